@@ -0,0 +1,414 @@
+// Every fast kernel against a double precision reference: max and mean ulp error, the input
+// of the worst one, then throughput on the same inputs, so a faster kernel ships with its
+// error known. Inputs are spread evenly over each range, then over its float bit patterns
+// (as many per binade, which brings in the tiny values and the denormals where the range
+// has them), plus edge cases. Errors are in ulps of the reference, see bench::Ulps, except
+// for quaternions, where they're in ulps of 1 (FLT_EPSILON).
+#include <cfloat>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+#include "bench.h"
+
+using namespace xo;
+
+namespace {
+size_t const Count = 1 << 18;
+// Timings run over the first Timed inputs, from the evenly spread ones.
+size_t const Timed = 4096;
+int const Reps = 100;
+
+double const Pi = 3.14159265358979323846;
+// The smallest denormal, FLT_TRUE_MIN only arrived with C++17.
+float const TrueMin = std::numeric_limits<float>::denorm_min();
+
+struct Error {
+    double max = 0.0;
+    double sum = 0.0;
+    size_t count = 0;
+    size_t nonFinite = 0;
+    size_t worst = 0;
+
+    void Add(size_t index, double ulps) {
+        if (std::isinf(ulps)) {
+            ++nonFinite;
+            return;
+        }
+        sum += ulps;
+        ++count;
+        if (ulps > max) {
+            max = ulps;
+            worst = index;
+        }
+    }
+
+    double Mean() const {
+        return count ? sum / double(count) : 0.0;
+    }
+};
+
+void Report(char const* name, char const* range, Error const& error, char const* worst, double nsPerOp) {
+    std::string const full = std::string(name) + " " + range;
+    bench::ReportAccuracy(full.c_str(), error.max, error.Mean(), error.count ? worst : "-", error.nonFinite);
+    bench::Report(full.c_str(), nsPerOp);
+}
+
+// Floats in the order of their values, -0 and 0 both at 0.
+int64_t Key(float f) {
+    int32_t i;
+    memcpy(&i, &f, sizeof(i));
+    return i < 0 ? int64_t(INT32_MIN) - i : int64_t(i);
+}
+
+float FromKey(int64_t key) {
+    int32_t const i = key < 0 ? int32_t(int64_t(INT32_MIN) - key) : int32_t(key);
+    float f;
+    memcpy(&f, &i, sizeof(f));
+    return f;
+}
+
+// Count inputs in [lo, hi], half even and half by bit pattern, then the edge cases in the
+// range, padded to whole FloatN<16>s.
+std::vector<float> Inputs(float lo, float hi, std::vector<float> const& edges) {
+    std::vector<float> in(Count);
+    size_t const even = Count / 2;
+    bench::Fill(in.data(), even, lo, hi);
+    int64_t const first = Key(lo), last = Key(hi);
+    for (size_t i = even; i < Count; ++i) {
+        in[i] = FromKey(first + (last - first) * int64_t(i - even) / int64_t(Count - even - 1));
+    }
+    for (float e : edges) {
+        if (e >= lo && e <= hi) in.push_back(e);
+    }
+    while (in.size() % 16) in.push_back(in[0]);
+    return in;
+}
+
+typedef void (*Kernel)(float const* in, float* out, size_t count);
+
+void Run(char const* name, char const* range, std::vector<float> const& in,
+         Kernel kernel, double (*reference)(double)) {
+    std::vector<float> out(in.size());
+    kernel(in.data(), out.data(), in.size());
+    Error error;
+    for (size_t i = 0; i < in.size(); ++i) {
+        error.Add(i, bench::Ulps(out[i], reference(double(in[i]))));
+    }
+    char worst[32];
+    snprintf(worst, sizeof(worst), "%.9g", in[error.worst]);
+    Report(name, range, error, worst, bench::NanosecondsPerOp(Timed * Reps, [&]() {
+        for (int r = 0; r < Reps; ++r) {
+            kernel(in.data(), out.data(), Timed);
+            bench::Consume(out[r & 1023]);
+        }
+    }));
+}
+
+double ReferenceSin(double x) { return std::sin(x); }
+double ReferenceCos(double x) { return std::cos(x); }
+double ReferenceASin(double x) { return std::asin(x); }
+double ReferenceACos(double x) { return std::acos(x); }
+double ReferenceInverseSqrt(double x) { return 1.0 / std::sqrt(x); }
+
+void XoSin(float const* in, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = Sin(in[i]);
+}
+void XoCos(float const* in, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = Cos(in[i]);
+}
+void StdSin(float const* in, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = std::sin(in[i]);
+}
+void StdCos(float const* in, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = std::cos(in[i]);
+}
+void XoASin(float const* in, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = ASin(in[i]);
+}
+void XoACos(float const* in, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = ACos(in[i]);
+}
+
+template<int N>
+void WideSin(float const* in, float* out, size_t count) {
+    for (size_t i = 0; i < count; i += N) Sin(FloatN<N>::Load(in + i)).Store(out + i);
+}
+template<int N>
+void WideCos(float const* in, float* out, size_t count) {
+    for (size_t i = 0; i < count; i += N) Cos(FloatN<N>::Load(in + i)).Store(out + i);
+}
+
+template<Precision P>
+void ScalarInverseSqrt(float const* in, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = InverseSqrt(in[i], P);
+}
+template<int N, Precision P>
+void WideInverseSqrt(float const* in, float* out, size_t count) {
+    for (size_t i = 0; i < count; i += N) FloatN<N>::InverseSqrt(FloatN<N>::Load(in + i), P).Store(out + i);
+}
+
+void Trig() {
+    std::vector<float> edges = { 0.f, -0.f, TrueMin, -TrueMin, FLT_MIN, -FLT_MIN,
+                                 1e5f, -1e5f, std::nextafter(1e5f, 1e6f), std::nextafter(-1e5f, -1e6f) };
+    for (int k = -8; k <= 8; ++k) {
+        edges.push_back(float(k * Pi / 2));
+    }
+    // The multiples of pi/2 nearest 1e5, where the reduction has the most to cancel.
+    for (int k = 63600; k <= 63700; ++k) {
+        edges.push_back(float(k * Pi / 2));
+    }
+    struct Range {
+        char const* name;
+        float lo, hi;
+        bool wide;  // FloatN has no fallback past trig::MaxReducible
+    };
+    Range const ranges[] = {
+        { "[-pi, pi]",   -3.14159265f, 3.14159265f, true },
+        { "[-1e5, 1e5]", -1e5f,        1e5f,        true },
+        { "[-1e7, 1e7]", -1e7f,        1e7f,        false },
+    };
+    printf("\n// Sin and Cos, against double precision std::sin and std::cos\n");
+    for (Range const& range : ranges) {
+        std::vector<float> const in = Inputs(range.lo, range.hi, edges);
+        Run("std::sin(float)", range.name, in, StdSin, ReferenceSin);
+        Run("xo::Sin(float)", range.name, in, XoSin, ReferenceSin);
+        Run("std::cos(float)", range.name, in, StdCos, ReferenceCos);
+        Run("xo::Cos(float)", range.name, in, XoCos, ReferenceCos);
+        if (range.wide) {
+            Run("xo::Sin(FloatN<4>)", range.name, in, WideSin<4>, ReferenceSin);
+            Run("xo::Cos(FloatN<4>)", range.name, in, WideCos<4>, ReferenceCos);
+            Run("xo::Sin(FloatN<8>)", range.name, in, WideSin<8>, ReferenceSin);
+            Run("xo::Cos(FloatN<8>)", range.name, in, WideCos<8>, ReferenceCos);
+            Run("xo::Sin(FloatN<16>)", range.name, in, WideSin<16>, ReferenceSin);
+            Run("xo::Cos(FloatN<16>)", range.name, in, WideCos<16>, ReferenceCos);
+        }
+    }
+
+    printf("\n// ASin and ACos, against double precision std::asin and std::acos\n");
+    std::vector<float> const in = Inputs(-1.f, 1.f, { 0.f, -0.f, TrueMin, 0.5f, -0.5f, 1.f, -1.f });
+    Run("xo::ASin", "[-1, 1]", in, XoASin, ReferenceASin);
+    Run("xo::ACos", "[-1, 1]", in, XoACos, ReferenceACos);
+}
+
+void InverseSqrts() {
+    std::vector<float> const edges = { 0.f, TrueMin, FLT_MIN, std::nextafter(FLT_MIN, 0.f),
+                                       0.25f, 1.f, 2.f, 4.f, FLT_MAX };
+    struct Range {
+        char const* name;
+        float lo, hi;
+    };
+    Range const ranges[] = {
+        { "[1e-3, 1e3]",        1e-3f,   1e3f },
+        { "[FLT_MIN, FLT_MAX]", FLT_MIN, FLT_MAX },
+        { "[0, FLT_MIN)",       0.f,     std::nextafter(FLT_MIN, 0.f) },
+    };
+    printf("\n// InverseSqrt, against double precision 1 / sqrt\n");
+    for (Range const& range : ranges) {
+        std::vector<float> const in = Inputs(range.lo, range.hi, edges);
+        Run("InverseSqrt Exact", range.name, in, ScalarInverseSqrt<Precision::Exact>, ReferenceInverseSqrt);
+        Run("InverseSqrt Fast", range.name, in, ScalarInverseSqrt<Precision::Fast>, ReferenceInverseSqrt);
+        Run("InverseSqrt Fastest", range.name, in, ScalarInverseSqrt<Precision::Fastest>, ReferenceInverseSqrt);
+        Run("FloatN<4>::InverseSqrt Fast", range.name, in, WideInverseSqrt<4, Precision::Fast>, ReferenceInverseSqrt);
+        Run("FloatN<4>::InverseSqrt Fastest", range.name, in, WideInverseSqrt<4, Precision::Fastest>, ReferenceInverseSqrt);
+        Run("FloatN<8>::InverseSqrt Fast", range.name, in, WideInverseSqrt<8, Precision::Fast>, ReferenceInverseSqrt);
+        Run("FloatN<8>::InverseSqrt Fastest", range.name, in, WideInverseSqrt<8, Precision::Fastest>, ReferenceInverseSqrt);
+        Run("FloatN<16>::InverseSqrt Fast", range.name, in, WideInverseSqrt<16, Precision::Fast>, ReferenceInverseSqrt);
+        Run("FloatN<16>::InverseSqrt Fastest", range.name, in, WideInverseSqrt<16, Precision::Fastest>, ReferenceInverseSqrt);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////// Normalize
+typedef void (*NormalizeKernel)(Vector3 const* in, Vector3* out, size_t count);
+
+template<Precision P>
+void ScalarNormalize(Vector3 const* in, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = in[i].Normalized(P);
+}
+template<Precision P>
+void BatchNormalize(Vector3 const* in, Vector3* out, size_t count) {
+    batch::Normalize(in, out, count, P);
+}
+
+void RunNormalize(char const* name, char const* range, std::vector<Vector3> const& in, NormalizeKernel kernel) {
+    std::vector<Vector3> out(in.size());
+    kernel(in.data(), out.data(), in.size());
+    Error error;
+    for (size_t i = 0; i < in.size(); ++i) {
+        double const x = in[i].x, y = in[i].y, z = in[i].z;
+        double const length = std::sqrt(x * x + y * y + z * z);
+        error.Add(i, Max(bench::Ulps(out[i].x, x / length),
+                         Max(bench::Ulps(out[i].y, y / length), bench::Ulps(out[i].z, z / length))));
+    }
+    Vector3 const& v = in[error.worst];
+    char worst[64];
+    snprintf(worst, sizeof(worst), "(%.4g, %.4g, %.4g)", v.x, v.y, v.z);
+    Report(name, range, error, worst, bench::NanosecondsPerOp(Timed * Reps, [&]() {
+        for (int r = 0; r < Reps; ++r) {
+            kernel(in.data(), out.data(), Timed);
+            bench::Consume(out[r & 1023]);
+        }
+    }));
+}
+
+void Normalizes() {
+    struct Range {
+        char const* name;
+        float bound;
+    };
+    // Squared lengths around 1e-38 and 1e38 are where the denormals and the overflow start.
+    Range const ranges[] = {
+        { "[-100, 100]",     100.f },
+        { "[-1e-19, 1e-19]", 1e-19f },
+        { "[-1e19, 1e19]",   1e19f },
+    };
+    printf("\n// Vector3 Normalize, components against double precision\n");
+    for (Range const& range : ranges) {
+        size_t const count = Count / 4;
+        std::vector<float> components(count * 3);
+        bench::Fill(components.data(), components.size(), -range.bound, range.bound);
+        std::vector<Vector3> in(count);
+        for (size_t i = 0; i < count; ++i) {
+            in[i] = Vector3(components[i * 3], components[i * 3 + 1], components[i * 3 + 2]);
+        }
+        in.push_back(Vector3(range.bound, 0.f, 0.f));
+        in.push_back(Vector3(0.f, 0.f, -range.bound));
+        in.push_back(Vector3(TrueMin, 0.f, 0.f));
+        in.push_back(Vector3(0.f));
+        RunNormalize("Vector3::Normalized Exact", range.name, in, ScalarNormalize<Precision::Exact>);
+        RunNormalize("Vector3::Normalized Fast", range.name, in, ScalarNormalize<Precision::Fast>);
+        RunNormalize("Vector3::Normalized Fastest", range.name, in, ScalarNormalize<Precision::Fastest>);
+        RunNormalize("batch::Normalize Exact", range.name, in, BatchNormalize<Precision::Exact>);
+        RunNormalize("batch::Normalize Fast", range.name, in, BatchNormalize<Precision::Fast>);
+        RunNormalize("batch::Normalize Fastest", range.name, in, BatchNormalize<Precision::Fastest>);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////// Slerp
+typedef void (*BlendKernel)(Quaternion const* start, Quaternion const* end, float const* t,
+                            Quaternion* out, size_t count);
+
+void QuaternionSlerp(Quaternion const* start, Quaternion const* end, float const* t, Quaternion* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = Quaternion::Slerp(start[i], end[i], t[i]);
+}
+void BatchSlerp(Quaternion const* start, Quaternion const* end, float const* t, Quaternion* out, size_t count) {
+    batch::Slerp(start, end, t, out, count);
+}
+template<Precision P>
+void BatchNlerp(Quaternion const* start, Quaternion const* end, float const* t, Quaternion* out, size_t count) {
+    batch::Nlerp(start, end, t, out, count, P);
+}
+
+// Slerp, or the normalized lerp, along the shorter arc in double precision. 'angle' is
+// the angle between start and end.
+void ReferenceBlend(Quaternion const& start, Quaternion const& end, float t, bool nlerp,
+                    double out[4], double& angle) {
+    double s[4], e[4], ss = 0.0, ee = 0.0;
+    for (int c = 0; c < 4; ++c) {
+        s[c] = start.vec4.v[c];
+        e[c] = end.vec4.v[c];
+        ss += s[c] * s[c];
+        ee += e[c] * e[c];
+    }
+    double d = 0.0;
+    for (int c = 0; c < 4; ++c) {
+        s[c] /= std::sqrt(ss);
+        e[c] /= std::sqrt(ee);
+        d += s[c] * e[c];
+    }
+    if (d < 0.0) {
+        for (double& c : e) c = -c;
+        d = -d;
+    }
+    angle = std::acos(d < 1.0 ? d : 1.0);
+    double s0 = 1.0 - t, s1 = t;
+    if (!nlerp && std::sin(angle) > 1e-12) {
+        s0 = std::sin((1.0 - t) * angle) / std::sin(angle);
+        s1 = std::sin(t * angle) / std::sin(angle);
+    }
+    double length = 0.0;
+    for (int c = 0; c < 4; ++c) {
+        out[c] = s[c] * s0 + e[c] * s1;
+        length += out[c] * out[c];
+    }
+    for (int c = 0; c < 4; ++c) {
+        out[c] /= std::sqrt(length);
+    }
+}
+
+void RunBlend(char const* name, char const* range, bool nlerp, std::vector<Quaternion> const& start,
+              std::vector<Quaternion> const& end, std::vector<float> const& t, BlendKernel kernel) {
+    size_t const count = start.size();
+    std::vector<Quaternion> out(count);
+    kernel(start.data(), end.data(), t.data(), out.data(), count);
+    Error error;
+    std::vector<double> angles(count);
+    for (size_t i = 0; i < count; ++i) {
+        double reference[4];
+        ReferenceBlend(start[i], end[i], t[i], nlerp, reference, angles[i]);
+        double worst = 0.0;
+        for (int c = 0; c < 4; ++c) {
+            float const v = out[i].vec4.v[c];
+            worst = Max(worst, std::isfinite(v) ? std::fabs(v - reference[c]) / FLT_EPSILON : INFINITY);
+        }
+        error.Add(i, worst);
+    }
+    char worst[64];
+    snprintf(worst, sizeof(worst), "angle %.4g t %.4g", angles[error.worst], t[error.worst]);
+    Report(name, range, error, worst, bench::NanosecondsPerOp(Timed * Reps, [&]() {
+        for (int r = 0; r < Reps; ++r) {
+            kernel(start.data(), end.data(), t.data(), out.data(), Timed);
+            bench::Consume(out[r & 1023]);
+        }
+    }));
+}
+
+void Blends() {
+    struct Range {
+        char const* name;
+        float spread;   // how far end is from start, before normalizing
+    };
+    Range const ranges[] = {
+        { "any angle",   0.f },
+        { "angle < 1e-2", 1e-2f },
+        { "angle < 1e-5", 1e-5f },
+    };
+    printf("\n// Quaternion blending, components in ulps of 1 against double precision\n");
+    for (Range const& range : ranges) {
+        size_t const count = Count / 4;
+        std::vector<float> components(count * 8);
+        bench::Fill(components.data(), components.size(), -1.f, 1.f);
+        std::vector<float> t(count);
+        bench::Fill(t.data(), count, 0.f, 1.f, 7);
+        t[0] = 0.f;
+        t[1] = 1.f;
+        std::vector<Quaternion> start(count), end(count);
+        for (size_t i = 0; i < count; ++i) {
+            float const* c = &components[i * 8];
+            start[i] = Quaternion(c[0], c[1], c[2], c[3]).Normalized();
+            if (range.spread > 0.f) {
+                Vector4 const offset(c[4], c[5], c[6], c[7]);
+                end[i] = Quaternion(start[i].vec4 + offset * range.spread).Normalized();
+            }
+            else {
+                end[i] = Quaternion(c[4], c[5], c[6], c[7]).Normalized();
+            }
+        }
+        // The same rotation both ways round.
+        end[2] = start[2];
+        end[3] = -start[3];
+        RunBlend("Quaternion::Slerp", range.name, false, start, end, t, QuaternionSlerp);
+        RunBlend("batch::Slerp", range.name, false, start, end, t, BatchSlerp);
+        RunBlend("batch::Nlerp Exact", range.name, true, start, end, t, BatchNlerp<Precision::Exact>);
+        RunBlend("batch::Nlerp Fast", range.name, true, start, end, t, BatchNlerp<Precision::Fast>);
+    }
+}
+} // ::anonymous
+
+void BenchAccuracy() {
+    printf("\n// Kernels used: %s\n", simd::SSEGetName(batch::ActiveKernels()));
+    Trig();
+    InverseSqrts();
+    Normalizes();
+    Blends();
+}
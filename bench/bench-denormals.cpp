@@ -0,0 +1,113 @@
+// What denormals cost: Lerp and Normalize chains on normal values, on values that keep
+// producing denormals, and on the same with xo::ScopedFlushDenormals, then the batch
+// versions. --counters shows the assists behind it as fp assist.
+#include <vector>
+#include "bench.h"
+
+using namespace xo;
+
+namespace {
+size_t const ChainLength = 1 << 16;
+size_t const Count = 4096;
+int const Reps = 100;
+
+// A Lerp chasing two targets in turn never settles, so with targets down in the denormals
+// every step works on them.
+double LerpChain(Vector3 const& a, Vector3 const& b) {
+    return bench::NanosecondsPerOp(ChainLength, [&]() {
+        Vector3 v = a;
+        bench::Opaque(v);
+        for (size_t i = 0; i < ChainLength; i += 2) {
+            v = Vector3::Lerp(v, b, 0.25f);
+            v = Vector3::Lerp(v, a, 0.25f);
+        }
+        bench::Consume(v);
+    });
+}
+
+// Normalized and scaled back down, so the squared components of the small axes are
+// denormal while the squared length isn't.
+double NormalizeChain(Vector3 const& start, float scale) {
+    return bench::NanosecondsPerOp(ChainLength, [&]() {
+        Vector3 v = start;
+        bench::Opaque(v);
+        for (size_t i = 0; i < ChainLength; ++i) {
+            v = v.Normalized(Precision::Exact) * scale;
+        }
+        bench::Consume(v);
+    });
+}
+
+double BatchLerp(std::vector<Vector3> const& a, std::vector<Vector3> const& b, std::vector<Vector3>& out) {
+    return bench::NanosecondsPerOp(Count * Reps, [&]() {
+        for (int r = 0; r < Reps; ++r) {
+            batch::Lerp(a.data(), b.data(), 0.25f, out.data(), Count);
+            bench::Consume(out[r & 1023]);
+        }
+    });
+}
+
+double BatchNormalize(std::vector<Vector3> const& in, std::vector<Vector3>& out) {
+    return bench::NanosecondsPerOp(Count * Reps, [&]() {
+        for (int r = 0; r < Reps; ++r) {
+            batch::Normalize(in.data(), out.data(), Count, Precision::Exact);
+            bench::Consume(out[r & 1023]);
+        }
+    });
+}
+
+std::vector<Vector3> Vectors(float scale, uint32_t seed) {
+    std::vector<float> components(Count * 3);
+    bench::Fill(components.data(), components.size(), 1.f, 2.f, seed);
+    std::vector<Vector3> out(Count);
+    for (size_t i = 0; i < Count; ++i) {
+        out[i] = Vector3(components[i * 3], components[i * 3 + 1] * 1e-3f, components[i * 3 + 2] * 1e-4f) * scale;
+    }
+    return out;
+}
+} // ::anonymous
+
+void BenchDenormals() {
+    bool supported;
+    {
+        ScopedFlushDenormals flush;
+        supported = GetFlushDenormals();
+    }
+    printf("\n// Denormals, flushing %s\n", supported ? "supported" : "not supported here");
+
+    Vector3 const a(1.f, 2.f, 3.f), b(3.f, 1.f, 2.f);
+    float const tiny = 1e-39f;
+    bench::Report("Vector3::Lerp normal", "latency", LerpChain(a, b));
+    bench::Report("Vector3::Lerp denormal", "latency", LerpChain(a * tiny, b * tiny));
+    {
+        ScopedFlushDenormals flush;
+        bench::Report("Vector3::Lerp denormal, flushed", "latency", LerpChain(a * tiny, b * tiny));
+    }
+
+    Vector3 const direction(1.f, 1e-3f, 1e-4f);
+    float const small = 2e-19f;
+    bench::Report("Vector3::Normalized normal", "latency", NormalizeChain(direction, 1.f));
+    bench::Report("Vector3::Normalized denormal", "latency", NormalizeChain(direction * small, small));
+    {
+        ScopedFlushDenormals flush;
+        bench::Report("Vector3::Normalized denormal, flushed", "latency", NormalizeChain(direction * small, small));
+    }
+
+    std::vector<Vector3> out(Count);
+    std::vector<Vector3> const normalA = Vectors(1.f, 1), normalB = Vectors(1.f, 2);
+    std::vector<Vector3> const tinyA = Vectors(tiny, 1), tinyB = Vectors(tiny, 2);
+    bench::Report("batch::Lerp normal", BatchLerp(normalA, normalB, out));
+    bench::Report("batch::Lerp denormal", BatchLerp(tinyA, tinyB, out));
+    {
+        ScopedFlushDenormals flush;
+        bench::Report("batch::Lerp denormal, flushed", BatchLerp(tinyA, tinyB, out));
+    }
+
+    std::vector<Vector3> const smallA = Vectors(small, 1);
+    bench::Report("batch::Normalize normal", BatchNormalize(normalA, out));
+    bench::Report("batch::Normalize denormal", BatchNormalize(smallA, out));
+    {
+        ScopedFlushDenormals flush;
+        bench::Report("batch::Normalize denormal, flushed", BatchNormalize(smallA, out));
+    }
+}
@@ -0,0 +1,86 @@
+// Normalize at each xo::Precision: worst error in the resulting length, then throughput of
+// Vector3::Normalized, the batch kernels and Vector3xN.
+#include <cmath>
+#include <vector>
+#include "bench.h"
+
+using namespace xo;
+
+namespace {
+struct Mode {
+    char const* name;
+    Precision precision;
+};
+Mode const modes[] = {
+    { "Exact",   Precision::Exact },
+    { "Fast",    Precision::Fast },
+    { "Fastest", Precision::Fastest },
+};
+
+double LengthError(Vector3 const& v) {
+    double const x = v.x, y = v.y, z = v.z;
+    return std::fabs(std::sqrt(x * x + y * y + z * z) - 1.0);
+}
+
+template<int N>
+double WideNormalize(std::vector<Vector3> const& in, std::vector<Vector3>& out, Precision precision, int reps) {
+    return bench::NanosecondsPerOp(in.size() * reps, [&]() {
+        for (int r = 0; r < reps; ++r) {
+            for (size_t i = 0; i + N <= in.size(); i += N) {
+                Vector3xN<N>::Gather(&in[i]).Normalized(precision).Scatter(&out[i]);
+            }
+            bench::Consume(out[r & 1023]);
+        }
+    });
+}
+} // ::anonymous
+
+void BenchNormalize() {
+    size_t const count = 4096;
+    int const reps = 1000;
+    std::vector<float> components(count * 3);
+    bench::Fill(components.data(), components.size(), -100.f, 100.f);
+    std::vector<Vector3> in(count), out(count);
+    for (size_t i = 0; i < count; ++i) {
+        in[i] = Vector3(components[i * 3], components[i * 3 + 1], components[i * 3 + 2]);
+    }
+
+    printf("\n// Normalize accuracy, max |length - 1|\n");
+    for (Mode const& mode : modes) {
+        double scalar = 0.0, batched = 0.0;
+        for (Vector3 const& v : in) {
+            scalar = Max(scalar, LengthError(v.Normalized(mode.precision)));
+        }
+        batch::Normalize(in.data(), out.data(), count, mode.precision);
+        for (Vector3 const& v : out) {
+            batched = Max(batched, LengthError(v));
+        }
+        printf("%-8s Vector3 %.3g   batch (%s) %.3g\n", mode.name, scalar,
+               simd::SSEGetName(batch::ActiveKernels()), batched);
+    }
+
+    printf("\n// Normalize throughput, per vector\n");
+    char name[64];
+    for (Mode const& mode : modes) {
+        snprintf(name, sizeof(name), "Vector3::Normalized %s", mode.name);
+        bench::Report(name, bench::NanosecondsPerOp(count * reps, [&]() {
+            for (int r = 0; r < reps; ++r) {
+                for (size_t i = 0; i < count; ++i) {
+                    out[i] = in[i].Normalized(mode.precision);
+                }
+                bench::Consume(out[r & 1023]);
+            }
+        }));
+        snprintf(name, sizeof(name), "batch::Normalize %s", mode.name);
+        bench::Report(name, bench::NanosecondsPerOp(count * reps, [&]() {
+            for (int r = 0; r < reps; ++r) {
+                batch::Normalize(in.data(), out.data(), count, mode.precision);
+                bench::Consume(out[r & 1023]);
+            }
+        }));
+        snprintf(name, sizeof(name), "Vector3x8::Normalized %s", mode.name);
+        bench::Report(name, WideNormalize<8>(in, out, mode.precision, reps));
+        snprintf(name, sizeof(name), "Vector3xN<16>::Normalized %s", mode.name);
+        bench::Report(name, WideNormalize<16>(in, out, mode.precision, reps));
+    }
+}
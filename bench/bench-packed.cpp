@@ -0,0 +1,122 @@
+// PackedQuaternion32/48 and PackedNormal32/16: the distribution of the angle error, then
+// unpack throughput per element and in GB/s of packed input, against packing.
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "bench.h"
+
+using namespace xo;
+
+namespace {
+// The angle in degrees between the rotations a and b, from the length of a - b (or a + b)
+// so it doesn't lose everything to acos near 1.
+double AngleError(Quaternion const& a, Quaternion const& b) {
+    double const sign = Quaternion::DotProduct(a, b) < 0.f ? -1.0 : 1.0;
+    double lengthSquared = 0.0;
+    for (int c = 0; c < 4; ++c) {
+        double const d = sign * a.vec4.v[c] - b.vec4.v[c];
+        lengthSquared += d * d;
+    }
+    return 4.0 * std::asin(std::sqrt(lengthSquared) * 0.5) * 57.29577951308232;
+}
+
+// The angle in degrees between the unit vectors a and b, the same way.
+double AngleError(Vector3 const& a, Vector3 const& b) {
+    double const x = double(a.x) - b.x, y = double(a.y) - b.y, z = double(a.z) - b.z;
+    return 2.0 * std::asin(std::sqrt(x * x + y * y + z * z) * 0.5) * 57.29577951308232;
+}
+
+template<typename P, typename T>
+void ReportError(char const* name, std::vector<T> const& in) {
+    std::vector<P> packed(in.size());
+    std::vector<T> out(in.size());
+    batch::Pack(in.data(), packed.data(), in.size());
+    batch::Unpack(packed.data(), out.data(), in.size());
+    std::vector<double> errors(in.size());
+    double sum = 0.0;
+    for (size_t i = 0; i < in.size(); ++i) {
+        errors[i] = AngleError(out[i], in[i]);
+        sum += errors[i];
+    }
+    std::sort(errors.begin(), errors.end());
+    auto percentile = [&](double p) { return errors[size_t(p * double(errors.size() - 1))]; };
+    printf("%-20s mean %.3g  p50 %.3g  p99 %.3g  p99.9 %.3g  max %.3g\n", name,
+           sum / double(errors.size()), percentile(0.5), percentile(0.99), percentile(0.999), errors.back());
+}
+
+XO_INL Quaternion Unpacked(PackedQuaternion32 const& p) { return p.ToQuaternion(); }
+XO_INL Quaternion Unpacked(PackedQuaternion48 const& p) { return p.ToQuaternion(); }
+XO_INL Vector3 Unpacked(PackedNormal32 const& p) { return p.ToVector3(); }
+XO_INL Vector3 Unpacked(PackedNormal16 const& p) { return p.ToVector3(); }
+
+template<typename P, typename T>
+void ReportThroughput(char const* name, std::vector<T> const& in, int reps) {
+    size_t const count = in.size();
+    std::vector<P> packed(count);
+    std::vector<T> out(count);
+    char label[64];
+    snprintf(label, sizeof(label), "%s one at a time", name);
+    batch::Pack(in.data(), packed.data(), count);
+    bench::Report(label, bench::NanosecondsPerOp(count * reps, [&]() {
+        for (int r = 0; r < reps; ++r) {
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = Unpacked(packed[i]);
+            }
+            bench::Consume(out[r & 1023]);
+        }
+    }));
+    snprintf(label, sizeof(label), "batch::Unpack %s", name);
+    double const unpack = bench::NanosecondsPerOp(count * reps, [&]() {
+        for (int r = 0; r < reps; ++r) {
+            batch::Unpack(packed.data(), out.data(), count);
+            bench::Consume(out[r & 1023]);
+        }
+    });
+    bench::Report(label, unpack);
+    printf("%-40s %10.3f GB/s packed\n", label, double(sizeof(P)) / unpack);
+    snprintf(label, sizeof(label), "batch::Pack %s", name);
+    bench::Report(label, bench::NanosecondsPerOp(count * reps, [&]() {
+        for (int r = 0; r < reps; ++r) {
+            batch::Pack(in.data(), packed.data(), count);
+            bench::Consume(packed[r & 1023]);
+        }
+    }));
+}
+} // ::anonymous
+
+void BenchPackedQuaternion() {
+    size_t const count = 1 << 16;
+    std::vector<float> components(count * 4);
+    bench::Fill(components.data(), components.size(), -1.f, 1.f, 11);
+    std::vector<Quaternion> in(count);
+    for (size_t i = 0; i < count; ++i) {
+        float const* c = &components[i * 4];
+        in[i] = Quaternion(c[0], c[1], c[2], c[3]).Normalized();
+    }
+
+    printf("\n// Packed quaternion error, degrees of rotation\n");
+    ReportError<PackedQuaternion32>("PackedQuaternion32", in);
+    ReportError<PackedQuaternion48>("PackedQuaternion48", in);
+
+    printf("\n// Packed quaternion throughput (%s), per rotation\n", simd::SSEGetName(batch::ActiveKernels()));
+    ReportThroughput<PackedQuaternion32>("PackedQuaternion32", in, 100);
+    ReportThroughput<PackedQuaternion48>("PackedQuaternion48", in, 100);
+}
+
+void BenchPackedNormal() {
+    size_t const count = 1 << 16;
+    std::vector<float> components(count * 3);
+    bench::Fill(components.data(), components.size(), -1.f, 1.f, 13);
+    std::vector<Vector3> in(count);
+    for (size_t i = 0; i < count; ++i) {
+        in[i] = Vector3(components[i * 3], components[i * 3 + 1], components[i * 3 + 2]).Normalized();
+    }
+
+    printf("\n// Packed normal error, degrees\n");
+    ReportError<PackedNormal32>("PackedNormal32", in);
+    ReportError<PackedNormal16>("PackedNormal16", in);
+
+    printf("\n// Packed normal throughput (%s), per vector\n", simd::SSEGetName(batch::ActiveKernels()));
+    ReportThroughput<PackedNormal32>("PackedNormal32", in, 100);
+    ReportThroughput<PackedNormal16>("PackedNormal16", in, 100);
+}
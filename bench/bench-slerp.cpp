@@ -0,0 +1,70 @@
+// batch::Slerp and batch::Nlerp against Quaternion::Slerp: worst component error, then
+// throughput per blended rotation.
+#include <cmath>
+#include <vector>
+#include "bench.h"
+
+using namespace xo;
+
+namespace {
+double MaxError(std::vector<Quaternion> const& a, std::vector<Quaternion> const& b) {
+    double worst = 0.0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        for (int c = 0; c < 4; ++c) {
+            worst = Max(worst, std::fabs(double(a[i].vec4.v[c]) - double(b[i].vec4.v[c])));
+        }
+    }
+    return worst;
+}
+} // ::anonymous
+
+void BenchSlerp() {
+    size_t const count = 4096;
+    int const reps = 1000;
+    std::vector<float> components(count * 8);
+    bench::Fill(components.data(), components.size(), -1.f, 1.f);
+    std::vector<float> t(count);
+    bench::Fill(t.data(), count, 0.f, 1.f, 7);
+    std::vector<Quaternion> start(count), end(count), reference(count), out(count);
+    for (size_t i = 0; i < count; ++i) {
+        float const* c = &components[i * 8];
+        start[i] = Quaternion(c[0], c[1], c[2], c[3]).Normalized();
+        end[i] = Quaternion(c[4], c[5], c[6], c[7]).Normalized();
+        reference[i] = Quaternion::Slerp(start[i], end[i], t[i]);
+    }
+
+    printf("\n// Quaternion blending accuracy, max component error against Quaternion::Slerp\n");
+    char const* kernels = simd::SSEGetName(batch::ActiveKernels());
+    batch::Slerp(start.data(), end.data(), t.data(), out.data(), count);
+    printf("batch::Slerp (%s) %.3g\n", kernels, MaxError(out, reference));
+    batch::Nlerp(start.data(), end.data(), t.data(), out.data(), count);
+    printf("batch::Nlerp (%s) %.3g\n", kernels, MaxError(out, reference));
+
+    printf("\n// Quaternion blending throughput, per rotation\n");
+    bench::Report("Quaternion::Slerp", bench::NanosecondsPerOp(count * reps, [&]() {
+        for (int r = 0; r < reps; ++r) {
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = Quaternion::Slerp(start[i], end[i], t[i]);
+            }
+            bench::Consume(out[r & 1023]);
+        }
+    }));
+    bench::Report("batch::Slerp", bench::NanosecondsPerOp(count * reps, [&]() {
+        for (int r = 0; r < reps; ++r) {
+            batch::Slerp(start.data(), end.data(), t.data(), out.data(), count);
+            bench::Consume(out[r & 1023]);
+        }
+    }));
+    bench::Report("batch::Nlerp Exact", bench::NanosecondsPerOp(count * reps, [&]() {
+        for (int r = 0; r < reps; ++r) {
+            batch::Nlerp(start.data(), end.data(), t.data(), out.data(), count, Precision::Exact);
+            bench::Consume(out[r & 1023]);
+        }
+    }));
+    bench::Report("batch::Nlerp Fast", bench::NanosecondsPerOp(count * reps, [&]() {
+        for (int r = 0; r < reps; ++r) {
+            batch::Nlerp(start.data(), end.data(), t.data(), out.data(), count, Precision::Fast);
+            bench::Consume(out[r & 1023]);
+        }
+    }));
+}
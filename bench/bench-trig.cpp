@@ -0,0 +1,76 @@
+// xo::SinCos against libm: max ulp error over a few input ranges, then throughput.
+#include <cmath>
+#include <vector>
+#include "bench.h"
+
+using namespace xo;
+
+namespace {
+void Accuracy(char const* name, float lo, float hi) {
+    size_t const count = 1 << 22;
+    std::vector<float> in(count);
+    bench::Fill(in.data(), count, lo, hi);
+    int64_t xoSin = 0, xoCos = 0, libSin = 0, libCos = 0;
+    for (float v : in) {
+        float s, c;
+        SinCos(v, s, c);
+        double const rs = std::sin(double(v));
+        double const rc = std::cos(double(v));
+        xoSin = Max(xoSin, bench::UlpError(s, rs));
+        xoCos = Max(xoCos, bench::UlpError(c, rc));
+        libSin = Max(libSin, bench::UlpError(std::sin(v), rs));
+        libCos = Max(libCos, bench::UlpError(std::cos(v), rc));
+    }
+    printf("%-24s max ulp  xo sin %lld cos %lld   libm sin %lld cos %lld\n", name,
+           (long long)xoSin, (long long)xoCos, (long long)libSin, (long long)libCos);
+}
+
+template<int N>
+double WideSinCos(std::vector<float> const& in, std::vector<float>& s, std::vector<float>& c, int reps) {
+    return bench::NanosecondsPerOp(in.size() * reps, [&]() {
+        for (int r = 0; r < reps; ++r) {
+            for (size_t i = 0; i + N <= in.size(); i += N) {
+                FloatN<N> fs, fc;
+                SinCos(FloatN<N>::Load(&in[i]), fs, fc);
+                fs.Store(&s[i]);
+                fc.Store(&c[i]);
+            }
+            bench::Consume(s[r & 1023]);
+        }
+    });
+}
+} // ::anonymous
+
+void BenchTrig() {
+    printf("\n// SinCos accuracy, against double precision libm\n");
+    Accuracy("[-pi, pi]", -3.14159265f, 3.14159265f);
+    Accuracy("[-100, 100]", -100.f, 100.f);
+    Accuracy("[-1e5, 1e5]", -1e5f, 1e5f);
+
+    printf("\n// SinCos throughput, inputs in [-pi, pi]\n");
+    size_t const count = 4096;
+    int const reps = 1000;
+    std::vector<float> in(count), s(count), c(count);
+    bench::Fill(in.data(), count, -3.14159265f, 3.14159265f);
+
+    bench::Report("std::sin + std::cos", bench::NanosecondsPerOp(count * reps, [&]() {
+        for (int r = 0; r < reps; ++r) {
+            for (size_t i = 0; i < count; ++i) {
+                s[i] = std::sin(in[i]);
+                c[i] = std::cos(in[i]);
+            }
+            bench::Consume(s[r & 1023]);
+        }
+    }));
+    bench::Report("xo::SinCos(float)", bench::NanosecondsPerOp(count * reps, [&]() {
+        for (int r = 0; r < reps; ++r) {
+            for (size_t i = 0; i < count; ++i) {
+                SinCos(in[i], s[i], c[i]);
+            }
+            bench::Consume(s[r & 1023]);
+        }
+    }));
+    bench::Report("xo::SinCos(FloatN<4>)", WideSinCos<4>(in, s, c, reps));
+    bench::Report("xo::SinCos(FloatN<8>)", WideSinCos<8>(in, s, c, reps));
+    bench::Report("xo::SinCos(FloatN<16>)", WideSinCos<16>(in, s, c, reps));
+}
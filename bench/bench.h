@@ -0,0 +1,210 @@
+#pragma once
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "xo-math.h"
+#include "perf.h"
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#   include <intrin.h>
+#   define XO_BENCH_HAS_TSC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#   include <x86intrin.h>
+#   define XO_BENCH_HAS_TSC 1
+#else
+#   define XO_BENCH_HAS_TSC 0
+#endif
+
+namespace bench {
+// Where Consume stores. A static member rather than a function local static, which gcc
+// warns about as set but never read.
+template<typename T>
+struct Sink { static unsigned char volatile bytes[sizeof(T)]; };
+template<typename T>
+unsigned char volatile Sink<T>::bytes[sizeof(T)];
+
+// Stores through a volatile so the optimizer can't drop the work that produced 'value'.
+template<typename T>
+void Consume(T const& value) {
+    unsigned char bytes[sizeof(T)];
+    memcpy(bytes, &value, sizeof(T));
+    for (size_t i = 0; i < sizeof(T); ++i) Sink<T>::bytes[i] = bytes[i];
+}
+
+// The perf counters of the last NanosecondsPerOp, per op, for Report.
+inline Counts& LastCounts() {
+    static Counts counts = Counts::None();
+    return counts;
+}
+
+// Best of 'runs' timings of body(), divided by 'ops'. With the perf counters open, the
+// counts of that best run go to LastCounts.
+template<typename Body>
+double NanosecondsPerOp(size_t ops, Body&& body, int runs = 5) {
+    PerfCounters& counters = PerfCounters::Instance();
+    double best = 1e300;
+    Counts bestCounts = Counts::None();
+    for (int r = 0; r < runs; ++r) {
+        if (counters.Active()) counters.Start();
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto end = std::chrono::steady_clock::now();
+        Counts const counts = counters.Active() ? counters.Stop() : Counts::None();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        if (ns < best) {
+            best = ns;
+            bestCounts = counts;
+        }
+    }
+    LastCounts() = bestCounts.PerOp(double(ops));
+    return best / double(ops);
+}
+
+// The optimizer can't see through this, so it can't fold a chain like -(-v) back to v.
+// It's a store and a reload where the compiler supports it, nothing where it doesn't.
+template<typename T>
+void Opaque(T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    __asm__ volatile("" : "+m"(value));
+#else
+    (void)value;
+#endif
+}
+
+// Timestamp counter ticks per nanosecond, measured once against steady_clock. The counter
+// runs at the nominal clock whatever the core is boosted to, so ops per cycle are per
+// nominal cycle. 0 where there's no counter.
+inline double TicksPerNanosecond() {
+#if XO_BENCH_HAS_TSC
+    static double const ticksPerNs = []() {
+        auto start = std::chrono::steady_clock::now();
+        uint64_t const first = __rdtsc();
+        while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(50)) { }
+        uint64_t const last = __rdtsc();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        return double(last - first) / ns;
+    }();
+    return ticksPerNs;
+#else
+    return 0.0;
+#endif
+}
+
+// Every Report lands here too, for --json. Group is the set of benchmarks main is running.
+struct Result {
+    std::string group;
+    std::string name;
+    std::string mode;
+    double nsPerOp;
+    Counts counts;
+};
+
+inline std::vector<Result>& Results() {
+    static std::vector<Result> results;
+    return results;
+}
+
+inline std::string& Group() {
+    static std::string group;
+    return group;
+}
+
+// 'mode' is latency for an op chained on its own result, throughput for independent ones.
+inline void Report(char const* name, char const* mode, double nsPerOp) {
+    double const ticks = TicksPerNanosecond();
+    Counts const counts = LastCounts();
+    LastCounts() = Counts::None();
+    Results().push_back(Result{ Group(), name, mode, nsPerOp, counts });
+    if (ticks > 0.0) {
+        printf("%-44s %-10s %10.3f ns/op %8.3f ops/cycle\n", name, mode, nsPerOp, 1.0 / (nsPerOp * ticks));
+    }
+    else {
+        printf("%-44s %-10s %10.3f ns/op\n", name, mode, nsPerOp);
+    }
+    if (PerfCounters::Instance().Active()) {
+        // Per op, the stalls as a share of the cycles, '-' for what couldn't be counted.
+        auto field = [](char* out, double value, char const* format) {
+            if (value < 0.0) snprintf(out, 16, "-");
+            else snprintf(out, 16, format, value);
+        };
+        double const* v = counts.value;
+        bool const haveCycles = v[Cycles] > 0.0;
+        char cycles[16], ipc[16], l1d[16], branch[16], fe[16], be[16], assist[16];
+        field(cycles, v[Cycles], "%.2f");
+        field(ipc, haveCycles && v[Instructions] >= 0.0 ? v[Instructions] / v[Cycles] : -1.0, "%.2f");
+        field(l1d, v[L1DMisses], "%.4f");
+        field(branch, v[BranchMisses], "%.4f");
+        field(fe, haveCycles && v[FrontendStalls] >= 0.0 ? 100.0 * v[FrontendStalls] / v[Cycles] : -1.0, "%.0f%%");
+        field(be, haveCycles && v[BackendStalls] >= 0.0 ? 100.0 * v[BackendStalls] / v[Cycles] : -1.0, "%.0f%%");
+        field(assist, v[FPAssists], "%.4f");
+        printf("    cycles %s  IPC %s  L1D miss %s  br miss %s  fe stall %s  be stall %s  fp assist %s\n",
+               cycles, ipc, l1d, branch, fe, be, assist);
+    }
+}
+
+inline void Report(char const* name, double nsPerOp) {
+    Report(name, "throughput", nsPerOp);
+}
+
+// Distance in representable floats between a and the correctly rounded reference.
+inline int64_t UlpError(float a, double reference) {
+    auto key = [](float f) {
+        int32_t i;
+        memcpy(&i, &f, sizeof(i));
+        return i < 0 ? int64_t(INT32_MIN) - i : int64_t(i);
+    };
+    int64_t d = key(a) - key(float(reference));
+    return d < 0 ? -d : d;
+}
+
+// |a - reference| in ulps of a float the size of reference, fractional, so 0.5 or less is
+// correctly rounded. Infinite when a is NaN or infinite and the reference isn't the same.
+inline double Ulps(float a, double reference) {
+    if (std::isnan(reference)) return std::isnan(a) ? 0.0 : INFINITY;
+    if (std::isinf(reference) || !std::isfinite(a)) return double(a) == reference ? 0.0 : INFINITY;
+    int exponent;
+    std::frexp(reference, &exponent);
+    // Floats have 24 bit significands, and none is finer than the smallest denormal.
+    double const ulp = std::ldexp(1.0, exponent - 24 > -149 ? exponent - 24 : -149);
+    return std::fabs(double(a) - reference) / ulp;
+}
+
+// An accuracy result for --json, next to the timings in Results.
+struct Accuracy {
+    std::string group;
+    std::string name;
+    double maxUlps;
+    double meanUlps;
+    std::string worstInput;
+    size_t nonFinite;
+};
+
+inline std::vector<Accuracy>& Accuracies() {
+    static std::vector<Accuracy> accuracies;
+    return accuracies;
+}
+
+// 'nonFinite' counts results that are NaN or infinite where the reference isn't, or the
+// other way around. They're left out of the max and the mean.
+inline void ReportAccuracy(char const* name, double maxUlps, double meanUlps,
+                           char const* worstInput, size_t nonFinite) {
+    Accuracies().push_back(Accuracy{ Group(), name, maxUlps, meanUlps, worstInput, nonFinite });
+    printf("%-44s max %9.3g ulp  mean %9.3g ulp  worst at %s", name, maxUlps, meanUlps, worstInput);
+    if (nonFinite) {
+        printf("  %zu non-finite mismatches", nonFinite);
+    }
+    printf("\n");
+}
+
+// Fills out with 'count' floats in [lo, hi) from a fixed seed.
+inline void Fill(float* out, size_t count, float lo, float hi, uint32_t seed = 1) {
+    for (size_t i = 0; i < count; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        out[i] = lo + (hi - lo) * float(seed >> 8) * (1.f / 16777216.f);
+    }
+}
+} // ::bench
@@ -0,0 +1,178 @@
+// Benchmarks for xo-math. Build the xomath_bench target with optimizations on, and with
+// the compiler flags of the target you care about (-msse4.1, -mavx2 -mfma, /arch:AVX2 ...).
+//
+//     xomath_bench [--json results.json] [--counters] [group ...]
+//
+// runs the named groups, or all of them, and with --json also writes every result out for
+// scripts/bench-compare.js to diff against another run. --counters adds the hardware
+// performance counters of every run, see perf.h. The accuracy group measures the error of
+// every fast kernel next to its throughput.
+#define XO_MATH_IMPL
+#include "bench.h"
+
+void BenchOps();
+void BenchTrig();
+void BenchNormalize();
+void BenchSlerp();
+void BenchPackedQuaternion();
+void BenchPackedNormal();
+void BenchAccuracy();
+void BenchDenormals();
+
+namespace {
+struct Group {
+    char const* name;
+    void (*run)();
+};
+Group const groups[] = {
+    { "ops",                BenchOps },
+    { "trig",               BenchTrig },
+    { "normalize",          BenchNormalize },
+    { "slerp",              BenchSlerp },
+    { "packed-quaternion",  BenchPackedQuaternion },
+    { "packed-normal",      BenchPackedNormal },
+    { "accuracy",           BenchAccuracy },
+    { "denormals",          BenchDenormals },
+};
+
+#if XO_SSE_CURRENT >= XO_SSE4_1
+char const* const backend = "sse4";
+#else
+char const* const backend = "reference";
+#endif
+
+#if defined(__clang__)
+char const* const compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+char const* const compiler = "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+#define XO_BENCH_STRING2(x) #x
+#define XO_BENCH_STRING(x) XO_BENCH_STRING2(x)
+char const* const compiler = "msvc " XO_BENCH_STRING(_MSC_FULL_VER);
+#else
+char const* const compiler = "unknown";
+#endif
+
+void WriteString(FILE* file, std::string const& s) {
+    fputc('"', file);
+    for (char c : s) {
+        if (c == '"' || c == '\\') fputc('\\', file);
+        fputc(c, file);
+    }
+    fputc('"', file);
+}
+
+bool WriteJson(char const* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+    double const ticks = bench::TicksPerNanosecond();
+    fprintf(file, "{\n  \"backend\": \"%s\",\n", backend);
+    fprintf(file, "  \"compiled_sse\": \"%s\",\n", xo::simd::SSEVersionName);
+    fprintf(file, "  \"running_sse\": \"%s\",\n", xo::simd::SSEGetRuntimeName());
+    fprintf(file, "  \"batch_kernels\": \"%s\",\n", xo::simd::SSEGetName(xo::batch::ActiveKernels()));
+    fprintf(file, "  \"compiler\": ");
+    WriteString(file, compiler);
+    fprintf(file, ",\n  \"tsc_ghz\": %.4f,\n  \"results\": [", ticks);
+    std::vector<bench::Result> const& results = bench::Results();
+    for (size_t i = 0; i < results.size(); ++i) {
+        bench::Result const& r = results[i];
+        fprintf(file, "%s\n    { \"group\": ", i ? "," : "");
+        WriteString(file, r.group);
+        fprintf(file, ", \"name\": ");
+        WriteString(file, r.name);
+        fprintf(file, ", \"mode\": ");
+        WriteString(file, r.mode);
+        fprintf(file, ", \"ns_per_op\": %.4f, \"ops_per_cycle\": ", r.nsPerOp);
+        if (ticks > 0.0) {
+            fprintf(file, "%.4f", 1.0 / (r.nsPerOp * ticks));
+        }
+        else {
+            fprintf(file, "null");
+        }
+        if (bench::PerfCounters::Instance().Active()) {
+            char const* const names[bench::CounterCount] = {
+                "cycles", "instructions", "l1d_read_misses", "branch_misses",
+                "frontend_stall_cycles", "backend_stall_cycles", "fp_assists"
+            };
+            fprintf(file, ", \"counters_per_op\": {");
+            for (int c = 0; c < bench::CounterCount; ++c) {
+                fprintf(file, c ? ", \"%s\": " : " \"%s\": ", names[c]);
+                if (r.counts.value[c] < 0.0) {
+                    fprintf(file, "null");
+                }
+                else {
+                    fprintf(file, "%.6g", r.counts.value[c]);
+                }
+            }
+            fprintf(file, " }");
+        }
+        fprintf(file, " }");
+    }
+    fprintf(file, "\n  ],\n  \"accuracy\": [");
+    std::vector<bench::Accuracy> const& accuracies = bench::Accuracies();
+    for (size_t i = 0; i < accuracies.size(); ++i) {
+        bench::Accuracy const& a = accuracies[i];
+        fprintf(file, "%s\n    { \"group\": ", i ? "," : "");
+        WriteString(file, a.group);
+        fprintf(file, ", \"name\": ");
+        WriteString(file, a.name);
+        fprintf(file, ", \"max_ulp\": %.6g, \"mean_ulp\": %.6g, \"worst_input\": ", a.maxUlps, a.meanUlps);
+        WriteString(file, a.worstInput);
+        fprintf(file, ", \"non_finite\": %zu }", a.nonFinite);
+    }
+    fprintf(file, "\n  ]\n}\n");
+    return fclose(file) == 0;
+}
+} // ::anonymous
+
+int main(int argc, char** argv) {
+    char const* json = nullptr;
+    bool counters = false;
+    std::vector<std::string> selected;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json = argv[++i];
+        }
+        else if (strcmp(argv[i], "--counters") == 0) {
+            counters = true;
+        }
+        else {
+            bool known = false;
+            for (Group const& group : groups) {
+                known = known || strcmp(argv[i], group.name) == 0;
+            }
+            if (!known) {
+                fprintf(stderr, "usage: %s [--json file] [--counters] [group ...]\ngroups:", argv[0]);
+                for (Group const& group : groups) {
+                    fprintf(stderr, " %s", group.name);
+                }
+                fprintf(stderr, "\n");
+                return 1;
+            }
+            selected.push_back(argv[i]);
+        }
+    }
+
+    printf("Compiling with sse: %s\n", xo::simd::SSEVersionName);
+    printf("Running with sse: %s\n", xo::simd::SSEGetRuntimeName());
+    printf("Backend: %s\n", backend);
+    if (counters && !bench::PerfCounters::Instance().Open()) {
+        fprintf(stderr, "no perf counters, running without them\n");
+    }
+    for (Group const& group : groups) {
+        bool run = selected.empty();
+        for (std::string const& name : selected) {
+            run = run || name == group.name;
+        }
+        if (run) {
+            bench::Group() = group.name;
+            group.run();
+        }
+    }
+
+    if (json && !WriteJson(json)) {
+        fprintf(stderr, "couldn't write %s\n", json);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,210 @@
+#pragma once
+// Hardware performance counters for the benchmarks, through Linux perf_event_open. With
+// --counters every Report also shows per op:
+//
+//     cycles      core cycles, boosted or not, unlike ops/cycle from the timestamp counter
+//     IPC         instructions per cycle: low with few stalls below means dependency chains
+//     L1D miss    L1 data cache read misses: memory bound when this is far from 0
+//     br miss     mispredicted branches
+//     fe/be stall the share of cycles the front end (fetch, decode) or the back end
+//                 (execution, memory) stalled, where the CPU reports them
+//     fp assist   microcode assists for floating point, which are mostly denormals
+//
+// The fp assist event differs per CPU. It's Intel's FP_ASSIST.ANY or ASSISTS.FP by model,
+// XO_BENCH_ASSIST_EVENT=0x<config> in the environment sets any other raw event. Counters
+// the kernel or the CPU doesn't have (containers, VMs, perf_event_paranoid > 2, other
+// platforms) show as '-'.
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#if defined(__linux__)
+#   include <linux/perf_event.h>
+#   include <sys/ioctl.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#   if defined(__x86_64__) || defined(__i386__)
+#       include <cpuid.h>
+#   endif
+#   define XO_BENCH_HAS_PERF 1
+#else
+#   define XO_BENCH_HAS_PERF 0
+#endif
+
+namespace bench {
+enum Counter {
+    Cycles,
+    Instructions,
+    L1DMisses,
+    BranchMisses,
+    FrontendStalls,
+    BackendStalls,
+    FPAssists,
+    CounterCount
+};
+
+// Counts for one run, or per op once divided. Negative for a counter that isn't there.
+struct Counts {
+    double value[CounterCount];
+
+    static Counts None() {
+        Counts c;
+        for (double& v : c.value) v = -1.0;
+        return c;
+    }
+
+    Counts PerOp(double ops) const {
+        Counts c = *this;
+        for (double& v : c.value) v = v < 0.0 ? v : v / ops;
+        return c;
+    }
+};
+
+class PerfCounters {
+public:
+    // The process wide set, closed until Open.
+    static PerfCounters& Instance() {
+        static PerfCounters counters;
+        return counters;
+    }
+
+    ~PerfCounters() {
+        Close();
+    }
+
+    // Opens what it can and says what it couldn't. True when any counter opened.
+    bool Open();
+    void Close();
+
+    bool Active() const {
+        return active;
+    }
+
+    void Start();
+    Counts Stop();
+
+private:
+    PerfCounters() {
+        for (int& fd : fds) fd = -1;
+    }
+
+    int fds[CounterCount];
+    bool active = false;
+};
+
+#if XO_BENCH_HAS_PERF
+namespace perf {
+inline int OpenEvent(uint32_t type, uint64_t config) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // More events than hardware counters get multiplexed, these say how long each ran.
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+// The raw config of the floating point assist event on this CPU, 0 when there isn't one.
+inline uint64_t AssistEvent() {
+    if (char const* env = getenv("XO_BENCH_ASSIST_EVENT")) {
+        return strtoull(env, nullptr, 0);
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned a, b, c, d;
+    char vendor[13] = {};
+    if (!__get_cpuid(0, &a, &b, &c, &d)) return 0;
+    memcpy(vendor, &b, 4);
+    memcpy(vendor + 4, &d, 4);
+    memcpy(vendor + 8, &c, 4);
+    if (strcmp(vendor, "GenuineIntel") != 0 || !__get_cpuid(1, &a, &b, &c, &d)) return 0;
+    unsigned const family = (a >> 8) & 0xF;
+    unsigned const model = ((a >> 4) & 0xF) | (((a >> 16) & 0xF) << 4);
+    if (family != 6) return 0;
+    // Sandy Bridge through the Skylake derivatives have FP_ASSIST.ANY, Ice Lake and later
+    // ASSISTS.FP.
+    switch (model) {
+    case 0x66: case 0x6A: case 0x6C: case 0x7D: case 0x7E: case 0x8C: case 0x8D:
+    case 0x8F: case 0x97: case 0x9A: case 0xA7: case 0xAA: case 0xAC: case 0xAD:
+    case 0xAE: case 0xB7: case 0xBA: case 0xBD: case 0xBF: case 0xC5: case 0xC6:
+    case 0xCF:
+        return 0x02C1;
+    default:
+        return model >= 0x2A ? 0x1ECA : 0;
+    }
+#else
+    return 0;
+#endif
+}
+} // ::bench::perf
+
+inline bool PerfCounters::Open() {
+    Close();
+    uint64_t const l1dReadMiss = PERF_COUNT_HW_CACHE_L1D
+                               | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                               | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    uint64_t const assist = perf::AssistEvent();
+    fds[Cycles] = perf::OpenEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    fds[Instructions] = perf::OpenEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    fds[L1DMisses] = perf::OpenEvent(PERF_TYPE_HW_CACHE, l1dReadMiss);
+    fds[BranchMisses] = perf::OpenEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    fds[FrontendStalls] = perf::OpenEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_FRONTEND);
+    fds[BackendStalls] = perf::OpenEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND);
+    fds[FPAssists] = assist ? perf::OpenEvent(PERF_TYPE_RAW, assist) : -1;
+
+    char const* const names[CounterCount] = {
+        "cycles", "instructions", "L1D read misses", "branch misses",
+        "front end stalls", "back end stalls", "fp assists"
+    };
+    for (int i = 0; i < CounterCount; ++i) {
+        active = active || fds[i] >= 0;
+        if (fds[i] < 0) {
+            fprintf(stderr, "perf counter %s isn't available\n", names[i]);
+        }
+    }
+    return active;
+}
+
+inline void PerfCounters::Close() {
+    for (int& fd : fds) {
+        if (fd >= 0) close(fd);
+        fd = -1;
+    }
+    active = false;
+}
+
+inline void PerfCounters::Start() {
+    for (int fd : fds) {
+        if (fd < 0) continue;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+inline Counts PerfCounters::Stop() {
+    for (int fd : fds) {
+        if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+    Counts counts = Counts::None();
+    for (int i = 0; i < CounterCount; ++i) {
+        uint64_t data[3];   // value, time enabled, time running
+        if (fds[i] < 0 || read(fds[i], data, sizeof(data)) != sizeof(data) || data[2] == 0) continue;
+        // Scaled up for the share of the time it was multiplexed out.
+        counts.value[i] = double(data[0]) * double(data[1]) / double(data[2]);
+    }
+    return counts;
+}
+#else
+inline bool PerfCounters::Open() {
+    fprintf(stderr, "perf counters are only available on Linux\n");
+    return false;
+}
+
+inline void PerfCounters::Close() { }
+inline void PerfCounters::Start() { }
+inline Counts PerfCounters::Stop() { return Counts::None(); }
+#endif
+} // ::bench
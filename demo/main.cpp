@@ -1,7 +1,10 @@
 // warning C4530: C++ exception handler used, but unwind semantics are not enabled.
 // warning C4577: 'noexcept' used with no exception handling mode specified; termination on exception is not guaranteed.
 #pragma warning(disable : 4530 4577)
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <vector>
 
 #define XO_MATH_IMPL
 #include "xo-math.h"
@@ -12,11 +15,103 @@ using namespace xo::simd;
 
 #define TestScalar(exec, expect) \
     { float res = exec; if(xo::CloseEnough(res, expect) == false) { Fail(#exec " != " #expect, __LINE__); cout << "\tgot:" << res << endl; } else { Pass(#exec " == " #expect, __LINE__); } }
+#define TestTrue(exec) \
+    { if((exec) == false) { Fail(#exec, __LINE__); } else { Pass(#exec, __LINE__); } }
+
+// Largest difference between two arrays, relative to the larger value where that's over 1.
+float MaxError(float const* left, float const* right, size_t count) {
+    float error = 0.f;
+    for (size_t i = 0; i < count; ++i) {
+        error = Max(error, Abs(left[i] - right[i]) / Max(1.f, Abs(left[i]), Abs(right[i])));
+    }
+    return error;
+}
+
+float MaxError(Vector3 const* left, Vector3 const* right, size_t count) {
+    float error = 0.f;
+    for (size_t i = 0; i < count; ++i) {
+        error = Max(error, MaxError(&left[i].x, &right[i].x, 3));
+    }
+    return error;
+}
+
+bool Aligned(void const* p, size_t alignment) {
+    return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+}
+
+// The batch operations on fixed inputs, every result in one array, to compare the kernels
+// against the plain loops. Long enough for the wide kernels and a tail.
+std::vector<float> RunBatch() {
+    size_t const count = 37;
+    Vector3 a3[count], b3[count], out3[count];
+    Vector4 a4[count], b4[count], out4[count];
+    Quaternion qa[count], qb[count], outq[count];
+    Matrix4x4 ma[count], mb[count], outm[count];
+    float t[count], dots[count];
+    for (size_t i = 0; i < count; ++i) {
+        a3[i] = Vector3(i * 0.5f - 9.f, 3.f - i, i * 0.25f + 1.f);
+        b3[i] = Vector3(2.f + i * 0.125f, i * 0.75f - 4.f, 5.25f - i * 0.5f);
+        a4[i] = Vector4(a3[i].x, a3[i].y, a3[i].z, 1.5f - i * 0.1f);
+        b4[i] = Vector4(b3[i].x, b3[i].y, b3[i].z, 0.5f + i * 0.2f);
+        qa[i] = Quaternion::RotationAxisAngle(a3[i].Normalized(), i * 0.1f);
+        qb[i] = Quaternion::RotationAxisAngle(b3[i].Normalized(), 2.f - i * 0.1f);
+        t[i] = i / float(count);
+        ma[i] = Matrix4x4::RotationYawPitchRoll(i * 0.1f, 0.5f - i * 0.05f, 1.f) * Matrix4x4::Translation(b3[i]);
+        mb[i] = Matrix4x4::Scale(Vector3(1.f + i * 0.1f, 2.f, 0.5f)) * Matrix4x4::Translation(a3[i]);
+        mb[i].rows[0].w = i * 0.01f;
+    }
+    Matrix4x4 const m = Matrix4x4::RotationYawPitchRoll(0.3f, -1.1f, 2.f) * Matrix4x4::Translation(Vector3(-4.f, 5.f, 6.f));
+
+    std::vector<float> results;
+    auto Append3 = [&]() { for (Vector3 const& v : out3) results.insert(results.end(), { v.x, v.y, v.z }); };
+    auto Append4 = [&]() { for (Vector4 const& v : out4) results.insert(results.end(), { v.x, v.y, v.z, v.w }); };
+    auto AppendQ = [&]() { for (Quaternion const& q : outq) results.insert(results.end(), { q.i, q.j, q.k, q.r }); };
+    auto AppendDots = [&]() { results.insert(results.end(), dots, dots + count); };
+
+    batch::Add(a3, b3, out3, count); Append3();
+    batch::Subtract(a3, b3, out3, count); Append3();
+    batch::Multiply(a3, b3, out3, count); Append3();
+    batch::Divide(a3, b3, out3, count); Append3();
+    batch::DotProduct(a3, b3, dots, count); AppendDots();
+    batch::CrossProduct(a3, b3, out3, count); Append3();
+    batch::Normalize(a3, out3, count, Precision::Exact); Append3();
+    batch::Lerp(a3, b3, 0.3f, out3, count); Append3();
+    batch::Add(a4, b4, out4, count); Append4();
+    batch::Subtract(a4, b4, out4, count); Append4();
+    batch::Multiply(a4, b4, out4, count); Append4();
+    batch::Divide(a4, b4, out4, count); Append4();
+    batch::DotProduct(a4, b4, dots, count); AppendDots();
+    batch::Normalize(a4, out4, count, Precision::Exact); Append4();
+    batch::Lerp(a4, b4, 0.3f, out4, count); Append4();
+    batch::Rotate(qa[5], a3, out3, count); Append3();
+    batch::Rotate(qa, a3, out3, count); Append3();
+    batch::Slerp(qa, qb, t, outq, count); AppendQ();
+    batch::Nlerp(qa, qb, t, outq, count, Precision::Exact); AppendQ();
+    m.TransformPoints(a3, out3, count); Append3();
+    m.TransformDirections(a3, out3, count); Append3();
+    m.TransformHomogeneous(a4, out4, count); Append4();
+    Matrix4x4::Multiply(ma, mb, outm, count);
+    for (Matrix4x4 const& product : outm) results.insert(results.end(), product.v, product.v + 16);
+    return results;
+}
+
+// Calls f with the plain loops and then with each kernel set the cpu has, and puts back the
+// kernels that were active.
+template<typename F>
+void ForEachKernels(F f) {
+    simd::eXO_SSE const initial = batch::ActiveKernels();
+    for (eXO_SSE version : { eXO_SSE::eXO_SSE_NONE, eXO_SSE::eXO_AVX2, eXO_SSE::eXO_AVX512 }) {
+        if (batch::UseKernels(version) && batch::ActiveKernels() == version) f();
+    }
+    batch::UseKernels(initial);
+}
 
 int main()
 {
     cout << "Compiling with sse: " << SSEVersionName << endl;
     cout << "Compiling with neon: " << NEONVersionName << endl;
+    cout << "Running with sse: " << SSEGetRuntimeName() << endl;
+    cout << "Batch kernels: " << SSEGetName(batch::ActiveKernels()) << endl;
     int passed = 0, failed = 0;
     auto Fail = [&failed](char const* statement, int line) {
         cout << "main.cpp(" << line << ") failed: " << statement << endl;
@@ -52,6 +147,541 @@ int main()
     TestScalar(Lerp(0.f, 10.f, 1.f), 10.f);
     TestScalar(Lerp(0.f, 10.f, 2.f), 20.f);
     TestScalar(Lerp(0.f, 10.f, -1.f), -10.f);
+    TestScalar(Vector4::DotProduct(Vector4(1.f, 2.f, 3.f, 4.f), Vector4(1.f)), 10.f);
+    TestScalar(Vector3::CrossProduct(Vector3::Right, Vector3::Up).z, 1.f);
+    TestScalar((Matrix4x4::Scale(Vector3(2.f)) * Matrix4x4::Translation(Vector3(1.f, 2.f, 3.f))).rows[3].z, 3.f);
+    TestScalar(Matrix4x4::Scale(Vector3(2.f)).Transform(Vector3(1.f, 2.f, 3.f)).y, 4.f);
+
+    {
+        Matrix4x4 const m = Matrix4x4::Translation(Vector3(10.f, 20.f, 30.f));
+        Vector3 point(1.f, 2.f, 3.f), direction(1.f, 2.f, 3.f);
+        m.TransformPoints(&point, &point, 1);
+        m.TransformDirections(&direction, &direction, 1);
+        TestScalar(point.x, 11.f);
+        TestScalar(point.y, 22.f);
+        TestScalar(point.z, 33.f);
+        TestScalar(direction.z, 3.f);
+
+        Vector4 homogeneous(1.f, 2.f, 3.f, 1.f);
+        m.TransformHomogeneous(&homogeneous, &homogeneous, 1);
+        TestScalar(homogeneous.x, 11.f);
+        TestScalar(homogeneous.z, 33.f);
+        TestScalar(homogeneous.w, 1.f);
+    }
+    {
+        // Long enough to run the wide kernels and a tail.
+        size_t const count = 37;
+        Vector3 in[count], out[count], expect[count];
+        for (size_t i = 0; i < count; ++i) {
+            in[i] = Vector3(i * 0.5f - 9.f, 3.f - i, i * 0.25f);
+        }
+        Matrix4x4 const m = Matrix4x4::RotationYawPitchRoll(0.3f, -1.1f, 2.f) * Matrix4x4::Translation(Vector3(-4.f, 5.f, 6.f));
+        Matrix3x4 const affine(m);
+        m.TransformPoints(in, out, count);
+        for (size_t i = 0; i < count; ++i) expect[i] = affine.TransformPoint(in[i]);
+        TestTrue(MaxError(out, expect, count) < 1e-5f);
+
+        // Homogeneous (p, 1) lands on TransformPoints(p) with w still 1, in every kernel set.
+        Vector4 homogeneous[count];
+        ForEachKernels([&]() {
+            for (size_t i = 0; i < count; ++i) homogeneous[i] = Vector4(in[i].x, in[i].y, in[i].z, 1.f);
+            m.TransformHomogeneous(homogeneous, homogeneous, count);
+            float w = 0.f;
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = Vector3(homogeneous[i].x, homogeneous[i].y, homogeneous[i].z);
+                w = Max(w, Abs(homogeneous[i].w - 1.f));
+            }
+            TestTrue(MaxError(out, expect, count) < 1e-5f);
+            TestTrue(w < 1e-6f);
+        });
+
+        // Multiply is operator * on every pair, in place too, in every kernel set.
+        Matrix4x4 left[count], right[count], products[count], expectProducts[count];
+        AMatrix4x4 alignedLeft[count], alignedRight[count];
+        for (size_t i = 0; i < count; ++i) {
+            left[i] = Matrix4x4::RotationYawPitchRoll(i * 0.1f, 0.5f, -0.2f) * Matrix4x4::Translation(in[i]);
+            right[i] = Matrix4x4::Scale(Vector3(2.f, 1.f + i * 0.1f, 0.5f)) * m;
+            right[i].rows[2].w = 0.25f;
+            expectProducts[i] = left[i] * right[i];
+            std::copy(right[i].v, right[i].v + 16, alignedRight[i].v);
+        }
+        ForEachKernels([&]() {
+            Matrix4x4::Multiply(left, right, products, count);
+            float error = 0.f;
+            for (size_t i = 0; i < count; ++i) error = Max(error, MaxError(products[i].v, expectProducts[i].v, 16));
+            TestTrue(error < 1e-5f);
+
+            for (size_t i = 0; i < count; ++i) std::copy(left[i].v, left[i].v + 16, alignedLeft[i].v);
+            AMatrix4x4::Multiply(alignedLeft, alignedRight, alignedLeft, count);
+            error = 0.f;
+            for (size_t i = 0; i < count; ++i) error = Max(error, MaxError(alignedLeft[i].v, expectProducts[i].v, 16));
+            TestTrue(error < 1e-5f);
+        });
+
+        Quaternion const q = Quaternion::RotationAxisAngle(Vector3(1.f, 2.f, -2.f).Normalized(), 0.7f);
+        batch::Rotate(q, in, out, count);
+        for (size_t i = 0; i < count; ++i) expect[i] = q.Rotate(in[i]);
+        TestTrue(MaxError(out, expect, count) < 1e-5f);
+    }
+    {
+        Vector3d point(1.0, 2.0, 3.0);
+        batch::TransformPoints(ToDouble(Matrix4x4::Translation(Vector3(10.f, 20.f, 30.f))), &point, &point, 1);
+        TestScalar(static_cast<float>(point.x()), 11.f);
+        TestScalar(static_cast<float>(point.y()), 22.f);
+        TestScalar(static_cast<float>(point.z()), 33.f);
+
+        size_t const count = 37;
+        Vector3d in[count], out[count];
+        Vector3 rounded[count], expect[count];
+        for (size_t i = 0; i < count; ++i) {
+            in[i] = Vector3d(i * 0.5 - 9.0, 3.0 - i, i * 0.25);
+        }
+        Matrix4x4 const m = Matrix4x4::RotationYawPitchRoll(0.3f, -1.1f, 2.f) * Matrix4x4::Translation(Vector3(-4.f, 5.f, 6.f));
+        Matrix3x4 const affine(m);
+        batch::TransformPoints(ToDouble(m), in, out, count);
+        for (size_t i = 0; i < count; ++i) {
+            rounded[i] = ToFloat(out[i]);
+            expect[i] = affine.TransformPoint(ToFloat(in[i]));
+        }
+        TestTrue(MaxError(rounded, expect, count) < 1e-5f);
+    }
+    {
+        // Every kernel set the cpu has against the plain loops, then back to the default.
+        simd::eXO_SSE const initial = batch::ActiveKernels();
+        batch::UseKernels(eXO_SSE::eXO_SSE_NONE);
+        std::vector<float> const expect = RunBatch();
+        for (eXO_SSE version : { eXO_SSE::eXO_AVX2, eXO_SSE::eXO_AVX512 }) {
+            if (batch::UseKernels(version) && batch::ActiveKernels() == version) {
+                std::vector<float> const results = RunBatch();
+                TestTrue(results.size() == expect.size() && MaxError(results.data(), expect.data(), expect.size()) < 1e-5f);
+            }
+        }
+        batch::UseKernels(initial);
+    }
+    {
+        // Empty spans may be null. Nothing to compare, this is for -fsanitize=undefined.
+        ForEachKernels([&]() {
+            Vector3* v3 = nullptr;
+            Vector4* v4 = nullptr;
+            Quaternion* q = nullptr;
+            Matrix4x4 const m = Matrix4x4::Identity;
+            batch::Add(v3, v3, v3, 0);
+            batch::Normalize(v3, v3, 0);
+            batch::Lerp(v4, v4, 0.5f, v4, 0);
+            batch::Normalize(v4, v4, 0);
+            batch::Rotate(Quaternion::Identity, v3, v3, 0);
+            batch::Slerp(q, q, nullptr, q, 0);
+            batch::RelativeTo(static_cast<Vector3d*>(nullptr), Vector3d(1.0, 2.0, 3.0), v3, 0);
+            batch::TransformPoints(ToDouble(m), static_cast<Vector3d*>(nullptr), nullptr, 0);
+            batch::ToHalf(v3, static_cast<Half3*>(nullptr), 0);
+            batch::FromHalf(static_cast<Half4*>(nullptr), v4, 0);
+            batch::Pack(q, static_cast<PackedQuaternion48*>(nullptr), 0);
+            batch::Unpack(static_cast<PackedQuaternion32*>(nullptr), q, 0);
+            m.TransformPoints(v3, v3, 0);
+            m.TransformHomogeneous(v4, v4, 0);
+            Matrix4x4::Multiply(nullptr, nullptr, nullptr, 0);
+        });
+    }
+    {
+        size_t const count = 7;
+        Matrix4x4 left[count], right[count], out[count];
+        for (size_t i = 0; i < count; ++i) {
+            left[i] = Matrix4x4::RotationYawPitchRoll(i * 0.4f, 0.2f - i * 0.3f, 1.f) * Matrix4x4::Translation(Vector3(i * 1.f, -2.f, 3.f));
+            right[i] = Matrix4x4::Scale(Vector3(1.f + i * 0.5f, 2.f, 0.5f)) * Matrix4x4::RotationRoll(i * 0.7f);
+        }
+        Matrix4x4::Multiply(left, right, out, count);
+        float error = 0.f;
+        for (size_t i = 0; i < count; ++i) {
+            Matrix4x4 const expect = left[i] * right[i];
+            error = Max(error, MaxError(out[i].v, expect.v, 16));
+        }
+        TestTrue(error < 1e-5f);
+    }
+    {
+        // A general matrix, nothing affine about it, times its inverse both ways round.
+        Matrix4x4 const m(Vector4(2.f, -1.f, 0.5f, 3.f), Vector4(0.f, 4.f, 1.f, -2.f),
+                          Vector4(1.f, 0.25f, -3.f, 0.f), Vector4(0.5f, 2.f, 1.f, 1.f));
+        Matrix4x4 const inverse = Matrix4x4::Invert(m);
+        TestTrue(MaxError((m * inverse).v, Matrix4x4::Identity.v, 16) < 1e-5f);
+        TestTrue(MaxError((inverse * m).v, Matrix4x4::Identity.v, 16) < 1e-5f);
+        Matrix4x4 safe;
+        TestTrue(Matrix4x4::InvertSafe(m, safe) && MaxError(safe.v, inverse.v, 16) == 0.f);
+        TestTrue(Matrix4x4::InvertSafe(Matrix4x4::Scale(Vector3(1.f, 0.f, 1.f)), safe) == false);
+
+        AMatrix4x4 const a(AVector4(2.f, -1.f, 0.5f, 3.f), AVector4(0.f, 4.f, 1.f, -2.f),
+                           AVector4(1.f, 0.25f, -3.f, 0.f), AVector4(0.5f, 2.f, 1.f, 1.f));
+        TestTrue(MaxError(AMatrix4x4::Invert(a).v, inverse.v, 16) == 0.f);
+    }
+    {
+        Matrix4x4 const rigid = Matrix4x4::RotationYawPitchRoll(0.3f, -1.1f, 2.f) * Matrix4x4::Translation(Vector3(-4.f, 5.f, 6.f));
+        Matrix4x4 const affine = Matrix4x4::Scale(Vector3(2.f, 0.5f, 3.f)) * rigid;
+        TestTrue(Matrix4x4::IsAffine(affine));
+        TestTrue(Matrix4x4::IsOrthonormal(rigid));
+        TestTrue(Matrix4x4::IsOrthonormal(affine) == false);
+        TestTrue(MaxError(Matrix4x4::InvertAffine(affine).v, Matrix4x4::Invert(affine).v, 16) < 1e-5f);
+        TestTrue(MaxError(Matrix4x4::InvertOrthonormal(rigid).v, Matrix4x4::Invert(rigid).v, 16) < 1e-5f);
+    }
+    {
+        Vector3 const axis = Vector3(1.f, 2.f, -2.f).Normalized(), translation(-4.f, 5.f, 6.f), scale(2.f, 0.5f, 3.f);
+        Matrix4x4 const a = Matrix4x4::Scale(scale) * Matrix4x4::RotationAxisAngle(axis, 0.7f) * Matrix4x4::Translation(translation);
+        Matrix4x4 const b = Matrix4x4::RotationYawPitchRoll(0.3f, -1.1f, 2.f) * Matrix4x4::Translation(Vector3(1.f, 2.f, 3.f));
+        Matrix3x4 const a34(a), b34(b);
+        TestTrue(MaxError(a34.ToMatrix4x4().v, a.v, 16) == 0.f);
+        TestTrue(MaxError((a34 * b34).v, Matrix3x4(a * b).v, 12) < 1e-5f);
+        TestTrue(MaxError(Matrix3x4::Invert(a34).v, Matrix3x4(Matrix4x4::Invert(a)).v, 12) < 1e-5f);
+        TestTrue(MaxError(Matrix3x4::FromTRS(translation, Quaternion::RotationAxisAngle(axis, 0.7f), scale).v, a34.v, 12) < 1e-5f);
+        Vector3 const direction = a34.TransformDirection(Vector3(1.f, -2.f, 0.5f));
+        Vector3 const expect = a34.TransformPoint(Vector3(1.f, -2.f, 0.5f)) - a34.GetTranslation();
+        TestTrue(MaxError(&direction, &expect, 1) < 1e-5f);
+    }
+    {
+        Vector3 const a(1.f, 2.f, 3.f), b(-4.f, 0.5f, 2.f), c(0.25f, -1.f, 8.f);
+        float const t = 0.3f, s = 2.5f;
+        Vector3 const eager = a + (b - a) * t + c * s;
+        Vector3 const evaluated = lazy::Evaluate(lazy::Of(a) + (lazy::Of(b) - lazy::Of(a)) * t + lazy::Of(c) * s);
+        TestTrue(MaxError(&evaluated, &eager, 1) < 1e-6f);
+        Vector4 const a4(1.f, 2.f, 3.f, 4.f), b4(2.f, -1.f, 0.5f, 8.f);
+        Vector4 const eager4 = -(a4 / b4) - b4 * 2.f, evaluated4 = lazy::Evaluate(-(lazy::Of(a4) / lazy::Of(b4)) - 2.f * lazy::Of(b4));
+        TestTrue(MaxError(eager4.v, evaluated4.v, 4) < 1e-6f);
+
+        // Long enough for the FloatN blocks and a tail, and written over one of its inputs.
+        size_t const count = 37;
+        Vector3 positions[count], velocities[count], expect[count];
+        for (size_t i = 0; i < count; ++i) {
+            positions[i] = Vector3(i * 0.5f - 9.f, 3.f - i, i * 0.25f);
+            velocities[i] = Vector3(2.f + i * 0.125f, i * 0.75f - 4.f, 5.f - i * 0.5f);
+            expect[i] = positions[i] + velocities[i] * t;
+        }
+        lazy::Evaluate(lazy::Of(positions, count) + lazy::Of(velocities, count) * t, positions);
+        TestTrue(MaxError(positions, expect, count) < 1e-6f);
+    }
+    {
+        // Each Precision within its documented relative error, taking the looser bounds of
+        // the build without SSE.
+        float fast = 0.f, fastest = 0.f;
+        bool exact = true;
+        for (int i = 0; i < 2000; ++i) {
+            float const x = 1e-6f + i * i * 0.37f;
+            float const expect = 1.f / std::sqrt(x);
+            exact = exact && InverseSqrt(x, Precision::Exact) == expect;
+            fast = Max(fast, Abs(InverseSqrt(x, Precision::Fast) - expect) / expect);
+            fastest = Max(fastest, Abs(InverseSqrt(x, Precision::Fastest) - expect) / expect);
+        }
+        TestTrue(exact);
+        TestTrue(fast < 5e-6f);
+        TestTrue(fastest < 2.5e-3f);
+
+        Vector3 in[37], out[37];
+        for (int i = 0; i < 37; ++i) {
+            in[i] = Vector3(i * 0.5f - 9.f, 3.f - i, i * 0.25f + 1.f);
+        }
+        TestScalar(in[4].Normalized(Precision::Exact).Magnitude(), 1.f);
+        TestTrue(Abs(in[4].Normalized(Precision::Fast).Magnitude() - 1.f) < 1e-5f);
+        // Squared lengths under FLT_MIN, down to denormals, still normalize.
+        Vector3 const tiny = Vector3(3e-20f, 4e-20f, 0.f).Normalized(Precision::Fast);
+        TestTrue(Abs(tiny.x - 0.6f) < 1e-5f && Abs(tiny.y - 0.8f) < 1e-5f);
+        for (int i = 0; i < 37; i += 3) {
+            in[i] *= i < 18 ? 1e-19f : 3e-21f;
+        }
+        ForEachKernels([&]() {
+            for (Precision precision : { Precision::Fast, Precision::Fastest }) {
+                float length = 0.f;
+                batch::Normalize(in, out, 37, precision);
+                for (Vector3 const& v : out) length = Max(length, Abs(v.Magnitude() - 1.f));
+                TestTrue(length < (precision == Precision::Fast ? 1e-5f : 2.5e-3f));
+            }
+        });
+    }
+    {
+        Quaternion const a = Quaternion::RotationAxisAngle(Vector3(1.f, 2.f, -2.f).Normalized(), 0.7f);
+        Quaternion const b = Quaternion::RotationAxisAngle(Vector3(-3.f, 0.f, 4.f).Normalized(), 2.1f);
+        Vector3 const v(1.f, -2.f, 0.5f);
+        // a * b rotates by b and then a, Rotate is ToMatrix().Transform.
+        Vector3 const product = (a * b).Rotate(v), twice = a.Rotate(b.Rotate(v)), matrix = a.ToMatrix().Transform(v);
+        Vector3 const rotated = a.Rotate(v);
+        TestTrue(MaxError(&product, &twice, 1) < 1e-5f);
+        TestTrue(MaxError(&rotated, &matrix, 1) < 1e-5f);
+        TestTrue(Abs(rotated.Magnitude() - v.Magnitude()) < 1e-5f);
+
+        size_t const count = 37;
+        Quaternion rotations[count];
+        Vector3 in[count], out[count], expect[count];
+        for (size_t i = 0; i < count; ++i) {
+            rotations[i] = Quaternion::RotationAxisAngle(Vector3(i * 0.37f - 5.f, 3.f - i * 0.2f, 1.f).Normalized(), i * 0.47f - 8.f);
+            in[i] = Vector3(i * 0.5f - 9.f, 3.f - i, i * 0.25f);
+            expect[i] = rotations[i].Rotate(in[i]);
+        }
+        batch::Rotate(rotations, in, out, count);
+        TestTrue(MaxError(out, expect, count) < 1e-5f);
+    }
+    {
+        // Against Quaternion::Slerp, with every other end negated for the shorter arc.
+        size_t const count = 37;
+        Quaternion start[count], end[count], out[count];
+        float t[count];
+        for (size_t i = 0; i < count; ++i) {
+            start[i] = Quaternion::RotationAxisAngle(Vector3(i * 0.37f - 5.f, 3.f - i * 0.2f, 1.f).Normalized(), i * 0.47f - 8.f);
+            end[i] = Quaternion::RotationAxisAngle(Vector3(1.f, i * 0.3f - 4.f, 2.f).Normalized(), 3.f - i * 0.21f);
+            if (i % 2) end[i] = -end[i];
+            t[i] = i / float(count - 1);
+        }
+        float slerp = 0.f, nlerp = 0.f;
+        batch::Slerp(start, end, t, out, count);
+        for (size_t i = 0; i < count; ++i) {
+            Quaternion const expect = Quaternion::Slerp(start[i], end[i], t[i]);
+            slerp = Max(slerp, MaxError(&out[i].i, &expect.i, 4));
+        }
+        batch::Nlerp(start, end, t, out, count, Precision::Exact);
+        for (size_t i = 0; i < count; ++i) {
+            nlerp = Max(nlerp, Abs(out[i].Magnitude() - 1.f));
+        }
+        TestTrue(slerp < 1e-5f);
+        TestTrue(nlerp < 1e-6f);
+        // t = 0 is the start, even for Nlerp.
+        TestTrue(MaxError(&out[0].i, &start[0].i, 4) < 1e-6f);
+    }
+    {
+        // Within the documented 1.2e-7 of the double results up to 1e5, std::sin and
+        // std::cos past that.
+        double error = 0.0;
+        for (int i = -20000; i <= 20000; ++i) {
+            float const x = i * 5.0000763f;
+            float s, c;
+            SinCos(x, s, c);
+            error = std::max(error, std::max(std::fabs(s - std::sin(double(x))), std::fabs(c - std::cos(double(x)))));
+            error = std::max(error, std::max(std::fabs(Sin(x) - double(s)), std::fabs(Cos(x) - double(c))));
+        }
+        TestTrue(error < 1.2e-7);
+        TestTrue(Sin(3e5f) == std::sin(3e5f) && Cos(-3e5f) == std::cos(-3e5f));
+    }
+    {
+        // Structure of arrays lanes against the same math one Vector3 at a time.
+        Vector3 a[8], b[8], out[8], expect[8];
+        for (int i = 0; i < 8; ++i) {
+            a[i] = Vector3(i * 0.5f - 2.f, 3.f - i, i * 0.25f + 1.f);
+            b[i] = Vector3(2.f + i * 0.125f, i * 0.75f - 4.f, 5.25f - i * 0.5f);
+            expect[i] = Vector3::Lerp(Vector3::CrossProduct(a[i], b[i]), b[i], 0.3f).Normalized(Precision::Exact);
+        }
+        Vector3x8 const wide = Vector3x8::Lerp(Vector3x8::CrossProduct(Vector3x8::Gather(a), Vector3x8::Gather(b)), Vector3x8::Gather(b), 0.3f);
+        wide.Normalized(Precision::Exact).Scatter(out);
+        TestTrue(MaxError(out, expect, 8) < 1e-6f);
+        float dots[8];
+        Vector3x8::DotProduct(Vector3x8::Gather(a), Vector3x8::Gather(b)).Store(dots);
+        float const dot = Vector3::DotProduct(a[3], b[3]);
+        TestTrue(MaxError(&dots[3], &dot, 1) < 1e-6f);
+
+        // The count versions zero the lanes past count and leave the rest of out alone.
+        Vector3x4 const partial = Vector3x4::Gather(a, 3);
+        Vector3 const lane2 = partial.Get(2), lane3 = partial.Get(3);
+        TestTrue(MaxError(&lane2, &a[2], 1) == 0.f && MaxError(&lane3, &Vector3::Zero, 1) == 0.f);
+        partial.Scatter(out, 3);
+        TestTrue(MaxError(out, a, 3) == 0.f && MaxError(&out[3], &expect[3], 1) < 1e-6f);
+    }
+    {
+        // The generic templates are constexpr, so these checks are compile time.
+        constexpr Vector3i a(1, -2, 3), b(4, 5, -6);
+        static_assert(Vector3i::Min(a, b) == Vector3i(1, -2, -6), "");
+        static_assert(Vector3i::Max(a, b) == Vector3i(4, 5, 3), "");
+        static_assert(Vector3i::CrossProduct(a, b) == Vector3i(-3, 18, 13), "");
+        static_assert(a.RoughlyEqual(a) && !a.RoughlyEqual(b), "");
+        static_assert(a.x() == 1 && a.y() == -2 && a.z() == 3, "");
+        constexpr Vector<3, float> f = a.Cast<float>();
+        static_assert(f.RoughlyEqual(Vector<3, float>(1.f, -2.f, 3.f)), "");
+        static_assert(!f.RoughlyEqual(f + Vector<3, float>(1e-3f)), "");
+        constexpr Matrix<2, 2, int32_t> m(Vector2i(1, 2), Vector2i(3, 4));
+        constexpr Matrix<2, 2, double> d(Vector<2, double>(1.0, 2.0), Vector<2, double>(3.0, 4.0));
+        static_assert(m.Cast<double>().RoughlyEqual(d), "");
+        static_assert((m * m.Transposed()).Transform(Vector2i(1, -1)) == Vector2i(-6, -14), "");
+        TestScalar(f.Magnitude(), Sqrt(14.f));
+    }
+    {
+        TestTrue(FloatToHalf(1.f) == 0x3C00 && FloatToHalf(-2.f) == 0xC000 && FloatToHalf(65504.f) == 0x7BFF);
+        TestTrue(FloatToHalf(1e-8f) == 0 && FloatToHalf(70000.f) == 0x7C00);
+        TestScalar(HalfToFloat(0x3555), 0.333251953f);
+        Vector3 const v(0.1f, -250.f, 3.14159f);
+        Vector3 const back = Half3(v).ToVector3();
+        TestTrue(MaxError(&back, &v, 1) < 1.f / 2048.f);
+
+        // Each kernel set gives the scalar conversions' bits, 37 for the blocks and a tail.
+        size_t const count = 37;
+        Vector3 in[count], out[count];
+        Half3 halves[count];
+        for (size_t i = 0; i < count; ++i) {
+            in[i] = Vector3(i * 0.37f - 9.f, 3.f - i * 11.f, i * 0.0013f);
+        }
+        ForEachKernels([&]() {
+            batch::ToHalf(in, halves, count);
+            batch::FromHalf(halves, out, count);
+            bool same = true;
+            for (size_t i = 0; i < count; ++i) {
+                Half3 const h(in[i]);
+                Vector3 const v3 = h.ToVector3();
+                same = same && halves[i].x == h.x && halves[i].y == h.y && halves[i].z == h.z
+                            && out[i].x == v3.x && out[i].y == v3.y && out[i].z == v3.z;
+            }
+            TestTrue(same);
+        });
+    }
+    {
+        // Packing keeps the rotation, q or -q, to the documented error per component.
+        size_t const count = 37;
+        Quaternion in[count], out[count];
+        PackedQuaternion32 packed32[count];
+        PackedQuaternion48 packed48[count];
+        float error32 = 0.f, error48 = 0.f;
+        auto Error = [](Quaternion const& q, Quaternion back) {
+            if (Quaternion::DotProduct(q, back) < 0.f) back = -back;
+            return Max(Max(Abs(back.i - q.i), Abs(back.j - q.j)), Max(Abs(back.k - q.k), Abs(back.r - q.r)));
+        };
+        for (size_t i = 0; i < count; ++i) {
+            Vector3 const axis = Vector3(i * 0.37f - 5.f, 3.f - i * 0.2f, 1.f).Normalized();
+            in[i] = Quaternion::RotationAxisAngle(axis, i * 0.47f - 8.f);
+            error32 = Max(error32, Error(in[i], PackedQuaternion32(in[i]).ToQuaternion()));
+            error48 = Max(error48, Error(in[i], PackedQuaternion48(in[i]).ToQuaternion()));
+        }
+        TestTrue(error32 < 1.8e-3f);
+        TestTrue(error48 < 5.4e-5f);
+
+        // Every path packs the same bits, unpacking can be a last bit off.
+        ForEachKernels([&]() {
+            bool same = true;
+            float unpackError = 0.f;
+            batch::Pack(in, packed32, count);
+            batch::Unpack(packed32, out, count);
+            for (size_t i = 0; i < count; ++i) {
+                same = same && packed32[i].bits == PackedQuaternion32(in[i]).bits;
+                unpackError = Max(unpackError, Error(packed32[i].ToQuaternion(), out[i]));
+            }
+            batch::Pack(in, packed48, count);
+            batch::Unpack(packed48, out, count);
+            for (size_t i = 0; i < count; ++i) {
+                PackedQuaternion48 const p(in[i]);
+                for (int w = 0; w < 3; ++w) same = same && packed48[i].words[w] == p.words[w];
+                unpackError = Max(unpackError, Error(packed48[i].ToQuaternion(), out[i]));
+            }
+            TestTrue(same);
+            TestTrue(unpackError < 1e-6f);
+        });
+    }
+    {
+        Vector3 const axes[] = { Vector3::Right, Vector3::Up, Vector3::Forward, -Vector3::Right, -Vector3::Up, -Vector3::Forward };
+        bool exact = true;
+        for (Vector3 const& axis : axes) {
+            Vector3 const back32 = PackedNormal32(axis).ToVector3(), back16 = PackedNormal16(axis).ToVector3();
+            exact = exact && MaxError(&back32, &axis, 1) == 0.f && MaxError(&back16, &axis, 1) == 0.f;
+        }
+        TestTrue(exact);
+
+        // Unit vectors back within the documented angles, 0.004 and 0.95 degrees. The sine
+        // from the cross product is the angle closely enough at these sizes.
+        size_t const count = 37;
+        Vector3 in[count], out[count];
+        PackedNormal32 packed32[count];
+        PackedNormal16 packed16[count];
+        float angle32 = 0.f, angle16 = 0.f, length = 0.f;
+        for (size_t i = 0; i < count; ++i) {
+            in[i] = Vector3(i * 0.37f - 5.f, 3.f - i * 0.2f, i % 2 ? 1.f : -2.f).Normalized(Precision::Exact);
+            Vector3 const back32 = PackedNormal32(in[i]).ToVector3(), back16 = PackedNormal16(in[i]).ToVector3();
+            angle32 = Max(angle32, Vector3::CrossProduct(in[i], back32).Magnitude());
+            angle16 = Max(angle16, Vector3::CrossProduct(in[i], back16).Magnitude());
+            length = Max(length, Max(Abs(back32.Magnitude() - 1.f), Abs(back16.Magnitude() - 1.f)));
+        }
+        TestTrue(angle32 < 0.004f * Deg2Rad && angle16 < 0.95f * Deg2Rad);
+        TestTrue(length < 1e-6f);
+
+        // Every path packs the same bits, unpacking can be a last bit off.
+        ForEachKernels([&]() {
+            bool same = true;
+            float unpackError = 0.f;
+            batch::Pack(in, packed32, count);
+            batch::Unpack(packed32, out, count);
+            for (size_t i = 0; i < count; ++i) {
+                PackedNormal32 const p(in[i]);
+                Vector3 const v = p.ToVector3();
+                same = same && packed32[i].x == p.x && packed32[i].y == p.y;
+                unpackError = Max(unpackError, MaxError(&out[i], &v, 1));
+            }
+            batch::Pack(in, packed16, count);
+            batch::Unpack(packed16, out, count);
+            for (size_t i = 0; i < count; ++i) {
+                PackedNormal16 const p(in[i]);
+                Vector3 const v = p.ToVector3();
+                same = same && packed16[i].x == p.x && packed16[i].y == p.y;
+                unpackError = Max(unpackError, MaxError(&out[i], &v, 1));
+            }
+            TestTrue(same);
+            TestTrue(unpackError < 1e-6f);
+        });
+    }
+    {
+        bool aligned = true;
+        for (size_t alignment : { 1, 16, 64, 4096 }) {
+            for (size_t size : { 0, 1, 100, 100000 }) {
+                void* const memory = AlignedMalloc(size, alignment);
+                aligned = aligned && memory && Aligned(memory, alignment);
+                AlignedFree(memory);
+            }
+        }
+        TestTrue(aligned);
+        AlignedVector<AVector4> vectors(37);
+        AlignedVector<Vector4, 64> lines;
+        for (int i = 0; i < 100; ++i) lines.push_back(Vector4(float(i)));
+        TestTrue(Aligned(vectors.data(), 16) && Aligned(lines.data(), 64) && lines[99].w == 99.f);
+        AMatrix4x4* const single = new AMatrix4x4(AMatrix4x4::Identity);
+        AVector4* const array = new AVector4[5];
+        TestTrue(Aligned(single, 16) && Aligned(array, 16));
+        delete single;
+        delete[] array;
+    }
+    {
+        // Through a volatile so the products happen at run time, under the current setting.
+        float volatile tiny = 1e-39f;
+        bool const before = GetFlushDenormals();
+        bool supported;
+        {
+            ScopedFlushDenormals flush;
+            supported = GetFlushDenormals();
+            TestTrue(!supported || tiny * 0.5f == 0.f);
+            bool const was = SetFlushDenormals(false);
+            TestTrue(was == supported && GetFlushDenormals() == false);
+            TestTrue(before || tiny * 0.5f != 0.f);
+        }
+        TestTrue(GetFlushDenormals() == before);
+        bool const was = SetFlushDenormals(true);
+        TestTrue(was == before && GetFlushDenormals() == supported);
+        SetFlushDenormals(was);
+        TestTrue(GetFlushDenormals() == before);
+    }
+    {
+        // Small blocks so the later sizes and alignments need new ones, one bigger than a block.
+        FrameArena arena(1024);
+        void* const first = arena.Allocate(3, 16);
+        bool aligned = Aligned(first, 16);
+        for (size_t alignment : { 4, 32, 64, 128, 256, 4096 }) {
+            for (size_t size : { 1, 100, 700, 3000 }) {
+                aligned = aligned && Aligned(arena.Allocate(size, alignment), alignment);
+            }
+        }
+        AMatrix4x4* const palette = arena.Allocate<AMatrix4x4>(40, 64);
+        aligned = aligned && Aligned(palette, 64) && Aligned(arena.Allocate<AVector4>(3), alignof(AVector4));
+        TestTrue(aligned);
+        arena.Reset();
+        TestTrue(arena.Allocate(3, 16) == first);
+
+        // 300 slots runs past the first block, a freed slot is the next one handed out.
+        Pool<Vector3, 64> pool(256);
+        Vector3* slots[300];
+        aligned = true;
+        for (Vector3*& slot : slots) {
+            slot = pool.Allocate();
+            aligned = aligned && Aligned(slot, 64);
+        }
+        TestTrue(aligned);
+        pool.Free(slots[17]);
+        TestTrue(pool.Allocate() == slots[17]);
+        pool.Reset();
+        TestTrue(pool.Allocate() == slots[0]);
+    }
     
     //{float a = xo::Lerp(1.f, 2.f, 0.5f); XO_UNUSED(a); }
     //{float a = xo::RelativeEpsilon(10.f); XO_UNUSED(a); }
@@ -68,6 +68,7 @@ namespace xo{
 // please read about epsilon before using it
 // see: http://realtimecollisiondetection.net/blog/?p=89
 constexpr float MachineEpsilon = std::numeric_limits<float>::epsilon();
+constexpr double MachineEpsilonDouble = std::numeric_limits<double>::epsilon();
 
 constexpr float Deg2Rad = 0.0174532925f;
 constexpr float Rad2Deg = 57.2957795f;
@@ -77,8 +78,12 @@ constexpr float Rad2Deg = 57.2957795f;
 ////////////////////////////////////////////////////////////////////////////////////////// end xo-math-constants.h inline
 ////////////////////////////////////////////////////////////////////////////////////////// xo-math-macros.h inlined
 #line 4 "xo-math-macros.h"
-#include <new.h>
+#include <cstddef>
 #include <cstdlib>
+#include <new>
+#if defined(_MSC_VER) || defined(__MINGW32__)
+#   include <malloc.h>
+#endif
 // xo-math calling convention.
 // See License in third-party-licenses.h for https://github.com/Microsoft/DirectXMath
 // applies to the exact version checking for __vectorcall
@@ -98,108 +103,72 @@ constexpr float Rad2Deg = 57.2957795f;
 #endif
 
 #define XO_ALN_16               alignas(16)
-#define XO_ALN_16_MALLOC(size)  _aligned_malloc(size, 16)
-#define XO_ALN_16_FREE(mem)     free(mem)
-
-// will never call a constructor, as it's intended for our math types...
-#define XO_NEW_DEL_16(typeName) \
-    void* operator new(size_t count) { \
-        void* m = XO_ALN_16_MALLOC(count); \
-        return static_cast<typeName*>(m); \
-    } \
-    void* operator new[](size_t count) { \
-        void* m = XO_ALN_16_MALLOC(count*sizeof(typeName)); \
-        return static_cast<typeName*>(m); \
-    } 
-
-#define XO_UNUSED(code) (void)code
-////////////////////////////////////////////////////////////////////////////////////////// end xo-math-macros.h inline
-////////////////////////////////////////////////////////////////////////////////////////// xo-math-utilities.h inlined
-#line 7 "xo-math-utilities.h"
-namespace xo
-{
-template<typename T> constexpr XO_INL T Abs(T num)          { return num >= 0 ? num : -num; }
-template<typename T> constexpr XO_INL T Max(T a, T b)       { return a > b ? a : b; }
-template<typename T> constexpr XO_INL T Max(T a, T b, T c)  { return Max(Max(a, b), c); }
-template<typename T> constexpr XO_INL T Min(T a, T b)       { return a < b ? a : b; }
-template<typename T> constexpr XO_INL T Min(T a, T b, T c)  { return Min(Min(a, b), c); }
+#define XO_ALN_16_MALLOC(size)  xo::AlignedMalloc(size, 16)
+#define XO_ALN_16_FREE(mem)     xo::AlignedFree(mem)
 
-constexpr XO_INL float Clamp(float val, float minVal, float maxVal) {
-    return Max(Min(val, maxVal), minVal);
+namespace xo {
+// 'size' bytes aligned to 'alignment', a power of two, or nullptr when out of memory.
+// Free it with AlignedFree, never free() or delete.
+XO_INL void* AlignedMalloc(size_t size, size_t alignment) {
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    return _aligned_malloc(size ? size : 1, alignment);
+#else
+    // posix_memalign wants at least pointer alignment, and a unique pointer for size 0.
+    void* memory = nullptr;
+    alignment = alignment < sizeof(void*) ? sizeof(void*) : alignment;
+    return posix_memalign(&memory, alignment, size ? size : 1) == 0 ? memory : nullptr;
+#endif
 }
 
-float WrapMinMax(float val, float minVal, float maxVal);
-
-constexpr XO_INL float Lerp(float start, float end, float t) {
-    return start + t * (end-start);
+XO_INL void AlignedFree(void* memory) {
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    _aligned_free(memory);
+#else
+    free(memory);
+#endif
 }
 
-constexpr XO_INL float RelativeEpsilon(float a)          { return MachineEpsilon * Max(1.f, Abs(a)); }
-constexpr XO_INL float RelativeEpsilon(float a, float b) { return MachineEpsilon * Max(1.f, Abs(a), Abs(b)); }
-
-// See: http://realtimecollisiondetection.net/blog/?p=89
-// Example accuracy:
-// CloseEnough(0.00000001f, 0.00000009f) == true
-// CloseEnough(0.0000001f,  0.0000009f) == false
-constexpr XO_INL bool CloseEnough(float left, float right) {
-    return Abs(left - right) <= RelativeEpsilon(left, right);
+// AlignedMalloc for operator new: throws std::bad_alloc instead of returning nullptr.
+XO_INL void* AlignedNew(size_t size, size_t alignment) {
+    void* memory = AlignedMalloc(size, alignment);
+    if (!memory) throw std::bad_alloc();
+    return memory;
 }
+} // ::xo
 
-float Sqrt(float val);
-float Pow(float val, int power);
-template<int power> XO_INL float Pow(float val) { return Pow(val, power); }
-template<> float XO_INL Pow<2>(float val) { return val*val; }
-template<> float XO_INL Pow<3>(float val) { return val * val * val; }
-
-float Sin(float val);
-float Cos(float val);
-float ASin(float val);
-float ACos(float val);
-void SinCos(float val, float& sinOut, float& cosOut);
-void ASinACos(float val, float& asinOut, float& acosOut);
+// Class operators new and delete for the A types, whose alignment plain new doesn't
+// guarantee before C++17. 'size' is in bytes for both forms, for arrays it's the whole
+// block. The placement forms are here because declaring any operator new in a class hides
+// the global ones.
+#define XO_NEW_DEL_16(typeName) \
+    static void* operator new(size_t size) { return xo::AlignedNew(size, 16); } \
+    static void* operator new[](size_t size) { return xo::AlignedNew(size, 16); } \
+    static void* operator new(size_t, void* where) noexcept { return where; } \
+    static void* operator new[](size_t, void* where) noexcept { return where; } \
+    static void operator delete(void* memory) noexcept { xo::AlignedFree(memory); } \
+    static void operator delete[](void* memory) noexcept { xo::AlignedFree(memory); } \
+    static void operator delete(void*, void*) noexcept { } \
+    static void operator delete[](void*, void*) noexcept { }
 
+#define XO_UNUSED(code) (void)code
+////////////////////////////////////////////////////////////////////////////////////////// end xo-math-macros.h inline
+////////////////////////////////////////////////////////////////////////////////////////// xo-math-detect-simd.h inlined
+#line 5 "xo-math-detect-simd.h"
 #if defined(XO_MATH_IMPL)
-float WrapMinMax(float val, float minVal, float maxVal) {
-    if (CloseEnough(val, minVal) || CloseEnough(val, maxVal)) {
-        return val;
-    }
-    else if (val > 0.f) {
-        return fmod(val, maxVal) + minVal;
-    }
-    else {
-        return maxVal - fmod(Abs(val), maxVal) + minVal;
-    }
-}
-
-float Sqrt(float val) { return std::sqrt(val); }
-float Pow(float val, int power) { return std::pow(val, power); }
-float Sin(float val) { return std::sin(val); }
-float Cos(float val) { return std::cos(val); }
-float ASin(float val) { return std::asin(val); }
-float ACos(float val) { return std::acos(val); }
-
-void SinCos(float val, float& sinOut, float& cosOut) {
-    sinOut = Sin(val);
-    cosOut = Cos(val);
-}
-
-void ASinACos(float val, float& asinOut, float& acosOut) {
-    asinOut = ASin(val);
-    acosOut = ACos(val);
-}
+#   if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#       include <intrin.h>
+#   elif (defined(__clang__) || defined(__GNUC__)) && (defined(__x86_64__) || defined(__i386__))
+#       include <cpuid.h>
+#   endif
 #endif
-
-XO_INL constexpr float operator "" _deg2rad(long double num) {
-    return static_cast<float>(num) * xo::Deg2Rad;
-}
-
-} // ::xo
-
-////////////////////////////////////////////////////////////////////////////////////////// end xo-math-utilities.h inline
-////////////////////////////////////////////////////////////////////////////////////////// xo-math-detect-simd.h inlined
-#line 4 "xo-math-detect-simd.h"
 namespace xo { namespace simd {
 
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#   define XO_X86 1
+#else
+#   define XO_X86 0
+#endif
+
 #define XO_SSE_NONE 0x00
 #define XO_SSE1     0x10
 #define XO_SSE2     0x20
@@ -262,6 +231,20 @@ namespace xo { namespace simd {
 #    define XO_HAS_SSE 1
 #endif
 
+// FMA3 is its own flag (-mfma) on gcc and clang, msvc enables it along with /arch:AVX2
+#if defined(__FMA__) || (defined(_MSC_VER) && XO_SSE_CURRENT >= XO_AVX2)
+#   define XO_HAS_FMA 1
+#else
+#   define XO_HAS_FMA 0
+#endif
+
+// So is F16C (-mf16c), msvc has no flag for it and uses it from /arch:AVX2 on
+#if defined(__F16C__) || (defined(_MSC_VER) && XO_SSE_CURRENT >= XO_AVX2)
+#   define XO_HAS_F16C 1
+#else
+#   define XO_HAS_F16C 0
+#endif
+
 enum class eXO_SSE : uint8_t
 {
     eXO_SSE_NONE    = XO_SSE_NONE,
@@ -297,6 +280,87 @@ constexpr char const* SSEGetName(eXO_SSE version = eXO_SSE::eXO_SSE_CURRENT)
 
 constexpr char const* SSEVersionName = SSEGetName();
 
+// XO_SSE_CURRENT is what the compiler was asked to target. The runtime version is what the
+// machine running the code supports, checked with cpuid and xgetbv (so an AVX capable cpu
+// on an OS that doesn't save the wider registers reports the level below AVX).
+// XO_AVX2 is only reported along with FMA3 and F16C, XO_AVX512 means AVX512F.
+// The result is computed once and cached.
+eXO_SSE SSEGetRuntimeVersion();
+char const* SSEGetRuntimeName();
+
+#if defined(XO_MATH_IMPL)
+namespace {
+bool CPUID(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) {
+#   if XO_X86 && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (static_cast<uint32_t>(info[0]) < leaf) return false;
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i) regs[i] = static_cast<uint32_t>(info[i]);
+    return true;
+#   elif XO_X86 && (defined(__clang__) || defined(__GNUC__))
+    if (__get_cpuid_max(0, nullptr) < leaf) return false;
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+    return true;
+#   else
+    XO_UNUSED(leaf);
+    XO_UNUSED(subleaf);
+    XO_UNUSED(regs);
+    return false;
+#   endif
+}
+
+// Which register states the OS saves on a context switch. Only valid with OSXSAVE.
+uint64_t XGETBV() {
+#   if XO_X86 && defined(_MSC_VER)
+    return _xgetbv(0);
+#   elif XO_X86 && (defined(__clang__) || defined(__GNUC__))
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+#   else
+    return 0;
+#   endif
+}
+
+eXO_SSE DetectRuntimeVersion() {
+    uint32_t r1[4];
+    if (!CPUID(1, 0, r1)) return eXO_SSE::eXO_SSE_NONE;
+    uint32_t const ecx = r1[2], edx = r1[3];
+    if (!(edx & (1u << 25))) return eXO_SSE::eXO_SSE_NONE;
+    if (!(edx & (1u << 26))) return eXO_SSE::eXO_SSE1;
+    if (!(ecx & (1u << 0)))  return eXO_SSE::eXO_SSE2;
+    if (!(ecx & (1u << 9)))  return eXO_SSE::eXO_SSE3;
+    if (!(ecx & (1u << 19))) return eXO_SSE::eXO_SSSE3;
+    if (!(ecx & (1u << 20))) return eXO_SSE::eXO_SSE4_1;
+
+    bool const osxsave = (ecx & (1u << 27)) != 0;
+    uint64_t const xcr0 = osxsave ? XGETBV() : 0;
+    bool const ymm = (xcr0 & 0x6) == 0x6;             // xmm and ymm state
+    bool const zmm = (xcr0 & 0xE6) == 0xE6;           // ... plus opmask and zmm state
+    if (!(ecx & (1u << 28)) || !ymm) return eXO_SSE::eXO_SSE4_2;
+
+    uint32_t r7[4];
+    if (!CPUID(7, 0, r7)) return eXO_SSE::eXO_AVX;
+    uint32_t const ebx7 = r7[1];
+    bool const fma = (ecx & (1u << 12)) != 0;
+    bool const f16c = (ecx & (1u << 29)) != 0;
+    if (!(ebx7 & (1u << 5)) || !fma || !f16c) return eXO_SSE::eXO_AVX;
+    if (!(ebx7 & (1u << 16)) || !zmm) return eXO_SSE::eXO_AVX2;
+    return eXO_SSE::eXO_AVX512;
+}
+} // ::xo::simd::anonymous
+
+eXO_SSE SSEGetRuntimeVersion() {
+    static eXO_SSE const version = DetectRuntimeVersion();
+    return version;
+}
+
+char const* SSEGetRuntimeName() {
+    return SSEGetName(SSEGetRuntimeVersion());
+}
+#endif
+
 #define XO_NEON_NONE 0x00
 #define XO_NEON7     0x70
 
@@ -349,12 +413,313 @@ constexpr char const* NEONVersionName = NEONGetName();
 
 } } // ::xo::simd
 ////////////////////////////////////////////////////////////////////////////////////////// end xo-math-detect-simd.h inline
+////////////////////////////////////////////////////////////////////////////////////////// xo-math-utilities.h inlined
+#line 8 "xo-math-utilities.h"
+#include <cmath>
+#include <cstring>
+#if XO_HAS_SSE
+#   include <xmmintrin.h>
+#endif
+namespace xo
+{
+template<typename T> constexpr XO_INL T Abs(T num)          { return num >= 0 ? num : -num; }
+template<typename T> constexpr XO_INL T Max(T a, T b)       { return a > b ? a : b; }
+template<typename T> constexpr XO_INL T Max(T a, T b, T c)  { return Max(Max(a, b), c); }
+template<typename T> constexpr XO_INL T Min(T a, T b)       { return a < b ? a : b; }
+template<typename T> constexpr XO_INL T Min(T a, T b, T c)  { return Min(Min(a, b), c); }
+
+constexpr XO_INL float Clamp(float val, float minVal, float maxVal) {
+    return Max(Min(val, maxVal), minVal);
+}
+
+float WrapMinMax(float val, float minVal, float maxVal);
+
+constexpr XO_INL float Lerp(float start, float end, float t) {
+    return start + t * (end-start);
+}
+
+constexpr XO_INL float RelativeEpsilon(float a)          { return MachineEpsilon * Max(1.f, Abs(a)); }
+constexpr XO_INL float RelativeEpsilon(float a, float b) { return MachineEpsilon * Max(1.f, Abs(a), Abs(b)); }
+constexpr XO_INL double RelativeEpsilon(double a)           { return MachineEpsilonDouble * Max(1.0, Abs(a)); }
+constexpr XO_INL double RelativeEpsilon(double a, double b) { return MachineEpsilonDouble * Max(1.0, Abs(a), Abs(b)); }
+
+// See: http://realtimecollisiondetection.net/blog/?p=89
+// Example accuracy:
+// CloseEnough(0.00000001f, 0.00000009f) == true
+// CloseEnough(0.0000001f,  0.0000009f) == false
+constexpr XO_INL bool CloseEnough(float left, float right) {
+    return Abs(left - right) <= RelativeEpsilon(left, right);
+}
+constexpr XO_INL bool CloseEnough(double left, double right) {
+    return Abs(left - right) <= RelativeEpsilon(left, right);
+}
+
+float Sqrt(float val);
+
+// How Normalize, Normalized and InverseSqrt get 1/sqrt(x).
+// Exact: sqrt and divide, both correctly rounded.
+// Fast: the hardware estimate refined by one Newton-Raphson step, within a few ulp.
+// Fastest: the hardware estimate alone, relative error below 1.5 * 2^-12 (2^-14 where
+// AVX512 rsqrt14 is used).
+// Without SSE the estimate is the integer shift trick plus one Newton-Raphson step (about
+// 2e-3 relative error), and Fast takes a second step (about 5e-6).
+// The default for the member functions is XO_CONFIG_DEFAULT_PRECISION.
+enum class Precision : uint8_t { Exact, Fast, Fastest };
+
+// rsqrtss and rsqrtps read a denormal as 0 and give infinity, and the shift trick is no
+// better there, so Fast and Fastest scale values under FLT_MIN up by 2^64 before the
+// estimate and the result by 2^32 after it. Both are exact, so short vectors normalize as
+// well as with Exact. AVX512 rsqrt14 takes denormals as they are.
+namespace rsqrt {
+constexpr float Tiny = std::numeric_limits<float>::min();
+constexpr float ScaleUp = 18446744073709551616.f;  // 2^64
+constexpr float ScaleBack = 4294967296.f;          // 2^32
+} // ::xo::rsqrt
+
+XO_INL float InverseSqrt(float val, Precision precision) {
+    if (precision == Precision::Exact) {
+        return 1.f / std::sqrt(val);
+    }
+    float scale = 1.f;
+    if (val < rsqrt::Tiny) {
+        val *= rsqrt::ScaleUp;
+        scale = rsqrt::ScaleBack;
+    }
+#if XO_HAS_SSE
+    float estimate = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(val)));
+#else
+    uint32_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    bits = 0x5F375A86u - (bits >> 1);
+    float estimate;
+    std::memcpy(&estimate, &bits, sizeof(estimate));
+    estimate = estimate * (1.5f - (0.5f * val * estimate) * estimate);
+#endif
+    if (precision == Precision::Fastest) {
+        return estimate * scale;
+    }
+    return estimate * (1.5f - (0.5f * val * estimate) * estimate) * scale;
+}
+
+float Pow(float val, int power);
+template<int power> XO_INL float Pow(float val) { return Pow(val, power); }
+template<> float XO_INL Pow<2>(float val) { return val*val; }
+template<> float XO_INL Pow<3>(float val) { return val * val * val; }
+
+// Sin, Cos and SinCos don't call into libm. One Cody-Waite reduction by pi/2 is shared by
+// a minimax polynomial for each of sin and cos on [-pi/4, pi/4].
+// Error against the correctly rounded result: at most 2 ulp for |val| <= pi. Up to
+// |val| <= 1e5 the absolute error stays below 1.2e-7, but right next to the zeros of sin
+// and cos (tiny results) that can be tens of ulp. Larger inputs go through std::sin and
+// std::cos. The FloatN versions in xo-math-wide.h run the same code on 4, 8 or 16 lanes,
+// without the fallback. bench/bench-trig.cpp measures both against libm.
+float Sin(float val);
+float Cos(float val);
+float ASin(float val);
+float ACos(float val);
+void SinCos(float val, float& sinOut, float& cosOut);
+void ASinACos(float val, float& asinOut, float& acosOut);
+
+namespace trig {
+constexpr float TwoOverPi = 0.636619772f;
+// pi/2 in four parts, the first three short enough that k times them is exact for
+// |k| < 2^16.
+constexpr float PiOver2A = 1.5703125f;
+constexpr float PiOver2B = 4.84466552734375e-4f;
+constexpr float PiOver2C = -6.4074993133544922e-7f;
+constexpr float PiOver2D = 9.9209362947050295e-10f;
+// Past this the reduction loses bits.
+constexpr float MaxReducible = 1e5f;
+// 1.5 * 2^23: adding and then subtracting it rounds |x| < 2^22 to the nearest integer.
+constexpr float RoundMagic = 12582912.f;
+
+// F is float or an xo::FloatN, the body only needs +, -, * and F(float).
+template<typename F>
+XO_INL void SinCos(F const& val, F& sinOut, F& cosOut) {
+    F const magic(RoundMagic);
+    F const k = (val * F(TwoOverPi) + magic) - magic;
+    F const r = (((val - k * F(PiOver2A)) - k * F(PiOver2B)) - k * F(PiOver2C)) - k * F(PiOver2D);
+    F const r2 = r * r;
+    F const s = r + r * r2 * (F(-1.6666654611e-1f) + r2 * (F(8.3321608736e-3f) + r2 * F(-1.9515295891e-4f)));
+    F const c = (F(1.f) - r2 * F(0.5f))
+              + r2 * r2 * (F(4.166664568298827e-2f) + r2 * (F(-1.388731625493765e-3f) + r2 * F(2.443315711809948e-5f)));
+
+    // Quadrant k: odd k swaps sin and cos, odd k/2 flips both signs. Selecting with a
+    // multiply by 0 or 1 keeps it branch free and exact.
+    F const half = ((k * F(0.5f) - F(0.25f)) + magic) - magic;     // floor(k / 2)
+    F const odd = k - half * F(2.f);
+    F const flip = half - (((half * F(0.5f) - F(0.25f)) + magic) - magic) * F(2.f);
+    F const even = F(1.f) - odd;
+    F const sign = F(1.f) - flip * F(2.f);
+    sinOut = sign * (s * even + c * odd);
+    cosOut = sign * (c * even - s * odd);
+}
+} // ::xo::trig
+
+// Slerp weights without acos or sin, from D. Eberly, "A Fast and Accurate Algorithm for
+// Computing SLERP". For unit quaternions at an angle a with cosine = cos(a) in [0, 1],
+// Weight(cosine, t) is sin(t a) / sin(a) as a series in t and cosine - 1. The series is cut
+// at Terms, with the last term scaled by Mu to make up for the rest: the error stays below
+// 8e-7 for t in [0, 1].
+namespace slerp {
+constexpr int Terms = 12;
+constexpr float Mu = 1.895f;
+// Term i multiplies by (U[i] t^2 - V[i]) (cosine - 1), U = 1 / (n (2n + 1)) and
+// V = n / (2n + 1) for n = i + 1.
+constexpr float U[Terms] = {
+    1.f / 3, 1.f / 10, 1.f / 21, 1.f / 36, 1.f / 55, 1.f / 78,
+    1.f / 105, 1.f / 136, 1.f / 171, 1.f / 210, 1.f / 253, Mu / 300 };
+constexpr float V[Terms] = {
+    1.f / 3, 2.f / 5, 3.f / 7, 4.f / 9, 5.f / 11, 6.f / 13,
+    7.f / 15, 8.f / 17, 9.f / 19, 10.f / 21, 11.f / 23, Mu * 12 / 25 };
+
+// F is float or an xo::FloatN, like trig::SinCos.
+template<typename F>
+XO_INL F Weight(F const& cosine, F const& t) {
+    F const xm1 = cosine - F(1.f);
+    F const tt = t * t;
+    F r(1.f);
+    for (int i = Terms - 1; i >= 0; --i) {
+        r = F(1.f) + (F(U[i]) * tt - F(V[i])) * xm1 * r;
+    }
+    return t * r;
+}
+} // ::xo::slerp
+
+// Denormals, the floats below FLT_MIN, go through a microcode assist on most x86 cores:
+// a hundred cycles or more per op where it's otherwise 4. Anything that decays toward zero,
+// like damped velocities or a Lerp chasing its target, ends up there. Flushing them makes
+// denormal results 0 (FTZ) and reads denormal inputs as 0 (DAZ), at full speed.
+// The setting is in MXCSR (FPCR on ARM64), which is per thread. ScopedFlushDenormals sets
+// it for a scope and puts back what was there, SetFlushDenormals(true) at the start of each
+// worker thread sets it for good. Whether a new thread inherits it from its creator
+// depends on the OS, so set it in every thread rather than counting on that.
+// Without SSE or ARM64 (x87 code included) they do nothing and report false.
+//
+//     void Worker() {
+//         xo::SetFlushDenormals(true);
+//         ...
+//     }
+//
+//     {
+//         xo::ScopedFlushDenormals flush;
+//         world.Step(dt);
+//     }
+namespace denormals {
+#if XO_HAS_SSE
+constexpr uint32_t Mask = 0x8040u;      // FTZ, bit 15, and DAZ, bit 6
+XO_INL uint32_t GetControl() { return _mm_getcsr(); }
+XO_INL void SetControl(uint32_t control) { _mm_setcsr(control); }
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+constexpr uint32_t Mask = 1u << 24;     // FZ, which flushes inputs and results
+XO_INL uint32_t GetControl() {
+    uint64_t fpcr;
+    __asm__ volatile("mrs %0, fpcr" : "=r"(fpcr));
+    return static_cast<uint32_t>(fpcr);
+}
+XO_INL void SetControl(uint32_t control) {
+    uint64_t const fpcr = control;
+    __asm__ volatile("msr fpcr, %0" : : "r"(fpcr));
+}
+#else
+constexpr uint32_t Mask = 0u;
+XO_INL uint32_t GetControl() { return 0u; }
+XO_INL void SetControl(uint32_t) { }
+#endif
+} // ::xo::denormals
+
+// True when denormals are flushed on this thread.
+XO_INL bool GetFlushDenormals() {
+    return denormals::Mask != 0u && (denormals::GetControl() & denormals::Mask) == denormals::Mask;
+}
+
+// Flushes denormals on this thread, or stops. Returns whether they were flushed before.
+XO_INL bool SetFlushDenormals(bool flush) {
+    bool const was = GetFlushDenormals();
+    uint32_t const control = denormals::GetControl();
+    denormals::SetControl(flush ? control | denormals::Mask : control & ~denormals::Mask);
+    return was;
+}
+
+class ScopedFlushDenormals {
+public:
+    ScopedFlushDenormals() : saved(denormals::GetControl()) {
+        denormals::SetControl(saved | denormals::Mask);
+    }
+    // Only the flush bits go back, a rounding mode set in the scope stays.
+    ~ScopedFlushDenormals() {
+        denormals::SetControl((denormals::GetControl() & ~denormals::Mask) | (saved & denormals::Mask));
+    }
+    ScopedFlushDenormals(ScopedFlushDenormals const&) = delete;
+    ScopedFlushDenormals& operator = (ScopedFlushDenormals const&) = delete;
+
+private:
+    uint32_t saved;
+};
+
+#if defined(XO_MATH_IMPL)
+float WrapMinMax(float val, float minVal, float maxVal) {
+    if (CloseEnough(val, minVal) || CloseEnough(val, maxVal)) {
+        return val;
+    }
+    else if (val > 0.f) {
+        return fmod(val, maxVal) + minVal;
+    }
+    else {
+        return maxVal - fmod(Abs(val), maxVal) + minVal;
+    }
+}
+
+float Sqrt(float val) { return std::sqrt(val); }
+float Pow(float val, int power) { return std::pow(val, power); }
+float Sin(float val) {
+    float s, c;
+    SinCos(val, s, c);
+    return s;
+}
+
+float Cos(float val) {
+    float s, c;
+    SinCos(val, s, c);
+    return c;
+}
+
+float ASin(float val) { return std::asin(val); }
+float ACos(float val) { return std::acos(val); }
+
+void SinCos(float val, float& sinOut, float& cosOut) {
+    if (Abs(val) <= trig::MaxReducible) {
+        trig::SinCos(val, sinOut, cosOut);
+    }
+    else {
+        sinOut = std::sin(val);
+        cosOut = std::cos(val);
+    }
+}
+
+void ASinACos(float val, float& asinOut, float& acosOut) {
+    asinOut = ASin(val);
+    acosOut = ACos(val);
+}
+#endif
+
+XO_INL constexpr float operator "" _deg2rad(long double num) {
+    return static_cast<float>(num) * xo::Deg2Rad;
+}
+
+} // ::xo
+
+////////////////////////////////////////////////////////////////////////////////////////// end xo-math-utilities.h inline
 
 // As an end user you can configure these values
 #define XO_CONFIG_LEFT_HANDED 1
 #define XO_CONFIG_Y_UP 1
 #define XO_CONFIG_DEFAULT_NEAR_PLANE 0.1f
 #define XO_CONFIG_DEFAULT_FAR_PLANE 1000.f
+// 1: batch functions pick AVX2/AVX512 kernels at runtime. 0: only what the build targets.
+#define XO_CONFIG_RUNTIME_DISPATCH 1
+// Normalize and Normalized use this when no xo::Precision is passed, see xo-math-utilities.h
+#define XO_CONFIG_DEFAULT_PRECISION xo::Precision::Exact
 
 // These configs can set themselves up based on the other configs above...
 #define XO_CONFIG_RIGHT_HANDED (XO_CONFIG_LEFT_HANDED == 0 ? 1 : 0)
@@ -362,23 +727,25 @@ constexpr char const* NEONVersionName = NEONGetName();
 
 #if XO_SSE_CURRENT >= XO_SSE4_1
 ////////////////////////////////////////////////////////////////////////////////////////// xo-math-sse4.h inlined
-#line 5 "xo-math-sse4.h"
-namespace xo {
-
-} // ::xo
-////////////////////////////////////////////////////////////////////////////////////////// end xo-math-sse4.h inline
+#line 19 "xo-math-sse4.h"
+#if XO_SSE_CURRENT >= XO_AVX
+#   include <immintrin.h>
 #else
-////////////////////////////////////////////////////////////////////////////////////////// xo-math-reference.h inlined
-#line 18 "xo-math-reference.h"
+#   include <smmintrin.h>
+#endif
+
 #if !defined(XO_CONFIG_DEFAULT_NEAR_PLANE)
 #   define XO_CONFIG_DEFAULT_NEAR_PLANE 0.1f
 #endif
 #if !defined(XO_CONFIG_DEFAULT_FAR_PLANE)
 #   define XO_CONFIG_DEFAULT_FAR_PLANE 1000.f
 #endif
+#if !defined(XO_CONFIG_DEFAULT_PRECISION)
+#   define XO_CONFIG_DEFAULT_PRECISION xo::Precision::Exact
+#endif
 
-#define XO_REF_ALN                  XO_ALN_16
-#define XO_REF_NEW_DEL(typeName)    XO_NEW_DEL_16(typeName)
+#define XO_SSE_ALN                  XO_ALN_16
+#define XO_SSE_NEW_DEL(typeName)    XO_NEW_DEL_16(typeName)
 
 namespace xo {
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -428,8 +795,8 @@ struct Vector3 {
     float Magnitude() const;
     float MagnitudeSquared() const;
 
-    Vector3& Normalize();
-    Vector3 Normalized() const;
+    Vector3& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+    Vector3 Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
 
     static bool XO_CC RoughlyEqual(Vector3 const& left, Vector3 const& right);
     static bool XO_CC ExactlyEqual(Vector3 const& left, Vector3 const& right);
@@ -513,8 +880,8 @@ struct Vector4 {
 
     float Magnitude() const;
     float MagnitudeSquared() const;
-    Vector4 Normalized() const;
-    Vector4& Normalize();
+    Vector4 Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+    Vector4& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
 
     static bool XO_CC RoughlyEqual(Vector4 const& left, Vector4 const& right);
     static bool XO_CC ExactlyEqual(Vector4 const& left, Vector4 const& right);
@@ -572,6 +939,29 @@ struct Matrix4x4 {
     Vector4 XO_CC Transform(Vector4 const& v4) const;
     Vector3 XO_CC InverseTransform(Vector3 const& v3) const;
     Vector4 XO_CC InverseTransform(Vector4 const& v4) const;
+
+    // Transforms 'count' vectors from in to out (which may be the same array). Points and
+    // directions are row vectors times the matrix, like InverseTransform and
+    // Matrix3x4::TransformPoint: points get the translation from rows[3], directions don't.
+    // Homogeneous is InverseTransform(Vector4), so a point with w = 1 comes out as from
+    // TransformPoints, and nothing divides by w. Strides are in bytes, for
+    // vectors that live inside larger structs. Runs 8 or 16 at a time with AVX2 or AVX512,
+    // see xo-math-batch.h.
+    void XO_CC TransformPoints(Vector3 const* in,
+                               Vector3* out,
+                               size_t count,
+                               size_t inStride = sizeof(Vector3),
+                               size_t outStride = sizeof(Vector3)) const;
+    void XO_CC TransformDirections(Vector3 const* in,
+                                   Vector3* out,
+                                   size_t count,
+                                   size_t inStride = sizeof(Vector3),
+                                   size_t outStride = sizeof(Vector3)) const;
+    void XO_CC TransformHomogeneous(Vector4 const* in,
+                                    Vector4* out,
+                                    size_t count,
+                                    size_t inStride = sizeof(Vector4),
+                                    size_t outStride = sizeof(Vector4)) const;
     Matrix4x4 XO_CC operator * (Matrix4x4 const& other) const;
     Matrix4x4& XO_CC operator *= (Matrix4x4 const& other);
 
@@ -585,9 +975,25 @@ struct Matrix4x4 {
     Vector3 Forward() const;
     Vector3 Backward() const;
 
+    // out[i] = left[i] * right[i], out may be left or right. Runs on the batch kernels, see
+    // xo-math-batch.h.
+    static void XO_CC Multiply(Matrix4x4 const* left,
+                               Matrix4x4 const* right,
+                               Matrix4x4* out,
+                               size_t count);
     static Matrix4x4 XO_CC Transpose(Matrix4x4 const& matrixIn);
     static Matrix4x4 XO_CC Invert(Matrix4x4 const& matrixIn);
     static bool XO_CC InvertSafe(Matrix4x4 const& matrixIn, Matrix4x4& matrixOut);
+    // Cheaper inverses for matrices whose last column is (0, 0, 0, 1), like the ones built
+    // by Translation, Scale, the Rotation functions, LookAt and products of them.
+    // InvertAffine inverts the upper 3x3 and moves the translation row back through it.
+    // InvertOrthonormal is for rotation and translation only (no scale or shear): the
+    // 3x3 inverse is its transpose. Neither checks its input, IsAffine and IsOrthonormal
+    // can do that in an assert. IsOrthonormal allows 1e-5 of error in the dot products.
+    static Matrix4x4 XO_CC InvertAffine(Matrix4x4 const& matrixIn);
+    static Matrix4x4 XO_CC InvertOrthonormal(Matrix4x4 const& matrixIn);
+    static bool XO_CC IsAffine(Matrix4x4 const& matrixIn);
+    static bool XO_CC IsOrthonormal(Matrix4x4 const& matrixIn);
     static Matrix4x4 XO_CC Translation(Vector3 const& pos);
     static Matrix4x4 XO_CC Scale(Vector3 const& scale);
     static Matrix4x4 XO_CC RotationYaw(float yaw);
@@ -655,11 +1061,18 @@ struct Quaternion {
     Quaternion operator + (Quaternion other) const;
     Quaternion operator * (float scalar) const;
     Quaternion operator -() const;
+    // The Hamilton product: rotating by a * b is rotating by b, then by a.
+    Quaternion XO_CC operator * (Quaternion const& other) const;
+    Quaternion& XO_CC operator *= (Quaternion const& other);
+
+    // v rotated by this, which should be normalized. The same as ToMatrix().Transform(v),
+    // without the matrix: v + 2r(q x v) + q x 2(q x v) for the vector part q.
+    Vector3 XO_CC Rotate(Vector3 const& v) const;
 
     float Magnitude() const;
     float MagnitudeSquared() const;
-    Quaternion Normalized() const;
-    Quaternion& Normalize();
+    Quaternion Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+    Quaternion& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
 
     Matrix4x4 ToMatrix() const;
 
@@ -681,8 +1094,8 @@ struct Quaternion {
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // vector 3, aligned for cpu specific optimizations (where applicable) 
-struct XO_REF_ALN AVector3 {
-    XO_REF_NEW_DEL(AVector3);
+struct XO_SSE_ALN AVector3 {
+    XO_SSE_NEW_DEL(AVector3);
     float x, y, z;
     constexpr AVector3(float x, float y, float z)
         : x(x)
@@ -728,8 +1141,8 @@ struct XO_REF_ALN AVector3 {
     float Magnitude() const;
     float MagnitudeSquared() const;
 
-    AVector3& Normalize();
-    AVector3 Normalized() const;
+    AVector3& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+    AVector3 Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
 
     static bool XO_CC RoughlyEqual(AVector3 const& left, AVector3 const& right);
     static bool XO_CC ExactlyEqual(AVector3 const& left, AVector3 const& right);
@@ -754,8 +1167,8 @@ struct XO_REF_ALN AVector3 {
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // vector 4, aligned for cpu specific optimizations (where applicable)
-struct XO_REF_ALN AVector4 {
-    XO_REF_NEW_DEL(AVector4);
+struct XO_SSE_ALN AVector4 {
+    XO_SSE_NEW_DEL(AVector4);
     union {
         struct { float x, y, z, w; };
         float v[4];
@@ -815,8 +1228,8 @@ struct XO_REF_ALN AVector4 {
 
     float Magnitude() const;
     float MagnitudeSquared() const;
-    AVector4 Normalized() const;
-    AVector4& Normalize();
+    AVector4 Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+    AVector4& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
 
     static bool XO_CC RoughlyEqual(AVector4 const& left, AVector4 const& right);
     static bool XO_CC ExactlyEqual(AVector4 const& left, AVector4 const& right);
@@ -832,8 +1245,8 @@ struct XO_REF_ALN AVector4 {
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // matrix4x4, aligned for cpu specific optimizations (where applicable)
-struct XO_REF_ALN AMatrix4x4 {
-    XO_REF_NEW_DEL(AMatrix4x4);
+struct XO_SSE_ALN AMatrix4x4 {
+    XO_SSE_NEW_DEL(AMatrix4x4);
     union {
         AVector4 rows[4];
         float v[16];
@@ -877,6 +1290,29 @@ struct XO_REF_ALN AMatrix4x4 {
     AVector3 XO_CC InverseTransform(AVector3 const& v3) const;
     AVector4 XO_CC InverseTransform(AVector4 const& v4) const;
 
+    // Transforms 'count' vectors from in to out (which may be the same array). Points and
+    // directions are row vectors times the matrix, like InverseTransform and
+    // Matrix3x4::TransformPoint: points get the translation from rows[3], directions don't.
+    // Homogeneous is InverseTransform(AVector4), so a point with w = 1 comes out as from
+    // TransformPoints, and nothing divides by w. Strides are in bytes, for
+    // vectors that live inside larger structs. Runs 8 or 16 at a time with AVX2 or AVX512,
+    // see xo-math-batch.h.
+    void XO_CC TransformPoints(AVector3 const* in,
+                               AVector3* out,
+                               size_t count,
+                               size_t inStride = sizeof(AVector3),
+                               size_t outStride = sizeof(AVector3)) const;
+    void XO_CC TransformDirections(AVector3 const* in,
+                                   AVector3* out,
+                                   size_t count,
+                                   size_t inStride = sizeof(AVector3),
+                                   size_t outStride = sizeof(AVector3)) const;
+    void XO_CC TransformHomogeneous(AVector4 const* in,
+                                    AVector4* out,
+                                    size_t count,
+                                    size_t inStride = sizeof(AVector4),
+                                    size_t outStride = sizeof(AVector4)) const;
+
     AMatrix4x4 XO_CC operator * (AMatrix4x4 const& other) const;
     AMatrix4x4& XO_CC operator *= (AMatrix4x4 const& other);
 
@@ -890,9 +1326,25 @@ struct XO_REF_ALN AMatrix4x4 {
     AVector3 Forward() const;
     AVector3 Backward() const;
 
+    // out[i] = left[i] * right[i], out may be left or right. Runs on the batch kernels, see
+    // xo-math-batch.h.
+    static void XO_CC Multiply(AMatrix4x4 const* left,
+                               AMatrix4x4 const* right,
+                               AMatrix4x4* out,
+                               size_t count);
     static AMatrix4x4 XO_CC Transpose(AMatrix4x4 const& matrixIn);
     static AMatrix4x4 XO_CC Invert(AMatrix4x4 const& matrixIn);
     static bool XO_CC InvertSafe(AMatrix4x4 const& matrixIn, AMatrix4x4& matrixOut);
+    // Cheaper inverses for matrices whose last column is (0, 0, 0, 1), like the ones built
+    // by Translation, Scale, the Rotation functions, LookAt and products of them.
+    // InvertAffine inverts the upper 3x3 and moves the translation row back through it.
+    // InvertOrthonormal is for rotation and translation only (no scale or shear): the
+    // 3x3 inverse is its transpose. Neither checks its input, IsAffine and IsOrthonormal
+    // can do that in an assert. IsOrthonormal allows 1e-5 of error in the dot products.
+    static AMatrix4x4 XO_CC InvertAffine(AMatrix4x4 const& matrixIn);
+    static AMatrix4x4 XO_CC InvertOrthonormal(AMatrix4x4 const& matrixIn);
+    static bool XO_CC IsAffine(AMatrix4x4 const& matrixIn);
+    static bool XO_CC IsOrthonormal(AMatrix4x4 const& matrixIn);
     static AMatrix4x4 XO_CC Translation(AVector3 const& pos);
     static AMatrix4x4 XO_CC Scale(AVector3 const& scale);
     static AMatrix4x4 XO_CC RotationYaw(float yaw);
@@ -927,8 +1379,8 @@ struct XO_REF_ALN AMatrix4x4 {
 
 //////////////////////////////////////////////////////////////////////////////////////////
 // quaternion, aligned for cpu specific optimizations (where applicable)
-struct XO_REF_ALN AQuaternion {
-    XO_REF_NEW_DEL(AQuaternion);
+struct XO_SSE_ALN AQuaternion {
+    XO_SSE_NEW_DEL(AQuaternion);
     union {
         struct { float i, j, k, r; };
         AVector4 vec4;
@@ -962,11 +1414,18 @@ struct XO_REF_ALN AQuaternion {
     AQuaternion operator + (AQuaternion other) const;
     AQuaternion operator * (float scalar) const;
     AQuaternion operator -() const;
+    // The Hamilton product: rotating by a * b is rotating by b, then by a.
+    AQuaternion XO_CC operator * (AQuaternion const& other) const;
+    AQuaternion& XO_CC operator *= (AQuaternion const& other);
+
+    // v rotated by this, which should be normalized. The same as ToMatrix().Transform(v),
+    // without the matrix: v + 2r(q x v) + q x 2(q x v) for the vector part q.
+    AVector3 XO_CC Rotate(AVector3 const& v) const;
 
     float Magnitude() const;
     float MagnitudeSquared() const;
-    AQuaternion Normalized() const;
-    AQuaternion& Normalize();
+    AQuaternion Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+    AQuaternion& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
 
     AMatrix4x4 ToMatrix() const;
 
@@ -986,12 +1445,246 @@ struct XO_REF_ALN AQuaternion {
     static const AQuaternion Identity;
 };
 
-////////////////////////////////////////////////////////////////////////////////////////// Vector 3
-#if defined(XO_MATH_IMPL)
-/*static*/ const Vector3 Vector3::Zero(0.f);
-/*static*/ const Vector3 Vector3::One(1.f);
-/*static*/ const Vector3 Vector3::Left(-1.f, 0.f, 0.f);
-/*static*/ const Vector3 Vector3::Right(1.f, 0.f, 0.f);
+////////////////////////////////////////////////////////////////////////////////////////// SSE helpers
+// Unaligned types go through loadu/storeu (or lane-wise for the 12 byte Vector3). The
+// aligned types can use the full 16 bytes directly, the w lane of an AVector3 is padding.
+namespace sse {
+XO_INL __m128 XO_CC Load(Vector3 const& v)       { return _mm_set_ps(0.f, v.z, v.y, v.x); }
+XO_INL __m128 XO_CC Load(Vector4 const& v)       { return _mm_loadu_ps(v.v); }
+XO_INL __m128 XO_CC Load(Quaternion const& q)    { return _mm_loadu_ps(q.vec4.v); }
+XO_INL __m128 XO_CC Load(AVector3 const& v)      { return _mm_load_ps(&v.x); }
+XO_INL __m128 XO_CC Load(AVector4 const& v)      { return _mm_load_ps(v.v); }
+XO_INL __m128 XO_CC Load(AQuaternion const& q)   { return _mm_load_ps(q.vec4.v); }
+
+XO_INL void XO_CC Store(Vector3& v, __m128 m) {
+    _mm_storel_pi(reinterpret_cast<__m64*>(&v.x), m);
+    _mm_store_ss(&v.z, _mm_movehl_ps(m, m));
+}
+XO_INL void XO_CC Store(Vector4& v, __m128 m)       { _mm_storeu_ps(v.v, m); }
+XO_INL void XO_CC Store(Quaternion& q, __m128 m)    { _mm_storeu_ps(q.vec4.v, m); }
+XO_INL void XO_CC Store(AVector3& v, __m128 m)      { _mm_store_ps(&v.x, m); }
+XO_INL void XO_CC Store(AVector4& v, __m128 m)      { _mm_store_ps(v.v, m); }
+XO_INL void XO_CC Store(AQuaternion& q, __m128 m)   { _mm_store_ps(q.vec4.v, m); }
+
+template<typename T>
+XO_INL T XO_CC Make(__m128 m) {
+    T result;
+    Store(result, m);
+    return result;
+}
+
+template<int lane>
+XO_INL __m128 XO_CC Splat(__m128 m) {
+    return _mm_shuffle_ps(m, m, _MM_SHUFFLE(lane, lane, lane, lane));
+}
+
+XO_INL __m128 XO_CC Abs(__m128 m) {
+    return _mm_andnot_ps(_mm_set1_ps(-0.f), m);
+}
+
+// Lane-wise CloseEnough, see xo-math-utilities.h
+XO_INL int XO_CC CloseEnoughMask(__m128 left, __m128 right) {
+    __m128 scale = _mm_max_ps(_mm_set1_ps(1.f), _mm_max_ps(Abs(left), Abs(right)));
+    __m128 epsilon = _mm_mul_ps(_mm_set1_ps(MachineEpsilon), scale);
+    return _mm_movemask_ps(_mm_cmple_ps(Abs(_mm_sub_ps(left, right)), epsilon));
+}
+
+XO_INL int XO_CC ExactlyEqualMask(__m128 left, __m128 right) {
+    return _mm_movemask_ps(_mm_cmpeq_ps(left, right));
+}
+
+// a * b + c, fused when the target has FMA3
+XO_INL __m128 XO_CC MultiplyAdd(__m128 a, __m128 b, __m128 c) {
+#if XO_HAS_FMA
+    return _mm_fmadd_ps(a, b, c);
+#else
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+// 1/sqrt(m) on every lane for Precision::Fast and Fastest, see xo-math-utilities.h.
+// The Newton-Raphson step is r * (1.5 - (0.5 * m * r) * r), never forming r * r, which
+// overflows for the smallest m.
+XO_INL __m128 XO_CC InverseSqrt(__m128 m, Precision precision) {
+#if XO_SSE_CURRENT >= XO_AVX512 && defined(__AVX512VL__)
+    __m128 const scale = _mm_set1_ps(1.f);
+    __m128 r = _mm_rsqrt14_ps(m);
+#else
+    // Denormals scaled into range, see xo::rsqrt.
+    __m128 const tiny = _mm_cmplt_ps(m, _mm_set1_ps(rsqrt::Tiny));
+    m = _mm_blendv_ps(m, _mm_mul_ps(m, _mm_set1_ps(rsqrt::ScaleUp)), tiny);
+    __m128 const scale = _mm_blendv_ps(_mm_set1_ps(1.f), _mm_set1_ps(rsqrt::ScaleBack), tiny);
+    __m128 r = _mm_rsqrt_ps(m);
+#endif
+    if (precision == Precision::Fastest) {
+        return _mm_mul_ps(r, scale);
+    }
+    __m128 halfMR = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), m), r);
+    return _mm_mul_ps(_mm_mul_ps(r, scale), _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(halfMR, r)));
+}
+
+#if XO_SSE_CURRENT >= XO_AVX
+XO_INL __m256 XO_CC MultiplyAdd(__m256 a, __m256 b, __m256 c) {
+#   if XO_HAS_FMA
+    return _mm256_fmadd_ps(a, b, c);
+#   else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#   endif
+}
+#endif
+
+// left x right on the xyz lanes, w comes out as 0 for finite input.
+XO_INL __m128 XO_CC CrossProduct(__m128 left, __m128 right) {
+    __m128 lyzx = _mm_shuffle_ps(left, left, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 ryzx = _mm_shuffle_ps(right, right, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 zxy = _mm_sub_ps(_mm_mul_ps(left, ryzx), _mm_mul_ps(lyzx, right));
+    return _mm_shuffle_ps(zxy, zxy, _MM_SHUFFLE(3, 0, 2, 1));
+}
+
+// The inverse of an affine matrix, given the columns of the inverse of its upper 3x3 and
+// its translation row t. The translation of the result is -t times the 3x3 inverse.
+template<typename M>
+XO_INL M XO_CC AffineInverse(__m128 c0, __m128 c1, __m128 c2, __m128 t) {
+    __m128 c3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    __m128 d = _mm_mul_ps(Splat<0>(t), c0);
+    d = MultiplyAdd(Splat<1>(t), c1, d);
+    d = MultiplyAdd(Splat<2>(t), c2, d);
+    M result;
+    Store(result.rows[0], c0);
+    Store(result.rows[1], c1);
+    Store(result.rows[2], c2);
+    Store(result.rows[3], _mm_sub_ps(_mm_setr_ps(0.f, 0.f, 0.f, 1.f), d));
+    return result;
+}
+
+// The adjugate of the row major 4x4 matrix m, returns the determinant in every lane.
+// The inverse is the adjugate divided by the determinant.
+// This is the cofactor expansion from Intel's "Streaming SIMD Extensions - Inverse of 4x4
+// Matrix" (AP-928): the matrix is transposed into registers (with rows 1 and 3 rotated by
+// two lanes), then each pair product of two rows is shuffled against the other rows to
+// build all 16 cofactors four at a time.
+XO_INL __m128 XO_CC Adjugate(float const* m, __m128 adjugate[4]) {
+    __m128 in0 = _mm_loadu_ps(m);
+    __m128 in1 = _mm_loadu_ps(m + 4);
+    __m128 in2 = _mm_loadu_ps(m + 8);
+    __m128 in3 = _mm_loadu_ps(m + 12);
+    __m128 tmp = _mm_movelh_ps(in0, in1);
+    __m128 row1 = _mm_movelh_ps(in2, in3);
+    __m128 row0 = _mm_shuffle_ps(tmp, row1, 0x88);
+    row1 = _mm_shuffle_ps(row1, tmp, 0xDD);
+    tmp = _mm_movehl_ps(in1, in0);
+    __m128 row3 = _mm_movehl_ps(in3, in2);
+    __m128 row2 = _mm_shuffle_ps(tmp, row3, 0x88);
+    row3 = _mm_shuffle_ps(row3, tmp, 0xDD);
+
+    __m128 minor0, minor1, minor2, minor3;
+    tmp = _mm_mul_ps(row2, row3);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    minor0 = _mm_mul_ps(row1, tmp);
+    minor1 = _mm_mul_ps(row0, tmp);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor0 = _mm_sub_ps(_mm_mul_ps(row1, tmp), minor0);
+    minor1 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor1);
+    minor1 = _mm_shuffle_ps(minor1, minor1, 0x4E);
+
+    tmp = _mm_mul_ps(row1, row2);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    minor0 = MultiplyAdd(row3, tmp, minor0);
+    minor3 = _mm_mul_ps(row0, tmp);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row3, tmp));
+    minor3 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor3);
+    minor3 = _mm_shuffle_ps(minor3, minor3, 0x4E);
+
+    tmp = _mm_mul_ps(_mm_shuffle_ps(row1, row1, 0x4E), row3);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    row2 = _mm_shuffle_ps(row2, row2, 0x4E);
+    minor0 = MultiplyAdd(row2, tmp, minor0);
+    minor2 = _mm_mul_ps(row0, tmp);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row2, tmp));
+    minor2 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor2);
+    minor2 = _mm_shuffle_ps(minor2, minor2, 0x4E);
+
+    tmp = _mm_mul_ps(row0, row1);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    minor2 = MultiplyAdd(row3, tmp, minor2);
+    minor3 = _mm_sub_ps(_mm_mul_ps(row2, tmp), minor3);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor2 = _mm_sub_ps(_mm_mul_ps(row3, tmp), minor2);
+    minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row2, tmp));
+
+    tmp = _mm_mul_ps(row0, row3);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row2, tmp));
+    minor2 = MultiplyAdd(row1, tmp, minor2);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor1 = MultiplyAdd(row2, tmp, minor1);
+    minor2 = _mm_sub_ps(minor2, _mm_mul_ps(row1, tmp));
+
+    tmp = _mm_mul_ps(row0, row2);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    minor1 = MultiplyAdd(row3, tmp, minor1);
+    minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row1, tmp));
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row3, tmp));
+    minor3 = MultiplyAdd(row1, tmp, minor3);
+
+    adjugate[0] = minor0;
+    adjugate[1] = minor1;
+    adjugate[2] = minor2;
+    adjugate[3] = minor3;
+    __m128 det = _mm_mul_ps(row0, minor0);
+    det = _mm_add_ps(_mm_shuffle_ps(det, det, 0x4E), det);
+    return _mm_add_ps(_mm_shuffle_ps(det, det, 0xB1), det);
+}
+
+// out = left * right for row major 4x4 float matrices. out may alias left or right.
+// Each row of the result is the rows of right weighted by the broadcast elements of the
+// same row of left. With AVX two rows of left share one 256 bit register, and each row of
+// right is broadcast into both halves.
+XO_INL void XO_CC MultiplyMatrix(float const* left, float const* right, float* out) {
+#if XO_SSE_CURRENT >= XO_AVX
+    __m256 r0 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(right));
+    __m256 r1 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(right + 4));
+    __m256 r2 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(right + 8));
+    __m256 r3 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(right + 12));
+    __m256 l01 = _mm256_loadu_ps(left);
+    __m256 l23 = _mm256_loadu_ps(left + 8);
+
+    __m256 a01 = MultiplyAdd(_mm256_permute_ps(l01, 0x55), r1,
+                             _mm256_mul_ps(_mm256_permute_ps(l01, 0x00), r0));
+    __m256 b01 = MultiplyAdd(_mm256_permute_ps(l01, 0xFF), r3,
+                             _mm256_mul_ps(_mm256_permute_ps(l01, 0xAA), r2));
+    __m256 a23 = MultiplyAdd(_mm256_permute_ps(l23, 0x55), r1,
+                             _mm256_mul_ps(_mm256_permute_ps(l23, 0x00), r0));
+    __m256 b23 = MultiplyAdd(_mm256_permute_ps(l23, 0xFF), r3,
+                             _mm256_mul_ps(_mm256_permute_ps(l23, 0xAA), r2));
+
+    _mm256_storeu_ps(out, _mm256_add_ps(a01, b01));
+    _mm256_storeu_ps(out + 8, _mm256_add_ps(a23, b23));
+#else
+    __m128 r0 = _mm_loadu_ps(right);
+    __m128 r1 = _mm_loadu_ps(right + 4);
+    __m128 r2 = _mm_loadu_ps(right + 8);
+    __m128 r3 = _mm_loadu_ps(right + 12);
+    for (int i = 0; i < 16; i += 4) {
+        __m128 row = _mm_loadu_ps(left + i);
+        __m128 a = MultiplyAdd(Splat<1>(row), r1, _mm_mul_ps(Splat<0>(row), r0));
+        __m128 b = MultiplyAdd(Splat<3>(row), r3, _mm_mul_ps(Splat<2>(row), r2));
+        _mm_storeu_ps(out + i, _mm_add_ps(a, b));
+    }
+#endif
+}
+} // ::xo::sse
+
+////////////////////////////////////////////////////////////////////////////////////////// Vector 3
+#if defined(XO_MATH_IMPL)
+/*static*/ const Vector3 Vector3::Zero(0.f);
+/*static*/ const Vector3 Vector3::One(1.f);
+/*static*/ const Vector3 Vector3::Left(-1.f, 0.f, 0.f);
+/*static*/ const Vector3 Vector3::Right(1.f, 0.f, 0.f);
 
 #   if !defined(XO_CONFIG_Y_UP) || !defined(XO_CONFIG_Z_UP)
     static_assert(false, 
@@ -1050,81 +1743,92 @@ value...");
 #   endif
 #endif
 
-XO_INL 
-Vector3 XO_CC Vector3::operator + (Vector3 const& other) const { 
-    return Vector3(x + other.x, y + other.y, z + other.z);
+XO_INL
+Vector3 XO_CC Vector3::operator + (Vector3 const& other) const {
+    return sse::Make<Vector3>(_mm_add_ps(sse::Load(*this), sse::Load(other)));
 }
 
 XO_INL
 Vector3 XO_CC Vector3::operator - (Vector3 const& other) const {
-    return Vector3(x - other.x, y - other.y, z - other.z);
+    return sse::Make<Vector3>(_mm_sub_ps(sse::Load(*this), sse::Load(other)));
 }
 
 XO_INL
 Vector3 XO_CC Vector3::operator * (Vector3 const& other) const {
-    return Vector3(x * other.x, y * other.y, z * other.z);
+    return sse::Make<Vector3>(_mm_mul_ps(sse::Load(*this), sse::Load(other)));
 }
 
 XO_INL
 Vector3 XO_CC Vector3::operator / (Vector3 const& other) const {
-    return Vector3(x / other.x, y / other.y, z / other.z);
+    return sse::Make<Vector3>(_mm_div_ps(sse::Load(*this), sse::Load(other)));
 }
 
 XO_INL
 Vector3& XO_CC Vector3::operator += (Vector3 const& other) {
-    x += other.x;
-    y += other.y;
-    z += other.z;
+    sse::Store(*this, _mm_add_ps(sse::Load(*this), sse::Load(other)));
     return *this;
 }
 
 XO_INL
 Vector3& XO_CC Vector3::operator -= (Vector3 const& other) {
-    x -= other.x;
-    y -= other.y;
-    z -= other.z;
+    sse::Store(*this, _mm_sub_ps(sse::Load(*this), sse::Load(other)));
     return *this;
 }
 
 XO_INL
 Vector3& XO_CC Vector3::operator *= (Vector3 const& other) {
-    x *= other.x;
-    y *= other.y;
-    z *= other.z;
+    sse::Store(*this, _mm_mul_ps(sse::Load(*this), sse::Load(other)));
     return *this;
 }
 
 XO_INL
 Vector3& XO_CC Vector3::operator /= (Vector3 const& other) {
-    x /= other.x;
-    y /= other.y;
-    z /= other.z;
+    sse::Store(*this, _mm_div_ps(sse::Load(*this), sse::Load(other)));
     return *this;
 }
 
-XO_INL Vector3 Vector3::operator -() const { return Vector3(-x, -y, -z); };
+XO_INL Vector3 Vector3::operator -() const {
+    return sse::Make<Vector3>(_mm_xor_ps(sse::Load(*this), _mm_set1_ps(-0.f)));
+}
 
-XO_INL float Vector3::Sum() const { return x + y + z; }
+XO_INL float Vector3::Sum() const {
+    return _mm_cvtss_f32(_mm_dp_ps(sse::Load(*this), _mm_set1_ps(1.f), 0x71));
+}
 
-XO_INL float Vector3::MagnitudeSquared() const { return ((*this) * (*this)).Sum(); }
-XO_INL float Vector3::Magnitude() const { return xo::Sqrt(MagnitudeSquared()); }
+XO_INL float Vector3::MagnitudeSquared() const {
+    __m128 m = sse::Load(*this);
+    return _mm_cvtss_f32(_mm_dp_ps(m, m, 0x71));
+}
 
-XO_INL Vector3& Vector3::Normalize() { return (*this) /= Vector3(Magnitude()); }
-XO_INL Vector3 Vector3::Normalized() const { return Vector3(*this).Normalize(); }
+XO_INL float Vector3::Magnitude() const {
+    __m128 m = sse::Load(*this);
+    return _mm_cvtss_f32(_mm_sqrt_ss(_mm_dp_ps(m, m, 0x71)));
+}
+
+XO_INL Vector3& Vector3::Normalize(Precision precision) {
+    __m128 m = sse::Load(*this);
+    __m128 magnitudeSquared = _mm_dp_ps(m, m, 0x7F);
+    if (precision == Precision::Exact) {
+        sse::Store(*this, _mm_div_ps(m, _mm_sqrt_ps(magnitudeSquared)));
+    }
+    else {
+        sse::Store(*this, _mm_mul_ps(m, sse::InverseSqrt(magnitudeSquared, precision)));
+    }
+    return *this;
+}
+
+XO_INL Vector3 Vector3::Normalized(Precision precision) const { return Vector3(*this).Normalize(precision); }
 
 /*static*/ XO_INL
 bool XO_CC Vector3::RoughlyEqual(Vector3 const& left, Vector3 const& right) {
-    return CloseEnough(left.x, right.x)
-        && CloseEnough(left.y, right.y)
-        && CloseEnough(left.z, right.z);
+    return (sse::CloseEnoughMask(sse::Load(left), sse::Load(right)) & 0x7) == 0x7;
 }
 
 /*static*/ XO_INL
 bool XO_CC Vector3::ExactlyEqual(Vector3 const& left, Vector3 const& right) {
-    return left.x == right.x
-        && left.y == right.y
-        && left.z == right.z;
+    return (sse::ExactlyEqualMask(sse::Load(left), sse::Load(right)) & 0x7) == 0x7;
 }
+
 /*static*/ XO_INL
 bool XO_CC Vector3::RoughlyEqual(Vector3 const& left, float magnitude) {
     return CloseEnough(left.MagnitudeSquared(), Pow<2>(magnitude));
@@ -1137,20 +1841,25 @@ bool XO_CC Vector3::ExactlyEqual(Vector3 const& left, float magnitude) {
 
 /*static*/ XO_INL
 float XO_CC Vector3::DotProduct(Vector3 const& left, Vector3 const& right) {
-    return (left * right).Sum();
+    return _mm_cvtss_f32(_mm_dp_ps(sse::Load(left), sse::Load(right), 0x71));
 }
 
 /*static*/ XO_INL
 Vector3 XO_CC Vector3::CrossProduct(Vector3 const& left, Vector3 const& right) {
-    return Vector3(
-        left.y * right.z - left.z * right.y,
-        left.z * right.x - left.x * right.z,
-        left.x * right.y - left.y * right.x);
+    // (l * r.yzx - l.yzx * r).yzx
+    __m128 l = sse::Load(left);
+    __m128 r = sse::Load(right);
+    __m128 lyzx = _mm_shuffle_ps(l, l, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 ryzx = _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 zxy = _mm_sub_ps(_mm_mul_ps(l, ryzx), _mm_mul_ps(lyzx, r));
+    return sse::Make<Vector3>(_mm_shuffle_ps(zxy, zxy, _MM_SHUFFLE(3, 0, 2, 1)));
 }
 
 /*static*/ XO_INL
 Vector3 XO_CC Vector3::Lerp(Vector3 const& left, Vector3 const& right, float t) {
-    return left + Vector3(t) * (right - left);
+    __m128 l = sse::Load(left);
+    __m128 r = sse::Load(right);
+    return sse::Make<Vector3>(_mm_add_ps(l, _mm_mul_ps(_mm_set1_ps(t), _mm_sub_ps(r, l))));
 }
 
 /*static*/ XO_INL
@@ -1167,88 +1876,94 @@ float XO_CC Vector3::Distance(Vector3 const& left, Vector3 const& right) {
 
 XO_INL
 Vector4 XO_CC Vector4::operator + (Vector4 const& other) const {
-    return Vector4(x + other.x, y + other.y, z + other.z, w + other.w);
+    return sse::Make<Vector4>(_mm_add_ps(sse::Load(*this), sse::Load(other)));
 }
 
 XO_INL
 Vector4 XO_CC Vector4::operator - (Vector4 const& other) const {
-    return Vector4(x - other.x, y - other.y, z - other.z, w - other.w);
+    return sse::Make<Vector4>(_mm_sub_ps(sse::Load(*this), sse::Load(other)));
 }
 
 XO_INL
 Vector4 XO_CC Vector4::operator * (Vector4 const& other) const {
-    return Vector4(x*other.x, y*other.y, z*other.z, w*other.w);
+    return sse::Make<Vector4>(_mm_mul_ps(sse::Load(*this), sse::Load(other)));
 }
 
 XO_INL
 Vector4 XO_CC Vector4::operator / (Vector4 const& other) const {
-    return Vector4(x / other.x, y / other.y, z / other.z, w / other.w);
+    return sse::Make<Vector4>(_mm_div_ps(sse::Load(*this), sse::Load(other)));
 }
 
-XO_INL 
+XO_INL
 Vector4& XO_CC Vector4::operator += (Vector4 const& other) {
-    x += other.x; 
-    y += other.y; 
-    z += other.z; 
-    w += other.w; 
+    sse::Store(*this, _mm_add_ps(sse::Load(*this), sse::Load(other)));
     return *this;
-};
+}
 
-XO_INL 
+XO_INL
 Vector4& XO_CC Vector4::operator -= (Vector4 const& other) {
-    x -=other.x;
-    y -=other.y;
-    z -= other.z;
-    w -= other.w;
-    return *this; };
+    sse::Store(*this, _mm_sub_ps(sse::Load(*this), sse::Load(other)));
+    return *this;
+}
 
-XO_INL 
+XO_INL
 Vector4& XO_CC Vector4::operator *= (Vector4 const& other) {
-    x *= other.x;
-    y *= other.y;
-    z *= other.z;
-    w *= other.w;
+    sse::Store(*this, _mm_mul_ps(sse::Load(*this), sse::Load(other)));
     return *this;
-};
+}
 
-XO_INL 
+XO_INL
 Vector4& XO_CC Vector4::operator /= (Vector4 const& other) {
-    x /= other.x;
-    y /= other.y;
-    z /= other.z;
-    w /= other.w;
+    sse::Store(*this, _mm_div_ps(sse::Load(*this), sse::Load(other)));
     return *this;
-};
+}
 
-XO_INL Vector4 Vector4::operator -() const { return Vector4(-x, -y, -z, -w); }
+XO_INL Vector4 Vector4::operator -() const {
+    return sse::Make<Vector4>(_mm_xor_ps(sse::Load(*this), _mm_set1_ps(-0.f)));
+}
 
 XO_INL float Vector4::operator[] (int index) const { return v[index]; }
 XO_INL float& Vector4::operator[] (int index) { return v[index]; }
 
-XO_INL float Vector4::Sum() const { return x + y + z + w; }
+XO_INL float Vector4::Sum() const {
+    return _mm_cvtss_f32(_mm_dp_ps(sse::Load(*this), _mm_set1_ps(1.f), 0xF1));
+}
 
-XO_INL float Vector4::MagnitudeSquared() const { return x * x + y * y + z * z + w * w; }
-XO_INL float Vector4::Magnitude() const { return Sqrt(MagnitudeSquared()); }
-XO_INL Vector4 Vector4::Normalized() const { return Vector4(*this).Normalize(); }
-XO_INL Vector4& Vector4::Normalize() { return (*this) /= Vector4(Magnitude()); };
+XO_INL float Vector4::MagnitudeSquared() const {
+    __m128 m = sse::Load(*this);
+    return _mm_cvtss_f32(_mm_dp_ps(m, m, 0xF1));
+}
 
-/*static*/ XO_INL 
+XO_INL float Vector4::Magnitude() const {
+    __m128 m = sse::Load(*this);
+    return _mm_cvtss_f32(_mm_sqrt_ss(_mm_dp_ps(m, m, 0xF1)));
+}
+
+XO_INL Vector4 Vector4::Normalized(Precision precision) const { return Vector4(*this).Normalize(precision); }
+
+XO_INL Vector4& Vector4::Normalize(Precision precision) {
+    __m128 m = sse::Load(*this);
+    __m128 magnitudeSquared = _mm_dp_ps(m, m, 0xFF);
+    if (precision == Precision::Exact) {
+        sse::Store(*this, _mm_div_ps(m, _mm_sqrt_ps(magnitudeSquared)));
+    }
+    else {
+        sse::Store(*this, _mm_mul_ps(m, sse::InverseSqrt(magnitudeSquared, precision)));
+    }
+    return *this;
+}
+
+/*static*/ XO_INL
 bool XO_CC Vector4::RoughlyEqual(Vector4 const& left, Vector4 const& right) {
-    return CloseEnough(left.x, right.x)
-        && CloseEnough(left.y, right.y)
-        && CloseEnough(left.z, right.z)
-        && CloseEnough(left.w, right.w);
+    return sse::CloseEnoughMask(sse::Load(left), sse::Load(right)) == 0xF;
 }
 
-/*static*/ XO_INL 
+/*static*/ XO_INL
 bool XO_CC Vector4::ExactlyEqual(Vector4 const& left, Vector4 const& right) {
-    return left.x == right.x
-        && left.y == right.y
-        && left.z == right.z
-        && left.w == right.w;
+    return sse::ExactlyEqualMask(sse::Load(left), sse::Load(right)) == 0xF;
 }
 
-/*static*/ XO_INL 
+/*static*/ XO_INL
 bool XO_CC Vector4::RoughlyEqual(Vector4 const& left, float magnitude) {
     return CloseEnough(left.MagnitudeSquared(), Pow<2>(magnitude));
 }
@@ -1260,12 +1975,14 @@ bool XO_CC Vector4::ExactlyEqual(Vector4 const& left, float magnitude) {
 
 /*static*/ XO_INL
 float XO_CC Vector4::DotProduct(Vector4 const& left, Vector4 const& right) {
-    return (left * right).Sum();
+    return _mm_cvtss_f32(_mm_dp_ps(sse::Load(left), sse::Load(right), 0xF1));
 }
 
-/*static*/ XO_INL 
+/*static*/ XO_INL
 Vector4 XO_CC Vector4::Lerp(Vector4 const& left, Vector4 const& right, float t) {
-    return left + Vector4(t) * (right - left);
+    __m128 l = sse::Load(left);
+    __m128 r = sse::Load(right);
+    return sse::Make<Vector4>(_mm_add_ps(l, _mm_mul_ps(_mm_set1_ps(t), _mm_sub_ps(r, l))));
 }
 
 #if defined(XO_MATH_IMPL)
@@ -1287,62 +2004,52 @@ Vector4 XO_CC Vector4::Lerp(Vector4 const& left, Vector4 const& right, float t)
 
 XO_INL
 Vector3 XO_CC Matrix4x4::Transform(Vector3 const& v3) const {
-    return Vector3(Vector4::DotProduct(rows[0], Vector4(v3)),
-                   Vector4::DotProduct(rows[1], Vector4(v3)),
-                   Vector4::DotProduct(rows[2], Vector4(v3)));
+    // w is implicitly 0, so the dot products only read xyz.
+    __m128 v = sse::Load(v3);
+    __m128 x = _mm_dp_ps(sse::Load(rows[0]), v, 0x71);
+    __m128 y = _mm_dp_ps(sse::Load(rows[1]), v, 0x72);
+    __m128 z = _mm_dp_ps(sse::Load(rows[2]), v, 0x74);
+    return sse::Make<Vector3>(_mm_or_ps(_mm_or_ps(x, y), z));
 }
 
 XO_INL
 Vector4 XO_CC Matrix4x4::Transform(Vector4 const& v4) const {
-    return Vector4(Vector4::DotProduct(rows[0], v4),
-                   Vector4::DotProduct(rows[1], v4),
-                   Vector4::DotProduct(rows[2], v4),
-                   Vector4::DotProduct(rows[3], v4));
+    __m128 v = sse::Load(v4);
+    __m128 x = _mm_dp_ps(sse::Load(rows[0]), v, 0xF1);
+    __m128 y = _mm_dp_ps(sse::Load(rows[1]), v, 0xF2);
+    __m128 z = _mm_dp_ps(sse::Load(rows[2]), v, 0xF4);
+    __m128 w = _mm_dp_ps(sse::Load(rows[3]), v, 0xF8);
+    return sse::Make<Vector4>(_mm_or_ps(_mm_or_ps(x, y), _mm_or_ps(z, w)));
 }
 
 XO_INL
 Vector3 XO_CC Matrix4x4::InverseTransform(Vector3 const& v3) const {
-    return Vector3(((rows[0][0]) * v3.x) + ((rows[1][0]) * v3.y) + ((rows[2][0]) * v3.z),
-                   ((rows[0][1]) * v3.x) + ((rows[1][1]) * v3.y) + ((rows[2][1]) * v3.z),
-                   ((rows[0][2]) * v3.x) + ((rows[1][2]) * v3.y) + ((rows[2][2]) * v3.z));
+    __m128 v = sse::Load(v3);
+    __m128 r = _mm_mul_ps(sse::Splat<0>(v), sse::Load(rows[0]));
+    r = sse::MultiplyAdd(sse::Splat<1>(v), sse::Load(rows[1]), r);
+    r = sse::MultiplyAdd(sse::Splat<2>(v), sse::Load(rows[2]), r);
+    return sse::Make<Vector3>(r);
 }
 
 XO_INL
 Vector4 XO_CC Matrix4x4::InverseTransform(Vector4 const& v4) const {
-    return Vector4(((rows[0][0]) * v4.x) + ((rows[1][0]) * v4.y) + ((rows[2][0]) * v4.z) + ((rows[3][0]) * v4.w),
-                   ((rows[0][1]) * v4.x) + ((rows[1][1]) * v4.y) + ((rows[2][1]) * v4.z) + ((rows[3][1]) * v4.w),
-                   ((rows[0][2]) * v4.x) + ((rows[1][2]) * v4.y) + ((rows[2][2]) * v4.z) + ((rows[3][2]) * v4.w),
-                   ((rows[0][3]) * v4.x) + ((rows[1][3]) * v4.y) + ((rows[2][3]) * v4.z) + ((rows[3][3]) * v4.w));
+    __m128 v = sse::Load(v4);
+    __m128 r = _mm_mul_ps(sse::Splat<0>(v), sse::Load(rows[0]));
+    r = sse::MultiplyAdd(sse::Splat<1>(v), sse::Load(rows[1]), r);
+    r = sse::MultiplyAdd(sse::Splat<2>(v), sse::Load(rows[2]), r);
+    r = sse::MultiplyAdd(sse::Splat<3>(v), sse::Load(rows[3]), r);
+    return sse::Make<Vector4>(r);
 }
 
-XO_INL 
+XO_INL
 Matrix4x4 XO_CC Matrix4x4::operator * (Matrix4x4 const& other) const {
     return Matrix4x4(*this) *= other;
 }
 
 XO_INL
 Matrix4x4& XO_CC Matrix4x4::operator *= (Matrix4x4 const& other) {
-    Matrix4x4 transposed = Transpose(other);
-    return (*this) = Matrix4x4(
-        Vector4(Vector4::DotProduct(rows[0], transposed[0]),
-                Vector4::DotProduct(rows[0], transposed[1]),
-                Vector4::DotProduct(rows[0], transposed[2]),
-                Vector4::DotProduct(rows[0], transposed[3])),
-
-        Vector4(Vector4::DotProduct(rows[1], transposed[0]),
-                Vector4::DotProduct(rows[1], transposed[1]),
-                Vector4::DotProduct(rows[1], transposed[2]),
-                Vector4::DotProduct(rows[1], transposed[3])),
-
-        Vector4(Vector4::DotProduct(rows[2], transposed[0]),
-                Vector4::DotProduct(rows[2], transposed[1]),
-                Vector4::DotProduct(rows[2], transposed[2]),
-                Vector4::DotProduct(rows[2], transposed[3])),
-
-        Vector4(Vector4::DotProduct(rows[3], transposed[0]),
-                Vector4::DotProduct(rows[3], transposed[1]),
-                Vector4::DotProduct(rows[3], transposed[2]),
-                Vector4::DotProduct(rows[3], transposed[3])));
+    sse::MultiplyMatrix(v, other.v, v);
+    return *this;
 }
 
 XO_INL Vector4 Matrix4x4::operator[] (int index) const { return rows[index]; }
@@ -1405,134 +2112,86 @@ Vector3 Matrix4x4::Backward() const {
     return -Forward();
 }
 
-/*static*/ XO_INL 
+/*static*/ XO_INL
 Matrix4x4 XO_CC Matrix4x4::Transpose(Matrix4x4 const& matrixIn) {
-    Matrix4x4 transposed = Matrix4x4(matrixIn);
-    float t;
-#define XO_TRANSPOSE_SWAP(i,j) \
-    t = transposed.rows[i][j];\
-    transposed.rows[i][j] = transposed.rows[j][i]; \
-    transposed.rows[j][i] = t;
-
-    XO_TRANSPOSE_SWAP(0, 1);
-    XO_TRANSPOSE_SWAP(0, 2);
-    XO_TRANSPOSE_SWAP(0, 3);
-    XO_TRANSPOSE_SWAP(1, 2);
-    XO_TRANSPOSE_SWAP(1, 3);
-    XO_TRANSPOSE_SWAP(2, 3);
-#undef XO_TRANSPOSE_SWAP
+    __m128 r0 = sse::Load(matrixIn.rows[0]);
+    __m128 r1 = sse::Load(matrixIn.rows[1]);
+    __m128 r2 = sse::Load(matrixIn.rows[2]);
+    __m128 r3 = sse::Load(matrixIn.rows[3]);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    Matrix4x4 transposed;
+    sse::Store(transposed.rows[0], r0);
+    sse::Store(transposed.rows[1], r1);
+    sse::Store(transposed.rows[2], r2);
+    sse::Store(transposed.rows[3], r3);
     return transposed;
 }
 
-namespace {
-XO_INL
-void XO_CC EarlyInverse(float tmp[12], float src[16], float& det, float m[16]) {
-    // http://download.intel.com/design/PentiumIII/sml/24504301.pdf
-    // transpose matrix
-    for (int i = 0; i < 4; i++) {
-        src[i] = m[i * 4];
-        src[i + 4] = m[i * 4 + 1];
-        src[i + 8] = m[i * 4 + 2];
-        src[i + 12] = m[i * 4 + 3];
+/*static*/ XO_INL 
+Matrix4x4 XO_CC Matrix4x4::Invert(Matrix4x4 const& matrixIn) {
+    __m128 adjugate[4];
+    __m128 invDet = _mm_div_ps(_mm_set1_ps(1.f), sse::Adjugate(matrixIn.v, adjugate));
+    Matrix4x4 inverted;
+    for (int i = 0; i < 4; ++i) {
+        sse::Store(inverted.rows[i], _mm_mul_ps(adjugate[i], invDet));
     }
-    // calculate pairs for first 8 elements (cofactors)
-    tmp[0] = src[10] * src[15];
-    tmp[1] = src[11] * src[14];
-    tmp[2] = src[9] * src[15];
-    tmp[3] = src[11] * src[13];
-    tmp[4] = src[9] * src[14];
-    tmp[5] = src[10] * src[13];
-    tmp[6] = src[8] * src[15];
-    tmp[7] = src[11] * src[12];
-    tmp[8] = src[8] * src[14];
-    tmp[9] = src[10] * src[12];
-    tmp[10] = src[8] * src[13];
-    tmp[11] = src[9] * src[12];
-    // calculate first 8 elements (cofactors)
-    m[0] = tmp[0] * src[5] + tmp[3] * src[6] + tmp[4] * src[7];
-    m[0] -= tmp[1] * src[5] + tmp[2] * src[6] + tmp[5] * src[7];
-    m[1] = tmp[1] * src[4] + tmp[6] * src[6] + tmp[9] * src[7];
-    m[1] -= tmp[0] * src[4] + tmp[7] * src[6] + tmp[8] * src[7];
-    m[2] = tmp[2] * src[4] + tmp[7] * src[5] + tmp[10] * src[7];
-    m[2] -= tmp[3] * src[4] + tmp[6] * src[5] + tmp[11] * src[7];
-    m[3] = tmp[5] * src[4] + tmp[8] * src[5] + tmp[11] * src[6];
-    m[3] -= tmp[4] * src[4] + tmp[9] * src[5] + tmp[10] * src[6];
-    m[4] = tmp[1] * src[1] + tmp[2] * src[2] + tmp[5] * src[3];
-    m[4] -= tmp[0] * src[1] + tmp[3] * src[2] + tmp[4] * src[3];
-    m[5] = tmp[0] * src[0] + tmp[7] * src[2] + tmp[8] * src[3];
-    m[5] -= tmp[1] * src[0] + tmp[6] * src[2] + tmp[9] * src[3];
-    m[6] = tmp[3] * src[0] + tmp[6] * src[1] + tmp[11] * src[3];
-    m[6] -= tmp[2] * src[0] + tmp[7] * src[1] + tmp[10] * src[3];
-    m[7] = tmp[4] * src[0] + tmp[9] * src[1] + tmp[10] * src[2];
-    m[7] -= tmp[5] * src[0] + tmp[8] * src[1] + tmp[11] * src[2];
-    // calculate pairs for second 8 elements (cofactors)
-    tmp[0] = src[2] * src[7];
-    tmp[1] = src[3] * src[6];
-    tmp[2] = src[1] * src[7];
-    tmp[3] = src[3] * src[5];
-    tmp[4] = src[1] * src[6];
-    tmp[5] = src[2] * src[5];
-    tmp[6] = src[0] * src[7];
-    tmp[7] = src[3] * src[4];
-    tmp[8] = src[0] * src[6];
-    tmp[9] = src[2] * src[4];
-    tmp[10] = src[0] * src[5];
-    tmp[11] = src[1] * src[4];
-    // calculate second 8 elements (cofactors)
-    m[8] = tmp[0] * src[13] + tmp[3] * src[14] + tmp[4] * src[15];
-    m[8] -= tmp[1] * src[13] + tmp[2] * src[14] + tmp[5] * src[15];
-    m[9] = tmp[1] * src[12] + tmp[6] * src[14] + tmp[9] * src[15];
-    m[9] -= tmp[0] * src[12] + tmp[7] * src[14] + tmp[8] * src[15];
-    m[10] = tmp[2] * src[12] + tmp[7] * src[13] + tmp[10] * src[15];
-    m[10] -= tmp[3] * src[12] + tmp[6] * src[13] + tmp[11] * src[15];
-    m[11] = tmp[5] * src[12] + tmp[8] * src[13] + tmp[11] * src[14];
-    m[11] -= tmp[4] * src[12] + tmp[9] * src[13] + tmp[10] * src[14];
-    m[12] = tmp[2] * src[10] + tmp[5] * src[11] + tmp[1] * src[9];
-    m[12] -= tmp[4] * src[11] + tmp[0] * src[9] + tmp[3] * src[10];
-    m[13] = tmp[8] * src[11] + tmp[0] * src[8] + tmp[7] * src[10];
-    m[13] -= tmp[6] * src[10] + tmp[9] * src[11] + tmp[1] * src[8];
-    m[14] = tmp[6] * src[9] + tmp[11] * src[11] + tmp[3] * src[8];
-    m[14] -= tmp[10] * src[11] + tmp[2] * src[8] + tmp[7] * src[9];
-    m[15] = tmp[10] * src[10] + tmp[4] * src[8] + tmp[9] * src[9];
-    m[15] -= tmp[8] * src[9] + tmp[11] * src[10] + tmp[5] * src[8];
-    // calculate determinant
-    det = src[0] * m[0] + src[1] * m[1] + src[2] * m[2] + src[3] * m[3];
+    return inverted;
 }
 
-XO_INL
-void XO_CC LateInverse(float &det, float m[16]) {
-    // http://download.intel.com/design/PentiumIII/sml/24504301.pdf
-    // calculate matrix inverse 
-    det = 1.0f / det;
-    for (int j = 0; j < 16; j++) {
-        m[j] *= det;
+/*static*/ XO_INL
+bool XO_CC Matrix4x4::InvertSafe(Matrix4x4 const& matrixIn, Matrix4x4& matrixOut) {
+    __m128 adjugate[4];
+    __m128 det = sse::Adjugate(matrixIn.v, adjugate);
+    if (CloseEnough(_mm_cvtss_f32(det), 0.f))
+        return false;
+    __m128 invDet = _mm_div_ps(_mm_set1_ps(1.f), det);
+    for (int i = 0; i < 4; ++i) {
+        sse::Store(matrixOut.rows[i], _mm_mul_ps(adjugate[i], invDet));
     }
+    return true;
 }
+
+/*static*/ XO_INL
+Matrix4x4 XO_CC Matrix4x4::InvertAffine(Matrix4x4 const& matrixIn) {
+    // The columns of the 3x3 inverse are c0 = a1 x a2, c1 = a2 x a0 and c2 = a0 x a1 over
+    // the determinant a0 . c0.
+    __m128 a0 = sse::Load(matrixIn.rows[0]);
+    __m128 a1 = sse::Load(matrixIn.rows[1]);
+    __m128 a2 = sse::Load(matrixIn.rows[2]);
+    __m128 c0 = sse::CrossProduct(a1, a2);
+    __m128 c1 = sse::CrossProduct(a2, a0);
+    __m128 c2 = sse::CrossProduct(a0, a1);
+    __m128 invDet = _mm_div_ps(_mm_set1_ps(1.f), _mm_dp_ps(a0, c0, 0x7F));
+    return sse::AffineInverse<Matrix4x4>(_mm_mul_ps(c0, invDet), _mm_mul_ps(c1, invDet),
+                                   _mm_mul_ps(c2, invDet), sse::Load(matrixIn.rows[3]));
 }
 
-/*static*/ XO_INL 
-Matrix4x4 XO_CC Matrix4x4::Invert(Matrix4x4 const& matrixIn) {
-    float tmp[12]; // temp array for pairs
-    float src[16]; // array of transpose source matrix
-    float det; // determinant
-    Matrix4x4 inverted(matrixIn);
-    EarlyInverse(tmp, src, det, inverted.v);
-    LateInverse(det, inverted.v);
-    return inverted;
+/*static*/ XO_INL
+Matrix4x4 XO_CC Matrix4x4::InvertOrthonormal(Matrix4x4 const& matrixIn) {
+    // The columns of the 3x3 inverse are the rows.
+    return sse::AffineInverse<Matrix4x4>(sse::Load(matrixIn.rows[0]), sse::Load(matrixIn.rows[1]),
+                                   sse::Load(matrixIn.rows[2]), sse::Load(matrixIn.rows[3]));
 }
 
 /*static*/ XO_INL
-bool XO_CC Matrix4x4::InvertSafe(Matrix4x4 const& matrixIn, Matrix4x4& matrixOut) {
-    float tmp[12]; // temp array for pairs
-    float src[16]; // array of transpose source matrix
-    float det; // determinant
-    Matrix4x4 inverted(matrixIn);
-    EarlyInverse(tmp, src, det, inverted.v);
-    if (CloseEnough(det, 0.f))
-        return false;
-    LateInverse(det, inverted.v);
-    matrixOut = inverted;
-    return true;
+bool XO_CC Matrix4x4::IsAffine(Matrix4x4 const& matrixIn) {
+    return CloseEnough(matrixIn.v[3], 0.f) && CloseEnough(matrixIn.v[7], 0.f)
+        && CloseEnough(matrixIn.v[11], 0.f) && CloseEnough(matrixIn.v[15], 1.f);
+}
+
+/*static*/ XO_INL
+bool XO_CC Matrix4x4::IsOrthonormal(Matrix4x4 const& matrixIn) {
+    Vector3 a0(matrixIn.v[0], matrixIn.v[1], matrixIn.v[2]);
+    Vector3 a1(matrixIn.v[4], matrixIn.v[5], matrixIn.v[6]);
+    Vector3 a2(matrixIn.v[8], matrixIn.v[9], matrixIn.v[10]);
+    float const tolerance = 1e-5f;
+    return IsAffine(matrixIn)
+        && Abs(a0.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(a1.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(a2.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(Vector3::DotProduct(a0, a1)) <= tolerance
+        && Abs(Vector3::DotProduct(a1, a2)) <= tolerance
+        && Abs(Vector3::DotProduct(a2, a0)) <= tolerance;
 }
 
 /*static*/ XO_INL 
@@ -1603,7 +2262,6 @@ Matrix4x4 XO_CC Matrix4x4::RotationAxisAngle(Vector3 const& axis, float angle) {
     rotation[1][1] = c + a.y*a.y*t;
     rotation[2][2] = c + a.z*a.z*t;
 
-
     float tmp1 = a.x*a.y*t;
     float tmp2 = a.z*s;
     rotation[1][0] = tmp1 + tmp2;
@@ -1645,6 +2303,7 @@ Matrix4x4 XO_CC Matrix4x4::Perspective(float width,
                                        float aspect, 
                                        float nearPlane, 
                                        float farPlane) {
+    XO_UNUSED(aspect);   // width / height already give it
     float n2 = Pow<2>(nearPlane);
     float r = farPlane / (nearPlane - farPlane);
     float w = n2 / width;
@@ -1716,17 +2375,49 @@ bool XO_CC Matrix4x4::ExactlyEqual(Matrix4x4 const& left, Matrix4x4 const& right
 
 XO_INL
 Quaternion Quaternion::operator + (Quaternion other) const {
-    return Quaternion(i + other.i, j + other.j, k + other.k, r + other.r);
+    return sse::Make<Quaternion>(_mm_add_ps(sse::Load(*this), sse::Load(other)));
 }
 
 XO_INL
-Quaternion Quaternion::operator *(float s) const { 
-    return Quaternion(i*s, j*s, k*s, r*s); 
+Quaternion Quaternion::operator *(float s) const {
+    return sse::Make<Quaternion>(_mm_mul_ps(sse::Load(*this), _mm_set1_ps(s)));
 }
 
 XO_INL
 Quaternion Quaternion::operator -() const {
-    return Quaternion(-i, -j, -k, -r);
+    return sse::Make<Quaternion>(_mm_xor_ps(sse::Load(*this), _mm_set1_ps(-0.f)));
+}
+
+XO_INL
+Quaternion XO_CC Quaternion::operator * (Quaternion const& other) const {
+    // Each lane of this times a shuffled, sign flipped copy of other, see the reference
+    // backend for the scalar form.
+    __m128 a = sse::Load(*this);
+    __m128 b = sse::Load(other);
+    __m128 rkji = _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3));
+    __m128 krij = _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2));
+    __m128 jirk = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 result = _mm_mul_ps(sse::Splat<3>(a), b);
+    result = sse::MultiplyAdd(sse::Splat<0>(a), _mm_xor_ps(rkji, _mm_setr_ps(0.f, -0.f, 0.f, -0.f)), result);
+    result = sse::MultiplyAdd(sse::Splat<1>(a), _mm_xor_ps(krij, _mm_setr_ps(0.f, 0.f, -0.f, -0.f)), result);
+    result = sse::MultiplyAdd(sse::Splat<2>(a), _mm_xor_ps(jirk, _mm_setr_ps(-0.f, 0.f, 0.f, -0.f)), result);
+    return sse::Make<Quaternion>(result);
+}
+
+XO_INL
+Quaternion& XO_CC Quaternion::operator *= (Quaternion const& other) {
+    return *this = *this * other;
+}
+
+XO_INL
+Vector3 XO_CC Quaternion::Rotate(Vector3 const& v) const {
+    // The cross products see r in the w lane, against the 0 w of v and t, so w stays 0.
+    __m128 q = sse::Load(*this);
+    __m128 m = sse::Load(v);
+    __m128 t = sse::CrossProduct(q, m);
+    t = _mm_add_ps(t, t);
+    __m128 result = sse::MultiplyAdd(sse::Splat<3>(q), t, m);
+    return sse::Make<Vector3>(_mm_add_ps(result, sse::CrossProduct(q, t)));
 }
 
 XO_INL
@@ -1734,19 +2425,19 @@ float Quaternion::Magnitude() const {
     return vec4.Magnitude();
 }
 
-XO_INL 
+XO_INL
 float Quaternion::MagnitudeSquared() const {
     return vec4.MagnitudeSquared();
 };
 
 XO_INL
-Quaternion Quaternion::Normalized() const {
-    return Quaternion(vec4.Normalized());
+Quaternion Quaternion::Normalized(Precision precision) const {
+    return Quaternion(vec4.Normalized(precision));
 };
 
 XO_INL
-Quaternion& Quaternion::Normalize() {
-    vec4.Normalize(); return *this;
+Quaternion& Quaternion::Normalize(Precision precision) {
+    vec4.Normalize(precision); return *this;
 };
 
 XO_INL
@@ -1770,7 +2461,7 @@ Matrix4x4 Quaternion::ToMatrix() const {
 
 /*static*/ XO_INL
 Quaternion XO_CC Quaternion::Invert(Quaternion const& quat) {
-    return Quaternion(-quat.i, -quat.j, -quat.k, quat.r);
+    return sse::Make<Quaternion>(_mm_xor_ps(sse::Load(quat), _mm_set_ps(0.f, -0.f, -0.f, -0.f)));
 }
 
 /*static*/ XO_INL
@@ -1831,20 +2522,14 @@ Quaternion XO_CC Quaternion::Slerp(Quaternion const& start,
     return (s * s0) + (e * s1);
 }
 
-/*static*/ XO_INL 
+/*static*/ XO_INL
 bool XO_CC Quaternion::RoughlyEqual(Quaternion const& left, Quaternion const& right) {
-    return CloseEnough(left.i, right.i)
-        && CloseEnough(left.j, right.j)
-        && CloseEnough(left.k, right.k)
-        && CloseEnough(left.r, right.r);
+    return sse::CloseEnoughMask(sse::Load(left), sse::Load(right)) == 0xF;
 }
 
-/*static*/ XO_INL 
+/*static*/ XO_INL
 bool XO_CC Quaternion::ExactlyEqual(Quaternion const& left, Quaternion const& right) {
-    return left.i == right.i
-        && left.j == right.j
-        && left.k == right.k
-        && left.r == right.r;
+    return sse::ExactlyEqualMask(sse::Load(left), sse::Load(right)) == 0xF;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////// AVector 3
@@ -1911,81 +2596,92 @@ value...");
 #   endif
 #endif
 
-XO_INL 
-AVector3 XO_CC AVector3::operator + (AVector3 const& other) const { 
-    return AVector3(x + other.x, y + other.y, z + other.z);
+XO_INL
+AVector3 XO_CC AVector3::operator + (AVector3 const& other) const {
+    return sse::Make<AVector3>(_mm_add_ps(sse::Load(*this), sse::Load(other)));
 }
 
 XO_INL
 AVector3 XO_CC AVector3::operator - (AVector3 const& other) const {
-    return AVector3(x - other.x, y - other.y, z - other.z);
+    return sse::Make<AVector3>(_mm_sub_ps(sse::Load(*this), sse::Load(other)));
 }
 
 XO_INL
 AVector3 XO_CC AVector3::operator * (AVector3 const& other) const {
-    return AVector3(x * other.x, y * other.y, z * other.z);
+    return sse::Make<AVector3>(_mm_mul_ps(sse::Load(*this), sse::Load(other)));
 }
 
 XO_INL
 AVector3 XO_CC AVector3::operator / (AVector3 const& other) const {
-    return AVector3(x / other.x, y / other.y, z / other.z);
+    return sse::Make<AVector3>(_mm_div_ps(sse::Load(*this), sse::Load(other)));
 }
 
 XO_INL
 AVector3& XO_CC AVector3::operator += (AVector3 const& other) {
-    x += other.x;
-    y += other.y;
-    z += other.z;
+    sse::Store(*this, _mm_add_ps(sse::Load(*this), sse::Load(other)));
     return *this;
 }
 
 XO_INL
 AVector3& XO_CC AVector3::operator -= (AVector3 const& other) {
-    x -= other.x;
-    y -= other.y;
-    z -= other.z;
+    sse::Store(*this, _mm_sub_ps(sse::Load(*this), sse::Load(other)));
     return *this;
 }
 
 XO_INL
 AVector3& XO_CC AVector3::operator *= (AVector3 const& other) {
-    x *= other.x;
-    y *= other.y;
-    z *= other.z;
+    sse::Store(*this, _mm_mul_ps(sse::Load(*this), sse::Load(other)));
     return *this;
 }
 
 XO_INL
 AVector3& XO_CC AVector3::operator /= (AVector3 const& other) {
-    x /= other.x;
-    y /= other.y;
-    z /= other.z;
+    sse::Store(*this, _mm_div_ps(sse::Load(*this), sse::Load(other)));
     return *this;
 }
 
-XO_INL AVector3 AVector3::operator -() const { return AVector3(-x, -y, -z); };
+XO_INL AVector3 AVector3::operator -() const {
+    return sse::Make<AVector3>(_mm_xor_ps(sse::Load(*this), _mm_set1_ps(-0.f)));
+}
 
-XO_INL float AVector3::Sum() const { return x + y + z; }
+XO_INL float AVector3::Sum() const {
+    return _mm_cvtss_f32(_mm_dp_ps(sse::Load(*this), _mm_set1_ps(1.f), 0x71));
+}
 
-XO_INL float AVector3::MagnitudeSquared() const { return ((*this) * (*this)).Sum(); }
-XO_INL float AVector3::Magnitude() const { return xo::Sqrt(MagnitudeSquared()); }
+XO_INL float AVector3::MagnitudeSquared() const {
+    __m128 m = sse::Load(*this);
+    return _mm_cvtss_f32(_mm_dp_ps(m, m, 0x71));
+}
+
+XO_INL float AVector3::Magnitude() const {
+    __m128 m = sse::Load(*this);
+    return _mm_cvtss_f32(_mm_sqrt_ss(_mm_dp_ps(m, m, 0x71)));
+}
+
+XO_INL AVector3& AVector3::Normalize(Precision precision) {
+    __m128 m = sse::Load(*this);
+    __m128 magnitudeSquared = _mm_dp_ps(m, m, 0x7F);
+    if (precision == Precision::Exact) {
+        sse::Store(*this, _mm_div_ps(m, _mm_sqrt_ps(magnitudeSquared)));
+    }
+    else {
+        sse::Store(*this, _mm_mul_ps(m, sse::InverseSqrt(magnitudeSquared, precision)));
+    }
+    return *this;
+}
 
-XO_INL AVector3& AVector3::Normalize() { return (*this) /= AVector3(Magnitude()); }
-XO_INL AVector3 AVector3::Normalized() const { return AVector3(*this).Normalize(); }
+XO_INL AVector3 AVector3::Normalized(Precision precision) const { return AVector3(*this).Normalize(precision); }
 
 /*static*/ XO_INL
 bool XO_CC AVector3::RoughlyEqual(AVector3 const& left, AVector3 const& right) {
-    return CloseEnough(left.x, right.x)
-        && CloseEnough(left.y, right.y)
-        && CloseEnough(left.z, right.z);
+    return (sse::CloseEnoughMask(sse::Load(left), sse::Load(right)) & 0x7) == 0x7;
 }
 
 /*static*/ XO_INL
 bool XO_CC AVector3::ExactlyEqual(AVector3 const& left, AVector3 const& right) {
-    return left.x == right.x
-        && left.y == right.y
-        && left.z == right.z;
+    return (sse::ExactlyEqualMask(sse::Load(left), sse::Load(right)) & 0x7) == 0x7;
 }
+
 /*static*/ XO_INL
 bool XO_CC AVector3::RoughlyEqual(AVector3 const& left, float magnitude) {
     return CloseEnough(left.MagnitudeSquared(), Pow<2>(magnitude));
@@ -1998,20 +2694,25 @@ bool XO_CC AVector3::ExactlyEqual(AVector3 const& left, float magnitude) {
 
 /*static*/ XO_INL
 float XO_CC AVector3::DotProduct(AVector3 const& left, AVector3 const& right) {
-    return (left * right).Sum();
+    return _mm_cvtss_f32(_mm_dp_ps(sse::Load(left), sse::Load(right), 0x71));
 }
 
 /*static*/ XO_INL
 AVector3 XO_CC AVector3::CrossProduct(AVector3 const& left, AVector3 const& right) {
-    return AVector3(
-        left.y * right.z - left.z * right.y,
-        left.z * right.x - left.x * right.z,
-        left.x * right.y - left.y * right.x);
+    // (l * r.yzx - l.yzx * r).yzx
+    __m128 l = sse::Load(left);
+    __m128 r = sse::Load(right);
+    __m128 lyzx = _mm_shuffle_ps(l, l, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 ryzx = _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 zxy = _mm_sub_ps(_mm_mul_ps(l, ryzx), _mm_mul_ps(lyzx, r));
+    return sse::Make<AVector3>(_mm_shuffle_ps(zxy, zxy, _MM_SHUFFLE(3, 0, 2, 1)));
 }
 
 /*static*/ XO_INL
 AVector3 XO_CC AVector3::Lerp(AVector3 const& left, AVector3 const& right, float t) {
-    return left + AVector3(t) * (right - left);
+    __m128 l = sse::Load(left);
+    __m128 r = sse::Load(right);
+    return sse::Make<AVector3>(_mm_add_ps(l, _mm_mul_ps(_mm_set1_ps(t), _mm_sub_ps(r, l))));
 }
 
 /*static*/ XO_INL
@@ -2028,88 +2729,94 @@ float XO_CC AVector3::Distance(AVector3 const& left, AVector3 const& right) {
 
 XO_INL
 AVector4 XO_CC AVector4::operator + (AVector4 const& other) const {
-    return AVector4(x + other.x, y + other.y, z + other.z, w + other.w);
+    return sse::Make<AVector4>(_mm_add_ps(sse::Load(*this), sse::Load(other)));
 }
 
 XO_INL
 AVector4 XO_CC AVector4::operator - (AVector4 const& other) const {
-    return AVector4(x - other.x, y - other.y, z - other.z, w - other.w);
+    return sse::Make<AVector4>(_mm_sub_ps(sse::Load(*this), sse::Load(other)));
 }
 
 XO_INL
 AVector4 XO_CC AVector4::operator * (AVector4 const& other) const {
-    return AVector4(x*other.x, y*other.y, z*other.z, w*other.w);
+    return sse::Make<AVector4>(_mm_mul_ps(sse::Load(*this), sse::Load(other)));
 }
 
 XO_INL
 AVector4 XO_CC AVector4::operator / (AVector4 const& other) const {
-    return AVector4(x / other.x, y / other.y, z / other.z, w / other.w);
+    return sse::Make<AVector4>(_mm_div_ps(sse::Load(*this), sse::Load(other)));
 }
 
-XO_INL 
+XO_INL
 AVector4& XO_CC AVector4::operator += (AVector4 const& other) {
-    x += other.x; 
-    y += other.y; 
-    z += other.z; 
-    w += other.w; 
+    sse::Store(*this, _mm_add_ps(sse::Load(*this), sse::Load(other)));
     return *this;
-};
+}
 
-XO_INL 
+XO_INL
 AVector4& XO_CC AVector4::operator -= (AVector4 const& other) {
-    x -=other.x;
-    y -=other.y;
-    z -= other.z;
-    w -= other.w;
-    return *this; };
+    sse::Store(*this, _mm_sub_ps(sse::Load(*this), sse::Load(other)));
+    return *this;
+}
 
-XO_INL 
+XO_INL
 AVector4& XO_CC AVector4::operator *= (AVector4 const& other) {
-    x *= other.x;
-    y *= other.y;
-    z *= other.z;
-    w *= other.w;
+    sse::Store(*this, _mm_mul_ps(sse::Load(*this), sse::Load(other)));
     return *this;
-};
+}
 
-XO_INL 
+XO_INL
 AVector4& XO_CC AVector4::operator /= (AVector4 const& other) {
-    x /= other.x;
-    y /= other.y;
-    z /= other.z;
-    w /= other.w;
+    sse::Store(*this, _mm_div_ps(sse::Load(*this), sse::Load(other)));
     return *this;
-};
+}
 
-XO_INL AVector4 AVector4::operator -() const { return AVector4(-x, -y, -z, -w); }
+XO_INL AVector4 AVector4::operator -() const {
+    return sse::Make<AVector4>(_mm_xor_ps(sse::Load(*this), _mm_set1_ps(-0.f)));
+}
 
 XO_INL float AVector4::operator[] (int index) const { return v[index]; }
 XO_INL float& AVector4::operator[] (int index) { return v[index]; }
 
-XO_INL float AVector4::Sum() const { return x + y + z + w; }
+XO_INL float AVector4::Sum() const {
+    return _mm_cvtss_f32(_mm_dp_ps(sse::Load(*this), _mm_set1_ps(1.f), 0xF1));
+}
 
-XO_INL float AVector4::MagnitudeSquared() const { return x * x + y * y + z * z + w * w; }
-XO_INL float AVector4::Magnitude() const { return Sqrt(MagnitudeSquared()); }
-XO_INL AVector4 AVector4::Normalized() const { return AVector4(*this).Normalize(); }
-XO_INL AVector4& AVector4::Normalize() { return (*this) /= AVector4(Magnitude()); };
+XO_INL float AVector4::MagnitudeSquared() const {
+    __m128 m = sse::Load(*this);
+    return _mm_cvtss_f32(_mm_dp_ps(m, m, 0xF1));
+}
 
-/*static*/ XO_INL 
+XO_INL float AVector4::Magnitude() const {
+    __m128 m = sse::Load(*this);
+    return _mm_cvtss_f32(_mm_sqrt_ss(_mm_dp_ps(m, m, 0xF1)));
+}
+
+XO_INL AVector4 AVector4::Normalized(Precision precision) const { return AVector4(*this).Normalize(precision); }
+
+XO_INL AVector4& AVector4::Normalize(Precision precision) {
+    __m128 m = sse::Load(*this);
+    __m128 magnitudeSquared = _mm_dp_ps(m, m, 0xFF);
+    if (precision == Precision::Exact) {
+        sse::Store(*this, _mm_div_ps(m, _mm_sqrt_ps(magnitudeSquared)));
+    }
+    else {
+        sse::Store(*this, _mm_mul_ps(m, sse::InverseSqrt(magnitudeSquared, precision)));
+    }
+    return *this;
+}
+
+/*static*/ XO_INL
 bool XO_CC AVector4::RoughlyEqual(AVector4 const& left, AVector4 const& right) {
-    return CloseEnough(left.x, right.x)
-        && CloseEnough(left.y, right.y)
-        && CloseEnough(left.z, right.z)
-        && CloseEnough(left.w, right.w);
+    return sse::CloseEnoughMask(sse::Load(left), sse::Load(right)) == 0xF;
 }
 
-/*static*/ XO_INL 
+/*static*/ XO_INL
 bool XO_CC AVector4::ExactlyEqual(AVector4 const& left, AVector4 const& right) {
-    return left.x == right.x
-        && left.y == right.y
-        && left.z == right.z
-        && left.w == right.w;
+    return sse::ExactlyEqualMask(sse::Load(left), sse::Load(right)) == 0xF;
 }
 
-/*static*/ XO_INL 
+/*static*/ XO_INL
 bool XO_CC AVector4::RoughlyEqual(AVector4 const& left, float magnitude) {
     return CloseEnough(left.MagnitudeSquared(), Pow<2>(magnitude));
 }
@@ -2121,12 +2828,14 @@ bool XO_CC AVector4::ExactlyEqual(AVector4 const& left, float magnitude) {
 
 /*static*/ XO_INL
 float XO_CC AVector4::DotProduct(AVector4 const& left, AVector4 const& right) {
-    return (left * right).Sum();
+    return _mm_cvtss_f32(_mm_dp_ps(sse::Load(left), sse::Load(right), 0xF1));
 }
 
-/*static*/ XO_INL 
+/*static*/ XO_INL
 AVector4 XO_CC AVector4::Lerp(AVector4 const& left, AVector4 const& right, float t) {
-    return left + AVector4(t) * (right - left);
+    __m128 l = sse::Load(left);
+    __m128 r = sse::Load(right);
+    return sse::Make<AVector4>(_mm_add_ps(l, _mm_mul_ps(_mm_set1_ps(t), _mm_sub_ps(r, l))));
 }
 
 #if defined(XO_MATH_IMPL)
@@ -2148,62 +2857,52 @@ AVector4 XO_CC AVector4::Lerp(AVector4 const& left, AVector4 const& right, float
 
 XO_INL
 AVector3 XO_CC AMatrix4x4::Transform(AVector3 const& v3) const {
-    return AVector3(AVector4::DotProduct(rows[0], AVector4(v3)),
-                    AVector4::DotProduct(rows[1], AVector4(v3)),
-                    AVector4::DotProduct(rows[2], AVector4(v3)));
+    // w is implicitly 0, so the dot products only read xyz.
+    __m128 v = sse::Load(v3);
+    __m128 x = _mm_dp_ps(sse::Load(rows[0]), v, 0x71);
+    __m128 y = _mm_dp_ps(sse::Load(rows[1]), v, 0x72);
+    __m128 z = _mm_dp_ps(sse::Load(rows[2]), v, 0x74);
+    return sse::Make<AVector3>(_mm_or_ps(_mm_or_ps(x, y), z));
 }
 
 XO_INL
 AVector4 XO_CC AMatrix4x4::Transform(AVector4 const& v4) const {
-    return AVector4(AVector4::DotProduct(rows[0], v4),
-                    AVector4::DotProduct(rows[1], v4),
-                    AVector4::DotProduct(rows[2], v4),
-                    AVector4::DotProduct(rows[3], v4));
+    __m128 v = sse::Load(v4);
+    __m128 x = _mm_dp_ps(sse::Load(rows[0]), v, 0xF1);
+    __m128 y = _mm_dp_ps(sse::Load(rows[1]), v, 0xF2);
+    __m128 z = _mm_dp_ps(sse::Load(rows[2]), v, 0xF4);
+    __m128 w = _mm_dp_ps(sse::Load(rows[3]), v, 0xF8);
+    return sse::Make<AVector4>(_mm_or_ps(_mm_or_ps(x, y), _mm_or_ps(z, w)));
 }
 
 XO_INL
 AVector3 XO_CC AMatrix4x4::InverseTransform(AVector3 const& v3) const {
-    return AVector3(((rows[0][0]) * v3.x) + ((rows[1][0]) * v3.y) + ((rows[2][0]) * v3.z),
-                    ((rows[0][1]) * v3.x) + ((rows[1][1]) * v3.y) + ((rows[2][1]) * v3.z),
-                    ((rows[0][2]) * v3.x) + ((rows[1][2]) * v3.y) + ((rows[2][2]) * v3.z));
+    __m128 v = sse::Load(v3);
+    __m128 r = _mm_mul_ps(sse::Splat<0>(v), sse::Load(rows[0]));
+    r = sse::MultiplyAdd(sse::Splat<1>(v), sse::Load(rows[1]), r);
+    r = sse::MultiplyAdd(sse::Splat<2>(v), sse::Load(rows[2]), r);
+    return sse::Make<AVector3>(r);
 }
 
 XO_INL
 AVector4 XO_CC AMatrix4x4::InverseTransform(AVector4 const& v4) const {
-    return AVector4(((rows[0][0]) * v4.x) + ((rows[1][0]) * v4.y) + ((rows[2][0]) * v4.z) + ((rows[3][0]) * v4.w),
-                    ((rows[0][1]) * v4.x) + ((rows[1][1]) * v4.y) + ((rows[2][1]) * v4.z) + ((rows[3][1]) * v4.w),
-                    ((rows[0][2]) * v4.x) + ((rows[1][2]) * v4.y) + ((rows[2][2]) * v4.z) + ((rows[3][2]) * v4.w),
-                    ((rows[0][3]) * v4.x) + ((rows[1][3]) * v4.y) + ((rows[2][3]) * v4.z) + ((rows[3][3]) * v4.w));
+    __m128 v = sse::Load(v4);
+    __m128 r = _mm_mul_ps(sse::Splat<0>(v), sse::Load(rows[0]));
+    r = sse::MultiplyAdd(sse::Splat<1>(v), sse::Load(rows[1]), r);
+    r = sse::MultiplyAdd(sse::Splat<2>(v), sse::Load(rows[2]), r);
+    r = sse::MultiplyAdd(sse::Splat<3>(v), sse::Load(rows[3]), r);
+    return sse::Make<AVector4>(r);
 }
 
-XO_INL 
+XO_INL
 AMatrix4x4 XO_CC AMatrix4x4::operator * (AMatrix4x4 const& other) const {
     return AMatrix4x4(*this) *= other;
 }
 
 XO_INL
 AMatrix4x4& XO_CC AMatrix4x4::operator *= (AMatrix4x4 const& other) {
-    AMatrix4x4 transposed = Transpose(other);
-    return (*this) = AMatrix4x4(
-        AVector4(AVector4::DotProduct(rows[0], transposed[0]),
-                 AVector4::DotProduct(rows[0], transposed[1]),
-                 AVector4::DotProduct(rows[0], transposed[2]),
-                 AVector4::DotProduct(rows[0], transposed[3])),
-
-        AVector4(AVector4::DotProduct(rows[1], transposed[0]),
-                 AVector4::DotProduct(rows[1], transposed[1]),
-                 AVector4::DotProduct(rows[1], transposed[2]),
-                 AVector4::DotProduct(rows[1], transposed[3])),
-
-        AVector4(AVector4::DotProduct(rows[2], transposed[0]),
-                 AVector4::DotProduct(rows[2], transposed[1]),
-                 AVector4::DotProduct(rows[2], transposed[2]),
-                 AVector4::DotProduct(rows[2], transposed[3])),
-
-        AVector4(AVector4::DotProduct(rows[3], transposed[0]),
-                 AVector4::DotProduct(rows[3], transposed[1]),
-                 AVector4::DotProduct(rows[3], transposed[2]),
-                 AVector4::DotProduct(rows[3], transposed[3])));
+    sse::MultiplyMatrix(v, other.v, v);
+    return *this;
 }
 
 XO_INL AVector4 AMatrix4x4::operator[] (int index) const { return rows[index]; }
@@ -2266,50 +2965,88 @@ AVector3 AMatrix4x4::Backward() const {
     return -Forward();
 }
 
+/*static*/ XO_INL
+AMatrix4x4 XO_CC AMatrix4x4::Transpose(AMatrix4x4 const& matrixIn) {
+    __m128 r0 = sse::Load(matrixIn.rows[0]);
+    __m128 r1 = sse::Load(matrixIn.rows[1]);
+    __m128 r2 = sse::Load(matrixIn.rows[2]);
+    __m128 r3 = sse::Load(matrixIn.rows[3]);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    AMatrix4x4 transposed;
+    sse::Store(transposed.rows[0], r0);
+    sse::Store(transposed.rows[1], r1);
+    sse::Store(transposed.rows[2], r2);
+    sse::Store(transposed.rows[3], r3);
+    return transposed;
+}
+
 /*static*/ XO_INL 
-AMatrix4x4 XO_CC AMatrix4x4::Transpose(AMatrix4x4 const& AMatrixIn) {
-    AMatrix4x4 transposed = AMatrix4x4(AMatrixIn);
-    float t;
-#define XO_TRANSPOSE_SWAP(i,j) \
-    t = transposed.rows[i][j];\
-    transposed.rows[i][j] = transposed.rows[j][i]; \
-    transposed.rows[j][i] = t;
-
-    XO_TRANSPOSE_SWAP(0, 1);
-    XO_TRANSPOSE_SWAP(0, 2);
-    XO_TRANSPOSE_SWAP(0, 3);
-    XO_TRANSPOSE_SWAP(1, 2);
-    XO_TRANSPOSE_SWAP(1, 3);
-    XO_TRANSPOSE_SWAP(2, 3);
-#undef XO_TRANSPOSE_SWAP
-    return transposed;
-}
-
-/*static*/ XO_INL 
-AMatrix4x4 XO_CC AMatrix4x4::Invert(AMatrix4x4 const& AMatrixIn) {
-    float tmp[12]; // temp array for pairs
-    float src[16]; // array of transpose source AMatrix
-    float det; // determinant
-    AMatrix4x4 inverted(AMatrixIn);
-    EarlyInverse(tmp, src, det, inverted.v);
-    LateInverse(det, inverted.v);
+AMatrix4x4 XO_CC AMatrix4x4::Invert(AMatrix4x4 const& matrixIn) {
+    __m128 adjugate[4];
+    __m128 invDet = _mm_div_ps(_mm_set1_ps(1.f), sse::Adjugate(matrixIn.v, adjugate));
+    AMatrix4x4 inverted;
+    for (int i = 0; i < 4; ++i) {
+        sse::Store(inverted.rows[i], _mm_mul_ps(adjugate[i], invDet));
+    }
     return inverted;
 }
 
 /*static*/ XO_INL
-bool XO_CC AMatrix4x4::InvertSafe(AMatrix4x4 const& AMatrixIn, AMatrix4x4& AMatrixOut) {
-    float tmp[12]; // temp array for pairs
-    float src[16]; // array of transpose source AMatrix
-    float det; // determinant
-    AMatrix4x4 inverted(AMatrixIn);
-    EarlyInverse(tmp, src, det, inverted.v);
-    if (CloseEnough(det, 0.f))
+bool XO_CC AMatrix4x4::InvertSafe(AMatrix4x4 const& matrixIn, AMatrix4x4& matrixOut) {
+    __m128 adjugate[4];
+    __m128 det = sse::Adjugate(matrixIn.v, adjugate);
+    if (CloseEnough(_mm_cvtss_f32(det), 0.f))
         return false;
-    LateInverse(det, inverted.v);
-    AMatrixOut = inverted;
+    __m128 invDet = _mm_div_ps(_mm_set1_ps(1.f), det);
+    for (int i = 0; i < 4; ++i) {
+        sse::Store(matrixOut.rows[i], _mm_mul_ps(adjugate[i], invDet));
+    }
     return true;
 }
 
+/*static*/ XO_INL
+AMatrix4x4 XO_CC AMatrix4x4::InvertAffine(AMatrix4x4 const& matrixIn) {
+    // The columns of the 3x3 inverse are c0 = a1 x a2, c1 = a2 x a0 and c2 = a0 x a1 over
+    // the determinant a0 . c0.
+    __m128 a0 = sse::Load(matrixIn.rows[0]);
+    __m128 a1 = sse::Load(matrixIn.rows[1]);
+    __m128 a2 = sse::Load(matrixIn.rows[2]);
+    __m128 c0 = sse::CrossProduct(a1, a2);
+    __m128 c1 = sse::CrossProduct(a2, a0);
+    __m128 c2 = sse::CrossProduct(a0, a1);
+    __m128 invDet = _mm_div_ps(_mm_set1_ps(1.f), _mm_dp_ps(a0, c0, 0x7F));
+    return sse::AffineInverse<AMatrix4x4>(_mm_mul_ps(c0, invDet), _mm_mul_ps(c1, invDet),
+                                   _mm_mul_ps(c2, invDet), sse::Load(matrixIn.rows[3]));
+}
+
+/*static*/ XO_INL
+AMatrix4x4 XO_CC AMatrix4x4::InvertOrthonormal(AMatrix4x4 const& matrixIn) {
+    // The columns of the 3x3 inverse are the rows.
+    return sse::AffineInverse<AMatrix4x4>(sse::Load(matrixIn.rows[0]), sse::Load(matrixIn.rows[1]),
+                                   sse::Load(matrixIn.rows[2]), sse::Load(matrixIn.rows[3]));
+}
+
+/*static*/ XO_INL
+bool XO_CC AMatrix4x4::IsAffine(AMatrix4x4 const& matrixIn) {
+    return CloseEnough(matrixIn.v[3], 0.f) && CloseEnough(matrixIn.v[7], 0.f)
+        && CloseEnough(matrixIn.v[11], 0.f) && CloseEnough(matrixIn.v[15], 1.f);
+}
+
+/*static*/ XO_INL
+bool XO_CC AMatrix4x4::IsOrthonormal(AMatrix4x4 const& matrixIn) {
+    AVector3 a0(matrixIn.v[0], matrixIn.v[1], matrixIn.v[2]);
+    AVector3 a1(matrixIn.v[4], matrixIn.v[5], matrixIn.v[6]);
+    AVector3 a2(matrixIn.v[8], matrixIn.v[9], matrixIn.v[10]);
+    float const tolerance = 1e-5f;
+    return IsAffine(matrixIn)
+        && Abs(a0.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(a1.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(a2.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(AVector3::DotProduct(a0, a1)) <= tolerance
+        && Abs(AVector3::DotProduct(a1, a2)) <= tolerance
+        && Abs(AVector3::DotProduct(a2, a0)) <= tolerance;
+}
+
 /*static*/ XO_INL 
 AMatrix4x4 XO_CC AMatrix4x4::Translation(AVector3 const& pos) {
     return AMatrix4x4(
@@ -2378,7 +3115,6 @@ AMatrix4x4 XO_CC AMatrix4x4::RotationAxisAngle(AVector3 const& axis, float angle
     rotation[1][1] = c + a.y*a.y*t;
     rotation[2][2] = c + a.z*a.z*t;
 
-
     float tmp1 = a.x*a.y*t;
     float tmp2 = a.z*s;
     rotation[1][0] = tmp1 + tmp2;
@@ -2420,6 +3156,7 @@ AMatrix4x4 XO_CC AMatrix4x4::Perspective(float width,
                                        float aspect, 
                                        float nearPlane, 
                                        float farPlane) {
+    XO_UNUSED(aspect);   // width / height already give it
     float n2 = Pow<2>(nearPlane);
     float r = farPlane / (nearPlane - farPlane);
     float w = n2 / width;
@@ -2491,17 +3228,49 @@ bool XO_CC AMatrix4x4::ExactlyEqual(AMatrix4x4 const& left, AMatrix4x4 const& ri
 
 XO_INL
 AQuaternion AQuaternion::operator + (AQuaternion other) const {
-    return AQuaternion(i + other.i, j + other.j, k + other.k, r + other.r);
+    return sse::Make<AQuaternion>(_mm_add_ps(sse::Load(*this), sse::Load(other)));
 }
 
 XO_INL
-AQuaternion AQuaternion::operator *(float s) const { 
-    return AQuaternion(i*s, j*s, k*s, r*s); 
+AQuaternion AQuaternion::operator *(float s) const {
+    return sse::Make<AQuaternion>(_mm_mul_ps(sse::Load(*this), _mm_set1_ps(s)));
 }
 
 XO_INL
 AQuaternion AQuaternion::operator -() const {
-    return AQuaternion(-i, -j, -k, -r);
+    return sse::Make<AQuaternion>(_mm_xor_ps(sse::Load(*this), _mm_set1_ps(-0.f)));
+}
+
+XO_INL
+AQuaternion XO_CC AQuaternion::operator * (AQuaternion const& other) const {
+    // Each lane of this times a shuffled, sign flipped copy of other, see the reference
+    // backend for the scalar form.
+    __m128 a = sse::Load(*this);
+    __m128 b = sse::Load(other);
+    __m128 rkji = _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3));
+    __m128 krij = _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2));
+    __m128 jirk = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 result = _mm_mul_ps(sse::Splat<3>(a), b);
+    result = sse::MultiplyAdd(sse::Splat<0>(a), _mm_xor_ps(rkji, _mm_setr_ps(0.f, -0.f, 0.f, -0.f)), result);
+    result = sse::MultiplyAdd(sse::Splat<1>(a), _mm_xor_ps(krij, _mm_setr_ps(0.f, 0.f, -0.f, -0.f)), result);
+    result = sse::MultiplyAdd(sse::Splat<2>(a), _mm_xor_ps(jirk, _mm_setr_ps(-0.f, 0.f, 0.f, -0.f)), result);
+    return sse::Make<AQuaternion>(result);
+}
+
+XO_INL
+AQuaternion& XO_CC AQuaternion::operator *= (AQuaternion const& other) {
+    return *this = *this * other;
+}
+
+XO_INL
+AVector3 XO_CC AQuaternion::Rotate(AVector3 const& v) const {
+    // The cross products see r in the w lane, against the 0 w of v and t, so w stays 0.
+    __m128 q = sse::Load(*this);
+    __m128 m = sse::Load(v);
+    __m128 t = sse::CrossProduct(q, m);
+    t = _mm_add_ps(t, t);
+    __m128 result = sse::MultiplyAdd(sse::Splat<3>(q), t, m);
+    return sse::Make<AVector3>(_mm_add_ps(result, sse::CrossProduct(q, t)));
 }
 
 XO_INL
@@ -2509,19 +3278,19 @@ float AQuaternion::Magnitude() const {
     return vec4.Magnitude();
 }
 
-XO_INL 
+XO_INL
 float AQuaternion::MagnitudeSquared() const {
     return vec4.MagnitudeSquared();
 };
 
 XO_INL
-AQuaternion AQuaternion::Normalized() const {
-    return AQuaternion(vec4.Normalized());
+AQuaternion AQuaternion::Normalized(Precision precision) const {
+    return AQuaternion(vec4.Normalized(precision));
 };
 
 XO_INL
-AQuaternion& AQuaternion::Normalize() {
-    vec4.Normalize(); return *this;
+AQuaternion& AQuaternion::Normalize(Precision precision) {
+    vec4.Normalize(precision); return *this;
 };
 
 XO_INL
@@ -2545,7 +3314,7 @@ AMatrix4x4 AQuaternion::ToMatrix() const {
 
 /*static*/ XO_INL
 AQuaternion XO_CC AQuaternion::Invert(AQuaternion const& quat) {
-    return AQuaternion(-quat.i, -quat.j, -quat.k, quat.r);
+    return sse::Make<AQuaternion>(_mm_xor_ps(sse::Load(quat), _mm_set_ps(0.f, -0.f, -0.f, -0.f)));
 }
 
 /*static*/ XO_INL
@@ -2558,7 +3327,6 @@ AQuaternion XO_CC AQuaternion::RotationAxisAngle(AVector3 const& axis, float ang
 /*static*/ XO_INL
 AQuaternion XO_CC AQuaternion::RotationEuler(AVector3 const& angles) {
     float sr, cp, sp, cy, sy, cr;
-    // todo: rename. yaw, pitch, roll are misnomers here. switch yaw and pitch.
     SinCos(angles.x * 0.5f, sy, cy);
     SinCos(angles.y * 0.5f, sp, cp);
     SinCos(angles.z * 0.5f, sr, cr);
@@ -2607,27 +3375,6999 @@ AQuaternion XO_CC AQuaternion::Slerp(AQuaternion const& start,
     return (s * s0) + (e * s1);
 }
 
-/*static*/ XO_INL 
+/*static*/ XO_INL
 bool XO_CC AQuaternion::RoughlyEqual(AQuaternion const& left, AQuaternion const& right) {
-    return CloseEnough(left.i, right.i)
-        && CloseEnough(left.j, right.j)
-        && CloseEnough(left.k, right.k)
-        && CloseEnough(left.r, right.r);
+    return sse::CloseEnoughMask(sse::Load(left), sse::Load(right)) == 0xF;
 }
 
-/*static*/ XO_INL 
+/*static*/ XO_INL
 bool XO_CC AQuaternion::ExactlyEqual(AQuaternion const& left, AQuaternion const& right) {
-    return left.i == right.i
-        && left.j == right.j
-        && left.k == right.k
-        && left.r == right.r;
+    return sse::ExactlyEqualMask(sse::Load(left), sse::Load(right)) == 0xF;
 }
 
 } // ::xo
-
-////////////////////////////////////////////////////////////////////////////////////////// end xo-math-reference.h inline
+////////////////////////////////////////////////////////////////////////////////////////// end xo-math-sse4.h inline
+#else
+////////////////////////////////////////////////////////////////////////////////////////// xo-math-reference.h inlined
+#line 18 "xo-math-reference.h"
+#if !defined(XO_CONFIG_DEFAULT_NEAR_PLANE)
+#   define XO_CONFIG_DEFAULT_NEAR_PLANE 0.1f
+#endif
+#if !defined(XO_CONFIG_DEFAULT_FAR_PLANE)
+#   define XO_CONFIG_DEFAULT_FAR_PLANE 1000.f
+#endif
+#if !defined(XO_CONFIG_DEFAULT_PRECISION)
+#   define XO_CONFIG_DEFAULT_PRECISION xo::Precision::Exact
 #endif
 
+#define XO_REF_ALN                  XO_ALN_16
+#define XO_REF_NEW_DEL(typeName)    XO_NEW_DEL_16(typeName)
+
+namespace xo {
+//////////////////////////////////////////////////////////////////////////////////////////
+struct Vector3 {
+    float x, y, z;
+    constexpr Vector3(float x, float y, float z) 
+        : x(x)
+        , y(y)
+        , z(z)
+    { }
+
+    constexpr explicit Vector3(float all)
+        : x(all)
+        , y(all)
+        , z(all) 
+    { }
+
+    Vector3() = default;
+    ~Vector3() = default;
+    Vector3(Vector3 const& other) = default;
+    Vector3(Vector3&& ref) = default;
+    Vector3& operator = (Vector3 const& other) = default;
+    Vector3& operator = (Vector3&& ref) = default;
+
+    Vector3 XO_CC operator + (Vector3 const& other) const;
+    Vector3 XO_CC operator - (Vector3 const& other) const;
+    Vector3 XO_CC operator * (Vector3 const& other) const;
+    Vector3 XO_CC operator / (Vector3 const& other) const;
+    Vector3& XO_CC operator += (Vector3 const& other);
+    Vector3& XO_CC operator -= (Vector3 const& other);
+    Vector3& XO_CC operator *= (Vector3 const& other);
+    Vector3& XO_CC operator /= (Vector3 const& other);
+
+    Vector3 XO_CC operator + (float value) const { return *this + Vector3(value); }
+    Vector3 XO_CC operator - (float value) const { return *this - Vector3(value); }
+    Vector3 XO_CC operator * (float value) const { return *this * Vector3(value); }
+    Vector3 XO_CC operator / (float value) const { return *this / Vector3(value); }
+    Vector3& XO_CC operator += (float value) { return *this += Vector3(value); }
+    Vector3& XO_CC operator -= (float value) { return *this -= Vector3(value); }
+    Vector3& XO_CC operator *= (float value) { return *this *= Vector3(value); }
+    Vector3& XO_CC operator /= (float value) { return *this /= Vector3(value); }
+
+    Vector3 operator -() const;
+
+    float Sum() const;
+
+    float Magnitude() const;
+    float MagnitudeSquared() const;
+
+    Vector3& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+    Vector3 Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+
+    static bool XO_CC RoughlyEqual(Vector3 const& left, Vector3 const& right);
+    static bool XO_CC ExactlyEqual(Vector3 const& left, Vector3 const& right);
+    static bool XO_CC RoughlyEqual(Vector3 const& left, float magnitude);
+    static bool XO_CC ExactlyEqual(Vector3 const& left, float magnitude);
+
+    static float XO_CC DotProduct(Vector3 const& left, Vector3 const& right);
+    static Vector3 XO_CC CrossProduct(Vector3 const& left, Vector3 const& right);
+    static Vector3 XO_CC Lerp(Vector3 const& left, Vector3 const& right, float t);
+    static float XO_CC DistanceSquared(Vector3 const& left, Vector3 const& right);
+    static float XO_CC Distance(Vector3 const& left, Vector3 const& right);
+
+    static const Vector3 Zero;
+    static const Vector3 One;
+    static const Vector3 Up;
+    static const Vector3 Down;
+    static const Vector3 Left;
+    static const Vector3 Right;
+    static const Vector3 Forward;
+    static const Vector3 Backward;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+struct Vector4 {
+    union {
+        struct { float x, y, z, w; };
+        float v[4];
+    };
+    constexpr Vector4(float x, float y, float z, float w)
+        : x(x)
+        , y(y)
+        , z(z)
+        , w(w)
+    { }
+
+    constexpr explicit Vector4(float all)
+        : x(all)
+        , y(all)
+        , z(all)
+        , w(all)
+    { }
+
+    constexpr explicit Vector4(Vector3 v3, float w = 0.f)
+        : x(v3.x)
+        , y(v3.y)
+        , z(v3.z)
+        , w(w)
+    { }
+
+    Vector4() = default;
+    ~Vector4() = default;
+    Vector4(Vector4 const& other) = default;
+    Vector4(Vector4&& ref) = default;
+    Vector4& operator = (Vector4 const& other) = default;
+    Vector4& operator = (Vector4&& ref) = default;
+
+    Vector4 XO_CC operator + (Vector4 const& other) const;
+    Vector4 XO_CC operator - (Vector4 const& other) const;
+    Vector4 XO_CC operator * (Vector4 const& other) const;
+    Vector4 XO_CC operator / (Vector4 const& other) const;
+    Vector4& XO_CC operator += (Vector4 const& other);
+    Vector4& XO_CC operator -= (Vector4 const& other);
+    Vector4& XO_CC operator *= (Vector4 const& other);
+    Vector4& XO_CC operator /= (Vector4 const& other);
+
+    Vector4 XO_CC operator + (float value) const { return *this + Vector4(value); }
+    Vector4 XO_CC operator - (float value) const { return *this - Vector4(value); }
+    Vector4 XO_CC operator * (float value) const { return *this * Vector4(value); }
+    Vector4 XO_CC operator / (float value) const { return *this / Vector4(value); }
+    Vector4& XO_CC operator += (float value) { return *this += Vector4(value); }
+    Vector4& XO_CC operator -= (float value) { return *this -= Vector4(value); }
+    Vector4& XO_CC operator *= (float value) { return *this *= Vector4(value); }
+    Vector4& XO_CC operator /= (float value) { return *this /= Vector4(value); }
+
+    Vector4 operator -() const;
+
+    float operator[] (int index) const;
+    float& operator[] (int index);
+
+    float Sum() const;
+
+    float Magnitude() const;
+    float MagnitudeSquared() const;
+    Vector4 Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+    Vector4& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+
+    static bool XO_CC RoughlyEqual(Vector4 const& left, Vector4 const& right);
+    static bool XO_CC ExactlyEqual(Vector4 const& left, Vector4 const& right);
+    static bool XO_CC RoughlyEqual(Vector4 const& left, float magnitude);
+    static bool XO_CC ExactlyEqual(Vector4 const& left, float magnitude);
+
+    static float XO_CC DotProduct(Vector4 const& left, Vector4 const& right);
+    static Vector4 XO_CC Lerp(Vector4 const& left, Vector4 const& right, float t);
+
+    static const Vector4 Zero;
+    static const Vector4 One;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+struct Matrix4x4 {
+    union {
+        Vector4 rows[4];
+        float v[16];
+    };
+    constexpr Matrix4x4(Vector4 const rows[4])
+        : rows {
+            rows[0],
+            rows[1],
+            rows[2],
+            rows[3] }
+    { }
+
+    constexpr Matrix4x4(Vector4 const& row0, 
+                        Vector4 const& row1,
+                        Vector4 const& row2,
+                        Vector4 const& row3)
+        : rows{
+            row0,
+            row1,
+            row2,
+            row3 }
+    { }
+
+    constexpr explicit Matrix4x4(float all)
+        : rows{
+            Vector4(all),
+            Vector4(all),
+            Vector4(all),
+            Vector4(all) }
+    { }
+
+    Matrix4x4() = default;
+    ~Matrix4x4() = default;
+    Matrix4x4(Matrix4x4 const& other) = default;
+    Matrix4x4(Matrix4x4&& ref) = default;
+    Matrix4x4& operator = (Matrix4x4 const& other) = default;
+    Matrix4x4& operator = (Matrix4x4&& ref) = default;
+
+    Vector3 XO_CC Transform(Vector3 const& v3) const;
+    Vector4 XO_CC Transform(Vector4 const& v4) const;
+    Vector3 XO_CC InverseTransform(Vector3 const& v3) const;
+    Vector4 XO_CC InverseTransform(Vector4 const& v4) const;
+
+    // Transforms 'count' vectors from in to out (which may be the same array). Points and
+    // directions are row vectors times the matrix, like InverseTransform and
+    // Matrix3x4::TransformPoint: points get the translation from rows[3], directions don't.
+    // Homogeneous is InverseTransform(Vector4), so a point with w = 1 comes out as from
+    // TransformPoints, and nothing divides by w. Strides are in bytes, for
+    // vectors that live inside larger structs. Runs 8 or 16 at a time with AVX2 or AVX512,
+    // see xo-math-batch.h.
+    void XO_CC TransformPoints(Vector3 const* in,
+                               Vector3* out,
+                               size_t count,
+                               size_t inStride = sizeof(Vector3),
+                               size_t outStride = sizeof(Vector3)) const;
+    void XO_CC TransformDirections(Vector3 const* in,
+                                   Vector3* out,
+                                   size_t count,
+                                   size_t inStride = sizeof(Vector3),
+                                   size_t outStride = sizeof(Vector3)) const;
+    void XO_CC TransformHomogeneous(Vector4 const* in,
+                                    Vector4* out,
+                                    size_t count,
+                                    size_t inStride = sizeof(Vector4),
+                                    size_t outStride = sizeof(Vector4)) const;
+    Matrix4x4 XO_CC operator * (Matrix4x4 const& other) const;
+    Matrix4x4& XO_CC operator *= (Matrix4x4 const& other);
+
+    Vector4 operator[] (int index) const;
+    Vector4& operator[] (int index);
+    
+    Vector3 Up() const;
+    Vector3 Down() const;
+    Vector3 Left() const;
+    Vector3 Right() const;
+    Vector3 Forward() const;
+    Vector3 Backward() const;
+
+    // out[i] = left[i] * right[i], out may be left or right. Runs on the batch kernels, see
+    // xo-math-batch.h.
+    static void XO_CC Multiply(Matrix4x4 const* left,
+                               Matrix4x4 const* right,
+                               Matrix4x4* out,
+                               size_t count);
+    static Matrix4x4 XO_CC Transpose(Matrix4x4 const& matrixIn);
+    static Matrix4x4 XO_CC Invert(Matrix4x4 const& matrixIn);
+    static bool XO_CC InvertSafe(Matrix4x4 const& matrixIn, Matrix4x4& matrixOut);
+    // Cheaper inverses for matrices whose last column is (0, 0, 0, 1), like the ones built
+    // by Translation, Scale, the Rotation functions, LookAt and products of them.
+    // InvertAffine inverts the upper 3x3 and moves the translation row back through it.
+    // InvertOrthonormal is for rotation and translation only (no scale or shear): the
+    // 3x3 inverse is its transpose. Neither checks its input, IsAffine and IsOrthonormal
+    // can do that in an assert. IsOrthonormal allows 1e-5 of error in the dot products.
+    static Matrix4x4 XO_CC InvertAffine(Matrix4x4 const& matrixIn);
+    static Matrix4x4 XO_CC InvertOrthonormal(Matrix4x4 const& matrixIn);
+    static bool XO_CC IsAffine(Matrix4x4 const& matrixIn);
+    static bool XO_CC IsOrthonormal(Matrix4x4 const& matrixIn);
+    static Matrix4x4 XO_CC Translation(Vector3 const& pos);
+    static Matrix4x4 XO_CC Scale(Vector3 const& scale);
+    static Matrix4x4 XO_CC RotationYaw(float yaw);
+    static Matrix4x4 XO_CC RotationPitch(float pitch);
+    static Matrix4x4 XO_CC RotationRoll(float roll);
+    static Matrix4x4 XO_CC RotationYawPitchRoll(float yaw, float pitch, float roll);
+    static Matrix4x4 XO_CC RotationAxisAngle(Vector3 const& axis, float angle);
+    static Matrix4x4 XO_CC PerspectiveFOV(float fov, 
+                                          float aspect, 
+                                          float nearPlane = XO_CONFIG_DEFAULT_NEAR_PLANE, 
+                                          float farPlane = XO_CONFIG_DEFAULT_FAR_PLANE);
+    static Matrix4x4 XO_CC Perspective(float width, 
+                                       float height, 
+                                       float aspect, 
+                                       float nearPlane = XO_CONFIG_DEFAULT_NEAR_PLANE, 
+                                       float farPlane = XO_CONFIG_DEFAULT_FAR_PLANE);
+    static Matrix4x4 XO_CC Orthographic(float width,
+                                        float height,
+                                        float nearPlane,
+                                        float farPlane);
+    static Matrix4x4 XO_CC LookAt(Vector3 const& from, 
+                                  Vector3 const& to, 
+                                  Vector3 const& up = Vector3::Up);
+
+    static bool XO_CC RoughlyEqual(Matrix4x4 const& left, Matrix4x4 const& right);
+    static bool XO_CC ExactlyEqual(Matrix4x4 const& left, Matrix4x4 const& right);
+
+    static const Matrix4x4 One;
+    static const Matrix4x4 Zero;
+    static const Matrix4x4 Identity;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+struct Quaternion {
+    union {
+        struct { float i, j, k, r; };
+        Vector4 vec4;
+    };
+
+    constexpr Quaternion(float i, float j, float k, float r)
+        : i(i)
+        , j(j)
+        , k(k)
+        , r(r)
+    { }
+
+    constexpr explicit Quaternion(float all)
+        : i(all)
+        , j(all)
+        , k(all)
+        , r(all)
+    { }
+
+    constexpr explicit Quaternion(Vector4 const& v4)
+        : vec4(v4)
+    { }
+
+    Quaternion() = default;
+    ~Quaternion() = default;
+    Quaternion(Quaternion const& other) = default;
+    Quaternion(Quaternion&& ref) = default;
+    Quaternion& operator = (Quaternion const& other) = default;
+    Quaternion& operator = (Quaternion&& ref) = default;
+
+    Quaternion operator + (Quaternion other) const;
+    Quaternion operator * (float scalar) const;
+    Quaternion operator -() const;
+    // The Hamilton product: rotating by a * b is rotating by b, then by a.
+    Quaternion XO_CC operator * (Quaternion const& other) const;
+    Quaternion& XO_CC operator *= (Quaternion const& other);
+
+    // v rotated by this, which should be normalized. The same as ToMatrix().Transform(v),
+    // without the matrix: v + 2r(q x v) + q x 2(q x v) for the vector part q.
+    Vector3 XO_CC Rotate(Vector3 const& v) const;
+
+    float Magnitude() const;
+    float MagnitudeSquared() const;
+    Quaternion Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+    Quaternion& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+
+    Matrix4x4 ToMatrix() const;
+
+    static Quaternion XO_CC Invert(Quaternion const& quat);
+    static Quaternion XO_CC RotationAxisAngle(Vector3 const& axis, float angle);
+    static Quaternion XO_CC RotationEuler(Vector3 const& angles);
+    static float XO_CC DotProduct(Quaternion const& left, Quaternion const& right);
+    static Quaternion XO_CC Lerp(Quaternion const& start, Quaternion const& end, float t);
+    static Quaternion XO_CC Slerp(Quaternion const& start, 
+                                  Quaternion const& end, 
+                                  float t);
+
+    static bool XO_CC RoughlyEqual(Quaternion const& left, Quaternion const& right);
+    static bool XO_CC ExactlyEqual(Quaternion const& left, Quaternion const& right);
+
+    static const Quaternion Zero;
+    static const Quaternion Identity;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// vector 3, aligned for cpu specific optimizations (where applicable) 
+struct XO_REF_ALN AVector3 {
+    XO_REF_NEW_DEL(AVector3);
+    float x, y, z;
+    constexpr AVector3(float x, float y, float z)
+        : x(x)
+        , y(y)
+        , z(z)
+    { }
+
+    constexpr explicit AVector3(float all)
+        : x(all)
+        , y(all)
+        , z(all)
+    { }
+
+    AVector3() = default;
+    ~AVector3() = default;
+    AVector3(AVector3 const& other) = default;
+    AVector3(AVector3&& ref) = default;
+    AVector3& operator = (AVector3 const& other) = default;
+    AVector3& operator = (AVector3&& ref) = default;
+
+    AVector3 XO_CC operator + (AVector3 const& other) const;
+    AVector3 XO_CC operator - (AVector3 const& other) const;
+    AVector3 XO_CC operator * (AVector3 const& other) const;
+    AVector3 XO_CC operator / (AVector3 const& other) const;
+    AVector3& XO_CC operator += (AVector3 const& other);
+    AVector3& XO_CC operator -= (AVector3 const& other);
+    AVector3& XO_CC operator *= (AVector3 const& other);
+    AVector3& XO_CC operator /= (AVector3 const& other);
+
+    AVector3 XO_CC operator + (float value) const { return *this + AVector3(value); }
+    AVector3 XO_CC operator - (float value) const { return *this - AVector3(value); }
+    AVector3 XO_CC operator * (float value) const { return *this * AVector3(value); }
+    AVector3 XO_CC operator / (float value) const { return *this / AVector3(value); }
+    AVector3& XO_CC operator += (float value) { return *this += AVector3(value); }
+    AVector3& XO_CC operator -= (float value) { return *this -= AVector3(value); }
+    AVector3& XO_CC operator *= (float value) { return *this *= AVector3(value); }
+    AVector3& XO_CC operator /= (float value) { return *this /= AVector3(value); }
+
+    AVector3 operator -() const;
+
+    float Sum() const;
+
+    float Magnitude() const;
+    float MagnitudeSquared() const;
+
+    AVector3& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+    AVector3 Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+
+    static bool XO_CC RoughlyEqual(AVector3 const& left, AVector3 const& right);
+    static bool XO_CC ExactlyEqual(AVector3 const& left, AVector3 const& right);
+    static bool XO_CC RoughlyEqual(AVector3 const& left, float magnitude);
+    static bool XO_CC ExactlyEqual(AVector3 const& left, float magnitude);
+
+    static float XO_CC DotProduct(AVector3 const& left, AVector3 const& right);
+    static AVector3 XO_CC CrossProduct(AVector3 const& left, AVector3 const& right);
+    static AVector3 XO_CC Lerp(AVector3 const& left, AVector3 const& right, float t);
+    static float XO_CC DistanceSquared(AVector3 const& left, AVector3 const& right);
+    static float XO_CC Distance(AVector3 const& left, AVector3 const& right);
+
+    static const AVector3 Zero;
+    static const AVector3 One;
+    static const AVector3 Up;
+    static const AVector3 Down;
+    static const AVector3 Left;
+    static const AVector3 Right;
+    static const AVector3 Forward;
+    static const AVector3 Backward;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// vector 4, aligned for cpu specific optimizations (where applicable)
+struct XO_REF_ALN AVector4 {
+    XO_REF_NEW_DEL(AVector4);
+    union {
+        struct { float x, y, z, w; };
+        float v[4];
+    };
+    constexpr AVector4(float x, float y, float z, float w)
+        : x(x)
+        , y(y)
+        , z(z)
+        , w(w)
+    { }
+
+    constexpr explicit AVector4(float all)
+        : x(all)
+        , y(all)
+        , z(all)
+        , w(all)
+    { }
+
+    constexpr explicit AVector4(AVector3 v3, float w = 0.f)
+        : x(v3.x)
+        , y(v3.y)
+        , z(v3.z)
+        , w(w)
+    { }
+
+    AVector4() = default;
+    ~AVector4() = default;
+    AVector4(AVector4 const& other) = default;
+    AVector4(AVector4&& ref) = default;
+    AVector4& operator = (AVector4 const& other) = default;
+    AVector4& operator = (AVector4&& ref) = default;
+
+    AVector4 XO_CC operator + (AVector4 const& other) const;
+    AVector4 XO_CC operator - (AVector4 const& other) const;
+    AVector4 XO_CC operator * (AVector4 const& other) const;
+    AVector4 XO_CC operator / (AVector4 const& other) const;
+    AVector4& XO_CC operator += (AVector4 const& other);
+    AVector4& XO_CC operator -= (AVector4 const& other);
+    AVector4& XO_CC operator *= (AVector4 const& other);
+    AVector4& XO_CC operator /= (AVector4 const& other);
+
+    AVector4 XO_CC operator + (float value) const { return *this + AVector4(value); }
+    AVector4 XO_CC operator - (float value) const { return *this - AVector4(value); }
+    AVector4 XO_CC operator * (float value) const { return *this * AVector4(value); }
+    AVector4 XO_CC operator / (float value) const { return *this / AVector4(value); }
+    AVector4& XO_CC operator += (float value) { return *this += AVector4(value); }
+    AVector4& XO_CC operator -= (float value) { return *this -= AVector4(value); }
+    AVector4& XO_CC operator *= (float value) { return *this *= AVector4(value); }
+    AVector4& XO_CC operator /= (float value) { return *this /= AVector4(value); }
+
+    AVector4 operator -() const;
+
+    float operator[] (int index) const;
+    float& operator[] (int index);
+
+    float Sum() const;
+
+    float Magnitude() const;
+    float MagnitudeSquared() const;
+    AVector4 Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+    AVector4& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+
+    static bool XO_CC RoughlyEqual(AVector4 const& left, AVector4 const& right);
+    static bool XO_CC ExactlyEqual(AVector4 const& left, AVector4 const& right);
+    static bool XO_CC RoughlyEqual(AVector4 const& left, float magnitude);
+    static bool XO_CC ExactlyEqual(AVector4 const& left, float magnitude);
+
+    static float XO_CC DotProduct(AVector4 const& left, AVector4 const& right);
+    static AVector4 XO_CC Lerp(AVector4 const& left, AVector4 const& right, float t);
+
+    static const AVector4 Zero;
+    static const AVector4 One;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// matrix4x4, aligned for cpu specific optimizations (where applicable)
+struct XO_REF_ALN AMatrix4x4 {
+    XO_REF_NEW_DEL(AMatrix4x4);
+    union {
+        AVector4 rows[4];
+        float v[16];
+    };
+    constexpr AMatrix4x4(AVector4 const rows[4])
+        : rows{
+        rows[0],
+        rows[1],
+        rows[2],
+        rows[3] }
+    { }
+
+    constexpr AMatrix4x4(AVector4 const& row0,
+        AVector4 const& row1,
+        AVector4 const& row2,
+        AVector4 const& row3)
+        : rows{
+        row0,
+        row1,
+        row2,
+        row3 }
+    { }
+
+    constexpr explicit AMatrix4x4(float all)
+        : rows{
+        AVector4(all),
+        AVector4(all),
+        AVector4(all),
+        AVector4(all) }
+    { }
+
+    AMatrix4x4() = default;
+    ~AMatrix4x4() = default;
+    AMatrix4x4(AMatrix4x4 const& other) = default;
+    AMatrix4x4(AMatrix4x4&& ref) = default;
+    AMatrix4x4& operator = (AMatrix4x4 const& other) = default;
+    AMatrix4x4& operator = (AMatrix4x4&& ref) = default;
+
+    AVector3 XO_CC Transform(AVector3 const& v3) const;
+    AVector4 XO_CC Transform(AVector4 const& v4) const;
+    AVector3 XO_CC InverseTransform(AVector3 const& v3) const;
+    AVector4 XO_CC InverseTransform(AVector4 const& v4) const;
+
+    // Transforms 'count' vectors from in to out (which may be the same array). Points and
+    // directions are row vectors times the matrix, like InverseTransform and
+    // Matrix3x4::TransformPoint: points get the translation from rows[3], directions don't.
+    // Homogeneous is InverseTransform(AVector4), so a point with w = 1 comes out as from
+    // TransformPoints, and nothing divides by w. Strides are in bytes, for
+    // vectors that live inside larger structs. Runs 8 or 16 at a time with AVX2 or AVX512,
+    // see xo-math-batch.h.
+    void XO_CC TransformPoints(AVector3 const* in,
+                               AVector3* out,
+                               size_t count,
+                               size_t inStride = sizeof(AVector3),
+                               size_t outStride = sizeof(AVector3)) const;
+    void XO_CC TransformDirections(AVector3 const* in,
+                                   AVector3* out,
+                                   size_t count,
+                                   size_t inStride = sizeof(AVector3),
+                                   size_t outStride = sizeof(AVector3)) const;
+    void XO_CC TransformHomogeneous(AVector4 const* in,
+                                    AVector4* out,
+                                    size_t count,
+                                    size_t inStride = sizeof(AVector4),
+                                    size_t outStride = sizeof(AVector4)) const;
+
+    AMatrix4x4 XO_CC operator * (AMatrix4x4 const& other) const;
+    AMatrix4x4& XO_CC operator *= (AMatrix4x4 const& other);
+
+    AVector4 operator[] (int index) const;
+    AVector4& operator[] (int index);
+
+    AVector3 Up() const;
+    AVector3 Down() const;
+    AVector3 Left() const;
+    AVector3 Right() const;
+    AVector3 Forward() const;
+    AVector3 Backward() const;
+
+    // out[i] = left[i] * right[i], out may be left or right. Runs on the batch kernels, see
+    // xo-math-batch.h.
+    static void XO_CC Multiply(AMatrix4x4 const* left,
+                               AMatrix4x4 const* right,
+                               AMatrix4x4* out,
+                               size_t count);
+    static AMatrix4x4 XO_CC Transpose(AMatrix4x4 const& matrixIn);
+    static AMatrix4x4 XO_CC Invert(AMatrix4x4 const& matrixIn);
+    static bool XO_CC InvertSafe(AMatrix4x4 const& matrixIn, AMatrix4x4& matrixOut);
+    // Cheaper inverses for matrices whose last column is (0, 0, 0, 1), like the ones built
+    // by Translation, Scale, the Rotation functions, LookAt and products of them.
+    // InvertAffine inverts the upper 3x3 and moves the translation row back through it.
+    // InvertOrthonormal is for rotation and translation only (no scale or shear): the
+    // 3x3 inverse is its transpose. Neither checks its input, IsAffine and IsOrthonormal
+    // can do that in an assert. IsOrthonormal allows 1e-5 of error in the dot products.
+    static AMatrix4x4 XO_CC InvertAffine(AMatrix4x4 const& matrixIn);
+    static AMatrix4x4 XO_CC InvertOrthonormal(AMatrix4x4 const& matrixIn);
+    static bool XO_CC IsAffine(AMatrix4x4 const& matrixIn);
+    static bool XO_CC IsOrthonormal(AMatrix4x4 const& matrixIn);
+    static AMatrix4x4 XO_CC Translation(AVector3 const& pos);
+    static AMatrix4x4 XO_CC Scale(AVector3 const& scale);
+    static AMatrix4x4 XO_CC RotationYaw(float yaw);
+    static AMatrix4x4 XO_CC RotationPitch(float pitch);
+    static AMatrix4x4 XO_CC RotationRoll(float roll);
+    static AMatrix4x4 XO_CC RotationYawPitchRoll(float yaw, float pitch, float roll);
+    static AMatrix4x4 XO_CC RotationAxisAngle(AVector3 const& axis, float angle);
+    static AMatrix4x4 XO_CC PerspectiveFOV(float fov,
+                                           float aspect,
+                                           float nearPlane = XO_CONFIG_DEFAULT_NEAR_PLANE,
+                                           float farPlane = XO_CONFIG_DEFAULT_FAR_PLANE);
+    static AMatrix4x4 XO_CC Perspective(float width,
+                                        float height,
+                                        float aspect,
+                                        float nearPlane = XO_CONFIG_DEFAULT_NEAR_PLANE,
+                                        float farPlane = XO_CONFIG_DEFAULT_FAR_PLANE);
+    static AMatrix4x4 XO_CC Orthographic(float width,
+                                         float height,
+                                         float nearPlane,
+                                         float farPlane);
+    static AMatrix4x4 XO_CC LookAt(AVector3 const& from,
+                                   AVector3 const& to,
+                                   AVector3 const& up = AVector3::Up);
+
+    static bool XO_CC RoughlyEqual(AMatrix4x4 const& left, AMatrix4x4 const& right);
+    static bool XO_CC ExactlyEqual(AMatrix4x4 const& left, AMatrix4x4 const& right);
+
+    static const AMatrix4x4 One;
+    static const AMatrix4x4 Zero;
+    static const AMatrix4x4 Identity;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// quaternion, aligned for cpu specific optimizations (where applicable)
+struct XO_REF_ALN AQuaternion {
+    XO_REF_NEW_DEL(AQuaternion);
+    union {
+        struct { float i, j, k, r; };
+        AVector4 vec4;
+    };
+
+    constexpr AQuaternion(float i, float j, float k, float r)
+        : i(i)
+        , j(j)
+        , k(k)
+        , r(r)
+    { }
+
+    constexpr explicit AQuaternion(float all)
+        : i(all)
+        , j(all)
+        , k(all)
+        , r(all)
+    { }
+
+    constexpr explicit AQuaternion(AVector4 const& v4)
+        : vec4(v4)
+    { }
+
+    AQuaternion() = default;
+    ~AQuaternion() = default;
+    AQuaternion(AQuaternion const& other) = default;
+    AQuaternion(AQuaternion&& ref) = default;
+    AQuaternion& operator = (AQuaternion const& other) = default;
+    AQuaternion& operator = (AQuaternion&& ref) = default;
+
+    AQuaternion operator + (AQuaternion other) const;
+    AQuaternion operator * (float scalar) const;
+    AQuaternion operator -() const;
+    // The Hamilton product: rotating by a * b is rotating by b, then by a.
+    AQuaternion XO_CC operator * (AQuaternion const& other) const;
+    AQuaternion& XO_CC operator *= (AQuaternion const& other);
+
+    // v rotated by this, which should be normalized. The same as ToMatrix().Transform(v),
+    // without the matrix: v + 2r(q x v) + q x 2(q x v) for the vector part q.
+    AVector3 XO_CC Rotate(AVector3 const& v) const;
+
+    float Magnitude() const;
+    float MagnitudeSquared() const;
+    AQuaternion Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+    AQuaternion& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+
+    AMatrix4x4 ToMatrix() const;
+
+    static AQuaternion XO_CC Invert(AQuaternion const& quat);
+    static AQuaternion XO_CC RotationAxisAngle(AVector3 const& axis, float angle);
+    static AQuaternion XO_CC RotationEuler(AVector3 const& angles);
+    static float XO_CC DotProduct(AQuaternion const& left, AQuaternion const& right);
+    static AQuaternion XO_CC Lerp(AQuaternion const& start, AQuaternion const& end, float t);
+    static AQuaternion XO_CC Slerp(AQuaternion const& start, 
+                                  AQuaternion const& end, 
+                                  float t);
+
+    static bool XO_CC RoughlyEqual(AQuaternion const& left, AQuaternion const& right);
+    static bool XO_CC ExactlyEqual(AQuaternion const& left, AQuaternion const& right);
+
+    static const AQuaternion Zero;
+    static const AQuaternion Identity;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////// Vector 3
+#if defined(XO_MATH_IMPL)
+/*static*/ const Vector3 Vector3::Zero(0.f);
+/*static*/ const Vector3 Vector3::One(1.f);
+/*static*/ const Vector3 Vector3::Left(-1.f, 0.f, 0.f);
+/*static*/ const Vector3 Vector3::Right(1.f, 0.f, 0.f);
+
+#   if !defined(XO_CONFIG_Y_UP) || !defined(XO_CONFIG_Z_UP)
+    static_assert(false, 
+        "define both XO_CONFIG_Y_UP and XO_CONFIG_Z_UP. One should have a value of 1, and\
+ the other should have a value of 0");
+#   endif
+
+#   if !defined(XO_CONFIG_LEFT_HANDED) || !defined(XO_CONFIG_RIGHT_HANDED)
+    static_assert(false, 
+        "define both XO_CONFIG_LEFT_HANDED and XO_CONFIG_RIGHT_HANDED. One should have a \
+value of 1, and the other should have a value of 0");
+#   endif
+
+#   if XO_CONFIG_Y_UP
+    static_assert(XO_CONFIG_Z_UP == 0, 
+        "XO_CONFIG_Z_UP should be 0 if XO_CONFIG_Y_UP is 1");
+/*static*/ const Vector3 Vector3::Up(0.f, 1.f, 0.f);
+/*static*/ const Vector3 Vector3::Down(0.f, -1.f, 0.f);
+#       if XO_CONFIG_LEFT_HANDED
+        static_assert(XO_CONFIG_RIGHT_HANDED == 0, 
+            "XO_CONFIG_RIGHT_HANDED should be 0 if XO_CONFIG_LEFT_HANDED is 1");
+/*static*/ const Vector3 Vector3::Forward(0.f, 0.f, 1.f);
+/*static*/ const Vector3 Vector3::Backward(0.f, 0.f, -1.f);
+#       elif XO_CONFIG_RIGHT_HANDED
+        static_assert(XO_CONFIG_LEFT_HANDED == 0, 
+            "XO_CONFIG_LEFT_HANDED should be 0 if XO_CONFIG_RIGHT_HANDED is 1");
+/*static*/ const Vector3 Vector3::Forward(0.f, 0.f, -1.f);
+/*static*/ const Vector3 Vector3::Backward(0.f, 0.f, 1.f);
+#       else
+        static_assert(false, 
+            "XO_CONFIG_LEFT_HANDED or XO_CONFIG_RIGHT_HANDED should have a non zero \
+value...");
+#       endif
+#   elif XO_CONFIG_Z_UP
+// no static assert here about XO_CONFIG_Y_UP, because it's been checked.
+/*static*/ const Vector3 Vector3::Up(0.f, 0.f, 1.f);
+/*static*/ const Vector3 Vector3::Down(0.f, 0.f, -1.f);
+#       if XO_CONFIG_LEFT_HANDED
+        static_assert(XO_CONFIG_RIGHT_HANDED == 0, 
+            "XO_CONFIG_RIGHT_HANDED should be 0 if XO_CONFIG_LEFT_HANDED is 1");
+/*static*/ const Vector3 Vector3::Forward(0.f, -1.f, 0.f);
+/*static*/ const Vector3 Vector3::Backward(0.f, 1.f, 0.f);
+#       elif XO_CONFIG_RIGHT_HANDED
+        static_assert(XO_CONFIG_LEFT_HANDED == 0, 
+            "XO_CONFIG_LEFT_HANDED should be 0 if XO_CONFIG_RIGHT_HANDED is 1");
+/*static*/ const Vector3 Vector3::Forward(0.f, 1.f, 0.f);
+/*static*/ const Vector3 Vector3::Backward(0.f, -1.f, 0.f);
+#       else
+        static_assert(false,
+            "XO_CONFIG_LEFT_HANDED or XO_CONFIG_RIGHT_HANDED should have a non zero \
+value...");
+#       endif
+#   else
+    static_assert(false,
+        "XO_CONFIG_Y_UP or XO_CONFIG_Z_UP should have a non zero value...");
+#   endif
+#endif
+
+XO_INL 
+Vector3 XO_CC Vector3::operator + (Vector3 const& other) const { 
+    return Vector3(x + other.x, y + other.y, z + other.z);
+}
+
+XO_INL
+Vector3 XO_CC Vector3::operator - (Vector3 const& other) const {
+    return Vector3(x - other.x, y - other.y, z - other.z);
+}
+
+XO_INL
+Vector3 XO_CC Vector3::operator * (Vector3 const& other) const {
+    return Vector3(x * other.x, y * other.y, z * other.z);
+}
+
+XO_INL
+Vector3 XO_CC Vector3::operator / (Vector3 const& other) const {
+    return Vector3(x / other.x, y / other.y, z / other.z);
+}
+
+XO_INL
+Vector3& XO_CC Vector3::operator += (Vector3 const& other) {
+    x += other.x;
+    y += other.y;
+    z += other.z;
+    return *this;
+}
+
+XO_INL
+Vector3& XO_CC Vector3::operator -= (Vector3 const& other) {
+    x -= other.x;
+    y -= other.y;
+    z -= other.z;
+    return *this;
+}
+
+XO_INL
+Vector3& XO_CC Vector3::operator *= (Vector3 const& other) {
+    x *= other.x;
+    y *= other.y;
+    z *= other.z;
+    return *this;
+}
+
+XO_INL
+Vector3& XO_CC Vector3::operator /= (Vector3 const& other) {
+    x /= other.x;
+    y /= other.y;
+    z /= other.z;
+    return *this;
+}
+
+XO_INL Vector3 Vector3::operator -() const { return Vector3(-x, -y, -z); };
+
+XO_INL float Vector3::Sum() const { return x + y + z; }
+
+XO_INL float Vector3::MagnitudeSquared() const { return ((*this) * (*this)).Sum(); }
+XO_INL float Vector3::Magnitude() const { return xo::Sqrt(MagnitudeSquared()); }
+
+XO_INL Vector3& Vector3::Normalize(Precision precision) {
+    if (precision == Precision::Exact) {
+        return (*this) /= Vector3(Magnitude());
+    }
+    return (*this) *= Vector3(InverseSqrt(MagnitudeSquared(), precision));
+}
+XO_INL Vector3 Vector3::Normalized(Precision precision) const { return Vector3(*this).Normalize(precision); }
+
+/*static*/ XO_INL
+bool XO_CC Vector3::RoughlyEqual(Vector3 const& left, Vector3 const& right) {
+    return CloseEnough(left.x, right.x)
+        && CloseEnough(left.y, right.y)
+        && CloseEnough(left.z, right.z);
+}
+
+/*static*/ XO_INL
+bool XO_CC Vector3::ExactlyEqual(Vector3 const& left, Vector3 const& right) {
+    return left.x == right.x
+        && left.y == right.y
+        && left.z == right.z;
+}
+/*static*/ XO_INL
+bool XO_CC Vector3::RoughlyEqual(Vector3 const& left, float magnitude) {
+    return CloseEnough(left.MagnitudeSquared(), Pow<2>(magnitude));
+}
+
+/*static*/ XO_INL
+bool XO_CC Vector3::ExactlyEqual(Vector3 const& left, float magnitude) {
+    return left.MagnitudeSquared() == Pow<2>(magnitude);
+}
+
+/*static*/ XO_INL
+float XO_CC Vector3::DotProduct(Vector3 const& left, Vector3 const& right) {
+    return (left * right).Sum();
+}
+
+/*static*/ XO_INL
+Vector3 XO_CC Vector3::CrossProduct(Vector3 const& left, Vector3 const& right) {
+    return Vector3(
+        left.y * right.z - left.z * right.y,
+        left.z * right.x - left.x * right.z,
+        left.x * right.y - left.y * right.x);
+}
+
+/*static*/ XO_INL
+Vector3 XO_CC Vector3::Lerp(Vector3 const& left, Vector3 const& right, float t) {
+    return left + Vector3(t) * (right - left);
+}
+
+/*static*/ XO_INL
+float XO_CC Vector3::DistanceSquared(Vector3 const& left, Vector3 const& right) {
+    return (right - left).MagnitudeSquared();
+}
+
+/*static*/ XO_INL
+float XO_CC Vector3::Distance(Vector3 const& left, Vector3 const& right) {
+    return (right - left).Magnitude();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////// Vector 4
+
+XO_INL
+Vector4 XO_CC Vector4::operator + (Vector4 const& other) const {
+    return Vector4(x + other.x, y + other.y, z + other.z, w + other.w);
+}
+
+XO_INL
+Vector4 XO_CC Vector4::operator - (Vector4 const& other) const {
+    return Vector4(x - other.x, y - other.y, z - other.z, w - other.w);
+}
+
+XO_INL
+Vector4 XO_CC Vector4::operator * (Vector4 const& other) const {
+    return Vector4(x*other.x, y*other.y, z*other.z, w*other.w);
+}
+
+XO_INL
+Vector4 XO_CC Vector4::operator / (Vector4 const& other) const {
+    return Vector4(x / other.x, y / other.y, z / other.z, w / other.w);
+}
+
+XO_INL 
+Vector4& XO_CC Vector4::operator += (Vector4 const& other) {
+    x += other.x; 
+    y += other.y; 
+    z += other.z; 
+    w += other.w; 
+    return *this;
+};
+
+XO_INL 
+Vector4& XO_CC Vector4::operator -= (Vector4 const& other) {
+    x -=other.x;
+    y -=other.y;
+    z -= other.z;
+    w -= other.w;
+    return *this; };
+
+XO_INL 
+Vector4& XO_CC Vector4::operator *= (Vector4 const& other) {
+    x *= other.x;
+    y *= other.y;
+    z *= other.z;
+    w *= other.w;
+    return *this;
+};
+
+XO_INL 
+Vector4& XO_CC Vector4::operator /= (Vector4 const& other) {
+    x /= other.x;
+    y /= other.y;
+    z /= other.z;
+    w /= other.w;
+    return *this;
+};
+
+XO_INL Vector4 Vector4::operator -() const { return Vector4(-x, -y, -z, -w); }
+
+XO_INL float Vector4::operator[] (int index) const { return v[index]; }
+XO_INL float& Vector4::operator[] (int index) { return v[index]; }
+
+XO_INL float Vector4::Sum() const { return x + y + z + w; }
+
+XO_INL float Vector4::MagnitudeSquared() const { return x * x + y * y + z * z + w * w; }
+XO_INL float Vector4::Magnitude() const { return Sqrt(MagnitudeSquared()); }
+XO_INL Vector4 Vector4::Normalized(Precision precision) const { return Vector4(*this).Normalize(precision); }
+XO_INL Vector4& Vector4::Normalize(Precision precision) {
+    if (precision == Precision::Exact) {
+        return (*this) /= Vector4(Magnitude());
+    }
+    return (*this) *= Vector4(InverseSqrt(MagnitudeSquared(), precision));
+}
+
+/*static*/ XO_INL 
+bool XO_CC Vector4::RoughlyEqual(Vector4 const& left, Vector4 const& right) {
+    return CloseEnough(left.x, right.x)
+        && CloseEnough(left.y, right.y)
+        && CloseEnough(left.z, right.z)
+        && CloseEnough(left.w, right.w);
+}
+
+/*static*/ XO_INL 
+bool XO_CC Vector4::ExactlyEqual(Vector4 const& left, Vector4 const& right) {
+    return left.x == right.x
+        && left.y == right.y
+        && left.z == right.z
+        && left.w == right.w;
+}
+
+/*static*/ XO_INL 
+bool XO_CC Vector4::RoughlyEqual(Vector4 const& left, float magnitude) {
+    return CloseEnough(left.MagnitudeSquared(), Pow<2>(magnitude));
+}
+
+/*static*/ XO_INL
+bool XO_CC Vector4::ExactlyEqual(Vector4 const& left, float magnitude) {
+    return left.MagnitudeSquared() == Pow<2>(magnitude);
+}
+
+/*static*/ XO_INL
+float XO_CC Vector4::DotProduct(Vector4 const& left, Vector4 const& right) {
+    return (left * right).Sum();
+}
+
+/*static*/ XO_INL 
+Vector4 XO_CC Vector4::Lerp(Vector4 const& left, Vector4 const& right, float t) {
+    return left + Vector4(t) * (right - left);
+}
+
+#if defined(XO_MATH_IMPL)
+/*static*/ const Vector4 Vector4::Zero(0.f);
+/*static*/ const Vector4 Vector4::One(1.f);
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////// Matrix4x4
+
+#if defined(XO_MATH_IMPL)
+/*static*/ const Matrix4x4 Matrix4x4::One(1.f);
+/*static*/ const Matrix4x4 Matrix4x4::Zero(0.f);
+/*static*/ const Matrix4x4 Matrix4x4::Identity(
+    Vector4(1.f, 0.f, 0.f, 0.f),
+    Vector4(0.f, 1.f, 0.f, 0.f),
+    Vector4(0.f, 0.f, 1.f, 0.f),
+    Vector4(0.f, 0.f, 0.f, 1.f));
+#endif
+
+XO_INL
+Vector3 XO_CC Matrix4x4::Transform(Vector3 const& v3) const {
+    return Vector3(Vector4::DotProduct(rows[0], Vector4(v3)),
+                   Vector4::DotProduct(rows[1], Vector4(v3)),
+                   Vector4::DotProduct(rows[2], Vector4(v3)));
+}
+
+XO_INL
+Vector4 XO_CC Matrix4x4::Transform(Vector4 const& v4) const {
+    return Vector4(Vector4::DotProduct(rows[0], v4),
+                   Vector4::DotProduct(rows[1], v4),
+                   Vector4::DotProduct(rows[2], v4),
+                   Vector4::DotProduct(rows[3], v4));
+}
+
+XO_INL
+Vector3 XO_CC Matrix4x4::InverseTransform(Vector3 const& v3) const {
+    return Vector3(((rows[0][0]) * v3.x) + ((rows[1][0]) * v3.y) + ((rows[2][0]) * v3.z),
+                   ((rows[0][1]) * v3.x) + ((rows[1][1]) * v3.y) + ((rows[2][1]) * v3.z),
+                   ((rows[0][2]) * v3.x) + ((rows[1][2]) * v3.y) + ((rows[2][2]) * v3.z));
+}
+
+XO_INL
+Vector4 XO_CC Matrix4x4::InverseTransform(Vector4 const& v4) const {
+    return Vector4(((rows[0][0]) * v4.x) + ((rows[1][0]) * v4.y) + ((rows[2][0]) * v4.z) + ((rows[3][0]) * v4.w),
+                   ((rows[0][1]) * v4.x) + ((rows[1][1]) * v4.y) + ((rows[2][1]) * v4.z) + ((rows[3][1]) * v4.w),
+                   ((rows[0][2]) * v4.x) + ((rows[1][2]) * v4.y) + ((rows[2][2]) * v4.z) + ((rows[3][2]) * v4.w),
+                   ((rows[0][3]) * v4.x) + ((rows[1][3]) * v4.y) + ((rows[2][3]) * v4.z) + ((rows[3][3]) * v4.w));
+}
+
+XO_INL 
+Matrix4x4 XO_CC Matrix4x4::operator * (Matrix4x4 const& other) const {
+    return Matrix4x4(*this) *= other;
+}
+
+XO_INL
+Matrix4x4& XO_CC Matrix4x4::operator *= (Matrix4x4 const& other) {
+    Matrix4x4 transposed = Transpose(other);
+    return (*this) = Matrix4x4(
+        Vector4(Vector4::DotProduct(rows[0], transposed[0]),
+                Vector4::DotProduct(rows[0], transposed[1]),
+                Vector4::DotProduct(rows[0], transposed[2]),
+                Vector4::DotProduct(rows[0], transposed[3])),
+
+        Vector4(Vector4::DotProduct(rows[1], transposed[0]),
+                Vector4::DotProduct(rows[1], transposed[1]),
+                Vector4::DotProduct(rows[1], transposed[2]),
+                Vector4::DotProduct(rows[1], transposed[3])),
+
+        Vector4(Vector4::DotProduct(rows[2], transposed[0]),
+                Vector4::DotProduct(rows[2], transposed[1]),
+                Vector4::DotProduct(rows[2], transposed[2]),
+                Vector4::DotProduct(rows[2], transposed[3])),
+
+        Vector4(Vector4::DotProduct(rows[3], transposed[0]),
+                Vector4::DotProduct(rows[3], transposed[1]),
+                Vector4::DotProduct(rows[3], transposed[2]),
+                Vector4::DotProduct(rows[3], transposed[3])));
+}
+
+XO_INL Vector4 Matrix4x4::operator[] (int index) const { return rows[index]; }
+XO_INL Vector4& Matrix4x4::operator[] (int index) { return rows[index]; }
+
+XO_INL
+Vector3 Matrix4x4::Up() const {
+#if defined(XO_CONFIG_Y_UP) && XO_CONFIG_Y_UP
+    return Vector3(rows[1][0], rows[1][1], rows[1][2]);
+#elif defined(XO_CONFIG_Z_UP) && XO_CONFIG_Z_UP
+    return Vector3(rows[2][0], rows[2][1], rows[2][2]);
+#else
+    static_assert(false, "Define XO_CONFIG_Y_UP and XO_CONFIG_Z_UP. One should have a \
+value of 1, the other should have a value of 0.");
+#endif
+}
+
+XO_INL
+Vector3 Matrix4x4::Down() const {
+    return -Up();
+}
+
+XO_INL
+Vector3 Matrix4x4::Left() const {
+    return -Right();
+}
+XO_INL
+Vector3 Matrix4x4::Right() const {
+    return Vector3(rows[0][0], rows[0][1], rows[0][2]);
+}
+
+XO_INL
+Vector3 Matrix4x4::Forward() const {
+#if defined(XO_CONFIG_Y_UP) && XO_CONFIG_Y_UP
+#   if defined(XO_CONFIG_LEFT_HANDED) && XO_CONFIG_LEFT_HANDED
+    return Vector3(rows[2][0], rows[2][1], rows[2][2]);
+#   elif defined(XO_CONFIG_RIGHT_HANDED) && XO_CONFIG_RIGHT_HANDED
+    return Vector3(-rows[2][0], -rows[2][1], -rows[2][2]);
+#   else
+    static_assert(false, "Define XO_CONFIG_LEFT_HANDED and XO_CONFIG_RIGHT_HANDED. One \
+should have a value of 1, the other should have a value of 0.");
+#   endif
+#elif defined(XO_CONFIG_Z_UP) && XO_CONFIG_Z_UP
+#   if defined(XO_CONFIG_LEFT_HANDED) && XO_CONFIG_LEFT_HANDED
+    return Vector3(-rows[1][0], -rows[1][1], -rows[1][2]);
+#   elif defined(XO_CONFIG_RIGHT_HANDED) && XO_CONFIG_RIGHT_HANDED
+    return Vector3(rows[1][0], rows[1][1], rows[1][2]);
+#   else
+    static_assert(false, "Define XO_CONFIG_LEFT_HANDED and XO_CONFIG_RIGHT_HANDED. One \
+should have a value of 1, the other should have a value of 0.");
+#   endif
+#else
+    static_assert(false, "Define XO_CONFIG_Y_UP and XO_CONFIG_Z_UP. One should have a \
+value of 1, the other should have a value of 0.");
+#endif
+}
+
+XO_INL
+Vector3 Matrix4x4::Backward() const {
+    return -Forward();
+}
+
+/*static*/ XO_INL 
+Matrix4x4 XO_CC Matrix4x4::Transpose(Matrix4x4 const& matrixIn) {
+    Matrix4x4 transposed = Matrix4x4(matrixIn);
+    float t;
+#define XO_TRANSPOSE_SWAP(i,j) \
+    t = transposed.rows[i][j];\
+    transposed.rows[i][j] = transposed.rows[j][i]; \
+    transposed.rows[j][i] = t;
+
+    XO_TRANSPOSE_SWAP(0, 1);
+    XO_TRANSPOSE_SWAP(0, 2);
+    XO_TRANSPOSE_SWAP(0, 3);
+    XO_TRANSPOSE_SWAP(1, 2);
+    XO_TRANSPOSE_SWAP(1, 3);
+    XO_TRANSPOSE_SWAP(2, 3);
+#undef XO_TRANSPOSE_SWAP
+    return transposed;
+}
+
+namespace {
+XO_INL
+void XO_CC EarlyInverse(float tmp[12], float src[16], float& det, float m[16]) {
+    // http://download.intel.com/design/PentiumIII/sml/24504301.pdf
+    // transpose matrix
+    for (int i = 0; i < 4; i++) {
+        src[i] = m[i * 4];
+        src[i + 4] = m[i * 4 + 1];
+        src[i + 8] = m[i * 4 + 2];
+        src[i + 12] = m[i * 4 + 3];
+    }
+    // calculate pairs for first 8 elements (cofactors)
+    tmp[0] = src[10] * src[15];
+    tmp[1] = src[11] * src[14];
+    tmp[2] = src[9] * src[15];
+    tmp[3] = src[11] * src[13];
+    tmp[4] = src[9] * src[14];
+    tmp[5] = src[10] * src[13];
+    tmp[6] = src[8] * src[15];
+    tmp[7] = src[11] * src[12];
+    tmp[8] = src[8] * src[14];
+    tmp[9] = src[10] * src[12];
+    tmp[10] = src[8] * src[13];
+    tmp[11] = src[9] * src[12];
+    // calculate first 8 elements (cofactors)
+    m[0] = tmp[0] * src[5] + tmp[3] * src[6] + tmp[4] * src[7];
+    m[0] -= tmp[1] * src[5] + tmp[2] * src[6] + tmp[5] * src[7];
+    m[1] = tmp[1] * src[4] + tmp[6] * src[6] + tmp[9] * src[7];
+    m[1] -= tmp[0] * src[4] + tmp[7] * src[6] + tmp[8] * src[7];
+    m[2] = tmp[2] * src[4] + tmp[7] * src[5] + tmp[10] * src[7];
+    m[2] -= tmp[3] * src[4] + tmp[6] * src[5] + tmp[11] * src[7];
+    m[3] = tmp[5] * src[4] + tmp[8] * src[5] + tmp[11] * src[6];
+    m[3] -= tmp[4] * src[4] + tmp[9] * src[5] + tmp[10] * src[6];
+    m[4] = tmp[1] * src[1] + tmp[2] * src[2] + tmp[5] * src[3];
+    m[4] -= tmp[0] * src[1] + tmp[3] * src[2] + tmp[4] * src[3];
+    m[5] = tmp[0] * src[0] + tmp[7] * src[2] + tmp[8] * src[3];
+    m[5] -= tmp[1] * src[0] + tmp[6] * src[2] + tmp[9] * src[3];
+    m[6] = tmp[3] * src[0] + tmp[6] * src[1] + tmp[11] * src[3];
+    m[6] -= tmp[2] * src[0] + tmp[7] * src[1] + tmp[10] * src[3];
+    m[7] = tmp[4] * src[0] + tmp[9] * src[1] + tmp[10] * src[2];
+    m[7] -= tmp[5] * src[0] + tmp[8] * src[1] + tmp[11] * src[2];
+    // calculate pairs for second 8 elements (cofactors)
+    tmp[0] = src[2] * src[7];
+    tmp[1] = src[3] * src[6];
+    tmp[2] = src[1] * src[7];
+    tmp[3] = src[3] * src[5];
+    tmp[4] = src[1] * src[6];
+    tmp[5] = src[2] * src[5];
+    tmp[6] = src[0] * src[7];
+    tmp[7] = src[3] * src[4];
+    tmp[8] = src[0] * src[6];
+    tmp[9] = src[2] * src[4];
+    tmp[10] = src[0] * src[5];
+    tmp[11] = src[1] * src[4];
+    // calculate second 8 elements (cofactors)
+    m[8] = tmp[0] * src[13] + tmp[3] * src[14] + tmp[4] * src[15];
+    m[8] -= tmp[1] * src[13] + tmp[2] * src[14] + tmp[5] * src[15];
+    m[9] = tmp[1] * src[12] + tmp[6] * src[14] + tmp[9] * src[15];
+    m[9] -= tmp[0] * src[12] + tmp[7] * src[14] + tmp[8] * src[15];
+    m[10] = tmp[2] * src[12] + tmp[7] * src[13] + tmp[10] * src[15];
+    m[10] -= tmp[3] * src[12] + tmp[6] * src[13] + tmp[11] * src[15];
+    m[11] = tmp[5] * src[12] + tmp[8] * src[13] + tmp[11] * src[14];
+    m[11] -= tmp[4] * src[12] + tmp[9] * src[13] + tmp[10] * src[14];
+    m[12] = tmp[2] * src[10] + tmp[5] * src[11] + tmp[1] * src[9];
+    m[12] -= tmp[4] * src[11] + tmp[0] * src[9] + tmp[3] * src[10];
+    m[13] = tmp[8] * src[11] + tmp[0] * src[8] + tmp[7] * src[10];
+    m[13] -= tmp[6] * src[10] + tmp[9] * src[11] + tmp[1] * src[8];
+    m[14] = tmp[6] * src[9] + tmp[11] * src[11] + tmp[3] * src[8];
+    m[14] -= tmp[10] * src[11] + tmp[2] * src[8] + tmp[7] * src[9];
+    m[15] = tmp[10] * src[10] + tmp[4] * src[8] + tmp[9] * src[9];
+    m[15] -= tmp[8] * src[9] + tmp[11] * src[10] + tmp[5] * src[8];
+    // calculate determinant
+    det = src[0] * m[0] + src[1] * m[1] + src[2] * m[2] + src[3] * m[3];
+}
+
+XO_INL
+void XO_CC LateInverse(float &det, float m[16]) {
+    // http://download.intel.com/design/PentiumIII/sml/24504301.pdf
+    // calculate matrix inverse 
+    det = 1.0f / det;
+    for (int j = 0; j < 16; j++) {
+        m[j] *= det;
+    }
+}
+}
+
+/*static*/ XO_INL 
+Matrix4x4 XO_CC Matrix4x4::Invert(Matrix4x4 const& matrixIn) {
+    float tmp[12]; // temp array for pairs
+    float src[16]; // array of transpose source matrix
+    float det; // determinant
+    Matrix4x4 inverted(matrixIn);
+    EarlyInverse(tmp, src, det, inverted.v);
+    LateInverse(det, inverted.v);
+    return inverted;
+}
+
+/*static*/ XO_INL
+bool XO_CC Matrix4x4::InvertSafe(Matrix4x4 const& matrixIn, Matrix4x4& matrixOut) {
+    float tmp[12]; // temp array for pairs
+    float src[16]; // array of transpose source matrix
+    float det; // determinant
+    Matrix4x4 inverted(matrixIn);
+    EarlyInverse(tmp, src, det, inverted.v);
+    if (CloseEnough(det, 0.f))
+        return false;
+    LateInverse(det, inverted.v);
+    matrixOut = inverted;
+    return true;
+}
+
+/*static*/ XO_INL
+Matrix4x4 XO_CC Matrix4x4::InvertAffine(Matrix4x4 const& matrixIn) {
+    // The columns of the 3x3 inverse are c0 = a1 x a2, c1 = a2 x a0 and c2 = a0 x a1 over
+    // the determinant a0 . c0.
+    Vector3 a0(matrixIn.v[0], matrixIn.v[1], matrixIn.v[2]);
+    Vector3 a1(matrixIn.v[4], matrixIn.v[5], matrixIn.v[6]);
+    Vector3 a2(matrixIn.v[8], matrixIn.v[9], matrixIn.v[10]);
+    Vector3 c0 = Vector3::CrossProduct(a1, a2);
+    Vector3 c1 = Vector3::CrossProduct(a2, a0);
+    Vector3 c2 = Vector3::CrossProduct(a0, a1);
+    float invDet = 1.f / Vector3::DotProduct(a0, c0);
+    Vector3 b0 = Vector3(c0.x, c1.x, c2.x) * invDet;
+    Vector3 b1 = Vector3(c0.y, c1.y, c2.y) * invDet;
+    Vector3 b2 = Vector3(c0.z, c1.z, c2.z) * invDet;
+    Vector3 d = -(b0 * matrixIn.v[12] + b1 * matrixIn.v[13] + b2 * matrixIn.v[14]);
+    return Matrix4x4(
+        Vector4(b0.x, b0.y, b0.z, 0.f),
+        Vector4(b1.x, b1.y, b1.z, 0.f),
+        Vector4(b2.x, b2.y, b2.z, 0.f),
+        Vector4(d.x,  d.y,  d.z,  1.f));
+}
+
+/*static*/ XO_INL
+Matrix4x4 XO_CC Matrix4x4::InvertOrthonormal(Matrix4x4 const& matrixIn) {
+    float const* m = matrixIn.v;
+    Vector3 b0(m[0], m[4], m[8]);
+    Vector3 b1(m[1], m[5], m[9]);
+    Vector3 b2(m[2], m[6], m[10]);
+    Vector3 d = -(b0 * m[12] + b1 * m[13] + b2 * m[14]);
+    return Matrix4x4(
+        Vector4(b0.x, b0.y, b0.z, 0.f),
+        Vector4(b1.x, b1.y, b1.z, 0.f),
+        Vector4(b2.x, b2.y, b2.z, 0.f),
+        Vector4(d.x,  d.y,  d.z,  1.f));
+}
+
+/*static*/ XO_INL
+bool XO_CC Matrix4x4::IsAffine(Matrix4x4 const& matrixIn) {
+    return CloseEnough(matrixIn.v[3], 0.f) && CloseEnough(matrixIn.v[7], 0.f)
+        && CloseEnough(matrixIn.v[11], 0.f) && CloseEnough(matrixIn.v[15], 1.f);
+}
+
+/*static*/ XO_INL
+bool XO_CC Matrix4x4::IsOrthonormal(Matrix4x4 const& matrixIn) {
+    Vector3 a0(matrixIn.v[0], matrixIn.v[1], matrixIn.v[2]);
+    Vector3 a1(matrixIn.v[4], matrixIn.v[5], matrixIn.v[6]);
+    Vector3 a2(matrixIn.v[8], matrixIn.v[9], matrixIn.v[10]);
+    float const tolerance = 1e-5f;
+    return IsAffine(matrixIn)
+        && Abs(a0.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(a1.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(a2.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(Vector3::DotProduct(a0, a1)) <= tolerance
+        && Abs(Vector3::DotProduct(a1, a2)) <= tolerance
+        && Abs(Vector3::DotProduct(a2, a0)) <= tolerance;
+}
+
+/*static*/ XO_INL 
+Matrix4x4 XO_CC Matrix4x4::Translation(Vector3 const& pos) {
+    return Matrix4x4(
+        Vector4(1.f,   0.f,   0.f,   0.f),
+        Vector4(0.f,   1.f,   0.f,   0.f),
+        Vector4(0.f,   0.f,   1.f,   0.f),
+        Vector4(pos.x, pos.y, pos.z, 1.f));
+}
+
+/*static*/ XO_INL 
+Matrix4x4 XO_CC Matrix4x4::Scale(Vector3 const& scale) {
+    return Matrix4x4(
+        Vector4(scale.x, 0.f,     0.f,     0.f),
+        Vector4(0.f,     scale.y, 0.f,     0.f),
+        Vector4(0.f,     0.f,     scale.z, 0.f),
+        Vector4(0.f,     0.f,     0.f,     1.f));
+}
+
+/*static*/ XO_INL 
+Matrix4x4 XO_CC Matrix4x4::RotationYaw(float yaw) {
+    float s, c;
+    SinCos(yaw, s, c);
+    return Matrix4x4(
+        Vector4(c,   0.f, -s,  0.f),
+        Vector4(0.f, 1.f, 0.f, 0.f),
+        Vector4(s,   0.f, c,   0.f),
+        Vector4(0.f, 0.f, 0.f, 1.f));
+}
+
+/*static*/ XO_INL
+Matrix4x4 XO_CC Matrix4x4::RotationPitch(float pitch) {
+    float s, c;
+    SinCos(pitch, s, c);
+    return Matrix4x4(
+        Vector4(1.f, 0.f, 0.f, 0.f),
+        Vector4(0.f, c,   -s,  0.f),
+        Vector4(0.f, s,   c,   0.f),
+        Vector4(0.f, 0.f, 0.f, 1.f));
+}
+
+/*static*/ XO_INL 
+Matrix4x4 XO_CC Matrix4x4::RotationRoll(float roll) {
+    float s, c;
+    SinCos(roll, s, c);
+    return Matrix4x4(
+        Vector4(c,   -s,  0.f, 0.f),
+        Vector4(s,   c,   0.f, 0.f),
+        Vector4(0.f, 0.f, 1.f, 0.f),
+        Vector4(0.f, 0.f, 0.f, 1.f));
+}
+
+/*static*/ XO_INL 
+Matrix4x4 XO_CC Matrix4x4::RotationYawPitchRoll(float yaw, float pitch, float roll) {
+    return RotationYaw(yaw) * RotationPitch(pitch) * RotationRoll(roll);
+}
+
+/*static*/ XO_INL
+Matrix4x4 XO_CC Matrix4x4::RotationAxisAngle(Vector3 const& axis, float angle) {
+    float s, c;
+    SinCos(angle, s, c);
+    float t = 1.f - c;
+    Vector3 a = axis.Normalized();
+    Matrix4x4 rotation(Matrix4x4::Identity);
+
+    rotation[0][0] = c + a.x*a.x*t;
+    rotation[1][1] = c + a.y*a.y*t;
+    rotation[2][2] = c + a.z*a.z*t;
+
+
+    float tmp1 = a.x*a.y*t;
+    float tmp2 = a.z*s;
+    rotation[1][0] = tmp1 + tmp2;
+    rotation[0][1] = tmp1 - tmp2;
+    
+    tmp1 = a.x*a.z*t;
+    tmp2 = a.y*s;
+    rotation[2][0] = tmp1 - tmp2;
+    rotation[0][2] = tmp1 + tmp2;    tmp1 = a.y*a.z*t;
+
+    tmp2 = a.x*s;
+    rotation[2][1] = tmp1 + tmp2;
+    rotation[1][2] = tmp1 - tmp2;
+
+    return rotation;
+}
+
+/*static*/ XO_INL 
+Matrix4x4 XO_CC Matrix4x4::PerspectiveFOV(float fov, 
+                                          float aspect, 
+                                          float nearPlane, 
+                                          float farPlane) {
+    float s, c;
+    SinCos(fov*0.5f, s, c);
+    float h = c / s;                             // height
+    float w = h / aspect;                        // width
+    float r = farPlane / (nearPlane - farPlane); // range
+    float rn = r * nearPlane;                    // range*near
+    return Matrix4x4(
+        Vector4(w,   0.f, 0.f, 0.f),
+        Vector4(0.f, h,   0.f, 0.f),
+        Vector4(0.f, 0.f, r,  -1.f),
+        Vector4(0.f, 0.f, rn,  0.f));
+}
+
+/*static*/ XO_INL 
+Matrix4x4 XO_CC Matrix4x4::Perspective(float width,
+                                       float height, 
+                                       float aspect, 
+                                       float nearPlane, 
+                                       float farPlane) {
+    XO_UNUSED(aspect);   // width / height already give it
+    float n2 = Pow<2>(nearPlane);
+    float r = farPlane / (nearPlane - farPlane);
+    float w = n2 / width;
+    float h = n2 / height;
+    float rn = r * nearPlane;
+    return Matrix4x4(
+        Vector4(w,   0.f, 0.f, 0.f),
+        Vector4(0.f, h,   0.f, 0.f),
+        Vector4(0.f, 0.f, r,  -1.f),
+        Vector4(0.f, 0.f, rn,  0.f));
+}
+
+/*static*/ XO_INL
+Matrix4x4 XO_CC Matrix4x4::Orthographic(float width,
+                                        float height,
+                                        float nearPlane,
+                                        float farPlane) {
+    float r = 1.f / (nearPlane - farPlane);
+    float w = 2.f / width;
+    float h = 2.f / height;
+    float rn = r * nearPlane;
+    return Matrix4x4(
+        Vector4(w, 0.f, 0.f, 0.f),
+        Vector4(0.f, h, 0.f, 0.f),
+        Vector4(0.f, 0.f, r, 0.f),
+        Vector4(0.f, 0.f, rn, 0.f));
+}
+
+/*static*/ XO_INL
+Matrix4x4 XO_CC Matrix4x4::LookAt(Vector3 const& from,
+                                  Vector3 const& to, 
+                                  Vector3 const& up) {
+    Vector3 dir = from - to;
+    Vector3 r2 = dir.Normalized();
+    Vector3 r0 = Vector3::CrossProduct(up, r2).Normalized();
+    Vector3 r1 = Vector3::CrossProduct(r2, r0);
+
+    float d0 = -Vector3::DotProduct(r0, from);
+    float d1 = -Vector3::DotProduct(r1, from);
+    float d2 = -Vector3::DotProduct(r2, from);
+    return Matrix4x4(
+        Vector4(r0.x, r1.x, r2.x, 0.f),
+        Vector4(r0.y, r1.y, r2.y, 0.f),
+        Vector4(r0.z, r1.z, r2.z, 0.f),
+        Vector4(d0,   d1,   d2,   1.f));
+}
+
+/*static*/ XO_INL 
+bool XO_CC Matrix4x4::RoughlyEqual(Matrix4x4 const& left, Matrix4x4 const& right) {
+    return Vector4::RoughlyEqual(left[0], right[0])
+        && Vector4::RoughlyEqual(left[1], right[1])
+        && Vector4::RoughlyEqual(left[2], right[2])
+        && Vector4::RoughlyEqual(left[3], right[3]);
+}
+
+/*static*/ XO_INL 
+bool XO_CC Matrix4x4::ExactlyEqual(Matrix4x4 const& left, Matrix4x4 const& right) {
+    return Vector4::ExactlyEqual(left[0], right[0])
+        && Vector4::ExactlyEqual(left[1], right[1])
+        && Vector4::ExactlyEqual(left[2], right[2])
+        && Vector4::ExactlyEqual(left[3], right[3]);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////// Quaternion
+#if defined(XO_MATH_IMPL)
+/*static*/ const Quaternion Quaternion::Zero(0.f);
+/*static*/ const Quaternion Quaternion::Identity(0.f, 0.f, 0.f, 1.f);
+#endif
+
+XO_INL
+Quaternion Quaternion::operator + (Quaternion other) const {
+    return Quaternion(i + other.i, j + other.j, k + other.k, r + other.r);
+}
+
+XO_INL
+Quaternion Quaternion::operator *(float s) const { 
+    return Quaternion(i*s, j*s, k*s, r*s); 
+}
+
+XO_INL
+Quaternion Quaternion::operator -() const {
+    return Quaternion(-i, -j, -k, -r);
+}
+
+XO_INL
+Quaternion XO_CC Quaternion::operator * (Quaternion const& other) const {
+    return Quaternion(r * other.i + i * other.r + j * other.k - k * other.j,
+                      r * other.j - i * other.k + j * other.r + k * other.i,
+                      r * other.k + i * other.j - j * other.i + k * other.r,
+                      r * other.r - i * other.i - j * other.j - k * other.k);
+}
+
+XO_INL
+Quaternion& XO_CC Quaternion::operator *= (Quaternion const& other) {
+    return *this = *this * other;
+}
+
+XO_INL
+Vector3 XO_CC Quaternion::Rotate(Vector3 const& v) const {
+    Vector3 q(i, j, k);
+    Vector3 t = Vector3::CrossProduct(q, v) * 2.f;
+    return v + t * r + Vector3::CrossProduct(q, t);
+}
+
+XO_INL
+float Quaternion::Magnitude() const {
+    return vec4.Magnitude();
+}
+
+XO_INL 
+float Quaternion::MagnitudeSquared() const {
+    return vec4.MagnitudeSquared();
+};
+
+XO_INL
+Quaternion Quaternion::Normalized(Precision precision) const {
+    return Quaternion(vec4.Normalized(precision));
+};
+
+XO_INL
+Quaternion& Quaternion::Normalize(Precision precision) {
+    vec4.Normalize(precision); return *this;
+};
+
+XO_INL
+Matrix4x4 Quaternion::ToMatrix() const {
+    // See: https://www.flipcode.com/documents/matrfaq.html#Q54
+    float ii = i * i;
+    float ij = i * j;
+    float ik = i * k;
+    float ir = i * r;
+    float jj = j * j;
+    float jk = j * k;
+    float jr = j * r;
+    float kk = k * k;
+    float kr = k * r;
+    return Matrix4x4(
+        Vector4(1.f - 2.f * (jj + kk), 2.f * (ij - kr), 2.f * (ik + jr), 0.f),
+        Vector4(2.f * (ij + kr), 1.f - 2.f * (ii + kk), 2.f * (jk - ir), 0.f),
+        Vector4(2.f * (ik - jr), 2.f * (jk + ir), 1.f - 2.f * (ii + jj), 0.f),
+        Vector4(0.f, 0.f, 0.f, 1.f));
+}
+
+/*static*/ XO_INL
+Quaternion XO_CC Quaternion::Invert(Quaternion const& quat) {
+    return Quaternion(-quat.i, -quat.j, -quat.k, quat.r);
+}
+
+/*static*/ XO_INL
+Quaternion XO_CC Quaternion::RotationAxisAngle(Vector3 const& axis, float angle) {
+    float s, c;
+    SinCos(angle*0.5f, s, c);
+    return Quaternion(axis.x*s, axis.y*s, axis.z*s, c);
+}
+
+/*static*/ XO_INL
+Quaternion XO_CC Quaternion::RotationEuler(Vector3 const& angles) {
+    float sr, cp, sp, cy, sy, cr;
+    SinCos(angles.x * 0.5f, sy, cy);
+    SinCos(angles.y * 0.5f, sp, cp);
+    SinCos(angles.z * 0.5f, sr, cr);
+    return Quaternion(cy * cr * cp + sy * sr * sp,
+                      cy * sr * cp - sy * cr * sp,
+                      cy * cr * sp + sy * sr * cp,
+                      sy * cr * cp - cy * sr * sp);
+}
+
+/*static*/ XO_INL
+float XO_CC Quaternion::DotProduct(Quaternion const& left, Quaternion const& right) {
+    return Vector4::DotProduct(left.vec4, right.vec4);
+}
+
+/*static*/ XO_INL
+Quaternion XO_CC Quaternion::Lerp(Quaternion const& start,
+                                  Quaternion const& end,
+                                  float t) {
+    return Quaternion(Vector4::Lerp(start.vec4, end.vec4, t));
+}
+
+/*static*/ XO_INL
+Quaternion XO_CC Quaternion::Slerp(Quaternion const& start, 
+                                   Quaternion const& end, 
+                                   float t) {
+    Quaternion s = start.Normalized();
+    Quaternion e = end.Normalized();
+    float d = Quaternion::DotProduct(s, e);
+    if (d < 0.f) {
+        e = -e;
+        d = -d;
+    }
+
+    if (CloseEnough(d, 1.f)) {
+        return Lerp(s, e, t).Normalize();
+    }
+
+    float th0 = ACos(d);
+    float th = th0 * t;
+
+    float st, ct, sth0;
+    SinCos(th, st, ct);
+    sth0 = Sin(th0);
+    float s0 = ct - d * st / sth0;
+    float s1 = st / sth0;
+    return (s * s0) + (e * s1);
+}
+
+/*static*/ XO_INL 
+bool XO_CC Quaternion::RoughlyEqual(Quaternion const& left, Quaternion const& right) {
+    return CloseEnough(left.i, right.i)
+        && CloseEnough(left.j, right.j)
+        && CloseEnough(left.k, right.k)
+        && CloseEnough(left.r, right.r);
+}
+
+/*static*/ XO_INL 
+bool XO_CC Quaternion::ExactlyEqual(Quaternion const& left, Quaternion const& right) {
+    return left.i == right.i
+        && left.j == right.j
+        && left.k == right.k
+        && left.r == right.r;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////// AVector 3
+#if defined(XO_MATH_IMPL)
+/*static*/ const AVector3 AVector3::Zero(0.f);
+/*static*/ const AVector3 AVector3::One(1.f);
+/*static*/ const AVector3 AVector3::Left(-1.f, 0.f, 0.f);
+/*static*/ const AVector3 AVector3::Right(1.f, 0.f, 0.f);
+
+#   if !defined(XO_CONFIG_Y_UP) || !defined(XO_CONFIG_Z_UP)
+    static_assert(false, 
+        "define both XO_CONFIG_Y_UP and XO_CONFIG_Z_UP. One should have a value of 1, and\
+ the other should have a value of 0");
+#   endif
+
+#   if !defined(XO_CONFIG_LEFT_HANDED) || !defined(XO_CONFIG_RIGHT_HANDED)
+    static_assert(false, 
+        "define both XO_CONFIG_LEFT_HANDED and XO_CONFIG_RIGHT_HANDED. One should have a \
+value of 1, and the other should have a value of 0");
+#   endif
+
+#   if XO_CONFIG_Y_UP
+    static_assert(XO_CONFIG_Z_UP == 0, 
+        "XO_CONFIG_Z_UP should be 0 if XO_CONFIG_Y_UP is 1");
+/*static*/ const AVector3 AVector3::Up(0.f, 1.f, 0.f);
+/*static*/ const AVector3 AVector3::Down(0.f, -1.f, 0.f);
+#       if XO_CONFIG_LEFT_HANDED
+        static_assert(XO_CONFIG_RIGHT_HANDED == 0, 
+            "XO_CONFIG_RIGHT_HANDED should be 0 if XO_CONFIG_LEFT_HANDED is 1");
+/*static*/ const AVector3 AVector3::Forward(0.f, 0.f, 1.f);
+/*static*/ const AVector3 AVector3::Backward(0.f, 0.f, -1.f);
+#       elif XO_CONFIG_RIGHT_HANDED
+        static_assert(XO_CONFIG_LEFT_HANDED == 0, 
+            "XO_CONFIG_LEFT_HANDED should be 0 if XO_CONFIG_RIGHT_HANDED is 1");
+/*static*/ const AVector3 AVector3::Forward(0.f, 0.f, -1.f);
+/*static*/ const AVector3 AVector3::Backward(0.f, 0.f, 1.f);
+#       else
+        static_assert(false, 
+            "XO_CONFIG_LEFT_HANDED or XO_CONFIG_RIGHT_HANDED should have a non zero \
+value...");
+#       endif
+#   elif XO_CONFIG_Z_UP
+// no static assert here about XO_CONFIG_Y_UP, because it's been checked.
+/*static*/ const AVector3 AVector3::Up(0.f, 0.f, 1.f);
+/*static*/ const AVector3 AVector3::Down(0.f, 0.f, -1.f);
+#       if XO_CONFIG_LEFT_HANDED
+        static_assert(XO_CONFIG_RIGHT_HANDED == 0, 
+            "XO_CONFIG_RIGHT_HANDED should be 0 if XO_CONFIG_LEFT_HANDED is 1");
+/*static*/ const AVector3 AVector3::Forward(0.f, -1.f, 0.f);
+/*static*/ const AVector3 AVector3::Backward(0.f, 1.f, 0.f);
+#       elif XO_CONFIG_RIGHT_HANDED
+        static_assert(XO_CONFIG_LEFT_HANDED == 0, 
+            "XO_CONFIG_LEFT_HANDED should be 0 if XO_CONFIG_RIGHT_HANDED is 1");
+/*static*/ const AVector3 AVector3::Forward(0.f, 1.f, 0.f);
+/*static*/ const AVector3 AVector3::Backward(0.f, -1.f, 0.f);
+#       else
+        static_assert(false,
+            "XO_CONFIG_LEFT_HANDED or XO_CONFIG_RIGHT_HANDED should have a non zero \
+value...");
+#       endif
+#   else
+    static_assert(false,
+        "XO_CONFIG_Y_UP or XO_CONFIG_Z_UP should have a non zero value...");
+#   endif
+#endif
+
+XO_INL 
+AVector3 XO_CC AVector3::operator + (AVector3 const& other) const { 
+    return AVector3(x + other.x, y + other.y, z + other.z);
+}
+
+XO_INL
+AVector3 XO_CC AVector3::operator - (AVector3 const& other) const {
+    return AVector3(x - other.x, y - other.y, z - other.z);
+}
+
+XO_INL
+AVector3 XO_CC AVector3::operator * (AVector3 const& other) const {
+    return AVector3(x * other.x, y * other.y, z * other.z);
+}
+
+XO_INL
+AVector3 XO_CC AVector3::operator / (AVector3 const& other) const {
+    return AVector3(x / other.x, y / other.y, z / other.z);
+}
+
+XO_INL
+AVector3& XO_CC AVector3::operator += (AVector3 const& other) {
+    x += other.x;
+    y += other.y;
+    z += other.z;
+    return *this;
+}
+
+XO_INL
+AVector3& XO_CC AVector3::operator -= (AVector3 const& other) {
+    x -= other.x;
+    y -= other.y;
+    z -= other.z;
+    return *this;
+}
+
+XO_INL
+AVector3& XO_CC AVector3::operator *= (AVector3 const& other) {
+    x *= other.x;
+    y *= other.y;
+    z *= other.z;
+    return *this;
+}
+
+XO_INL
+AVector3& XO_CC AVector3::operator /= (AVector3 const& other) {
+    x /= other.x;
+    y /= other.y;
+    z /= other.z;
+    return *this;
+}
+
+XO_INL AVector3 AVector3::operator -() const { return AVector3(-x, -y, -z); };
+
+XO_INL float AVector3::Sum() const { return x + y + z; }
+
+XO_INL float AVector3::MagnitudeSquared() const { return ((*this) * (*this)).Sum(); }
+XO_INL float AVector3::Magnitude() const { return xo::Sqrt(MagnitudeSquared()); }
+
+XO_INL AVector3& AVector3::Normalize(Precision precision) {
+    if (precision == Precision::Exact) {
+        return (*this) /= AVector3(Magnitude());
+    }
+    return (*this) *= AVector3(InverseSqrt(MagnitudeSquared(), precision));
+}
+XO_INL AVector3 AVector3::Normalized(Precision precision) const { return AVector3(*this).Normalize(precision); }
+
+/*static*/ XO_INL
+bool XO_CC AVector3::RoughlyEqual(AVector3 const& left, AVector3 const& right) {
+    return CloseEnough(left.x, right.x)
+        && CloseEnough(left.y, right.y)
+        && CloseEnough(left.z, right.z);
+}
+
+/*static*/ XO_INL
+bool XO_CC AVector3::ExactlyEqual(AVector3 const& left, AVector3 const& right) {
+    return left.x == right.x
+        && left.y == right.y
+        && left.z == right.z;
+}
+/*static*/ XO_INL
+bool XO_CC AVector3::RoughlyEqual(AVector3 const& left, float magnitude) {
+    return CloseEnough(left.MagnitudeSquared(), Pow<2>(magnitude));
+}
+
+/*static*/ XO_INL
+bool XO_CC AVector3::ExactlyEqual(AVector3 const& left, float magnitude) {
+    return left.MagnitudeSquared() == Pow<2>(magnitude);
+}
+
+/*static*/ XO_INL
+float XO_CC AVector3::DotProduct(AVector3 const& left, AVector3 const& right) {
+    return (left * right).Sum();
+}
+
+/*static*/ XO_INL
+AVector3 XO_CC AVector3::CrossProduct(AVector3 const& left, AVector3 const& right) {
+    return AVector3(
+        left.y * right.z - left.z * right.y,
+        left.z * right.x - left.x * right.z,
+        left.x * right.y - left.y * right.x);
+}
+
+/*static*/ XO_INL
+AVector3 XO_CC AVector3::Lerp(AVector3 const& left, AVector3 const& right, float t) {
+    return left + AVector3(t) * (right - left);
+}
+
+/*static*/ XO_INL
+float XO_CC AVector3::DistanceSquared(AVector3 const& left, AVector3 const& right) {
+    return (right - left).MagnitudeSquared();
+}
+
+/*static*/ XO_INL
+float XO_CC AVector3::Distance(AVector3 const& left, AVector3 const& right) {
+    return (right - left).Magnitude();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////// AVector 4
+
+XO_INL
+AVector4 XO_CC AVector4::operator + (AVector4 const& other) const {
+    return AVector4(x + other.x, y + other.y, z + other.z, w + other.w);
+}
+
+XO_INL
+AVector4 XO_CC AVector4::operator - (AVector4 const& other) const {
+    return AVector4(x - other.x, y - other.y, z - other.z, w - other.w);
+}
+
+XO_INL
+AVector4 XO_CC AVector4::operator * (AVector4 const& other) const {
+    return AVector4(x*other.x, y*other.y, z*other.z, w*other.w);
+}
+
+XO_INL
+AVector4 XO_CC AVector4::operator / (AVector4 const& other) const {
+    return AVector4(x / other.x, y / other.y, z / other.z, w / other.w);
+}
+
+XO_INL 
+AVector4& XO_CC AVector4::operator += (AVector4 const& other) {
+    x += other.x; 
+    y += other.y; 
+    z += other.z; 
+    w += other.w; 
+    return *this;
+};
+
+XO_INL 
+AVector4& XO_CC AVector4::operator -= (AVector4 const& other) {
+    x -=other.x;
+    y -=other.y;
+    z -= other.z;
+    w -= other.w;
+    return *this; };
+
+XO_INL 
+AVector4& XO_CC AVector4::operator *= (AVector4 const& other) {
+    x *= other.x;
+    y *= other.y;
+    z *= other.z;
+    w *= other.w;
+    return *this;
+};
+
+XO_INL 
+AVector4& XO_CC AVector4::operator /= (AVector4 const& other) {
+    x /= other.x;
+    y /= other.y;
+    z /= other.z;
+    w /= other.w;
+    return *this;
+};
+
+XO_INL AVector4 AVector4::operator -() const { return AVector4(-x, -y, -z, -w); }
+
+XO_INL float AVector4::operator[] (int index) const { return v[index]; }
+XO_INL float& AVector4::operator[] (int index) { return v[index]; }
+
+XO_INL float AVector4::Sum() const { return x + y + z + w; }
+
+XO_INL float AVector4::MagnitudeSquared() const { return x * x + y * y + z * z + w * w; }
+XO_INL float AVector4::Magnitude() const { return Sqrt(MagnitudeSquared()); }
+XO_INL AVector4 AVector4::Normalized(Precision precision) const { return AVector4(*this).Normalize(precision); }
+XO_INL AVector4& AVector4::Normalize(Precision precision) {
+    if (precision == Precision::Exact) {
+        return (*this) /= AVector4(Magnitude());
+    }
+    return (*this) *= AVector4(InverseSqrt(MagnitudeSquared(), precision));
+}
+
+/*static*/ XO_INL 
+bool XO_CC AVector4::RoughlyEqual(AVector4 const& left, AVector4 const& right) {
+    return CloseEnough(left.x, right.x)
+        && CloseEnough(left.y, right.y)
+        && CloseEnough(left.z, right.z)
+        && CloseEnough(left.w, right.w);
+}
+
+/*static*/ XO_INL 
+bool XO_CC AVector4::ExactlyEqual(AVector4 const& left, AVector4 const& right) {
+    return left.x == right.x
+        && left.y == right.y
+        && left.z == right.z
+        && left.w == right.w;
+}
+
+/*static*/ XO_INL 
+bool XO_CC AVector4::RoughlyEqual(AVector4 const& left, float magnitude) {
+    return CloseEnough(left.MagnitudeSquared(), Pow<2>(magnitude));
+}
+
+/*static*/ XO_INL
+bool XO_CC AVector4::ExactlyEqual(AVector4 const& left, float magnitude) {
+    return left.MagnitudeSquared() == Pow<2>(magnitude);
+}
+
+/*static*/ XO_INL
+float XO_CC AVector4::DotProduct(AVector4 const& left, AVector4 const& right) {
+    return (left * right).Sum();
+}
+
+/*static*/ XO_INL 
+AVector4 XO_CC AVector4::Lerp(AVector4 const& left, AVector4 const& right, float t) {
+    return left + AVector4(t) * (right - left);
+}
+
+#if defined(XO_MATH_IMPL)
+/*static*/ const AVector4 AVector4::Zero(0.f);
+/*static*/ const AVector4 AVector4::One(1.f);
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////// AMatrix4x4
+
+#if defined(XO_MATH_IMPL)
+/*static*/ const AMatrix4x4 AMatrix4x4::One(1.f);
+/*static*/ const AMatrix4x4 AMatrix4x4::Zero(0.f);
+/*static*/ const AMatrix4x4 AMatrix4x4::Identity(
+    AVector4(1.f, 0.f, 0.f, 0.f),
+    AVector4(0.f, 1.f, 0.f, 0.f),
+    AVector4(0.f, 0.f, 1.f, 0.f),
+    AVector4(0.f, 0.f, 0.f, 1.f));
+#endif
+
+XO_INL
+AVector3 XO_CC AMatrix4x4::Transform(AVector3 const& v3) const {
+    return AVector3(AVector4::DotProduct(rows[0], AVector4(v3)),
+                    AVector4::DotProduct(rows[1], AVector4(v3)),
+                    AVector4::DotProduct(rows[2], AVector4(v3)));
+}
+
+XO_INL
+AVector4 XO_CC AMatrix4x4::Transform(AVector4 const& v4) const {
+    return AVector4(AVector4::DotProduct(rows[0], v4),
+                    AVector4::DotProduct(rows[1], v4),
+                    AVector4::DotProduct(rows[2], v4),
+                    AVector4::DotProduct(rows[3], v4));
+}
+
+XO_INL
+AVector3 XO_CC AMatrix4x4::InverseTransform(AVector3 const& v3) const {
+    return AVector3(((rows[0][0]) * v3.x) + ((rows[1][0]) * v3.y) + ((rows[2][0]) * v3.z),
+                    ((rows[0][1]) * v3.x) + ((rows[1][1]) * v3.y) + ((rows[2][1]) * v3.z),
+                    ((rows[0][2]) * v3.x) + ((rows[1][2]) * v3.y) + ((rows[2][2]) * v3.z));
+}
+
+XO_INL
+AVector4 XO_CC AMatrix4x4::InverseTransform(AVector4 const& v4) const {
+    return AVector4(((rows[0][0]) * v4.x) + ((rows[1][0]) * v4.y) + ((rows[2][0]) * v4.z) + ((rows[3][0]) * v4.w),
+                    ((rows[0][1]) * v4.x) + ((rows[1][1]) * v4.y) + ((rows[2][1]) * v4.z) + ((rows[3][1]) * v4.w),
+                    ((rows[0][2]) * v4.x) + ((rows[1][2]) * v4.y) + ((rows[2][2]) * v4.z) + ((rows[3][2]) * v4.w),
+                    ((rows[0][3]) * v4.x) + ((rows[1][3]) * v4.y) + ((rows[2][3]) * v4.z) + ((rows[3][3]) * v4.w));
+}
+
+XO_INL 
+AMatrix4x4 XO_CC AMatrix4x4::operator * (AMatrix4x4 const& other) const {
+    return AMatrix4x4(*this) *= other;
+}
+
+XO_INL
+AMatrix4x4& XO_CC AMatrix4x4::operator *= (AMatrix4x4 const& other) {
+    AMatrix4x4 transposed = Transpose(other);
+    return (*this) = AMatrix4x4(
+        AVector4(AVector4::DotProduct(rows[0], transposed[0]),
+                 AVector4::DotProduct(rows[0], transposed[1]),
+                 AVector4::DotProduct(rows[0], transposed[2]),
+                 AVector4::DotProduct(rows[0], transposed[3])),
+
+        AVector4(AVector4::DotProduct(rows[1], transposed[0]),
+                 AVector4::DotProduct(rows[1], transposed[1]),
+                 AVector4::DotProduct(rows[1], transposed[2]),
+                 AVector4::DotProduct(rows[1], transposed[3])),
+
+        AVector4(AVector4::DotProduct(rows[2], transposed[0]),
+                 AVector4::DotProduct(rows[2], transposed[1]),
+                 AVector4::DotProduct(rows[2], transposed[2]),
+                 AVector4::DotProduct(rows[2], transposed[3])),
+
+        AVector4(AVector4::DotProduct(rows[3], transposed[0]),
+                 AVector4::DotProduct(rows[3], transposed[1]),
+                 AVector4::DotProduct(rows[3], transposed[2]),
+                 AVector4::DotProduct(rows[3], transposed[3])));
+}
+
+XO_INL AVector4 AMatrix4x4::operator[] (int index) const { return rows[index]; }
+XO_INL AVector4& AMatrix4x4::operator[] (int index) { return rows[index]; }
+
+XO_INL
+AVector3 AMatrix4x4::Up() const {
+#if defined(XO_CONFIG_Y_UP) && XO_CONFIG_Y_UP
+    return AVector3(rows[1][0], rows[1][1], rows[1][2]);
+#elif defined(XO_CONFIG_Z_UP) && XO_CONFIG_Z_UP
+    return AVector3(rows[2][0], rows[2][1], rows[2][2]);
+#else
+    static_assert(false, "Define XO_CONFIG_Y_UP and XO_CONFIG_Z_UP. One should have a \
+value of 1, the other should have a value of 0.");
+#endif
+}
+
+XO_INL
+AVector3 AMatrix4x4::Down() const {
+    return -Up();
+}
+
+XO_INL
+AVector3 AMatrix4x4::Left() const {
+    return -Right();
+}
+XO_INL
+AVector3 AMatrix4x4::Right() const {
+    return AVector3(rows[0][0], rows[0][1], rows[0][2]);
+}
+
+XO_INL
+AVector3 AMatrix4x4::Forward() const {
+#if defined(XO_CONFIG_Y_UP) && XO_CONFIG_Y_UP
+#   if defined(XO_CONFIG_LEFT_HANDED) && XO_CONFIG_LEFT_HANDED
+    return AVector3(rows[2][0], rows[2][1], rows[2][2]);
+#   elif defined(XO_CONFIG_RIGHT_HANDED) && XO_CONFIG_RIGHT_HANDED
+    return AVector3(-rows[2][0], -rows[2][1], -rows[2][2]);
+#   else
+    static_assert(false, "Define XO_CONFIG_LEFT_HANDED and XO_CONFIG_RIGHT_HANDED. One \
+should have a value of 1, the other should have a value of 0.");
+#   endif
+#elif defined(XO_CONFIG_Z_UP) && XO_CONFIG_Z_UP
+#   if defined(XO_CONFIG_LEFT_HANDED) && XO_CONFIG_LEFT_HANDED
+    return AVector3(-rows[1][0], -rows[1][1], -rows[1][2]);
+#   elif defined(XO_CONFIG_RIGHT_HANDED) && XO_CONFIG_RIGHT_HANDED
+    return AVector3(rows[1][0], rows[1][1], rows[1][2]);
+#   else
+    static_assert(false, "Define XO_CONFIG_LEFT_HANDED and XO_CONFIG_RIGHT_HANDED. One \
+should have a value of 1, the other should have a value of 0.");
+#   endif
+#else
+    static_assert(false, "Define XO_CONFIG_Y_UP and XO_CONFIG_Z_UP. One should have a \
+value of 1, the other should have a value of 0.");
+#endif
+}
+
+XO_INL
+AVector3 AMatrix4x4::Backward() const {
+    return -Forward();
+}
+
+/*static*/ XO_INL 
+AMatrix4x4 XO_CC AMatrix4x4::Transpose(AMatrix4x4 const& AMatrixIn) {
+    AMatrix4x4 transposed = AMatrix4x4(AMatrixIn);
+    float t;
+#define XO_TRANSPOSE_SWAP(i,j) \
+    t = transposed.rows[i][j];\
+    transposed.rows[i][j] = transposed.rows[j][i]; \
+    transposed.rows[j][i] = t;
+
+    XO_TRANSPOSE_SWAP(0, 1);
+    XO_TRANSPOSE_SWAP(0, 2);
+    XO_TRANSPOSE_SWAP(0, 3);
+    XO_TRANSPOSE_SWAP(1, 2);
+    XO_TRANSPOSE_SWAP(1, 3);
+    XO_TRANSPOSE_SWAP(2, 3);
+#undef XO_TRANSPOSE_SWAP
+    return transposed;
+}
+
+/*static*/ XO_INL 
+AMatrix4x4 XO_CC AMatrix4x4::Invert(AMatrix4x4 const& AMatrixIn) {
+    float tmp[12]; // temp array for pairs
+    float src[16]; // array of transpose source AMatrix
+    float det; // determinant
+    AMatrix4x4 inverted(AMatrixIn);
+    EarlyInverse(tmp, src, det, inverted.v);
+    LateInverse(det, inverted.v);
+    return inverted;
+}
+
+/*static*/ XO_INL
+bool XO_CC AMatrix4x4::InvertSafe(AMatrix4x4 const& AMatrixIn, AMatrix4x4& AMatrixOut) {
+    float tmp[12]; // temp array for pairs
+    float src[16]; // array of transpose source AMatrix
+    float det; // determinant
+    AMatrix4x4 inverted(AMatrixIn);
+    EarlyInverse(tmp, src, det, inverted.v);
+    if (CloseEnough(det, 0.f))
+        return false;
+    LateInverse(det, inverted.v);
+    AMatrixOut = inverted;
+    return true;
+}
+
+/*static*/ XO_INL
+AMatrix4x4 XO_CC AMatrix4x4::InvertAffine(AMatrix4x4 const& matrixIn) {
+    // The columns of the 3x3 inverse are c0 = a1 x a2, c1 = a2 x a0 and c2 = a0 x a1 over
+    // the determinant a0 . c0.
+    AVector3 a0(matrixIn.v[0], matrixIn.v[1], matrixIn.v[2]);
+    AVector3 a1(matrixIn.v[4], matrixIn.v[5], matrixIn.v[6]);
+    AVector3 a2(matrixIn.v[8], matrixIn.v[9], matrixIn.v[10]);
+    AVector3 c0 = AVector3::CrossProduct(a1, a2);
+    AVector3 c1 = AVector3::CrossProduct(a2, a0);
+    AVector3 c2 = AVector3::CrossProduct(a0, a1);
+    float invDet = 1.f / AVector3::DotProduct(a0, c0);
+    AVector3 b0 = AVector3(c0.x, c1.x, c2.x) * invDet;
+    AVector3 b1 = AVector3(c0.y, c1.y, c2.y) * invDet;
+    AVector3 b2 = AVector3(c0.z, c1.z, c2.z) * invDet;
+    AVector3 d = -(b0 * matrixIn.v[12] + b1 * matrixIn.v[13] + b2 * matrixIn.v[14]);
+    return AMatrix4x4(
+        AVector4(b0.x, b0.y, b0.z, 0.f),
+        AVector4(b1.x, b1.y, b1.z, 0.f),
+        AVector4(b2.x, b2.y, b2.z, 0.f),
+        AVector4(d.x,  d.y,  d.z,  1.f));
+}
+
+/*static*/ XO_INL
+AMatrix4x4 XO_CC AMatrix4x4::InvertOrthonormal(AMatrix4x4 const& matrixIn) {
+    float const* m = matrixIn.v;
+    AVector3 b0(m[0], m[4], m[8]);
+    AVector3 b1(m[1], m[5], m[9]);
+    AVector3 b2(m[2], m[6], m[10]);
+    AVector3 d = -(b0 * m[12] + b1 * m[13] + b2 * m[14]);
+    return AMatrix4x4(
+        AVector4(b0.x, b0.y, b0.z, 0.f),
+        AVector4(b1.x, b1.y, b1.z, 0.f),
+        AVector4(b2.x, b2.y, b2.z, 0.f),
+        AVector4(d.x,  d.y,  d.z,  1.f));
+}
+
+/*static*/ XO_INL
+bool XO_CC AMatrix4x4::IsAffine(AMatrix4x4 const& matrixIn) {
+    return CloseEnough(matrixIn.v[3], 0.f) && CloseEnough(matrixIn.v[7], 0.f)
+        && CloseEnough(matrixIn.v[11], 0.f) && CloseEnough(matrixIn.v[15], 1.f);
+}
+
+/*static*/ XO_INL
+bool XO_CC AMatrix4x4::IsOrthonormal(AMatrix4x4 const& matrixIn) {
+    AVector3 a0(matrixIn.v[0], matrixIn.v[1], matrixIn.v[2]);
+    AVector3 a1(matrixIn.v[4], matrixIn.v[5], matrixIn.v[6]);
+    AVector3 a2(matrixIn.v[8], matrixIn.v[9], matrixIn.v[10]);
+    float const tolerance = 1e-5f;
+    return IsAffine(matrixIn)
+        && Abs(a0.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(a1.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(a2.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(AVector3::DotProduct(a0, a1)) <= tolerance
+        && Abs(AVector3::DotProduct(a1, a2)) <= tolerance
+        && Abs(AVector3::DotProduct(a2, a0)) <= tolerance;
+}
+
+/*static*/ XO_INL 
+AMatrix4x4 XO_CC AMatrix4x4::Translation(AVector3 const& pos) {
+    return AMatrix4x4(
+        AVector4(1.f,   0.f,   0.f,   0.f),
+        AVector4(0.f,   1.f,   0.f,   0.f),
+        AVector4(0.f,   0.f,   1.f,   0.f),
+        AVector4(pos.x, pos.y, pos.z, 1.f));
+}
+
+/*static*/ XO_INL 
+AMatrix4x4 XO_CC AMatrix4x4::Scale(AVector3 const& scale) {
+    return AMatrix4x4(
+        AVector4(scale.x, 0.f,     0.f,     0.f),
+        AVector4(0.f,     scale.y, 0.f,     0.f),
+        AVector4(0.f,     0.f,     scale.z, 0.f),
+        AVector4(0.f,     0.f,     0.f,     1.f));
+}
+
+/*static*/ XO_INL 
+AMatrix4x4 XO_CC AMatrix4x4::RotationYaw(float yaw) {
+    float s, c;
+    SinCos(yaw, s, c);
+    return AMatrix4x4(
+        AVector4(c,   0.f, -s,  0.f),
+        AVector4(0.f, 1.f, 0.f, 0.f),
+        AVector4(s,   0.f, c,   0.f),
+        AVector4(0.f, 0.f, 0.f, 1.f));
+}
+
+/*static*/ XO_INL
+AMatrix4x4 XO_CC AMatrix4x4::RotationPitch(float pitch) {
+    float s, c;
+    SinCos(pitch, s, c);
+    return AMatrix4x4(
+        AVector4(1.f, 0.f, 0.f, 0.f),
+        AVector4(0.f, c,   -s,  0.f),
+        AVector4(0.f, s,   c,   0.f),
+        AVector4(0.f, 0.f, 0.f, 1.f));
+}
+
+/*static*/ XO_INL 
+AMatrix4x4 XO_CC AMatrix4x4::RotationRoll(float roll) {
+    float s, c;
+    SinCos(roll, s, c);
+    return AMatrix4x4(
+        AVector4(c,   -s,  0.f, 0.f),
+        AVector4(s,   c,   0.f, 0.f),
+        AVector4(0.f, 0.f, 1.f, 0.f),
+        AVector4(0.f, 0.f, 0.f, 1.f));
+}
+
+/*static*/ XO_INL 
+AMatrix4x4 XO_CC AMatrix4x4::RotationYawPitchRoll(float yaw, float pitch, float roll) {
+    return RotationYaw(yaw) * RotationPitch(pitch) * RotationRoll(roll);
+}
+
+/*static*/ XO_INL
+AMatrix4x4 XO_CC AMatrix4x4::RotationAxisAngle(AVector3 const& axis, float angle) {
+    float s, c;
+    SinCos(angle, s, c);
+    float t = 1.f - c;
+    AVector3 a = axis.Normalized();
+    AMatrix4x4 rotation(AMatrix4x4::Identity);
+
+    rotation[0][0] = c + a.x*a.x*t;
+    rotation[1][1] = c + a.y*a.y*t;
+    rotation[2][2] = c + a.z*a.z*t;
+
+
+    float tmp1 = a.x*a.y*t;
+    float tmp2 = a.z*s;
+    rotation[1][0] = tmp1 + tmp2;
+    rotation[0][1] = tmp1 - tmp2;
+    
+    tmp1 = a.x*a.z*t;
+    tmp2 = a.y*s;
+    rotation[2][0] = tmp1 - tmp2;
+    rotation[0][2] = tmp1 + tmp2;    tmp1 = a.y*a.z*t;
+
+    tmp2 = a.x*s;
+    rotation[2][1] = tmp1 + tmp2;
+    rotation[1][2] = tmp1 - tmp2;
+
+    return rotation;
+}
+
+/*static*/ XO_INL 
+AMatrix4x4 XO_CC AMatrix4x4::PerspectiveFOV(float fov, 
+                                          float aspect, 
+                                          float nearPlane, 
+                                          float farPlane) {
+    float s, c;
+    SinCos(fov*0.5f, s, c);
+    float h = c / s;                             // height
+    float w = h / aspect;                        // width
+    float r = farPlane / (nearPlane - farPlane); // range
+    float rn = r * nearPlane;                    // range*near
+    return AMatrix4x4(
+        AVector4(w,   0.f, 0.f, 0.f),
+        AVector4(0.f, h,   0.f, 0.f),
+        AVector4(0.f, 0.f, r,  -1.f),
+        AVector4(0.f, 0.f, rn,  0.f));
+}
+
+/*static*/ XO_INL 
+AMatrix4x4 XO_CC AMatrix4x4::Perspective(float width,
+                                       float height, 
+                                       float aspect, 
+                                       float nearPlane, 
+                                       float farPlane) {
+    XO_UNUSED(aspect);   // width / height already give it
+    float n2 = Pow<2>(nearPlane);
+    float r = farPlane / (nearPlane - farPlane);
+    float w = n2 / width;
+    float h = n2 / height;
+    float rn = r * nearPlane;
+    return AMatrix4x4(
+        AVector4(w,   0.f, 0.f, 0.f),
+        AVector4(0.f, h,   0.f, 0.f),
+        AVector4(0.f, 0.f, r,  -1.f),
+        AVector4(0.f, 0.f, rn,  0.f));
+}
+
+/*static*/ XO_INL
+AMatrix4x4 XO_CC AMatrix4x4::Orthographic(float width,
+                                        float height,
+                                        float nearPlane,
+                                        float farPlane) {
+    float r = 1.f / (nearPlane - farPlane);
+    float w = 2.f / width;
+    float h = 2.f / height;
+    float rn = r * nearPlane;
+    return AMatrix4x4(
+        AVector4(w, 0.f, 0.f, 0.f),
+        AVector4(0.f, h, 0.f, 0.f),
+        AVector4(0.f, 0.f, r, 0.f),
+        AVector4(0.f, 0.f, rn, 0.f));
+}
+
+/*static*/ XO_INL
+AMatrix4x4 XO_CC AMatrix4x4::LookAt(AVector3 const& from,
+                                  AVector3 const& to, 
+                                  AVector3 const& up) {
+    AVector3 dir = from - to;
+    AVector3 r2 = dir.Normalized();
+    AVector3 r0 = AVector3::CrossProduct(up, r2).Normalized();
+    AVector3 r1 = AVector3::CrossProduct(r2, r0);
+
+    float d0 = -AVector3::DotProduct(r0, from);
+    float d1 = -AVector3::DotProduct(r1, from);
+    float d2 = -AVector3::DotProduct(r2, from);
+    return AMatrix4x4(
+        AVector4(r0.x, r1.x, r2.x, 0.f),
+        AVector4(r0.y, r1.y, r2.y, 0.f),
+        AVector4(r0.z, r1.z, r2.z, 0.f),
+        AVector4(d0,   d1,   d2,   1.f));
+}
+
+/*static*/ XO_INL 
+bool XO_CC AMatrix4x4::RoughlyEqual(AMatrix4x4 const& left, AMatrix4x4 const& right) {
+    return AVector4::RoughlyEqual(left[0], right[0])
+        && AVector4::RoughlyEqual(left[1], right[1])
+        && AVector4::RoughlyEqual(left[2], right[2])
+        && AVector4::RoughlyEqual(left[3], right[3]);
+}
+
+/*static*/ XO_INL 
+bool XO_CC AMatrix4x4::ExactlyEqual(AMatrix4x4 const& left, AMatrix4x4 const& right) {
+    return AVector4::ExactlyEqual(left[0], right[0])
+        && AVector4::ExactlyEqual(left[1], right[1])
+        && AVector4::ExactlyEqual(left[2], right[2])
+        && AVector4::ExactlyEqual(left[3], right[3]);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////// AQuaternion
+#if defined(XO_MATH_IMPL)
+/*static*/ const AQuaternion AQuaternion::Zero(0.f);
+/*static*/ const AQuaternion AQuaternion::Identity(0.f, 0.f, 0.f, 1.f);
+#endif
+
+XO_INL
+AQuaternion AQuaternion::operator + (AQuaternion other) const {
+    return AQuaternion(i + other.i, j + other.j, k + other.k, r + other.r);
+}
+
+XO_INL
+AQuaternion AQuaternion::operator *(float s) const { 
+    return AQuaternion(i*s, j*s, k*s, r*s); 
+}
+
+XO_INL
+AQuaternion AQuaternion::operator -() const {
+    return AQuaternion(-i, -j, -k, -r);
+}
+
+XO_INL
+AQuaternion XO_CC AQuaternion::operator * (AQuaternion const& other) const {
+    return AQuaternion(r * other.i + i * other.r + j * other.k - k * other.j,
+                       r * other.j - i * other.k + j * other.r + k * other.i,
+                       r * other.k + i * other.j - j * other.i + k * other.r,
+                       r * other.r - i * other.i - j * other.j - k * other.k);
+}
+
+XO_INL
+AQuaternion& XO_CC AQuaternion::operator *= (AQuaternion const& other) {
+    return *this = *this * other;
+}
+
+XO_INL
+AVector3 XO_CC AQuaternion::Rotate(AVector3 const& v) const {
+    AVector3 q(i, j, k);
+    AVector3 t = AVector3::CrossProduct(q, v) * 2.f;
+    return v + t * r + AVector3::CrossProduct(q, t);
+}
+
+XO_INL
+float AQuaternion::Magnitude() const {
+    return vec4.Magnitude();
+}
+
+XO_INL 
+float AQuaternion::MagnitudeSquared() const {
+    return vec4.MagnitudeSquared();
+};
+
+XO_INL
+AQuaternion AQuaternion::Normalized(Precision precision) const {
+    return AQuaternion(vec4.Normalized(precision));
+};
+
+XO_INL
+AQuaternion& AQuaternion::Normalize(Precision precision) {
+    vec4.Normalize(precision); return *this;
+};
+
+XO_INL
+AMatrix4x4 AQuaternion::ToMatrix() const {
+    // See: https://www.flipcode.com/documents/matrfaq.html#Q54
+    float ii = i * i;
+    float ij = i * j;
+    float ik = i * k;
+    float ir = i * r;
+    float jj = j * j;
+    float jk = j * k;
+    float jr = j * r;
+    float kk = k * k;
+    float kr = k * r;
+    return AMatrix4x4(
+        AVector4(1.f - 2.f * (jj + kk), 2.f * (ij - kr), 2.f * (ik + jr), 0.f),
+        AVector4(2.f * (ij + kr), 1.f - 2.f * (ii + kk), 2.f * (jk - ir), 0.f),
+        AVector4(2.f * (ik - jr), 2.f * (jk + ir), 1.f - 2.f * (ii + jj), 0.f),
+        AVector4(0.f, 0.f, 0.f, 1.f));
+}
+
+/*static*/ XO_INL
+AQuaternion XO_CC AQuaternion::Invert(AQuaternion const& quat) {
+    return AQuaternion(-quat.i, -quat.j, -quat.k, quat.r);
+}
+
+/*static*/ XO_INL
+AQuaternion XO_CC AQuaternion::RotationAxisAngle(AVector3 const& axis, float angle) {
+    float s, c;
+    SinCos(angle*0.5f, s, c);
+    return AQuaternion(axis.x*s, axis.y*s, axis.z*s, c);
+}
+
+/*static*/ XO_INL
+AQuaternion XO_CC AQuaternion::RotationEuler(AVector3 const& angles) {
+    float sr, cp, sp, cy, sy, cr;
+    // todo: rename. yaw, pitch, roll are misnomers here. switch yaw and pitch.
+    SinCos(angles.x * 0.5f, sy, cy);
+    SinCos(angles.y * 0.5f, sp, cp);
+    SinCos(angles.z * 0.5f, sr, cr);
+    return AQuaternion(cy * cr * cp + sy * sr * sp,
+                      cy * sr * cp - sy * cr * sp,
+                      cy * cr * sp + sy * sr * cp,
+                      sy * cr * cp - cy * sr * sp);
+}
+
+/*static*/ XO_INL
+float XO_CC AQuaternion::DotProduct(AQuaternion const& left, AQuaternion const& right) {
+    return AVector4::DotProduct(left.vec4, right.vec4);
+}
+
+/*static*/ XO_INL
+AQuaternion XO_CC AQuaternion::Lerp(AQuaternion const& start,
+                                  AQuaternion const& end,
+                                  float t) {
+    return AQuaternion(AVector4::Lerp(start.vec4, end.vec4, t));
+}
+
+/*static*/ XO_INL
+AQuaternion XO_CC AQuaternion::Slerp(AQuaternion const& start, 
+                                   AQuaternion const& end, 
+                                   float t) {
+    AQuaternion s = start.Normalized();
+    AQuaternion e = end.Normalized();
+    float d = AQuaternion::DotProduct(s, e);
+    if (d < 0.f) {
+        e = -e;
+        d = -d;
+    }
+
+    if (CloseEnough(d, 1.f)) {
+        return Lerp(s, e, t).Normalize();
+    }
+
+    float th0 = ACos(d);
+    float th = th0 * t;
+
+    float st, ct, sth0;
+    SinCos(th, st, ct);
+    sth0 = Sin(th0);
+    float s0 = ct - d * st / sth0;
+    float s1 = st / sth0;
+    return (s * s0) + (e * s1);
+}
+
+/*static*/ XO_INL 
+bool XO_CC AQuaternion::RoughlyEqual(AQuaternion const& left, AQuaternion const& right) {
+    return CloseEnough(left.i, right.i)
+        && CloseEnough(left.j, right.j)
+        && CloseEnough(left.k, right.k)
+        && CloseEnough(left.r, right.r);
+}
+
+/*static*/ XO_INL 
+bool XO_CC AQuaternion::ExactlyEqual(AQuaternion const& left, AQuaternion const& right) {
+    return left.i == right.i
+        && left.j == right.j
+        && left.k == right.k
+        && left.r == right.r;
+}
+
+} // ::xo
+
+////////////////////////////////////////////////////////////////////////////////////////// end xo-math-reference.h inline
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////// xo-math-matrix3x4.h inlined
+#line 6 "xo-math-matrix3x4.h"
+namespace xo {
+//////////////////////////////////////////////////////////////////////////////////////////
+// An affine transform in 12 floats: a Matrix4x4 whose last column is (0, 0, 0, 1), which
+// is what Translation, Scale, the Rotation functions and LookAt build.
+// It's stored transposed, rows[i] is column i of that Matrix4x4. Each row is then a
+// Vector4 whose dot product with (p, 1) gives one component of the transformed point, and
+// the translation is (rows[0].w, rows[1].w, rows[2].w).
+// Points are row vectors like they are for Translation: p' = p * M, so a * b is a then b,
+// the same order as the Matrix4x4 product of the two.
+struct Matrix3x4 {
+    union {
+        Vector4 rows[3];
+        float v[12];
+    };
+
+    constexpr Matrix3x4(Vector4 const& row0,
+                        Vector4 const& row1,
+                        Vector4 const& row2)
+        : rows{
+            row0,
+            row1,
+            row2 }
+    { }
+
+    // Drops the last column of matrix, which should be (0, 0, 0, 1).
+    explicit Matrix3x4(Matrix4x4 const& matrix);
+
+    Matrix3x4() = default;
+    ~Matrix3x4() = default;
+    Matrix3x4(Matrix3x4 const& other) = default;
+    Matrix3x4(Matrix3x4&& ref) = default;
+    Matrix3x4& operator = (Matrix3x4 const& other) = default;
+    Matrix3x4& operator = (Matrix3x4&& ref) = default;
+
+    Matrix4x4 XO_CC ToMatrix4x4() const;
+
+    Vector3 XO_CC TransformPoint(Vector3 const& point) const;
+    Vector3 XO_CC TransformDirection(Vector3 const& direction) const;
+    Vector3 XO_CC GetTranslation() const;
+
+    Matrix3x4 XO_CC operator * (Matrix3x4 const& other) const;
+    Matrix3x4& XO_CC operator *= (Matrix3x4 const& other);
+
+    static Matrix3x4 XO_CC Invert(Matrix3x4 const& matrixIn);
+    // Scale, then rotate, then translate. The same matrix as
+    // Matrix4x4::Scale(scale) * R * Matrix4x4::Translation(translation), where R is
+    // Matrix4x4::RotationAxisAngle(axis, angle) for Quaternion::RotationAxisAngle(axis, angle).
+    // rotation should be normalized.
+    static Matrix3x4 XO_CC FromTRS(Vector3 const& translation,
+                                   Quaternion const& rotation,
+                                   Vector3 const& scale);
+    static bool XO_CC RoughlyEqual(Matrix3x4 const& left, Matrix3x4 const& right);
+    static bool XO_CC ExactlyEqual(Matrix3x4 const& left, Matrix3x4 const& right);
+
+    static const Matrix3x4 Identity;
+};
+
+#if defined(XO_MATH_IMPL)
+/*static*/ const Matrix3x4 Matrix3x4::Identity(
+    Vector4(1.f, 0.f, 0.f, 0.f),
+    Vector4(0.f, 1.f, 0.f, 0.f),
+    Vector4(0.f, 0.f, 1.f, 0.f));
+#endif
+
+XO_INL
+Matrix3x4::Matrix3x4(Matrix4x4 const& matrix)
+    : rows{
+        Vector4(matrix.v[0], matrix.v[4], matrix.v[8], matrix.v[12]),
+        Vector4(matrix.v[1], matrix.v[5], matrix.v[9], matrix.v[13]),
+        Vector4(matrix.v[2], matrix.v[6], matrix.v[10], matrix.v[14]) }
+{ }
+
+XO_INL
+Matrix4x4 XO_CC Matrix3x4::ToMatrix4x4() const {
+    return Matrix4x4(
+        Vector4(v[0], v[4], v[8],  0.f),
+        Vector4(v[1], v[5], v[9],  0.f),
+        Vector4(v[2], v[6], v[10], 0.f),
+        Vector4(v[3], v[7], v[11], 1.f));
+}
+
+XO_INL
+Vector3 XO_CC Matrix3x4::TransformPoint(Vector3 const& point) const {
+    Vector4 p(point.x, point.y, point.z, 1.f);
+    return Vector3(Vector4::DotProduct(rows[0], p),
+                   Vector4::DotProduct(rows[1], p),
+                   Vector4::DotProduct(rows[2], p));
+}
+
+XO_INL
+Vector3 XO_CC Matrix3x4::TransformDirection(Vector3 const& direction) const {
+    Vector4 d(direction.x, direction.y, direction.z, 0.f);
+    return Vector3(Vector4::DotProduct(rows[0], d),
+                   Vector4::DotProduct(rows[1], d),
+                   Vector4::DotProduct(rows[2], d));
+}
+
+XO_INL
+Vector3 XO_CC Matrix3x4::GetTranslation() const {
+    return Vector3(v[3], v[7], v[11]);
+}
+
+XO_INL
+Matrix3x4 XO_CC Matrix3x4::operator * (Matrix3x4 const& other) const {
+    return Matrix3x4(*this) *= other;
+}
+
+XO_INL
+Matrix3x4& XO_CC Matrix3x4::operator *= (Matrix3x4 const& other) {
+    // Row i of the result is column i of the product: the rows of this weighted by
+    // other.rows[i], plus other's translation.
+    Vector4 const a0 = rows[0], a1 = rows[1], a2 = rows[2];
+    for (int i = 0; i < 3; ++i) {
+        Vector4 const& b = other.rows[i];
+        rows[i] = a0 * b.x + a1 * b.y + a2 * b.z + Vector4(0.f, 0.f, 0.f, b.w);
+    }
+    return *this;
+}
+
+/*static*/ XO_INL
+Matrix3x4 XO_CC Matrix3x4::Invert(Matrix3x4 const& matrixIn) {
+    // The 3x3 parts of rows are the rows of L transposed, with L the linear part of the
+    // Matrix4x4. The inverse wants the columns of L^-1 as rows: those are the rows of
+    // (L^T)^-1, whose columns are c0 = a1 x a2, c1 = a2 x a0 and c2 = a0 x a1 over
+    // a0 . c0. The translation t moves to -t * L^-1.
+    Vector3 a0(matrixIn.v[0], matrixIn.v[1], matrixIn.v[2]);
+    Vector3 a1(matrixIn.v[4], matrixIn.v[5], matrixIn.v[6]);
+    Vector3 a2(matrixIn.v[8], matrixIn.v[9], matrixIn.v[10]);
+    Vector3 c0 = Vector3::CrossProduct(a1, a2);
+    Vector3 c1 = Vector3::CrossProduct(a2, a0);
+    Vector3 c2 = Vector3::CrossProduct(a0, a1);
+    float invDet = 1.f / Vector3::DotProduct(a0, c0);
+    Vector3 g0 = Vector3(c0.x, c1.x, c2.x) * invDet;
+    Vector3 g1 = Vector3(c0.y, c1.y, c2.y) * invDet;
+    Vector3 g2 = Vector3(c0.z, c1.z, c2.z) * invDet;
+    Vector3 t = matrixIn.GetTranslation();
+    return Matrix3x4(
+        Vector4(g0.x, g0.y, g0.z, -Vector3::DotProduct(t, g0)),
+        Vector4(g1.x, g1.y, g1.z, -Vector3::DotProduct(t, g1)),
+        Vector4(g2.x, g2.y, g2.z, -Vector3::DotProduct(t, g2)));
+}
+
+/*static*/ XO_INL
+Matrix3x4 XO_CC Matrix3x4::FromTRS(Vector3 const& translation,
+                                   Quaternion const& rotation,
+                                   Vector3 const& scale) {
+    // Row i is column i of the rotation matrix of q, scaled per component, with the
+    // translation in w. No trig and no matrix products.
+    float x = rotation.i, y = rotation.j, z = rotation.k, w = rotation.r;
+    float x2 = x + x, y2 = y + y, z2 = z + z;
+    float xx = x * x2, yy = y * y2, zz = z * z2;
+    float xy = x * y2, xz = x * z2, yz = y * z2;
+    float wx = w * x2, wy = w * y2, wz = w * z2;
+    return Matrix3x4(
+        Vector4((1.f - (yy + zz)) * scale.x, (xy + wz) * scale.y, (xz - wy) * scale.z, translation.x),
+        Vector4((xy - wz) * scale.x, (1.f - (xx + zz)) * scale.y, (yz + wx) * scale.z, translation.y),
+        Vector4((xz + wy) * scale.x, (yz - wx) * scale.y, (1.f - (xx + yy)) * scale.z, translation.z));
+}
+
+/*static*/ XO_INL
+bool XO_CC Matrix3x4::RoughlyEqual(Matrix3x4 const& left, Matrix3x4 const& right) {
+    return Vector4::RoughlyEqual(left.rows[0], right.rows[0])
+        && Vector4::RoughlyEqual(left.rows[1], right.rows[1])
+        && Vector4::RoughlyEqual(left.rows[2], right.rows[2]);
+}
+
+/*static*/ XO_INL
+bool XO_CC Matrix3x4::ExactlyEqual(Matrix3x4 const& left, Matrix3x4 const& right) {
+    return Vector4::ExactlyEqual(left.rows[0], right.rows[0])
+        && Vector4::ExactlyEqual(left.rows[1], right.rows[1])
+        && Vector4::ExactlyEqual(left.rows[2], right.rows[2]);
+}
+} // ::xo
+
+////////////////////////////////////////////////////////////////////////////////////////// end xo-math-matrix3x4.h inline
+////////////////////////////////////////////////////////////////////////////////////////// xo-math-generic.h inlined
+#line 6 "xo-math-generic.h"
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+namespace xo {
+//////////////////////////////////////////////////////////////////////////////////////////
+// Vector<N, T, Align> and Matrix<R, C, T, Align> for any size and any arithmetic T.
+// Everything short of a square root is constexpr, and the per component work is expanded
+// over an index sequence rather than looped, so vectors and matrices built from constants
+// fold away entirely:
+//
+//     constexpr Matrix<3, 3, float> m(Vector<3, float>(0.f, -1.f, 0.f),
+//                                     Vector<3, float>(1.f,  0.f, 0.f),
+//                                     Vector<3, float>(0.f,  0.f, 1.f));
+//     static_assert((m * m.Transposed()).ExactlyEqual(Matrix<3, 3, float>::Identity()), "");
+//
+// They sit beside Vector3, Vector4 and Matrix4x4 instead of replacing them, those keep
+// their SSE layouts and A types. The memory layout is the same though: Vector<3, float> is
+// three floats like Vector3 and Matrix<4, 4, float> is 16 row major floats like Matrix4x4,
+// see Generic() and the To functions at the end.
+// Matrices work on column vectors like Matrix4x4::Transform: Transform(v) is the dot
+// product of each row with v.
+
+template<int N, typename T, size_t Align = alignof(T)>
+struct alignas(Align) Vector {
+    static_assert(N > 0, "xo::Vector needs at least one component");
+    typedef T Scalar;
+    static constexpr int Size = N;
+
+    T v[N];
+
+    Vector() = default;
+    constexpr explicit Vector(T all) : Vector(all, std::make_index_sequence<N>()) { }
+    // One value per component.
+    template<typename... A, typename = typename std::enable_if<sizeof...(A) == N && (N > 1)>::type>
+    constexpr Vector(A... components) : v{ static_cast<T>(components)... } { }
+
+    constexpr T const& operator [] (int i) const { return v[i]; }
+    constexpr T& operator [] (int i) { return v[i]; }
+    // v.x() through v.w() are v[0] through v[3], as far as N goes. Functions rather than a
+    // union with Vector3's x, y and z members, which constant expressions couldn't read.
+    constexpr T const& x() const { return v[0]; }
+    constexpr T& x() { return v[0]; }
+    template<int M = N, typename = typename std::enable_if<(M > 1)>::type> constexpr T const& y() const { return v[1]; }
+    template<int M = N, typename = typename std::enable_if<(M > 1)>::type> constexpr T& y() { return v[1]; }
+    template<int M = N, typename = typename std::enable_if<(M > 2)>::type> constexpr T const& z() const { return v[2]; }
+    template<int M = N, typename = typename std::enable_if<(M > 2)>::type> constexpr T& z() { return v[2]; }
+    template<int M = N, typename = typename std::enable_if<(M > 3)>::type> constexpr T const& w() const { return v[3]; }
+    template<int M = N, typename = typename std::enable_if<(M > 3)>::type> constexpr T& w() { return v[3]; }
+
+    constexpr Vector operator + (Vector const& o) const { return Map(*this, o, std::plus<T>()); }
+    constexpr Vector operator - (Vector const& o) const { return Map(*this, o, std::minus<T>()); }
+    constexpr Vector operator * (Vector const& o) const { return Map(*this, o, std::multiplies<T>()); }
+    constexpr Vector operator / (Vector const& o) const { return Map(*this, o, std::divides<T>()); }
+    constexpr Vector operator * (T s) const { return *this * Vector(s); }
+    constexpr Vector operator / (T s) const { return *this / Vector(s); }
+    constexpr Vector operator - () const { return Vector(T(0)) - *this; }
+    constexpr Vector& operator += (Vector const& o) { return *this = *this + o; }
+    constexpr Vector& operator -= (Vector const& o) { return *this = *this - o; }
+    constexpr Vector& operator *= (Vector const& o) { return *this = *this * o; }
+    constexpr Vector& operator /= (Vector const& o) { return *this = *this / o; }
+    constexpr Vector& operator *= (T s) { return *this = *this * s; }
+    constexpr Vector& operator /= (T s) { return *this = *this / s; }
+
+    constexpr T Sum() const {
+        T sum = v[0];
+        for (int i = 1; i < N; ++i) sum += v[i];
+        return sum;
+    }
+    constexpr T MagnitudeSquared() const { return DotProduct(*this, *this); }
+    T Magnitude() const { return static_cast<T>(std::sqrt(MagnitudeSquared())); }
+    Vector Normalized() const { return *this / Magnitude(); }
+
+    // The same vector with each component converted to U.
+    template<typename U, size_t UAlign = alignof(U)>
+    constexpr Vector<N, U, UAlign> Cast() const { return Cast<U, UAlign>(std::make_index_sequence<N>()); }
+
+    constexpr bool ExactlyEqual(Vector const& o) const {
+        for (int i = 0; i < N; ++i) if (!(v[i] == o.v[i])) return false;
+        return true;
+    }
+    // Each component within CloseEnough of the other, exact for integer T.
+    constexpr bool RoughlyEqual(Vector const& o) const {
+        for (int i = 0; i < N; ++i) {
+            T const epsilon = std::numeric_limits<T>::epsilon() * xo::Max(T(1), Abs(v[i]), Abs(o.v[i]));
+            if (!(Abs(v[i] - o.v[i]) <= epsilon)) return false;
+        }
+        return true;
+    }
+    constexpr bool operator == (Vector const& o) const { return ExactlyEqual(o); }
+    constexpr bool operator != (Vector const& o) const { return !ExactlyEqual(o); }
+
+    static constexpr T DotProduct(Vector const& left, Vector const& right) { return (left * right).Sum(); }
+    template<int M = N, typename = typename std::enable_if<M == 3>::type>
+    static constexpr Vector CrossProduct(Vector const& l, Vector const& r) {
+        return Vector(l.v[1] * r.v[2] - l.v[2] * r.v[1],
+                      l.v[2] * r.v[0] - l.v[0] * r.v[2],
+                      l.v[0] * r.v[1] - l.v[1] * r.v[0]);
+    }
+    static constexpr Vector Lerp(Vector const& start, Vector const& end, T t) { return start + (end - start) * t; }
+    static constexpr Vector Min(Vector const& a, Vector const& b) { return Map(a, b, MinOp()); }
+    static constexpr Vector Max(Vector const& a, Vector const& b) { return Map(a, b, MaxOp()); }
+    // Component i is 1, the rest 0.
+    static constexpr Vector Unit(int i) { return Unit(i, std::make_index_sequence<N>()); }
+    static constexpr Vector Zero() { return Vector(T(0)); }
+
+private:
+    struct MinOp { constexpr T operator () (T a, T b) const { return xo::Min(a, b); } };
+    struct MaxOp { constexpr T operator () (T a, T b) const { return xo::Max(a, b); } };
+
+    template<size_t... I>
+    constexpr Vector(T all, std::index_sequence<I...>) : v{ (static_cast<void>(I), all)... } { }
+
+    template<typename Op, size_t... I>
+    static constexpr Vector Map(Vector const& l, Vector const& r, Op op, std::index_sequence<I...>) {
+        return Vector(static_cast<T>(op(l.v[I], r.v[I]))...);
+    }
+    template<typename Op>
+    static constexpr Vector Map(Vector const& l, Vector const& r, Op op) {
+        return Map(l, r, op, std::make_index_sequence<N>());
+    }
+    template<size_t... I>
+    static constexpr Vector Unit(int i, std::index_sequence<I...>) {
+        return Vector((int(I) == i ? T(1) : T(0))...);
+    }
+    template<typename U, size_t UAlign, size_t... I>
+    constexpr Vector<N, U, UAlign> Cast(std::index_sequence<I...>) const {
+        return Vector<N, U, UAlign>(static_cast<U>(v[I])...);
+    }
+};
+
+template<int N, typename T, size_t Align>
+constexpr Vector<N, T, Align> operator * (T s, Vector<N, T, Align> const& v) { return v * s; }
+
+//////////////////////////////////////////////////////////////////////////////////////////
+template<int R, int C, typename T, size_t Align = alignof(T)>
+struct alignas(Align) Matrix {
+    typedef Vector<C, T> Row;
+    typedef Vector<R, T> Column;
+    typedef T Scalar;
+    static constexpr int Rows = R;
+    static constexpr int Columns = C;
+
+    Row rows[R];
+
+    Matrix() = default;
+    // One Row per row.
+    template<typename... A, typename = typename std::enable_if<sizeof...(A) == R>::type>
+    constexpr Matrix(A const&... r) : rows{ Row(r)... } { }
+
+    constexpr Row const& operator [] (int row) const { return rows[row]; }
+    constexpr Row& operator [] (int row) { return rows[row]; }
+    constexpr Column GetColumn(int column) const { return GetColumn(column, std::make_index_sequence<R>()); }
+
+    constexpr Matrix operator + (Matrix const& o) const { return Map(o, std::plus<Row>()); }
+    constexpr Matrix operator - (Matrix const& o) const { return Map(o, std::minus<Row>()); }
+    constexpr Matrix operator * (T s) const { return Map(*this, ScaleOp{ s }); }
+
+    template<int K, size_t OAlign>
+    constexpr Matrix<R, K, T, Align> operator * (Matrix<C, K, T, OAlign> const& o) const {
+        return Multiply(o, std::make_index_sequence<R>());
+    }
+    template<size_t OAlign>
+    constexpr Matrix& operator *= (Matrix<C, C, T, OAlign> const& o) { return *this = *this * o; }
+
+    // The dot product of each row with v.
+    constexpr Column Transform(Row const& v) const { return Transform(v, std::make_index_sequence<R>()); }
+
+    constexpr Matrix<C, R, T, Align> Transposed() const { return Transposed(std::make_index_sequence<C>()); }
+
+    // The same matrix with each element converted to U.
+    template<typename U, size_t UAlign = alignof(U)>
+    constexpr Matrix<R, C, U, UAlign> Cast() const { return Cast<U, UAlign>(std::make_index_sequence<R>()); }
+
+    constexpr bool ExactlyEqual(Matrix const& o) const {
+        for (int i = 0; i < R; ++i) if (!rows[i].ExactlyEqual(o.rows[i])) return false;
+        return true;
+    }
+    constexpr bool RoughlyEqual(Matrix const& o) const {
+        for (int i = 0; i < R; ++i) if (!rows[i].RoughlyEqual(o.rows[i])) return false;
+        return true;
+    }
+    constexpr bool operator == (Matrix const& o) const { return ExactlyEqual(o); }
+    constexpr bool operator != (Matrix const& o) const { return !ExactlyEqual(o); }
+
+    template<int M = R, typename = typename std::enable_if<M == C>::type>
+    static constexpr Matrix Identity() { return Identity(std::make_index_sequence<R>()); }
+
+private:
+    struct ScaleOp { T s; constexpr Row operator () (Row const& r, Row const&) const { return r * s; } };
+
+    template<typename Op, size_t... I>
+    constexpr Matrix Map(Matrix const& o, Op op, std::index_sequence<I...>) const {
+        return Matrix(op(rows[I], o.rows[I])...);
+    }
+    template<typename Op>
+    constexpr Matrix Map(Matrix const& o, Op op) const { return Map(o, op, std::make_index_sequence<R>()); }
+
+    // Row 'row' of this times o: o's rows weighted by this row's components.
+    template<int K, size_t OAlign>
+    static constexpr Vector<K, T> RowTimes(Row const& row, Matrix<C, K, T, OAlign> const& o) {
+        Vector<K, T> sum = o.rows[0] * row.v[0];
+        for (int j = 1; j < C; ++j) sum += o.rows[j] * row.v[j];
+        return sum;
+    }
+    template<int K, size_t OAlign, size_t... I>
+    constexpr Matrix<R, K, T, Align> Multiply(Matrix<C, K, T, OAlign> const& o, std::index_sequence<I...>) const {
+        return Matrix<R, K, T, Align>(RowTimes(rows[I], o)...);
+    }
+    template<size_t... I>
+    constexpr Column Transform(Row const& v, std::index_sequence<I...>) const {
+        return Column(Row::DotProduct(rows[I], v)...);
+    }
+    template<size_t... I>
+    constexpr Column GetColumn(int column, std::index_sequence<I...>) const {
+        return Column(rows[I].v[column]...);
+    }
+    template<size_t... I>
+    constexpr Matrix<C, R, T, Align> Transposed(std::index_sequence<I...>) const {
+        return Matrix<C, R, T, Align>(GetColumn(int(I))...);
+    }
+    template<size_t... I>
+    static constexpr Matrix Identity(std::index_sequence<I...>) { return Matrix(Row::Unit(int(I))...); }
+    template<typename U, size_t UAlign, size_t... I>
+    constexpr Matrix<R, C, U, UAlign> Cast(std::index_sequence<I...>) const {
+        return Matrix<R, C, U, UAlign>(rows[I].template Cast<U>()...);
+    }
+};
+
+template<int R, int C, typename T, size_t Align>
+constexpr Matrix<R, C, T, Align> operator * (T s, Matrix<R, C, T, Align> const& m) { return m * s; }
+
+typedef Vector<2, float> Vector2f;
+typedef Vector<2, int32_t> Vector2i;
+typedef Vector<3, int32_t> Vector3i;
+typedef Vector<4, int32_t> Vector4i;
+
+// Between the generic float types and the SSE or reference ones.
+XO_INL Vector<3, float> Generic(Vector3 const& v) { return Vector<3, float>(v.x, v.y, v.z); }
+XO_INL Vector<4, float> Generic(Vector4 const& v) { return Vector<4, float>(v.x, v.y, v.z, v.w); }
+XO_INL Matrix<4, 4, float> Generic(Matrix4x4 const& m) {
+    return Matrix<4, 4, float>(Generic(m.rows[0]), Generic(m.rows[1]), Generic(m.rows[2]), Generic(m.rows[3]));
+}
+XO_INL Vector3 ToVector3(Vector<3, float> const& v) { return Vector3(v.v[0], v.v[1], v.v[2]); }
+XO_INL Vector4 ToVector4(Vector<4, float> const& v) { return Vector4(v.v[0], v.v[1], v.v[2], v.v[3]); }
+XO_INL Matrix4x4 ToMatrix4x4(Matrix<4, 4, float> const& m) {
+    return Matrix4x4(ToVector4(m.rows[0]), ToVector4(m.rows[1]), ToVector4(m.rows[2]), ToVector4(m.rows[3]));
+}
+} // ::xo
+
+////////////////////////////////////////////////////////////////////////////////////////// end xo-math-generic.h inline
+////////////////////////////////////////////////////////////////////////////////////////// xo-math-double.h inlined
+#line 7 "xo-math-double.h"
+#include <cmath>
+namespace xo {
+//////////////////////////////////////////////////////////////////////////////////////////
+// Double precision for world space positions that floats can't hold, like a planet sized
+// map where a float is already a centimetre off 100km from the origin.
+// The vectors and the matrix are the generic templates over double, Quaterniond mirrors
+// Quaternion. Being the templates, the vectors name their components with functions,
+// p.x() where a Vector3 has p.x, and DotProduct and CrossProduct are static as on Vector3.
+// Keep the simulation in doubles and go to floats per frame relative to the camera: the
+// subtraction happens before the precision goes, so everything near the camera is as exact
+// as floats allow.
+//
+//     Vector3 p = RelativeTo(position, cameraPosition);
+//     batch::RelativeTo(positions, cameraPosition, renderPositions, count);
+//
+// The array work, RelativeTo and TransformPoints, is in xo::batch and runs 4 doubles at a
+// time with AVX2 and 8 with AVX512.
+
+typedef Vector<3, double> Vector3d;
+typedef Vector<4, double> Vector4d;
+typedef Matrix<4, 4, double> Matrix4x4d;
+
+struct Quaterniond {
+    union {
+        struct { double i, j, k, r; };
+        Vector4d vec4;
+    };
+
+    constexpr Quaterniond(double i, double j, double k, double r)
+        : i(i)
+        , j(j)
+        , k(k)
+        , r(r)
+    { }
+
+    constexpr explicit Quaterniond(Vector4d const& v4)
+        : vec4(v4)
+    { }
+
+    explicit Quaterniond(Quaternion const& q);
+
+    Quaterniond() = default;
+    ~Quaterniond() = default;
+    Quaterniond(Quaterniond const& other) = default;
+    Quaterniond(Quaterniond&& ref) = default;
+    Quaterniond& operator = (Quaterniond const& other) = default;
+    Quaterniond& operator = (Quaterniond&& ref) = default;
+
+    Quaterniond operator + (Quaterniond const& other) const;
+    Quaterniond operator * (double scalar) const;
+    Quaterniond operator -() const;
+    // The Hamilton product: rotating by a * b is rotating by b, then by a.
+    Quaterniond XO_CC operator * (Quaterniond const& other) const;
+    Quaterniond& XO_CC operator *= (Quaterniond const& other);
+
+    // v rotated by this, which should be normalized.
+    Vector3d XO_CC Rotate(Vector3d const& v) const;
+
+    double Magnitude() const;
+    double MagnitudeSquared() const;
+    Quaterniond Normalized() const;
+    Quaterniond& Normalize();
+
+    Matrix4x4d ToMatrix() const;
+    Quaternion ToFloat() const;
+
+    static Quaterniond XO_CC Invert(Quaterniond const& quat);
+    static Quaterniond XO_CC RotationAxisAngle(Vector3d const& axis, double angle);
+    static double XO_CC DotProduct(Quaterniond const& left, Quaterniond const& right);
+    static Quaterniond XO_CC Lerp(Quaterniond const& start, Quaterniond const& end, double t);
+    static Quaterniond XO_CC Slerp(Quaterniond const& start, Quaterniond const& end, double t);
+
+    static bool XO_CC RoughlyEqual(Quaterniond const& left, Quaterniond const& right);
+    static bool XO_CC ExactlyEqual(Quaterniond const& left, Quaterniond const& right);
+
+    static const Quaterniond Identity;
+};
+
+#if defined(XO_MATH_IMPL)
+/*static*/ const Quaterniond Quaterniond::Identity(0.0, 0.0, 0.0, 1.0);
+#endif
+
+XO_INL
+Quaterniond::Quaterniond(Quaternion const& q)
+    : i(q.i)
+    , j(q.j)
+    , k(q.k)
+    , r(q.r)
+{ }
+
+XO_INL
+Quaterniond Quaterniond::operator + (Quaterniond const& other) const {
+    return Quaterniond(vec4 + other.vec4);
+}
+
+XO_INL
+Quaterniond Quaterniond::operator * (double scalar) const {
+    return Quaterniond(vec4 * scalar);
+}
+
+XO_INL
+Quaterniond Quaterniond::operator -() const {
+    return Quaterniond(-vec4);
+}
+
+XO_INL
+Quaterniond XO_CC Quaterniond::operator * (Quaterniond const& other) const {
+    return Quaterniond(r * other.i + i * other.r + j * other.k - k * other.j,
+                       r * other.j - i * other.k + j * other.r + k * other.i,
+                       r * other.k + i * other.j - j * other.i + k * other.r,
+                       r * other.r - i * other.i - j * other.j - k * other.k);
+}
+
+XO_INL
+Quaterniond& XO_CC Quaterniond::operator *= (Quaterniond const& other) {
+    return *this = *this * other;
+}
+
+XO_INL
+Vector3d XO_CC Quaterniond::Rotate(Vector3d const& v) const {
+    Vector3d q(i, j, k);
+    Vector3d t = Vector3d::CrossProduct(q, v) * 2.0;
+    return v + t * r + Vector3d::CrossProduct(q, t);
+}
+
+XO_INL
+double Quaterniond::Magnitude() const {
+    return std::sqrt(MagnitudeSquared());
+}
+
+XO_INL
+double Quaterniond::MagnitudeSquared() const {
+    return Vector4d::DotProduct(vec4, vec4);
+}
+
+XO_INL
+Quaterniond Quaterniond::Normalized() const {
+    return Quaterniond(vec4 / Magnitude());
+}
+
+XO_INL
+Quaterniond& Quaterniond::Normalize() {
+    return *this = Normalized();
+}
+
+XO_INL
+Matrix4x4d Quaterniond::ToMatrix() const {
+    // The same matrix as Quaternion::ToMatrix.
+    double ii = i * i;
+    double ij = i * j;
+    double ik = i * k;
+    double ir = i * r;
+    double jj = j * j;
+    double jk = j * k;
+    double jr = j * r;
+    double kk = k * k;
+    double kr = k * r;
+    return Matrix4x4d(
+        Vector4d(1.0 - 2.0 * (jj + kk), 2.0 * (ij - kr), 2.0 * (ik + jr), 0.0),
+        Vector4d(2.0 * (ij + kr), 1.0 - 2.0 * (ii + kk), 2.0 * (jk - ir), 0.0),
+        Vector4d(2.0 * (ik - jr), 2.0 * (jk + ir), 1.0 - 2.0 * (ii + jj), 0.0),
+        Vector4d(0.0, 0.0, 0.0, 1.0));
+}
+
+XO_INL
+Quaternion Quaterniond::ToFloat() const {
+    return Quaternion(static_cast<float>(i), static_cast<float>(j),
+                      static_cast<float>(k), static_cast<float>(r));
+}
+
+/*static*/ XO_INL
+Quaterniond XO_CC Quaterniond::Invert(Quaterniond const& quat) {
+    return Quaterniond(-quat.i, -quat.j, -quat.k, quat.r);
+}
+
+/*static*/ XO_INL
+Quaterniond XO_CC Quaterniond::RotationAxisAngle(Vector3d const& axis, double angle) {
+    double s = std::sin(angle * 0.5), c = std::cos(angle * 0.5);
+    return Quaterniond(axis.v[0] * s, axis.v[1] * s, axis.v[2] * s, c);
+}
+
+/*static*/ XO_INL
+double XO_CC Quaterniond::DotProduct(Quaterniond const& left, Quaterniond const& right) {
+    return Vector4d::DotProduct(left.vec4, right.vec4);
+}
+
+/*static*/ XO_INL
+Quaterniond XO_CC Quaterniond::Lerp(Quaterniond const& start, Quaterniond const& end, double t) {
+    return Quaterniond(Vector4d::Lerp(start.vec4, end.vec4, t));
+}
+
+/*static*/ XO_INL
+Quaterniond XO_CC Quaterniond::Slerp(Quaterniond const& start, Quaterniond const& end, double t) {
+    Quaterniond s = start.Normalized();
+    Quaterniond e = end.Normalized();
+    double d = DotProduct(s, e);
+    if (d < 0.0) {
+        e = -e;
+        d = -d;
+    }
+
+    if (CloseEnough(d, 1.0)) {
+        return Lerp(s, e, t).Normalize();
+    }
+
+    double th0 = std::acos(d);
+    double th = th0 * t;
+    double sth0 = std::sin(th0);
+    double s0 = std::cos(th) - d * std::sin(th) / sth0;
+    double s1 = std::sin(th) / sth0;
+    return (s * s0) + (e * s1);
+}
+
+/*static*/ XO_INL
+bool XO_CC Quaterniond::RoughlyEqual(Quaterniond const& left, Quaterniond const& right) {
+    return left.vec4.RoughlyEqual(right.vec4);
+}
+
+/*static*/ XO_INL
+bool XO_CC Quaterniond::ExactlyEqual(Quaterniond const& left, Quaterniond const& right) {
+    return left.vec4.ExactlyEqual(right.vec4);
+}
+
+// Between float and double. ToFloat rounds each component to the nearest float.
+XO_INL Vector3d ToDouble(Vector3 const& v) { return Vector3d(v.x, v.y, v.z); }
+XO_INL Vector4d ToDouble(Vector4 const& v) { return Vector4d(v.x, v.y, v.z, v.w); }
+XO_INL Matrix4x4d ToDouble(Matrix4x4 const& m) { return Generic(m).Cast<double>(); }
+XO_INL Quaterniond ToDouble(Quaternion const& q) { return Quaterniond(q); }
+XO_INL Vector3 ToFloat(Vector3d const& v) { return ToVector3(v.Cast<float>()); }
+XO_INL Vector4 ToFloat(Vector4d const& v) { return ToVector4(v.Cast<float>()); }
+XO_INL Matrix4x4 ToFloat(Matrix4x4d const& m) { return ToMatrix4x4(m.Cast<float>()); }
+XO_INL Quaternion ToFloat(Quaterniond const& q) { return q.ToFloat(); }
+
+// position - origin as a float vector, subtracted in double first.
+XO_INL Vector3 RelativeTo(Vector3d const& position, Vector3d const& origin) {
+    return ToFloat(position - origin);
+}
+} // ::xo
+
+////////////////////////////////////////////////////////////////////////////////////////// end xo-math-double.h inline
+////////////////////////////////////////////////////////////////////////////////////////// xo-math-half.h inlined
+#line 6 "xo-math-half.h"
+namespace xo {
+//////////////////////////////////////////////////////////////////////////////////////////
+// IEEE half precision (fp16) storage for normals, tangents, velocities and anything else
+// where 11 bits of precision are enough and memory traffic isn't. There's no half math,
+// convert to Vector3 or Vector4, work in floats and convert back. Whole arrays convert
+// with batch::ToHalf and batch::FromHalf, 8 or 16 at a time with F16C.
+// Conversions round to nearest even like F16C does. Floats past 65504 become infinity and
+// ones under 2^-24 become zero, NaNs stay NaN.
+
+uint16_t FloatToHalf(float value);
+float HalfToFloat(uint16_t half);
+
+struct Half3 {
+    uint16_t x, y, z;
+
+    Half3() = default;
+    explicit Half3(Vector3 const& v);
+
+    Vector3 ToVector3() const;
+};
+
+struct Half4 {
+    uint16_t x, y, z, w;
+
+    Half4() = default;
+    explicit Half4(Vector4 const& v);
+
+    Vector4 ToVector4() const;
+};
+
+XO_INL
+uint16_t FloatToHalf(float value) {
+    // See: https://gist.github.com/rygorous/2156668
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint32_t const sign = (bits >> 16) & 0x8000u;
+    bits &= 0x7FFFFFFFu;
+    if (bits >= (143u << 23)) {
+        // 2^16 and up is infinity, NaNs keep the top of their payload and become quiet.
+        return static_cast<uint16_t>(sign | (bits > 0x7F800000u ? 0x7E00u | ((bits >> 13) & 0x3FFu) : 0x7C00u));
+    }
+    if (bits < (113u << 23)) {
+        // Under 2^-14 the half is subnormal: adding 0.5 lines the 10 bits it keeps up with
+        // the bottom of the float mantissa, and the add rounds them.
+        float const magic = 0.5f;
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        f += magic;
+        std::memcpy(&bits, &f, sizeof(bits));
+        return static_cast<uint16_t>(sign | (bits - (126u << 23)));
+    }
+    // Rebias the exponent and round the 13 dropped bits to nearest even. A carry out of
+    // the mantissa bumps the exponent, up to infinity past 65504.
+    bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xFFFu + ((bits >> 13) & 1u);
+    return static_cast<uint16_t>(sign | (bits >> 13));
+}
+
+XO_INL
+float HalfToFloat(uint16_t half) {
+    uint32_t bits = (half & 0x7FFFu) << 13;
+    uint32_t const exponent = bits & (0x7C00u << 13);
+    bits += static_cast<uint32_t>(127 - 15) << 23;
+    if (exponent == (0x7C00u << 13)) {
+        bits += static_cast<uint32_t>(128 - 16) << 23;   // infinity and NaN
+    }
+    else if (exponent == 0) {
+        // Subnormal or zero: make it 2^-14 + m * 2^-24 and take the 2^-14 off again.
+        bits += 1u << 23;
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        f -= 6.103515625e-05f;
+        std::memcpy(&bits, &f, sizeof(bits));
+    }
+    bits |= static_cast<uint32_t>(half & 0x8000u) << 16;
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+XO_INL
+Half3::Half3(Vector3 const& v)
+    : x(FloatToHalf(v.x))
+    , y(FloatToHalf(v.y))
+    , z(FloatToHalf(v.z))
+{ }
+
+XO_INL
+Vector3 Half3::ToVector3() const {
+    return Vector3(HalfToFloat(x), HalfToFloat(y), HalfToFloat(z));
+}
+
+XO_INL
+Half4::Half4(Vector4 const& v)
+    : x(FloatToHalf(v.x))
+    , y(FloatToHalf(v.y))
+    , z(FloatToHalf(v.z))
+    , w(FloatToHalf(v.w))
+{ }
+
+XO_INL
+Vector4 Half4::ToVector4() const {
+    return Vector4(HalfToFloat(x), HalfToFloat(y), HalfToFloat(z), HalfToFloat(w));
+}
+} // ::xo
+
+////////////////////////////////////////////////////////////////////////////////////////// end xo-math-half.h inline
+////////////////////////////////////////////////////////////////////////////////////////// xo-math-packed.h inlined
+#line 6 "xo-math-packed.h"
+#include <cmath>
+namespace xo {
+//////////////////////////////////////////////////////////////////////////////////////////
+// Quantized storage for rotations, for animation clips and network snapshots.
+//
+// PackedQuaternion32 and PackedQuaternion48 are "smallest three" encodings: the largest
+// magnitude component is dropped and rebuilt from the unit length, the other three are
+// in [-1/sqrt(2), 1/sqrt(2)] and quantized to 10 bits (32 bit form) or 15 bits (48 bit
+// form). q and -q are the same rotation, so the sign goes by making the dropped component
+// positive. A kept component is at most half a step off, the rebuilt one collects the
+// error of the other three: worst about 1.8e-3 for 32 bits and 5.4e-5 for 48, under 0.25
+// and 0.008 degrees of rotation.
+// Quaternions should be normalized before packing. Arrays pack and unpack with
+// batch::Pack and batch::Unpack, 8 or 16 at a time with AVX2 or AVX512. Packing gives the
+// same bits on every path, unpacking can differ in the last bit of a float.
+//
+// PackedNormal32 and PackedNormal16 are octahedral encodings of unit vectors: the vector
+// is projected onto the octahedron |x| + |y| + |z| = 1, the lower half is folded over the
+// upper one, and the resulting point in [-1, 1]^2 is quantized to 16 or 8 bits per axis.
+// Both axes have an odd number of steps so 0 is exact and so are the 6 axis directions.
+// The worst angle error is about 0.004 degrees for 32 bits and 0.95 degrees for 16. Any
+// nonzero length packs, unpacking gives unit vectors. batch::Pack and batch::Unpack do
+// arrays 8 or 16 at a time with AVX2 or AVX512, with the same guarantees as above.
+
+struct PackedQuaternion32 {
+    // The dropped component's index in bits 30-31, the others in order in bits 20-29,
+    // 10-19 and 0-9.
+    uint32_t bits;
+
+    PackedQuaternion32() = default;
+    explicit PackedQuaternion32(Quaternion const& q);
+
+    Quaternion ToQuaternion() const;
+};
+
+struct PackedQuaternion48 {
+    // One word per kept component, 15 bits each. The top bit of words 0 and 1 is the
+    // dropped component's index, the top bit of word 2 is 0.
+    uint16_t words[3];
+
+    PackedQuaternion48() = default;
+    explicit PackedQuaternion48(Quaternion const& q);
+
+    Quaternion ToQuaternion() const;
+};
+
+struct PackedNormal32 {
+    uint16_t x, y;
+
+    PackedNormal32() = default;
+    explicit PackedNormal32(Vector3 const& normal);
+
+    Vector3 ToVector3() const;
+};
+
+struct PackedNormal16 {
+    uint8_t x, y;
+
+    PackedNormal16() = default;
+    explicit PackedNormal16(Vector3 const& normal);
+
+    Vector3 ToVector3() const;
+};
+
+namespace smallest3 {
+constexpr float Bound = 0.707106781f;
+
+// Quantization of a kept component to Bits bits: value = round((c + Bound) * Scale) and
+// back c = (value - Middle) * Step. Written so neither side can be fused into an FMA,
+// which keeps the scalar and SIMD encoders bit identical.
+template<int Bits>
+struct Format {
+    static constexpr uint32_t Max = (1u << Bits) - 1u;
+    static constexpr float Scale = float(Max) * Bound;
+    static constexpr float Middle = float(Max) * 0.5f;
+    static constexpr float Step = 2.f * Bound / float(Max);
+};
+
+// The index of the largest magnitude component of q (the first one on a tie), with the
+// other three in 'kept', negated when the largest is negative.
+XO_INL int Split(Quaternion const& q, float kept[3]) {
+    float const c[4] = { q.i, q.j, q.k, q.r };
+    int m = 0;
+    for (int k = 1; k < 4; ++k) {
+        if (Abs(c[k]) > Abs(c[m])) m = k;
+    }
+    float const sign = c[m] < 0.f ? -1.f : 1.f;
+    for (int k = 0, n = 0; k < 4; ++k) {
+        if (k != m) kept[n++] = c[k] * sign;
+    }
+    return m;
+}
+
+template<int Bits>
+XO_INL uint32_t Quantize(float c) {
+    long const v = std::lrint((c + Bound) * Format<Bits>::Scale);
+    return static_cast<uint32_t>(Min(xo::Max(v, 0L), static_cast<long>(Format<Bits>::Max)));
+}
+
+template<int Bits>
+XO_INL float Dequantize(uint32_t value) {
+    return (static_cast<float>(value) - Format<Bits>::Middle) * Format<Bits>::Step;
+}
+
+// The unit quaternion with component m rebuilt from a, b and c, the kept components.
+XO_INL Quaternion Join(int m, float a, float b, float c) {
+    float const d = std::sqrt(xo::Max(0.f, 1.f - a * a - b * b - c * c));
+    switch (m) {
+    case 0: return Quaternion(d, a, b, c);
+    case 1: return Quaternion(a, d, b, c);
+    case 2: return Quaternion(a, b, d, c);
+    default: return Quaternion(a, b, c, d);
+    }
+}
+} // ::xo::smallest3
+
+namespace octahedral {
+// Quantization of an octahedral coordinate in [-1, 1] to Bits bits: value =
+// round((p + 1) * Scale) and back p = (value - Middle) * Step, unfusable like smallest3.
+template<int Bits>
+struct Format {
+    static constexpr uint32_t Max = (1u << Bits) - 2u;
+    static constexpr float Scale = float(Max) * 0.5f;
+    static constexpr float Middle = float(Max) * 0.5f;
+    static constexpr float Step = 2.f / float(Max);
+};
+
+// The octahedral coordinates of v.
+XO_INL void Project(Vector3 const& v, float& px, float& py) {
+    float const sum = Abs(v.x) + Abs(v.y) + Abs(v.z);
+    px = v.x / sum;
+    py = v.y / sum;
+    if (v.z < 0.f) {
+        float const fx = (1.f - Abs(py)) * (px < 0.f ? -1.f : 1.f);
+        float const fy = (1.f - Abs(px)) * (py < 0.f ? -1.f : 1.f);
+        px = fx;
+        py = fy;
+    }
+}
+
+template<int Bits>
+XO_INL uint32_t Quantize(float p) {
+    long const v = std::lrint((p + 1.f) * Format<Bits>::Scale);
+    return static_cast<uint32_t>(Min(xo::Max(v, 0L), static_cast<long>(Format<Bits>::Max)));
+}
+
+template<int Bits>
+XO_INL float Dequantize(uint32_t value) {
+    return (static_cast<float>(value) - Format<Bits>::Middle) * Format<Bits>::Step;
+}
+
+// The unit vector at octahedral coordinates (px, py).
+XO_INL Vector3 Unproject(float px, float py) {
+    float const z = 1.f - Abs(px) - Abs(py);
+    float const t = xo::Max(-z, 0.f);
+    px += px < 0.f ? t : -t;
+    py += py < 0.f ? t : -t;
+    float const length = std::sqrt(px * px + py * py + z * z);
+    return Vector3(px / length, py / length, z / length);
+}
+} // ::xo::octahedral
+
+XO_INL
+PackedQuaternion32::PackedQuaternion32(Quaternion const& q) {
+    float kept[3];
+    uint32_t const m = static_cast<uint32_t>(smallest3::Split(q, kept));
+    bits = (m << 30)
+         | (smallest3::Quantize<10>(kept[0]) << 20)
+         | (smallest3::Quantize<10>(kept[1]) << 10)
+         | smallest3::Quantize<10>(kept[2]);
+}
+
+XO_INL
+Quaternion PackedQuaternion32::ToQuaternion() const {
+    return smallest3::Join(static_cast<int>(bits >> 30),
+                           smallest3::Dequantize<10>((bits >> 20) & 0x3FFu),
+                           smallest3::Dequantize<10>((bits >> 10) & 0x3FFu),
+                           smallest3::Dequantize<10>(bits & 0x3FFu));
+}
+
+XO_INL
+PackedQuaternion48::PackedQuaternion48(Quaternion const& q) {
+    float kept[3];
+    uint32_t const m = static_cast<uint32_t>(smallest3::Split(q, kept));
+    words[0] = static_cast<uint16_t>(smallest3::Quantize<15>(kept[0]) | ((m & 1u) << 15));
+    words[1] = static_cast<uint16_t>(smallest3::Quantize<15>(kept[1]) | ((m >> 1) << 15));
+    words[2] = static_cast<uint16_t>(smallest3::Quantize<15>(kept[2]));
+}
+
+XO_INL
+Quaternion PackedQuaternion48::ToQuaternion() const {
+    return smallest3::Join((words[0] >> 15) | ((words[1] >> 15) << 1),
+                           smallest3::Dequantize<15>(words[0] & 0x7FFFu),
+                           smallest3::Dequantize<15>(words[1] & 0x7FFFu),
+                           smallest3::Dequantize<15>(words[2] & 0x7FFFu));
+}
+
+XO_INL
+PackedNormal32::PackedNormal32(Vector3 const& normal) {
+    float px, py;
+    octahedral::Project(normal, px, py);
+    x = static_cast<uint16_t>(octahedral::Quantize<16>(px));
+    y = static_cast<uint16_t>(octahedral::Quantize<16>(py));
+}
+
+XO_INL
+Vector3 PackedNormal32::ToVector3() const {
+    return octahedral::Unproject(octahedral::Dequantize<16>(x), octahedral::Dequantize<16>(y));
+}
+
+XO_INL
+PackedNormal16::PackedNormal16(Vector3 const& normal) {
+    float px, py;
+    octahedral::Project(normal, px, py);
+    x = static_cast<uint8_t>(octahedral::Quantize<8>(px));
+    y = static_cast<uint8_t>(octahedral::Quantize<8>(py));
+}
+
+XO_INL
+Vector3 PackedNormal16::ToVector3() const {
+    return octahedral::Unproject(octahedral::Dequantize<8>(x), octahedral::Dequantize<8>(y));
+}
+} // ::xo
+
+////////////////////////////////////////////////////////////////////////////////////////// end xo-math-packed.h inline
+////////////////////////////////////////////////////////////////////////////////////////// xo-math-memory.h inlined
+#line 5 "xo-math-memory.h"
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <vector>
+namespace xo {
+//////////////////////////////////////////////////////////////////////////////////////////
+// Containers of the A types. std::allocator only has to honor alignof(max_align_t) before
+// C++17, so a std::vector<AVector4> or std::vector<AMatrix4x4> can hand out elements the
+// aligned loads fault on. AlignedVector is std::vector with an allocator that goes through
+// AlignedMalloc, at alignof(T) or more when asked for, say 64 to keep a run of matrices on
+// cache lines.
+//
+//     AlignedVector<AMatrix4x4> transforms(count);
+//     AlignedVector<Vector4, 64> particles;
+//
+// AlignedAllocator works with any other standard container too.
+//
+// For per frame scratch, like the skinning matrices or culling bounds a batch job needs
+// for one update, FrameArena hands out aligned runs of memory by bumping a pointer and
+// takes them all back with Reset. Pool<T> is the same for single objects freed one by one.
+// Neither is thread safe, each thread has its own with ThreadLocal(). Once warmed up they
+// go back to the heap only when a frame needs more than any frame before it.
+//
+//     FrameArena& arena = FrameArena::ThreadLocal();
+//     Matrix4x4* palette = arena.Allocate<Matrix4x4>(boneCount, 64);
+//     ...
+//     arena.Reset();   // at the end of the frame, palette is gone
+
+template<typename T, size_t Align = alignof(T)>
+class AlignedAllocator {
+public:
+    static_assert((Align & (Align - 1)) == 0, "xo::AlignedAllocator alignment must be a power of two");
+    static constexpr size_t Alignment = Align > alignof(T) ? Align : alignof(T);
+
+    typedef T value_type;
+    template<typename U> struct rebind { typedef AlignedAllocator<U, Align> other; };
+
+    AlignedAllocator() noexcept = default;
+    template<typename U>
+    AlignedAllocator(AlignedAllocator<U, Align> const&) noexcept { }
+
+    T* allocate(size_t count) {
+        if (count > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_alloc();
+        return static_cast<T*>(AlignedNew(count * sizeof(T), Alignment));
+    }
+
+    void deallocate(T* memory, size_t) noexcept {
+        AlignedFree(memory);
+    }
+};
+
+// Stateless, so any two of the same alignment can free each other's memory.
+template<typename T, typename U, size_t Align>
+XO_INL bool operator == (AlignedAllocator<T, Align> const&, AlignedAllocator<U, Align> const&) { return true; }
+template<typename T, typename U, size_t Align>
+XO_INL bool operator != (AlignedAllocator<T, Align> const&, AlignedAllocator<U, Align> const&) { return false; }
+
+template<typename T, size_t Align = alignof(T)>
+using AlignedVector = std::vector<T, AlignedAllocator<T, Align>>;
+
+class FrameArena {
+public:
+    static constexpr size_t DefaultBlockSize = 64 * 1024;
+
+    explicit FrameArena(size_t blockSize = DefaultBlockSize);
+    ~FrameArena();
+    FrameArena(FrameArena const&) = delete;
+    FrameArena& operator = (FrameArena const&) = delete;
+
+    // 'size' bytes aligned to 'alignment', a power of two. Never returns nullptr, throws
+    // std::bad_alloc when a new block can't be had.
+    void* Allocate(size_t size, size_t alignment = 16);
+
+    // 'count' default constructed Ts. Reset doesn't run destructors, so T has to be
+    // trivially destructible like the math types.
+    template<typename T>
+    T* Allocate(size_t count, size_t alignment = alignof(T));
+
+    // Takes back everything allocated, in O(1). The blocks are kept for reuse.
+    void Reset();
+
+    // This thread's arena.
+    static FrameArena& ThreadLocal();
+
+private:
+    struct Block {
+        Block* next;
+        size_t size;
+    };
+
+    // Block headers take a whole cache line so block data starts 64 byte aligned.
+    static constexpr size_t HeaderSize = 64;
+
+    void* AllocateSlow(size_t size, size_t alignment);
+
+    size_t blockSize;
+    Block* first;
+    Block* current;
+    size_t offset;
+};
+
+// Fixed size slots for one T. Free slots go on a list threaded through them, new ones
+// come out of a FrameArena, so Reset is O(1) here too.
+template<typename T, size_t Align = alignof(T)>
+class Pool {
+public:
+    static_assert(std::is_trivially_destructible<T>::value, "xo::Pool is for trivially destructible types");
+    static_assert((Align & (Align - 1)) == 0, "xo::Pool alignment must be a power of two");
+    static constexpr size_t Alignment = Align > alignof(T) ? Align : alignof(T);
+
+    explicit Pool(size_t slotsPerBlock = 256);
+
+    // A default constructed T.
+    T* Allocate();
+    void Free(T* item);
+    // Takes back every slot, freed or not.
+    void Reset();
+
+    static Pool& ThreadLocal();
+
+private:
+    struct Slot { Slot* next; };
+    static constexpr size_t SlotSize = ((sizeof(T) > sizeof(Slot) ? sizeof(T) : sizeof(Slot)) + Alignment - 1) & ~(Alignment - 1);
+
+    FrameArena arena;
+    Slot* freeSlots;
+};
+
+XO_INL
+FrameArena::FrameArena(size_t blockSize)
+    : blockSize(blockSize)
+    , first(nullptr)
+    , current(nullptr)
+    , offset(0)
+{ }
+
+inline
+FrameArena::~FrameArena() {
+    while (first) {
+        Block* next = first->next;
+        AlignedFree(first);
+        first = next;
+    }
+}
+
+XO_INL
+void* FrameArena::Allocate(size_t size, size_t alignment) {
+    if (current) {
+        uintptr_t const base = reinterpret_cast<uintptr_t>(current) + HeaderSize;
+        uintptr_t const at = (base + offset + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        if (at + size <= base + current->size) {
+            offset = at + size - base;
+            return reinterpret_cast<void*>(at);
+        }
+    }
+    return AllocateSlow(size, alignment);
+}
+
+template<typename T>
+XO_INL T* FrameArena::Allocate(size_t count, size_t alignment) {
+    static_assert(std::is_trivially_destructible<T>::value, "xo::FrameArena is for trivially destructible types");
+    if (count > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_alloc();
+    T* items = static_cast<T*>(Allocate(count * sizeof(T), alignment > alignof(T) ? alignment : alignof(T)));
+    for (size_t i = 0; i < count; ++i) {
+        ::new (static_cast<void*>(items + i)) T;
+    }
+    return items;
+}
+
+XO_INL
+void FrameArena::Reset() {
+    current = first;
+    offset = 0;
+}
+
+/*static*/ inline
+FrameArena& FrameArena::ThreadLocal() {
+    static thread_local FrameArena arena;
+    return arena;
+}
+
+inline
+void* FrameArena::AllocateSlow(size_t size, size_t alignment) {
+    // The next block kept from an earlier frame, if there is one and it's big enough.
+    Block* next = current ? current->next : first;
+    if (next && size + alignment <= next->size) {
+        current = next;
+        offset = 0;
+        return Allocate(size, alignment);
+    }
+    // Otherwise a new one goes in after current, sized for 'size' if it's a big one.
+    if (size > std::numeric_limits<size_t>::max() - HeaderSize - alignment) throw std::bad_alloc();
+    size_t const blockBytes = size + alignment > blockSize ? size + alignment : blockSize;
+    Block* block = static_cast<Block*>(AlignedNew(HeaderSize + blockBytes, HeaderSize));
+    block->size = blockBytes;
+    block->next = next;
+    (current ? current->next : first) = block;
+    current = block;
+    offset = 0;
+    return Allocate(size, alignment);
+}
+
+template<typename T, size_t Align>
+XO_INL Pool<T, Align>::Pool(size_t slotsPerBlock)
+    : arena(slotsPerBlock * SlotSize)
+    , freeSlots(nullptr)
+{ }
+
+template<typename T, size_t Align>
+XO_INL T* Pool<T, Align>::Allocate() {
+    void* memory;
+    if (freeSlots) {
+        memory = freeSlots;
+        freeSlots = freeSlots->next;
+    }
+    else {
+        memory = arena.Allocate(SlotSize, Alignment);
+    }
+    return ::new (memory) T;
+}
+
+template<typename T, size_t Align>
+XO_INL void Pool<T, Align>::Free(T* item) {
+    Slot* slot = ::new (static_cast<void*>(item)) Slot;
+    slot->next = freeSlots;
+    freeSlots = slot;
+}
+
+template<typename T, size_t Align>
+XO_INL void Pool<T, Align>::Reset() {
+    arena.Reset();
+    freeSlots = nullptr;
+}
+
+template<typename T, size_t Align>
+/*static*/ inline Pool<T, Align>& Pool<T, Align>::ThreadLocal() {
+    static thread_local Pool pool;
+    return pool;
+}
+} // ::xo
+
+////////////////////////////////////////////////////////////////////////////////////////// end xo-math-memory.h inline
+////////////////////////////////////////////////////////////////////////////////////////// xo-math-wide.h inlined
+#line 7 "xo-math-wide.h"
+#if XO_SSE_CURRENT >= XO_AVX || XO_HAS_FMA
+#   include <immintrin.h>
+#elif XO_HAS_SSE
+#   include <xmmintrin.h>
+#endif
+
+namespace xo {
+// Structure of arrays types. Where a Vector3 is one vector, a Vector3xN<N> is N vectors
+// with each component held in a FloatN<N>: N floats worked on as one value. Every function
+// does the same thing as its Vector3 counterpart to all N lanes at once, so dot products,
+// cross products and normalization don't waste lanes or need horizontal sums.
+// Move data in and out with Gather/Scatter, or keep it in this form between frames.
+//
+// FloatN<4> is an __m128 with SSE, FloatN<8> an __m256 with AVX and FloatN<16> an __m512
+// with AVX512. Any other N (or a build without them) is a plain array the compiler can
+// vectorize. Pick the N that matches the widest register the build targets.
+
+// One Newton-Raphson step on an estimate r of 1/sqrt(a). r * r would overflow for the
+// smallest a, so the product goes (0.5 * a * r) * r.
+template<typename F>
+XO_INL F RefineInverseSqrt(F const& a, F const& r) {
+    return r * (F(1.5f) - (F(0.5f) * a * r) * r);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+template<int N>
+struct FloatN {
+    float v[N];
+
+    FloatN() = default;
+    explicit FloatN(float all) { for (int i = 0; i < N; ++i) v[i] = all; }
+
+    static FloatN XO_CC Load(float const* in) { FloatN r; for (int i = 0; i < N; ++i) r.v[i] = in[i]; return r; }
+    void XO_CC Store(float* out) const { for (int i = 0; i < N; ++i) out[i] = v[i]; }
+
+    FloatN XO_CC operator + (FloatN const& o) const { FloatN r; for (int i = 0; i < N; ++i) r.v[i] = v[i] + o.v[i]; return r; }
+    FloatN XO_CC operator - (FloatN const& o) const { FloatN r; for (int i = 0; i < N; ++i) r.v[i] = v[i] - o.v[i]; return r; }
+    FloatN XO_CC operator * (FloatN const& o) const { FloatN r; for (int i = 0; i < N; ++i) r.v[i] = v[i] * o.v[i]; return r; }
+    FloatN XO_CC operator / (FloatN const& o) const { FloatN r; for (int i = 0; i < N; ++i) r.v[i] = v[i] / o.v[i]; return r; }
+    FloatN operator -() const { FloatN r; for (int i = 0; i < N; ++i) r.v[i] = -v[i]; return r; }
+
+    static FloatN XO_CC Sqrt(FloatN const& a) { FloatN r; for (int i = 0; i < N; ++i) r.v[i] = xo::Sqrt(a.v[i]); return r; }
+    static FloatN XO_CC InverseSqrt(FloatN const& a, Precision precision) {
+        FloatN r; for (int i = 0; i < N; ++i) r.v[i] = xo::InverseSqrt(a.v[i], precision); return r;
+    }
+    static FloatN XO_CC Abs(FloatN const& a) { FloatN r; for (int i = 0; i < N; ++i) r.v[i] = xo::Abs(a.v[i]); return r; }
+    static FloatN XO_CC Max(FloatN const& a, FloatN const& b) { FloatN r; for (int i = 0; i < N; ++i) r.v[i] = xo::Max(a.v[i], b.v[i]); return r; }
+    // a * b + c
+    static FloatN XO_CC MultiplyAdd(FloatN const& a, FloatN const& b, FloatN const& c) { return a * b + c; }
+
+    static bool XO_CC AllLessEqual(FloatN const& a, FloatN const& b) {
+        for (int i = 0; i < N; ++i) if (!(a.v[i] <= b.v[i])) return false;
+        return true;
+    }
+    static bool XO_CC AllEqual(FloatN const& a, FloatN const& b) {
+        for (int i = 0; i < N; ++i) if (!(a.v[i] == b.v[i])) return false;
+        return true;
+    }
+};
+
+#if XO_HAS_SSE
+template<>
+struct FloatN<4> {
+    __m128 m;
+
+    FloatN() = default;
+    explicit FloatN(float all) : m(_mm_set1_ps(all)) { }
+    explicit FloatN(__m128 m) : m(m) { }
+
+    static FloatN XO_CC Load(float const* in) { return FloatN(_mm_loadu_ps(in)); }
+    void XO_CC Store(float* out) const { _mm_storeu_ps(out, m); }
+
+    FloatN XO_CC operator + (FloatN const& o) const { return FloatN(_mm_add_ps(m, o.m)); }
+    FloatN XO_CC operator - (FloatN const& o) const { return FloatN(_mm_sub_ps(m, o.m)); }
+    FloatN XO_CC operator * (FloatN const& o) const { return FloatN(_mm_mul_ps(m, o.m)); }
+    FloatN XO_CC operator / (FloatN const& o) const { return FloatN(_mm_div_ps(m, o.m)); }
+    FloatN operator -() const { return FloatN(_mm_xor_ps(m, _mm_set1_ps(-0.f))); }
+
+    static FloatN XO_CC Sqrt(FloatN const& a) { return FloatN(_mm_sqrt_ps(a.m)); }
+    static FloatN XO_CC InverseSqrt(FloatN const& a, Precision precision) {
+        if (precision == Precision::Exact) return FloatN(1.f) / Sqrt(a);
+        // Denormals scaled into range, see xo::rsqrt. No blendv before SSE4.1.
+        __m128 const tiny = _mm_cmplt_ps(a.m, _mm_set1_ps(rsqrt::Tiny));
+        FloatN const up(_mm_or_ps(_mm_andnot_ps(tiny, a.m), _mm_and_ps(tiny, _mm_mul_ps(a.m, _mm_set1_ps(rsqrt::ScaleUp)))));
+        FloatN const scale(_mm_or_ps(_mm_andnot_ps(tiny, _mm_set1_ps(1.f)), _mm_and_ps(tiny, _mm_set1_ps(rsqrt::ScaleBack))));
+        FloatN r(_mm_rsqrt_ps(up.m));
+        return (precision == Precision::Fastest ? r : RefineInverseSqrt(up, r)) * scale;
+    }
+    static FloatN XO_CC Abs(FloatN const& a) { return FloatN(_mm_andnot_ps(_mm_set1_ps(-0.f), a.m)); }
+    static FloatN XO_CC Max(FloatN const& a, FloatN const& b) { return FloatN(_mm_max_ps(a.m, b.m)); }
+    static FloatN XO_CC MultiplyAdd(FloatN const& a, FloatN const& b, FloatN const& c) {
+#   if XO_HAS_FMA
+        return FloatN(_mm_fmadd_ps(a.m, b.m, c.m));
+#   else
+        return a * b + c;
+#   endif
+    }
+
+    static bool XO_CC AllLessEqual(FloatN const& a, FloatN const& b) { return _mm_movemask_ps(_mm_cmple_ps(a.m, b.m)) == 0xF; }
+    static bool XO_CC AllEqual(FloatN const& a, FloatN const& b) { return _mm_movemask_ps(_mm_cmpeq_ps(a.m, b.m)) == 0xF; }
+};
+#endif
+
+#if XO_SSE_CURRENT >= XO_AVX || XO_HAS_FMA
+template<>
+struct FloatN<8> {
+    __m256 m;
+
+    FloatN() = default;
+    explicit FloatN(float all) : m(_mm256_set1_ps(all)) { }
+    explicit FloatN(__m256 m) : m(m) { }
+
+    static FloatN XO_CC Load(float const* in) { return FloatN(_mm256_loadu_ps(in)); }
+    void XO_CC Store(float* out) const { _mm256_storeu_ps(out, m); }
+
+    FloatN XO_CC operator + (FloatN const& o) const { return FloatN(_mm256_add_ps(m, o.m)); }
+    FloatN XO_CC operator - (FloatN const& o) const { return FloatN(_mm256_sub_ps(m, o.m)); }
+    FloatN XO_CC operator * (FloatN const& o) const { return FloatN(_mm256_mul_ps(m, o.m)); }
+    FloatN XO_CC operator / (FloatN const& o) const { return FloatN(_mm256_div_ps(m, o.m)); }
+    FloatN operator -() const { return FloatN(_mm256_xor_ps(m, _mm256_set1_ps(-0.f))); }
+
+    static FloatN XO_CC Sqrt(FloatN const& a) { return FloatN(_mm256_sqrt_ps(a.m)); }
+    static FloatN XO_CC InverseSqrt(FloatN const& a, Precision precision) {
+        if (precision == Precision::Exact) return FloatN(1.f) / Sqrt(a);
+        // Denormals scaled into range, see xo::rsqrt.
+        __m256 const tiny = _mm256_cmp_ps(a.m, _mm256_set1_ps(rsqrt::Tiny), _CMP_LT_OQ);
+        FloatN const up(_mm256_blendv_ps(a.m, _mm256_mul_ps(a.m, _mm256_set1_ps(rsqrt::ScaleUp)), tiny));
+        FloatN const scale(_mm256_blendv_ps(_mm256_set1_ps(1.f), _mm256_set1_ps(rsqrt::ScaleBack), tiny));
+        FloatN r(_mm256_rsqrt_ps(up.m));
+        return (precision == Precision::Fastest ? r : RefineInverseSqrt(up, r)) * scale;
+    }
+    static FloatN XO_CC Abs(FloatN const& a) { return FloatN(_mm256_andnot_ps(_mm256_set1_ps(-0.f), a.m)); }
+    static FloatN XO_CC Max(FloatN const& a, FloatN const& b) { return FloatN(_mm256_max_ps(a.m, b.m)); }
+    static FloatN XO_CC MultiplyAdd(FloatN const& a, FloatN const& b, FloatN const& c) {
+#   if XO_HAS_FMA
+        return FloatN(_mm256_fmadd_ps(a.m, b.m, c.m));
+#   else
+        return a * b + c;
+#   endif
+    }
+
+    static bool XO_CC AllLessEqual(FloatN const& a, FloatN const& b) {
+        return _mm256_movemask_ps(_mm256_cmp_ps(a.m, b.m, _CMP_LE_OQ)) == 0xFF;
+    }
+    static bool XO_CC AllEqual(FloatN const& a, FloatN const& b) {
+        return _mm256_movemask_ps(_mm256_cmp_ps(a.m, b.m, _CMP_EQ_OQ)) == 0xFF;
+    }
+};
+#endif
+
+#if XO_SSE_CURRENT >= XO_AVX512
+template<>
+struct FloatN<16> {
+    __m512 m;
+
+    FloatN() = default;
+    explicit FloatN(float all) : m(_mm512_set1_ps(all)) { }
+    explicit FloatN(__m512 m) : m(m) { }
+
+    static FloatN XO_CC Load(float const* in) { return FloatN(_mm512_loadu_ps(in)); }
+    void XO_CC Store(float* out) const { _mm512_storeu_ps(out, m); }
+
+    FloatN XO_CC operator + (FloatN const& o) const { return FloatN(_mm512_add_ps(m, o.m)); }
+    FloatN XO_CC operator - (FloatN const& o) const { return FloatN(_mm512_sub_ps(m, o.m)); }
+    FloatN XO_CC operator * (FloatN const& o) const { return FloatN(_mm512_mul_ps(m, o.m)); }
+    FloatN XO_CC operator / (FloatN const& o) const { return FloatN(_mm512_div_ps(m, o.m)); }
+    FloatN operator -() const { return FloatN(_mm512_sub_ps(_mm512_setzero_ps(), m)); }
+
+    // The maskz forms with every lane set are the same instructions. The plain intrinsics
+    // pass _mm512_undefined_ps() through, which gcc flags with -Wmaybe-uninitialized.
+    static FloatN XO_CC Sqrt(FloatN const& a) { return FloatN(_mm512_maskz_sqrt_ps(0xFFFF, a.m)); }
+    // rsqrt14 is good to 2^-14, so Fastest here is a little better than on 4 or 8 lanes
+    static FloatN XO_CC InverseSqrt(FloatN const& a, Precision precision) {
+        if (precision == Precision::Exact) return FloatN(1.f) / Sqrt(a);
+        FloatN r(_mm512_maskz_rsqrt14_ps(0xFFFF, a.m));
+        return precision == Precision::Fastest ? r : RefineInverseSqrt(a, r);
+    }
+    static FloatN XO_CC Abs(FloatN const& a) { return FloatN(_mm512_abs_ps(a.m)); }
+    static FloatN XO_CC Max(FloatN const& a, FloatN const& b) { return FloatN(_mm512_max_ps(a.m, b.m)); }
+    static FloatN XO_CC MultiplyAdd(FloatN const& a, FloatN const& b, FloatN const& c) {
+        return FloatN(_mm512_fmadd_ps(a.m, b.m, c.m));
+    }
+
+    static bool XO_CC AllLessEqual(FloatN const& a, FloatN const& b) {
+        return _mm512_cmp_ps_mask(a.m, b.m, _CMP_LE_OQ) == 0xFFFF;
+    }
+    static bool XO_CC AllEqual(FloatN const& a, FloatN const& b) {
+        return _mm512_cmp_ps_mask(a.m, b.m, _CMP_EQ_OQ) == 0xFFFF;
+    }
+};
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////////
+template<int N>
+struct Vector3xN {
+    typedef FloatN<N> Lanes;
+    static constexpr int Width = N;
+
+    Lanes x, y, z;
+
+    Vector3xN(Lanes const& x, Lanes const& y, Lanes const& z)
+        : x(x)
+        , y(y)
+        , z(z)
+    { }
+
+    explicit Vector3xN(float all)
+        : x(all)
+        , y(all)
+        , z(all)
+    { }
+
+    // The same vector in every lane.
+    explicit Vector3xN(Vector3 const& v)
+        : x(v.x)
+        , y(v.y)
+        , z(v.z)
+    { }
+
+    Vector3xN() = default;
+
+    // Reads N vectors. The count versions read min(count, N) and zero the remaining lanes,
+    // or write only the first min(count, N) lanes.
+    static Vector3xN XO_CC Gather(Vector3 const* in);
+    static Vector3xN XO_CC Gather(Vector3 const* in, size_t count);
+    void XO_CC Scatter(Vector3* out) const;
+    void XO_CC Scatter(Vector3* out, size_t count) const;
+
+    Vector3 XO_CC Get(int lane) const;
+
+    Vector3xN XO_CC operator + (Vector3xN const& other) const;
+    Vector3xN XO_CC operator - (Vector3xN const& other) const;
+    Vector3xN XO_CC operator * (Vector3xN const& other) const;
+    Vector3xN XO_CC operator / (Vector3xN const& other) const;
+    Vector3xN& XO_CC operator += (Vector3xN const& other) { return *this = *this + other; }
+    Vector3xN& XO_CC operator -= (Vector3xN const& other) { return *this = *this - other; }
+    Vector3xN& XO_CC operator *= (Vector3xN const& other) { return *this = *this * other; }
+    Vector3xN& XO_CC operator /= (Vector3xN const& other) { return *this = *this / other; }
+
+    Vector3xN XO_CC operator * (Lanes const& value) const { return Vector3xN(x * value, y * value, z * value); }
+    Vector3xN XO_CC operator / (Lanes const& value) const { return Vector3xN(x / value, y / value, z / value); }
+
+    Vector3xN XO_CC operator + (float value) const { return *this + Vector3xN(value); }
+    Vector3xN XO_CC operator - (float value) const { return *this - Vector3xN(value); }
+    Vector3xN XO_CC operator * (float value) const { return *this * Vector3xN(value); }
+    Vector3xN XO_CC operator / (float value) const { return *this / Vector3xN(value); }
+    Vector3xN& XO_CC operator += (float value) { return *this += Vector3xN(value); }
+    Vector3xN& XO_CC operator -= (float value) { return *this -= Vector3xN(value); }
+    Vector3xN& XO_CC operator *= (float value) { return *this *= Vector3xN(value); }
+    Vector3xN& XO_CC operator /= (float value) { return *this /= Vector3xN(value); }
+
+    Vector3xN operator -() const { return Vector3xN(-x, -y, -z); }
+
+    Lanes Sum() const;
+
+    Lanes Magnitude() const;
+    Lanes MagnitudeSquared() const;
+
+    Vector3xN& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+    Vector3xN Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+
+    // true when every lane is equal
+    static bool XO_CC RoughlyEqual(Vector3xN const& left, Vector3xN const& right);
+    static bool XO_CC ExactlyEqual(Vector3xN const& left, Vector3xN const& right);
+    static bool XO_CC RoughlyEqual(Vector3xN const& left, float magnitude);
+    static bool XO_CC ExactlyEqual(Vector3xN const& left, float magnitude);
+
+    static Lanes XO_CC DotProduct(Vector3xN const& left, Vector3xN const& right);
+    static Vector3xN XO_CC CrossProduct(Vector3xN const& left, Vector3xN const& right);
+    static Vector3xN XO_CC Lerp(Vector3xN const& left, Vector3xN const& right, float t);
+    static Vector3xN XO_CC Lerp(Vector3xN const& left, Vector3xN const& right, Lanes const& t);
+    static Lanes XO_CC DistanceSquared(Vector3xN const& left, Vector3xN const& right);
+    static Lanes XO_CC Distance(Vector3xN const& left, Vector3xN const& right);
+
+    static const Vector3xN Zero;
+    static const Vector3xN One;
+    static const Vector3xN Up;
+    static const Vector3xN Down;
+    static const Vector3xN Left;
+    static const Vector3xN Right;
+    static const Vector3xN Forward;
+    static const Vector3xN Backward;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+template<int N>
+struct Vector4xN {
+    typedef FloatN<N> Lanes;
+    static constexpr int Width = N;
+
+    Lanes x, y, z, w;
+
+    Vector4xN(Lanes const& x, Lanes const& y, Lanes const& z, Lanes const& w)
+        : x(x)
+        , y(y)
+        , z(z)
+        , w(w)
+    { }
+
+    explicit Vector4xN(float all)
+        : x(all)
+        , y(all)
+        , z(all)
+        , w(all)
+    { }
+
+    // The same vector in every lane.
+    explicit Vector4xN(Vector4 const& v)
+        : x(v.x)
+        , y(v.y)
+        , z(v.z)
+        , w(v.w)
+    { }
+
+    explicit Vector4xN(Vector3xN<N> const& v3, float w = 0.f)
+        : x(v3.x)
+        , y(v3.y)
+        , z(v3.z)
+        , w(w)
+    { }
+
+    Vector4xN() = default;
+
+    // See Vector3xN::Gather
+    static Vector4xN XO_CC Gather(Vector4 const* in);
+    static Vector4xN XO_CC Gather(Vector4 const* in, size_t count);
+    void XO_CC Scatter(Vector4* out) const;
+    void XO_CC Scatter(Vector4* out, size_t count) const;
+
+    Vector4 XO_CC Get(int lane) const;
+
+    Vector4xN XO_CC operator + (Vector4xN const& other) const;
+    Vector4xN XO_CC operator - (Vector4xN const& other) const;
+    Vector4xN XO_CC operator * (Vector4xN const& other) const;
+    Vector4xN XO_CC operator / (Vector4xN const& other) const;
+    Vector4xN& XO_CC operator += (Vector4xN const& other) { return *this = *this + other; }
+    Vector4xN& XO_CC operator -= (Vector4xN const& other) { return *this = *this - other; }
+    Vector4xN& XO_CC operator *= (Vector4xN const& other) { return *this = *this * other; }
+    Vector4xN& XO_CC operator /= (Vector4xN const& other) { return *this = *this / other; }
+
+    Vector4xN XO_CC operator * (Lanes const& value) const { return Vector4xN(x * value, y * value, z * value, w * value); }
+    Vector4xN XO_CC operator / (Lanes const& value) const { return Vector4xN(x / value, y / value, z / value, w / value); }
+
+    Vector4xN XO_CC operator + (float value) const { return *this + Vector4xN(value); }
+    Vector4xN XO_CC operator - (float value) const { return *this - Vector4xN(value); }
+    Vector4xN XO_CC operator * (float value) const { return *this * Vector4xN(value); }
+    Vector4xN XO_CC operator / (float value) const { return *this / Vector4xN(value); }
+    Vector4xN& XO_CC operator += (float value) { return *this += Vector4xN(value); }
+    Vector4xN& XO_CC operator -= (float value) { return *this -= Vector4xN(value); }
+    Vector4xN& XO_CC operator *= (float value) { return *this *= Vector4xN(value); }
+    Vector4xN& XO_CC operator /= (float value) { return *this /= Vector4xN(value); }
+
+    Vector4xN operator -() const { return Vector4xN(-x, -y, -z, -w); }
+
+    Lanes Sum() const;
+
+    Lanes Magnitude() const;
+    Lanes MagnitudeSquared() const;
+    Vector4xN Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+    Vector4xN& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+
+    // true when every lane is equal
+    static bool XO_CC RoughlyEqual(Vector4xN const& left, Vector4xN const& right);
+    static bool XO_CC ExactlyEqual(Vector4xN const& left, Vector4xN const& right);
+    static bool XO_CC RoughlyEqual(Vector4xN const& left, float magnitude);
+    static bool XO_CC ExactlyEqual(Vector4xN const& left, float magnitude);
+
+    static Lanes XO_CC DotProduct(Vector4xN const& left, Vector4xN const& right);
+    static Vector4xN XO_CC Lerp(Vector4xN const& left, Vector4xN const& right, float t);
+    static Vector4xN XO_CC Lerp(Vector4xN const& left, Vector4xN const& right, Lanes const& t);
+
+    static const Vector4xN Zero;
+    static const Vector4xN One;
+};
+
+typedef Vector3xN<4> Vector3x4;
+typedef Vector3xN<8> Vector3x8;
+typedef Vector4xN<4> Vector4x4;
+typedef Vector4xN<8> Vector4x8;
+
+////////////////////////////////////////////////////////////////////////////////////////// FloatN trig
+// The polynomial from xo-math-utilities.h on every lane. No libm fallback here, so keep
+// |val| <= trig::MaxReducible.
+template<int N>
+XO_INL void XO_CC SinCos(FloatN<N> const& val, FloatN<N>& sinOut, FloatN<N>& cosOut) {
+    trig::SinCos(val, sinOut, cosOut);
+}
+
+template<int N>
+XO_INL FloatN<N> XO_CC Sin(FloatN<N> const& val) {
+    FloatN<N> s, c;
+    trig::SinCos(val, s, c);
+    return s;
+}
+
+template<int N>
+XO_INL FloatN<N> XO_CC Cos(FloatN<N> const& val) {
+    FloatN<N> s, c;
+    trig::SinCos(val, s, c);
+    return c;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////// FloatN helpers
+namespace wide {
+// Lane-wise CloseEnough, see xo-math-utilities.h
+template<int N>
+XO_INL bool XO_CC CloseEnough(FloatN<N> const& left, FloatN<N> const& right) {
+    typedef FloatN<N> F;
+    F scale = F::Max(F(1.f), F::Max(F::Abs(left), F::Abs(right)));
+    return F::AllLessEqual(F::Abs(left - right), F(MachineEpsilon) * scale);
+}
+} // ::xo::wide
+
+////////////////////////////////////////////////////////////////////////////////////////// Vector 3 xN
+
+template<int N> /*static*/ XO_INL
+Vector3xN<N> XO_CC Vector3xN<N>::Gather(Vector3 const* in) {
+    // A transpose through the stack: cheap next to the math it feeds, and the compiler
+    // turns it into shuffles where it can.
+    XO_ALN_16 float c[3][N];
+    for (int i = 0; i < N; ++i) {
+        c[0][i] = in[i].x;
+        c[1][i] = in[i].y;
+        c[2][i] = in[i].z;
+    }
+    return Vector3xN(Lanes::Load(c[0]), Lanes::Load(c[1]), Lanes::Load(c[2]));
+}
+
+template<int N> /*static*/ XO_INL
+Vector3xN<N> XO_CC Vector3xN<N>::Gather(Vector3 const* in, size_t count) {
+    XO_ALN_16 float c[3][N];
+    for (int i = 0; i < N; ++i) {
+        bool const live = size_t(i) < count;
+        c[0][i] = live ? in[i].x : 0.f;
+        c[1][i] = live ? in[i].y : 0.f;
+        c[2][i] = live ? in[i].z : 0.f;
+    }
+    return Vector3xN(Lanes::Load(c[0]), Lanes::Load(c[1]), Lanes::Load(c[2]));
+}
+
+template<int N> XO_INL
+void XO_CC Vector3xN<N>::Scatter(Vector3* out) const {
+    Scatter(out, N);
+}
+
+template<int N> XO_INL
+void XO_CC Vector3xN<N>::Scatter(Vector3* out, size_t count) const {
+    XO_ALN_16 float c[3][N];
+    x.Store(c[0]);
+    y.Store(c[1]);
+    z.Store(c[2]);
+    size_t const n = count < size_t(N) ? count : size_t(N);
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = Vector3(c[0][i], c[1][i], c[2][i]);
+    }
+}
+
+template<int N> XO_INL
+Vector3 XO_CC Vector3xN<N>::Get(int lane) const {
+    XO_ALN_16 float c[N];
+    x.Store(c); float const xx = c[lane];
+    y.Store(c); float const yy = c[lane];
+    z.Store(c); float const zz = c[lane];
+    return Vector3(xx, yy, zz);
+}
+
+template<int N> XO_INL
+Vector3xN<N> XO_CC Vector3xN<N>::operator + (Vector3xN const& other) const {
+    return Vector3xN(x + other.x, y + other.y, z + other.z);
+}
+
+template<int N> XO_INL
+Vector3xN<N> XO_CC Vector3xN<N>::operator - (Vector3xN const& other) const {
+    return Vector3xN(x - other.x, y - other.y, z - other.z);
+}
+
+template<int N> XO_INL
+Vector3xN<N> XO_CC Vector3xN<N>::operator * (Vector3xN const& other) const {
+    return Vector3xN(x * other.x, y * other.y, z * other.z);
+}
+
+template<int N> XO_INL
+Vector3xN<N> XO_CC Vector3xN<N>::operator / (Vector3xN const& other) const {
+    return Vector3xN(x / other.x, y / other.y, z / other.z);
+}
+
+template<int N> XO_INL FloatN<N> Vector3xN<N>::Sum() const { return x + y + z; }
+
+template<int N> XO_INL FloatN<N> Vector3xN<N>::MagnitudeSquared() const { return DotProduct(*this, *this); }
+template<int N> XO_INL FloatN<N> Vector3xN<N>::Magnitude() const { return Lanes::Sqrt(MagnitudeSquared()); }
+
+template<int N> XO_INL Vector3xN<N>& Vector3xN<N>::Normalize(Precision precision) {
+    if (precision == Precision::Exact) {
+        return *this = *this / Magnitude();
+    }
+    return *this = *this * Lanes::InverseSqrt(MagnitudeSquared(), precision);
+}
+template<int N> XO_INL Vector3xN<N> Vector3xN<N>::Normalized(Precision precision) const { return Vector3xN(*this).Normalize(precision); }
+
+template<int N> /*static*/ XO_INL
+bool XO_CC Vector3xN<N>::RoughlyEqual(Vector3xN const& left, Vector3xN const& right) {
+    return wide::CloseEnough(left.x, right.x)
+        && wide::CloseEnough(left.y, right.y)
+        && wide::CloseEnough(left.z, right.z);
+}
+
+template<int N> /*static*/ XO_INL
+bool XO_CC Vector3xN<N>::ExactlyEqual(Vector3xN const& left, Vector3xN const& right) {
+    return Lanes::AllEqual(left.x, right.x)
+        && Lanes::AllEqual(left.y, right.y)
+        && Lanes::AllEqual(left.z, right.z);
+}
+
+template<int N> /*static*/ XO_INL
+bool XO_CC Vector3xN<N>::RoughlyEqual(Vector3xN const& left, float magnitude) {
+    return wide::CloseEnough(left.MagnitudeSquared(), Lanes(Pow<2>(magnitude)));
+}
+
+template<int N> /*static*/ XO_INL
+bool XO_CC Vector3xN<N>::ExactlyEqual(Vector3xN const& left, float magnitude) {
+    return Lanes::AllEqual(left.MagnitudeSquared(), Lanes(Pow<2>(magnitude)));
+}
+
+template<int N> /*static*/ XO_INL
+FloatN<N> XO_CC Vector3xN<N>::DotProduct(Vector3xN const& left, Vector3xN const& right) {
+    return Lanes::MultiplyAdd(left.z, right.z, Lanes::MultiplyAdd(left.y, right.y, left.x * right.x));
+}
+
+template<int N> /*static*/ XO_INL
+Vector3xN<N> XO_CC Vector3xN<N>::CrossProduct(Vector3xN const& left, Vector3xN const& right) {
+    return Vector3xN(
+        left.y * right.z - left.z * right.y,
+        left.z * right.x - left.x * right.z,
+        left.x * right.y - left.y * right.x);
+}
+
+template<int N> /*static*/ XO_INL
+Vector3xN<N> XO_CC Vector3xN<N>::Lerp(Vector3xN const& left, Vector3xN const& right, float t) {
+    return Lerp(left, right, Lanes(t));
+}
+
+template<int N> /*static*/ XO_INL
+Vector3xN<N> XO_CC Vector3xN<N>::Lerp(Vector3xN const& left, Vector3xN const& right, Lanes const& t) {
+    return Vector3xN(
+        Lanes::MultiplyAdd(t, right.x - left.x, left.x),
+        Lanes::MultiplyAdd(t, right.y - left.y, left.y),
+        Lanes::MultiplyAdd(t, right.z - left.z, left.z));
+}
+
+template<int N> /*static*/ XO_INL
+FloatN<N> XO_CC Vector3xN<N>::DistanceSquared(Vector3xN const& left, Vector3xN const& right) {
+    return (right - left).MagnitudeSquared();
+}
+
+template<int N> /*static*/ XO_INL
+FloatN<N> XO_CC Vector3xN<N>::Distance(Vector3xN const& left, Vector3xN const& right) {
+    return (right - left).Magnitude();
+}
+
+template<int N> /*static*/ const Vector3xN<N> Vector3xN<N>::Zero(Vector3::Zero);
+template<int N> /*static*/ const Vector3xN<N> Vector3xN<N>::One(Vector3::One);
+template<int N> /*static*/ const Vector3xN<N> Vector3xN<N>::Up(Vector3::Up);
+template<int N> /*static*/ const Vector3xN<N> Vector3xN<N>::Down(Vector3::Down);
+template<int N> /*static*/ const Vector3xN<N> Vector3xN<N>::Left(Vector3::Left);
+template<int N> /*static*/ const Vector3xN<N> Vector3xN<N>::Right(Vector3::Right);
+template<int N> /*static*/ const Vector3xN<N> Vector3xN<N>::Forward(Vector3::Forward);
+template<int N> /*static*/ const Vector3xN<N> Vector3xN<N>::Backward(Vector3::Backward);
+
+////////////////////////////////////////////////////////////////////////////////////////// Vector 4 xN
+
+template<int N> /*static*/ XO_INL
+Vector4xN<N> XO_CC Vector4xN<N>::Gather(Vector4 const* in) {
+    XO_ALN_16 float c[4][N];
+    for (int i = 0; i < N; ++i) {
+        for (int j = 0; j < 4; ++j) c[j][i] = in[i].v[j];
+    }
+    return Vector4xN(Lanes::Load(c[0]), Lanes::Load(c[1]), Lanes::Load(c[2]), Lanes::Load(c[3]));
+}
+
+template<int N> /*static*/ XO_INL
+Vector4xN<N> XO_CC Vector4xN<N>::Gather(Vector4 const* in, size_t count) {
+    XO_ALN_16 float c[4][N];
+    for (int i = 0; i < N; ++i) {
+        bool const live = size_t(i) < count;
+        for (int j = 0; j < 4; ++j) c[j][i] = live ? in[i].v[j] : 0.f;
+    }
+    return Vector4xN(Lanes::Load(c[0]), Lanes::Load(c[1]), Lanes::Load(c[2]), Lanes::Load(c[3]));
+}
+
+template<int N> XO_INL
+void XO_CC Vector4xN<N>::Scatter(Vector4* out) const {
+    Scatter(out, N);
+}
+
+template<int N> XO_INL
+void XO_CC Vector4xN<N>::Scatter(Vector4* out, size_t count) const {
+    XO_ALN_16 float c[4][N];
+    x.Store(c[0]);
+    y.Store(c[1]);
+    z.Store(c[2]);
+    w.Store(c[3]);
+    size_t const n = count < size_t(N) ? count : size_t(N);
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = Vector4(c[0][i], c[1][i], c[2][i], c[3][i]);
+    }
+}
+
+template<int N> XO_INL
+Vector4 XO_CC Vector4xN<N>::Get(int lane) const {
+    XO_ALN_16 float c[N];
+    x.Store(c); float const xx = c[lane];
+    y.Store(c); float const yy = c[lane];
+    z.Store(c); float const zz = c[lane];
+    w.Store(c); float const ww = c[lane];
+    return Vector4(xx, yy, zz, ww);
+}
+
+template<int N> XO_INL
+Vector4xN<N> XO_CC Vector4xN<N>::operator + (Vector4xN const& other) const {
+    return Vector4xN(x + other.x, y + other.y, z + other.z, w + other.w);
+}
+
+template<int N> XO_INL
+Vector4xN<N> XO_CC Vector4xN<N>::operator - (Vector4xN const& other) const {
+    return Vector4xN(x - other.x, y - other.y, z - other.z, w - other.w);
+}
+
+template<int N> XO_INL
+Vector4xN<N> XO_CC Vector4xN<N>::operator * (Vector4xN const& other) const {
+    return Vector4xN(x * other.x, y * other.y, z * other.z, w * other.w);
+}
+
+template<int N> XO_INL
+Vector4xN<N> XO_CC Vector4xN<N>::operator / (Vector4xN const& other) const {
+    return Vector4xN(x / other.x, y / other.y, z / other.z, w / other.w);
+}
+
+template<int N> XO_INL FloatN<N> Vector4xN<N>::Sum() const { return (x + y) + (z + w); }
+
+template<int N> XO_INL FloatN<N> Vector4xN<N>::MagnitudeSquared() const { return DotProduct(*this, *this); }
+template<int N> XO_INL FloatN<N> Vector4xN<N>::Magnitude() const { return Lanes::Sqrt(MagnitudeSquared()); }
+
+template<int N> XO_INL Vector4xN<N>& Vector4xN<N>::Normalize(Precision precision) {
+    if (precision == Precision::Exact) {
+        return *this = *this / Magnitude();
+    }
+    return *this = *this * Lanes::InverseSqrt(MagnitudeSquared(), precision);
+}
+template<int N> XO_INL Vector4xN<N> Vector4xN<N>::Normalized(Precision precision) const { return Vector4xN(*this).Normalize(precision); }
+
+template<int N> /*static*/ XO_INL
+bool XO_CC Vector4xN<N>::RoughlyEqual(Vector4xN const& left, Vector4xN const& right) {
+    return wide::CloseEnough(left.x, right.x)
+        && wide::CloseEnough(left.y, right.y)
+        && wide::CloseEnough(left.z, right.z)
+        && wide::CloseEnough(left.w, right.w);
+}
+
+template<int N> /*static*/ XO_INL
+bool XO_CC Vector4xN<N>::ExactlyEqual(Vector4xN const& left, Vector4xN const& right) {
+    return Lanes::AllEqual(left.x, right.x)
+        && Lanes::AllEqual(left.y, right.y)
+        && Lanes::AllEqual(left.z, right.z)
+        && Lanes::AllEqual(left.w, right.w);
+}
+
+template<int N> /*static*/ XO_INL
+bool XO_CC Vector4xN<N>::RoughlyEqual(Vector4xN const& left, float magnitude) {
+    return wide::CloseEnough(left.MagnitudeSquared(), Lanes(Pow<2>(magnitude)));
+}
+
+template<int N> /*static*/ XO_INL
+bool XO_CC Vector4xN<N>::ExactlyEqual(Vector4xN const& left, float magnitude) {
+    return Lanes::AllEqual(left.MagnitudeSquared(), Lanes(Pow<2>(magnitude)));
+}
+
+template<int N> /*static*/ XO_INL
+FloatN<N> XO_CC Vector4xN<N>::DotProduct(Vector4xN const& left, Vector4xN const& right) {
+    return Lanes::MultiplyAdd(left.w, right.w,
+           Lanes::MultiplyAdd(left.z, right.z,
+           Lanes::MultiplyAdd(left.y, right.y, left.x * right.x)));
+}
+
+template<int N> /*static*/ XO_INL
+Vector4xN<N> XO_CC Vector4xN<N>::Lerp(Vector4xN const& left, Vector4xN const& right, float t) {
+    return Lerp(left, right, Lanes(t));
+}
+
+template<int N> /*static*/ XO_INL
+Vector4xN<N> XO_CC Vector4xN<N>::Lerp(Vector4xN const& left, Vector4xN const& right, Lanes const& t) {
+    return Vector4xN(
+        Lanes::MultiplyAdd(t, right.x - left.x, left.x),
+        Lanes::MultiplyAdd(t, right.y - left.y, left.y),
+        Lanes::MultiplyAdd(t, right.z - left.z, left.z),
+        Lanes::MultiplyAdd(t, right.w - left.w, left.w));
+}
+
+template<int N> /*static*/ const Vector4xN<N> Vector4xN<N>::Zero(Vector4::Zero);
+template<int N> /*static*/ const Vector4xN<N> Vector4xN<N>::One(Vector4::One);
+
+} // ::xo
+
+////////////////////////////////////////////////////////////////////////////////////////// end xo-math-wide.h inline
+////////////////////////////////////////////////////////////////////////////////////////// xo-math-avx2.h inlined
+#line 6 "xo-math-avx2.h"
+#if !defined(XO_CONFIG_RUNTIME_DISPATCH)
+#   define XO_CONFIG_RUNTIME_DISPATCH 1
+#endif
+
+#if defined(XO_MATH_IMPL) && XO_X86 && (XO_CONFIG_RUNTIME_DISPATCH || (XO_SSE_CURRENT >= XO_AVX2 && XO_HAS_FMA && XO_HAS_F16C))
+#define XO_BATCH_AVX2 1
+#include <immintrin.h>
+// Everything in here is compiled for AVX2, FMA3 and F16C regardless of the flags of the
+// translation unit. It's only called through the batch kernel table after the cpu has been
+// checked.
+#if defined(__clang__)
+#   pragma clang attribute push (__attribute__((target("avx2,fma,f16c"))), apply_to = function)
+#elif defined(__GNUC__)
+#   pragma GCC push_options
+#   pragma GCC target("avx2,fma,f16c")
+#endif
+namespace xo { namespace avx2 {
+// 8 wide kernels over contiguous arrays, see xo-math-batch.h. The tail of an array is
+// loaded and stored with maskload/maskstore so nothing past the end of an array is touched.
+
+XO_INL __m256i Lanes() {
+    return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+}
+
+XO_INL __m256i TailMask(size_t count) {
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(count < 8 ? count : 8)), Lanes());
+}
+
+// Loads up to 24 floats (8 Vector3s), zeroing anything past 'floats'.
+XO_INL void Load3(float const* in, size_t floats, __m256& r0, __m256& r1, __m256& r2) {
+    r0 = _mm256_maskload_ps(in, TailMask(floats));
+    r1 = _mm256_maskload_ps(in + 8, TailMask(floats > 8 ? floats - 8 : 0));
+    r2 = _mm256_maskload_ps(in + 16, TailMask(floats > 16 ? floats - 16 : 0));
+}
+
+XO_INL void Store3(float* out, size_t floats, __m256 r0, __m256 r1, __m256 r2) {
+    _mm256_maskstore_ps(out, TailMask(floats), r0);
+    _mm256_maskstore_ps(out + 8, TailMask(floats > 8 ? floats - 8 : 0), r1);
+    _mm256_maskstore_ps(out + 16, TailMask(floats > 16 ? floats - 16 : 0), r2);
+}
+
+// Picks 'value' from a, b or c for each lane, by which of 0, 1 or 2 'which' holds.
+XO_INL __m256 Select3(__m256 a, __m256 b, __m256 c, __m256i which) {
+    __m256 isB = _mm256_castsi256_ps(_mm256_cmpeq_epi32(which, _mm256_set1_epi32(1)));
+    __m256 isC = _mm256_castsi256_ps(_mm256_cmpeq_epi32(which, _mm256_set1_epi32(2)));
+    return _mm256_blendv_ps(_mm256_blendv_ps(a, b, isB), c, isC);
+}
+
+// Picks component c (0 = x, 1 = y, 2 = z) of 8 interleaved Vector3s held in r0, r1, r2.
+XO_INL __m256 Deinterleave3(__m256 r0, __m256 r1, __m256 r2, int c) {
+    // permutevar8x32 only looks at the low 3 bits, k >> 3 says which register to take.
+    __m256i k = _mm256_add_epi32(_mm256_mullo_epi32(Lanes(), _mm256_set1_epi32(3)),
+                                 _mm256_set1_epi32(c));
+    return Select3(_mm256_permutevar8x32_ps(r0, k),
+                   _mm256_permutevar8x32_ps(r1, k),
+                   _mm256_permutevar8x32_ps(r2, k),
+                   _mm256_srli_epi32(k, 3));
+}
+
+// Builds register r (0, 1 or 2) of the interleaved form of 8 Vector3s held as x, y, z.
+XO_INL __m256 Interleave3(__m256 x, __m256 y, __m256 z, int r) {
+    __m256i k = _mm256_add_epi32(Lanes(), _mm256_set1_epi32(8 * r));
+    // k / 3 for k < 24
+    __m256i vec = _mm256_srli_epi32(_mm256_mullo_epi32(k, _mm256_set1_epi32(0xAAAB)), 17);
+    __m256i c = _mm256_sub_epi32(k, _mm256_mullo_epi32(vec, _mm256_set1_epi32(3)));
+    return Select3(_mm256_permutevar8x32_ps(x, vec),
+                   _mm256_permutevar8x32_ps(y, vec),
+                   _mm256_permutevar8x32_ps(z, vec),
+                   c);
+}
+
+// Sums each group of 4 lanes and broadcasts the sum back to the group.
+XO_INL __m256 SumQuads(__m256 m) {
+    m = _mm256_add_ps(m, _mm256_permute_ps(m, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm256_add_ps(m, _mm256_permute_ps(m, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+struct AddOp      { static XO_INL __m256 Apply(__m256 l, __m256 r) { return _mm256_add_ps(l, r); } };
+struct SubtractOp { static XO_INL __m256 Apply(__m256 l, __m256 r) { return _mm256_sub_ps(l, r); } };
+struct MultiplyOp { static XO_INL __m256 Apply(__m256 l, __m256 r) { return _mm256_mul_ps(l, r); } };
+struct DivideOp   { static XO_INL __m256 Apply(__m256 l, __m256 r) { return _mm256_div_ps(l, r); } };
+
+// An array of Vector3s or Vector4s as the floats it's made of. Casts the pointer rather than
+// taking &in->x, so an empty array may be null.
+template<typename T>
+XO_INL float const* Floats(T const* vectors) { return reinterpret_cast<float const*>(vectors); }
+template<typename T>
+XO_INL float* Floats(T* vectors) { return reinterpret_cast<float*>(vectors); }
+
+template<typename Op>
+XO_INL void Elementwise(float const* left, float const* right, float* out, size_t floats) {
+    size_t i = 0;
+    for (; i + 8 <= floats; i += 8) {
+        _mm256_storeu_ps(out + i, Op::Apply(_mm256_loadu_ps(left + i), _mm256_loadu_ps(right + i)));
+    }
+    if (i < floats) {
+        __m256i m = TailMask(floats - i);
+        // masked off lanes are zero in both inputs, DivideOp's 0/0 there is never stored.
+        __m256 l = _mm256_maskload_ps(left + i, m);
+        __m256 r = _mm256_maskload_ps(right + i, m);
+        _mm256_maskstore_ps(out + i, m, Op::Apply(l, r));
+    }
+}
+
+XO_INL void LerpFloats(float const* left, float const* right, float t, float* out, size_t floats) {
+    __m256 tt = _mm256_set1_ps(t);
+    for (size_t i = 0; i < floats; i += 8) {
+        __m256i m = TailMask(floats - i);
+        __m256 l = _mm256_maskload_ps(left + i, m);
+        __m256 r = _mm256_maskload_ps(right + i, m);
+        _mm256_maskstore_ps(out + i, m, _mm256_fmadd_ps(tt, _mm256_sub_ps(r, l), l));
+    }
+}
+
+void Add3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Elementwise<AddOp>(Floats(left), Floats(right), Floats(out), count * 3);
+}
+
+void Subtract3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Elementwise<SubtractOp>(Floats(left), Floats(right), Floats(out), count * 3);
+}
+
+void Multiply3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Elementwise<MultiplyOp>(Floats(left), Floats(right), Floats(out), count * 3);
+}
+
+void Divide3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Elementwise<DivideOp>(Floats(left), Floats(right), Floats(out), count * 3);
+}
+
+void DotProduct3(Vector3 const* left, Vector3 const* right, float* out, size_t count) {
+    float const* l = Floats(left);
+    float const* r = Floats(right);
+    for (size_t i = 0; i < count; i += 8) {
+        size_t floats = (count - i) * 3;
+        __m256 l0, l1, l2, r0, r1, r2;
+        Load3(l + i * 3, floats, l0, l1, l2);
+        Load3(r + i * 3, floats, r0, r1, r2);
+        __m256 d = _mm256_mul_ps(Deinterleave3(l0, l1, l2, 0), Deinterleave3(r0, r1, r2, 0));
+        d = _mm256_fmadd_ps(Deinterleave3(l0, l1, l2, 1), Deinterleave3(r0, r1, r2, 1), d);
+        d = _mm256_fmadd_ps(Deinterleave3(l0, l1, l2, 2), Deinterleave3(r0, r1, r2, 2), d);
+        _mm256_maskstore_ps(out + i, TailMask(count - i), d);
+    }
+}
+
+void CrossProduct3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    float const* l = Floats(left);
+    float const* r = Floats(right);
+    for (size_t i = 0; i < count; i += 8) {
+        size_t floats = (count - i) * 3;
+        __m256 l0, l1, l2, r0, r1, r2;
+        Load3(l + i * 3, floats, l0, l1, l2);
+        Load3(r + i * 3, floats, r0, r1, r2);
+        __m256 lx = Deinterleave3(l0, l1, l2, 0);
+        __m256 ly = Deinterleave3(l0, l1, l2, 1);
+        __m256 lz = Deinterleave3(l0, l1, l2, 2);
+        __m256 rx = Deinterleave3(r0, r1, r2, 0);
+        __m256 ry = Deinterleave3(r0, r1, r2, 1);
+        __m256 rz = Deinterleave3(r0, r1, r2, 2);
+        __m256 x = _mm256_fmsub_ps(ly, rz, _mm256_mul_ps(lz, ry));
+        __m256 y = _mm256_fmsub_ps(lz, rx, _mm256_mul_ps(lx, rz));
+        __m256 z = _mm256_fmsub_ps(lx, ry, _mm256_mul_ps(ly, rx));
+        Store3(Floats(out) + i * 3, floats,
+               Interleave3(x, y, z, 0), Interleave3(x, y, z, 1), Interleave3(x, y, z, 2));
+    }
+}
+
+// 1/sqrt(m) for Precision::Fast and Fastest: rsqrtps, then one Newton-Raphson step
+// r * (1.5 - 0.5 * m * r * r) for Fast. Denormal m are scaled into range, see xo::rsqrt.
+XO_INL __m256 InverseSqrt(__m256 m, Precision precision) {
+    __m256 const tiny = _mm256_cmp_ps(m, _mm256_set1_ps(rsqrt::Tiny), _CMP_LT_OQ);
+    m = _mm256_blendv_ps(m, _mm256_mul_ps(m, _mm256_set1_ps(rsqrt::ScaleUp)), tiny);
+    __m256 const scale = _mm256_blendv_ps(_mm256_set1_ps(1.f), _mm256_set1_ps(rsqrt::ScaleBack), tiny);
+    __m256 r = _mm256_rsqrt_ps(m);
+    if (precision == Precision::Fastest) {
+        return _mm256_mul_ps(r, scale);
+    }
+    __m256 halfMR = _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), m), r);
+    return _mm256_mul_ps(_mm256_mul_ps(r, scale), _mm256_fnmadd_ps(halfMR, r, _mm256_set1_ps(1.5f)));
+}
+
+void Normalize3(Vector3 const* in, Vector3* out, size_t count, Precision precision) {
+    for (size_t i = 0; i < count; i += 8) {
+        size_t floats = (count - i) * 3;
+        __m256 r0, r1, r2;
+        Load3(Floats(in) + i * 3, floats, r0, r1, r2);
+        __m256 x = Deinterleave3(r0, r1, r2, 0);
+        __m256 y = Deinterleave3(r0, r1, r2, 1);
+        __m256 z = Deinterleave3(r0, r1, r2, 2);
+        __m256 lengthSquared = _mm256_fmadd_ps(z, z, _mm256_fmadd_ps(y, y, _mm256_mul_ps(x, x)));
+        if (precision == Precision::Exact) {
+            __m256 len = _mm256_sqrt_ps(lengthSquared);
+            x = _mm256_div_ps(x, len);
+            y = _mm256_div_ps(y, len);
+            z = _mm256_div_ps(z, len);
+        }
+        else {
+            __m256 scale = InverseSqrt(lengthSquared, precision);
+            x = _mm256_mul_ps(x, scale);
+            y = _mm256_mul_ps(y, scale);
+            z = _mm256_mul_ps(z, scale);
+        }
+        Store3(Floats(out) + i * 3, floats,
+               Interleave3(x, y, z, 0), Interleave3(x, y, z, 1), Interleave3(x, y, z, 2));
+    }
+}
+
+void Lerp3(Vector3 const* left, Vector3 const* right, float t, Vector3* out, size_t count) {
+    LerpFloats(Floats(left), Floats(right), t, Floats(out), count * 3);
+}
+
+void Add4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Elementwise<AddOp>(Floats(left), Floats(right), Floats(out), count * 4);
+}
+
+void Subtract4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Elementwise<SubtractOp>(Floats(left), Floats(right), Floats(out), count * 4);
+}
+
+void Multiply4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Elementwise<MultiplyOp>(Floats(left), Floats(right), Floats(out), count * 4);
+}
+
+void Divide4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Elementwise<DivideOp>(Floats(left), Floats(right), Floats(out), count * 4);
+}
+
+void DotProduct4(Vector4 const* left, Vector4 const* right, float* out, size_t count) {
+    // Lane 4h+m of the blended sums holds the dot product of vector 2m+h in the block.
+    __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    for (size_t i = 0; i < count; i += 8) {
+        size_t floats = (count - i) * 4;
+        __m256 s[4];
+        for (int m = 0; m < 4; ++m) {
+            __m256i mask = TailMask(floats > size_t(m) * 8 ? floats - m * 8 : 0);
+            __m256 l = _mm256_maskload_ps(left[i].v + m * 8, mask);
+            __m256 r = _mm256_maskload_ps(right[i].v + m * 8, mask);
+            s[m] = SumQuads(_mm256_mul_ps(l, r));
+        }
+        __m256 d = _mm256_blend_ps(s[0], s[1], 0x22);
+        d = _mm256_blend_ps(d, s[2], 0x44);
+        d = _mm256_blend_ps(d, s[3], 0x88);
+        _mm256_maskstore_ps(out + i, TailMask(count - i), _mm256_permutevar8x32_ps(d, order));
+    }
+}
+
+void Normalize4(Vector4 const* in, Vector4* out, size_t count, Precision precision) {
+    size_t floats = count * 4;
+    for (size_t i = 0; i < floats; i += 8) {
+        __m256i m = TailMask(floats - i);
+        __m256 v = _mm256_maskload_ps(Floats(in) + i, m);
+        __m256 lengthSquared = SumQuads(_mm256_mul_ps(v, v));
+        if (precision == Precision::Exact) {
+            v = _mm256_div_ps(v, _mm256_sqrt_ps(lengthSquared));
+        }
+        else {
+            v = _mm256_mul_ps(v, InverseSqrt(lengthSquared, precision));
+        }
+        _mm256_maskstore_ps(Floats(out) + i, m, v);
+    }
+}
+
+void Lerp4(Vector4 const* left, Vector4 const* right, float t, Vector4* out, size_t count) {
+    LerpFloats(Floats(left), Floats(right), t, Floats(out), count * 4);
+}
+
+// Splits 8 Quaternions (or Vector4s) held two to a register in a0..a3 into one register
+// per component, in array order.
+XO_INL void Deinterleave4(__m256 a0, __m256 a1, __m256 a2, __m256 a3, __m256 c[4]) {
+    // A 4x4 transpose in each half leaves lane 4h+m holding element 2m+h.
+    __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    __m256 t0 = _mm256_unpacklo_ps(a0, a1);
+    __m256 t1 = _mm256_unpackhi_ps(a0, a1);
+    __m256 t2 = _mm256_unpacklo_ps(a2, a3);
+    __m256 t3 = _mm256_unpackhi_ps(a2, a3);
+    c[0] = _mm256_permutevar8x32_ps(_mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)), order);
+    c[1] = _mm256_permutevar8x32_ps(_mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)), order);
+    c[2] = _mm256_permutevar8x32_ps(_mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)), order);
+    c[3] = _mm256_permutevar8x32_ps(_mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2)), order);
+}
+
+// Loads up to 32 floats (8 Quaternions or Vector4s) split into one register per
+// component, zeroing anything past 'floats'.
+XO_INL void Load4(float const* in, size_t floats, __m256 c[4]) {
+    __m256 a[4];
+    if (floats >= 32) {
+        for (int m = 0; m < 4; ++m) a[m] = _mm256_loadu_ps(in + m * 8);
+    }
+    else {
+        for (int m = 0; m < 4; ++m) {
+            a[m] = _mm256_maskload_ps(in + m * 8, TailMask(floats > size_t(m) * 8 ? floats - m * 8 : 0));
+        }
+    }
+    Deinterleave4(a[0], a[1], a[2], a[3], c);
+}
+
+// Undoes Deinterleave4 and stores the first 'floats' floats. Whole blocks skip the masks,
+// maskstore is slow on some cpus.
+XO_INL void Store4(float* out, size_t floats, __m256 const c[4]) {
+    __m256i order = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    __m256 p[4];
+    for (int m = 0; m < 4; ++m) p[m] = _mm256_permutevar8x32_ps(c[m], order);
+    __m256 t0 = _mm256_unpacklo_ps(p[0], p[1]);
+    __m256 t1 = _mm256_unpackhi_ps(p[0], p[1]);
+    __m256 t2 = _mm256_unpacklo_ps(p[2], p[3]);
+    __m256 t3 = _mm256_unpackhi_ps(p[2], p[3]);
+    __m256 a[4] = {
+        _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)),
+        _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)),
+        _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)),
+        _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2)) };
+    if (floats >= 32) {
+        for (int m = 0; m < 4; ++m) _mm256_storeu_ps(out + m * 8, a[m]);
+    }
+    else {
+        for (int m = 0; m < 4; ++m) {
+            _mm256_maskstore_ps(out + m * 8, TailMask(floats > size_t(m) * 8 ? floats - m * 8 : 0), a[m]);
+        }
+    }
+}
+
+// v + 2r(q x v) + q x 2(q x v), see Quaternion::Rotate.
+void Rotate3(Quaternion const* rotations, Vector3 const* in, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; i += 8) {
+        __m256 q[4];
+        Load4(rotations[i].vec4.v, (count - i) * 4, q);
+        __m256 r0, r1, r2;
+        Load3(Floats(in) + i * 3, (count - i) * 3, r0, r1, r2);
+        __m256 x = Deinterleave3(r0, r1, r2, 0);
+        __m256 y = Deinterleave3(r0, r1, r2, 1);
+        __m256 z = Deinterleave3(r0, r1, r2, 2);
+        __m256 two = _mm256_set1_ps(2.f);
+        __m256 tx = _mm256_mul_ps(two, _mm256_fmsub_ps(q[1], z, _mm256_mul_ps(q[2], y)));
+        __m256 ty = _mm256_mul_ps(two, _mm256_fmsub_ps(q[2], x, _mm256_mul_ps(q[0], z)));
+        __m256 tz = _mm256_mul_ps(two, _mm256_fmsub_ps(q[0], y, _mm256_mul_ps(q[1], x)));
+        x = _mm256_add_ps(_mm256_fmadd_ps(q[3], tx, x), _mm256_fmsub_ps(q[1], tz, _mm256_mul_ps(q[2], ty)));
+        y = _mm256_add_ps(_mm256_fmadd_ps(q[3], ty, y), _mm256_fmsub_ps(q[2], tx, _mm256_mul_ps(q[0], tz)));
+        z = _mm256_add_ps(_mm256_fmadd_ps(q[3], tz, z), _mm256_fmsub_ps(q[0], ty, _mm256_mul_ps(q[1], tx)));
+        Store3(Floats(out) + i * 3, (count - i) * 3,
+               Interleave3(x, y, z, 0), Interleave3(x, y, z, 1), Interleave3(x, y, z, 2));
+    }
+}
+
+XO_INL float const* At(float const* base, size_t index, size_t stride) {
+    return reinterpret_cast<float const*>(reinterpret_cast<char const*>(base) + index * stride);
+}
+
+XO_INL float* At(float* base, size_t index, size_t stride) {
+    return reinterpret_cast<float*>(reinterpret_cast<char*>(base) + index * stride);
+}
+
+// out = (in.xyz, w) times m as a row vector, 8 vectors at a time. Strides are in bytes, tightly
+// packed arrays are deinterleaved in registers, anything else is gathered.
+void Transform3(float const* m,
+                float const* in, size_t inStride,
+                float* out, size_t outStride,
+                size_t count, float w) {
+    __m256 r[3][4];
+    for (int i = 0; i < 3; ++i) {
+        r[i][0] = _mm256_set1_ps(m[i]);
+        r[i][1] = _mm256_set1_ps(m[4 + i]);
+        r[i][2] = _mm256_set1_ps(m[8 + i]);
+        r[i][3] = _mm256_set1_ps(m[12 + i] * w);
+    }
+    bool const packedIn = inStride == 3 * sizeof(float);
+    bool const packedOut = outStride == 3 * sizeof(float);
+    __m256i const offsets = _mm256_mullo_epi32(Lanes(), _mm256_set1_epi32(static_cast<int>(inStride)));
+    for (size_t i = 0; i < count; i += 8) {
+        size_t const n = count - i < 8 ? count - i : 8;
+        float const* src = At(in, i, inStride);
+        __m256 x, y, z;
+        if (packedIn) {
+            __m256 r0, r1, r2;
+            Load3(src, n * 3, r0, r1, r2);
+            x = Deinterleave3(r0, r1, r2, 0);
+            y = Deinterleave3(r0, r1, r2, 1);
+            z = Deinterleave3(r0, r1, r2, 2);
+        }
+        else {
+            __m256 const mask = _mm256_castsi256_ps(TailMask(n));
+            __m256 const zero = _mm256_setzero_ps();
+            x = _mm256_mask_i32gather_ps(zero, src, offsets, mask, 1);
+            y = _mm256_mask_i32gather_ps(zero, src + 1, offsets, mask, 1);
+            z = _mm256_mask_i32gather_ps(zero, src + 2, offsets, mask, 1);
+        }
+        __m256 o[3];
+        for (int j = 0; j < 3; ++j) {
+            o[j] = _mm256_fmadd_ps(r[j][0], x, _mm256_fmadd_ps(r[j][1], y, _mm256_fmadd_ps(r[j][2], z, r[j][3])));
+        }
+        float* dst = At(out, i, outStride);
+        if (packedOut) {
+            Store3(dst, n * 3,
+                   Interleave3(o[0], o[1], o[2], 0),
+                   Interleave3(o[0], o[1], o[2], 1),
+                   Interleave3(o[0], o[1], o[2], 2));
+        }
+        else {
+            alignas(32) float t[3][8];
+            for (int j = 0; j < 3; ++j) _mm256_store_ps(t[j], o[j]);
+            for (size_t k = 0; k < n; ++k) {
+                float* d = At(dst, k, outStride);
+                d[0] = t[0][k];
+                d[1] = t[1][k];
+                d[2] = t[2][k];
+            }
+        }
+    }
+}
+
+// Two Vector4s in v as row vectors times the matrix held as rows (each repeated in both halves).
+XO_INL __m256 Transform4(__m256 const row[4], __m256 v) {
+    __m256 lo = _mm256_mul_ps(_mm256_permute_ps(v, 0x00), row[0]);
+    __m256 hi = _mm256_mul_ps(_mm256_permute_ps(v, 0x55), row[1]);
+    lo = _mm256_fmadd_ps(_mm256_permute_ps(v, 0xAA), row[2], lo);
+    hi = _mm256_fmadd_ps(_mm256_permute_ps(v, 0xFF), row[3], hi);
+    return _mm256_add_ps(lo, hi);
+}
+
+// out = in * m for Vector4s, two per register and four per iteration.
+void Transform4(float const* m,
+                float const* in, size_t inStride,
+                float* out, size_t outStride,
+                size_t count) {
+    __m256 row[4];
+    for (int j = 0; j < 4; ++j) {
+        row[j] = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(m + 4 * j));
+    }
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256 a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(At(in, i, inStride))),
+                                        _mm_loadu_ps(At(in, i + 1, inStride)), 1);
+        __m256 b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(At(in, i + 2, inStride))),
+                                        _mm_loadu_ps(At(in, i + 3, inStride)), 1);
+        a = Transform4(row, a);
+        b = Transform4(row, b);
+        _mm_storeu_ps(At(out, i, outStride), _mm256_castps256_ps128(a));
+        _mm_storeu_ps(At(out, i + 1, outStride), _mm256_extractf128_ps(a, 1));
+        _mm_storeu_ps(At(out, i + 2, outStride), _mm256_castps256_ps128(b));
+        _mm_storeu_ps(At(out, i + 3, outStride), _mm256_extractf128_ps(b, 1));
+    }
+    for (; i < count; ++i) {
+        __m256 a = Transform4(row, _mm256_castps128_ps256(_mm_loadu_ps(At(in, i, inStride))));
+        _mm_storeu_ps(At(out, i, outStride), _mm256_castps256_ps128(a));
+    }
+}
+
+// out = left * right for row major 4x4 matrices, two rows of left per register and two
+// matrices per iteration. Each row of the product is the rows of right weighted by the
+// elements of the same row of left. Both inputs are read before out is written, so out may
+// be left or right.
+XO_INL void Multiply4x4(float const* left, float const* right, float* out) {
+    __m256 r[4];
+    for (int j = 0; j < 4; ++j) {
+        r[j] = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(right + 4 * j));
+    }
+    __m256 const l01 = _mm256_loadu_ps(left);
+    __m256 const l23 = _mm256_loadu_ps(left + 8);
+    __m256 a01 = _mm256_fmadd_ps(_mm256_permute_ps(l01, 0x55), r[1], _mm256_mul_ps(_mm256_permute_ps(l01, 0x00), r[0]));
+    __m256 b01 = _mm256_fmadd_ps(_mm256_permute_ps(l01, 0xFF), r[3], _mm256_mul_ps(_mm256_permute_ps(l01, 0xAA), r[2]));
+    __m256 a23 = _mm256_fmadd_ps(_mm256_permute_ps(l23, 0x55), r[1], _mm256_mul_ps(_mm256_permute_ps(l23, 0x00), r[0]));
+    __m256 b23 = _mm256_fmadd_ps(_mm256_permute_ps(l23, 0xFF), r[3], _mm256_mul_ps(_mm256_permute_ps(l23, 0xAA), r[2]));
+    _mm256_storeu_ps(out, _mm256_add_ps(a01, b01));
+    _mm256_storeu_ps(out + 8, _mm256_add_ps(a23, b23));
+}
+
+void Multiply4x4(float const* left, float const* right, float* out, size_t count) {
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        Multiply4x4(left + i * 16, right + i * 16, out + i * 16);
+        Multiply4x4(left + i * 16 + 16, right + i * 16 + 16, out + i * 16 + 16);
+    }
+    if (i < count) {
+        Multiply4x4(left + i * 16, right + i * 16, out + i * 16);
+    }
+}
+
+// slerp::Weight from xo-math-utilities.h.
+XO_INL __m256 SlerpWeight(__m256 cosine, __m256 t) {
+    __m256 const one = _mm256_set1_ps(1.f);
+    __m256 const xm1 = _mm256_sub_ps(cosine, one);
+    __m256 const tt = _mm256_mul_ps(t, t);
+    __m256 r = one;
+    for (int i = slerp::Terms - 1; i >= 0; --i) {
+        __m256 b = _mm256_mul_ps(_mm256_fmsub_ps(_mm256_set1_ps(slerp::U[i]), tt, _mm256_set1_ps(slerp::V[i])), xm1);
+        r = _mm256_fmadd_ps(b, r, one);
+    }
+    return _mm256_mul_ps(t, r);
+}
+
+// Dot products of 4 component vectors split into one register per component.
+XO_INL __m256 Dot4(__m256 const l[4], __m256 const r[4]) {
+    __m256 d = _mm256_mul_ps(l[0], r[0]);
+    d = _mm256_fmadd_ps(l[1], r[1], d);
+    d = _mm256_fmadd_ps(l[2], r[2], d);
+    return _mm256_fmadd_ps(l[3], r[3], d);
+}
+
+void Slerp(Quaternion const* start, Quaternion const* end, float const* t, Quaternion* out, size_t count) {
+    for (size_t i = 0; i < count; i += 8) {
+        size_t floats = (count - i) * 4;
+        __m256 s[4], e[4];
+        Load4(start[i].vec4.v, floats, s);
+        Load4(end[i].vec4.v, floats, e);
+        // Flipping end when start . end < 0 takes the shorter arc, like Quaternion::Slerp.
+        __m256 d = Dot4(s, e);
+        __m256 sign = _mm256_and_ps(d, _mm256_set1_ps(-0.f));
+        __m256 cosine = _mm256_xor_ps(d, sign);
+        __m256 te = count - i >= 8 ? _mm256_loadu_ps(t + i) : _mm256_maskload_ps(t + i, TailMask(count - i));
+        __m256 ts = _mm256_sub_ps(_mm256_set1_ps(1.f), te);
+        __m256 ws = SlerpWeight(cosine, ts);
+        __m256 we = _mm256_xor_ps(SlerpWeight(cosine, te), sign);
+        __m256 c[4];
+        for (int j = 0; j < 4; ++j) c[j] = _mm256_fmadd_ps(s[j], ws, _mm256_mul_ps(e[j], we));
+        Store4(out[i].vec4.v, floats, c);
+    }
+}
+
+void Nlerp(Quaternion const* start, Quaternion const* end, float const* t, Quaternion* out, size_t count, Precision precision) {
+    for (size_t i = 0; i < count; i += 8) {
+        size_t floats = (count - i) * 4;
+        __m256 s[4], e[4];
+        Load4(start[i].vec4.v, floats, s);
+        Load4(end[i].vec4.v, floats, e);
+        __m256 sign = _mm256_and_ps(Dot4(s, e), _mm256_set1_ps(-0.f));
+        __m256 te = count - i >= 8 ? _mm256_loadu_ps(t + i) : _mm256_maskload_ps(t + i, TailMask(count - i));
+        __m256 c[4];
+        for (int j = 0; j < 4; ++j) c[j] = _mm256_fmadd_ps(te, _mm256_sub_ps(_mm256_xor_ps(e[j], sign), s[j]), s[j]);
+        __m256 lengthSquared = _mm256_mul_ps(c[0], c[0]);
+        for (int j = 1; j < 4; ++j) lengthSquared = _mm256_fmadd_ps(c[j], c[j], lengthSquared);
+        // Lanes past the end divide 0 by 0, they're never stored.
+        if (precision == Precision::Exact) {
+            __m256 len = _mm256_sqrt_ps(lengthSquared);
+            for (int j = 0; j < 4; ++j) c[j] = _mm256_div_ps(c[j], len);
+        }
+        else {
+            __m256 scale = InverseSqrt(lengthSquared, precision);
+            for (int j = 0; j < 4; ++j) c[j] = _mm256_mul_ps(c[j], scale);
+        }
+        Store4(out[i].vec4.v, floats, c);
+    }
+}
+
+// out = in - origin rounded to floats, for arrays of Vector3d. 4 Vector3ds are 12 doubles,
+// three registers, and origin repeats every 3 lanes so it's three registers too.
+void RelativeTo3d(double const* in, double const* origin, float* out, size_t count) {
+    __m256d const o0 = _mm256_setr_pd(origin[0], origin[1], origin[2], origin[0]);
+    __m256d const o1 = _mm256_setr_pd(origin[1], origin[2], origin[0], origin[1]);
+    __m256d const o2 = _mm256_setr_pd(origin[2], origin[0], origin[1], origin[2]);
+    size_t const doubles = count * 3;
+    size_t i = 0;
+    for (; i + 12 <= doubles; i += 12) {
+        _mm_storeu_ps(out + i, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(in + i), o0)));
+        _mm_storeu_ps(out + i + 4, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(in + i + 4), o1)));
+        _mm_storeu_ps(out + i + 8, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(in + i + 8), o2)));
+    }
+    for (; i < doubles; i += 3) {
+        out[i] = static_cast<float>(in[i] - origin[0]);
+        out[i + 1] = static_cast<float>(in[i + 1] - origin[1]);
+        out[i + 2] = static_cast<float>(in[i + 2] - origin[2]);
+    }
+}
+
+// out = (in, 1) times m as a row vector for arrays of Vector3d, one vector per register:
+// the rows of m weighted by x, y and z.
+void Transform3d(double const* m, double const* in, double* out, size_t count) {
+    __m256d row[4];
+    for (int j = 0; j < 4; ++j) {
+        row[j] = _mm256_setr_pd(m[j * 4], m[j * 4 + 1], m[j * 4 + 2], 0.0);
+    }
+    for (size_t i = 0; i < count * 3; i += 3) {
+        __m256d p = _mm256_fmadd_pd(row[0], _mm256_broadcast_sd(in + i), row[3]);
+        p = _mm256_fmadd_pd(row[1], _mm256_broadcast_sd(in + i + 1), p);
+        p = _mm256_fmadd_pd(row[2], _mm256_broadcast_sd(in + i + 2), p);
+        _mm_storeu_pd(out + i, _mm256_castpd256_pd128(p));
+        _mm_store_sd(out + i + 2, _mm256_extractf128_pd(p, 1));
+    }
+}
+
+// Half floats to floats and back, 8 at a time. The tail goes through a buffer, there are no
+// masked 16 bit loads or stores before AVX512BW.
+void ToHalf(float const* in, uint16_t* out, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), h);
+    }
+    if (i < count) {
+        alignas(16) uint16_t t[8];
+        __m256 f = _mm256_maskload_ps(in + i, TailMask(count - i));
+        _mm_store_si128(reinterpret_cast<__m128i*>(t), _mm256_cvtps_ph(f, _MM_FROUND_TO_NEAREST_INT));
+        std::memcpy(out + i, t, (count - i) * sizeof(uint16_t));
+    }
+}
+
+void FromHalf(uint16_t const* in, float* out, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i h = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i));
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+    }
+    if (i < count) {
+        alignas(16) uint16_t t[8] = {};
+        std::memcpy(t, in + i, (count - i) * sizeof(uint16_t));
+        __m256 f = _mm256_cvtph_ps(_mm_load_si128(reinterpret_cast<__m128i const*>(t)));
+        _mm256_maskstore_ps(out + i, TailMask(count - i), f);
+    }
+}
+
+// smallest3 from xo-math-packed.h over 8 quaternions held as one register per component.
+// Returns the index of the largest magnitude component of each (the first one on a tie)
+// and the other three in kept, negated where the largest is negative.
+XO_INL __m256i SplitLargest(__m256 const q[4], __m256 kept[3]) {
+    __m256 const signBit = _mm256_set1_ps(-0.f);
+    __m256 a[4];
+    for (int k = 0; k < 4; ++k) a[k] = _mm256_andnot_ps(signBit, q[k]);
+    __m256 const top = _mm256_max_ps(_mm256_max_ps(a[0], a[1]), _mm256_max_ps(a[2], a[3]));
+    // le1 is "the index is at most 1" and so on, the index is 3 minus how many are set.
+    __m256 const is0 = _mm256_cmp_ps(a[0], top, _CMP_EQ_OQ);
+    __m256 const le1 = _mm256_or_ps(is0, _mm256_cmp_ps(a[1], top, _CMP_EQ_OQ));
+    __m256 const le2 = _mm256_or_ps(le1, _mm256_cmp_ps(a[2], top, _CMP_EQ_OQ));
+    __m256i const m = _mm256_add_epi32(_mm256_set1_epi32(3),
+                                       _mm256_add_epi32(_mm256_castps_si256(is0),
+                                                        _mm256_add_epi32(_mm256_castps_si256(le1),
+                                                                         _mm256_castps_si256(le2))));
+    __m256 const largest = _mm256_blendv_ps(_mm256_blendv_ps(_mm256_blendv_ps(q[3], q[2], le2), q[1], le1), q[0], is0);
+    __m256 const flip = _mm256_and_ps(_mm256_cmp_ps(largest, _mm256_setzero_ps(), _CMP_LT_OQ), signBit);
+    kept[0] = _mm256_xor_ps(_mm256_blendv_ps(q[0], q[1], is0), flip);
+    kept[1] = _mm256_xor_ps(_mm256_blendv_ps(q[1], q[2], le1), flip);
+    kept[2] = _mm256_xor_ps(_mm256_blendv_ps(q[2], q[3], le2), flip);
+    return m;
+}
+
+template<int Bits>
+XO_INL __m256i Quantize(__m256 c) {
+    typedef smallest3::Format<Bits> F;
+    __m256 const scaled = _mm256_mul_ps(_mm256_add_ps(c, _mm256_set1_ps(smallest3::Bound)), _mm256_set1_ps(F::Scale));
+    __m256i const v = _mm256_max_epi32(_mm256_cvtps_epi32(scaled), _mm256_setzero_si256());
+    return _mm256_min_epi32(v, _mm256_set1_epi32(static_cast<int>(F::Max)));
+}
+
+template<int Bits>
+XO_INL __m256 Dequantize(__m256i value) {
+    typedef smallest3::Format<Bits> F;
+    return _mm256_mul_ps(_mm256_sub_ps(_mm256_cvtepi32_ps(value), _mm256_set1_ps(F::Middle)), _mm256_set1_ps(F::Step));
+}
+
+// The quaternions with component m rebuilt from the kept a, b and c.
+XO_INL void JoinLargest(__m256i m, __m256 a, __m256 b, __m256 c, __m256 q[4]) {
+    __m256 d = _mm256_fnmadd_ps(a, a, _mm256_set1_ps(1.f));
+    d = _mm256_fnmadd_ps(b, b, d);
+    d = _mm256_fnmadd_ps(c, c, d);
+    d = _mm256_sqrt_ps(_mm256_max_ps(d, _mm256_setzero_ps()));
+    __m256 is[4], above[3];
+    for (int k = 0; k < 4; ++k) is[k] = _mm256_castsi256_ps(_mm256_cmpeq_epi32(m, _mm256_set1_epi32(k)));
+    for (int k = 0; k < 3; ++k) above[k] = _mm256_castsi256_ps(_mm256_cmpgt_epi32(m, _mm256_set1_epi32(k)));
+    q[0] = _mm256_blendv_ps(a, d, is[0]);
+    q[1] = _mm256_blendv_ps(_mm256_blendv_ps(a, d, is[1]), b, above[1]);
+    q[2] = _mm256_blendv_ps(_mm256_blendv_ps(b, d, is[2]), c, above[2]);
+    q[3] = _mm256_blendv_ps(c, d, is[3]);
+}
+
+// 8 values under 65536 to 16 bits each.
+XO_INL __m128i Narrow16(__m256i v) {
+    return _mm256_castsi256_si128(_mm256_permute4x64_epi64(_mm256_packus_epi32(v, v), _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+void Pack32(Quaternion const* in, uint32_t* out, size_t count) {
+    for (size_t i = 0; i < count; i += 8) {
+        size_t const n = count - i < 8 ? count - i : 8;
+        __m256 q[4], kept[3];
+        Load4(in[i].vec4.v, n * 4, q);
+        __m256i const m = SplitLargest(q, kept);
+        __m256i v = _mm256_or_si256(_mm256_slli_epi32(m, 30), _mm256_slli_epi32(Quantize<10>(kept[0]), 20));
+        v = _mm256_or_si256(v, _mm256_or_si256(_mm256_slli_epi32(Quantize<10>(kept[1]), 10), Quantize<10>(kept[2])));
+        if (n == 8) _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+        else _mm256_maskstore_epi32(reinterpret_cast<int*>(out + i), TailMask(n), v);
+    }
+}
+
+void Unpack32(uint32_t const* in, Quaternion* out, size_t count) {
+    __m256i const bits10 = _mm256_set1_epi32(0x3FF);
+    for (size_t i = 0; i < count; i += 8) {
+        size_t const n = count - i < 8 ? count - i : 8;
+        __m256i const v = n == 8 ? _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in + i))
+                                 : _mm256_maskload_epi32(reinterpret_cast<int const*>(in + i), TailMask(n));
+        __m256 q[4];
+        JoinLargest(_mm256_srli_epi32(v, 30),
+                    Dequantize<10>(_mm256_and_si256(_mm256_srli_epi32(v, 20), bits10)),
+                    Dequantize<10>(_mm256_and_si256(_mm256_srli_epi32(v, 10), bits10)),
+                    Dequantize<10>(_mm256_and_si256(v, bits10)), q);
+        Store4(out[i].vec4.v, n * 4, q);
+    }
+}
+
+// PackedQuaternion48 arrays are flat runs of words, 8 quaternions are 24 of them. They're
+// widened to 32 bits and split into one register per word with Deinterleave3.
+void Pack48(Quaternion const* in, uint16_t* out, size_t count) {
+    for (size_t i = 0; i < count; i += 8) {
+        size_t const n = count - i < 8 ? count - i : 8;
+        __m256 q[4], kept[3];
+        Load4(in[i].vec4.v, n * 4, q);
+        __m256i const m = SplitLargest(q, kept);
+        __m256i const one = _mm256_set1_epi32(1);
+        __m256 w[3] = {
+            _mm256_castsi256_ps(_mm256_or_si256(Quantize<15>(kept[0]), _mm256_slli_epi32(_mm256_and_si256(m, one), 15))),
+            _mm256_castsi256_ps(_mm256_or_si256(Quantize<15>(kept[1]), _mm256_slli_epi32(_mm256_srli_epi32(m, 1), 15))),
+            _mm256_castsi256_ps(Quantize<15>(kept[2])) };
+        alignas(16) uint16_t t[24];
+        uint16_t* dst = n == 8 ? out + i * 3 : t;
+        for (int r = 0; r < 3; ++r) {
+            __m128i const h = Narrow16(_mm256_castps_si256(Interleave3(w[0], w[1], w[2], r)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + r * 8), h);
+        }
+        if (n < 8) std::memcpy(out + i * 3, t, n * 3 * sizeof(uint16_t));
+    }
+}
+
+void Unpack48(uint16_t const* in, Quaternion* out, size_t count) {
+    __m256i const bits15 = _mm256_set1_epi32(0x7FFF);
+    for (size_t i = 0; i < count; i += 8) {
+        size_t const n = count - i < 8 ? count - i : 8;
+        alignas(16) uint16_t t[24] = {};
+        uint16_t const* src = in + i * 3;
+        if (n < 8) {
+            std::memcpy(t, src, n * 3 * sizeof(uint16_t));
+            src = t;
+        }
+        __m256 r[3];
+        for (int k = 0; k < 3; ++k) {
+            __m128i const h = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + k * 8));
+            r[k] = _mm256_castsi256_ps(_mm256_cvtepu16_epi32(h));
+        }
+        __m256i w[3];
+        for (int k = 0; k < 3; ++k) w[k] = _mm256_castps_si256(Deinterleave3(r[0], r[1], r[2], k));
+        __m256i const m = _mm256_or_si256(_mm256_srli_epi32(w[0], 15), _mm256_slli_epi32(_mm256_srli_epi32(w[1], 15), 1));
+        __m256 q[4];
+        JoinLargest(m,
+                    Dequantize<15>(_mm256_and_si256(w[0], bits15)),
+                    Dequantize<15>(_mm256_and_si256(w[1], bits15)),
+                    Dequantize<15>(_mm256_and_si256(w[2], bits15)), q);
+        Store4(out[i].vec4.v, n * 4, q);
+    }
+}
+
+// octahedral from xo-math-packed.h over 8 vectors held as x, y and z. Returns each
+// vector's quantized coordinates as qx | qy << Bits.
+template<int Bits>
+XO_INL __m256i PackNormals(__m256 x, __m256 y, __m256 z) {
+    typedef octahedral::Format<Bits> F;
+    __m256 const signBit = _mm256_set1_ps(-0.f);
+    __m256 const zero = _mm256_setzero_ps();
+    __m256 const one = _mm256_set1_ps(1.f);
+    __m256 const sum = _mm256_add_ps(_mm256_add_ps(_mm256_andnot_ps(signBit, x), _mm256_andnot_ps(signBit, y)),
+                                     _mm256_andnot_ps(signBit, z));
+    __m256 px = _mm256_div_ps(x, sum);
+    __m256 py = _mm256_div_ps(y, sum);
+    __m256 const fx = _mm256_xor_ps(_mm256_sub_ps(one, _mm256_andnot_ps(signBit, py)),
+                                    _mm256_and_ps(_mm256_cmp_ps(px, zero, _CMP_LT_OQ), signBit));
+    __m256 const fy = _mm256_xor_ps(_mm256_sub_ps(one, _mm256_andnot_ps(signBit, px)),
+                                    _mm256_and_ps(_mm256_cmp_ps(py, zero, _CMP_LT_OQ), signBit));
+    __m256 const lower = _mm256_cmp_ps(z, zero, _CMP_LT_OQ);
+    px = _mm256_blendv_ps(px, fx, lower);
+    py = _mm256_blendv_ps(py, fy, lower);
+    __m256 const scale = _mm256_set1_ps(F::Scale);
+    __m256i const max = _mm256_set1_epi32(static_cast<int>(F::Max));
+    __m256i qx = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_add_ps(px, one), scale));
+    __m256i qy = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_add_ps(py, one), scale));
+    qx = _mm256_min_epi32(_mm256_max_epi32(qx, _mm256_setzero_si256()), max);
+    qy = _mm256_min_epi32(_mm256_max_epi32(qy, _mm256_setzero_si256()), max);
+    return _mm256_or_si256(qx, _mm256_slli_epi32(qy, Bits));
+}
+
+// The unit vectors for 8 values of qx | qy << Bits, as x, y and z.
+template<int Bits>
+XO_INL void UnpackNormals(__m256i v, __m256& x, __m256& y, __m256& z) {
+    typedef octahedral::Format<Bits> F;
+    __m256 const signBit = _mm256_set1_ps(-0.f);
+    __m256 const zero = _mm256_setzero_ps();
+    __m256i const mask = _mm256_set1_epi32((1 << Bits) - 1);
+    __m256 const middle = _mm256_set1_ps(F::Middle);
+    __m256 const step = _mm256_set1_ps(F::Step);
+    __m256 px = _mm256_mul_ps(_mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_and_si256(v, mask)), middle), step);
+    __m256 py = _mm256_mul_ps(_mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(v, Bits), mask)), middle), step);
+    __m256 const pz = _mm256_sub_ps(_mm256_sub_ps(_mm256_set1_ps(1.f), _mm256_andnot_ps(signBit, px)),
+                                    _mm256_andnot_ps(signBit, py));
+    __m256 const t = _mm256_max_ps(_mm256_xor_ps(pz, signBit), zero);
+    // px + t where px < 0, px - t elsewhere.
+    px = _mm256_add_ps(px, _mm256_xor_ps(t, _mm256_andnot_ps(_mm256_cmp_ps(px, zero, _CMP_LT_OQ), signBit)));
+    py = _mm256_add_ps(py, _mm256_xor_ps(t, _mm256_andnot_ps(_mm256_cmp_ps(py, zero, _CMP_LT_OQ), signBit)));
+    __m256 const length = _mm256_sqrt_ps(_mm256_fmadd_ps(px, px, _mm256_fmadd_ps(py, py, _mm256_mul_ps(pz, pz))));
+    x = _mm256_div_ps(px, length);
+    y = _mm256_div_ps(py, length);
+    z = _mm256_div_ps(pz, length);
+}
+
+void PackNormals32(Vector3 const* in, uint32_t* out, size_t count) {
+    for (size_t i = 0; i < count; i += 8) {
+        size_t const n = count - i < 8 ? count - i : 8;
+        __m256 r0, r1, r2;
+        Load3(&in[i].x, n * 3, r0, r1, r2);
+        __m256i const v = PackNormals<16>(Deinterleave3(r0, r1, r2, 0),
+                                          Deinterleave3(r0, r1, r2, 1),
+                                          Deinterleave3(r0, r1, r2, 2));
+        if (n == 8) _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+        else _mm256_maskstore_epi32(reinterpret_cast<int*>(out + i), TailMask(n), v);
+    }
+}
+
+void UnpackNormals32(uint32_t const* in, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; i += 8) {
+        size_t const n = count - i < 8 ? count - i : 8;
+        __m256i const v = n == 8 ? _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in + i))
+                                 : _mm256_maskload_epi32(reinterpret_cast<int const*>(in + i), TailMask(n));
+        __m256 x, y, z;
+        UnpackNormals<16>(v, x, y, z);
+        Store3(&out[i].x, n * 3, Interleave3(x, y, z, 0), Interleave3(x, y, z, 1), Interleave3(x, y, z, 2));
+    }
+}
+
+void PackNormals16(Vector3 const* in, uint16_t* out, size_t count) {
+    for (size_t i = 0; i < count; i += 8) {
+        size_t const n = count - i < 8 ? count - i : 8;
+        __m256 r0, r1, r2;
+        Load3(&in[i].x, n * 3, r0, r1, r2);
+        __m128i const v = Narrow16(PackNormals<8>(Deinterleave3(r0, r1, r2, 0),
+                                                  Deinterleave3(r0, r1, r2, 1),
+                                                  Deinterleave3(r0, r1, r2, 2)));
+        if (n == 8) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), v);
+        }
+        else {
+            alignas(16) uint16_t t[8];
+            _mm_store_si128(reinterpret_cast<__m128i*>(t), v);
+            std::memcpy(out + i, t, n * sizeof(uint16_t));
+        }
+    }
+}
+
+void UnpackNormals16(uint16_t const* in, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; i += 8) {
+        size_t const n = count - i < 8 ? count - i : 8;
+        alignas(16) uint16_t t[8] = {};
+        uint16_t const* src = in + i;
+        if (n < 8) {
+            std::memcpy(t, src, n * sizeof(uint16_t));
+            src = t;
+        }
+        __m256i const v = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(src)));
+        __m256 x, y, z;
+        UnpackNormals<8>(v, x, y, z);
+        Store3(&out[i].x, n * 3, Interleave3(x, y, z, 0), Interleave3(x, y, z, 1), Interleave3(x, y, z, 2));
+    }
+}
+
+} } // ::xo::avx2
+#if defined(__clang__)
+#   pragma clang attribute pop
+#elif defined(__GNUC__)
+#   pragma GCC pop_options
+#endif
+#else
+#define XO_BATCH_AVX2 0
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////// end xo-math-avx2.h inline
+////////////////////////////////////////////////////////////////////////////////////////// xo-math-avx512.h inlined
+#line 6 "xo-math-avx512.h"
+#if !defined(XO_CONFIG_RUNTIME_DISPATCH)
+#   define XO_CONFIG_RUNTIME_DISPATCH 1
+#endif
+
+#if defined(XO_MATH_IMPL) && XO_X86 && (XO_CONFIG_RUNTIME_DISPATCH || XO_SSE_CURRENT >= XO_AVX512)
+#define XO_BATCH_AVX512 1
+#include <immintrin.h>
+// Everything in here is compiled for AVX512F regardless of the flags of the translation
+// unit. It's only called through the batch kernel table after the cpu has been checked.
+#if defined(__clang__)
+#   pragma clang attribute push (__attribute__((target("avx512f"))), apply_to = function)
+#elif defined(__GNUC__)
+#   pragma GCC push_options
+#   pragma GCC target("avx512f")
+// gcc's own avx512fintrin.h trips these for the masked loads and gathers.
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wuninitialized"
+#   pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+namespace xo { namespace avx512 {
+// 16 wide kernels over contiguous arrays, see xo-math-batch.h. Every block is loaded and
+// stored with a lane mask, so the tail of an array never needs a scalar loop and nothing
+// past the end of an array is touched.
+
+XO_INL __mmask16 TailMask(size_t count) {
+    return count >= 16 ? __mmask16(0xFFFF) : __mmask16((1u << count) - 1u);
+}
+
+XO_INL __m512i Lanes() {
+    return _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+}
+
+// Loads up to 48 floats (16 Vector3s), zeroing anything past 'floats'.
+XO_INL void Load3(float const* in, size_t floats, __m512& r0, __m512& r1, __m512& r2) {
+    r0 = _mm512_maskz_loadu_ps(TailMask(floats), in);
+    r1 = _mm512_maskz_loadu_ps(TailMask(floats > 16 ? floats - 16 : 0), in + 16);
+    r2 = _mm512_maskz_loadu_ps(TailMask(floats > 32 ? floats - 32 : 0), in + 32);
+}
+
+XO_INL void Store3(float* out, size_t floats, __m512 r0, __m512 r1, __m512 r2) {
+    _mm512_mask_storeu_ps(out, TailMask(floats), r0);
+    _mm512_mask_storeu_ps(out + 16, TailMask(floats > 16 ? floats - 16 : 0), r1);
+    _mm512_mask_storeu_ps(out + 32, TailMask(floats > 32 ? floats - 32 : 0), r2);
+}
+
+// Picks component c (0 = x, 1 = y, 2 = z) of 16 interleaved Vector3s held in r0, r1, r2.
+XO_INL __m512 Deinterleave3(__m512 r0, __m512 r1, __m512 r2, int c) {
+    __m512i k = _mm512_add_epi32(_mm512_mullo_epi32(Lanes(), _mm512_set1_epi32(3)),
+                                 _mm512_set1_epi32(c));
+    __m512 lo = _mm512_permutex2var_ps(r0, k, r1);
+    __mmask16 fromHigh = _mm512_cmpge_epi32_mask(k, _mm512_set1_epi32(32));
+    return _mm512_mask_permutexvar_ps(lo, fromHigh, _mm512_sub_epi32(k, _mm512_set1_epi32(32)), r2);
+}
+
+// Builds register r (0, 1 or 2) of the interleaved form of 16 Vector3s held as x, y, z.
+XO_INL __m512 Interleave3(__m512 x, __m512 y, __m512 z, int r) {
+    __m512i k = _mm512_add_epi32(Lanes(), _mm512_set1_epi32(16 * r));
+    // k / 3 for k < 48
+    __m512i vec = _mm512_srli_epi32(_mm512_mullo_epi32(k, _mm512_set1_epi32(0xAAAB)), 17);
+    __m512i c = _mm512_sub_epi32(k, _mm512_mullo_epi32(vec, _mm512_set1_epi32(3)));
+    __mmask16 isY = _mm512_cmpeq_epi32_mask(c, _mm512_set1_epi32(1));
+    __mmask16 isZ = _mm512_cmpeq_epi32_mask(c, _mm512_set1_epi32(2));
+    __m512 xy = _mm512_mask_permutexvar_ps(_mm512_permutexvar_ps(vec, x), isY, vec, y);
+    return _mm512_mask_permutexvar_ps(xy, isZ, vec, z);
+}
+
+// Sums each group of 4 lanes and broadcasts the sum back to the group.
+XO_INL __m512 SumQuads(__m512 m) {
+    m = _mm512_add_ps(m, _mm512_permute_ps(m, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm512_add_ps(m, _mm512_permute_ps(m, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+struct AddOp      { static XO_INL __m512 Apply(__m512 l, __m512 r) { return _mm512_add_ps(l, r); } };
+struct SubtractOp { static XO_INL __m512 Apply(__m512 l, __m512 r) { return _mm512_sub_ps(l, r); } };
+struct MultiplyOp { static XO_INL __m512 Apply(__m512 l, __m512 r) { return _mm512_mul_ps(l, r); } };
+struct DivideOp   { static XO_INL __m512 Apply(__m512 l, __m512 r) { return _mm512_div_ps(l, r); } };
+
+// An array of Vector3s or Vector4s as the floats it's made of. Casts the pointer rather than
+// taking &in->x, so an empty array may be null.
+template<typename T>
+XO_INL float const* Floats(T const* vectors) { return reinterpret_cast<float const*>(vectors); }
+template<typename T>
+XO_INL float* Floats(T* vectors) { return reinterpret_cast<float*>(vectors); }
+
+template<typename Op>
+XO_INL void Elementwise(float const* left, float const* right, float* out, size_t floats) {
+    size_t i = 0;
+    for (; i + 16 <= floats; i += 16) {
+        _mm512_storeu_ps(out + i, Op::Apply(_mm512_loadu_ps(left + i), _mm512_loadu_ps(right + i)));
+    }
+    if (i < floats) {
+        __mmask16 m = TailMask(floats - i);
+        // masked off lanes are zero in both inputs, DivideOp's 0/0 there is never stored.
+        __m512 l = _mm512_maskz_loadu_ps(m, left + i);
+        __m512 r = _mm512_maskz_loadu_ps(m, right + i);
+        _mm512_mask_storeu_ps(out + i, m, Op::Apply(l, r));
+    }
+}
+
+XO_INL void LerpFloats(float const* left, float const* right, float t, float* out, size_t floats) {
+    __m512 tt = _mm512_set1_ps(t);
+    for (size_t i = 0; i < floats; i += 16) {
+        __mmask16 m = TailMask(floats - i);
+        __m512 l = _mm512_maskz_loadu_ps(m, left + i);
+        __m512 r = _mm512_maskz_loadu_ps(m, right + i);
+        _mm512_mask_storeu_ps(out + i, m, _mm512_fmadd_ps(tt, _mm512_sub_ps(r, l), l));
+    }
+}
+
+void Add3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Elementwise<AddOp>(Floats(left), Floats(right), Floats(out), count * 3);
+}
+
+void Subtract3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Elementwise<SubtractOp>(Floats(left), Floats(right), Floats(out), count * 3);
+}
+
+void Multiply3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Elementwise<MultiplyOp>(Floats(left), Floats(right), Floats(out), count * 3);
+}
+
+void Divide3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Elementwise<DivideOp>(Floats(left), Floats(right), Floats(out), count * 3);
+}
+
+void DotProduct3(Vector3 const* left, Vector3 const* right, float* out, size_t count) {
+    float const* l = Floats(left);
+    float const* r = Floats(right);
+    for (size_t i = 0; i < count; i += 16) {
+        size_t floats = (count - i) * 3;
+        __m512 l0, l1, l2, r0, r1, r2;
+        Load3(l + i * 3, floats, l0, l1, l2);
+        Load3(r + i * 3, floats, r0, r1, r2);
+        __m512 d = _mm512_mul_ps(Deinterleave3(l0, l1, l2, 0), Deinterleave3(r0, r1, r2, 0));
+        d = _mm512_fmadd_ps(Deinterleave3(l0, l1, l2, 1), Deinterleave3(r0, r1, r2, 1), d);
+        d = _mm512_fmadd_ps(Deinterleave3(l0, l1, l2, 2), Deinterleave3(r0, r1, r2, 2), d);
+        _mm512_mask_storeu_ps(out + i, TailMask(count - i), d);
+    }
+}
+
+void CrossProduct3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    float const* l = Floats(left);
+    float const* r = Floats(right);
+    for (size_t i = 0; i < count; i += 16) {
+        size_t floats = (count - i) * 3;
+        __m512 l0, l1, l2, r0, r1, r2;
+        Load3(l + i * 3, floats, l0, l1, l2);
+        Load3(r + i * 3, floats, r0, r1, r2);
+        __m512 lx = Deinterleave3(l0, l1, l2, 0);
+        __m512 ly = Deinterleave3(l0, l1, l2, 1);
+        __m512 lz = Deinterleave3(l0, l1, l2, 2);
+        __m512 rx = Deinterleave3(r0, r1, r2, 0);
+        __m512 ry = Deinterleave3(r0, r1, r2, 1);
+        __m512 rz = Deinterleave3(r0, r1, r2, 2);
+        __m512 x = _mm512_fmsub_ps(ly, rz, _mm512_mul_ps(lz, ry));
+        __m512 y = _mm512_fmsub_ps(lz, rx, _mm512_mul_ps(lx, rz));
+        __m512 z = _mm512_fmsub_ps(lx, ry, _mm512_mul_ps(ly, rx));
+        Store3(Floats(out) + i * 3, floats,
+               Interleave3(x, y, z, 0), Interleave3(x, y, z, 1), Interleave3(x, y, z, 2));
+    }
+}
+
+// 1/sqrt(m) for Precision::Fast and Fastest: rsqrt14 is good to 2^-14 on its own, Fast
+// adds one Newton-Raphson step r * (1.5 - 0.5 * m * r * r).
+XO_INL __m512 InverseSqrt(__m512 m, Precision precision) {
+    __m512 r = _mm512_rsqrt14_ps(m);
+    if (precision == Precision::Fastest) {
+        return r;
+    }
+    __m512 halfMR = _mm512_mul_ps(_mm512_mul_ps(_mm512_set1_ps(0.5f), m), r);
+    return _mm512_mul_ps(r, _mm512_fnmadd_ps(halfMR, r, _mm512_set1_ps(1.5f)));
+}
+
+void Normalize3(Vector3 const* in, Vector3* out, size_t count, Precision precision) {
+    for (size_t i = 0; i < count; i += 16) {
+        size_t floats = (count - i) * 3;
+        __m512 r0, r1, r2;
+        Load3(Floats(in) + i * 3, floats, r0, r1, r2);
+        __m512 x = Deinterleave3(r0, r1, r2, 0);
+        __m512 y = Deinterleave3(r0, r1, r2, 1);
+        __m512 z = Deinterleave3(r0, r1, r2, 2);
+        __m512 lengthSquared = _mm512_fmadd_ps(z, z, _mm512_fmadd_ps(y, y, _mm512_mul_ps(x, x)));
+        if (precision == Precision::Exact) {
+            __m512 len = _mm512_sqrt_ps(lengthSquared);
+            x = _mm512_div_ps(x, len);
+            y = _mm512_div_ps(y, len);
+            z = _mm512_div_ps(z, len);
+        }
+        else {
+            __m512 scale = InverseSqrt(lengthSquared, precision);
+            x = _mm512_mul_ps(x, scale);
+            y = _mm512_mul_ps(y, scale);
+            z = _mm512_mul_ps(z, scale);
+        }
+        Store3(Floats(out) + i * 3, floats,
+               Interleave3(x, y, z, 0), Interleave3(x, y, z, 1), Interleave3(x, y, z, 2));
+    }
+}
+
+void Lerp3(Vector3 const* left, Vector3 const* right, float t, Vector3* out, size_t count) {
+    LerpFloats(Floats(left), Floats(right), t, Floats(out), count * 3);
+}
+
+void Add4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Elementwise<AddOp>(Floats(left), Floats(right), Floats(out), count * 4);
+}
+
+void Subtract4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Elementwise<SubtractOp>(Floats(left), Floats(right), Floats(out), count * 4);
+}
+
+void Multiply4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Elementwise<MultiplyOp>(Floats(left), Floats(right), Floats(out), count * 4);
+}
+
+void Divide4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Elementwise<DivideOp>(Floats(left), Floats(right), Floats(out), count * 4);
+}
+
+void DotProduct4(Vector4 const* left, Vector4 const* right, float* out, size_t count) {
+    // Lane 4q+m of the blended sums holds the dot product of vector 4m+q in the block.
+    __m512i quad = _mm512_and_epi32(Lanes(), _mm512_set1_epi32(3));
+    __m512i order = _mm512_or_epi32(_mm512_slli_epi32(quad, 2), _mm512_srli_epi32(Lanes(), 2));
+    for (size_t i = 0; i < count; i += 16) {
+        size_t floats = (count - i) * 4;
+        __m512 s[4];
+        for (int m = 0; m < 4; ++m) {
+            __mmask16 mask = TailMask(floats > size_t(m) * 16 ? floats - m * 16 : 0);
+            __m512 l = _mm512_maskz_loadu_ps(mask, left[i].v + m * 16);
+            __m512 r = _mm512_maskz_loadu_ps(mask, right[i].v + m * 16);
+            s[m] = SumQuads(_mm512_mul_ps(l, r));
+        }
+        __m512 d = _mm512_mask_blend_ps(0x2222, s[0], s[1]);
+        d = _mm512_mask_blend_ps(0x4444, d, s[2]);
+        d = _mm512_mask_blend_ps(0x8888, d, s[3]);
+        _mm512_mask_storeu_ps(out + i, TailMask(count - i), _mm512_permutexvar_ps(order, d));
+    }
+}
+
+void Normalize4(Vector4 const* in, Vector4* out, size_t count, Precision precision) {
+    size_t floats = count * 4;
+    for (size_t i = 0; i < floats; i += 16) {
+        __mmask16 m = TailMask(floats - i);
+        __m512 v = _mm512_maskz_loadu_ps(m, Floats(in) + i);
+        __m512 lengthSquared = SumQuads(_mm512_mul_ps(v, v));
+        if (precision == Precision::Exact) {
+            v = _mm512_div_ps(v, _mm512_sqrt_ps(lengthSquared));
+        }
+        else {
+            v = _mm512_mul_ps(v, InverseSqrt(lengthSquared, precision));
+        }
+        _mm512_mask_storeu_ps(Floats(out) + i, m, v);
+    }
+}
+
+void Lerp4(Vector4 const* left, Vector4 const* right, float t, Vector4* out, size_t count) {
+    LerpFloats(Floats(left), Floats(right), t, Floats(out), count * 4);
+}
+
+// Splits 16 Quaternions (or Vector4s) held four to a register in a0..a3 into one register
+// per component, in array order.
+XO_INL void Deinterleave4(__m512 a0, __m512 a1, __m512 a2, __m512 a3, __m512 c[4]) {
+    // A 4x4 transpose in each 128 bit lane leaves lane 4q+m holding element 4m+q.
+    __m512i quad = _mm512_and_epi32(Lanes(), _mm512_set1_epi32(3));
+    __m512i order = _mm512_or_epi32(_mm512_slli_epi32(quad, 2), _mm512_srli_epi32(Lanes(), 2));
+    __m512 t0 = _mm512_unpacklo_ps(a0, a1);
+    __m512 t1 = _mm512_unpackhi_ps(a0, a1);
+    __m512 t2 = _mm512_unpacklo_ps(a2, a3);
+    __m512 t3 = _mm512_unpackhi_ps(a2, a3);
+    c[0] = _mm512_permutexvar_ps(order, _mm512_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)));
+    c[1] = _mm512_permutexvar_ps(order, _mm512_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)));
+    c[2] = _mm512_permutexvar_ps(order, _mm512_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)));
+    c[3] = _mm512_permutexvar_ps(order, _mm512_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2)));
+}
+
+// Loads up to 64 floats (16 Quaternions or Vector4s) split into one register per
+// component, zeroing anything past 'floats'.
+XO_INL void Load4(float const* in, size_t floats, __m512 c[4]) {
+    __m512 a[4];
+    for (int m = 0; m < 4; ++m) {
+        a[m] = _mm512_maskz_loadu_ps(TailMask(floats > size_t(m) * 16 ? floats - m * 16 : 0), in + m * 16);
+    }
+    Deinterleave4(a[0], a[1], a[2], a[3], c);
+}
+
+// Undoes Deinterleave4 and stores the first 'floats' floats. The reordering there swaps
+// lanes 4q+m and 4m+q, so it undoes itself.
+XO_INL void Store4(float* out, size_t floats, __m512 const c[4]) {
+    __m512i quad = _mm512_and_epi32(Lanes(), _mm512_set1_epi32(3));
+    __m512i order = _mm512_or_epi32(_mm512_slli_epi32(quad, 2), _mm512_srli_epi32(Lanes(), 2));
+    __m512 p[4];
+    for (int m = 0; m < 4; ++m) p[m] = _mm512_permutexvar_ps(order, c[m]);
+    __m512 t0 = _mm512_unpacklo_ps(p[0], p[1]);
+    __m512 t1 = _mm512_unpackhi_ps(p[0], p[1]);
+    __m512 t2 = _mm512_unpacklo_ps(p[2], p[3]);
+    __m512 t3 = _mm512_unpackhi_ps(p[2], p[3]);
+    __m512 a[4] = {
+        _mm512_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)),
+        _mm512_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)),
+        _mm512_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)),
+        _mm512_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2)) };
+    for (int m = 0; m < 4; ++m) {
+        _mm512_mask_storeu_ps(out + m * 16, TailMask(floats > size_t(m) * 16 ? floats - m * 16 : 0), a[m]);
+    }
+}
+
+// v + 2r(q x v) + q x 2(q x v), see Quaternion::Rotate.
+void Rotate3(Quaternion const* rotations, Vector3 const* in, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; i += 16) {
+        __m512 q[4];
+        Load4(rotations[i].vec4.v, (count - i) * 4, q);
+        __m512 r0, r1, r2;
+        Load3(Floats(in) + i * 3, (count - i) * 3, r0, r1, r2);
+        __m512 x = Deinterleave3(r0, r1, r2, 0);
+        __m512 y = Deinterleave3(r0, r1, r2, 1);
+        __m512 z = Deinterleave3(r0, r1, r2, 2);
+        __m512 two = _mm512_set1_ps(2.f);
+        __m512 tx = _mm512_mul_ps(two, _mm512_fmsub_ps(q[1], z, _mm512_mul_ps(q[2], y)));
+        __m512 ty = _mm512_mul_ps(two, _mm512_fmsub_ps(q[2], x, _mm512_mul_ps(q[0], z)));
+        __m512 tz = _mm512_mul_ps(two, _mm512_fmsub_ps(q[0], y, _mm512_mul_ps(q[1], x)));
+        x = _mm512_add_ps(_mm512_fmadd_ps(q[3], tx, x), _mm512_fmsub_ps(q[1], tz, _mm512_mul_ps(q[2], ty)));
+        y = _mm512_add_ps(_mm512_fmadd_ps(q[3], ty, y), _mm512_fmsub_ps(q[2], tx, _mm512_mul_ps(q[0], tz)));
+        z = _mm512_add_ps(_mm512_fmadd_ps(q[3], tz, z), _mm512_fmsub_ps(q[0], ty, _mm512_mul_ps(q[1], tx)));
+        Store3(Floats(out) + i * 3, (count - i) * 3,
+               Interleave3(x, y, z, 0), Interleave3(x, y, z, 1), Interleave3(x, y, z, 2));
+    }
+}
+
+XO_INL float const* At(float const* base, size_t index, size_t stride) {
+    return reinterpret_cast<float const*>(reinterpret_cast<char const*>(base) + index * stride);
+}
+
+XO_INL float* At(float* base, size_t index, size_t stride) {
+    return reinterpret_cast<float*>(reinterpret_cast<char*>(base) + index * stride);
+}
+
+// out = (in.xyz, w) times m as a row vector, 16 vectors at a time. Strides are in bytes, tightly
+// packed arrays are deinterleaved in registers, anything else is gathered and scattered.
+void Transform3(float const* m,
+                float const* in, size_t inStride,
+                float* out, size_t outStride,
+                size_t count, float w) {
+    __m512 r[3][4];
+    for (int i = 0; i < 3; ++i) {
+        r[i][0] = _mm512_set1_ps(m[i]);
+        r[i][1] = _mm512_set1_ps(m[4 + i]);
+        r[i][2] = _mm512_set1_ps(m[8 + i]);
+        r[i][3] = _mm512_set1_ps(m[12 + i] * w);
+    }
+    bool const packedIn = inStride == 3 * sizeof(float);
+    bool const packedOut = outStride == 3 * sizeof(float);
+    __m512i const inOffsets = _mm512_mullo_epi32(Lanes(), _mm512_set1_epi32(static_cast<int>(inStride)));
+    __m512i const outOffsets = _mm512_mullo_epi32(Lanes(), _mm512_set1_epi32(static_cast<int>(outStride)));
+    for (size_t i = 0; i < count; i += 16) {
+        size_t const n = count - i < 16 ? count - i : 16;
+        __mmask16 const mask = TailMask(n);
+        float const* src = At(in, i, inStride);
+        __m512 x, y, z;
+        if (packedIn) {
+            __m512 r0, r1, r2;
+            Load3(src, n * 3, r0, r1, r2);
+            x = Deinterleave3(r0, r1, r2, 0);
+            y = Deinterleave3(r0, r1, r2, 1);
+            z = Deinterleave3(r0, r1, r2, 2);
+        }
+        else {
+            __m512 const zero = _mm512_setzero_ps();
+            x = _mm512_mask_i32gather_ps(zero, mask, inOffsets, src, 1);
+            y = _mm512_mask_i32gather_ps(zero, mask, inOffsets, src + 1, 1);
+            z = _mm512_mask_i32gather_ps(zero, mask, inOffsets, src + 2, 1);
+        }
+        __m512 o[3];
+        for (int j = 0; j < 3; ++j) {
+            o[j] = _mm512_fmadd_ps(r[j][0], x, _mm512_fmadd_ps(r[j][1], y, _mm512_fmadd_ps(r[j][2], z, r[j][3])));
+        }
+        float* dst = At(out, i, outStride);
+        if (packedOut) {
+            Store3(dst, n * 3,
+                   Interleave3(o[0], o[1], o[2], 0),
+                   Interleave3(o[0], o[1], o[2], 1),
+                   Interleave3(o[0], o[1], o[2], 2));
+        }
+        else {
+            _mm512_mask_i32scatter_ps(dst, mask, outOffsets, o[0], 1);
+            _mm512_mask_i32scatter_ps(dst + 1, mask, outOffsets, o[1], 1);
+            _mm512_mask_i32scatter_ps(dst + 2, mask, outOffsets, o[2], 1);
+        }
+    }
+}
+
+// out = in * m for Vector4s, four per register. Lane 4v+c reads component c of vector v.
+void Transform4(float const* m,
+                float const* in, size_t inStride,
+                float* out, size_t outStride,
+                size_t count) {
+    __m512 row[4];
+    for (int j = 0; j < 4; ++j) {
+        row[j] = _mm512_broadcast_f32x4(_mm_loadu_ps(m + 4 * j));
+    }
+    __m512i const vec = _mm512_srli_epi32(Lanes(), 2);
+    __m512i const component = _mm512_slli_epi32(_mm512_and_epi32(Lanes(), _mm512_set1_epi32(3)), 2);
+    __m512i const inOffsets = _mm512_add_epi32(_mm512_mullo_epi32(vec, _mm512_set1_epi32(static_cast<int>(inStride))), component);
+    __m512i const outOffsets = _mm512_add_epi32(_mm512_mullo_epi32(vec, _mm512_set1_epi32(static_cast<int>(outStride))), component);
+    bool const packedIn = inStride == 4 * sizeof(float);
+    bool const packedOut = outStride == 4 * sizeof(float);
+    for (size_t i = 0; i < count; i += 4) {
+        __mmask16 const mask = TailMask((count - i < 4 ? count - i : 4) * 4);
+        float const* src = At(in, i, inStride);
+        __m512 v = packedIn ? _mm512_maskz_loadu_ps(mask, src)
+                            : _mm512_mask_i32gather_ps(_mm512_setzero_ps(), mask, inOffsets, src, 1);
+        __m512 lo = _mm512_mul_ps(_mm512_permute_ps(v, 0x00), row[0]);
+        __m512 hi = _mm512_mul_ps(_mm512_permute_ps(v, 0x55), row[1]);
+        lo = _mm512_fmadd_ps(_mm512_permute_ps(v, 0xAA), row[2], lo);
+        hi = _mm512_fmadd_ps(_mm512_permute_ps(v, 0xFF), row[3], hi);
+        float* dst = At(out, i, outStride);
+        if (packedOut) {
+            _mm512_mask_storeu_ps(dst, mask, _mm512_add_ps(lo, hi));
+        }
+        else {
+            _mm512_mask_i32scatter_ps(dst, mask, outOffsets, _mm512_add_ps(lo, hi), 1);
+        }
+    }
+}
+
+// out = left * right for row major 4x4 matrices, a whole matrix per register. Lane 4r+c of
+// the product is sum over k of left[r][k] * right[k][c]: element k of each row of left is
+// broadcast across its row and multiplied by row k of right repeated in every row.
+XO_INL __m512 Multiply4x4(__m512 l, float const* right) {
+    __m512 r[4];
+    for (int k = 0; k < 4; ++k) {
+        r[k] = _mm512_broadcast_f32x4(_mm_loadu_ps(right + 4 * k));
+    }
+    __m512 a = _mm512_fmadd_ps(_mm512_permute_ps(l, 0x55), r[1], _mm512_mul_ps(_mm512_permute_ps(l, 0x00), r[0]));
+    __m512 b = _mm512_fmadd_ps(_mm512_permute_ps(l, 0xFF), r[3], _mm512_mul_ps(_mm512_permute_ps(l, 0xAA), r[2]));
+    return _mm512_add_ps(a, b);
+}
+
+// Two matrices per iteration. Both inputs are read before out is written, so out may be
+// left or right.
+void Multiply4x4(float const* left, float const* right, float* out, size_t count) {
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m512 a = Multiply4x4(_mm512_loadu_ps(left + i * 16), right + i * 16);
+        __m512 b = Multiply4x4(_mm512_loadu_ps(left + i * 16 + 16), right + i * 16 + 16);
+        _mm512_storeu_ps(out + i * 16, a);
+        _mm512_storeu_ps(out + i * 16 + 16, b);
+    }
+    if (i < count) {
+        _mm512_storeu_ps(out + i * 16, Multiply4x4(_mm512_loadu_ps(left + i * 16), right + i * 16));
+    }
+}
+
+// and_ps and xor_ps on zmm need AVX512DQ, these stay within AVX512F.
+XO_INL __m512 And(__m512 a, __m512 b) {
+    return _mm512_castsi512_ps(_mm512_and_epi32(_mm512_castps_si512(a), _mm512_castps_si512(b)));
+}
+
+XO_INL __m512 Xor(__m512 a, __m512 b) {
+    return _mm512_castsi512_ps(_mm512_xor_epi32(_mm512_castps_si512(a), _mm512_castps_si512(b)));
+}
+
+// slerp::Weight from xo-math-utilities.h.
+XO_INL __m512 SlerpWeight(__m512 cosine, __m512 t) {
+    __m512 const one = _mm512_set1_ps(1.f);
+    __m512 const xm1 = _mm512_sub_ps(cosine, one);
+    __m512 const tt = _mm512_mul_ps(t, t);
+    __m512 r = one;
+    for (int i = slerp::Terms - 1; i >= 0; --i) {
+        __m512 b = _mm512_mul_ps(_mm512_fmsub_ps(_mm512_set1_ps(slerp::U[i]), tt, _mm512_set1_ps(slerp::V[i])), xm1);
+        r = _mm512_fmadd_ps(b, r, one);
+    }
+    return _mm512_mul_ps(t, r);
+}
+
+// Dot products of 4 component vectors split into one register per component.
+XO_INL __m512 Dot4(__m512 const l[4], __m512 const r[4]) {
+    __m512 d = _mm512_mul_ps(l[0], r[0]);
+    d = _mm512_fmadd_ps(l[1], r[1], d);
+    d = _mm512_fmadd_ps(l[2], r[2], d);
+    return _mm512_fmadd_ps(l[3], r[3], d);
+}
+
+void Slerp(Quaternion const* start, Quaternion const* end, float const* t, Quaternion* out, size_t count) {
+    for (size_t i = 0; i < count; i += 16) {
+        size_t floats = (count - i) * 4;
+        __m512 s[4], e[4];
+        Load4(start[i].vec4.v, floats, s);
+        Load4(end[i].vec4.v, floats, e);
+        // Flipping end when start . end < 0 takes the shorter arc, like Quaternion::Slerp.
+        __m512 d = Dot4(s, e);
+        __m512 sign = And(d, _mm512_set1_ps(-0.f));
+        __m512 cosine = Xor(d, sign);
+        __m512 te = _mm512_maskz_loadu_ps(TailMask(count - i), t + i);
+        __m512 ts = _mm512_sub_ps(_mm512_set1_ps(1.f), te);
+        __m512 ws = SlerpWeight(cosine, ts);
+        __m512 we = Xor(SlerpWeight(cosine, te), sign);
+        __m512 c[4];
+        for (int j = 0; j < 4; ++j) c[j] = _mm512_fmadd_ps(s[j], ws, _mm512_mul_ps(e[j], we));
+        Store4(out[i].vec4.v, floats, c);
+    }
+}
+
+void Nlerp(Quaternion const* start, Quaternion const* end, float const* t, Quaternion* out, size_t count, Precision precision) {
+    for (size_t i = 0; i < count; i += 16) {
+        size_t floats = (count - i) * 4;
+        __m512 s[4], e[4];
+        Load4(start[i].vec4.v, floats, s);
+        Load4(end[i].vec4.v, floats, e);
+        __m512 sign = And(Dot4(s, e), _mm512_set1_ps(-0.f));
+        __m512 te = _mm512_maskz_loadu_ps(TailMask(count - i), t + i);
+        __m512 c[4];
+        for (int j = 0; j < 4; ++j) c[j] = _mm512_fmadd_ps(te, _mm512_sub_ps(Xor(e[j], sign), s[j]), s[j]);
+        __m512 lengthSquared = _mm512_mul_ps(c[0], c[0]);
+        for (int j = 1; j < 4; ++j) lengthSquared = _mm512_fmadd_ps(c[j], c[j], lengthSquared);
+        // Lanes past the end divide 0 by 0, they're never stored.
+        if (precision == Precision::Exact) {
+            __m512 len = _mm512_sqrt_ps(lengthSquared);
+            for (int j = 0; j < 4; ++j) c[j] = _mm512_div_ps(c[j], len);
+        }
+        else {
+            __m512 scale = InverseSqrt(lengthSquared, precision);
+            for (int j = 0; j < 4; ++j) c[j] = _mm512_mul_ps(c[j], scale);
+        }
+        Store4(out[i].vec4.v, floats, c);
+    }
+}
+
+// out = in - origin rounded to floats, for arrays of Vector3d: 8 Vector3ds are three
+// registers of doubles, and origin repeated every 3 lanes another three.
+void RelativeTo3d(double const* in, double const* origin, float* out, size_t count) {
+    double repeated[24];
+    for (int k = 0; k < 24; ++k) repeated[k] = origin[k % 3];
+    __m512d o[3];
+    for (int r = 0; r < 3; ++r) o[r] = _mm512_loadu_pd(repeated + r * 8);
+    size_t const doubles = count * 3;
+    for (size_t i = 0; i < doubles; i += 24) {
+        for (int r = 0; r < 3; ++r) {
+            size_t const k = i + r * 8;
+            size_t const n = k < doubles ? (doubles - k < 8 ? doubles - k : 8) : 0;
+            __mmask16 const mask = TailMask(n);
+            __m512d d = _mm512_sub_pd(_mm512_maskz_loadu_pd(static_cast<__mmask8>(mask), in + k), o[r]);
+            // The 8 floats go through a zmm store, 8 wide masked stores need AVX512VL.
+            _mm512_mask_storeu_ps(out + k, mask, _mm512_castps256_ps512(_mm512_cvtpd_ps(d)));
+        }
+    }
+}
+
+// out = (in, 1) times m as a row vector for arrays of Vector3d, two vectors per register:
+// each half holds the rows of m and is weighted by the x, y and z of one vector.
+void Transform3d(double const* m, double const* in, double* out, size_t count) {
+    __m512d row[4];
+    for (int j = 0; j < 4; ++j) {
+        double const* r = m + j * 4;
+        row[j] = _mm512_setr_pd(r[0], r[1], r[2], 0.0, r[0], r[1], r[2], 0.0);
+    }
+    __m512i const x = _mm512_setr_epi64(0, 0, 0, 0, 3, 3, 3, 3);
+    __m512i const y = _mm512_setr_epi64(1, 1, 1, 1, 4, 4, 4, 4);
+    __m512i const z = _mm512_setr_epi64(2, 2, 2, 2, 5, 5, 5, 5);
+    __m512i const pack = _mm512_setr_epi64(0, 1, 2, 4, 5, 6, 3, 7);
+    for (size_t i = 0; i < count; i += 2) {
+        __mmask8 const mask = count - i >= 2 ? 0x3F : 0x07;
+        __m512d v = _mm512_maskz_loadu_pd(mask, in + i * 3);
+        __m512d p = _mm512_fmadd_pd(row[0], _mm512_permutexvar_pd(x, v), row[3]);
+        p = _mm512_fmadd_pd(row[1], _mm512_permutexvar_pd(y, v), p);
+        p = _mm512_fmadd_pd(row[2], _mm512_permutexvar_pd(z, v), p);
+        _mm512_mask_storeu_pd(out + i * 3, mask, _mm512_permutexvar_pd(pack, p));
+    }
+}
+
+// Half floats to floats and back, 16 at a time. The tail goes through a buffer, masked 16
+// bit loads and stores need AVX512BW.
+void ToHalf(float const* in, uint16_t* out, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i h = _mm512_cvtps_ph(_mm512_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), h);
+    }
+    if (i < count) {
+        alignas(32) uint16_t t[16];
+        __m512 f = _mm512_maskz_loadu_ps(TailMask(count - i), in + i);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(t), _mm512_cvtps_ph(f, _MM_FROUND_TO_NEAREST_INT));
+        std::memcpy(out + i, t, (count - i) * sizeof(uint16_t));
+    }
+}
+
+void FromHalf(uint16_t const* in, float* out, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i h = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in + i));
+        _mm512_storeu_ps(out + i, _mm512_cvtph_ps(h));
+    }
+    if (i < count) {
+        alignas(32) uint16_t t[16] = {};
+        std::memcpy(t, in + i, (count - i) * sizeof(uint16_t));
+        __m512 f = _mm512_cvtph_ps(_mm256_load_si256(reinterpret_cast<__m256i const*>(t)));
+        _mm512_mask_storeu_ps(out + i, TailMask(count - i), f);
+    }
+}
+
+// smallest3 from xo-math-packed.h over 16 quaternions held as one register per component.
+// Returns the index of the largest magnitude component of each (the first one on a tie)
+// and the other three in kept, negated where the largest is negative.
+XO_INL __m512i SplitLargest(__m512 const q[4], __m512 kept[3]) {
+    __m512 a[4];
+    for (int k = 0; k < 4; ++k) a[k] = _mm512_abs_ps(q[k]);
+    __m512 const top = _mm512_max_ps(_mm512_max_ps(a[0], a[1]), _mm512_max_ps(a[2], a[3]));
+    // le1 is "the index is at most 1" and so on.
+    __mmask16 const is0 = _mm512_cmp_ps_mask(a[0], top, _CMP_EQ_OQ);
+    __mmask16 const le1 = is0 | _mm512_cmp_ps_mask(a[1], top, _CMP_EQ_OQ);
+    __mmask16 const le2 = le1 | _mm512_cmp_ps_mask(a[2], top, _CMP_EQ_OQ);
+    __m512i m = _mm512_mask_mov_epi32(_mm512_set1_epi32(3), le2, _mm512_set1_epi32(2));
+    m = _mm512_mask_mov_epi32(m, le1, _mm512_set1_epi32(1));
+    m = _mm512_mask_mov_epi32(m, is0, _mm512_setzero_si512());
+    __m512 largest = _mm512_mask_mov_ps(q[3], le2, q[2]);
+    largest = _mm512_mask_mov_ps(largest, le1, q[1]);
+    largest = _mm512_mask_mov_ps(largest, is0, q[0]);
+    __mmask16 const negative = _mm512_cmp_ps_mask(largest, _mm512_setzero_ps(), _CMP_LT_OQ);
+    __m512 const flip = _mm512_maskz_mov_ps(negative, _mm512_set1_ps(-0.f));
+    kept[0] = Xor(_mm512_mask_blend_ps(is0, q[0], q[1]), flip);
+    kept[1] = Xor(_mm512_mask_blend_ps(le1, q[1], q[2]), flip);
+    kept[2] = Xor(_mm512_mask_blend_ps(le2, q[2], q[3]), flip);
+    return m;
+}
+
+template<int Bits>
+XO_INL __m512i Quantize(__m512 c) {
+    typedef smallest3::Format<Bits> F;
+    __m512 const scaled = _mm512_mul_ps(_mm512_add_ps(c, _mm512_set1_ps(smallest3::Bound)), _mm512_set1_ps(F::Scale));
+    __m512i const v = _mm512_max_epi32(_mm512_cvtps_epi32(scaled), _mm512_setzero_si512());
+    return _mm512_min_epi32(v, _mm512_set1_epi32(static_cast<int>(F::Max)));
+}
+
+template<int Bits>
+XO_INL __m512 Dequantize(__m512i value) {
+    typedef smallest3::Format<Bits> F;
+    return _mm512_mul_ps(_mm512_sub_ps(_mm512_cvtepi32_ps(value), _mm512_set1_ps(F::Middle)), _mm512_set1_ps(F::Step));
+}
+
+// The quaternions with component m rebuilt from the kept a, b and c.
+XO_INL void JoinLargest(__m512i m, __m512 a, __m512 b, __m512 c, __m512 q[4]) {
+    __m512 d = _mm512_fnmadd_ps(a, a, _mm512_set1_ps(1.f));
+    d = _mm512_fnmadd_ps(b, b, d);
+    d = _mm512_fnmadd_ps(c, c, d);
+    d = _mm512_sqrt_ps(_mm512_max_ps(d, _mm512_setzero_ps()));
+    __mmask16 is[4], above[3];
+    for (int k = 0; k < 4; ++k) is[k] = _mm512_cmpeq_epi32_mask(m, _mm512_set1_epi32(k));
+    for (int k = 0; k < 3; ++k) above[k] = _mm512_cmpgt_epi32_mask(m, _mm512_set1_epi32(k));
+    q[0] = _mm512_mask_blend_ps(is[0], a, d);
+    q[1] = _mm512_mask_blend_ps(above[1], _mm512_mask_blend_ps(is[1], a, d), b);
+    q[2] = _mm512_mask_blend_ps(above[2], _mm512_mask_blend_ps(is[2], b, d), c);
+    q[3] = _mm512_mask_blend_ps(is[3], c, d);
+}
+
+void Pack32(Quaternion const* in, uint32_t* out, size_t count) {
+    for (size_t i = 0; i < count; i += 16) {
+        size_t const n = count - i < 16 ? count - i : 16;
+        __m512 q[4], kept[3];
+        Load4(in[i].vec4.v, n * 4, q);
+        __m512i const m = SplitLargest(q, kept);
+        __m512i v = _mm512_or_si512(_mm512_slli_epi32(m, 30), _mm512_slli_epi32(Quantize<10>(kept[0]), 20));
+        v = _mm512_or_si512(v, _mm512_or_si512(_mm512_slli_epi32(Quantize<10>(kept[1]), 10), Quantize<10>(kept[2])));
+        _mm512_mask_storeu_epi32(out + i, TailMask(n), v);
+    }
+}
+
+void Unpack32(uint32_t const* in, Quaternion* out, size_t count) {
+    __m512i const bits10 = _mm512_set1_epi32(0x3FF);
+    for (size_t i = 0; i < count; i += 16) {
+        size_t const n = count - i < 16 ? count - i : 16;
+        __m512i const v = _mm512_maskz_loadu_epi32(TailMask(n), in + i);
+        __m512 q[4];
+        JoinLargest(_mm512_srli_epi32(v, 30),
+                    Dequantize<10>(_mm512_and_epi32(_mm512_srli_epi32(v, 20), bits10)),
+                    Dequantize<10>(_mm512_and_epi32(_mm512_srli_epi32(v, 10), bits10)),
+                    Dequantize<10>(_mm512_and_epi32(v, bits10)), q);
+        Store4(out[i].vec4.v, n * 4, q);
+    }
+}
+
+// PackedQuaternion48 arrays are flat runs of words, 16 quaternions are 48 of them. They're
+// widened to 32 bits and split into one register per word with Deinterleave3. The tails go
+// through a buffer, masked 16 bit loads and stores need AVX512BW.
+void Pack48(Quaternion const* in, uint16_t* out, size_t count) {
+    for (size_t i = 0; i < count; i += 16) {
+        size_t const n = count - i < 16 ? count - i : 16;
+        __m512 q[4], kept[3];
+        Load4(in[i].vec4.v, n * 4, q);
+        __m512i const m = SplitLargest(q, kept);
+        __m512i const one = _mm512_set1_epi32(1);
+        __m512 w[3] = {
+            _mm512_castsi512_ps(_mm512_or_si512(Quantize<15>(kept[0]), _mm512_slli_epi32(_mm512_and_epi32(m, one), 15))),
+            _mm512_castsi512_ps(_mm512_or_si512(Quantize<15>(kept[1]), _mm512_slli_epi32(_mm512_srli_epi32(m, 1), 15))),
+            _mm512_castsi512_ps(Quantize<15>(kept[2])) };
+        alignas(32) uint16_t t[48];
+        uint16_t* dst = n == 16 ? out + i * 3 : t;
+        for (int r = 0; r < 3; ++r) {
+            __m256i const h = _mm512_cvtepi32_epi16(_mm512_castps_si512(Interleave3(w[0], w[1], w[2], r)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + r * 16), h);
+        }
+        if (n < 16) std::memcpy(out + i * 3, t, n * 3 * sizeof(uint16_t));
+    }
+}
+
+void Unpack48(uint16_t const* in, Quaternion* out, size_t count) {
+    __m512i const bits15 = _mm512_set1_epi32(0x7FFF);
+    for (size_t i = 0; i < count; i += 16) {
+        size_t const n = count - i < 16 ? count - i : 16;
+        alignas(32) uint16_t t[48] = {};
+        uint16_t const* src = in + i * 3;
+        if (n < 16) {
+            std::memcpy(t, src, n * 3 * sizeof(uint16_t));
+            src = t;
+        }
+        __m512 r[3];
+        for (int k = 0; k < 3; ++k) {
+            __m256i const h = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src + k * 16));
+            r[k] = _mm512_castsi512_ps(_mm512_cvtepu16_epi32(h));
+        }
+        __m512i w[3];
+        for (int k = 0; k < 3; ++k) w[k] = _mm512_castps_si512(Deinterleave3(r[0], r[1], r[2], k));
+        __m512i const m = _mm512_or_si512(_mm512_srli_epi32(w[0], 15), _mm512_slli_epi32(_mm512_srli_epi32(w[1], 15), 1));
+        __m512 q[4];
+        JoinLargest(m,
+                    Dequantize<15>(_mm512_and_epi32(w[0], bits15)),
+                    Dequantize<15>(_mm512_and_epi32(w[1], bits15)),
+                    Dequantize<15>(_mm512_and_epi32(w[2], bits15)), q);
+        Store4(out[i].vec4.v, n * 4, q);
+    }
+}
+
+// octahedral from xo-math-packed.h over 16 vectors held as x, y and z. Returns each
+// vector's quantized coordinates as qx | qy << Bits.
+template<int Bits>
+XO_INL __m512i PackNormals(__m512 x, __m512 y, __m512 z) {
+    typedef octahedral::Format<Bits> F;
+    __m512 const signBit = _mm512_set1_ps(-0.f);
+    __m512 const zero = _mm512_setzero_ps();
+    __m512 const one = _mm512_set1_ps(1.f);
+    __m512 const sum = _mm512_add_ps(_mm512_add_ps(_mm512_abs_ps(x), _mm512_abs_ps(y)), _mm512_abs_ps(z));
+    __m512 px = _mm512_div_ps(x, sum);
+    __m512 py = _mm512_div_ps(y, sum);
+    __m512 const fx = Xor(_mm512_sub_ps(one, _mm512_abs_ps(py)),
+                          _mm512_maskz_mov_ps(_mm512_cmp_ps_mask(px, zero, _CMP_LT_OQ), signBit));
+    __m512 const fy = Xor(_mm512_sub_ps(one, _mm512_abs_ps(px)),
+                          _mm512_maskz_mov_ps(_mm512_cmp_ps_mask(py, zero, _CMP_LT_OQ), signBit));
+    __mmask16 const lower = _mm512_cmp_ps_mask(z, zero, _CMP_LT_OQ);
+    px = _mm512_mask_mov_ps(px, lower, fx);
+    py = _mm512_mask_mov_ps(py, lower, fy);
+    __m512 const scale = _mm512_set1_ps(F::Scale);
+    __m512i const max = _mm512_set1_epi32(static_cast<int>(F::Max));
+    __m512i qx = _mm512_cvtps_epi32(_mm512_mul_ps(_mm512_add_ps(px, one), scale));
+    __m512i qy = _mm512_cvtps_epi32(_mm512_mul_ps(_mm512_add_ps(py, one), scale));
+    qx = _mm512_min_epi32(_mm512_max_epi32(qx, _mm512_setzero_si512()), max);
+    qy = _mm512_min_epi32(_mm512_max_epi32(qy, _mm512_setzero_si512()), max);
+    return _mm512_or_si512(qx, _mm512_slli_epi32(qy, Bits));
+}
+
+// The unit vectors for 16 values of qx | qy << Bits, as x, y and z.
+template<int Bits>
+XO_INL void UnpackNormals(__m512i v, __m512& x, __m512& y, __m512& z) {
+    typedef octahedral::Format<Bits> F;
+    __m512 const signBit = _mm512_set1_ps(-0.f);
+    __m512 const zero = _mm512_setzero_ps();
+    __m512i const mask = _mm512_set1_epi32((1 << Bits) - 1);
+    __m512 const middle = _mm512_set1_ps(F::Middle);
+    __m512 const step = _mm512_set1_ps(F::Step);
+    __m512 px = _mm512_mul_ps(_mm512_sub_ps(_mm512_cvtepi32_ps(_mm512_and_epi32(v, mask)), middle), step);
+    __m512 py = _mm512_mul_ps(_mm512_sub_ps(_mm512_cvtepi32_ps(_mm512_and_epi32(_mm512_srli_epi32(v, Bits), mask)), middle), step);
+    __m512 const pz = _mm512_sub_ps(_mm512_sub_ps(_mm512_set1_ps(1.f), _mm512_abs_ps(px)), _mm512_abs_ps(py));
+    __m512 const t = _mm512_max_ps(Xor(pz, signBit), zero);
+    // px + t where px < 0, px - t elsewhere.
+    px = _mm512_add_ps(px, _mm512_mask_mov_ps(Xor(t, signBit), _mm512_cmp_ps_mask(px, zero, _CMP_LT_OQ), t));
+    py = _mm512_add_ps(py, _mm512_mask_mov_ps(Xor(t, signBit), _mm512_cmp_ps_mask(py, zero, _CMP_LT_OQ), t));
+    __m512 const length = _mm512_sqrt_ps(_mm512_fmadd_ps(px, px, _mm512_fmadd_ps(py, py, _mm512_mul_ps(pz, pz))));
+    x = _mm512_div_ps(px, length);
+    y = _mm512_div_ps(py, length);
+    z = _mm512_div_ps(pz, length);
+}
+
+void PackNormals32(Vector3 const* in, uint32_t* out, size_t count) {
+    for (size_t i = 0; i < count; i += 16) {
+        size_t const n = count - i < 16 ? count - i : 16;
+        __m512 r0, r1, r2;
+        Load3(&in[i].x, n * 3, r0, r1, r2);
+        __m512i const v = PackNormals<16>(Deinterleave3(r0, r1, r2, 0),
+                                          Deinterleave3(r0, r1, r2, 1),
+                                          Deinterleave3(r0, r1, r2, 2));
+        _mm512_mask_storeu_epi32(out + i, TailMask(n), v);
+    }
+}
+
+void UnpackNormals32(uint32_t const* in, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; i += 16) {
+        size_t const n = count - i < 16 ? count - i : 16;
+        __m512 x, y, z;
+        UnpackNormals<16>(_mm512_maskz_loadu_epi32(TailMask(n), in + i), x, y, z);
+        Store3(&out[i].x, n * 3, Interleave3(x, y, z, 0), Interleave3(x, y, z, 1), Interleave3(x, y, z, 2));
+    }
+}
+
+// The 16 bit forms go through a buffer at the tail, masked 16 bit loads and stores need
+// AVX512BW.
+void PackNormals16(Vector3 const* in, uint16_t* out, size_t count) {
+    for (size_t i = 0; i < count; i += 16) {
+        size_t const n = count - i < 16 ? count - i : 16;
+        __m512 r0, r1, r2;
+        Load3(&in[i].x, n * 3, r0, r1, r2);
+        __m256i const v = _mm512_cvtepi32_epi16(PackNormals<8>(Deinterleave3(r0, r1, r2, 0),
+                                                               Deinterleave3(r0, r1, r2, 1),
+                                                               Deinterleave3(r0, r1, r2, 2)));
+        if (n == 16) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+        }
+        else {
+            alignas(32) uint16_t t[16];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(t), v);
+            std::memcpy(out + i, t, n * sizeof(uint16_t));
+        }
+    }
+}
+
+void UnpackNormals16(uint16_t const* in, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; i += 16) {
+        size_t const n = count - i < 16 ? count - i : 16;
+        alignas(32) uint16_t t[16] = {};
+        uint16_t const* src = in + i;
+        if (n < 16) {
+            std::memcpy(t, src, n * sizeof(uint16_t));
+            src = t;
+        }
+        __m512 x, y, z;
+        UnpackNormals<8>(_mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(src))), x, y, z);
+        Store3(&out[i].x, n * 3, Interleave3(x, y, z, 0), Interleave3(x, y, z, 1), Interleave3(x, y, z, 2));
+    }
+}
+
+} } // ::xo::avx512
+#if defined(__clang__)
+#   pragma clang attribute pop
+#elif defined(__GNUC__)
+#   pragma GCC diagnostic pop
+#   pragma GCC pop_options
+#endif
+#else
+#define XO_BATCH_AVX512 0
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////// end xo-math-avx512.h inline
+////////////////////////////////////////////////////////////////////////////////////////// xo-math-batch.h inlined
+#line 8 "xo-math-batch.h"
+namespace xo { namespace batch {
+// Array versions of the per vector operations. Every function processes 'count' elements,
+// out may be the same array as an input but must not partially overlap one. With a count of
+// 0 the pointers may be null.
+// Each call goes through a table of kernels picked once, on first use, from what the cpu
+// supports: 16 lanes at a time with AVX512, 8 with AVX2, FMA3 and F16C, otherwise a loop over
+// the vector types (which use whatever the build targets). Define
+// XO_CONFIG_RUNTIME_DISPATCH 0 to pick from the build flags only.
+// With Precision::Fast or Fastest, Normalize results depend on the kernels in use, the
+// AVX512 ones start from a more accurate estimate.
+
+void Add(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count);
+void Subtract(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count);
+void Multiply(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count);
+void Divide(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count);
+void DotProduct(Vector3 const* left, Vector3 const* right, float* out, size_t count);
+void CrossProduct(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count);
+void Normalize(Vector3 const* in, Vector3* out, size_t count,
+               Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+void Lerp(Vector3 const* left, Vector3 const* right, float t, Vector3* out, size_t count);
+
+void Add(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count);
+void Subtract(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count);
+void Multiply(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count);
+void Divide(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count);
+void DotProduct(Vector4 const* left, Vector4 const* right, float* out, size_t count);
+void Normalize(Vector4 const* in, Vector4* out, size_t count,
+               Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+void Lerp(Vector4 const* left, Vector4 const* right, float t, Vector4* out, size_t count);
+
+// out[i] = rotation.Rotate(in[i]), through the same kernels as Matrix4x4::TransformDirections.
+void Rotate(Quaternion const& rotation, Vector3 const* in, Vector3* out, size_t count);
+// out[i] = rotations[i].Rotate(in[i]), for skinning and rigid body updates. The rotations
+// should be normalized.
+void Rotate(Quaternion const* rotations, Vector3 const* in, Vector3* out, size_t count);
+
+// Interpolates from start[i] to end[i] by t[i], taking the shorter arc like
+// Quaternion::Slerp, for blending animation poses. start and end should be normalized.
+// Slerp has no branches and calls neither acos nor sin, the weights are polynomials
+// (see xo::slerp), about 1e-6 off Quaternion::Slerp. Nlerp is the normalized Lerp: cheaper,
+// but it doesn't move at a constant speed.
+void Slerp(Quaternion const* start, Quaternion const* end, float const* t,
+           Quaternion* out, size_t count);
+void Nlerp(Quaternion const* start, Quaternion const* end, float const* t,
+           Quaternion* out, size_t count, Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+
+// out[i] = RelativeTo(positions[i], origin): double precision positions to floats around
+// a camera or any other origin, subtracted before rounding.
+void RelativeTo(Vector3d const* positions, Vector3d const& origin, Vector3* out, size_t count);
+// out[i] = (in[i], 1) times matrix as a row vector, in double precision: the translation
+// comes from rows[3], the same as Matrix4x4::TransformPoints.
+void TransformPoints(Matrix4x4d const& matrix, Vector3d const* in, Vector3d* out, size_t count);
+
+// out[i] = Half3(in[i]) and the reverse, with F16C when the kernels have it. The results
+// are the same as FloatToHalf and HalfToFloat either way.
+void ToHalf(Vector3 const* in, Half3* out, size_t count);
+void ToHalf(Vector4 const* in, Half4* out, size_t count);
+void FromHalf(Half3 const* in, Vector3* out, size_t count);
+void FromHalf(Half4 const* in, Vector4* out, size_t count);
+
+// out[i] = PackedQuaternion32(in[i]) or PackedQuaternion48(in[i]) and back. Packing gives
+// the same bits on every path.
+void Pack(Quaternion const* in, PackedQuaternion32* out, size_t count);
+void Pack(Quaternion const* in, PackedQuaternion48* out, size_t count);
+void Unpack(PackedQuaternion32 const* in, Quaternion* out, size_t count);
+void Unpack(PackedQuaternion48 const* in, Quaternion* out, size_t count);
+// out[i] = PackedNormal32(in[i]) or PackedNormal16(in[i]) and back, the same guarantees.
+void Pack(Vector3 const* in, PackedNormal32* out, size_t count);
+void Pack(Vector3 const* in, PackedNormal16* out, size_t count);
+void Unpack(PackedNormal32 const* in, Vector3* out, size_t count);
+void Unpack(PackedNormal16 const* in, Vector3* out, size_t count);
+
+// The instruction set the batch functions are running with: eXO_AVX512, eXO_AVX2 or
+// eXO_SSE_NONE for the plain loops.
+simd::eXO_SSE ActiveKernels();
+
+// Switches to the best kernels at or below 'version', eXO_SSE_NONE for the plain loops.
+// Returns false and changes nothing if the cpu doesn't support 'version'.
+// Not thread safe, call it before any batch work is in flight.
+bool UseKernels(simd::eXO_SSE version);
+
+#if defined(XO_MATH_IMPL)
+namespace generic {
+void Add3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = left[i] + right[i];
+}
+
+void Subtract3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = left[i] - right[i];
+}
+
+void Multiply3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = left[i] * right[i];
+}
+
+void Divide3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = left[i] / right[i];
+}
+
+void DotProduct3(Vector3 const* left, Vector3 const* right, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = Vector3::DotProduct(left[i], right[i]);
+}
+
+void CrossProduct3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = Vector3::CrossProduct(left[i], right[i]);
+}
+
+void Normalize3(Vector3 const* in, Vector3* out, size_t count, Precision precision) {
+    for (size_t i = 0; i < count; ++i) out[i] = in[i].Normalized(precision);
+}
+
+void Lerp3(Vector3 const* left, Vector3 const* right, float t, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = Vector3::Lerp(left[i], right[i], t);
+}
+
+void Add4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = left[i] + right[i];
+}
+
+void Subtract4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = left[i] - right[i];
+}
+
+void Multiply4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = left[i] * right[i];
+}
+
+void Divide4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = left[i] / right[i];
+}
+
+void DotProduct4(Vector4 const* left, Vector4 const* right, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = Vector4::DotProduct(left[i], right[i]);
+}
+
+void Normalize4(Vector4 const* in, Vector4* out, size_t count, Precision precision) {
+    for (size_t i = 0; i < count; ++i) out[i] = in[i].Normalized(precision);
+}
+
+void Lerp4(Vector4 const* left, Vector4 const* right, float t, Vector4* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = Vector4::Lerp(left[i], right[i], t);
+}
+
+void Rotate3(Quaternion const* rotations, Vector3 const* in, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = rotations[i].Rotate(in[i]);
+}
+
+void Slerp(Quaternion const* start, Quaternion const* end, float const* t, Quaternion* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        float d = Quaternion::DotProduct(start[i], end[i]);
+        float sign = d < 0.f ? -1.f : 1.f;
+        out[i] = start[i] * slerp::Weight(d * sign, 1.f - t[i])
+               + end[i] * (slerp::Weight(d * sign, t[i]) * sign);
+    }
+}
+
+void Nlerp(Quaternion const* start, Quaternion const* end, float const* t, Quaternion* out, size_t count, Precision precision) {
+    for (size_t i = 0; i < count; ++i) {
+        Quaternion e = Quaternion::DotProduct(start[i], end[i]) < 0.f ? -end[i] : end[i];
+        out[i] = Quaternion::Lerp(start[i], e, t[i]).Normalized(precision);
+    }
+}
+
+void Transform3(float const* m,
+                float const* in, size_t inStride,
+                float* out, size_t outStride,
+                size_t count, float w) {
+    char const* src = reinterpret_cast<char const*>(in);
+    char* dst = reinterpret_cast<char*>(out);
+    for (size_t i = 0; i < count; ++i, src += inStride, dst += outStride) {
+        float const* s = reinterpret_cast<float const*>(src);
+        float* d = reinterpret_cast<float*>(dst);
+        float const x = s[0], y = s[1], z = s[2];
+        d[0] = x * m[0] + y * m[4] + z * m[8] + w * m[12];
+        d[1] = x * m[1] + y * m[5] + z * m[9] + w * m[13];
+        d[2] = x * m[2] + y * m[6] + z * m[10] + w * m[14];
+    }
+}
+
+void RelativeTo3d(double const* in, double const* origin, float* out, size_t count) {
+    for (size_t i = 0; i < count * 3; i += 3) {
+        out[i] = static_cast<float>(in[i] - origin[0]);
+        out[i + 1] = static_cast<float>(in[i + 1] - origin[1]);
+        out[i + 2] = static_cast<float>(in[i + 2] - origin[2]);
+    }
+}
+
+void Transform3d(double const* m, double const* in, double* out, size_t count) {
+    for (size_t i = 0; i < count * 3; i += 3) {
+        double const x = in[i], y = in[i + 1], z = in[i + 2];
+        out[i] = x * m[0] + y * m[4] + z * m[8] + m[12];
+        out[i + 1] = x * m[1] + y * m[5] + z * m[9] + m[13];
+        out[i + 2] = x * m[2] + y * m[6] + z * m[10] + m[14];
+    }
+}
+
+void ToHalf(float const* in, uint16_t* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = FloatToHalf(in[i]);
+}
+
+void FromHalf(uint16_t const* in, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = HalfToFloat(in[i]);
+}
+
+void Pack32(Quaternion const* in, uint32_t* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = PackedQuaternion32(in[i]).bits;
+}
+
+void Unpack32(uint32_t const* in, Quaternion* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        PackedQuaternion32 p;
+        p.bits = in[i];
+        out[i] = p.ToQuaternion();
+    }
+}
+
+void Pack48(Quaternion const* in, uint16_t* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        PackedQuaternion48 const p(in[i]);
+        std::memcpy(out + i * 3, p.words, sizeof(p.words));
+    }
+}
+
+void Unpack48(uint16_t const* in, Quaternion* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        PackedQuaternion48 p;
+        std::memcpy(p.words, in + i * 3, sizeof(p.words));
+        out[i] = p.ToQuaternion();
+    }
+}
+
+void PackNormals32(Vector3 const* in, uint32_t* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        PackedNormal32 const p(in[i]);
+        out[i] = p.x | (static_cast<uint32_t>(p.y) << 16);
+    }
+}
+
+void UnpackNormals32(uint32_t const* in, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        PackedNormal32 p;
+        p.x = static_cast<uint16_t>(in[i]);
+        p.y = static_cast<uint16_t>(in[i] >> 16);
+        out[i] = p.ToVector3();
+    }
+}
+
+void PackNormals16(Vector3 const* in, uint16_t* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        PackedNormal16 const p(in[i]);
+        out[i] = static_cast<uint16_t>(p.x | (p.y << 8));
+    }
+}
+
+void UnpackNormals16(uint16_t const* in, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        PackedNormal16 p;
+        p.x = static_cast<uint8_t>(in[i]);
+        p.y = static_cast<uint8_t>(in[i] >> 8);
+        out[i] = p.ToVector3();
+    }
+}
+
+void Transform4(float const* m,
+                float const* in, size_t inStride,
+                float* out, size_t outStride,
+                size_t count) {
+    char const* src = reinterpret_cast<char const*>(in);
+    char* dst = reinterpret_cast<char*>(out);
+    for (size_t i = 0; i < count; ++i, src += inStride, dst += outStride) {
+        float const* s = reinterpret_cast<float const*>(src);
+        float* d = reinterpret_cast<float*>(dst);
+        float const x = s[0], y = s[1], z = s[2], w = s[3];
+        d[0] = x * m[0] + y * m[4] + z * m[8] + w * m[12];
+        d[1] = x * m[1] + y * m[5] + z * m[9] + w * m[13];
+        d[2] = x * m[2] + y * m[6] + z * m[10] + w * m[14];
+        d[3] = x * m[3] + y * m[7] + z * m[11] + w * m[15];
+    }
+}
+
+void Multiply4x4(float const* left, float const* right, float* out, size_t count) {
+    for (size_t i = 0; i < count * 16; i += 16) {
+        Matrix4x4 l, r;
+        std::memcpy(l.v, left + i, sizeof(l.v));
+        std::memcpy(r.v, right + i, sizeof(r.v));
+        l *= r;
+        std::memcpy(out + i, l.v, sizeof(l.v));
+    }
+}
+} // ::xo::batch::generic
+
+namespace {
+struct Kernels {
+    simd::eXO_SSE version;
+    void (*add3)(Vector3 const*, Vector3 const*, Vector3*, size_t);
+    void (*subtract3)(Vector3 const*, Vector3 const*, Vector3*, size_t);
+    void (*multiply3)(Vector3 const*, Vector3 const*, Vector3*, size_t);
+    void (*divide3)(Vector3 const*, Vector3 const*, Vector3*, size_t);
+    void (*dotProduct3)(Vector3 const*, Vector3 const*, float*, size_t);
+    void (*crossProduct3)(Vector3 const*, Vector3 const*, Vector3*, size_t);
+    void (*normalize3)(Vector3 const*, Vector3*, size_t, Precision);
+    void (*lerp3)(Vector3 const*, Vector3 const*, float, Vector3*, size_t);
+    void (*add4)(Vector4 const*, Vector4 const*, Vector4*, size_t);
+    void (*subtract4)(Vector4 const*, Vector4 const*, Vector4*, size_t);
+    void (*multiply4)(Vector4 const*, Vector4 const*, Vector4*, size_t);
+    void (*divide4)(Vector4 const*, Vector4 const*, Vector4*, size_t);
+    void (*dotProduct4)(Vector4 const*, Vector4 const*, float*, size_t);
+    void (*normalize4)(Vector4 const*, Vector4*, size_t, Precision);
+    void (*lerp4)(Vector4 const*, Vector4 const*, float, Vector4*, size_t);
+    void (*rotate3)(Quaternion const*, Vector3 const*, Vector3*, size_t);
+    void (*slerp)(Quaternion const*, Quaternion const*, float const*, Quaternion*, size_t);
+    void (*nlerp)(Quaternion const*, Quaternion const*, float const*, Quaternion*, size_t, Precision);
+    void (*transform3)(float const*, float const*, size_t, float*, size_t, size_t, float);
+    void (*transform4)(float const*, float const*, size_t, float*, size_t, size_t);
+    void (*multiply4x4)(float const*, float const*, float*, size_t);
+    void (*relativeTo3d)(double const*, double const*, float*, size_t);
+    void (*transform3d)(double const*, double const*, double*, size_t);
+    void (*toHalf)(float const*, uint16_t*, size_t);
+    void (*fromHalf)(uint16_t const*, float*, size_t);
+    void (*pack32)(Quaternion const*, uint32_t*, size_t);
+    void (*unpack32)(uint32_t const*, Quaternion*, size_t);
+    void (*pack48)(Quaternion const*, uint16_t*, size_t);
+    void (*unpack48)(uint16_t const*, Quaternion*, size_t);
+    void (*packNormals32)(Vector3 const*, uint32_t*, size_t);
+    void (*unpackNormals32)(uint32_t const*, Vector3*, size_t);
+    void (*packNormals16)(Vector3 const*, uint16_t*, size_t);
+    void (*unpackNormals16)(uint16_t const*, Vector3*, size_t);
+};
+
+#define XO_BATCH_KERNELS(ns, version) { version, \
+    ns::Add3, ns::Subtract3, ns::Multiply3, ns::Divide3, \
+    ns::DotProduct3, ns::CrossProduct3, ns::Normalize3, ns::Lerp3, \
+    ns::Add4, ns::Subtract4, ns::Multiply4, ns::Divide4, \
+    ns::DotProduct4, ns::Normalize4, ns::Lerp4, \
+    ns::Rotate3, ns::Slerp, ns::Nlerp, \
+    ns::Transform3, ns::Transform4, ns::Multiply4x4, \
+    ns::RelativeTo3d, ns::Transform3d, \
+    ns::ToHalf, ns::FromHalf, \
+    ns::Pack32, ns::Unpack32, ns::Pack48, ns::Unpack48, \
+    ns::PackNormals32, ns::UnpackNormals32, ns::PackNormals16, ns::UnpackNormals16 }
+
+Kernels const GenericKernels = XO_BATCH_KERNELS(generic, simd::eXO_SSE::eXO_SSE_NONE);
+#   if XO_BATCH_AVX2
+Kernels const AVX2Kernels = XO_BATCH_KERNELS(avx2, simd::eXO_SSE::eXO_AVX2);
+#   endif
+#   if XO_BATCH_AVX512
+Kernels const AVX512Kernels = XO_BATCH_KERNELS(avx512, simd::eXO_SSE::eXO_AVX512);
+#   endif
+#undef XO_BATCH_KERNELS
+
+// What the kernels are allowed to assume is available.
+simd::eXO_SSE SupportedVersion() {
+#   if XO_CONFIG_RUNTIME_DISPATCH
+    return simd::SSEGetRuntimeVersion();
+#   else
+    return simd::eXO_SSE::eXO_SSE_CURRENT;
+#   endif
+}
+
+Kernels const* SelectKernels(simd::eXO_SSE version) {
+#   if XO_BATCH_AVX512
+    if (version >= simd::eXO_SSE::eXO_AVX512) return &AVX512Kernels;
+#   endif
+#   if XO_BATCH_AVX2
+    if (version >= simd::eXO_SSE::eXO_AVX2) return &AVX2Kernels;
+#   endif
+    XO_UNUSED(version);
+    return &GenericKernels;
+}
+
+Kernels const*& Active() {
+    static Kernels const* active = SelectKernels(SupportedVersion());
+    return active;
+}
+} // ::xo::batch::anonymous
+
+simd::eXO_SSE ActiveKernels() {
+    return Active()->version;
+}
+
+bool UseKernels(simd::eXO_SSE version) {
+    if (version > SupportedVersion()) return false;
+    Active() = SelectKernels(version);
+    return true;
+}
+
+void Add(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Active()->add3(left, right, out, count);
+}
+
+void Subtract(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Active()->subtract3(left, right, out, count);
+}
+
+void Multiply(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Active()->multiply3(left, right, out, count);
+}
+
+void Divide(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Active()->divide3(left, right, out, count);
+}
+
+void DotProduct(Vector3 const* left, Vector3 const* right, float* out, size_t count) {
+    Active()->dotProduct3(left, right, out, count);
+}
+
+void CrossProduct(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Active()->crossProduct3(left, right, out, count);
+}
+
+void Normalize(Vector3 const* in, Vector3* out, size_t count, Precision precision) {
+    Active()->normalize3(in, out, count, precision);
+}
+
+void Lerp(Vector3 const* left, Vector3 const* right, float t, Vector3* out, size_t count) {
+    Active()->lerp3(left, right, t, out, count);
+}
+
+void Add(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Active()->add4(left, right, out, count);
+}
+
+void Subtract(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Active()->subtract4(left, right, out, count);
+}
+
+void Multiply(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Active()->multiply4(left, right, out, count);
+}
+
+void Divide(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Active()->divide4(left, right, out, count);
+}
+
+void DotProduct(Vector4 const* left, Vector4 const* right, float* out, size_t count) {
+    Active()->dotProduct4(left, right, out, count);
+}
+
+void Normalize(Vector4 const* in, Vector4* out, size_t count, Precision precision) {
+    Active()->normalize4(in, out, count, precision);
+}
+
+void Lerp(Vector4 const* left, Vector4 const* right, float t, Vector4* out, size_t count) {
+    Active()->lerp4(left, right, t, out, count);
+}
+
+void Rotate(Quaternion const& rotation, Vector3 const* in, Vector3* out, size_t count) {
+    // ToMatrix rotates column vectors, the kernels take row vectors.
+    Matrix4x4 const m = Matrix4x4::Transpose(rotation.ToMatrix());
+    Active()->transform3(m.v, reinterpret_cast<float const*>(in), sizeof(Vector3),
+                         reinterpret_cast<float*>(out), sizeof(Vector3), count, 0.f);
+}
+
+void Rotate(Quaternion const* rotations, Vector3 const* in, Vector3* out, size_t count) {
+    Active()->rotate3(rotations, in, out, count);
+}
+
+void Slerp(Quaternion const* start, Quaternion const* end, float const* t,
+           Quaternion* out, size_t count) {
+    Active()->slerp(start, end, t, out, count);
+}
+
+void Nlerp(Quaternion const* start, Quaternion const* end, float const* t,
+           Quaternion* out, size_t count, Precision precision) {
+    Active()->nlerp(start, end, t, out, count, precision);
+}
+
+void RelativeTo(Vector3d const* positions, Vector3d const& origin, Vector3* out, size_t count) {
+    Active()->relativeTo3d(reinterpret_cast<double const*>(positions), origin.v,
+                           reinterpret_cast<float*>(out), count);
+}
+
+void TransformPoints(Matrix4x4d const& matrix, Vector3d const* in, Vector3d* out, size_t count) {
+    Active()->transform3d(matrix.rows[0].v, reinterpret_cast<double const*>(in),
+                          reinterpret_cast<double*>(out), count);
+}
+
+// Half3 and Half4 arrays are flat runs of halves like Vector3 and Vector4 arrays are of
+// floats, so they convert component by component.
+void ToHalf(Vector3 const* in, Half3* out, size_t count) {
+    Active()->toHalf(reinterpret_cast<float const*>(in), reinterpret_cast<uint16_t*>(out), count * 3);
+}
+
+void ToHalf(Vector4 const* in, Half4* out, size_t count) {
+    Active()->toHalf(reinterpret_cast<float const*>(in), reinterpret_cast<uint16_t*>(out), count * 4);
+}
+
+void FromHalf(Half3 const* in, Vector3* out, size_t count) {
+    Active()->fromHalf(reinterpret_cast<uint16_t const*>(in), reinterpret_cast<float*>(out), count * 3);
+}
+
+void FromHalf(Half4 const* in, Vector4* out, size_t count) {
+    Active()->fromHalf(reinterpret_cast<uint16_t const*>(in), reinterpret_cast<float*>(out), count * 4);
+}
+
+void Pack(Quaternion const* in, PackedQuaternion32* out, size_t count) {
+    Active()->pack32(in, reinterpret_cast<uint32_t*>(out), count);
+}
+
+void Pack(Quaternion const* in, PackedQuaternion48* out, size_t count) {
+    Active()->pack48(in, reinterpret_cast<uint16_t*>(out), count);
+}
+
+void Unpack(PackedQuaternion32 const* in, Quaternion* out, size_t count) {
+    Active()->unpack32(reinterpret_cast<uint32_t const*>(in), out, count);
+}
+
+void Unpack(PackedQuaternion48 const* in, Quaternion* out, size_t count) {
+    Active()->unpack48(reinterpret_cast<uint16_t const*>(in), out, count);
+}
+
+// The packed normals are read and written as one little endian word per vector, x in the
+// low half.
+void Pack(Vector3 const* in, PackedNormal32* out, size_t count) {
+    Active()->packNormals32(in, reinterpret_cast<uint32_t*>(out), count);
+}
+
+void Pack(Vector3 const* in, PackedNormal16* out, size_t count) {
+    Active()->packNormals16(in, reinterpret_cast<uint16_t*>(out), count);
+}
+
+void Unpack(PackedNormal32 const* in, Vector3* out, size_t count) {
+    Active()->unpackNormals32(reinterpret_cast<uint32_t const*>(in), out, count);
+}
+
+void Unpack(PackedNormal16 const* in, Vector3* out, size_t count) {
+    Active()->unpackNormals16(reinterpret_cast<uint16_t const*>(in), out, count);
+}
+#endif
+
+} } // ::xo::batch
+
+namespace xo {
+#if defined(XO_MATH_IMPL)
+////////////////////////////////////////////////////////////////////////////////////////// Matrix transforms
+// The span transforms on the matrix types run on the same kernel table as the batch
+// functions. Like those, they cast the array pointers instead of taking &in->x, which is
+// undefined for the null pointer an empty span may pass.
+void XO_CC Matrix4x4::TransformPoints(Vector3 const* in, Vector3* out, size_t count,
+                                      size_t inStride, size_t outStride) const {
+    batch::Active()->transform3(v, reinterpret_cast<float const*>(in), inStride,
+                                reinterpret_cast<float*>(out), outStride, count, 1.f);
+}
+
+void XO_CC Matrix4x4::TransformDirections(Vector3 const* in, Vector3* out, size_t count,
+                                          size_t inStride, size_t outStride) const {
+    batch::Active()->transform3(v, reinterpret_cast<float const*>(in), inStride,
+                                reinterpret_cast<float*>(out), outStride, count, 0.f);
+}
+
+void XO_CC Matrix4x4::TransformHomogeneous(Vector4 const* in, Vector4* out, size_t count,
+                                           size_t inStride, size_t outStride) const {
+    batch::Active()->transform4(v, reinterpret_cast<float const*>(in), inStride,
+                                reinterpret_cast<float*>(out), outStride, count);
+}
+
+void XO_CC AMatrix4x4::TransformPoints(AVector3 const* in, AVector3* out, size_t count,
+                                       size_t inStride, size_t outStride) const {
+    batch::Active()->transform3(v, reinterpret_cast<float const*>(in), inStride,
+                                reinterpret_cast<float*>(out), outStride, count, 1.f);
+}
+
+void XO_CC AMatrix4x4::TransformDirections(AVector3 const* in, AVector3* out, size_t count,
+                                           size_t inStride, size_t outStride) const {
+    batch::Active()->transform3(v, reinterpret_cast<float const*>(in), inStride,
+                                reinterpret_cast<float*>(out), outStride, count, 0.f);
+}
+
+void XO_CC AMatrix4x4::TransformHomogeneous(AVector4 const* in, AVector4* out, size_t count,
+                                            size_t inStride, size_t outStride) const {
+    batch::Active()->transform4(v, reinterpret_cast<float const*>(in), inStride,
+                                reinterpret_cast<float*>(out), outStride, count);
+}
+
+// Both matrix types are 16 floats with no padding, so an array of either is a flat run of
+// floats for the kernels.
+/*static*/
+void XO_CC Matrix4x4::Multiply(Matrix4x4 const* left, Matrix4x4 const* right, Matrix4x4* out,
+                               size_t count) {
+    static_assert(sizeof(Matrix4x4) == 16 * sizeof(float), "Matrix4x4 arrays must be packed");
+    batch::Active()->multiply4x4(reinterpret_cast<float const*>(left), reinterpret_cast<float const*>(right),
+                                 reinterpret_cast<float*>(out), count);
+}
+
+/*static*/
+void XO_CC AMatrix4x4::Multiply(AMatrix4x4 const* left, AMatrix4x4 const* right, AMatrix4x4* out,
+                                size_t count) {
+    static_assert(sizeof(AMatrix4x4) == 16 * sizeof(float), "AMatrix4x4 arrays must be packed");
+    batch::Active()->multiply4x4(reinterpret_cast<float const*>(left), reinterpret_cast<float const*>(right),
+                                 reinterpret_cast<float*>(out), count);
+}
+#endif
+} // ::xo
+
+////////////////////////////////////////////////////////////////////////////////////////// end xo-math-batch.h inline
+////////////////////////////////////////////////////////////////////////////////////////// xo-math-lazy.h inlined
+#line 7 "xo-math-lazy.h"
+#include <type_traits>
+namespace xo { namespace lazy {
+// Expression templates over Vector3 and Vector4, opt in: nothing else in xo-math uses them.
+// Wrap the operands with Of() and +, -, * and / build a tree instead of doing any math.
+// Evaluate then runs the whole tree once per component, so there are no Vector3
+// temporaries in between and scalars stay floats instead of becoming Vector3(value).
+//
+//     Vector3 p = lazy::Evaluate(lazy::Of(a) + (lazy::Of(b) - lazy::Of(a)) * t + lazy::Of(c) * s);
+//
+// Over arrays the components are evaluated as one flat run of floats, Width at a time in a
+// FloatN<Width>, so the whole expression is a single loop.
+//
+//     lazy::Evaluate(lazy::Of(positions, count) + lazy::Of(velocities, count) * dt, positions);
+//
+// Arrays and single vectors can't be mixed in one expression, and every array needs the
+// same count. Nodes hold references to their operands, build and evaluate in one statement.
+
+// FloatN<Width> is the widest register the build targets.
+#if XO_SSE_CURRENT >= XO_AVX512
+constexpr int Width = 16;
+#elif XO_SSE_CURRENT >= XO_AVX || XO_HAS_FMA
+constexpr int Width = 8;
+#elif XO_HAS_SSE
+constexpr int Width = 4;
+#else
+constexpr int Width = 8;
+#endif
+
+template<typename V> struct Components;
+template<> struct Components<Vector3> { static constexpr int value = 3; };
+template<> struct Components<Vector4> { static constexpr int value = 4; };
+
+XO_INL float const* Floats(Vector3 const& v) { return &v.x; }
+XO_INL float* Floats(Vector3& v) { return &v.x; }
+XO_INL float const* Floats(Vector4 const& v) { return v.v; }
+XO_INL float* Floats(Vector4& v) { return v.v; }
+
+// Every node has a Value (the vector type it produces, void for a scalar), IsArray, the
+// array length as Count() (0 when it isn't an array), At(k) for flat component k and
+// Block<F>(k) for the F::Load of components k onwards.
+template<typename T> struct IsNode : std::false_type { };
+
+template<typename V>
+struct Ref {
+    typedef V Value;
+    static constexpr bool IsArray = false;
+    V const& v;
+
+    size_t Count() const { return 0; }
+    XO_INL float At(size_t k) const { return Floats(v)[k]; }
+};
+
+template<typename V>
+struct Span {
+    typedef V Value;
+    static constexpr bool IsArray = true;
+    V const* data;
+    size_t count;
+
+    size_t Count() const { return count; }
+    XO_INL float At(size_t k) const { return Floats(*data)[k]; }
+    template<typename F> XO_INL F Block(size_t k) const { return F::Load(Floats(*data) + k); }
+};
+
+struct Scalar {
+    typedef void Value;
+    static constexpr bool IsArray = false;
+    float s;
+
+    size_t Count() const { return 0; }
+    XO_INL float At(size_t) const { return s; }
+    template<typename F> XO_INL F Block(size_t) const { return F(s); }
+};
+
+struct Add      { template<typename T> static XO_INL T Apply(T const& l, T const& r) { return l + r; } };
+struct Subtract { template<typename T> static XO_INL T Apply(T const& l, T const& r) { return l - r; } };
+struct Multiply { template<typename T> static XO_INL T Apply(T const& l, T const& r) { return l * r; } };
+struct Divide   { template<typename T> static XO_INL T Apply(T const& l, T const& r) { return l / r; } };
+
+template<typename L, typename R>
+struct BinaryValue {
+    static_assert(std::is_void<typename L::Value>::value || std::is_void<typename R::Value>::value ||
+                  std::is_same<typename L::Value, typename R::Value>::value,
+                  "xo::lazy can't mix Vector3 and Vector4 operands");
+    static_assert(std::is_void<typename L::Value>::value || std::is_void<typename R::Value>::value ||
+                  L::IsArray == R::IsArray,
+                  "xo::lazy can't mix arrays and single vectors");
+    typedef typename std::conditional<std::is_void<typename L::Value>::value,
+                                      typename R::Value, typename L::Value>::type type;
+};
+
+template<typename Op, typename L, typename R>
+struct Binary {
+    typedef typename BinaryValue<L, R>::type Value;
+    static constexpr bool IsArray = L::IsArray || R::IsArray;
+    L l;
+    R r;
+
+    size_t Count() const { return L::IsArray ? l.Count() : r.Count(); }
+    XO_INL float At(size_t k) const { return Op::Apply(l.At(k), r.At(k)); }
+    template<typename F> XO_INL F Block(size_t k) const {
+        return Op::Apply(l.template Block<F>(k), r.template Block<F>(k));
+    }
+};
+
+template<typename E>
+struct Negate {
+    typedef typename E::Value Value;
+    static constexpr bool IsArray = E::IsArray;
+    E e;
+
+    size_t Count() const { return e.Count(); }
+    XO_INL float At(size_t k) const { return -e.At(k); }
+    template<typename F> XO_INL F Block(size_t k) const { return -e.template Block<F>(k); }
+};
+
+template<typename V> struct IsNode<Ref<V>> : std::true_type { };
+template<typename V> struct IsNode<Span<V>> : std::true_type { };
+template<> struct IsNode<Scalar> : std::true_type { };
+template<typename Op, typename L, typename R> struct IsNode<Binary<Op, L, R>> : std::true_type { };
+template<typename E> struct IsNode<Negate<E>> : std::true_type { };
+
+template<typename V> XO_INL Ref<V> Of(V const& v) { return Ref<V>{ v }; }
+template<typename V> XO_INL Span<V> Of(V const* v, size_t count) { return Span<V>{ v, count }; }
+
+// node op node, node op float and float op node.
+#define XO_LAZY_OPERATOR(op, Op) \
+    template<typename L, typename R, \
+             typename = typename std::enable_if<IsNode<L>::value && IsNode<R>::value>::type> \
+    XO_INL Binary<Op, L, R> operator op (L const& l, R const& r) { return Binary<Op, L, R>{ l, r }; } \
+    template<typename L, typename = typename std::enable_if<IsNode<L>::value>::type> \
+    XO_INL Binary<Op, L, Scalar> operator op (L const& l, float r) { return Binary<Op, L, Scalar>{ l, Scalar{ r } }; } \
+    template<typename R, typename = typename std::enable_if<IsNode<R>::value>::type> \
+    XO_INL Binary<Op, Scalar, R> operator op (float l, R const& r) { return Binary<Op, Scalar, R>{ Scalar{ l }, r }; }
+
+XO_LAZY_OPERATOR(+, Add)
+XO_LAZY_OPERATOR(-, Subtract)
+XO_LAZY_OPERATOR(*, Multiply)
+XO_LAZY_OPERATOR(/, Divide)
+#undef XO_LAZY_OPERATOR
+
+template<typename E, typename = typename std::enable_if<IsNode<E>::value>::type>
+XO_INL Negate<E> operator - (E const& e) { return Negate<E>{ e }; }
+
+// The vector an expression over single vectors comes to.
+template<typename E>
+XO_INL typename E::Value Evaluate(E const& e) {
+    static_assert(!E::IsArray, "xo::lazy::Evaluate(e) is for single vectors, pass an output array");
+    typedef typename E::Value V;
+    V result;
+    float* out = Floats(result);
+    for (int k = 0; k < Components<V>::value; ++k) {
+        out[k] = e.At(k);
+    }
+    return result;
+}
+
+// Writes an expression over arrays to out, which may be one of the arrays in it.
+template<typename E>
+XO_INL void Evaluate(E const& e, typename E::Value* out) {
+    static_assert(E::IsArray, "xo::lazy::Evaluate(e, out) is for arrays");
+    typedef FloatN<Width> F;
+    size_t const floats = e.Count() * Components<typename E::Value>::value;
+    float* o = Floats(*out);
+    size_t k = 0;
+    for (; k + Width <= floats; k += Width) {
+        e.template Block<F>(k).Store(o + k);
+    }
+    for (; k < floats; ++k) {
+        o[k] = e.At(k);
+    }
+}
+} } // ::xo::lazy
+
+////////////////////////////////////////////////////////////////////////////////////////// end xo-math-lazy.h inline
+
 ////////////////////////////////////////////////////////////////////////////////////////// third-party-licenses.h inlined
 #line 3 "third-party-licenses.h"
 /*****************************************************************************************
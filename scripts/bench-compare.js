@@ -0,0 +1,75 @@
+"use strict";
+
+// Compares two xomath_bench --json files, like the reference and SSE4.1 backends or the
+// last release and this one:
+//
+//     node bench-compare.js before.json after.json
+//
+// Prints ns/op for both and before / after for every result they share. Ones that got more
+// than 10% slower are marked with a !. Runs with --counters also get cycles per op. Then
+// the max ulp errors of the accuracy group where they changed, with a ! for 10% worse.
+
+const fs = require('fs');
+
+function Load(path) {
+    const run = JSON.parse(fs.readFileSync(path, 'utf8'));
+    const results = new Map();
+    for(const r of run.results) {
+        results.set(`${r.group}\t${r.name}\t${r.mode}`, r);
+    }
+    const accuracy = new Map();
+    for(const a of run.accuracy || []) {
+        accuracy.set(`${a.group}\t${a.name}`, a);
+    }
+    return { run: run, results: results, accuracy: accuracy };
+}
+
+function Describe(run) {
+    return `${run.backend}, ${run.compiled_sse} build on ${run.running_sse}, ${run.compiler}`;
+}
+
+if(process.argv.length != 4) {
+    console.error('usage: node bench-compare.js before.json after.json');
+    process.exit(1);
+}
+
+const before = Load(process.argv[2]);
+const after = Load(process.argv[3]);
+console.log(`before: ${Describe(before.run)}`);
+console.log(`after:  ${Describe(after.run)}`);
+console.log('');
+console.log(`${'name'.padEnd(44)} ${'mode'.padEnd(10)} ${'before'.padStart(10)} ${'after'.padStart(10)} ${'speedup'.padStart(8)}`);
+
+let missing = 0;
+for(const [key, b] of before.results) {
+    const a = after.results.get(key);
+    if(!a) {
+        ++missing;
+        continue;
+    }
+    const speedup = b.ns_per_op / a.ns_per_op;
+    let cycles = '';
+    if(b.counters_per_op && a.counters_per_op && b.counters_per_op.cycles != null && a.counters_per_op.cycles != null) {
+        cycles = `   cycles ${b.counters_per_op.cycles.toFixed(2)} -> ${a.counters_per_op.cycles.toFixed(2)}`;
+    }
+    console.log(`${b.name.padEnd(44)} ${b.mode.padEnd(10)} ${b.ns_per_op.toFixed(3).padStart(10)} ${a.ns_per_op.toFixed(3).padStart(10)} ${speedup.toFixed(2).padStart(7)}x${speedup < 1 / 1.1 ? ' !' : (cycles ? '  ' : '')}${cycles}`);
+}
+const added = [...after.results.keys()].filter(key => !before.results.has(key)).length;
+if(missing || added) {
+    console.log(`\n${missing} result(s) only in before, ${added} only in after`);
+}
+
+const changed = [];
+for(const [key, b] of before.accuracy) {
+    const a = after.accuracy.get(key);
+    if(a && (a.max_ulp != b.max_ulp || a.non_finite != b.non_finite)) {
+        changed.push([b, a]);
+    }
+}
+if(changed.length) {
+    console.log(`\n${'accuracy'.padEnd(44)} ${'max ulp before'.padStart(14)} ${'after'.padStart(10)}`);
+    for(const [b, a] of changed) {
+        const nonFinite = a.non_finite != b.non_finite ? `   non-finite ${b.non_finite} -> ${a.non_finite}` : '';
+        console.log(`${b.name.padEnd(44)} ${b.max_ulp.toPrecision(3).padStart(14)} ${a.max_ulp.toPrecision(3).padStart(10)}${a.max_ulp > b.max_ulp * 1.1 ? ' !' : ''}${nonFinite}`);
+    }
+}
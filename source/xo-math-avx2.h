@@ -0,0 +1,868 @@
+#pragma once
+#include <inttypes.h>
+#include "xo-math-macros.h"
+#include "xo-math-detect-simd.h"
+// $inline_begin
+#if !defined(XO_CONFIG_RUNTIME_DISPATCH)
+#   define XO_CONFIG_RUNTIME_DISPATCH 1
+#endif
+
+#if defined(XO_MATH_IMPL) && XO_X86 && (XO_CONFIG_RUNTIME_DISPATCH || (XO_SSE_CURRENT >= XO_AVX2 && XO_HAS_FMA && XO_HAS_F16C))
+#define XO_BATCH_AVX2 1
+#include <immintrin.h>
+// Everything in here is compiled for AVX2, FMA3 and F16C regardless of the flags of the
+// translation unit. It's only called through the batch kernel table after the cpu has been
+// checked.
+#if defined(__clang__)
+#   pragma clang attribute push (__attribute__((target("avx2,fma,f16c"))), apply_to = function)
+#elif defined(__GNUC__)
+#   pragma GCC push_options
+#   pragma GCC target("avx2,fma,f16c")
+#endif
+namespace xo { namespace avx2 {
+// 8 wide kernels over contiguous arrays, see xo-math-batch.h. The tail of an array is
+// loaded and stored with maskload/maskstore so nothing past the end of an array is touched.
+
+XO_INL __m256i Lanes() {
+    return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+}
+
+XO_INL __m256i TailMask(size_t count) {
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(count < 8 ? count : 8)), Lanes());
+}
+
+// Loads up to 24 floats (8 Vector3s), zeroing anything past 'floats'.
+XO_INL void Load3(float const* in, size_t floats, __m256& r0, __m256& r1, __m256& r2) {
+    r0 = _mm256_maskload_ps(in, TailMask(floats));
+    r1 = _mm256_maskload_ps(in + 8, TailMask(floats > 8 ? floats - 8 : 0));
+    r2 = _mm256_maskload_ps(in + 16, TailMask(floats > 16 ? floats - 16 : 0));
+}
+
+XO_INL void Store3(float* out, size_t floats, __m256 r0, __m256 r1, __m256 r2) {
+    _mm256_maskstore_ps(out, TailMask(floats), r0);
+    _mm256_maskstore_ps(out + 8, TailMask(floats > 8 ? floats - 8 : 0), r1);
+    _mm256_maskstore_ps(out + 16, TailMask(floats > 16 ? floats - 16 : 0), r2);
+}
+
+// Picks 'value' from a, b or c for each lane, by which of 0, 1 or 2 'which' holds.
+XO_INL __m256 Select3(__m256 a, __m256 b, __m256 c, __m256i which) {
+    __m256 isB = _mm256_castsi256_ps(_mm256_cmpeq_epi32(which, _mm256_set1_epi32(1)));
+    __m256 isC = _mm256_castsi256_ps(_mm256_cmpeq_epi32(which, _mm256_set1_epi32(2)));
+    return _mm256_blendv_ps(_mm256_blendv_ps(a, b, isB), c, isC);
+}
+
+// Picks component c (0 = x, 1 = y, 2 = z) of 8 interleaved Vector3s held in r0, r1, r2.
+XO_INL __m256 Deinterleave3(__m256 r0, __m256 r1, __m256 r2, int c) {
+    // permutevar8x32 only looks at the low 3 bits, k >> 3 says which register to take.
+    __m256i k = _mm256_add_epi32(_mm256_mullo_epi32(Lanes(), _mm256_set1_epi32(3)),
+                                 _mm256_set1_epi32(c));
+    return Select3(_mm256_permutevar8x32_ps(r0, k),
+                   _mm256_permutevar8x32_ps(r1, k),
+                   _mm256_permutevar8x32_ps(r2, k),
+                   _mm256_srli_epi32(k, 3));
+}
+
+// Builds register r (0, 1 or 2) of the interleaved form of 8 Vector3s held as x, y, z.
+XO_INL __m256 Interleave3(__m256 x, __m256 y, __m256 z, int r) {
+    __m256i k = _mm256_add_epi32(Lanes(), _mm256_set1_epi32(8 * r));
+    // k / 3 for k < 24
+    __m256i vec = _mm256_srli_epi32(_mm256_mullo_epi32(k, _mm256_set1_epi32(0xAAAB)), 17);
+    __m256i c = _mm256_sub_epi32(k, _mm256_mullo_epi32(vec, _mm256_set1_epi32(3)));
+    return Select3(_mm256_permutevar8x32_ps(x, vec),
+                   _mm256_permutevar8x32_ps(y, vec),
+                   _mm256_permutevar8x32_ps(z, vec),
+                   c);
+}
+
+// Sums each group of 4 lanes and broadcasts the sum back to the group.
+XO_INL __m256 SumQuads(__m256 m) {
+    m = _mm256_add_ps(m, _mm256_permute_ps(m, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm256_add_ps(m, _mm256_permute_ps(m, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+struct AddOp      { static XO_INL __m256 Apply(__m256 l, __m256 r) { return _mm256_add_ps(l, r); } };
+struct SubtractOp { static XO_INL __m256 Apply(__m256 l, __m256 r) { return _mm256_sub_ps(l, r); } };
+struct MultiplyOp { static XO_INL __m256 Apply(__m256 l, __m256 r) { return _mm256_mul_ps(l, r); } };
+struct DivideOp   { static XO_INL __m256 Apply(__m256 l, __m256 r) { return _mm256_div_ps(l, r); } };
+
+// An array of Vector3s or Vector4s as the floats it's made of. Casts the pointer rather than
+// taking &in->x, so an empty array may be null.
+template<typename T>
+XO_INL float const* Floats(T const* vectors) { return reinterpret_cast<float const*>(vectors); }
+template<typename T>
+XO_INL float* Floats(T* vectors) { return reinterpret_cast<float*>(vectors); }
+
+template<typename Op>
+XO_INL void Elementwise(float const* left, float const* right, float* out, size_t floats) {
+    size_t i = 0;
+    for (; i + 8 <= floats; i += 8) {
+        _mm256_storeu_ps(out + i, Op::Apply(_mm256_loadu_ps(left + i), _mm256_loadu_ps(right + i)));
+    }
+    if (i < floats) {
+        __m256i m = TailMask(floats - i);
+        // masked off lanes are zero in both inputs, DivideOp's 0/0 there is never stored.
+        __m256 l = _mm256_maskload_ps(left + i, m);
+        __m256 r = _mm256_maskload_ps(right + i, m);
+        _mm256_maskstore_ps(out + i, m, Op::Apply(l, r));
+    }
+}
+
+XO_INL void LerpFloats(float const* left, float const* right, float t, float* out, size_t floats) {
+    __m256 tt = _mm256_set1_ps(t);
+    for (size_t i = 0; i < floats; i += 8) {
+        __m256i m = TailMask(floats - i);
+        __m256 l = _mm256_maskload_ps(left + i, m);
+        __m256 r = _mm256_maskload_ps(right + i, m);
+        _mm256_maskstore_ps(out + i, m, _mm256_fmadd_ps(tt, _mm256_sub_ps(r, l), l));
+    }
+}
+
+void Add3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Elementwise<AddOp>(Floats(left), Floats(right), Floats(out), count * 3);
+}
+
+void Subtract3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Elementwise<SubtractOp>(Floats(left), Floats(right), Floats(out), count * 3);
+}
+
+void Multiply3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Elementwise<MultiplyOp>(Floats(left), Floats(right), Floats(out), count * 3);
+}
+
+void Divide3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Elementwise<DivideOp>(Floats(left), Floats(right), Floats(out), count * 3);
+}
+
+void DotProduct3(Vector3 const* left, Vector3 const* right, float* out, size_t count) {
+    float const* l = Floats(left);
+    float const* r = Floats(right);
+    for (size_t i = 0; i < count; i += 8) {
+        size_t floats = (count - i) * 3;
+        __m256 l0, l1, l2, r0, r1, r2;
+        Load3(l + i * 3, floats, l0, l1, l2);
+        Load3(r + i * 3, floats, r0, r1, r2);
+        __m256 d = _mm256_mul_ps(Deinterleave3(l0, l1, l2, 0), Deinterleave3(r0, r1, r2, 0));
+        d = _mm256_fmadd_ps(Deinterleave3(l0, l1, l2, 1), Deinterleave3(r0, r1, r2, 1), d);
+        d = _mm256_fmadd_ps(Deinterleave3(l0, l1, l2, 2), Deinterleave3(r0, r1, r2, 2), d);
+        _mm256_maskstore_ps(out + i, TailMask(count - i), d);
+    }
+}
+
+void CrossProduct3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    float const* l = Floats(left);
+    float const* r = Floats(right);
+    for (size_t i = 0; i < count; i += 8) {
+        size_t floats = (count - i) * 3;
+        __m256 l0, l1, l2, r0, r1, r2;
+        Load3(l + i * 3, floats, l0, l1, l2);
+        Load3(r + i * 3, floats, r0, r1, r2);
+        __m256 lx = Deinterleave3(l0, l1, l2, 0);
+        __m256 ly = Deinterleave3(l0, l1, l2, 1);
+        __m256 lz = Deinterleave3(l0, l1, l2, 2);
+        __m256 rx = Deinterleave3(r0, r1, r2, 0);
+        __m256 ry = Deinterleave3(r0, r1, r2, 1);
+        __m256 rz = Deinterleave3(r0, r1, r2, 2);
+        __m256 x = _mm256_fmsub_ps(ly, rz, _mm256_mul_ps(lz, ry));
+        __m256 y = _mm256_fmsub_ps(lz, rx, _mm256_mul_ps(lx, rz));
+        __m256 z = _mm256_fmsub_ps(lx, ry, _mm256_mul_ps(ly, rx));
+        Store3(Floats(out) + i * 3, floats,
+               Interleave3(x, y, z, 0), Interleave3(x, y, z, 1), Interleave3(x, y, z, 2));
+    }
+}
+
+// 1/sqrt(m) for Precision::Fast and Fastest: rsqrtps, then one Newton-Raphson step
+// r * (1.5 - 0.5 * m * r * r) for Fast. Denormal m are scaled into range, see xo::rsqrt.
+XO_INL __m256 InverseSqrt(__m256 m, Precision precision) {
+    __m256 const tiny = _mm256_cmp_ps(m, _mm256_set1_ps(rsqrt::Tiny), _CMP_LT_OQ);
+    m = _mm256_blendv_ps(m, _mm256_mul_ps(m, _mm256_set1_ps(rsqrt::ScaleUp)), tiny);
+    __m256 const scale = _mm256_blendv_ps(_mm256_set1_ps(1.f), _mm256_set1_ps(rsqrt::ScaleBack), tiny);
+    __m256 r = _mm256_rsqrt_ps(m);
+    if (precision == Precision::Fastest) {
+        return _mm256_mul_ps(r, scale);
+    }
+    __m256 halfMR = _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), m), r);
+    return _mm256_mul_ps(_mm256_mul_ps(r, scale), _mm256_fnmadd_ps(halfMR, r, _mm256_set1_ps(1.5f)));
+}
+
+void Normalize3(Vector3 const* in, Vector3* out, size_t count, Precision precision) {
+    for (size_t i = 0; i < count; i += 8) {
+        size_t floats = (count - i) * 3;
+        __m256 r0, r1, r2;
+        Load3(Floats(in) + i * 3, floats, r0, r1, r2);
+        __m256 x = Deinterleave3(r0, r1, r2, 0);
+        __m256 y = Deinterleave3(r0, r1, r2, 1);
+        __m256 z = Deinterleave3(r0, r1, r2, 2);
+        __m256 lengthSquared = _mm256_fmadd_ps(z, z, _mm256_fmadd_ps(y, y, _mm256_mul_ps(x, x)));
+        if (precision == Precision::Exact) {
+            __m256 len = _mm256_sqrt_ps(lengthSquared);
+            x = _mm256_div_ps(x, len);
+            y = _mm256_div_ps(y, len);
+            z = _mm256_div_ps(z, len);
+        }
+        else {
+            __m256 scale = InverseSqrt(lengthSquared, precision);
+            x = _mm256_mul_ps(x, scale);
+            y = _mm256_mul_ps(y, scale);
+            z = _mm256_mul_ps(z, scale);
+        }
+        Store3(Floats(out) + i * 3, floats,
+               Interleave3(x, y, z, 0), Interleave3(x, y, z, 1), Interleave3(x, y, z, 2));
+    }
+}
+
+void Lerp3(Vector3 const* left, Vector3 const* right, float t, Vector3* out, size_t count) {
+    LerpFloats(Floats(left), Floats(right), t, Floats(out), count * 3);
+}
+
+void Add4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Elementwise<AddOp>(Floats(left), Floats(right), Floats(out), count * 4);
+}
+
+void Subtract4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Elementwise<SubtractOp>(Floats(left), Floats(right), Floats(out), count * 4);
+}
+
+void Multiply4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Elementwise<MultiplyOp>(Floats(left), Floats(right), Floats(out), count * 4);
+}
+
+void Divide4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Elementwise<DivideOp>(Floats(left), Floats(right), Floats(out), count * 4);
+}
+
+void DotProduct4(Vector4 const* left, Vector4 const* right, float* out, size_t count) {
+    // Lane 4h+m of the blended sums holds the dot product of vector 2m+h in the block.
+    __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    for (size_t i = 0; i < count; i += 8) {
+        size_t floats = (count - i) * 4;
+        __m256 s[4];
+        for (int m = 0; m < 4; ++m) {
+            __m256i mask = TailMask(floats > size_t(m) * 8 ? floats - m * 8 : 0);
+            __m256 l = _mm256_maskload_ps(left[i].v + m * 8, mask);
+            __m256 r = _mm256_maskload_ps(right[i].v + m * 8, mask);
+            s[m] = SumQuads(_mm256_mul_ps(l, r));
+        }
+        __m256 d = _mm256_blend_ps(s[0], s[1], 0x22);
+        d = _mm256_blend_ps(d, s[2], 0x44);
+        d = _mm256_blend_ps(d, s[3], 0x88);
+        _mm256_maskstore_ps(out + i, TailMask(count - i), _mm256_permutevar8x32_ps(d, order));
+    }
+}
+
+void Normalize4(Vector4 const* in, Vector4* out, size_t count, Precision precision) {
+    size_t floats = count * 4;
+    for (size_t i = 0; i < floats; i += 8) {
+        __m256i m = TailMask(floats - i);
+        __m256 v = _mm256_maskload_ps(Floats(in) + i, m);
+        __m256 lengthSquared = SumQuads(_mm256_mul_ps(v, v));
+        if (precision == Precision::Exact) {
+            v = _mm256_div_ps(v, _mm256_sqrt_ps(lengthSquared));
+        }
+        else {
+            v = _mm256_mul_ps(v, InverseSqrt(lengthSquared, precision));
+        }
+        _mm256_maskstore_ps(Floats(out) + i, m, v);
+    }
+}
+
+void Lerp4(Vector4 const* left, Vector4 const* right, float t, Vector4* out, size_t count) {
+    LerpFloats(Floats(left), Floats(right), t, Floats(out), count * 4);
+}
+
+// Splits 8 Quaternions (or Vector4s) held two to a register in a0..a3 into one register
+// per component, in array order.
+XO_INL void Deinterleave4(__m256 a0, __m256 a1, __m256 a2, __m256 a3, __m256 c[4]) {
+    // A 4x4 transpose in each half leaves lane 4h+m holding element 2m+h.
+    __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    __m256 t0 = _mm256_unpacklo_ps(a0, a1);
+    __m256 t1 = _mm256_unpackhi_ps(a0, a1);
+    __m256 t2 = _mm256_unpacklo_ps(a2, a3);
+    __m256 t3 = _mm256_unpackhi_ps(a2, a3);
+    c[0] = _mm256_permutevar8x32_ps(_mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)), order);
+    c[1] = _mm256_permutevar8x32_ps(_mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)), order);
+    c[2] = _mm256_permutevar8x32_ps(_mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)), order);
+    c[3] = _mm256_permutevar8x32_ps(_mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2)), order);
+}
+
+// Loads up to 32 floats (8 Quaternions or Vector4s) split into one register per
+// component, zeroing anything past 'floats'.
+XO_INL void Load4(float const* in, size_t floats, __m256 c[4]) {
+    __m256 a[4];
+    if (floats >= 32) {
+        for (int m = 0; m < 4; ++m) a[m] = _mm256_loadu_ps(in + m * 8);
+    }
+    else {
+        for (int m = 0; m < 4; ++m) {
+            a[m] = _mm256_maskload_ps(in + m * 8, TailMask(floats > size_t(m) * 8 ? floats - m * 8 : 0));
+        }
+    }
+    Deinterleave4(a[0], a[1], a[2], a[3], c);
+}
+
+// Undoes Deinterleave4 and stores the first 'floats' floats. Whole blocks skip the masks,
+// maskstore is slow on some cpus.
+XO_INL void Store4(float* out, size_t floats, __m256 const c[4]) {
+    __m256i order = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    __m256 p[4];
+    for (int m = 0; m < 4; ++m) p[m] = _mm256_permutevar8x32_ps(c[m], order);
+    __m256 t0 = _mm256_unpacklo_ps(p[0], p[1]);
+    __m256 t1 = _mm256_unpackhi_ps(p[0], p[1]);
+    __m256 t2 = _mm256_unpacklo_ps(p[2], p[3]);
+    __m256 t3 = _mm256_unpackhi_ps(p[2], p[3]);
+    __m256 a[4] = {
+        _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)),
+        _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)),
+        _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)),
+        _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2)) };
+    if (floats >= 32) {
+        for (int m = 0; m < 4; ++m) _mm256_storeu_ps(out + m * 8, a[m]);
+    }
+    else {
+        for (int m = 0; m < 4; ++m) {
+            _mm256_maskstore_ps(out + m * 8, TailMask(floats > size_t(m) * 8 ? floats - m * 8 : 0), a[m]);
+        }
+    }
+}
+
+// v + 2r(q x v) + q x 2(q x v), see Quaternion::Rotate.
+void Rotate3(Quaternion const* rotations, Vector3 const* in, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; i += 8) {
+        __m256 q[4];
+        Load4(rotations[i].vec4.v, (count - i) * 4, q);
+        __m256 r0, r1, r2;
+        Load3(Floats(in) + i * 3, (count - i) * 3, r0, r1, r2);
+        __m256 x = Deinterleave3(r0, r1, r2, 0);
+        __m256 y = Deinterleave3(r0, r1, r2, 1);
+        __m256 z = Deinterleave3(r0, r1, r2, 2);
+        __m256 two = _mm256_set1_ps(2.f);
+        __m256 tx = _mm256_mul_ps(two, _mm256_fmsub_ps(q[1], z, _mm256_mul_ps(q[2], y)));
+        __m256 ty = _mm256_mul_ps(two, _mm256_fmsub_ps(q[2], x, _mm256_mul_ps(q[0], z)));
+        __m256 tz = _mm256_mul_ps(two, _mm256_fmsub_ps(q[0], y, _mm256_mul_ps(q[1], x)));
+        x = _mm256_add_ps(_mm256_fmadd_ps(q[3], tx, x), _mm256_fmsub_ps(q[1], tz, _mm256_mul_ps(q[2], ty)));
+        y = _mm256_add_ps(_mm256_fmadd_ps(q[3], ty, y), _mm256_fmsub_ps(q[2], tx, _mm256_mul_ps(q[0], tz)));
+        z = _mm256_add_ps(_mm256_fmadd_ps(q[3], tz, z), _mm256_fmsub_ps(q[0], ty, _mm256_mul_ps(q[1], tx)));
+        Store3(Floats(out) + i * 3, (count - i) * 3,
+               Interleave3(x, y, z, 0), Interleave3(x, y, z, 1), Interleave3(x, y, z, 2));
+    }
+}
+
+XO_INL float const* At(float const* base, size_t index, size_t stride) {
+    return reinterpret_cast<float const*>(reinterpret_cast<char const*>(base) + index * stride);
+}
+
+XO_INL float* At(float* base, size_t index, size_t stride) {
+    return reinterpret_cast<float*>(reinterpret_cast<char*>(base) + index * stride);
+}
+
+// out = (in.xyz, w) times m as a row vector, 8 vectors at a time. Strides are in bytes, tightly
+// packed arrays are deinterleaved in registers, anything else is gathered.
+void Transform3(float const* m,
+                float const* in, size_t inStride,
+                float* out, size_t outStride,
+                size_t count, float w) {
+    __m256 r[3][4];
+    for (int i = 0; i < 3; ++i) {
+        r[i][0] = _mm256_set1_ps(m[i]);
+        r[i][1] = _mm256_set1_ps(m[4 + i]);
+        r[i][2] = _mm256_set1_ps(m[8 + i]);
+        r[i][3] = _mm256_set1_ps(m[12 + i] * w);
+    }
+    bool const packedIn = inStride == 3 * sizeof(float);
+    bool const packedOut = outStride == 3 * sizeof(float);
+    __m256i const offsets = _mm256_mullo_epi32(Lanes(), _mm256_set1_epi32(static_cast<int>(inStride)));
+    for (size_t i = 0; i < count; i += 8) {
+        size_t const n = count - i < 8 ? count - i : 8;
+        float const* src = At(in, i, inStride);
+        __m256 x, y, z;
+        if (packedIn) {
+            __m256 r0, r1, r2;
+            Load3(src, n * 3, r0, r1, r2);
+            x = Deinterleave3(r0, r1, r2, 0);
+            y = Deinterleave3(r0, r1, r2, 1);
+            z = Deinterleave3(r0, r1, r2, 2);
+        }
+        else {
+            __m256 const mask = _mm256_castsi256_ps(TailMask(n));
+            __m256 const zero = _mm256_setzero_ps();
+            x = _mm256_mask_i32gather_ps(zero, src, offsets, mask, 1);
+            y = _mm256_mask_i32gather_ps(zero, src + 1, offsets, mask, 1);
+            z = _mm256_mask_i32gather_ps(zero, src + 2, offsets, mask, 1);
+        }
+        __m256 o[3];
+        for (int j = 0; j < 3; ++j) {
+            o[j] = _mm256_fmadd_ps(r[j][0], x, _mm256_fmadd_ps(r[j][1], y, _mm256_fmadd_ps(r[j][2], z, r[j][3])));
+        }
+        float* dst = At(out, i, outStride);
+        if (packedOut) {
+            Store3(dst, n * 3,
+                   Interleave3(o[0], o[1], o[2], 0),
+                   Interleave3(o[0], o[1], o[2], 1),
+                   Interleave3(o[0], o[1], o[2], 2));
+        }
+        else {
+            alignas(32) float t[3][8];
+            for (int j = 0; j < 3; ++j) _mm256_store_ps(t[j], o[j]);
+            for (size_t k = 0; k < n; ++k) {
+                float* d = At(dst, k, outStride);
+                d[0] = t[0][k];
+                d[1] = t[1][k];
+                d[2] = t[2][k];
+            }
+        }
+    }
+}
+
+// Two Vector4s in v as row vectors times the matrix held as rows (each repeated in both halves).
+XO_INL __m256 Transform4(__m256 const row[4], __m256 v) {
+    __m256 lo = _mm256_mul_ps(_mm256_permute_ps(v, 0x00), row[0]);
+    __m256 hi = _mm256_mul_ps(_mm256_permute_ps(v, 0x55), row[1]);
+    lo = _mm256_fmadd_ps(_mm256_permute_ps(v, 0xAA), row[2], lo);
+    hi = _mm256_fmadd_ps(_mm256_permute_ps(v, 0xFF), row[3], hi);
+    return _mm256_add_ps(lo, hi);
+}
+
+// out = in * m for Vector4s, two per register and four per iteration.
+void Transform4(float const* m,
+                float const* in, size_t inStride,
+                float* out, size_t outStride,
+                size_t count) {
+    __m256 row[4];
+    for (int j = 0; j < 4; ++j) {
+        row[j] = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(m + 4 * j));
+    }
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256 a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(At(in, i, inStride))),
+                                        _mm_loadu_ps(At(in, i + 1, inStride)), 1);
+        __m256 b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(At(in, i + 2, inStride))),
+                                        _mm_loadu_ps(At(in, i + 3, inStride)), 1);
+        a = Transform4(row, a);
+        b = Transform4(row, b);
+        _mm_storeu_ps(At(out, i, outStride), _mm256_castps256_ps128(a));
+        _mm_storeu_ps(At(out, i + 1, outStride), _mm256_extractf128_ps(a, 1));
+        _mm_storeu_ps(At(out, i + 2, outStride), _mm256_castps256_ps128(b));
+        _mm_storeu_ps(At(out, i + 3, outStride), _mm256_extractf128_ps(b, 1));
+    }
+    for (; i < count; ++i) {
+        __m256 a = Transform4(row, _mm256_castps128_ps256(_mm_loadu_ps(At(in, i, inStride))));
+        _mm_storeu_ps(At(out, i, outStride), _mm256_castps256_ps128(a));
+    }
+}
+
+// out = left * right for row major 4x4 matrices, two rows of left per register and two
+// matrices per iteration. Each row of the product is the rows of right weighted by the
+// elements of the same row of left. Both inputs are read before out is written, so out may
+// be left or right.
+XO_INL void Multiply4x4(float const* left, float const* right, float* out) {
+    __m256 r[4];
+    for (int j = 0; j < 4; ++j) {
+        r[j] = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(right + 4 * j));
+    }
+    __m256 const l01 = _mm256_loadu_ps(left);
+    __m256 const l23 = _mm256_loadu_ps(left + 8);
+    __m256 a01 = _mm256_fmadd_ps(_mm256_permute_ps(l01, 0x55), r[1], _mm256_mul_ps(_mm256_permute_ps(l01, 0x00), r[0]));
+    __m256 b01 = _mm256_fmadd_ps(_mm256_permute_ps(l01, 0xFF), r[3], _mm256_mul_ps(_mm256_permute_ps(l01, 0xAA), r[2]));
+    __m256 a23 = _mm256_fmadd_ps(_mm256_permute_ps(l23, 0x55), r[1], _mm256_mul_ps(_mm256_permute_ps(l23, 0x00), r[0]));
+    __m256 b23 = _mm256_fmadd_ps(_mm256_permute_ps(l23, 0xFF), r[3], _mm256_mul_ps(_mm256_permute_ps(l23, 0xAA), r[2]));
+    _mm256_storeu_ps(out, _mm256_add_ps(a01, b01));
+    _mm256_storeu_ps(out + 8, _mm256_add_ps(a23, b23));
+}
+
+void Multiply4x4(float const* left, float const* right, float* out, size_t count) {
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        Multiply4x4(left + i * 16, right + i * 16, out + i * 16);
+        Multiply4x4(left + i * 16 + 16, right + i * 16 + 16, out + i * 16 + 16);
+    }
+    if (i < count) {
+        Multiply4x4(left + i * 16, right + i * 16, out + i * 16);
+    }
+}
+
+// slerp::Weight from xo-math-utilities.h.
+XO_INL __m256 SlerpWeight(__m256 cosine, __m256 t) {
+    __m256 const one = _mm256_set1_ps(1.f);
+    __m256 const xm1 = _mm256_sub_ps(cosine, one);
+    __m256 const tt = _mm256_mul_ps(t, t);
+    __m256 r = one;
+    for (int i = slerp::Terms - 1; i >= 0; --i) {
+        __m256 b = _mm256_mul_ps(_mm256_fmsub_ps(_mm256_set1_ps(slerp::U[i]), tt, _mm256_set1_ps(slerp::V[i])), xm1);
+        r = _mm256_fmadd_ps(b, r, one);
+    }
+    return _mm256_mul_ps(t, r);
+}
+
+// Dot products of 4 component vectors split into one register per component.
+XO_INL __m256 Dot4(__m256 const l[4], __m256 const r[4]) {
+    __m256 d = _mm256_mul_ps(l[0], r[0]);
+    d = _mm256_fmadd_ps(l[1], r[1], d);
+    d = _mm256_fmadd_ps(l[2], r[2], d);
+    return _mm256_fmadd_ps(l[3], r[3], d);
+}
+
+void Slerp(Quaternion const* start, Quaternion const* end, float const* t, Quaternion* out, size_t count) {
+    for (size_t i = 0; i < count; i += 8) {
+        size_t floats = (count - i) * 4;
+        __m256 s[4], e[4];
+        Load4(start[i].vec4.v, floats, s);
+        Load4(end[i].vec4.v, floats, e);
+        // Flipping end when start . end < 0 takes the shorter arc, like Quaternion::Slerp.
+        __m256 d = Dot4(s, e);
+        __m256 sign = _mm256_and_ps(d, _mm256_set1_ps(-0.f));
+        __m256 cosine = _mm256_xor_ps(d, sign);
+        __m256 te = count - i >= 8 ? _mm256_loadu_ps(t + i) : _mm256_maskload_ps(t + i, TailMask(count - i));
+        __m256 ts = _mm256_sub_ps(_mm256_set1_ps(1.f), te);
+        __m256 ws = SlerpWeight(cosine, ts);
+        __m256 we = _mm256_xor_ps(SlerpWeight(cosine, te), sign);
+        __m256 c[4];
+        for (int j = 0; j < 4; ++j) c[j] = _mm256_fmadd_ps(s[j], ws, _mm256_mul_ps(e[j], we));
+        Store4(out[i].vec4.v, floats, c);
+    }
+}
+
+void Nlerp(Quaternion const* start, Quaternion const* end, float const* t, Quaternion* out, size_t count, Precision precision) {
+    for (size_t i = 0; i < count; i += 8) {
+        size_t floats = (count - i) * 4;
+        __m256 s[4], e[4];
+        Load4(start[i].vec4.v, floats, s);
+        Load4(end[i].vec4.v, floats, e);
+        __m256 sign = _mm256_and_ps(Dot4(s, e), _mm256_set1_ps(-0.f));
+        __m256 te = count - i >= 8 ? _mm256_loadu_ps(t + i) : _mm256_maskload_ps(t + i, TailMask(count - i));
+        __m256 c[4];
+        for (int j = 0; j < 4; ++j) c[j] = _mm256_fmadd_ps(te, _mm256_sub_ps(_mm256_xor_ps(e[j], sign), s[j]), s[j]);
+        __m256 lengthSquared = _mm256_mul_ps(c[0], c[0]);
+        for (int j = 1; j < 4; ++j) lengthSquared = _mm256_fmadd_ps(c[j], c[j], lengthSquared);
+        // Lanes past the end divide 0 by 0, they're never stored.
+        if (precision == Precision::Exact) {
+            __m256 len = _mm256_sqrt_ps(lengthSquared);
+            for (int j = 0; j < 4; ++j) c[j] = _mm256_div_ps(c[j], len);
+        }
+        else {
+            __m256 scale = InverseSqrt(lengthSquared, precision);
+            for (int j = 0; j < 4; ++j) c[j] = _mm256_mul_ps(c[j], scale);
+        }
+        Store4(out[i].vec4.v, floats, c);
+    }
+}
+
+// out = in - origin rounded to floats, for arrays of Vector3d. 4 Vector3ds are 12 doubles,
+// three registers, and origin repeats every 3 lanes so it's three registers too.
+void RelativeTo3d(double const* in, double const* origin, float* out, size_t count) {
+    __m256d const o0 = _mm256_setr_pd(origin[0], origin[1], origin[2], origin[0]);
+    __m256d const o1 = _mm256_setr_pd(origin[1], origin[2], origin[0], origin[1]);
+    __m256d const o2 = _mm256_setr_pd(origin[2], origin[0], origin[1], origin[2]);
+    size_t const doubles = count * 3;
+    size_t i = 0;
+    for (; i + 12 <= doubles; i += 12) {
+        _mm_storeu_ps(out + i, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(in + i), o0)));
+        _mm_storeu_ps(out + i + 4, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(in + i + 4), o1)));
+        _mm_storeu_ps(out + i + 8, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(in + i + 8), o2)));
+    }
+    for (; i < doubles; i += 3) {
+        out[i] = static_cast<float>(in[i] - origin[0]);
+        out[i + 1] = static_cast<float>(in[i + 1] - origin[1]);
+        out[i + 2] = static_cast<float>(in[i + 2] - origin[2]);
+    }
+}
+
+// out = (in, 1) times m as a row vector for arrays of Vector3d, one vector per register:
+// the rows of m weighted by x, y and z.
+void Transform3d(double const* m, double const* in, double* out, size_t count) {
+    __m256d row[4];
+    for (int j = 0; j < 4; ++j) {
+        row[j] = _mm256_setr_pd(m[j * 4], m[j * 4 + 1], m[j * 4 + 2], 0.0);
+    }
+    for (size_t i = 0; i < count * 3; i += 3) {
+        __m256d p = _mm256_fmadd_pd(row[0], _mm256_broadcast_sd(in + i), row[3]);
+        p = _mm256_fmadd_pd(row[1], _mm256_broadcast_sd(in + i + 1), p);
+        p = _mm256_fmadd_pd(row[2], _mm256_broadcast_sd(in + i + 2), p);
+        _mm_storeu_pd(out + i, _mm256_castpd256_pd128(p));
+        _mm_store_sd(out + i + 2, _mm256_extractf128_pd(p, 1));
+    }
+}
+
+// Half floats to floats and back, 8 at a time. The tail goes through a buffer, there are no
+// masked 16 bit loads or stores before AVX512BW.
+void ToHalf(float const* in, uint16_t* out, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), h);
+    }
+    if (i < count) {
+        alignas(16) uint16_t t[8];
+        __m256 f = _mm256_maskload_ps(in + i, TailMask(count - i));
+        _mm_store_si128(reinterpret_cast<__m128i*>(t), _mm256_cvtps_ph(f, _MM_FROUND_TO_NEAREST_INT));
+        std::memcpy(out + i, t, (count - i) * sizeof(uint16_t));
+    }
+}
+
+void FromHalf(uint16_t const* in, float* out, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i h = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i));
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+    }
+    if (i < count) {
+        alignas(16) uint16_t t[8] = {};
+        std::memcpy(t, in + i, (count - i) * sizeof(uint16_t));
+        __m256 f = _mm256_cvtph_ps(_mm_load_si128(reinterpret_cast<__m128i const*>(t)));
+        _mm256_maskstore_ps(out + i, TailMask(count - i), f);
+    }
+}
+
+// smallest3 from xo-math-packed.h over 8 quaternions held as one register per component.
+// Returns the index of the largest magnitude component of each (the first one on a tie)
+// and the other three in kept, negated where the largest is negative.
+XO_INL __m256i SplitLargest(__m256 const q[4], __m256 kept[3]) {
+    __m256 const signBit = _mm256_set1_ps(-0.f);
+    __m256 a[4];
+    for (int k = 0; k < 4; ++k) a[k] = _mm256_andnot_ps(signBit, q[k]);
+    __m256 const top = _mm256_max_ps(_mm256_max_ps(a[0], a[1]), _mm256_max_ps(a[2], a[3]));
+    // le1 is "the index is at most 1" and so on, the index is 3 minus how many are set.
+    __m256 const is0 = _mm256_cmp_ps(a[0], top, _CMP_EQ_OQ);
+    __m256 const le1 = _mm256_or_ps(is0, _mm256_cmp_ps(a[1], top, _CMP_EQ_OQ));
+    __m256 const le2 = _mm256_or_ps(le1, _mm256_cmp_ps(a[2], top, _CMP_EQ_OQ));
+    __m256i const m = _mm256_add_epi32(_mm256_set1_epi32(3),
+                                       _mm256_add_epi32(_mm256_castps_si256(is0),
+                                                        _mm256_add_epi32(_mm256_castps_si256(le1),
+                                                                         _mm256_castps_si256(le2))));
+    __m256 const largest = _mm256_blendv_ps(_mm256_blendv_ps(_mm256_blendv_ps(q[3], q[2], le2), q[1], le1), q[0], is0);
+    __m256 const flip = _mm256_and_ps(_mm256_cmp_ps(largest, _mm256_setzero_ps(), _CMP_LT_OQ), signBit);
+    kept[0] = _mm256_xor_ps(_mm256_blendv_ps(q[0], q[1], is0), flip);
+    kept[1] = _mm256_xor_ps(_mm256_blendv_ps(q[1], q[2], le1), flip);
+    kept[2] = _mm256_xor_ps(_mm256_blendv_ps(q[2], q[3], le2), flip);
+    return m;
+}
+
+template<int Bits>
+XO_INL __m256i Quantize(__m256 c) {
+    typedef smallest3::Format<Bits> F;
+    __m256 const scaled = _mm256_mul_ps(_mm256_add_ps(c, _mm256_set1_ps(smallest3::Bound)), _mm256_set1_ps(F::Scale));
+    __m256i const v = _mm256_max_epi32(_mm256_cvtps_epi32(scaled), _mm256_setzero_si256());
+    return _mm256_min_epi32(v, _mm256_set1_epi32(static_cast<int>(F::Max)));
+}
+
+template<int Bits>
+XO_INL __m256 Dequantize(__m256i value) {
+    typedef smallest3::Format<Bits> F;
+    return _mm256_mul_ps(_mm256_sub_ps(_mm256_cvtepi32_ps(value), _mm256_set1_ps(F::Middle)), _mm256_set1_ps(F::Step));
+}
+
+// The quaternions with component m rebuilt from the kept a, b and c.
+XO_INL void JoinLargest(__m256i m, __m256 a, __m256 b, __m256 c, __m256 q[4]) {
+    __m256 d = _mm256_fnmadd_ps(a, a, _mm256_set1_ps(1.f));
+    d = _mm256_fnmadd_ps(b, b, d);
+    d = _mm256_fnmadd_ps(c, c, d);
+    d = _mm256_sqrt_ps(_mm256_max_ps(d, _mm256_setzero_ps()));
+    __m256 is[4], above[3];
+    for (int k = 0; k < 4; ++k) is[k] = _mm256_castsi256_ps(_mm256_cmpeq_epi32(m, _mm256_set1_epi32(k)));
+    for (int k = 0; k < 3; ++k) above[k] = _mm256_castsi256_ps(_mm256_cmpgt_epi32(m, _mm256_set1_epi32(k)));
+    q[0] = _mm256_blendv_ps(a, d, is[0]);
+    q[1] = _mm256_blendv_ps(_mm256_blendv_ps(a, d, is[1]), b, above[1]);
+    q[2] = _mm256_blendv_ps(_mm256_blendv_ps(b, d, is[2]), c, above[2]);
+    q[3] = _mm256_blendv_ps(c, d, is[3]);
+}
+
+// 8 values under 65536 to 16 bits each.
+XO_INL __m128i Narrow16(__m256i v) {
+    return _mm256_castsi256_si128(_mm256_permute4x64_epi64(_mm256_packus_epi32(v, v), _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+void Pack32(Quaternion const* in, uint32_t* out, size_t count) {
+    for (size_t i = 0; i < count; i += 8) {
+        size_t const n = count - i < 8 ? count - i : 8;
+        __m256 q[4], kept[3];
+        Load4(in[i].vec4.v, n * 4, q);
+        __m256i const m = SplitLargest(q, kept);
+        __m256i v = _mm256_or_si256(_mm256_slli_epi32(m, 30), _mm256_slli_epi32(Quantize<10>(kept[0]), 20));
+        v = _mm256_or_si256(v, _mm256_or_si256(_mm256_slli_epi32(Quantize<10>(kept[1]), 10), Quantize<10>(kept[2])));
+        if (n == 8) _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+        else _mm256_maskstore_epi32(reinterpret_cast<int*>(out + i), TailMask(n), v);
+    }
+}
+
+void Unpack32(uint32_t const* in, Quaternion* out, size_t count) {
+    __m256i const bits10 = _mm256_set1_epi32(0x3FF);
+    for (size_t i = 0; i < count; i += 8) {
+        size_t const n = count - i < 8 ? count - i : 8;
+        __m256i const v = n == 8 ? _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in + i))
+                                 : _mm256_maskload_epi32(reinterpret_cast<int const*>(in + i), TailMask(n));
+        __m256 q[4];
+        JoinLargest(_mm256_srli_epi32(v, 30),
+                    Dequantize<10>(_mm256_and_si256(_mm256_srli_epi32(v, 20), bits10)),
+                    Dequantize<10>(_mm256_and_si256(_mm256_srli_epi32(v, 10), bits10)),
+                    Dequantize<10>(_mm256_and_si256(v, bits10)), q);
+        Store4(out[i].vec4.v, n * 4, q);
+    }
+}
+
+// PackedQuaternion48 arrays are flat runs of words, 8 quaternions are 24 of them. They're
+// widened to 32 bits and split into one register per word with Deinterleave3.
+void Pack48(Quaternion const* in, uint16_t* out, size_t count) {
+    for (size_t i = 0; i < count; i += 8) {
+        size_t const n = count - i < 8 ? count - i : 8;
+        __m256 q[4], kept[3];
+        Load4(in[i].vec4.v, n * 4, q);
+        __m256i const m = SplitLargest(q, kept);
+        __m256i const one = _mm256_set1_epi32(1);
+        __m256 w[3] = {
+            _mm256_castsi256_ps(_mm256_or_si256(Quantize<15>(kept[0]), _mm256_slli_epi32(_mm256_and_si256(m, one), 15))),
+            _mm256_castsi256_ps(_mm256_or_si256(Quantize<15>(kept[1]), _mm256_slli_epi32(_mm256_srli_epi32(m, 1), 15))),
+            _mm256_castsi256_ps(Quantize<15>(kept[2])) };
+        alignas(16) uint16_t t[24];
+        uint16_t* dst = n == 8 ? out + i * 3 : t;
+        for (int r = 0; r < 3; ++r) {
+            __m128i const h = Narrow16(_mm256_castps_si256(Interleave3(w[0], w[1], w[2], r)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + r * 8), h);
+        }
+        if (n < 8) std::memcpy(out + i * 3, t, n * 3 * sizeof(uint16_t));
+    }
+}
+
+void Unpack48(uint16_t const* in, Quaternion* out, size_t count) {
+    __m256i const bits15 = _mm256_set1_epi32(0x7FFF);
+    for (size_t i = 0; i < count; i += 8) {
+        size_t const n = count - i < 8 ? count - i : 8;
+        alignas(16) uint16_t t[24] = {};
+        uint16_t const* src = in + i * 3;
+        if (n < 8) {
+            std::memcpy(t, src, n * 3 * sizeof(uint16_t));
+            src = t;
+        }
+        __m256 r[3];
+        for (int k = 0; k < 3; ++k) {
+            __m128i const h = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + k * 8));
+            r[k] = _mm256_castsi256_ps(_mm256_cvtepu16_epi32(h));
+        }
+        __m256i w[3];
+        for (int k = 0; k < 3; ++k) w[k] = _mm256_castps_si256(Deinterleave3(r[0], r[1], r[2], k));
+        __m256i const m = _mm256_or_si256(_mm256_srli_epi32(w[0], 15), _mm256_slli_epi32(_mm256_srli_epi32(w[1], 15), 1));
+        __m256 q[4];
+        JoinLargest(m,
+                    Dequantize<15>(_mm256_and_si256(w[0], bits15)),
+                    Dequantize<15>(_mm256_and_si256(w[1], bits15)),
+                    Dequantize<15>(_mm256_and_si256(w[2], bits15)), q);
+        Store4(out[i].vec4.v, n * 4, q);
+    }
+}
+
+// octahedral from xo-math-packed.h over 8 vectors held as x, y and z. Returns each
+// vector's quantized coordinates as qx | qy << Bits.
+template<int Bits>
+XO_INL __m256i PackNormals(__m256 x, __m256 y, __m256 z) {
+    typedef octahedral::Format<Bits> F;
+    __m256 const signBit = _mm256_set1_ps(-0.f);
+    __m256 const zero = _mm256_setzero_ps();
+    __m256 const one = _mm256_set1_ps(1.f);
+    __m256 const sum = _mm256_add_ps(_mm256_add_ps(_mm256_andnot_ps(signBit, x), _mm256_andnot_ps(signBit, y)),
+                                     _mm256_andnot_ps(signBit, z));
+    __m256 px = _mm256_div_ps(x, sum);
+    __m256 py = _mm256_div_ps(y, sum);
+    __m256 const fx = _mm256_xor_ps(_mm256_sub_ps(one, _mm256_andnot_ps(signBit, py)),
+                                    _mm256_and_ps(_mm256_cmp_ps(px, zero, _CMP_LT_OQ), signBit));
+    __m256 const fy = _mm256_xor_ps(_mm256_sub_ps(one, _mm256_andnot_ps(signBit, px)),
+                                    _mm256_and_ps(_mm256_cmp_ps(py, zero, _CMP_LT_OQ), signBit));
+    __m256 const lower = _mm256_cmp_ps(z, zero, _CMP_LT_OQ);
+    px = _mm256_blendv_ps(px, fx, lower);
+    py = _mm256_blendv_ps(py, fy, lower);
+    __m256 const scale = _mm256_set1_ps(F::Scale);
+    __m256i const max = _mm256_set1_epi32(static_cast<int>(F::Max));
+    __m256i qx = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_add_ps(px, one), scale));
+    __m256i qy = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_add_ps(py, one), scale));
+    qx = _mm256_min_epi32(_mm256_max_epi32(qx, _mm256_setzero_si256()), max);
+    qy = _mm256_min_epi32(_mm256_max_epi32(qy, _mm256_setzero_si256()), max);
+    return _mm256_or_si256(qx, _mm256_slli_epi32(qy, Bits));
+}
+
+// The unit vectors for 8 values of qx | qy << Bits, as x, y and z.
+template<int Bits>
+XO_INL void UnpackNormals(__m256i v, __m256& x, __m256& y, __m256& z) {
+    typedef octahedral::Format<Bits> F;
+    __m256 const signBit = _mm256_set1_ps(-0.f);
+    __m256 const zero = _mm256_setzero_ps();
+    __m256i const mask = _mm256_set1_epi32((1 << Bits) - 1);
+    __m256 const middle = _mm256_set1_ps(F::Middle);
+    __m256 const step = _mm256_set1_ps(F::Step);
+    __m256 px = _mm256_mul_ps(_mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_and_si256(v, mask)), middle), step);
+    __m256 py = _mm256_mul_ps(_mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(v, Bits), mask)), middle), step);
+    __m256 const pz = _mm256_sub_ps(_mm256_sub_ps(_mm256_set1_ps(1.f), _mm256_andnot_ps(signBit, px)),
+                                    _mm256_andnot_ps(signBit, py));
+    __m256 const t = _mm256_max_ps(_mm256_xor_ps(pz, signBit), zero);
+    // px + t where px < 0, px - t elsewhere.
+    px = _mm256_add_ps(px, _mm256_xor_ps(t, _mm256_andnot_ps(_mm256_cmp_ps(px, zero, _CMP_LT_OQ), signBit)));
+    py = _mm256_add_ps(py, _mm256_xor_ps(t, _mm256_andnot_ps(_mm256_cmp_ps(py, zero, _CMP_LT_OQ), signBit)));
+    __m256 const length = _mm256_sqrt_ps(_mm256_fmadd_ps(px, px, _mm256_fmadd_ps(py, py, _mm256_mul_ps(pz, pz))));
+    x = _mm256_div_ps(px, length);
+    y = _mm256_div_ps(py, length);
+    z = _mm256_div_ps(pz, length);
+}
+
+void PackNormals32(Vector3 const* in, uint32_t* out, size_t count) {
+    for (size_t i = 0; i < count; i += 8) {
+        size_t const n = count - i < 8 ? count - i : 8;
+        __m256 r0, r1, r2;
+        Load3(&in[i].x, n * 3, r0, r1, r2);
+        __m256i const v = PackNormals<16>(Deinterleave3(r0, r1, r2, 0),
+                                          Deinterleave3(r0, r1, r2, 1),
+                                          Deinterleave3(r0, r1, r2, 2));
+        if (n == 8) _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+        else _mm256_maskstore_epi32(reinterpret_cast<int*>(out + i), TailMask(n), v);
+    }
+}
+
+void UnpackNormals32(uint32_t const* in, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; i += 8) {
+        size_t const n = count - i < 8 ? count - i : 8;
+        __m256i const v = n == 8 ? _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in + i))
+                                 : _mm256_maskload_epi32(reinterpret_cast<int const*>(in + i), TailMask(n));
+        __m256 x, y, z;
+        UnpackNormals<16>(v, x, y, z);
+        Store3(&out[i].x, n * 3, Interleave3(x, y, z, 0), Interleave3(x, y, z, 1), Interleave3(x, y, z, 2));
+    }
+}
+
+void PackNormals16(Vector3 const* in, uint16_t* out, size_t count) {
+    for (size_t i = 0; i < count; i += 8) {
+        size_t const n = count - i < 8 ? count - i : 8;
+        __m256 r0, r1, r2;
+        Load3(&in[i].x, n * 3, r0, r1, r2);
+        __m128i const v = Narrow16(PackNormals<8>(Deinterleave3(r0, r1, r2, 0),
+                                                  Deinterleave3(r0, r1, r2, 1),
+                                                  Deinterleave3(r0, r1, r2, 2)));
+        if (n == 8) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), v);
+        }
+        else {
+            alignas(16) uint16_t t[8];
+            _mm_store_si128(reinterpret_cast<__m128i*>(t), v);
+            std::memcpy(out + i, t, n * sizeof(uint16_t));
+        }
+    }
+}
+
+void UnpackNormals16(uint16_t const* in, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; i += 8) {
+        size_t const n = count - i < 8 ? count - i : 8;
+        alignas(16) uint16_t t[8] = {};
+        uint16_t const* src = in + i;
+        if (n < 8) {
+            std::memcpy(t, src, n * sizeof(uint16_t));
+            src = t;
+        }
+        __m256i const v = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(src)));
+        __m256 x, y, z;
+        UnpackNormals<8>(v, x, y, z);
+        Store3(&out[i].x, n * 3, Interleave3(x, y, z, 0), Interleave3(x, y, z, 1), Interleave3(x, y, z, 2));
+    }
+}
+
+} } // ::xo::avx2
+#if defined(__clang__)
+#   pragma clang attribute pop
+#elif defined(__GNUC__)
+#   pragma GCC pop_options
+#endif
+#else
+#define XO_BATCH_AVX2 0
+#endif
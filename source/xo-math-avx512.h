@@ -0,0 +1,851 @@
+#pragma once
+#include <inttypes.h>
+#include "xo-math-macros.h"
+#include "xo-math-detect-simd.h"
+// $inline_begin
+#if !defined(XO_CONFIG_RUNTIME_DISPATCH)
+#   define XO_CONFIG_RUNTIME_DISPATCH 1
+#endif
+
+#if defined(XO_MATH_IMPL) && XO_X86 && (XO_CONFIG_RUNTIME_DISPATCH || XO_SSE_CURRENT >= XO_AVX512)
+#define XO_BATCH_AVX512 1
+#include <immintrin.h>
+// Everything in here is compiled for AVX512F regardless of the flags of the translation
+// unit. It's only called through the batch kernel table after the cpu has been checked.
+#if defined(__clang__)
+#   pragma clang attribute push (__attribute__((target("avx512f"))), apply_to = function)
+#elif defined(__GNUC__)
+#   pragma GCC push_options
+#   pragma GCC target("avx512f")
+// gcc's own avx512fintrin.h trips these for the masked loads and gathers.
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wuninitialized"
+#   pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+namespace xo { namespace avx512 {
+// 16 wide kernels over contiguous arrays, see xo-math-batch.h. Every block is loaded and
+// stored with a lane mask, so the tail of an array never needs a scalar loop and nothing
+// past the end of an array is touched.
+
+XO_INL __mmask16 TailMask(size_t count) {
+    return count >= 16 ? __mmask16(0xFFFF) : __mmask16((1u << count) - 1u);
+}
+
+XO_INL __m512i Lanes() {
+    return _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+}
+
+// Loads up to 48 floats (16 Vector3s), zeroing anything past 'floats'.
+XO_INL void Load3(float const* in, size_t floats, __m512& r0, __m512& r1, __m512& r2) {
+    r0 = _mm512_maskz_loadu_ps(TailMask(floats), in);
+    r1 = _mm512_maskz_loadu_ps(TailMask(floats > 16 ? floats - 16 : 0), in + 16);
+    r2 = _mm512_maskz_loadu_ps(TailMask(floats > 32 ? floats - 32 : 0), in + 32);
+}
+
+XO_INL void Store3(float* out, size_t floats, __m512 r0, __m512 r1, __m512 r2) {
+    _mm512_mask_storeu_ps(out, TailMask(floats), r0);
+    _mm512_mask_storeu_ps(out + 16, TailMask(floats > 16 ? floats - 16 : 0), r1);
+    _mm512_mask_storeu_ps(out + 32, TailMask(floats > 32 ? floats - 32 : 0), r2);
+}
+
+// Picks component c (0 = x, 1 = y, 2 = z) of 16 interleaved Vector3s held in r0, r1, r2.
+XO_INL __m512 Deinterleave3(__m512 r0, __m512 r1, __m512 r2, int c) {
+    __m512i k = _mm512_add_epi32(_mm512_mullo_epi32(Lanes(), _mm512_set1_epi32(3)),
+                                 _mm512_set1_epi32(c));
+    __m512 lo = _mm512_permutex2var_ps(r0, k, r1);
+    __mmask16 fromHigh = _mm512_cmpge_epi32_mask(k, _mm512_set1_epi32(32));
+    return _mm512_mask_permutexvar_ps(lo, fromHigh, _mm512_sub_epi32(k, _mm512_set1_epi32(32)), r2);
+}
+
+// Builds register r (0, 1 or 2) of the interleaved form of 16 Vector3s held as x, y, z.
+XO_INL __m512 Interleave3(__m512 x, __m512 y, __m512 z, int r) {
+    __m512i k = _mm512_add_epi32(Lanes(), _mm512_set1_epi32(16 * r));
+    // k / 3 for k < 48
+    __m512i vec = _mm512_srli_epi32(_mm512_mullo_epi32(k, _mm512_set1_epi32(0xAAAB)), 17);
+    __m512i c = _mm512_sub_epi32(k, _mm512_mullo_epi32(vec, _mm512_set1_epi32(3)));
+    __mmask16 isY = _mm512_cmpeq_epi32_mask(c, _mm512_set1_epi32(1));
+    __mmask16 isZ = _mm512_cmpeq_epi32_mask(c, _mm512_set1_epi32(2));
+    __m512 xy = _mm512_mask_permutexvar_ps(_mm512_permutexvar_ps(vec, x), isY, vec, y);
+    return _mm512_mask_permutexvar_ps(xy, isZ, vec, z);
+}
+
+// Sums each group of 4 lanes and broadcasts the sum back to the group.
+XO_INL __m512 SumQuads(__m512 m) {
+    m = _mm512_add_ps(m, _mm512_permute_ps(m, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm512_add_ps(m, _mm512_permute_ps(m, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+struct AddOp      { static XO_INL __m512 Apply(__m512 l, __m512 r) { return _mm512_add_ps(l, r); } };
+struct SubtractOp { static XO_INL __m512 Apply(__m512 l, __m512 r) { return _mm512_sub_ps(l, r); } };
+struct MultiplyOp { static XO_INL __m512 Apply(__m512 l, __m512 r) { return _mm512_mul_ps(l, r); } };
+struct DivideOp   { static XO_INL __m512 Apply(__m512 l, __m512 r) { return _mm512_div_ps(l, r); } };
+
+// An array of Vector3s or Vector4s as the floats it's made of. Casts the pointer rather than
+// taking &in->x, so an empty array may be null.
+template<typename T>
+XO_INL float const* Floats(T const* vectors) { return reinterpret_cast<float const*>(vectors); }
+template<typename T>
+XO_INL float* Floats(T* vectors) { return reinterpret_cast<float*>(vectors); }
+
+template<typename Op>
+XO_INL void Elementwise(float const* left, float const* right, float* out, size_t floats) {
+    size_t i = 0;
+    for (; i + 16 <= floats; i += 16) {
+        _mm512_storeu_ps(out + i, Op::Apply(_mm512_loadu_ps(left + i), _mm512_loadu_ps(right + i)));
+    }
+    if (i < floats) {
+        __mmask16 m = TailMask(floats - i);
+        // masked off lanes are zero in both inputs, DivideOp's 0/0 there is never stored.
+        __m512 l = _mm512_maskz_loadu_ps(m, left + i);
+        __m512 r = _mm512_maskz_loadu_ps(m, right + i);
+        _mm512_mask_storeu_ps(out + i, m, Op::Apply(l, r));
+    }
+}
+
+XO_INL void LerpFloats(float const* left, float const* right, float t, float* out, size_t floats) {
+    __m512 tt = _mm512_set1_ps(t);
+    for (size_t i = 0; i < floats; i += 16) {
+        __mmask16 m = TailMask(floats - i);
+        __m512 l = _mm512_maskz_loadu_ps(m, left + i);
+        __m512 r = _mm512_maskz_loadu_ps(m, right + i);
+        _mm512_mask_storeu_ps(out + i, m, _mm512_fmadd_ps(tt, _mm512_sub_ps(r, l), l));
+    }
+}
+
+void Add3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Elementwise<AddOp>(Floats(left), Floats(right), Floats(out), count * 3);
+}
+
+void Subtract3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Elementwise<SubtractOp>(Floats(left), Floats(right), Floats(out), count * 3);
+}
+
+void Multiply3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Elementwise<MultiplyOp>(Floats(left), Floats(right), Floats(out), count * 3);
+}
+
+void Divide3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Elementwise<DivideOp>(Floats(left), Floats(right), Floats(out), count * 3);
+}
+
+void DotProduct3(Vector3 const* left, Vector3 const* right, float* out, size_t count) {
+    float const* l = Floats(left);
+    float const* r = Floats(right);
+    for (size_t i = 0; i < count; i += 16) {
+        size_t floats = (count - i) * 3;
+        __m512 l0, l1, l2, r0, r1, r2;
+        Load3(l + i * 3, floats, l0, l1, l2);
+        Load3(r + i * 3, floats, r0, r1, r2);
+        __m512 d = _mm512_mul_ps(Deinterleave3(l0, l1, l2, 0), Deinterleave3(r0, r1, r2, 0));
+        d = _mm512_fmadd_ps(Deinterleave3(l0, l1, l2, 1), Deinterleave3(r0, r1, r2, 1), d);
+        d = _mm512_fmadd_ps(Deinterleave3(l0, l1, l2, 2), Deinterleave3(r0, r1, r2, 2), d);
+        _mm512_mask_storeu_ps(out + i, TailMask(count - i), d);
+    }
+}
+
+void CrossProduct3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    float const* l = Floats(left);
+    float const* r = Floats(right);
+    for (size_t i = 0; i < count; i += 16) {
+        size_t floats = (count - i) * 3;
+        __m512 l0, l1, l2, r0, r1, r2;
+        Load3(l + i * 3, floats, l0, l1, l2);
+        Load3(r + i * 3, floats, r0, r1, r2);
+        __m512 lx = Deinterleave3(l0, l1, l2, 0);
+        __m512 ly = Deinterleave3(l0, l1, l2, 1);
+        __m512 lz = Deinterleave3(l0, l1, l2, 2);
+        __m512 rx = Deinterleave3(r0, r1, r2, 0);
+        __m512 ry = Deinterleave3(r0, r1, r2, 1);
+        __m512 rz = Deinterleave3(r0, r1, r2, 2);
+        __m512 x = _mm512_fmsub_ps(ly, rz, _mm512_mul_ps(lz, ry));
+        __m512 y = _mm512_fmsub_ps(lz, rx, _mm512_mul_ps(lx, rz));
+        __m512 z = _mm512_fmsub_ps(lx, ry, _mm512_mul_ps(ly, rx));
+        Store3(Floats(out) + i * 3, floats,
+               Interleave3(x, y, z, 0), Interleave3(x, y, z, 1), Interleave3(x, y, z, 2));
+    }
+}
+
+// 1/sqrt(m) for Precision::Fast and Fastest: rsqrt14 is good to 2^-14 on its own, Fast
+// adds one Newton-Raphson step r * (1.5 - 0.5 * m * r * r).
+XO_INL __m512 InverseSqrt(__m512 m, Precision precision) {
+    __m512 r = _mm512_rsqrt14_ps(m);
+    if (precision == Precision::Fastest) {
+        return r;
+    }
+    __m512 halfMR = _mm512_mul_ps(_mm512_mul_ps(_mm512_set1_ps(0.5f), m), r);
+    return _mm512_mul_ps(r, _mm512_fnmadd_ps(halfMR, r, _mm512_set1_ps(1.5f)));
+}
+
+void Normalize3(Vector3 const* in, Vector3* out, size_t count, Precision precision) {
+    for (size_t i = 0; i < count; i += 16) {
+        size_t floats = (count - i) * 3;
+        __m512 r0, r1, r2;
+        Load3(Floats(in) + i * 3, floats, r0, r1, r2);
+        __m512 x = Deinterleave3(r0, r1, r2, 0);
+        __m512 y = Deinterleave3(r0, r1, r2, 1);
+        __m512 z = Deinterleave3(r0, r1, r2, 2);
+        __m512 lengthSquared = _mm512_fmadd_ps(z, z, _mm512_fmadd_ps(y, y, _mm512_mul_ps(x, x)));
+        if (precision == Precision::Exact) {
+            __m512 len = _mm512_sqrt_ps(lengthSquared);
+            x = _mm512_div_ps(x, len);
+            y = _mm512_div_ps(y, len);
+            z = _mm512_div_ps(z, len);
+        }
+        else {
+            __m512 scale = InverseSqrt(lengthSquared, precision);
+            x = _mm512_mul_ps(x, scale);
+            y = _mm512_mul_ps(y, scale);
+            z = _mm512_mul_ps(z, scale);
+        }
+        Store3(Floats(out) + i * 3, floats,
+               Interleave3(x, y, z, 0), Interleave3(x, y, z, 1), Interleave3(x, y, z, 2));
+    }
+}
+
+void Lerp3(Vector3 const* left, Vector3 const* right, float t, Vector3* out, size_t count) {
+    LerpFloats(Floats(left), Floats(right), t, Floats(out), count * 3);
+}
+
+void Add4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Elementwise<AddOp>(Floats(left), Floats(right), Floats(out), count * 4);
+}
+
+void Subtract4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Elementwise<SubtractOp>(Floats(left), Floats(right), Floats(out), count * 4);
+}
+
+void Multiply4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Elementwise<MultiplyOp>(Floats(left), Floats(right), Floats(out), count * 4);
+}
+
+void Divide4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Elementwise<DivideOp>(Floats(left), Floats(right), Floats(out), count * 4);
+}
+
+void DotProduct4(Vector4 const* left, Vector4 const* right, float* out, size_t count) {
+    // Lane 4q+m of the blended sums holds the dot product of vector 4m+q in the block.
+    __m512i quad = _mm512_and_epi32(Lanes(), _mm512_set1_epi32(3));
+    __m512i order = _mm512_or_epi32(_mm512_slli_epi32(quad, 2), _mm512_srli_epi32(Lanes(), 2));
+    for (size_t i = 0; i < count; i += 16) {
+        size_t floats = (count - i) * 4;
+        __m512 s[4];
+        for (int m = 0; m < 4; ++m) {
+            __mmask16 mask = TailMask(floats > size_t(m) * 16 ? floats - m * 16 : 0);
+            __m512 l = _mm512_maskz_loadu_ps(mask, left[i].v + m * 16);
+            __m512 r = _mm512_maskz_loadu_ps(mask, right[i].v + m * 16);
+            s[m] = SumQuads(_mm512_mul_ps(l, r));
+        }
+        __m512 d = _mm512_mask_blend_ps(0x2222, s[0], s[1]);
+        d = _mm512_mask_blend_ps(0x4444, d, s[2]);
+        d = _mm512_mask_blend_ps(0x8888, d, s[3]);
+        _mm512_mask_storeu_ps(out + i, TailMask(count - i), _mm512_permutexvar_ps(order, d));
+    }
+}
+
+void Normalize4(Vector4 const* in, Vector4* out, size_t count, Precision precision) {
+    size_t floats = count * 4;
+    for (size_t i = 0; i < floats; i += 16) {
+        __mmask16 m = TailMask(floats - i);
+        __m512 v = _mm512_maskz_loadu_ps(m, Floats(in) + i);
+        __m512 lengthSquared = SumQuads(_mm512_mul_ps(v, v));
+        if (precision == Precision::Exact) {
+            v = _mm512_div_ps(v, _mm512_sqrt_ps(lengthSquared));
+        }
+        else {
+            v = _mm512_mul_ps(v, InverseSqrt(lengthSquared, precision));
+        }
+        _mm512_mask_storeu_ps(Floats(out) + i, m, v);
+    }
+}
+
+void Lerp4(Vector4 const* left, Vector4 const* right, float t, Vector4* out, size_t count) {
+    LerpFloats(Floats(left), Floats(right), t, Floats(out), count * 4);
+}
+
+// Splits 16 Quaternions (or Vector4s) held four to a register in a0..a3 into one register
+// per component, in array order.
+XO_INL void Deinterleave4(__m512 a0, __m512 a1, __m512 a2, __m512 a3, __m512 c[4]) {
+    // A 4x4 transpose in each 128 bit lane leaves lane 4q+m holding element 4m+q.
+    __m512i quad = _mm512_and_epi32(Lanes(), _mm512_set1_epi32(3));
+    __m512i order = _mm512_or_epi32(_mm512_slli_epi32(quad, 2), _mm512_srli_epi32(Lanes(), 2));
+    __m512 t0 = _mm512_unpacklo_ps(a0, a1);
+    __m512 t1 = _mm512_unpackhi_ps(a0, a1);
+    __m512 t2 = _mm512_unpacklo_ps(a2, a3);
+    __m512 t3 = _mm512_unpackhi_ps(a2, a3);
+    c[0] = _mm512_permutexvar_ps(order, _mm512_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)));
+    c[1] = _mm512_permutexvar_ps(order, _mm512_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)));
+    c[2] = _mm512_permutexvar_ps(order, _mm512_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)));
+    c[3] = _mm512_permutexvar_ps(order, _mm512_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2)));
+}
+
+// Loads up to 64 floats (16 Quaternions or Vector4s) split into one register per
+// component, zeroing anything past 'floats'.
+XO_INL void Load4(float const* in, size_t floats, __m512 c[4]) {
+    __m512 a[4];
+    for (int m = 0; m < 4; ++m) {
+        a[m] = _mm512_maskz_loadu_ps(TailMask(floats > size_t(m) * 16 ? floats - m * 16 : 0), in + m * 16);
+    }
+    Deinterleave4(a[0], a[1], a[2], a[3], c);
+}
+
+// Undoes Deinterleave4 and stores the first 'floats' floats. The reordering there swaps
+// lanes 4q+m and 4m+q, so it undoes itself.
+XO_INL void Store4(float* out, size_t floats, __m512 const c[4]) {
+    __m512i quad = _mm512_and_epi32(Lanes(), _mm512_set1_epi32(3));
+    __m512i order = _mm512_or_epi32(_mm512_slli_epi32(quad, 2), _mm512_srli_epi32(Lanes(), 2));
+    __m512 p[4];
+    for (int m = 0; m < 4; ++m) p[m] = _mm512_permutexvar_ps(order, c[m]);
+    __m512 t0 = _mm512_unpacklo_ps(p[0], p[1]);
+    __m512 t1 = _mm512_unpackhi_ps(p[0], p[1]);
+    __m512 t2 = _mm512_unpacklo_ps(p[2], p[3]);
+    __m512 t3 = _mm512_unpackhi_ps(p[2], p[3]);
+    __m512 a[4] = {
+        _mm512_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)),
+        _mm512_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)),
+        _mm512_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)),
+        _mm512_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2)) };
+    for (int m = 0; m < 4; ++m) {
+        _mm512_mask_storeu_ps(out + m * 16, TailMask(floats > size_t(m) * 16 ? floats - m * 16 : 0), a[m]);
+    }
+}
+
+// v + 2r(q x v) + q x 2(q x v), see Quaternion::Rotate.
+void Rotate3(Quaternion const* rotations, Vector3 const* in, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; i += 16) {
+        __m512 q[4];
+        Load4(rotations[i].vec4.v, (count - i) * 4, q);
+        __m512 r0, r1, r2;
+        Load3(Floats(in) + i * 3, (count - i) * 3, r0, r1, r2);
+        __m512 x = Deinterleave3(r0, r1, r2, 0);
+        __m512 y = Deinterleave3(r0, r1, r2, 1);
+        __m512 z = Deinterleave3(r0, r1, r2, 2);
+        __m512 two = _mm512_set1_ps(2.f);
+        __m512 tx = _mm512_mul_ps(two, _mm512_fmsub_ps(q[1], z, _mm512_mul_ps(q[2], y)));
+        __m512 ty = _mm512_mul_ps(two, _mm512_fmsub_ps(q[2], x, _mm512_mul_ps(q[0], z)));
+        __m512 tz = _mm512_mul_ps(two, _mm512_fmsub_ps(q[0], y, _mm512_mul_ps(q[1], x)));
+        x = _mm512_add_ps(_mm512_fmadd_ps(q[3], tx, x), _mm512_fmsub_ps(q[1], tz, _mm512_mul_ps(q[2], ty)));
+        y = _mm512_add_ps(_mm512_fmadd_ps(q[3], ty, y), _mm512_fmsub_ps(q[2], tx, _mm512_mul_ps(q[0], tz)));
+        z = _mm512_add_ps(_mm512_fmadd_ps(q[3], tz, z), _mm512_fmsub_ps(q[0], ty, _mm512_mul_ps(q[1], tx)));
+        Store3(Floats(out) + i * 3, (count - i) * 3,
+               Interleave3(x, y, z, 0), Interleave3(x, y, z, 1), Interleave3(x, y, z, 2));
+    }
+}
+
+XO_INL float const* At(float const* base, size_t index, size_t stride) {
+    return reinterpret_cast<float const*>(reinterpret_cast<char const*>(base) + index * stride);
+}
+
+XO_INL float* At(float* base, size_t index, size_t stride) {
+    return reinterpret_cast<float*>(reinterpret_cast<char*>(base) + index * stride);
+}
+
+// out = (in.xyz, w) times m as a row vector, 16 vectors at a time. Strides are in bytes, tightly
+// packed arrays are deinterleaved in registers, anything else is gathered and scattered.
+void Transform3(float const* m,
+                float const* in, size_t inStride,
+                float* out, size_t outStride,
+                size_t count, float w) {
+    __m512 r[3][4];
+    for (int i = 0; i < 3; ++i) {
+        r[i][0] = _mm512_set1_ps(m[i]);
+        r[i][1] = _mm512_set1_ps(m[4 + i]);
+        r[i][2] = _mm512_set1_ps(m[8 + i]);
+        r[i][3] = _mm512_set1_ps(m[12 + i] * w);
+    }
+    bool const packedIn = inStride == 3 * sizeof(float);
+    bool const packedOut = outStride == 3 * sizeof(float);
+    __m512i const inOffsets = _mm512_mullo_epi32(Lanes(), _mm512_set1_epi32(static_cast<int>(inStride)));
+    __m512i const outOffsets = _mm512_mullo_epi32(Lanes(), _mm512_set1_epi32(static_cast<int>(outStride)));
+    for (size_t i = 0; i < count; i += 16) {
+        size_t const n = count - i < 16 ? count - i : 16;
+        __mmask16 const mask = TailMask(n);
+        float const* src = At(in, i, inStride);
+        __m512 x, y, z;
+        if (packedIn) {
+            __m512 r0, r1, r2;
+            Load3(src, n * 3, r0, r1, r2);
+            x = Deinterleave3(r0, r1, r2, 0);
+            y = Deinterleave3(r0, r1, r2, 1);
+            z = Deinterleave3(r0, r1, r2, 2);
+        }
+        else {
+            __m512 const zero = _mm512_setzero_ps();
+            x = _mm512_mask_i32gather_ps(zero, mask, inOffsets, src, 1);
+            y = _mm512_mask_i32gather_ps(zero, mask, inOffsets, src + 1, 1);
+            z = _mm512_mask_i32gather_ps(zero, mask, inOffsets, src + 2, 1);
+        }
+        __m512 o[3];
+        for (int j = 0; j < 3; ++j) {
+            o[j] = _mm512_fmadd_ps(r[j][0], x, _mm512_fmadd_ps(r[j][1], y, _mm512_fmadd_ps(r[j][2], z, r[j][3])));
+        }
+        float* dst = At(out, i, outStride);
+        if (packedOut) {
+            Store3(dst, n * 3,
+                   Interleave3(o[0], o[1], o[2], 0),
+                   Interleave3(o[0], o[1], o[2], 1),
+                   Interleave3(o[0], o[1], o[2], 2));
+        }
+        else {
+            _mm512_mask_i32scatter_ps(dst, mask, outOffsets, o[0], 1);
+            _mm512_mask_i32scatter_ps(dst + 1, mask, outOffsets, o[1], 1);
+            _mm512_mask_i32scatter_ps(dst + 2, mask, outOffsets, o[2], 1);
+        }
+    }
+}
+
+// out = in * m for Vector4s, four per register. Lane 4v+c reads component c of vector v.
+void Transform4(float const* m,
+                float const* in, size_t inStride,
+                float* out, size_t outStride,
+                size_t count) {
+    __m512 row[4];
+    for (int j = 0; j < 4; ++j) {
+        row[j] = _mm512_broadcast_f32x4(_mm_loadu_ps(m + 4 * j));
+    }
+    __m512i const vec = _mm512_srli_epi32(Lanes(), 2);
+    __m512i const component = _mm512_slli_epi32(_mm512_and_epi32(Lanes(), _mm512_set1_epi32(3)), 2);
+    __m512i const inOffsets = _mm512_add_epi32(_mm512_mullo_epi32(vec, _mm512_set1_epi32(static_cast<int>(inStride))), component);
+    __m512i const outOffsets = _mm512_add_epi32(_mm512_mullo_epi32(vec, _mm512_set1_epi32(static_cast<int>(outStride))), component);
+    bool const packedIn = inStride == 4 * sizeof(float);
+    bool const packedOut = outStride == 4 * sizeof(float);
+    for (size_t i = 0; i < count; i += 4) {
+        __mmask16 const mask = TailMask((count - i < 4 ? count - i : 4) * 4);
+        float const* src = At(in, i, inStride);
+        __m512 v = packedIn ? _mm512_maskz_loadu_ps(mask, src)
+                            : _mm512_mask_i32gather_ps(_mm512_setzero_ps(), mask, inOffsets, src, 1);
+        __m512 lo = _mm512_mul_ps(_mm512_permute_ps(v, 0x00), row[0]);
+        __m512 hi = _mm512_mul_ps(_mm512_permute_ps(v, 0x55), row[1]);
+        lo = _mm512_fmadd_ps(_mm512_permute_ps(v, 0xAA), row[2], lo);
+        hi = _mm512_fmadd_ps(_mm512_permute_ps(v, 0xFF), row[3], hi);
+        float* dst = At(out, i, outStride);
+        if (packedOut) {
+            _mm512_mask_storeu_ps(dst, mask, _mm512_add_ps(lo, hi));
+        }
+        else {
+            _mm512_mask_i32scatter_ps(dst, mask, outOffsets, _mm512_add_ps(lo, hi), 1);
+        }
+    }
+}
+
+// out = left * right for row major 4x4 matrices, a whole matrix per register. Lane 4r+c of
+// the product is sum over k of left[r][k] * right[k][c]: element k of each row of left is
+// broadcast across its row and multiplied by row k of right repeated in every row.
+XO_INL __m512 Multiply4x4(__m512 l, float const* right) {
+    __m512 r[4];
+    for (int k = 0; k < 4; ++k) {
+        r[k] = _mm512_broadcast_f32x4(_mm_loadu_ps(right + 4 * k));
+    }
+    __m512 a = _mm512_fmadd_ps(_mm512_permute_ps(l, 0x55), r[1], _mm512_mul_ps(_mm512_permute_ps(l, 0x00), r[0]));
+    __m512 b = _mm512_fmadd_ps(_mm512_permute_ps(l, 0xFF), r[3], _mm512_mul_ps(_mm512_permute_ps(l, 0xAA), r[2]));
+    return _mm512_add_ps(a, b);
+}
+
+// Two matrices per iteration. Both inputs are read before out is written, so out may be
+// left or right.
+void Multiply4x4(float const* left, float const* right, float* out, size_t count) {
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m512 a = Multiply4x4(_mm512_loadu_ps(left + i * 16), right + i * 16);
+        __m512 b = Multiply4x4(_mm512_loadu_ps(left + i * 16 + 16), right + i * 16 + 16);
+        _mm512_storeu_ps(out + i * 16, a);
+        _mm512_storeu_ps(out + i * 16 + 16, b);
+    }
+    if (i < count) {
+        _mm512_storeu_ps(out + i * 16, Multiply4x4(_mm512_loadu_ps(left + i * 16), right + i * 16));
+    }
+}
+
+// and_ps and xor_ps on zmm need AVX512DQ, these stay within AVX512F.
+XO_INL __m512 And(__m512 a, __m512 b) {
+    return _mm512_castsi512_ps(_mm512_and_epi32(_mm512_castps_si512(a), _mm512_castps_si512(b)));
+}
+
+XO_INL __m512 Xor(__m512 a, __m512 b) {
+    return _mm512_castsi512_ps(_mm512_xor_epi32(_mm512_castps_si512(a), _mm512_castps_si512(b)));
+}
+
+// slerp::Weight from xo-math-utilities.h.
+XO_INL __m512 SlerpWeight(__m512 cosine, __m512 t) {
+    __m512 const one = _mm512_set1_ps(1.f);
+    __m512 const xm1 = _mm512_sub_ps(cosine, one);
+    __m512 const tt = _mm512_mul_ps(t, t);
+    __m512 r = one;
+    for (int i = slerp::Terms - 1; i >= 0; --i) {
+        __m512 b = _mm512_mul_ps(_mm512_fmsub_ps(_mm512_set1_ps(slerp::U[i]), tt, _mm512_set1_ps(slerp::V[i])), xm1);
+        r = _mm512_fmadd_ps(b, r, one);
+    }
+    return _mm512_mul_ps(t, r);
+}
+
+// Dot products of 4 component vectors split into one register per component.
+XO_INL __m512 Dot4(__m512 const l[4], __m512 const r[4]) {
+    __m512 d = _mm512_mul_ps(l[0], r[0]);
+    d = _mm512_fmadd_ps(l[1], r[1], d);
+    d = _mm512_fmadd_ps(l[2], r[2], d);
+    return _mm512_fmadd_ps(l[3], r[3], d);
+}
+
+void Slerp(Quaternion const* start, Quaternion const* end, float const* t, Quaternion* out, size_t count) {
+    for (size_t i = 0; i < count; i += 16) {
+        size_t floats = (count - i) * 4;
+        __m512 s[4], e[4];
+        Load4(start[i].vec4.v, floats, s);
+        Load4(end[i].vec4.v, floats, e);
+        // Flipping end when start . end < 0 takes the shorter arc, like Quaternion::Slerp.
+        __m512 d = Dot4(s, e);
+        __m512 sign = And(d, _mm512_set1_ps(-0.f));
+        __m512 cosine = Xor(d, sign);
+        __m512 te = _mm512_maskz_loadu_ps(TailMask(count - i), t + i);
+        __m512 ts = _mm512_sub_ps(_mm512_set1_ps(1.f), te);
+        __m512 ws = SlerpWeight(cosine, ts);
+        __m512 we = Xor(SlerpWeight(cosine, te), sign);
+        __m512 c[4];
+        for (int j = 0; j < 4; ++j) c[j] = _mm512_fmadd_ps(s[j], ws, _mm512_mul_ps(e[j], we));
+        Store4(out[i].vec4.v, floats, c);
+    }
+}
+
+void Nlerp(Quaternion const* start, Quaternion const* end, float const* t, Quaternion* out, size_t count, Precision precision) {
+    for (size_t i = 0; i < count; i += 16) {
+        size_t floats = (count - i) * 4;
+        __m512 s[4], e[4];
+        Load4(start[i].vec4.v, floats, s);
+        Load4(end[i].vec4.v, floats, e);
+        __m512 sign = And(Dot4(s, e), _mm512_set1_ps(-0.f));
+        __m512 te = _mm512_maskz_loadu_ps(TailMask(count - i), t + i);
+        __m512 c[4];
+        for (int j = 0; j < 4; ++j) c[j] = _mm512_fmadd_ps(te, _mm512_sub_ps(Xor(e[j], sign), s[j]), s[j]);
+        __m512 lengthSquared = _mm512_mul_ps(c[0], c[0]);
+        for (int j = 1; j < 4; ++j) lengthSquared = _mm512_fmadd_ps(c[j], c[j], lengthSquared);
+        // Lanes past the end divide 0 by 0, they're never stored.
+        if (precision == Precision::Exact) {
+            __m512 len = _mm512_sqrt_ps(lengthSquared);
+            for (int j = 0; j < 4; ++j) c[j] = _mm512_div_ps(c[j], len);
+        }
+        else {
+            __m512 scale = InverseSqrt(lengthSquared, precision);
+            for (int j = 0; j < 4; ++j) c[j] = _mm512_mul_ps(c[j], scale);
+        }
+        Store4(out[i].vec4.v, floats, c);
+    }
+}
+
+// out = in - origin rounded to floats, for arrays of Vector3d: 8 Vector3ds are three
+// registers of doubles, and origin repeated every 3 lanes another three.
+void RelativeTo3d(double const* in, double const* origin, float* out, size_t count) {
+    double repeated[24];
+    for (int k = 0; k < 24; ++k) repeated[k] = origin[k % 3];
+    __m512d o[3];
+    for (int r = 0; r < 3; ++r) o[r] = _mm512_loadu_pd(repeated + r * 8);
+    size_t const doubles = count * 3;
+    for (size_t i = 0; i < doubles; i += 24) {
+        for (int r = 0; r < 3; ++r) {
+            size_t const k = i + r * 8;
+            size_t const n = k < doubles ? (doubles - k < 8 ? doubles - k : 8) : 0;
+            __mmask16 const mask = TailMask(n);
+            __m512d d = _mm512_sub_pd(_mm512_maskz_loadu_pd(static_cast<__mmask8>(mask), in + k), o[r]);
+            // The 8 floats go through a zmm store, 8 wide masked stores need AVX512VL.
+            _mm512_mask_storeu_ps(out + k, mask, _mm512_castps256_ps512(_mm512_cvtpd_ps(d)));
+        }
+    }
+}
+
+// out = (in, 1) times m as a row vector for arrays of Vector3d, two vectors per register:
+// each half holds the rows of m and is weighted by the x, y and z of one vector.
+void Transform3d(double const* m, double const* in, double* out, size_t count) {
+    __m512d row[4];
+    for (int j = 0; j < 4; ++j) {
+        double const* r = m + j * 4;
+        row[j] = _mm512_setr_pd(r[0], r[1], r[2], 0.0, r[0], r[1], r[2], 0.0);
+    }
+    __m512i const x = _mm512_setr_epi64(0, 0, 0, 0, 3, 3, 3, 3);
+    __m512i const y = _mm512_setr_epi64(1, 1, 1, 1, 4, 4, 4, 4);
+    __m512i const z = _mm512_setr_epi64(2, 2, 2, 2, 5, 5, 5, 5);
+    __m512i const pack = _mm512_setr_epi64(0, 1, 2, 4, 5, 6, 3, 7);
+    for (size_t i = 0; i < count; i += 2) {
+        __mmask8 const mask = count - i >= 2 ? 0x3F : 0x07;
+        __m512d v = _mm512_maskz_loadu_pd(mask, in + i * 3);
+        __m512d p = _mm512_fmadd_pd(row[0], _mm512_permutexvar_pd(x, v), row[3]);
+        p = _mm512_fmadd_pd(row[1], _mm512_permutexvar_pd(y, v), p);
+        p = _mm512_fmadd_pd(row[2], _mm512_permutexvar_pd(z, v), p);
+        _mm512_mask_storeu_pd(out + i * 3, mask, _mm512_permutexvar_pd(pack, p));
+    }
+}
+
+// Half floats to floats and back, 16 at a time. The tail goes through a buffer, masked 16
+// bit loads and stores need AVX512BW.
+void ToHalf(float const* in, uint16_t* out, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i h = _mm512_cvtps_ph(_mm512_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), h);
+    }
+    if (i < count) {
+        alignas(32) uint16_t t[16];
+        __m512 f = _mm512_maskz_loadu_ps(TailMask(count - i), in + i);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(t), _mm512_cvtps_ph(f, _MM_FROUND_TO_NEAREST_INT));
+        std::memcpy(out + i, t, (count - i) * sizeof(uint16_t));
+    }
+}
+
+void FromHalf(uint16_t const* in, float* out, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i h = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in + i));
+        _mm512_storeu_ps(out + i, _mm512_cvtph_ps(h));
+    }
+    if (i < count) {
+        alignas(32) uint16_t t[16] = {};
+        std::memcpy(t, in + i, (count - i) * sizeof(uint16_t));
+        __m512 f = _mm512_cvtph_ps(_mm256_load_si256(reinterpret_cast<__m256i const*>(t)));
+        _mm512_mask_storeu_ps(out + i, TailMask(count - i), f);
+    }
+}
+
+// smallest3 from xo-math-packed.h over 16 quaternions held as one register per component.
+// Returns the index of the largest magnitude component of each (the first one on a tie)
+// and the other three in kept, negated where the largest is negative.
+XO_INL __m512i SplitLargest(__m512 const q[4], __m512 kept[3]) {
+    __m512 a[4];
+    for (int k = 0; k < 4; ++k) a[k] = _mm512_abs_ps(q[k]);
+    __m512 const top = _mm512_max_ps(_mm512_max_ps(a[0], a[1]), _mm512_max_ps(a[2], a[3]));
+    // le1 is "the index is at most 1" and so on.
+    __mmask16 const is0 = _mm512_cmp_ps_mask(a[0], top, _CMP_EQ_OQ);
+    __mmask16 const le1 = is0 | _mm512_cmp_ps_mask(a[1], top, _CMP_EQ_OQ);
+    __mmask16 const le2 = le1 | _mm512_cmp_ps_mask(a[2], top, _CMP_EQ_OQ);
+    __m512i m = _mm512_mask_mov_epi32(_mm512_set1_epi32(3), le2, _mm512_set1_epi32(2));
+    m = _mm512_mask_mov_epi32(m, le1, _mm512_set1_epi32(1));
+    m = _mm512_mask_mov_epi32(m, is0, _mm512_setzero_si512());
+    __m512 largest = _mm512_mask_mov_ps(q[3], le2, q[2]);
+    largest = _mm512_mask_mov_ps(largest, le1, q[1]);
+    largest = _mm512_mask_mov_ps(largest, is0, q[0]);
+    __mmask16 const negative = _mm512_cmp_ps_mask(largest, _mm512_setzero_ps(), _CMP_LT_OQ);
+    __m512 const flip = _mm512_maskz_mov_ps(negative, _mm512_set1_ps(-0.f));
+    kept[0] = Xor(_mm512_mask_blend_ps(is0, q[0], q[1]), flip);
+    kept[1] = Xor(_mm512_mask_blend_ps(le1, q[1], q[2]), flip);
+    kept[2] = Xor(_mm512_mask_blend_ps(le2, q[2], q[3]), flip);
+    return m;
+}
+
+template<int Bits>
+XO_INL __m512i Quantize(__m512 c) {
+    typedef smallest3::Format<Bits> F;
+    __m512 const scaled = _mm512_mul_ps(_mm512_add_ps(c, _mm512_set1_ps(smallest3::Bound)), _mm512_set1_ps(F::Scale));
+    __m512i const v = _mm512_max_epi32(_mm512_cvtps_epi32(scaled), _mm512_setzero_si512());
+    return _mm512_min_epi32(v, _mm512_set1_epi32(static_cast<int>(F::Max)));
+}
+
+template<int Bits>
+XO_INL __m512 Dequantize(__m512i value) {
+    typedef smallest3::Format<Bits> F;
+    return _mm512_mul_ps(_mm512_sub_ps(_mm512_cvtepi32_ps(value), _mm512_set1_ps(F::Middle)), _mm512_set1_ps(F::Step));
+}
+
+// The quaternions with component m rebuilt from the kept a, b and c.
+XO_INL void JoinLargest(__m512i m, __m512 a, __m512 b, __m512 c, __m512 q[4]) {
+    __m512 d = _mm512_fnmadd_ps(a, a, _mm512_set1_ps(1.f));
+    d = _mm512_fnmadd_ps(b, b, d);
+    d = _mm512_fnmadd_ps(c, c, d);
+    d = _mm512_sqrt_ps(_mm512_max_ps(d, _mm512_setzero_ps()));
+    __mmask16 is[4], above[3];
+    for (int k = 0; k < 4; ++k) is[k] = _mm512_cmpeq_epi32_mask(m, _mm512_set1_epi32(k));
+    for (int k = 0; k < 3; ++k) above[k] = _mm512_cmpgt_epi32_mask(m, _mm512_set1_epi32(k));
+    q[0] = _mm512_mask_blend_ps(is[0], a, d);
+    q[1] = _mm512_mask_blend_ps(above[1], _mm512_mask_blend_ps(is[1], a, d), b);
+    q[2] = _mm512_mask_blend_ps(above[2], _mm512_mask_blend_ps(is[2], b, d), c);
+    q[3] = _mm512_mask_blend_ps(is[3], c, d);
+}
+
+void Pack32(Quaternion const* in, uint32_t* out, size_t count) {
+    for (size_t i = 0; i < count; i += 16) {
+        size_t const n = count - i < 16 ? count - i : 16;
+        __m512 q[4], kept[3];
+        Load4(in[i].vec4.v, n * 4, q);
+        __m512i const m = SplitLargest(q, kept);
+        __m512i v = _mm512_or_si512(_mm512_slli_epi32(m, 30), _mm512_slli_epi32(Quantize<10>(kept[0]), 20));
+        v = _mm512_or_si512(v, _mm512_or_si512(_mm512_slli_epi32(Quantize<10>(kept[1]), 10), Quantize<10>(kept[2])));
+        _mm512_mask_storeu_epi32(out + i, TailMask(n), v);
+    }
+}
+
+void Unpack32(uint32_t const* in, Quaternion* out, size_t count) {
+    __m512i const bits10 = _mm512_set1_epi32(0x3FF);
+    for (size_t i = 0; i < count; i += 16) {
+        size_t const n = count - i < 16 ? count - i : 16;
+        __m512i const v = _mm512_maskz_loadu_epi32(TailMask(n), in + i);
+        __m512 q[4];
+        JoinLargest(_mm512_srli_epi32(v, 30),
+                    Dequantize<10>(_mm512_and_epi32(_mm512_srli_epi32(v, 20), bits10)),
+                    Dequantize<10>(_mm512_and_epi32(_mm512_srli_epi32(v, 10), bits10)),
+                    Dequantize<10>(_mm512_and_epi32(v, bits10)), q);
+        Store4(out[i].vec4.v, n * 4, q);
+    }
+}
+
+// PackedQuaternion48 arrays are flat runs of words, 16 quaternions are 48 of them. They're
+// widened to 32 bits and split into one register per word with Deinterleave3. The tails go
+// through a buffer, masked 16 bit loads and stores need AVX512BW.
+void Pack48(Quaternion const* in, uint16_t* out, size_t count) {
+    for (size_t i = 0; i < count; i += 16) {
+        size_t const n = count - i < 16 ? count - i : 16;
+        __m512 q[4], kept[3];
+        Load4(in[i].vec4.v, n * 4, q);
+        __m512i const m = SplitLargest(q, kept);
+        __m512i const one = _mm512_set1_epi32(1);
+        __m512 w[3] = {
+            _mm512_castsi512_ps(_mm512_or_si512(Quantize<15>(kept[0]), _mm512_slli_epi32(_mm512_and_epi32(m, one), 15))),
+            _mm512_castsi512_ps(_mm512_or_si512(Quantize<15>(kept[1]), _mm512_slli_epi32(_mm512_srli_epi32(m, 1), 15))),
+            _mm512_castsi512_ps(Quantize<15>(kept[2])) };
+        alignas(32) uint16_t t[48];
+        uint16_t* dst = n == 16 ? out + i * 3 : t;
+        for (int r = 0; r < 3; ++r) {
+            __m256i const h = _mm512_cvtepi32_epi16(_mm512_castps_si512(Interleave3(w[0], w[1], w[2], r)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + r * 16), h);
+        }
+        if (n < 16) std::memcpy(out + i * 3, t, n * 3 * sizeof(uint16_t));
+    }
+}
+
+void Unpack48(uint16_t const* in, Quaternion* out, size_t count) {
+    __m512i const bits15 = _mm512_set1_epi32(0x7FFF);
+    for (size_t i = 0; i < count; i += 16) {
+        size_t const n = count - i < 16 ? count - i : 16;
+        alignas(32) uint16_t t[48] = {};
+        uint16_t const* src = in + i * 3;
+        if (n < 16) {
+            std::memcpy(t, src, n * 3 * sizeof(uint16_t));
+            src = t;
+        }
+        __m512 r[3];
+        for (int k = 0; k < 3; ++k) {
+            __m256i const h = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src + k * 16));
+            r[k] = _mm512_castsi512_ps(_mm512_cvtepu16_epi32(h));
+        }
+        __m512i w[3];
+        for (int k = 0; k < 3; ++k) w[k] = _mm512_castps_si512(Deinterleave3(r[0], r[1], r[2], k));
+        __m512i const m = _mm512_or_si512(_mm512_srli_epi32(w[0], 15), _mm512_slli_epi32(_mm512_srli_epi32(w[1], 15), 1));
+        __m512 q[4];
+        JoinLargest(m,
+                    Dequantize<15>(_mm512_and_epi32(w[0], bits15)),
+                    Dequantize<15>(_mm512_and_epi32(w[1], bits15)),
+                    Dequantize<15>(_mm512_and_epi32(w[2], bits15)), q);
+        Store4(out[i].vec4.v, n * 4, q);
+    }
+}
+
+// octahedral from xo-math-packed.h over 16 vectors held as x, y and z. Returns each
+// vector's quantized coordinates as qx | qy << Bits.
+template<int Bits>
+XO_INL __m512i PackNormals(__m512 x, __m512 y, __m512 z) {
+    typedef octahedral::Format<Bits> F;
+    __m512 const signBit = _mm512_set1_ps(-0.f);
+    __m512 const zero = _mm512_setzero_ps();
+    __m512 const one = _mm512_set1_ps(1.f);
+    __m512 const sum = _mm512_add_ps(_mm512_add_ps(_mm512_abs_ps(x), _mm512_abs_ps(y)), _mm512_abs_ps(z));
+    __m512 px = _mm512_div_ps(x, sum);
+    __m512 py = _mm512_div_ps(y, sum);
+    __m512 const fx = Xor(_mm512_sub_ps(one, _mm512_abs_ps(py)),
+                          _mm512_maskz_mov_ps(_mm512_cmp_ps_mask(px, zero, _CMP_LT_OQ), signBit));
+    __m512 const fy = Xor(_mm512_sub_ps(one, _mm512_abs_ps(px)),
+                          _mm512_maskz_mov_ps(_mm512_cmp_ps_mask(py, zero, _CMP_LT_OQ), signBit));
+    __mmask16 const lower = _mm512_cmp_ps_mask(z, zero, _CMP_LT_OQ);
+    px = _mm512_mask_mov_ps(px, lower, fx);
+    py = _mm512_mask_mov_ps(py, lower, fy);
+    __m512 const scale = _mm512_set1_ps(F::Scale);
+    __m512i const max = _mm512_set1_epi32(static_cast<int>(F::Max));
+    __m512i qx = _mm512_cvtps_epi32(_mm512_mul_ps(_mm512_add_ps(px, one), scale));
+    __m512i qy = _mm512_cvtps_epi32(_mm512_mul_ps(_mm512_add_ps(py, one), scale));
+    qx = _mm512_min_epi32(_mm512_max_epi32(qx, _mm512_setzero_si512()), max);
+    qy = _mm512_min_epi32(_mm512_max_epi32(qy, _mm512_setzero_si512()), max);
+    return _mm512_or_si512(qx, _mm512_slli_epi32(qy, Bits));
+}
+
+// The unit vectors for 16 values of qx | qy << Bits, as x, y and z.
+template<int Bits>
+XO_INL void UnpackNormals(__m512i v, __m512& x, __m512& y, __m512& z) {
+    typedef octahedral::Format<Bits> F;
+    __m512 const signBit = _mm512_set1_ps(-0.f);
+    __m512 const zero = _mm512_setzero_ps();
+    __m512i const mask = _mm512_set1_epi32((1 << Bits) - 1);
+    __m512 const middle = _mm512_set1_ps(F::Middle);
+    __m512 const step = _mm512_set1_ps(F::Step);
+    __m512 px = _mm512_mul_ps(_mm512_sub_ps(_mm512_cvtepi32_ps(_mm512_and_epi32(v, mask)), middle), step);
+    __m512 py = _mm512_mul_ps(_mm512_sub_ps(_mm512_cvtepi32_ps(_mm512_and_epi32(_mm512_srli_epi32(v, Bits), mask)), middle), step);
+    __m512 const pz = _mm512_sub_ps(_mm512_sub_ps(_mm512_set1_ps(1.f), _mm512_abs_ps(px)), _mm512_abs_ps(py));
+    __m512 const t = _mm512_max_ps(Xor(pz, signBit), zero);
+    // px + t where px < 0, px - t elsewhere.
+    px = _mm512_add_ps(px, _mm512_mask_mov_ps(Xor(t, signBit), _mm512_cmp_ps_mask(px, zero, _CMP_LT_OQ), t));
+    py = _mm512_add_ps(py, _mm512_mask_mov_ps(Xor(t, signBit), _mm512_cmp_ps_mask(py, zero, _CMP_LT_OQ), t));
+    __m512 const length = _mm512_sqrt_ps(_mm512_fmadd_ps(px, px, _mm512_fmadd_ps(py, py, _mm512_mul_ps(pz, pz))));
+    x = _mm512_div_ps(px, length);
+    y = _mm512_div_ps(py, length);
+    z = _mm512_div_ps(pz, length);
+}
+
+void PackNormals32(Vector3 const* in, uint32_t* out, size_t count) {
+    for (size_t i = 0; i < count; i += 16) {
+        size_t const n = count - i < 16 ? count - i : 16;
+        __m512 r0, r1, r2;
+        Load3(&in[i].x, n * 3, r0, r1, r2);
+        __m512i const v = PackNormals<16>(Deinterleave3(r0, r1, r2, 0),
+                                          Deinterleave3(r0, r1, r2, 1),
+                                          Deinterleave3(r0, r1, r2, 2));
+        _mm512_mask_storeu_epi32(out + i, TailMask(n), v);
+    }
+}
+
+void UnpackNormals32(uint32_t const* in, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; i += 16) {
+        size_t const n = count - i < 16 ? count - i : 16;
+        __m512 x, y, z;
+        UnpackNormals<16>(_mm512_maskz_loadu_epi32(TailMask(n), in + i), x, y, z);
+        Store3(&out[i].x, n * 3, Interleave3(x, y, z, 0), Interleave3(x, y, z, 1), Interleave3(x, y, z, 2));
+    }
+}
+
+// The 16 bit forms go through a buffer at the tail, masked 16 bit loads and stores need
+// AVX512BW.
+void PackNormals16(Vector3 const* in, uint16_t* out, size_t count) {
+    for (size_t i = 0; i < count; i += 16) {
+        size_t const n = count - i < 16 ? count - i : 16;
+        __m512 r0, r1, r2;
+        Load3(&in[i].x, n * 3, r0, r1, r2);
+        __m256i const v = _mm512_cvtepi32_epi16(PackNormals<8>(Deinterleave3(r0, r1, r2, 0),
+                                                               Deinterleave3(r0, r1, r2, 1),
+                                                               Deinterleave3(r0, r1, r2, 2)));
+        if (n == 16) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+        }
+        else {
+            alignas(32) uint16_t t[16];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(t), v);
+            std::memcpy(out + i, t, n * sizeof(uint16_t));
+        }
+    }
+}
+
+void UnpackNormals16(uint16_t const* in, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; i += 16) {
+        size_t const n = count - i < 16 ? count - i : 16;
+        alignas(32) uint16_t t[16] = {};
+        uint16_t const* src = in + i;
+        if (n < 16) {
+            std::memcpy(t, src, n * sizeof(uint16_t));
+            src = t;
+        }
+        __m512 x, y, z;
+        UnpackNormals<8>(_mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(src))), x, y, z);
+        Store3(&out[i].x, n * 3, Interleave3(x, y, z, 0), Interleave3(x, y, z, 1), Interleave3(x, y, z, 2));
+    }
+}
+
+} } // ::xo::avx512
+#if defined(__clang__)
+#   pragma clang attribute pop
+#elif defined(__GNUC__)
+#   pragma GCC diagnostic pop
+#   pragma GCC pop_options
+#endif
+#else
+#define XO_BATCH_AVX512 0
+#endif
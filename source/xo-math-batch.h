@@ -0,0 +1,600 @@
+#pragma once
+#include <inttypes.h>
+#include "xo-math-macros.h"
+#include "xo-math-detect-simd.h"
+#include "xo-math-avx2.h"
+#include "xo-math-avx512.h"
+// $inline_begin
+namespace xo { namespace batch {
+// Array versions of the per vector operations. Every function processes 'count' elements,
+// out may be the same array as an input but must not partially overlap one. With a count of
+// 0 the pointers may be null.
+// Each call goes through a table of kernels picked once, on first use, from what the cpu
+// supports: 16 lanes at a time with AVX512, 8 with AVX2, FMA3 and F16C, otherwise a loop over
+// the vector types (which use whatever the build targets). Define
+// XO_CONFIG_RUNTIME_DISPATCH 0 to pick from the build flags only.
+// With Precision::Fast or Fastest, Normalize results depend on the kernels in use, the
+// AVX512 ones start from a more accurate estimate.
+
+void Add(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count);
+void Subtract(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count);
+void Multiply(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count);
+void Divide(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count);
+void DotProduct(Vector3 const* left, Vector3 const* right, float* out, size_t count);
+void CrossProduct(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count);
+void Normalize(Vector3 const* in, Vector3* out, size_t count,
+               Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+void Lerp(Vector3 const* left, Vector3 const* right, float t, Vector3* out, size_t count);
+
+void Add(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count);
+void Subtract(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count);
+void Multiply(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count);
+void Divide(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count);
+void DotProduct(Vector4 const* left, Vector4 const* right, float* out, size_t count);
+void Normalize(Vector4 const* in, Vector4* out, size_t count,
+               Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+void Lerp(Vector4 const* left, Vector4 const* right, float t, Vector4* out, size_t count);
+
+// out[i] = rotation.Rotate(in[i]), through the same kernels as Matrix4x4::TransformDirections.
+void Rotate(Quaternion const& rotation, Vector3 const* in, Vector3* out, size_t count);
+// out[i] = rotations[i].Rotate(in[i]), for skinning and rigid body updates. The rotations
+// should be normalized.
+void Rotate(Quaternion const* rotations, Vector3 const* in, Vector3* out, size_t count);
+
+// Interpolates from start[i] to end[i] by t[i], taking the shorter arc like
+// Quaternion::Slerp, for blending animation poses. start and end should be normalized.
+// Slerp has no branches and calls neither acos nor sin, the weights are polynomials
+// (see xo::slerp), about 1e-6 off Quaternion::Slerp. Nlerp is the normalized Lerp: cheaper,
+// but it doesn't move at a constant speed.
+void Slerp(Quaternion const* start, Quaternion const* end, float const* t,
+           Quaternion* out, size_t count);
+void Nlerp(Quaternion const* start, Quaternion const* end, float const* t,
+           Quaternion* out, size_t count, Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+
+// out[i] = RelativeTo(positions[i], origin): double precision positions to floats around
+// a camera or any other origin, subtracted before rounding.
+void RelativeTo(Vector3d const* positions, Vector3d const& origin, Vector3* out, size_t count);
+// out[i] = (in[i], 1) times matrix as a row vector, in double precision: the translation
+// comes from rows[3], the same as Matrix4x4::TransformPoints.
+void TransformPoints(Matrix4x4d const& matrix, Vector3d const* in, Vector3d* out, size_t count);
+
+// out[i] = Half3(in[i]) and the reverse, with F16C when the kernels have it. The results
+// are the same as FloatToHalf and HalfToFloat either way.
+void ToHalf(Vector3 const* in, Half3* out, size_t count);
+void ToHalf(Vector4 const* in, Half4* out, size_t count);
+void FromHalf(Half3 const* in, Vector3* out, size_t count);
+void FromHalf(Half4 const* in, Vector4* out, size_t count);
+
+// out[i] = PackedQuaternion32(in[i]) or PackedQuaternion48(in[i]) and back. Packing gives
+// the same bits on every path.
+void Pack(Quaternion const* in, PackedQuaternion32* out, size_t count);
+void Pack(Quaternion const* in, PackedQuaternion48* out, size_t count);
+void Unpack(PackedQuaternion32 const* in, Quaternion* out, size_t count);
+void Unpack(PackedQuaternion48 const* in, Quaternion* out, size_t count);
+// out[i] = PackedNormal32(in[i]) or PackedNormal16(in[i]) and back, the same guarantees.
+void Pack(Vector3 const* in, PackedNormal32* out, size_t count);
+void Pack(Vector3 const* in, PackedNormal16* out, size_t count);
+void Unpack(PackedNormal32 const* in, Vector3* out, size_t count);
+void Unpack(PackedNormal16 const* in, Vector3* out, size_t count);
+
+// The instruction set the batch functions are running with: eXO_AVX512, eXO_AVX2 or
+// eXO_SSE_NONE for the plain loops.
+simd::eXO_SSE ActiveKernels();
+
+// Switches to the best kernels at or below 'version', eXO_SSE_NONE for the plain loops.
+// Returns false and changes nothing if the cpu doesn't support 'version'.
+// Not thread safe, call it before any batch work is in flight.
+bool UseKernels(simd::eXO_SSE version);
+
+#if defined(XO_MATH_IMPL)
+namespace generic {
+void Add3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = left[i] + right[i];
+}
+
+void Subtract3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = left[i] - right[i];
+}
+
+void Multiply3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = left[i] * right[i];
+}
+
+void Divide3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = left[i] / right[i];
+}
+
+void DotProduct3(Vector3 const* left, Vector3 const* right, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = Vector3::DotProduct(left[i], right[i]);
+}
+
+void CrossProduct3(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = Vector3::CrossProduct(left[i], right[i]);
+}
+
+void Normalize3(Vector3 const* in, Vector3* out, size_t count, Precision precision) {
+    for (size_t i = 0; i < count; ++i) out[i] = in[i].Normalized(precision);
+}
+
+void Lerp3(Vector3 const* left, Vector3 const* right, float t, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = Vector3::Lerp(left[i], right[i], t);
+}
+
+void Add4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = left[i] + right[i];
+}
+
+void Subtract4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = left[i] - right[i];
+}
+
+void Multiply4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = left[i] * right[i];
+}
+
+void Divide4(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = left[i] / right[i];
+}
+
+void DotProduct4(Vector4 const* left, Vector4 const* right, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = Vector4::DotProduct(left[i], right[i]);
+}
+
+void Normalize4(Vector4 const* in, Vector4* out, size_t count, Precision precision) {
+    for (size_t i = 0; i < count; ++i) out[i] = in[i].Normalized(precision);
+}
+
+void Lerp4(Vector4 const* left, Vector4 const* right, float t, Vector4* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = Vector4::Lerp(left[i], right[i], t);
+}
+
+void Rotate3(Quaternion const* rotations, Vector3 const* in, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = rotations[i].Rotate(in[i]);
+}
+
+void Slerp(Quaternion const* start, Quaternion const* end, float const* t, Quaternion* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        float d = Quaternion::DotProduct(start[i], end[i]);
+        float sign = d < 0.f ? -1.f : 1.f;
+        out[i] = start[i] * slerp::Weight(d * sign, 1.f - t[i])
+               + end[i] * (slerp::Weight(d * sign, t[i]) * sign);
+    }
+}
+
+void Nlerp(Quaternion const* start, Quaternion const* end, float const* t, Quaternion* out, size_t count, Precision precision) {
+    for (size_t i = 0; i < count; ++i) {
+        Quaternion e = Quaternion::DotProduct(start[i], end[i]) < 0.f ? -end[i] : end[i];
+        out[i] = Quaternion::Lerp(start[i], e, t[i]).Normalized(precision);
+    }
+}
+
+void Transform3(float const* m,
+                float const* in, size_t inStride,
+                float* out, size_t outStride,
+                size_t count, float w) {
+    char const* src = reinterpret_cast<char const*>(in);
+    char* dst = reinterpret_cast<char*>(out);
+    for (size_t i = 0; i < count; ++i, src += inStride, dst += outStride) {
+        float const* s = reinterpret_cast<float const*>(src);
+        float* d = reinterpret_cast<float*>(dst);
+        float const x = s[0], y = s[1], z = s[2];
+        d[0] = x * m[0] + y * m[4] + z * m[8] + w * m[12];
+        d[1] = x * m[1] + y * m[5] + z * m[9] + w * m[13];
+        d[2] = x * m[2] + y * m[6] + z * m[10] + w * m[14];
+    }
+}
+
+void RelativeTo3d(double const* in, double const* origin, float* out, size_t count) {
+    for (size_t i = 0; i < count * 3; i += 3) {
+        out[i] = static_cast<float>(in[i] - origin[0]);
+        out[i + 1] = static_cast<float>(in[i + 1] - origin[1]);
+        out[i + 2] = static_cast<float>(in[i + 2] - origin[2]);
+    }
+}
+
+void Transform3d(double const* m, double const* in, double* out, size_t count) {
+    for (size_t i = 0; i < count * 3; i += 3) {
+        double const x = in[i], y = in[i + 1], z = in[i + 2];
+        out[i] = x * m[0] + y * m[4] + z * m[8] + m[12];
+        out[i + 1] = x * m[1] + y * m[5] + z * m[9] + m[13];
+        out[i + 2] = x * m[2] + y * m[6] + z * m[10] + m[14];
+    }
+}
+
+void ToHalf(float const* in, uint16_t* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = FloatToHalf(in[i]);
+}
+
+void FromHalf(uint16_t const* in, float* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = HalfToFloat(in[i]);
+}
+
+void Pack32(Quaternion const* in, uint32_t* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) out[i] = PackedQuaternion32(in[i]).bits;
+}
+
+void Unpack32(uint32_t const* in, Quaternion* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        PackedQuaternion32 p;
+        p.bits = in[i];
+        out[i] = p.ToQuaternion();
+    }
+}
+
+void Pack48(Quaternion const* in, uint16_t* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        PackedQuaternion48 const p(in[i]);
+        std::memcpy(out + i * 3, p.words, sizeof(p.words));
+    }
+}
+
+void Unpack48(uint16_t const* in, Quaternion* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        PackedQuaternion48 p;
+        std::memcpy(p.words, in + i * 3, sizeof(p.words));
+        out[i] = p.ToQuaternion();
+    }
+}
+
+void PackNormals32(Vector3 const* in, uint32_t* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        PackedNormal32 const p(in[i]);
+        out[i] = p.x | (static_cast<uint32_t>(p.y) << 16);
+    }
+}
+
+void UnpackNormals32(uint32_t const* in, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        PackedNormal32 p;
+        p.x = static_cast<uint16_t>(in[i]);
+        p.y = static_cast<uint16_t>(in[i] >> 16);
+        out[i] = p.ToVector3();
+    }
+}
+
+void PackNormals16(Vector3 const* in, uint16_t* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        PackedNormal16 const p(in[i]);
+        out[i] = static_cast<uint16_t>(p.x | (p.y << 8));
+    }
+}
+
+void UnpackNormals16(uint16_t const* in, Vector3* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        PackedNormal16 p;
+        p.x = static_cast<uint8_t>(in[i]);
+        p.y = static_cast<uint8_t>(in[i] >> 8);
+        out[i] = p.ToVector3();
+    }
+}
+
+void Transform4(float const* m,
+                float const* in, size_t inStride,
+                float* out, size_t outStride,
+                size_t count) {
+    char const* src = reinterpret_cast<char const*>(in);
+    char* dst = reinterpret_cast<char*>(out);
+    for (size_t i = 0; i < count; ++i, src += inStride, dst += outStride) {
+        float const* s = reinterpret_cast<float const*>(src);
+        float* d = reinterpret_cast<float*>(dst);
+        float const x = s[0], y = s[1], z = s[2], w = s[3];
+        d[0] = x * m[0] + y * m[4] + z * m[8] + w * m[12];
+        d[1] = x * m[1] + y * m[5] + z * m[9] + w * m[13];
+        d[2] = x * m[2] + y * m[6] + z * m[10] + w * m[14];
+        d[3] = x * m[3] + y * m[7] + z * m[11] + w * m[15];
+    }
+}
+
+void Multiply4x4(float const* left, float const* right, float* out, size_t count) {
+    for (size_t i = 0; i < count * 16; i += 16) {
+        Matrix4x4 l, r;
+        std::memcpy(l.v, left + i, sizeof(l.v));
+        std::memcpy(r.v, right + i, sizeof(r.v));
+        l *= r;
+        std::memcpy(out + i, l.v, sizeof(l.v));
+    }
+}
+} // ::xo::batch::generic
+
+namespace {
+struct Kernels {
+    simd::eXO_SSE version;
+    void (*add3)(Vector3 const*, Vector3 const*, Vector3*, size_t);
+    void (*subtract3)(Vector3 const*, Vector3 const*, Vector3*, size_t);
+    void (*multiply3)(Vector3 const*, Vector3 const*, Vector3*, size_t);
+    void (*divide3)(Vector3 const*, Vector3 const*, Vector3*, size_t);
+    void (*dotProduct3)(Vector3 const*, Vector3 const*, float*, size_t);
+    void (*crossProduct3)(Vector3 const*, Vector3 const*, Vector3*, size_t);
+    void (*normalize3)(Vector3 const*, Vector3*, size_t, Precision);
+    void (*lerp3)(Vector3 const*, Vector3 const*, float, Vector3*, size_t);
+    void (*add4)(Vector4 const*, Vector4 const*, Vector4*, size_t);
+    void (*subtract4)(Vector4 const*, Vector4 const*, Vector4*, size_t);
+    void (*multiply4)(Vector4 const*, Vector4 const*, Vector4*, size_t);
+    void (*divide4)(Vector4 const*, Vector4 const*, Vector4*, size_t);
+    void (*dotProduct4)(Vector4 const*, Vector4 const*, float*, size_t);
+    void (*normalize4)(Vector4 const*, Vector4*, size_t, Precision);
+    void (*lerp4)(Vector4 const*, Vector4 const*, float, Vector4*, size_t);
+    void (*rotate3)(Quaternion const*, Vector3 const*, Vector3*, size_t);
+    void (*slerp)(Quaternion const*, Quaternion const*, float const*, Quaternion*, size_t);
+    void (*nlerp)(Quaternion const*, Quaternion const*, float const*, Quaternion*, size_t, Precision);
+    void (*transform3)(float const*, float const*, size_t, float*, size_t, size_t, float);
+    void (*transform4)(float const*, float const*, size_t, float*, size_t, size_t);
+    void (*multiply4x4)(float const*, float const*, float*, size_t);
+    void (*relativeTo3d)(double const*, double const*, float*, size_t);
+    void (*transform3d)(double const*, double const*, double*, size_t);
+    void (*toHalf)(float const*, uint16_t*, size_t);
+    void (*fromHalf)(uint16_t const*, float*, size_t);
+    void (*pack32)(Quaternion const*, uint32_t*, size_t);
+    void (*unpack32)(uint32_t const*, Quaternion*, size_t);
+    void (*pack48)(Quaternion const*, uint16_t*, size_t);
+    void (*unpack48)(uint16_t const*, Quaternion*, size_t);
+    void (*packNormals32)(Vector3 const*, uint32_t*, size_t);
+    void (*unpackNormals32)(uint32_t const*, Vector3*, size_t);
+    void (*packNormals16)(Vector3 const*, uint16_t*, size_t);
+    void (*unpackNormals16)(uint16_t const*, Vector3*, size_t);
+};
+
+#define XO_BATCH_KERNELS(ns, version) { version, \
+    ns::Add3, ns::Subtract3, ns::Multiply3, ns::Divide3, \
+    ns::DotProduct3, ns::CrossProduct3, ns::Normalize3, ns::Lerp3, \
+    ns::Add4, ns::Subtract4, ns::Multiply4, ns::Divide4, \
+    ns::DotProduct4, ns::Normalize4, ns::Lerp4, \
+    ns::Rotate3, ns::Slerp, ns::Nlerp, \
+    ns::Transform3, ns::Transform4, ns::Multiply4x4, \
+    ns::RelativeTo3d, ns::Transform3d, \
+    ns::ToHalf, ns::FromHalf, \
+    ns::Pack32, ns::Unpack32, ns::Pack48, ns::Unpack48, \
+    ns::PackNormals32, ns::UnpackNormals32, ns::PackNormals16, ns::UnpackNormals16 }
+
+Kernels const GenericKernels = XO_BATCH_KERNELS(generic, simd::eXO_SSE::eXO_SSE_NONE);
+#   if XO_BATCH_AVX2
+Kernels const AVX2Kernels = XO_BATCH_KERNELS(avx2, simd::eXO_SSE::eXO_AVX2);
+#   endif
+#   if XO_BATCH_AVX512
+Kernels const AVX512Kernels = XO_BATCH_KERNELS(avx512, simd::eXO_SSE::eXO_AVX512);
+#   endif
+#undef XO_BATCH_KERNELS
+
+// What the kernels are allowed to assume is available.
+simd::eXO_SSE SupportedVersion() {
+#   if XO_CONFIG_RUNTIME_DISPATCH
+    return simd::SSEGetRuntimeVersion();
+#   else
+    return simd::eXO_SSE::eXO_SSE_CURRENT;
+#   endif
+}
+
+Kernels const* SelectKernels(simd::eXO_SSE version) {
+#   if XO_BATCH_AVX512
+    if (version >= simd::eXO_SSE::eXO_AVX512) return &AVX512Kernels;
+#   endif
+#   if XO_BATCH_AVX2
+    if (version >= simd::eXO_SSE::eXO_AVX2) return &AVX2Kernels;
+#   endif
+    XO_UNUSED(version);
+    return &GenericKernels;
+}
+
+Kernels const*& Active() {
+    static Kernels const* active = SelectKernels(SupportedVersion());
+    return active;
+}
+} // ::xo::batch::anonymous
+
+simd::eXO_SSE ActiveKernels() {
+    return Active()->version;
+}
+
+bool UseKernels(simd::eXO_SSE version) {
+    if (version > SupportedVersion()) return false;
+    Active() = SelectKernels(version);
+    return true;
+}
+
+void Add(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Active()->add3(left, right, out, count);
+}
+
+void Subtract(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Active()->subtract3(left, right, out, count);
+}
+
+void Multiply(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Active()->multiply3(left, right, out, count);
+}
+
+void Divide(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Active()->divide3(left, right, out, count);
+}
+
+void DotProduct(Vector3 const* left, Vector3 const* right, float* out, size_t count) {
+    Active()->dotProduct3(left, right, out, count);
+}
+
+void CrossProduct(Vector3 const* left, Vector3 const* right, Vector3* out, size_t count) {
+    Active()->crossProduct3(left, right, out, count);
+}
+
+void Normalize(Vector3 const* in, Vector3* out, size_t count, Precision precision) {
+    Active()->normalize3(in, out, count, precision);
+}
+
+void Lerp(Vector3 const* left, Vector3 const* right, float t, Vector3* out, size_t count) {
+    Active()->lerp3(left, right, t, out, count);
+}
+
+void Add(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Active()->add4(left, right, out, count);
+}
+
+void Subtract(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Active()->subtract4(left, right, out, count);
+}
+
+void Multiply(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Active()->multiply4(left, right, out, count);
+}
+
+void Divide(Vector4 const* left, Vector4 const* right, Vector4* out, size_t count) {
+    Active()->divide4(left, right, out, count);
+}
+
+void DotProduct(Vector4 const* left, Vector4 const* right, float* out, size_t count) {
+    Active()->dotProduct4(left, right, out, count);
+}
+
+void Normalize(Vector4 const* in, Vector4* out, size_t count, Precision precision) {
+    Active()->normalize4(in, out, count, precision);
+}
+
+void Lerp(Vector4 const* left, Vector4 const* right, float t, Vector4* out, size_t count) {
+    Active()->lerp4(left, right, t, out, count);
+}
+
+void Rotate(Quaternion const& rotation, Vector3 const* in, Vector3* out, size_t count) {
+    // ToMatrix rotates column vectors, the kernels take row vectors.
+    Matrix4x4 const m = Matrix4x4::Transpose(rotation.ToMatrix());
+    Active()->transform3(m.v, reinterpret_cast<float const*>(in), sizeof(Vector3),
+                         reinterpret_cast<float*>(out), sizeof(Vector3), count, 0.f);
+}
+
+void Rotate(Quaternion const* rotations, Vector3 const* in, Vector3* out, size_t count) {
+    Active()->rotate3(rotations, in, out, count);
+}
+
+void Slerp(Quaternion const* start, Quaternion const* end, float const* t,
+           Quaternion* out, size_t count) {
+    Active()->slerp(start, end, t, out, count);
+}
+
+void Nlerp(Quaternion const* start, Quaternion const* end, float const* t,
+           Quaternion* out, size_t count, Precision precision) {
+    Active()->nlerp(start, end, t, out, count, precision);
+}
+
+void RelativeTo(Vector3d const* positions, Vector3d const& origin, Vector3* out, size_t count) {
+    Active()->relativeTo3d(reinterpret_cast<double const*>(positions), origin.v,
+                           reinterpret_cast<float*>(out), count);
+}
+
+void TransformPoints(Matrix4x4d const& matrix, Vector3d const* in, Vector3d* out, size_t count) {
+    Active()->transform3d(matrix.rows[0].v, reinterpret_cast<double const*>(in),
+                          reinterpret_cast<double*>(out), count);
+}
+
+// Half3 and Half4 arrays are flat runs of halves like Vector3 and Vector4 arrays are of
+// floats, so they convert component by component.
+void ToHalf(Vector3 const* in, Half3* out, size_t count) {
+    Active()->toHalf(reinterpret_cast<float const*>(in), reinterpret_cast<uint16_t*>(out), count * 3);
+}
+
+void ToHalf(Vector4 const* in, Half4* out, size_t count) {
+    Active()->toHalf(reinterpret_cast<float const*>(in), reinterpret_cast<uint16_t*>(out), count * 4);
+}
+
+void FromHalf(Half3 const* in, Vector3* out, size_t count) {
+    Active()->fromHalf(reinterpret_cast<uint16_t const*>(in), reinterpret_cast<float*>(out), count * 3);
+}
+
+void FromHalf(Half4 const* in, Vector4* out, size_t count) {
+    Active()->fromHalf(reinterpret_cast<uint16_t const*>(in), reinterpret_cast<float*>(out), count * 4);
+}
+
+void Pack(Quaternion const* in, PackedQuaternion32* out, size_t count) {
+    Active()->pack32(in, reinterpret_cast<uint32_t*>(out), count);
+}
+
+void Pack(Quaternion const* in, PackedQuaternion48* out, size_t count) {
+    Active()->pack48(in, reinterpret_cast<uint16_t*>(out), count);
+}
+
+void Unpack(PackedQuaternion32 const* in, Quaternion* out, size_t count) {
+    Active()->unpack32(reinterpret_cast<uint32_t const*>(in), out, count);
+}
+
+void Unpack(PackedQuaternion48 const* in, Quaternion* out, size_t count) {
+    Active()->unpack48(reinterpret_cast<uint16_t const*>(in), out, count);
+}
+
+// The packed normals are read and written as one little endian word per vector, x in the
+// low half.
+void Pack(Vector3 const* in, PackedNormal32* out, size_t count) {
+    Active()->packNormals32(in, reinterpret_cast<uint32_t*>(out), count);
+}
+
+void Pack(Vector3 const* in, PackedNormal16* out, size_t count) {
+    Active()->packNormals16(in, reinterpret_cast<uint16_t*>(out), count);
+}
+
+void Unpack(PackedNormal32 const* in, Vector3* out, size_t count) {
+    Active()->unpackNormals32(reinterpret_cast<uint32_t const*>(in), out, count);
+}
+
+void Unpack(PackedNormal16 const* in, Vector3* out, size_t count) {
+    Active()->unpackNormals16(reinterpret_cast<uint16_t const*>(in), out, count);
+}
+#endif
+
+} } // ::xo::batch
+
+namespace xo {
+#if defined(XO_MATH_IMPL)
+////////////////////////////////////////////////////////////////////////////////////////// Matrix transforms
+// The span transforms on the matrix types run on the same kernel table as the batch
+// functions. Like those, they cast the array pointers instead of taking &in->x, which is
+// undefined for the null pointer an empty span may pass.
+void XO_CC Matrix4x4::TransformPoints(Vector3 const* in, Vector3* out, size_t count,
+                                      size_t inStride, size_t outStride) const {
+    batch::Active()->transform3(v, reinterpret_cast<float const*>(in), inStride,
+                                reinterpret_cast<float*>(out), outStride, count, 1.f);
+}
+
+void XO_CC Matrix4x4::TransformDirections(Vector3 const* in, Vector3* out, size_t count,
+                                          size_t inStride, size_t outStride) const {
+    batch::Active()->transform3(v, reinterpret_cast<float const*>(in), inStride,
+                                reinterpret_cast<float*>(out), outStride, count, 0.f);
+}
+
+void XO_CC Matrix4x4::TransformHomogeneous(Vector4 const* in, Vector4* out, size_t count,
+                                           size_t inStride, size_t outStride) const {
+    batch::Active()->transform4(v, reinterpret_cast<float const*>(in), inStride,
+                                reinterpret_cast<float*>(out), outStride, count);
+}
+
+void XO_CC AMatrix4x4::TransformPoints(AVector3 const* in, AVector3* out, size_t count,
+                                       size_t inStride, size_t outStride) const {
+    batch::Active()->transform3(v, reinterpret_cast<float const*>(in), inStride,
+                                reinterpret_cast<float*>(out), outStride, count, 1.f);
+}
+
+void XO_CC AMatrix4x4::TransformDirections(AVector3 const* in, AVector3* out, size_t count,
+                                           size_t inStride, size_t outStride) const {
+    batch::Active()->transform3(v, reinterpret_cast<float const*>(in), inStride,
+                                reinterpret_cast<float*>(out), outStride, count, 0.f);
+}
+
+void XO_CC AMatrix4x4::TransformHomogeneous(AVector4 const* in, AVector4* out, size_t count,
+                                            size_t inStride, size_t outStride) const {
+    batch::Active()->transform4(v, reinterpret_cast<float const*>(in), inStride,
+                                reinterpret_cast<float*>(out), outStride, count);
+}
+
+// Both matrix types are 16 floats with no padding, so an array of either is a flat run of
+// floats for the kernels.
+/*static*/
+void XO_CC Matrix4x4::Multiply(Matrix4x4 const* left, Matrix4x4 const* right, Matrix4x4* out,
+                               size_t count) {
+    static_assert(sizeof(Matrix4x4) == 16 * sizeof(float), "Matrix4x4 arrays must be packed");
+    batch::Active()->multiply4x4(reinterpret_cast<float const*>(left), reinterpret_cast<float const*>(right),
+                                 reinterpret_cast<float*>(out), count);
+}
+
+/*static*/
+void XO_CC AMatrix4x4::Multiply(AMatrix4x4 const* left, AMatrix4x4 const* right, AMatrix4x4* out,
+                                size_t count) {
+    static_assert(sizeof(AMatrix4x4) == 16 * sizeof(float), "AMatrix4x4 arrays must be packed");
+    batch::Active()->multiply4x4(reinterpret_cast<float const*>(left), reinterpret_cast<float const*>(right),
+                                 reinterpret_cast<float*>(out), count);
+}
+#endif
+} // ::xo
@@ -7,6 +7,7 @@ namespace xo{
 // please read about epsilon before using it
 // see: http://realtimecollisiondetection.net/blog/?p=89
 constexpr float MachineEpsilon = std::numeric_limits<float>::epsilon();
+constexpr double MachineEpsilonDouble = std::numeric_limits<double>::epsilon();
 
 constexpr float Deg2Rad = 0.0174532925f;
 constexpr float Rad2Deg = 57.2957795f;
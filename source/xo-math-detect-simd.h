@@ -1,8 +1,22 @@
 #pragma once
 #include <inttypes.h>
+#include "xo-math-macros.h"
 // $inline_begin
+#if defined(XO_MATH_IMPL)
+#   if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#       include <intrin.h>
+#   elif (defined(__clang__) || defined(__GNUC__)) && (defined(__x86_64__) || defined(__i386__))
+#       include <cpuid.h>
+#   endif
+#endif
 namespace xo { namespace simd {
 
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#   define XO_X86 1
+#else
+#   define XO_X86 0
+#endif
+
 #define XO_SSE_NONE 0x00
 #define XO_SSE1     0x10
 #define XO_SSE2     0x20
@@ -65,6 +79,20 @@ namespace xo { namespace simd {
 #    define XO_HAS_SSE 1
 #endif
 
+// FMA3 is its own flag (-mfma) on gcc and clang, msvc enables it along with /arch:AVX2
+#if defined(__FMA__) || (defined(_MSC_VER) && XO_SSE_CURRENT >= XO_AVX2)
+#   define XO_HAS_FMA 1
+#else
+#   define XO_HAS_FMA 0
+#endif
+
+// So is F16C (-mf16c), msvc has no flag for it and uses it from /arch:AVX2 on
+#if defined(__F16C__) || (defined(_MSC_VER) && XO_SSE_CURRENT >= XO_AVX2)
+#   define XO_HAS_F16C 1
+#else
+#   define XO_HAS_F16C 0
+#endif
+
 enum class eXO_SSE : uint8_t
 {
     eXO_SSE_NONE    = XO_SSE_NONE,
@@ -100,6 +128,87 @@ constexpr char const* SSEGetName(eXO_SSE version = eXO_SSE::eXO_SSE_CURRENT)
 
 constexpr char const* SSEVersionName = SSEGetName();
 
+// XO_SSE_CURRENT is what the compiler was asked to target. The runtime version is what the
+// machine running the code supports, checked with cpuid and xgetbv (so an AVX capable cpu
+// on an OS that doesn't save the wider registers reports the level below AVX).
+// XO_AVX2 is only reported along with FMA3 and F16C, XO_AVX512 means AVX512F.
+// The result is computed once and cached.
+eXO_SSE SSEGetRuntimeVersion();
+char const* SSEGetRuntimeName();
+
+#if defined(XO_MATH_IMPL)
+namespace {
+bool CPUID(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) {
+#   if XO_X86 && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (static_cast<uint32_t>(info[0]) < leaf) return false;
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i) regs[i] = static_cast<uint32_t>(info[i]);
+    return true;
+#   elif XO_X86 && (defined(__clang__) || defined(__GNUC__))
+    if (__get_cpuid_max(0, nullptr) < leaf) return false;
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+    return true;
+#   else
+    XO_UNUSED(leaf);
+    XO_UNUSED(subleaf);
+    XO_UNUSED(regs);
+    return false;
+#   endif
+}
+
+// Which register states the OS saves on a context switch. Only valid with OSXSAVE.
+uint64_t XGETBV() {
+#   if XO_X86 && defined(_MSC_VER)
+    return _xgetbv(0);
+#   elif XO_X86 && (defined(__clang__) || defined(__GNUC__))
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+#   else
+    return 0;
+#   endif
+}
+
+eXO_SSE DetectRuntimeVersion() {
+    uint32_t r1[4];
+    if (!CPUID(1, 0, r1)) return eXO_SSE::eXO_SSE_NONE;
+    uint32_t const ecx = r1[2], edx = r1[3];
+    if (!(edx & (1u << 25))) return eXO_SSE::eXO_SSE_NONE;
+    if (!(edx & (1u << 26))) return eXO_SSE::eXO_SSE1;
+    if (!(ecx & (1u << 0)))  return eXO_SSE::eXO_SSE2;
+    if (!(ecx & (1u << 9)))  return eXO_SSE::eXO_SSE3;
+    if (!(ecx & (1u << 19))) return eXO_SSE::eXO_SSSE3;
+    if (!(ecx & (1u << 20))) return eXO_SSE::eXO_SSE4_1;
+
+    bool const osxsave = (ecx & (1u << 27)) != 0;
+    uint64_t const xcr0 = osxsave ? XGETBV() : 0;
+    bool const ymm = (xcr0 & 0x6) == 0x6;             // xmm and ymm state
+    bool const zmm = (xcr0 & 0xE6) == 0xE6;           // ... plus opmask and zmm state
+    if (!(ecx & (1u << 28)) || !ymm) return eXO_SSE::eXO_SSE4_2;
+
+    uint32_t r7[4];
+    if (!CPUID(7, 0, r7)) return eXO_SSE::eXO_AVX;
+    uint32_t const ebx7 = r7[1];
+    bool const fma = (ecx & (1u << 12)) != 0;
+    bool const f16c = (ecx & (1u << 29)) != 0;
+    if (!(ebx7 & (1u << 5)) || !fma || !f16c) return eXO_SSE::eXO_AVX;
+    if (!(ebx7 & (1u << 16)) || !zmm) return eXO_SSE::eXO_AVX2;
+    return eXO_SSE::eXO_AVX512;
+}
+} // ::xo::simd::anonymous
+
+eXO_SSE SSEGetRuntimeVersion() {
+    static eXO_SSE const version = DetectRuntimeVersion();
+    return version;
+}
+
+char const* SSEGetRuntimeName() {
+    return SSEGetName(SSEGetRuntimeVersion());
+}
+#endif
+
 #define XO_NEON_NONE 0x00
 #define XO_NEON7     0x70
 
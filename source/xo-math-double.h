@@ -0,0 +1,244 @@
+#pragma once
+#include <inttypes.h>
+#include "xo-math-macros.h"
+#include "xo-math-utilities.h"
+#include "xo-math-generic.h"
+// $inline_begin
+#include <cmath>
+namespace xo {
+//////////////////////////////////////////////////////////////////////////////////////////
+// Double precision for world space positions that floats can't hold, like a planet sized
+// map where a float is already a centimetre off 100km from the origin.
+// The vectors and the matrix are the generic templates over double, Quaterniond mirrors
+// Quaternion. Being the templates, the vectors name their components with functions,
+// p.x() where a Vector3 has p.x, and DotProduct and CrossProduct are static as on Vector3.
+// Keep the simulation in doubles and go to floats per frame relative to the camera: the
+// subtraction happens before the precision goes, so everything near the camera is as exact
+// as floats allow.
+//
+//     Vector3 p = RelativeTo(position, cameraPosition);
+//     batch::RelativeTo(positions, cameraPosition, renderPositions, count);
+//
+// The array work, RelativeTo and TransformPoints, is in xo::batch and runs 4 doubles at a
+// time with AVX2 and 8 with AVX512.
+
+typedef Vector<3, double> Vector3d;
+typedef Vector<4, double> Vector4d;
+typedef Matrix<4, 4, double> Matrix4x4d;
+
+struct Quaterniond {
+    union {
+        struct { double i, j, k, r; };
+        Vector4d vec4;
+    };
+
+    constexpr Quaterniond(double i, double j, double k, double r)
+        : i(i)
+        , j(j)
+        , k(k)
+        , r(r)
+    { }
+
+    constexpr explicit Quaterniond(Vector4d const& v4)
+        : vec4(v4)
+    { }
+
+    explicit Quaterniond(Quaternion const& q);
+
+    Quaterniond() = default;
+    ~Quaterniond() = default;
+    Quaterniond(Quaterniond const& other) = default;
+    Quaterniond(Quaterniond&& ref) = default;
+    Quaterniond& operator = (Quaterniond const& other) = default;
+    Quaterniond& operator = (Quaterniond&& ref) = default;
+
+    Quaterniond operator + (Quaterniond const& other) const;
+    Quaterniond operator * (double scalar) const;
+    Quaterniond operator -() const;
+    // The Hamilton product: rotating by a * b is rotating by b, then by a.
+    Quaterniond XO_CC operator * (Quaterniond const& other) const;
+    Quaterniond& XO_CC operator *= (Quaterniond const& other);
+
+    // v rotated by this, which should be normalized.
+    Vector3d XO_CC Rotate(Vector3d const& v) const;
+
+    double Magnitude() const;
+    double MagnitudeSquared() const;
+    Quaterniond Normalized() const;
+    Quaterniond& Normalize();
+
+    Matrix4x4d ToMatrix() const;
+    Quaternion ToFloat() const;
+
+    static Quaterniond XO_CC Invert(Quaterniond const& quat);
+    static Quaterniond XO_CC RotationAxisAngle(Vector3d const& axis, double angle);
+    static double XO_CC DotProduct(Quaterniond const& left, Quaterniond const& right);
+    static Quaterniond XO_CC Lerp(Quaterniond const& start, Quaterniond const& end, double t);
+    static Quaterniond XO_CC Slerp(Quaterniond const& start, Quaterniond const& end, double t);
+
+    static bool XO_CC RoughlyEqual(Quaterniond const& left, Quaterniond const& right);
+    static bool XO_CC ExactlyEqual(Quaterniond const& left, Quaterniond const& right);
+
+    static const Quaterniond Identity;
+};
+
+#if defined(XO_MATH_IMPL)
+/*static*/ const Quaterniond Quaterniond::Identity(0.0, 0.0, 0.0, 1.0);
+#endif
+
+XO_INL
+Quaterniond::Quaterniond(Quaternion const& q)
+    : i(q.i)
+    , j(q.j)
+    , k(q.k)
+    , r(q.r)
+{ }
+
+XO_INL
+Quaterniond Quaterniond::operator + (Quaterniond const& other) const {
+    return Quaterniond(vec4 + other.vec4);
+}
+
+XO_INL
+Quaterniond Quaterniond::operator * (double scalar) const {
+    return Quaterniond(vec4 * scalar);
+}
+
+XO_INL
+Quaterniond Quaterniond::operator -() const {
+    return Quaterniond(-vec4);
+}
+
+XO_INL
+Quaterniond XO_CC Quaterniond::operator * (Quaterniond const& other) const {
+    return Quaterniond(r * other.i + i * other.r + j * other.k - k * other.j,
+                       r * other.j - i * other.k + j * other.r + k * other.i,
+                       r * other.k + i * other.j - j * other.i + k * other.r,
+                       r * other.r - i * other.i - j * other.j - k * other.k);
+}
+
+XO_INL
+Quaterniond& XO_CC Quaterniond::operator *= (Quaterniond const& other) {
+    return *this = *this * other;
+}
+
+XO_INL
+Vector3d XO_CC Quaterniond::Rotate(Vector3d const& v) const {
+    Vector3d q(i, j, k);
+    Vector3d t = Vector3d::CrossProduct(q, v) * 2.0;
+    return v + t * r + Vector3d::CrossProduct(q, t);
+}
+
+XO_INL
+double Quaterniond::Magnitude() const {
+    return std::sqrt(MagnitudeSquared());
+}
+
+XO_INL
+double Quaterniond::MagnitudeSquared() const {
+    return Vector4d::DotProduct(vec4, vec4);
+}
+
+XO_INL
+Quaterniond Quaterniond::Normalized() const {
+    return Quaterniond(vec4 / Magnitude());
+}
+
+XO_INL
+Quaterniond& Quaterniond::Normalize() {
+    return *this = Normalized();
+}
+
+XO_INL
+Matrix4x4d Quaterniond::ToMatrix() const {
+    // The same matrix as Quaternion::ToMatrix.
+    double ii = i * i;
+    double ij = i * j;
+    double ik = i * k;
+    double ir = i * r;
+    double jj = j * j;
+    double jk = j * k;
+    double jr = j * r;
+    double kk = k * k;
+    double kr = k * r;
+    return Matrix4x4d(
+        Vector4d(1.0 - 2.0 * (jj + kk), 2.0 * (ij - kr), 2.0 * (ik + jr), 0.0),
+        Vector4d(2.0 * (ij + kr), 1.0 - 2.0 * (ii + kk), 2.0 * (jk - ir), 0.0),
+        Vector4d(2.0 * (ik - jr), 2.0 * (jk + ir), 1.0 - 2.0 * (ii + jj), 0.0),
+        Vector4d(0.0, 0.0, 0.0, 1.0));
+}
+
+XO_INL
+Quaternion Quaterniond::ToFloat() const {
+    return Quaternion(static_cast<float>(i), static_cast<float>(j),
+                      static_cast<float>(k), static_cast<float>(r));
+}
+
+/*static*/ XO_INL
+Quaterniond XO_CC Quaterniond::Invert(Quaterniond const& quat) {
+    return Quaterniond(-quat.i, -quat.j, -quat.k, quat.r);
+}
+
+/*static*/ XO_INL
+Quaterniond XO_CC Quaterniond::RotationAxisAngle(Vector3d const& axis, double angle) {
+    double s = std::sin(angle * 0.5), c = std::cos(angle * 0.5);
+    return Quaterniond(axis.v[0] * s, axis.v[1] * s, axis.v[2] * s, c);
+}
+
+/*static*/ XO_INL
+double XO_CC Quaterniond::DotProduct(Quaterniond const& left, Quaterniond const& right) {
+    return Vector4d::DotProduct(left.vec4, right.vec4);
+}
+
+/*static*/ XO_INL
+Quaterniond XO_CC Quaterniond::Lerp(Quaterniond const& start, Quaterniond const& end, double t) {
+    return Quaterniond(Vector4d::Lerp(start.vec4, end.vec4, t));
+}
+
+/*static*/ XO_INL
+Quaterniond XO_CC Quaterniond::Slerp(Quaterniond const& start, Quaterniond const& end, double t) {
+    Quaterniond s = start.Normalized();
+    Quaterniond e = end.Normalized();
+    double d = DotProduct(s, e);
+    if (d < 0.0) {
+        e = -e;
+        d = -d;
+    }
+
+    if (CloseEnough(d, 1.0)) {
+        return Lerp(s, e, t).Normalize();
+    }
+
+    double th0 = std::acos(d);
+    double th = th0 * t;
+    double sth0 = std::sin(th0);
+    double s0 = std::cos(th) - d * std::sin(th) / sth0;
+    double s1 = std::sin(th) / sth0;
+    return (s * s0) + (e * s1);
+}
+
+/*static*/ XO_INL
+bool XO_CC Quaterniond::RoughlyEqual(Quaterniond const& left, Quaterniond const& right) {
+    return left.vec4.RoughlyEqual(right.vec4);
+}
+
+/*static*/ XO_INL
+bool XO_CC Quaterniond::ExactlyEqual(Quaterniond const& left, Quaterniond const& right) {
+    return left.vec4.ExactlyEqual(right.vec4);
+}
+
+// Between float and double. ToFloat rounds each component to the nearest float.
+XO_INL Vector3d ToDouble(Vector3 const& v) { return Vector3d(v.x, v.y, v.z); }
+XO_INL Vector4d ToDouble(Vector4 const& v) { return Vector4d(v.x, v.y, v.z, v.w); }
+XO_INL Matrix4x4d ToDouble(Matrix4x4 const& m) { return Generic(m).Cast<double>(); }
+XO_INL Quaterniond ToDouble(Quaternion const& q) { return Quaterniond(q); }
+XO_INL Vector3 ToFloat(Vector3d const& v) { return ToVector3(v.Cast<float>()); }
+XO_INL Vector4 ToFloat(Vector4d const& v) { return ToVector4(v.Cast<float>()); }
+XO_INL Matrix4x4 ToFloat(Matrix4x4d const& m) { return ToMatrix4x4(m.Cast<float>()); }
+XO_INL Quaternion ToFloat(Quaterniond const& q) { return q.ToFloat(); }
+
+// position - origin as a float vector, subtracted in double first.
+XO_INL Vector3 RelativeTo(Vector3d const& position, Vector3d const& origin) {
+    return ToFloat(position - origin);
+}
+} // ::xo
@@ -0,0 +1,255 @@
+#pragma once
+#include <inttypes.h>
+#include "xo-math-macros.h"
+#include "xo-math-utilities.h"
+// $inline_begin
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+namespace xo {
+//////////////////////////////////////////////////////////////////////////////////////////
+// Vector<N, T, Align> and Matrix<R, C, T, Align> for any size and any arithmetic T.
+// Everything short of a square root is constexpr, and the per component work is expanded
+// over an index sequence rather than looped, so vectors and matrices built from constants
+// fold away entirely:
+//
+//     constexpr Matrix<3, 3, float> m(Vector<3, float>(0.f, -1.f, 0.f),
+//                                     Vector<3, float>(1.f,  0.f, 0.f),
+//                                     Vector<3, float>(0.f,  0.f, 1.f));
+//     static_assert((m * m.Transposed()).ExactlyEqual(Matrix<3, 3, float>::Identity()), "");
+//
+// They sit beside Vector3, Vector4 and Matrix4x4 instead of replacing them, those keep
+// their SSE layouts and A types. The memory layout is the same though: Vector<3, float> is
+// three floats like Vector3 and Matrix<4, 4, float> is 16 row major floats like Matrix4x4,
+// see Generic() and the To functions at the end.
+// Matrices work on column vectors like Matrix4x4::Transform: Transform(v) is the dot
+// product of each row with v.
+
+template<int N, typename T, size_t Align = alignof(T)>
+struct alignas(Align) Vector {
+    static_assert(N > 0, "xo::Vector needs at least one component");
+    typedef T Scalar;
+    static constexpr int Size = N;
+
+    T v[N];
+
+    Vector() = default;
+    constexpr explicit Vector(T all) : Vector(all, std::make_index_sequence<N>()) { }
+    // One value per component.
+    template<typename... A, typename = typename std::enable_if<sizeof...(A) == N && (N > 1)>::type>
+    constexpr Vector(A... components) : v{ static_cast<T>(components)... } { }
+
+    constexpr T const& operator [] (int i) const { return v[i]; }
+    constexpr T& operator [] (int i) { return v[i]; }
+    // v.x() through v.w() are v[0] through v[3], as far as N goes. Functions rather than a
+    // union with Vector3's x, y and z members, which constant expressions couldn't read.
+    constexpr T const& x() const { return v[0]; }
+    constexpr T& x() { return v[0]; }
+    template<int M = N, typename = typename std::enable_if<(M > 1)>::type> constexpr T const& y() const { return v[1]; }
+    template<int M = N, typename = typename std::enable_if<(M > 1)>::type> constexpr T& y() { return v[1]; }
+    template<int M = N, typename = typename std::enable_if<(M > 2)>::type> constexpr T const& z() const { return v[2]; }
+    template<int M = N, typename = typename std::enable_if<(M > 2)>::type> constexpr T& z() { return v[2]; }
+    template<int M = N, typename = typename std::enable_if<(M > 3)>::type> constexpr T const& w() const { return v[3]; }
+    template<int M = N, typename = typename std::enable_if<(M > 3)>::type> constexpr T& w() { return v[3]; }
+
+    constexpr Vector operator + (Vector const& o) const { return Map(*this, o, std::plus<T>()); }
+    constexpr Vector operator - (Vector const& o) const { return Map(*this, o, std::minus<T>()); }
+    constexpr Vector operator * (Vector const& o) const { return Map(*this, o, std::multiplies<T>()); }
+    constexpr Vector operator / (Vector const& o) const { return Map(*this, o, std::divides<T>()); }
+    constexpr Vector operator * (T s) const { return *this * Vector(s); }
+    constexpr Vector operator / (T s) const { return *this / Vector(s); }
+    constexpr Vector operator - () const { return Vector(T(0)) - *this; }
+    constexpr Vector& operator += (Vector const& o) { return *this = *this + o; }
+    constexpr Vector& operator -= (Vector const& o) { return *this = *this - o; }
+    constexpr Vector& operator *= (Vector const& o) { return *this = *this * o; }
+    constexpr Vector& operator /= (Vector const& o) { return *this = *this / o; }
+    constexpr Vector& operator *= (T s) { return *this = *this * s; }
+    constexpr Vector& operator /= (T s) { return *this = *this / s; }
+
+    constexpr T Sum() const {
+        T sum = v[0];
+        for (int i = 1; i < N; ++i) sum += v[i];
+        return sum;
+    }
+    constexpr T MagnitudeSquared() const { return DotProduct(*this, *this); }
+    T Magnitude() const { return static_cast<T>(std::sqrt(MagnitudeSquared())); }
+    Vector Normalized() const { return *this / Magnitude(); }
+
+    // The same vector with each component converted to U.
+    template<typename U, size_t UAlign = alignof(U)>
+    constexpr Vector<N, U, UAlign> Cast() const { return Cast<U, UAlign>(std::make_index_sequence<N>()); }
+
+    constexpr bool ExactlyEqual(Vector const& o) const {
+        for (int i = 0; i < N; ++i) if (!(v[i] == o.v[i])) return false;
+        return true;
+    }
+    // Each component within CloseEnough of the other, exact for integer T.
+    constexpr bool RoughlyEqual(Vector const& o) const {
+        for (int i = 0; i < N; ++i) {
+            T const epsilon = std::numeric_limits<T>::epsilon() * xo::Max(T(1), Abs(v[i]), Abs(o.v[i]));
+            if (!(Abs(v[i] - o.v[i]) <= epsilon)) return false;
+        }
+        return true;
+    }
+    constexpr bool operator == (Vector const& o) const { return ExactlyEqual(o); }
+    constexpr bool operator != (Vector const& o) const { return !ExactlyEqual(o); }
+
+    static constexpr T DotProduct(Vector const& left, Vector const& right) { return (left * right).Sum(); }
+    template<int M = N, typename = typename std::enable_if<M == 3>::type>
+    static constexpr Vector CrossProduct(Vector const& l, Vector const& r) {
+        return Vector(l.v[1] * r.v[2] - l.v[2] * r.v[1],
+                      l.v[2] * r.v[0] - l.v[0] * r.v[2],
+                      l.v[0] * r.v[1] - l.v[1] * r.v[0]);
+    }
+    static constexpr Vector Lerp(Vector const& start, Vector const& end, T t) { return start + (end - start) * t; }
+    static constexpr Vector Min(Vector const& a, Vector const& b) { return Map(a, b, MinOp()); }
+    static constexpr Vector Max(Vector const& a, Vector const& b) { return Map(a, b, MaxOp()); }
+    // Component i is 1, the rest 0.
+    static constexpr Vector Unit(int i) { return Unit(i, std::make_index_sequence<N>()); }
+    static constexpr Vector Zero() { return Vector(T(0)); }
+
+private:
+    struct MinOp { constexpr T operator () (T a, T b) const { return xo::Min(a, b); } };
+    struct MaxOp { constexpr T operator () (T a, T b) const { return xo::Max(a, b); } };
+
+    template<size_t... I>
+    constexpr Vector(T all, std::index_sequence<I...>) : v{ (static_cast<void>(I), all)... } { }
+
+    template<typename Op, size_t... I>
+    static constexpr Vector Map(Vector const& l, Vector const& r, Op op, std::index_sequence<I...>) {
+        return Vector(static_cast<T>(op(l.v[I], r.v[I]))...);
+    }
+    template<typename Op>
+    static constexpr Vector Map(Vector const& l, Vector const& r, Op op) {
+        return Map(l, r, op, std::make_index_sequence<N>());
+    }
+    template<size_t... I>
+    static constexpr Vector Unit(int i, std::index_sequence<I...>) {
+        return Vector((int(I) == i ? T(1) : T(0))...);
+    }
+    template<typename U, size_t UAlign, size_t... I>
+    constexpr Vector<N, U, UAlign> Cast(std::index_sequence<I...>) const {
+        return Vector<N, U, UAlign>(static_cast<U>(v[I])...);
+    }
+};
+
+template<int N, typename T, size_t Align>
+constexpr Vector<N, T, Align> operator * (T s, Vector<N, T, Align> const& v) { return v * s; }
+
+//////////////////////////////////////////////////////////////////////////////////////////
+template<int R, int C, typename T, size_t Align = alignof(T)>
+struct alignas(Align) Matrix {
+    typedef Vector<C, T> Row;
+    typedef Vector<R, T> Column;
+    typedef T Scalar;
+    static constexpr int Rows = R;
+    static constexpr int Columns = C;
+
+    Row rows[R];
+
+    Matrix() = default;
+    // One Row per row.
+    template<typename... A, typename = typename std::enable_if<sizeof...(A) == R>::type>
+    constexpr Matrix(A const&... r) : rows{ Row(r)... } { }
+
+    constexpr Row const& operator [] (int row) const { return rows[row]; }
+    constexpr Row& operator [] (int row) { return rows[row]; }
+    constexpr Column GetColumn(int column) const { return GetColumn(column, std::make_index_sequence<R>()); }
+
+    constexpr Matrix operator + (Matrix const& o) const { return Map(o, std::plus<Row>()); }
+    constexpr Matrix operator - (Matrix const& o) const { return Map(o, std::minus<Row>()); }
+    constexpr Matrix operator * (T s) const { return Map(*this, ScaleOp{ s }); }
+
+    template<int K, size_t OAlign>
+    constexpr Matrix<R, K, T, Align> operator * (Matrix<C, K, T, OAlign> const& o) const {
+        return Multiply(o, std::make_index_sequence<R>());
+    }
+    template<size_t OAlign>
+    constexpr Matrix& operator *= (Matrix<C, C, T, OAlign> const& o) { return *this = *this * o; }
+
+    // The dot product of each row with v.
+    constexpr Column Transform(Row const& v) const { return Transform(v, std::make_index_sequence<R>()); }
+
+    constexpr Matrix<C, R, T, Align> Transposed() const { return Transposed(std::make_index_sequence<C>()); }
+
+    // The same matrix with each element converted to U.
+    template<typename U, size_t UAlign = alignof(U)>
+    constexpr Matrix<R, C, U, UAlign> Cast() const { return Cast<U, UAlign>(std::make_index_sequence<R>()); }
+
+    constexpr bool ExactlyEqual(Matrix const& o) const {
+        for (int i = 0; i < R; ++i) if (!rows[i].ExactlyEqual(o.rows[i])) return false;
+        return true;
+    }
+    constexpr bool RoughlyEqual(Matrix const& o) const {
+        for (int i = 0; i < R; ++i) if (!rows[i].RoughlyEqual(o.rows[i])) return false;
+        return true;
+    }
+    constexpr bool operator == (Matrix const& o) const { return ExactlyEqual(o); }
+    constexpr bool operator != (Matrix const& o) const { return !ExactlyEqual(o); }
+
+    template<int M = R, typename = typename std::enable_if<M == C>::type>
+    static constexpr Matrix Identity() { return Identity(std::make_index_sequence<R>()); }
+
+private:
+    struct ScaleOp { T s; constexpr Row operator () (Row const& r, Row const&) const { return r * s; } };
+
+    template<typename Op, size_t... I>
+    constexpr Matrix Map(Matrix const& o, Op op, std::index_sequence<I...>) const {
+        return Matrix(op(rows[I], o.rows[I])...);
+    }
+    template<typename Op>
+    constexpr Matrix Map(Matrix const& o, Op op) const { return Map(o, op, std::make_index_sequence<R>()); }
+
+    // Row 'row' of this times o: o's rows weighted by this row's components.
+    template<int K, size_t OAlign>
+    static constexpr Vector<K, T> RowTimes(Row const& row, Matrix<C, K, T, OAlign> const& o) {
+        Vector<K, T> sum = o.rows[0] * row.v[0];
+        for (int j = 1; j < C; ++j) sum += o.rows[j] * row.v[j];
+        return sum;
+    }
+    template<int K, size_t OAlign, size_t... I>
+    constexpr Matrix<R, K, T, Align> Multiply(Matrix<C, K, T, OAlign> const& o, std::index_sequence<I...>) const {
+        return Matrix<R, K, T, Align>(RowTimes(rows[I], o)...);
+    }
+    template<size_t... I>
+    constexpr Column Transform(Row const& v, std::index_sequence<I...>) const {
+        return Column(Row::DotProduct(rows[I], v)...);
+    }
+    template<size_t... I>
+    constexpr Column GetColumn(int column, std::index_sequence<I...>) const {
+        return Column(rows[I].v[column]...);
+    }
+    template<size_t... I>
+    constexpr Matrix<C, R, T, Align> Transposed(std::index_sequence<I...>) const {
+        return Matrix<C, R, T, Align>(GetColumn(int(I))...);
+    }
+    template<size_t... I>
+    static constexpr Matrix Identity(std::index_sequence<I...>) { return Matrix(Row::Unit(int(I))...); }
+    template<typename U, size_t UAlign, size_t... I>
+    constexpr Matrix<R, C, U, UAlign> Cast(std::index_sequence<I...>) const {
+        return Matrix<R, C, U, UAlign>(rows[I].template Cast<U>()...);
+    }
+};
+
+template<int R, int C, typename T, size_t Align>
+constexpr Matrix<R, C, T, Align> operator * (T s, Matrix<R, C, T, Align> const& m) { return m * s; }
+
+typedef Vector<2, float> Vector2f;
+typedef Vector<2, int32_t> Vector2i;
+typedef Vector<3, int32_t> Vector3i;
+typedef Vector<4, int32_t> Vector4i;
+
+// Between the generic float types and the SSE or reference ones.
+XO_INL Vector<3, float> Generic(Vector3 const& v) { return Vector<3, float>(v.x, v.y, v.z); }
+XO_INL Vector<4, float> Generic(Vector4 const& v) { return Vector<4, float>(v.x, v.y, v.z, v.w); }
+XO_INL Matrix<4, 4, float> Generic(Matrix4x4 const& m) {
+    return Matrix<4, 4, float>(Generic(m.rows[0]), Generic(m.rows[1]), Generic(m.rows[2]), Generic(m.rows[3]));
+}
+XO_INL Vector3 ToVector3(Vector<3, float> const& v) { return Vector3(v.v[0], v.v[1], v.v[2]); }
+XO_INL Vector4 ToVector4(Vector<4, float> const& v) { return Vector4(v.v[0], v.v[1], v.v[2], v.v[3]); }
+XO_INL Matrix4x4 ToMatrix4x4(Matrix<4, 4, float> const& m) {
+    return Matrix4x4(ToVector4(m.rows[0]), ToVector4(m.rows[1]), ToVector4(m.rows[2]), ToVector4(m.rows[3]));
+}
+} // ::xo
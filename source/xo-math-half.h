@@ -0,0 +1,109 @@
+#pragma once
+#include <inttypes.h>
+#include "xo-math-macros.h"
+#include "xo-math-utilities.h"
+// $inline_begin
+namespace xo {
+//////////////////////////////////////////////////////////////////////////////////////////
+// IEEE half precision (fp16) storage for normals, tangents, velocities and anything else
+// where 11 bits of precision are enough and memory traffic isn't. There's no half math,
+// convert to Vector3 or Vector4, work in floats and convert back. Whole arrays convert
+// with batch::ToHalf and batch::FromHalf, 8 or 16 at a time with F16C.
+// Conversions round to nearest even like F16C does. Floats past 65504 become infinity and
+// ones under 2^-24 become zero, NaNs stay NaN.
+
+uint16_t FloatToHalf(float value);
+float HalfToFloat(uint16_t half);
+
+struct Half3 {
+    uint16_t x, y, z;
+
+    Half3() = default;
+    explicit Half3(Vector3 const& v);
+
+    Vector3 ToVector3() const;
+};
+
+struct Half4 {
+    uint16_t x, y, z, w;
+
+    Half4() = default;
+    explicit Half4(Vector4 const& v);
+
+    Vector4 ToVector4() const;
+};
+
+XO_INL
+uint16_t FloatToHalf(float value) {
+    // See: https://gist.github.com/rygorous/2156668
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint32_t const sign = (bits >> 16) & 0x8000u;
+    bits &= 0x7FFFFFFFu;
+    if (bits >= (143u << 23)) {
+        // 2^16 and up is infinity, NaNs keep the top of their payload and become quiet.
+        return static_cast<uint16_t>(sign | (bits > 0x7F800000u ? 0x7E00u | ((bits >> 13) & 0x3FFu) : 0x7C00u));
+    }
+    if (bits < (113u << 23)) {
+        // Under 2^-14 the half is subnormal: adding 0.5 lines the 10 bits it keeps up with
+        // the bottom of the float mantissa, and the add rounds them.
+        float const magic = 0.5f;
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        f += magic;
+        std::memcpy(&bits, &f, sizeof(bits));
+        return static_cast<uint16_t>(sign | (bits - (126u << 23)));
+    }
+    // Rebias the exponent and round the 13 dropped bits to nearest even. A carry out of
+    // the mantissa bumps the exponent, up to infinity past 65504.
+    bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xFFFu + ((bits >> 13) & 1u);
+    return static_cast<uint16_t>(sign | (bits >> 13));
+}
+
+XO_INL
+float HalfToFloat(uint16_t half) {
+    uint32_t bits = (half & 0x7FFFu) << 13;
+    uint32_t const exponent = bits & (0x7C00u << 13);
+    bits += static_cast<uint32_t>(127 - 15) << 23;
+    if (exponent == (0x7C00u << 13)) {
+        bits += static_cast<uint32_t>(128 - 16) << 23;   // infinity and NaN
+    }
+    else if (exponent == 0) {
+        // Subnormal or zero: make it 2^-14 + m * 2^-24 and take the 2^-14 off again.
+        bits += 1u << 23;
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        f -= 6.103515625e-05f;
+        std::memcpy(&bits, &f, sizeof(bits));
+    }
+    bits |= static_cast<uint32_t>(half & 0x8000u) << 16;
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+XO_INL
+Half3::Half3(Vector3 const& v)
+    : x(FloatToHalf(v.x))
+    , y(FloatToHalf(v.y))
+    , z(FloatToHalf(v.z))
+{ }
+
+XO_INL
+Vector3 Half3::ToVector3() const {
+    return Vector3(HalfToFloat(x), HalfToFloat(y), HalfToFloat(z));
+}
+
+XO_INL
+Half4::Half4(Vector4 const& v)
+    : x(FloatToHalf(v.x))
+    , y(FloatToHalf(v.y))
+    , z(FloatToHalf(v.z))
+    , w(FloatToHalf(v.w))
+{ }
+
+XO_INL
+Vector4 Half4::ToVector4() const {
+    return Vector4(HalfToFloat(x), HalfToFloat(y), HalfToFloat(z), HalfToFloat(w));
+}
+} // ::xo
@@ -0,0 +1,179 @@
+#pragma once
+#include <inttypes.h>
+#include "xo-math-macros.h"
+#include "xo-math-detect-simd.h"
+#include "xo-math-wide.h"
+// $inline_begin
+#include <type_traits>
+namespace xo { namespace lazy {
+// Expression templates over Vector3 and Vector4, opt in: nothing else in xo-math uses them.
+// Wrap the operands with Of() and +, -, * and / build a tree instead of doing any math.
+// Evaluate then runs the whole tree once per component, so there are no Vector3
+// temporaries in between and scalars stay floats instead of becoming Vector3(value).
+//
+//     Vector3 p = lazy::Evaluate(lazy::Of(a) + (lazy::Of(b) - lazy::Of(a)) * t + lazy::Of(c) * s);
+//
+// Over arrays the components are evaluated as one flat run of floats, Width at a time in a
+// FloatN<Width>, so the whole expression is a single loop.
+//
+//     lazy::Evaluate(lazy::Of(positions, count) + lazy::Of(velocities, count) * dt, positions);
+//
+// Arrays and single vectors can't be mixed in one expression, and every array needs the
+// same count. Nodes hold references to their operands, build and evaluate in one statement.
+
+// FloatN<Width> is the widest register the build targets.
+#if XO_SSE_CURRENT >= XO_AVX512
+constexpr int Width = 16;
+#elif XO_SSE_CURRENT >= XO_AVX || XO_HAS_FMA
+constexpr int Width = 8;
+#elif XO_HAS_SSE
+constexpr int Width = 4;
+#else
+constexpr int Width = 8;
+#endif
+
+template<typename V> struct Components;
+template<> struct Components<Vector3> { static constexpr int value = 3; };
+template<> struct Components<Vector4> { static constexpr int value = 4; };
+
+XO_INL float const* Floats(Vector3 const& v) { return &v.x; }
+XO_INL float* Floats(Vector3& v) { return &v.x; }
+XO_INL float const* Floats(Vector4 const& v) { return v.v; }
+XO_INL float* Floats(Vector4& v) { return v.v; }
+
+// Every node has a Value (the vector type it produces, void for a scalar), IsArray, the
+// array length as Count() (0 when it isn't an array), At(k) for flat component k and
+// Block<F>(k) for the F::Load of components k onwards.
+template<typename T> struct IsNode : std::false_type { };
+
+template<typename V>
+struct Ref {
+    typedef V Value;
+    static constexpr bool IsArray = false;
+    V const& v;
+
+    size_t Count() const { return 0; }
+    XO_INL float At(size_t k) const { return Floats(v)[k]; }
+};
+
+template<typename V>
+struct Span {
+    typedef V Value;
+    static constexpr bool IsArray = true;
+    V const* data;
+    size_t count;
+
+    size_t Count() const { return count; }
+    XO_INL float At(size_t k) const { return Floats(*data)[k]; }
+    template<typename F> XO_INL F Block(size_t k) const { return F::Load(Floats(*data) + k); }
+};
+
+struct Scalar {
+    typedef void Value;
+    static constexpr bool IsArray = false;
+    float s;
+
+    size_t Count() const { return 0; }
+    XO_INL float At(size_t) const { return s; }
+    template<typename F> XO_INL F Block(size_t) const { return F(s); }
+};
+
+struct Add      { template<typename T> static XO_INL T Apply(T const& l, T const& r) { return l + r; } };
+struct Subtract { template<typename T> static XO_INL T Apply(T const& l, T const& r) { return l - r; } };
+struct Multiply { template<typename T> static XO_INL T Apply(T const& l, T const& r) { return l * r; } };
+struct Divide   { template<typename T> static XO_INL T Apply(T const& l, T const& r) { return l / r; } };
+
+template<typename L, typename R>
+struct BinaryValue {
+    static_assert(std::is_void<typename L::Value>::value || std::is_void<typename R::Value>::value ||
+                  std::is_same<typename L::Value, typename R::Value>::value,
+                  "xo::lazy can't mix Vector3 and Vector4 operands");
+    static_assert(std::is_void<typename L::Value>::value || std::is_void<typename R::Value>::value ||
+                  L::IsArray == R::IsArray,
+                  "xo::lazy can't mix arrays and single vectors");
+    typedef typename std::conditional<std::is_void<typename L::Value>::value,
+                                      typename R::Value, typename L::Value>::type type;
+};
+
+template<typename Op, typename L, typename R>
+struct Binary {
+    typedef typename BinaryValue<L, R>::type Value;
+    static constexpr bool IsArray = L::IsArray || R::IsArray;
+    L l;
+    R r;
+
+    size_t Count() const { return L::IsArray ? l.Count() : r.Count(); }
+    XO_INL float At(size_t k) const { return Op::Apply(l.At(k), r.At(k)); }
+    template<typename F> XO_INL F Block(size_t k) const {
+        return Op::Apply(l.template Block<F>(k), r.template Block<F>(k));
+    }
+};
+
+template<typename E>
+struct Negate {
+    typedef typename E::Value Value;
+    static constexpr bool IsArray = E::IsArray;
+    E e;
+
+    size_t Count() const { return e.Count(); }
+    XO_INL float At(size_t k) const { return -e.At(k); }
+    template<typename F> XO_INL F Block(size_t k) const { return -e.template Block<F>(k); }
+};
+
+template<typename V> struct IsNode<Ref<V>> : std::true_type { };
+template<typename V> struct IsNode<Span<V>> : std::true_type { };
+template<> struct IsNode<Scalar> : std::true_type { };
+template<typename Op, typename L, typename R> struct IsNode<Binary<Op, L, R>> : std::true_type { };
+template<typename E> struct IsNode<Negate<E>> : std::true_type { };
+
+template<typename V> XO_INL Ref<V> Of(V const& v) { return Ref<V>{ v }; }
+template<typename V> XO_INL Span<V> Of(V const* v, size_t count) { return Span<V>{ v, count }; }
+
+// node op node, node op float and float op node.
+#define XO_LAZY_OPERATOR(op, Op) \
+    template<typename L, typename R, \
+             typename = typename std::enable_if<IsNode<L>::value && IsNode<R>::value>::type> \
+    XO_INL Binary<Op, L, R> operator op (L const& l, R const& r) { return Binary<Op, L, R>{ l, r }; } \
+    template<typename L, typename = typename std::enable_if<IsNode<L>::value>::type> \
+    XO_INL Binary<Op, L, Scalar> operator op (L const& l, float r) { return Binary<Op, L, Scalar>{ l, Scalar{ r } }; } \
+    template<typename R, typename = typename std::enable_if<IsNode<R>::value>::type> \
+    XO_INL Binary<Op, Scalar, R> operator op (float l, R const& r) { return Binary<Op, Scalar, R>{ Scalar{ l }, r }; }
+
+XO_LAZY_OPERATOR(+, Add)
+XO_LAZY_OPERATOR(-, Subtract)
+XO_LAZY_OPERATOR(*, Multiply)
+XO_LAZY_OPERATOR(/, Divide)
+#undef XO_LAZY_OPERATOR
+
+template<typename E, typename = typename std::enable_if<IsNode<E>::value>::type>
+XO_INL Negate<E> operator - (E const& e) { return Negate<E>{ e }; }
+
+// The vector an expression over single vectors comes to.
+template<typename E>
+XO_INL typename E::Value Evaluate(E const& e) {
+    static_assert(!E::IsArray, "xo::lazy::Evaluate(e) is for single vectors, pass an output array");
+    typedef typename E::Value V;
+    V result;
+    float* out = Floats(result);
+    for (int k = 0; k < Components<V>::value; ++k) {
+        out[k] = e.At(k);
+    }
+    return result;
+}
+
+// Writes an expression over arrays to out, which may be one of the arrays in it.
+template<typename E>
+XO_INL void Evaluate(E const& e, typename E::Value* out) {
+    static_assert(E::IsArray, "xo::lazy::Evaluate(e, out) is for arrays");
+    typedef FloatN<Width> F;
+    size_t const floats = e.Count() * Components<typename E::Value>::value;
+    float* o = Floats(*out);
+    size_t k = 0;
+    for (; k + Width <= floats; k += Width) {
+        e.template Block<F>(k).Store(o + k);
+    }
+    for (; k < floats; ++k) {
+        o[k] = e.At(k);
+    }
+}
+} } // ::xo::lazy
@@ -1,8 +1,12 @@
 #pragma once
 #include <inttypes.h>
 // $inline_begin
-#include <new.h>
+#include <cstddef>
 #include <cstdlib>
+#include <new>
+#if defined(_MSC_VER) || defined(__MINGW32__)
+#   include <malloc.h>
+#endif
 // xo-math calling convention.
 // See License in third-party-licenses.h for https://github.com/Microsoft/DirectXMath
 // applies to the exact version checking for __vectorcall
@@ -22,18 +26,51 @@
 #endif
 
 #define XO_ALN_16               alignas(16)
-#define XO_ALN_16_MALLOC(size)  _aligned_malloc(size, 16)
-#define XO_ALN_16_FREE(mem)     free(mem)
+#define XO_ALN_16_MALLOC(size)  xo::AlignedMalloc(size, 16)
+#define XO_ALN_16_FREE(mem)     xo::AlignedFree(mem)
+
+namespace xo {
+// 'size' bytes aligned to 'alignment', a power of two, or nullptr when out of memory.
+// Free it with AlignedFree, never free() or delete.
+XO_INL void* AlignedMalloc(size_t size, size_t alignment) {
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    return _aligned_malloc(size ? size : 1, alignment);
+#else
+    // posix_memalign wants at least pointer alignment, and a unique pointer for size 0.
+    void* memory = nullptr;
+    alignment = alignment < sizeof(void*) ? sizeof(void*) : alignment;
+    return posix_memalign(&memory, alignment, size ? size : 1) == 0 ? memory : nullptr;
+#endif
+}
+
+XO_INL void AlignedFree(void* memory) {
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    _aligned_free(memory);
+#else
+    free(memory);
+#endif
+}
+
+// AlignedMalloc for operator new: throws std::bad_alloc instead of returning nullptr.
+XO_INL void* AlignedNew(size_t size, size_t alignment) {
+    void* memory = AlignedMalloc(size, alignment);
+    if (!memory) throw std::bad_alloc();
+    return memory;
+}
+} // ::xo
 
-// will never call a constructor, as it's intended for our math types...
+// Class operators new and delete for the A types, whose alignment plain new doesn't
+// guarantee before C++17. 'size' is in bytes for both forms, for arrays it's the whole
+// block. The placement forms are here because declaring any operator new in a class hides
+// the global ones.
 #define XO_NEW_DEL_16(typeName) \
-    void* operator new(size_t count) { \
-        void* m = XO_ALN_16_MALLOC(count); \
-        return static_cast<typeName*>(m); \
-    } \
-    void* operator new[](size_t count) { \
-        void* m = XO_ALN_16_MALLOC(count*sizeof(typeName)); \
-        return static_cast<typeName*>(m); \
-    } 
+    static void* operator new(size_t size) { return xo::AlignedNew(size, 16); } \
+    static void* operator new[](size_t size) { return xo::AlignedNew(size, 16); } \
+    static void* operator new(size_t, void* where) noexcept { return where; } \
+    static void* operator new[](size_t, void* where) noexcept { return where; } \
+    static void operator delete(void* memory) noexcept { xo::AlignedFree(memory); } \
+    static void operator delete[](void* memory) noexcept { xo::AlignedFree(memory); } \
+    static void operator delete(void*, void*) noexcept { } \
+    static void operator delete[](void*, void*) noexcept { }
 
 #define XO_UNUSED(code) (void)code
\ No newline at end of file
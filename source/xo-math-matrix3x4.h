@@ -0,0 +1,178 @@
+#pragma once
+#include <inttypes.h>
+#include "xo-math-macros.h"
+#include "xo-math-utilities.h"
+// $inline_begin
+namespace xo {
+//////////////////////////////////////////////////////////////////////////////////////////
+// An affine transform in 12 floats: a Matrix4x4 whose last column is (0, 0, 0, 1), which
+// is what Translation, Scale, the Rotation functions and LookAt build.
+// It's stored transposed, rows[i] is column i of that Matrix4x4. Each row is then a
+// Vector4 whose dot product with (p, 1) gives one component of the transformed point, and
+// the translation is (rows[0].w, rows[1].w, rows[2].w).
+// Points are row vectors like they are for Translation: p' = p * M, so a * b is a then b,
+// the same order as the Matrix4x4 product of the two.
+struct Matrix3x4 {
+    union {
+        Vector4 rows[3];
+        float v[12];
+    };
+
+    constexpr Matrix3x4(Vector4 const& row0,
+                        Vector4 const& row1,
+                        Vector4 const& row2)
+        : rows{
+            row0,
+            row1,
+            row2 }
+    { }
+
+    // Drops the last column of matrix, which should be (0, 0, 0, 1).
+    explicit Matrix3x4(Matrix4x4 const& matrix);
+
+    Matrix3x4() = default;
+    ~Matrix3x4() = default;
+    Matrix3x4(Matrix3x4 const& other) = default;
+    Matrix3x4(Matrix3x4&& ref) = default;
+    Matrix3x4& operator = (Matrix3x4 const& other) = default;
+    Matrix3x4& operator = (Matrix3x4&& ref) = default;
+
+    Matrix4x4 XO_CC ToMatrix4x4() const;
+
+    Vector3 XO_CC TransformPoint(Vector3 const& point) const;
+    Vector3 XO_CC TransformDirection(Vector3 const& direction) const;
+    Vector3 XO_CC GetTranslation() const;
+
+    Matrix3x4 XO_CC operator * (Matrix3x4 const& other) const;
+    Matrix3x4& XO_CC operator *= (Matrix3x4 const& other);
+
+    static Matrix3x4 XO_CC Invert(Matrix3x4 const& matrixIn);
+    // Scale, then rotate, then translate. The same matrix as
+    // Matrix4x4::Scale(scale) * R * Matrix4x4::Translation(translation), where R is
+    // Matrix4x4::RotationAxisAngle(axis, angle) for Quaternion::RotationAxisAngle(axis, angle).
+    // rotation should be normalized.
+    static Matrix3x4 XO_CC FromTRS(Vector3 const& translation,
+                                   Quaternion const& rotation,
+                                   Vector3 const& scale);
+    static bool XO_CC RoughlyEqual(Matrix3x4 const& left, Matrix3x4 const& right);
+    static bool XO_CC ExactlyEqual(Matrix3x4 const& left, Matrix3x4 const& right);
+
+    static const Matrix3x4 Identity;
+};
+
+#if defined(XO_MATH_IMPL)
+/*static*/ const Matrix3x4 Matrix3x4::Identity(
+    Vector4(1.f, 0.f, 0.f, 0.f),
+    Vector4(0.f, 1.f, 0.f, 0.f),
+    Vector4(0.f, 0.f, 1.f, 0.f));
+#endif
+
+XO_INL
+Matrix3x4::Matrix3x4(Matrix4x4 const& matrix)
+    : rows{
+        Vector4(matrix.v[0], matrix.v[4], matrix.v[8], matrix.v[12]),
+        Vector4(matrix.v[1], matrix.v[5], matrix.v[9], matrix.v[13]),
+        Vector4(matrix.v[2], matrix.v[6], matrix.v[10], matrix.v[14]) }
+{ }
+
+XO_INL
+Matrix4x4 XO_CC Matrix3x4::ToMatrix4x4() const {
+    return Matrix4x4(
+        Vector4(v[0], v[4], v[8],  0.f),
+        Vector4(v[1], v[5], v[9],  0.f),
+        Vector4(v[2], v[6], v[10], 0.f),
+        Vector4(v[3], v[7], v[11], 1.f));
+}
+
+XO_INL
+Vector3 XO_CC Matrix3x4::TransformPoint(Vector3 const& point) const {
+    Vector4 p(point.x, point.y, point.z, 1.f);
+    return Vector3(Vector4::DotProduct(rows[0], p),
+                   Vector4::DotProduct(rows[1], p),
+                   Vector4::DotProduct(rows[2], p));
+}
+
+XO_INL
+Vector3 XO_CC Matrix3x4::TransformDirection(Vector3 const& direction) const {
+    Vector4 d(direction.x, direction.y, direction.z, 0.f);
+    return Vector3(Vector4::DotProduct(rows[0], d),
+                   Vector4::DotProduct(rows[1], d),
+                   Vector4::DotProduct(rows[2], d));
+}
+
+XO_INL
+Vector3 XO_CC Matrix3x4::GetTranslation() const {
+    return Vector3(v[3], v[7], v[11]);
+}
+
+XO_INL
+Matrix3x4 XO_CC Matrix3x4::operator * (Matrix3x4 const& other) const {
+    return Matrix3x4(*this) *= other;
+}
+
+XO_INL
+Matrix3x4& XO_CC Matrix3x4::operator *= (Matrix3x4 const& other) {
+    // Row i of the result is column i of the product: the rows of this weighted by
+    // other.rows[i], plus other's translation.
+    Vector4 const a0 = rows[0], a1 = rows[1], a2 = rows[2];
+    for (int i = 0; i < 3; ++i) {
+        Vector4 const& b = other.rows[i];
+        rows[i] = a0 * b.x + a1 * b.y + a2 * b.z + Vector4(0.f, 0.f, 0.f, b.w);
+    }
+    return *this;
+}
+
+/*static*/ XO_INL
+Matrix3x4 XO_CC Matrix3x4::Invert(Matrix3x4 const& matrixIn) {
+    // The 3x3 parts of rows are the rows of L transposed, with L the linear part of the
+    // Matrix4x4. The inverse wants the columns of L^-1 as rows: those are the rows of
+    // (L^T)^-1, whose columns are c0 = a1 x a2, c1 = a2 x a0 and c2 = a0 x a1 over
+    // a0 . c0. The translation t moves to -t * L^-1.
+    Vector3 a0(matrixIn.v[0], matrixIn.v[1], matrixIn.v[2]);
+    Vector3 a1(matrixIn.v[4], matrixIn.v[5], matrixIn.v[6]);
+    Vector3 a2(matrixIn.v[8], matrixIn.v[9], matrixIn.v[10]);
+    Vector3 c0 = Vector3::CrossProduct(a1, a2);
+    Vector3 c1 = Vector3::CrossProduct(a2, a0);
+    Vector3 c2 = Vector3::CrossProduct(a0, a1);
+    float invDet = 1.f / Vector3::DotProduct(a0, c0);
+    Vector3 g0 = Vector3(c0.x, c1.x, c2.x) * invDet;
+    Vector3 g1 = Vector3(c0.y, c1.y, c2.y) * invDet;
+    Vector3 g2 = Vector3(c0.z, c1.z, c2.z) * invDet;
+    Vector3 t = matrixIn.GetTranslation();
+    return Matrix3x4(
+        Vector4(g0.x, g0.y, g0.z, -Vector3::DotProduct(t, g0)),
+        Vector4(g1.x, g1.y, g1.z, -Vector3::DotProduct(t, g1)),
+        Vector4(g2.x, g2.y, g2.z, -Vector3::DotProduct(t, g2)));
+}
+
+/*static*/ XO_INL
+Matrix3x4 XO_CC Matrix3x4::FromTRS(Vector3 const& translation,
+                                   Quaternion const& rotation,
+                                   Vector3 const& scale) {
+    // Row i is column i of the rotation matrix of q, scaled per component, with the
+    // translation in w. No trig and no matrix products.
+    float x = rotation.i, y = rotation.j, z = rotation.k, w = rotation.r;
+    float x2 = x + x, y2 = y + y, z2 = z + z;
+    float xx = x * x2, yy = y * y2, zz = z * z2;
+    float xy = x * y2, xz = x * z2, yz = y * z2;
+    float wx = w * x2, wy = w * y2, wz = w * z2;
+    return Matrix3x4(
+        Vector4((1.f - (yy + zz)) * scale.x, (xy + wz) * scale.y, (xz - wy) * scale.z, translation.x),
+        Vector4((xy - wz) * scale.x, (1.f - (xx + zz)) * scale.y, (yz + wx) * scale.z, translation.y),
+        Vector4((xz + wy) * scale.x, (yz - wx) * scale.y, (1.f - (xx + yy)) * scale.z, translation.z));
+}
+
+/*static*/ XO_INL
+bool XO_CC Matrix3x4::RoughlyEqual(Matrix3x4 const& left, Matrix3x4 const& right) {
+    return Vector4::RoughlyEqual(left.rows[0], right.rows[0])
+        && Vector4::RoughlyEqual(left.rows[1], right.rows[1])
+        && Vector4::RoughlyEqual(left.rows[2], right.rows[2]);
+}
+
+/*static*/ XO_INL
+bool XO_CC Matrix3x4::ExactlyEqual(Matrix3x4 const& left, Matrix3x4 const& right) {
+    return Vector4::ExactlyEqual(left.rows[0], right.rows[0])
+        && Vector4::ExactlyEqual(left.rows[1], right.rows[1])
+        && Vector4::ExactlyEqual(left.rows[2], right.rows[2]);
+}
+} // ::xo
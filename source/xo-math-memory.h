@@ -0,0 +1,244 @@
+#pragma once
+#include <inttypes.h>
+#include "xo-math-macros.h"
+// $inline_begin
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <vector>
+namespace xo {
+//////////////////////////////////////////////////////////////////////////////////////////
+// Containers of the A types. std::allocator only has to honor alignof(max_align_t) before
+// C++17, so a std::vector<AVector4> or std::vector<AMatrix4x4> can hand out elements the
+// aligned loads fault on. AlignedVector is std::vector with an allocator that goes through
+// AlignedMalloc, at alignof(T) or more when asked for, say 64 to keep a run of matrices on
+// cache lines.
+//
+//     AlignedVector<AMatrix4x4> transforms(count);
+//     AlignedVector<Vector4, 64> particles;
+//
+// AlignedAllocator works with any other standard container too.
+//
+// For per frame scratch, like the skinning matrices or culling bounds a batch job needs
+// for one update, FrameArena hands out aligned runs of memory by bumping a pointer and
+// takes them all back with Reset. Pool<T> is the same for single objects freed one by one.
+// Neither is thread safe, each thread has its own with ThreadLocal(). Once warmed up they
+// go back to the heap only when a frame needs more than any frame before it.
+//
+//     FrameArena& arena = FrameArena::ThreadLocal();
+//     Matrix4x4* palette = arena.Allocate<Matrix4x4>(boneCount, 64);
+//     ...
+//     arena.Reset();   // at the end of the frame, palette is gone
+
+template<typename T, size_t Align = alignof(T)>
+class AlignedAllocator {
+public:
+    static_assert((Align & (Align - 1)) == 0, "xo::AlignedAllocator alignment must be a power of two");
+    static constexpr size_t Alignment = Align > alignof(T) ? Align : alignof(T);
+
+    typedef T value_type;
+    template<typename U> struct rebind { typedef AlignedAllocator<U, Align> other; };
+
+    AlignedAllocator() noexcept = default;
+    template<typename U>
+    AlignedAllocator(AlignedAllocator<U, Align> const&) noexcept { }
+
+    T* allocate(size_t count) {
+        if (count > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_alloc();
+        return static_cast<T*>(AlignedNew(count * sizeof(T), Alignment));
+    }
+
+    void deallocate(T* memory, size_t) noexcept {
+        AlignedFree(memory);
+    }
+};
+
+// Stateless, so any two of the same alignment can free each other's memory.
+template<typename T, typename U, size_t Align>
+XO_INL bool operator == (AlignedAllocator<T, Align> const&, AlignedAllocator<U, Align> const&) { return true; }
+template<typename T, typename U, size_t Align>
+XO_INL bool operator != (AlignedAllocator<T, Align> const&, AlignedAllocator<U, Align> const&) { return false; }
+
+template<typename T, size_t Align = alignof(T)>
+using AlignedVector = std::vector<T, AlignedAllocator<T, Align>>;
+
+class FrameArena {
+public:
+    static constexpr size_t DefaultBlockSize = 64 * 1024;
+
+    explicit FrameArena(size_t blockSize = DefaultBlockSize);
+    ~FrameArena();
+    FrameArena(FrameArena const&) = delete;
+    FrameArena& operator = (FrameArena const&) = delete;
+
+    // 'size' bytes aligned to 'alignment', a power of two. Never returns nullptr, throws
+    // std::bad_alloc when a new block can't be had.
+    void* Allocate(size_t size, size_t alignment = 16);
+
+    // 'count' default constructed Ts. Reset doesn't run destructors, so T has to be
+    // trivially destructible like the math types.
+    template<typename T>
+    T* Allocate(size_t count, size_t alignment = alignof(T));
+
+    // Takes back everything allocated, in O(1). The blocks are kept for reuse.
+    void Reset();
+
+    // This thread's arena.
+    static FrameArena& ThreadLocal();
+
+private:
+    struct Block {
+        Block* next;
+        size_t size;
+    };
+
+    // Block headers take a whole cache line so block data starts 64 byte aligned.
+    static constexpr size_t HeaderSize = 64;
+
+    void* AllocateSlow(size_t size, size_t alignment);
+
+    size_t blockSize;
+    Block* first;
+    Block* current;
+    size_t offset;
+};
+
+// Fixed size slots for one T. Free slots go on a list threaded through them, new ones
+// come out of a FrameArena, so Reset is O(1) here too.
+template<typename T, size_t Align = alignof(T)>
+class Pool {
+public:
+    static_assert(std::is_trivially_destructible<T>::value, "xo::Pool is for trivially destructible types");
+    static_assert((Align & (Align - 1)) == 0, "xo::Pool alignment must be a power of two");
+    static constexpr size_t Alignment = Align > alignof(T) ? Align : alignof(T);
+
+    explicit Pool(size_t slotsPerBlock = 256);
+
+    // A default constructed T.
+    T* Allocate();
+    void Free(T* item);
+    // Takes back every slot, freed or not.
+    void Reset();
+
+    static Pool& ThreadLocal();
+
+private:
+    struct Slot { Slot* next; };
+    static constexpr size_t SlotSize = ((sizeof(T) > sizeof(Slot) ? sizeof(T) : sizeof(Slot)) + Alignment - 1) & ~(Alignment - 1);
+
+    FrameArena arena;
+    Slot* freeSlots;
+};
+
+XO_INL
+FrameArena::FrameArena(size_t blockSize)
+    : blockSize(blockSize)
+    , first(nullptr)
+    , current(nullptr)
+    , offset(0)
+{ }
+
+inline
+FrameArena::~FrameArena() {
+    while (first) {
+        Block* next = first->next;
+        AlignedFree(first);
+        first = next;
+    }
+}
+
+XO_INL
+void* FrameArena::Allocate(size_t size, size_t alignment) {
+    if (current) {
+        uintptr_t const base = reinterpret_cast<uintptr_t>(current) + HeaderSize;
+        uintptr_t const at = (base + offset + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        if (at + size <= base + current->size) {
+            offset = at + size - base;
+            return reinterpret_cast<void*>(at);
+        }
+    }
+    return AllocateSlow(size, alignment);
+}
+
+template<typename T>
+XO_INL T* FrameArena::Allocate(size_t count, size_t alignment) {
+    static_assert(std::is_trivially_destructible<T>::value, "xo::FrameArena is for trivially destructible types");
+    if (count > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_alloc();
+    T* items = static_cast<T*>(Allocate(count * sizeof(T), alignment > alignof(T) ? alignment : alignof(T)));
+    for (size_t i = 0; i < count; ++i) {
+        ::new (static_cast<void*>(items + i)) T;
+    }
+    return items;
+}
+
+XO_INL
+void FrameArena::Reset() {
+    current = first;
+    offset = 0;
+}
+
+/*static*/ inline
+FrameArena& FrameArena::ThreadLocal() {
+    static thread_local FrameArena arena;
+    return arena;
+}
+
+inline
+void* FrameArena::AllocateSlow(size_t size, size_t alignment) {
+    // The next block kept from an earlier frame, if there is one and it's big enough.
+    Block* next = current ? current->next : first;
+    if (next && size + alignment <= next->size) {
+        current = next;
+        offset = 0;
+        return Allocate(size, alignment);
+    }
+    // Otherwise a new one goes in after current, sized for 'size' if it's a big one.
+    if (size > std::numeric_limits<size_t>::max() - HeaderSize - alignment) throw std::bad_alloc();
+    size_t const blockBytes = size + alignment > blockSize ? size + alignment : blockSize;
+    Block* block = static_cast<Block*>(AlignedNew(HeaderSize + blockBytes, HeaderSize));
+    block->size = blockBytes;
+    block->next = next;
+    (current ? current->next : first) = block;
+    current = block;
+    offset = 0;
+    return Allocate(size, alignment);
+}
+
+template<typename T, size_t Align>
+XO_INL Pool<T, Align>::Pool(size_t slotsPerBlock)
+    : arena(slotsPerBlock * SlotSize)
+    , freeSlots(nullptr)
+{ }
+
+template<typename T, size_t Align>
+XO_INL T* Pool<T, Align>::Allocate() {
+    void* memory;
+    if (freeSlots) {
+        memory = freeSlots;
+        freeSlots = freeSlots->next;
+    }
+    else {
+        memory = arena.Allocate(SlotSize, Alignment);
+    }
+    return ::new (memory) T;
+}
+
+template<typename T, size_t Align>
+XO_INL void Pool<T, Align>::Free(T* item) {
+    Slot* slot = ::new (static_cast<void*>(item)) Slot;
+    slot->next = freeSlots;
+    freeSlots = slot;
+}
+
+template<typename T, size_t Align>
+XO_INL void Pool<T, Align>::Reset() {
+    arena.Reset();
+    freeSlots = nullptr;
+}
+
+template<typename T, size_t Align>
+/*static*/ inline Pool<T, Align>& Pool<T, Align>::ThreadLocal() {
+    static thread_local Pool pool;
+    return pool;
+}
+} // ::xo
@@ -21,6 +21,9 @@
 #if !defined(XO_CONFIG_DEFAULT_FAR_PLANE)
 #   define XO_CONFIG_DEFAULT_FAR_PLANE 1000.f
 #endif
+#if !defined(XO_CONFIG_DEFAULT_PRECISION)
+#   define XO_CONFIG_DEFAULT_PRECISION xo::Precision::Exact
+#endif
 
 #define XO_REF_ALN                  XO_ALN_16
 #define XO_REF_NEW_DEL(typeName)    XO_NEW_DEL_16(typeName)
@@ -73,8 +76,8 @@ struct Vector3 {
     float Magnitude() const;
     float MagnitudeSquared() const;
 
-    Vector3& Normalize();
-    Vector3 Normalized() const;
+    Vector3& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+    Vector3 Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
 
     static bool XO_CC RoughlyEqual(Vector3 const& left, Vector3 const& right);
     static bool XO_CC ExactlyEqual(Vector3 const& left, Vector3 const& right);
@@ -158,8 +161,8 @@ struct Vector4 {
 
     float Magnitude() const;
     float MagnitudeSquared() const;
-    Vector4 Normalized() const;
-    Vector4& Normalize();
+    Vector4 Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+    Vector4& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
 
     static bool XO_CC RoughlyEqual(Vector4 const& left, Vector4 const& right);
     static bool XO_CC ExactlyEqual(Vector4 const& left, Vector4 const& right);
@@ -217,6 +220,29 @@ struct Matrix4x4 {
     Vector4 XO_CC Transform(Vector4 const& v4) const;
     Vector3 XO_CC InverseTransform(Vector3 const& v3) const;
     Vector4 XO_CC InverseTransform(Vector4 const& v4) const;
+
+    // Transforms 'count' vectors from in to out (which may be the same array). Points and
+    // directions are row vectors times the matrix, like InverseTransform and
+    // Matrix3x4::TransformPoint: points get the translation from rows[3], directions don't.
+    // Homogeneous is InverseTransform(Vector4), so a point with w = 1 comes out as from
+    // TransformPoints, and nothing divides by w. Strides are in bytes, for
+    // vectors that live inside larger structs. Runs 8 or 16 at a time with AVX2 or AVX512,
+    // see xo-math-batch.h.
+    void XO_CC TransformPoints(Vector3 const* in,
+                               Vector3* out,
+                               size_t count,
+                               size_t inStride = sizeof(Vector3),
+                               size_t outStride = sizeof(Vector3)) const;
+    void XO_CC TransformDirections(Vector3 const* in,
+                                   Vector3* out,
+                                   size_t count,
+                                   size_t inStride = sizeof(Vector3),
+                                   size_t outStride = sizeof(Vector3)) const;
+    void XO_CC TransformHomogeneous(Vector4 const* in,
+                                    Vector4* out,
+                                    size_t count,
+                                    size_t inStride = sizeof(Vector4),
+                                    size_t outStride = sizeof(Vector4)) const;
     Matrix4x4 XO_CC operator * (Matrix4x4 const& other) const;
     Matrix4x4& XO_CC operator *= (Matrix4x4 const& other);
 
@@ -230,9 +256,25 @@ struct Matrix4x4 {
     Vector3 Forward() const;
     Vector3 Backward() const;
 
+    // out[i] = left[i] * right[i], out may be left or right. Runs on the batch kernels, see
+    // xo-math-batch.h.
+    static void XO_CC Multiply(Matrix4x4 const* left,
+                               Matrix4x4 const* right,
+                               Matrix4x4* out,
+                               size_t count);
     static Matrix4x4 XO_CC Transpose(Matrix4x4 const& matrixIn);
     static Matrix4x4 XO_CC Invert(Matrix4x4 const& matrixIn);
     static bool XO_CC InvertSafe(Matrix4x4 const& matrixIn, Matrix4x4& matrixOut);
+    // Cheaper inverses for matrices whose last column is (0, 0, 0, 1), like the ones built
+    // by Translation, Scale, the Rotation functions, LookAt and products of them.
+    // InvertAffine inverts the upper 3x3 and moves the translation row back through it.
+    // InvertOrthonormal is for rotation and translation only (no scale or shear): the
+    // 3x3 inverse is its transpose. Neither checks its input, IsAffine and IsOrthonormal
+    // can do that in an assert. IsOrthonormal allows 1e-5 of error in the dot products.
+    static Matrix4x4 XO_CC InvertAffine(Matrix4x4 const& matrixIn);
+    static Matrix4x4 XO_CC InvertOrthonormal(Matrix4x4 const& matrixIn);
+    static bool XO_CC IsAffine(Matrix4x4 const& matrixIn);
+    static bool XO_CC IsOrthonormal(Matrix4x4 const& matrixIn);
     static Matrix4x4 XO_CC Translation(Vector3 const& pos);
     static Matrix4x4 XO_CC Scale(Vector3 const& scale);
     static Matrix4x4 XO_CC RotationYaw(float yaw);
@@ -300,11 +342,18 @@ struct Quaternion {
     Quaternion operator + (Quaternion other) const;
     Quaternion operator * (float scalar) const;
     Quaternion operator -() const;
+    // The Hamilton product: rotating by a * b is rotating by b, then by a.
+    Quaternion XO_CC operator * (Quaternion const& other) const;
+    Quaternion& XO_CC operator *= (Quaternion const& other);
+
+    // v rotated by this, which should be normalized. The same as ToMatrix().Transform(v),
+    // without the matrix: v + 2r(q x v) + q x 2(q x v) for the vector part q.
+    Vector3 XO_CC Rotate(Vector3 const& v) const;
 
     float Magnitude() const;
     float MagnitudeSquared() const;
-    Quaternion Normalized() const;
-    Quaternion& Normalize();
+    Quaternion Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+    Quaternion& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
 
     Matrix4x4 ToMatrix() const;
 
@@ -373,8 +422,8 @@ struct XO_REF_ALN AVector3 {
     float Magnitude() const;
     float MagnitudeSquared() const;
 
-    AVector3& Normalize();
-    AVector3 Normalized() const;
+    AVector3& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+    AVector3 Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
 
     static bool XO_CC RoughlyEqual(AVector3 const& left, AVector3 const& right);
     static bool XO_CC ExactlyEqual(AVector3 const& left, AVector3 const& right);
@@ -460,8 +509,8 @@ struct XO_REF_ALN AVector4 {
 
     float Magnitude() const;
     float MagnitudeSquared() const;
-    AVector4 Normalized() const;
-    AVector4& Normalize();
+    AVector4 Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+    AVector4& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
 
     static bool XO_CC RoughlyEqual(AVector4 const& left, AVector4 const& right);
     static bool XO_CC ExactlyEqual(AVector4 const& left, AVector4 const& right);
@@ -522,6 +571,29 @@ struct XO_REF_ALN AMatrix4x4 {
     AVector3 XO_CC InverseTransform(AVector3 const& v3) const;
     AVector4 XO_CC InverseTransform(AVector4 const& v4) const;
 
+    // Transforms 'count' vectors from in to out (which may be the same array). Points and
+    // directions are row vectors times the matrix, like InverseTransform and
+    // Matrix3x4::TransformPoint: points get the translation from rows[3], directions don't.
+    // Homogeneous is InverseTransform(AVector4), so a point with w = 1 comes out as from
+    // TransformPoints, and nothing divides by w. Strides are in bytes, for
+    // vectors that live inside larger structs. Runs 8 or 16 at a time with AVX2 or AVX512,
+    // see xo-math-batch.h.
+    void XO_CC TransformPoints(AVector3 const* in,
+                               AVector3* out,
+                               size_t count,
+                               size_t inStride = sizeof(AVector3),
+                               size_t outStride = sizeof(AVector3)) const;
+    void XO_CC TransformDirections(AVector3 const* in,
+                                   AVector3* out,
+                                   size_t count,
+                                   size_t inStride = sizeof(AVector3),
+                                   size_t outStride = sizeof(AVector3)) const;
+    void XO_CC TransformHomogeneous(AVector4 const* in,
+                                    AVector4* out,
+                                    size_t count,
+                                    size_t inStride = sizeof(AVector4),
+                                    size_t outStride = sizeof(AVector4)) const;
+
     AMatrix4x4 XO_CC operator * (AMatrix4x4 const& other) const;
     AMatrix4x4& XO_CC operator *= (AMatrix4x4 const& other);
 
@@ -535,9 +607,25 @@ struct XO_REF_ALN AMatrix4x4 {
     AVector3 Forward() const;
     AVector3 Backward() const;
 
+    // out[i] = left[i] * right[i], out may be left or right. Runs on the batch kernels, see
+    // xo-math-batch.h.
+    static void XO_CC Multiply(AMatrix4x4 const* left,
+                               AMatrix4x4 const* right,
+                               AMatrix4x4* out,
+                               size_t count);
     static AMatrix4x4 XO_CC Transpose(AMatrix4x4 const& matrixIn);
     static AMatrix4x4 XO_CC Invert(AMatrix4x4 const& matrixIn);
     static bool XO_CC InvertSafe(AMatrix4x4 const& matrixIn, AMatrix4x4& matrixOut);
+    // Cheaper inverses for matrices whose last column is (0, 0, 0, 1), like the ones built
+    // by Translation, Scale, the Rotation functions, LookAt and products of them.
+    // InvertAffine inverts the upper 3x3 and moves the translation row back through it.
+    // InvertOrthonormal is for rotation and translation only (no scale or shear): the
+    // 3x3 inverse is its transpose. Neither checks its input, IsAffine and IsOrthonormal
+    // can do that in an assert. IsOrthonormal allows 1e-5 of error in the dot products.
+    static AMatrix4x4 XO_CC InvertAffine(AMatrix4x4 const& matrixIn);
+    static AMatrix4x4 XO_CC InvertOrthonormal(AMatrix4x4 const& matrixIn);
+    static bool XO_CC IsAffine(AMatrix4x4 const& matrixIn);
+    static bool XO_CC IsOrthonormal(AMatrix4x4 const& matrixIn);
     static AMatrix4x4 XO_CC Translation(AVector3 const& pos);
     static AMatrix4x4 XO_CC Scale(AVector3 const& scale);
     static AMatrix4x4 XO_CC RotationYaw(float yaw);
@@ -607,11 +695,18 @@ struct XO_REF_ALN AQuaternion {
     AQuaternion operator + (AQuaternion other) const;
     AQuaternion operator * (float scalar) const;
     AQuaternion operator -() const;
+    // The Hamilton product: rotating by a * b is rotating by b, then by a.
+    AQuaternion XO_CC operator * (AQuaternion const& other) const;
+    AQuaternion& XO_CC operator *= (AQuaternion const& other);
+
+    // v rotated by this, which should be normalized. The same as ToMatrix().Transform(v),
+    // without the matrix: v + 2r(q x v) + q x 2(q x v) for the vector part q.
+    AVector3 XO_CC Rotate(AVector3 const& v) const;
 
     float Magnitude() const;
     float MagnitudeSquared() const;
-    AQuaternion Normalized() const;
-    AQuaternion& Normalize();
+    AQuaternion Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+    AQuaternion& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
 
     AMatrix4x4 ToMatrix() const;
 
@@ -754,8 +849,13 @@ XO_INL float Vector3::Sum() const { return x + y + z; }
 XO_INL float Vector3::MagnitudeSquared() const { return ((*this) * (*this)).Sum(); }
 XO_INL float Vector3::Magnitude() const { return xo::Sqrt(MagnitudeSquared()); }
 
-XO_INL Vector3& Vector3::Normalize() { return (*this) /= Vector3(Magnitude()); }
-XO_INL Vector3 Vector3::Normalized() const { return Vector3(*this).Normalize(); }
+XO_INL Vector3& Vector3::Normalize(Precision precision) {
+    if (precision == Precision::Exact) {
+        return (*this) /= Vector3(Magnitude());
+    }
+    return (*this) *= Vector3(InverseSqrt(MagnitudeSquared(), precision));
+}
+XO_INL Vector3 Vector3::Normalized(Precision precision) const { return Vector3(*this).Normalize(precision); }
 
 /*static*/ XO_INL
 bool XO_CC Vector3::RoughlyEqual(Vector3 const& left, Vector3 const& right) {
@@ -874,8 +974,13 @@ XO_INL float Vector4::Sum() const { return x + y + z + w; }
 
 XO_INL float Vector4::MagnitudeSquared() const { return x * x + y * y + z * z + w * w; }
 XO_INL float Vector4::Magnitude() const { return Sqrt(MagnitudeSquared()); }
-XO_INL Vector4 Vector4::Normalized() const { return Vector4(*this).Normalize(); }
-XO_INL Vector4& Vector4::Normalize() { return (*this) /= Vector4(Magnitude()); };
+XO_INL Vector4 Vector4::Normalized(Precision precision) const { return Vector4(*this).Normalize(precision); }
+XO_INL Vector4& Vector4::Normalize(Precision precision) {
+    if (precision == Precision::Exact) {
+        return (*this) /= Vector4(Magnitude());
+    }
+    return (*this) *= Vector4(InverseSqrt(MagnitudeSquared(), precision));
+}
 
 /*static*/ XO_INL 
 bool XO_CC Vector4::RoughlyEqual(Vector4 const& left, Vector4 const& right) {
@@ -1180,6 +1285,63 @@ bool XO_CC Matrix4x4::InvertSafe(Matrix4x4 const& matrixIn, Matrix4x4& matrixOut
     return true;
 }
 
+/*static*/ XO_INL
+Matrix4x4 XO_CC Matrix4x4::InvertAffine(Matrix4x4 const& matrixIn) {
+    // The columns of the 3x3 inverse are c0 = a1 x a2, c1 = a2 x a0 and c2 = a0 x a1 over
+    // the determinant a0 . c0.
+    Vector3 a0(matrixIn.v[0], matrixIn.v[1], matrixIn.v[2]);
+    Vector3 a1(matrixIn.v[4], matrixIn.v[5], matrixIn.v[6]);
+    Vector3 a2(matrixIn.v[8], matrixIn.v[9], matrixIn.v[10]);
+    Vector3 c0 = Vector3::CrossProduct(a1, a2);
+    Vector3 c1 = Vector3::CrossProduct(a2, a0);
+    Vector3 c2 = Vector3::CrossProduct(a0, a1);
+    float invDet = 1.f / Vector3::DotProduct(a0, c0);
+    Vector3 b0 = Vector3(c0.x, c1.x, c2.x) * invDet;
+    Vector3 b1 = Vector3(c0.y, c1.y, c2.y) * invDet;
+    Vector3 b2 = Vector3(c0.z, c1.z, c2.z) * invDet;
+    Vector3 d = -(b0 * matrixIn.v[12] + b1 * matrixIn.v[13] + b2 * matrixIn.v[14]);
+    return Matrix4x4(
+        Vector4(b0.x, b0.y, b0.z, 0.f),
+        Vector4(b1.x, b1.y, b1.z, 0.f),
+        Vector4(b2.x, b2.y, b2.z, 0.f),
+        Vector4(d.x,  d.y,  d.z,  1.f));
+}
+
+/*static*/ XO_INL
+Matrix4x4 XO_CC Matrix4x4::InvertOrthonormal(Matrix4x4 const& matrixIn) {
+    float const* m = matrixIn.v;
+    Vector3 b0(m[0], m[4], m[8]);
+    Vector3 b1(m[1], m[5], m[9]);
+    Vector3 b2(m[2], m[6], m[10]);
+    Vector3 d = -(b0 * m[12] + b1 * m[13] + b2 * m[14]);
+    return Matrix4x4(
+        Vector4(b0.x, b0.y, b0.z, 0.f),
+        Vector4(b1.x, b1.y, b1.z, 0.f),
+        Vector4(b2.x, b2.y, b2.z, 0.f),
+        Vector4(d.x,  d.y,  d.z,  1.f));
+}
+
+/*static*/ XO_INL
+bool XO_CC Matrix4x4::IsAffine(Matrix4x4 const& matrixIn) {
+    return CloseEnough(matrixIn.v[3], 0.f) && CloseEnough(matrixIn.v[7], 0.f)
+        && CloseEnough(matrixIn.v[11], 0.f) && CloseEnough(matrixIn.v[15], 1.f);
+}
+
+/*static*/ XO_INL
+bool XO_CC Matrix4x4::IsOrthonormal(Matrix4x4 const& matrixIn) {
+    Vector3 a0(matrixIn.v[0], matrixIn.v[1], matrixIn.v[2]);
+    Vector3 a1(matrixIn.v[4], matrixIn.v[5], matrixIn.v[6]);
+    Vector3 a2(matrixIn.v[8], matrixIn.v[9], matrixIn.v[10]);
+    float const tolerance = 1e-5f;
+    return IsAffine(matrixIn)
+        && Abs(a0.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(a1.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(a2.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(Vector3::DotProduct(a0, a1)) <= tolerance
+        && Abs(Vector3::DotProduct(a1, a2)) <= tolerance
+        && Abs(Vector3::DotProduct(a2, a0)) <= tolerance;
+}
+
 /*static*/ XO_INL 
 Matrix4x4 XO_CC Matrix4x4::Translation(Vector3 const& pos) {
     return Matrix4x4(
@@ -1290,6 +1452,7 @@ Matrix4x4 XO_CC Matrix4x4::Perspective(float width,
                                        float aspect, 
                                        float nearPlane, 
                                        float farPlane) {
+    XO_UNUSED(aspect);   // width / height already give it
     float n2 = Pow<2>(nearPlane);
     float r = farPlane / (nearPlane - farPlane);
     float w = n2 / width;
@@ -1374,6 +1537,26 @@ Quaternion Quaternion::operator -() const {
     return Quaternion(-i, -j, -k, -r);
 }
 
+XO_INL
+Quaternion XO_CC Quaternion::operator * (Quaternion const& other) const {
+    return Quaternion(r * other.i + i * other.r + j * other.k - k * other.j,
+                      r * other.j - i * other.k + j * other.r + k * other.i,
+                      r * other.k + i * other.j - j * other.i + k * other.r,
+                      r * other.r - i * other.i - j * other.j - k * other.k);
+}
+
+XO_INL
+Quaternion& XO_CC Quaternion::operator *= (Quaternion const& other) {
+    return *this = *this * other;
+}
+
+XO_INL
+Vector3 XO_CC Quaternion::Rotate(Vector3 const& v) const {
+    Vector3 q(i, j, k);
+    Vector3 t = Vector3::CrossProduct(q, v) * 2.f;
+    return v + t * r + Vector3::CrossProduct(q, t);
+}
+
 XO_INL
 float Quaternion::Magnitude() const {
     return vec4.Magnitude();
@@ -1385,13 +1568,13 @@ float Quaternion::MagnitudeSquared() const {
 };
 
 XO_INL
-Quaternion Quaternion::Normalized() const {
-    return Quaternion(vec4.Normalized());
+Quaternion Quaternion::Normalized(Precision precision) const {
+    return Quaternion(vec4.Normalized(precision));
 };
 
 XO_INL
-Quaternion& Quaternion::Normalize() {
-    vec4.Normalize(); return *this;
+Quaternion& Quaternion::Normalize(Precision precision) {
+    vec4.Normalize(precision); return *this;
 };
 
 XO_INL
@@ -1615,8 +1798,13 @@ XO_INL float AVector3::Sum() const { return x + y + z; }
 XO_INL float AVector3::MagnitudeSquared() const { return ((*this) * (*this)).Sum(); }
 XO_INL float AVector3::Magnitude() const { return xo::Sqrt(MagnitudeSquared()); }
 
-XO_INL AVector3& AVector3::Normalize() { return (*this) /= AVector3(Magnitude()); }
-XO_INL AVector3 AVector3::Normalized() const { return AVector3(*this).Normalize(); }
+XO_INL AVector3& AVector3::Normalize(Precision precision) {
+    if (precision == Precision::Exact) {
+        return (*this) /= AVector3(Magnitude());
+    }
+    return (*this) *= AVector3(InverseSqrt(MagnitudeSquared(), precision));
+}
+XO_INL AVector3 AVector3::Normalized(Precision precision) const { return AVector3(*this).Normalize(precision); }
 
 /*static*/ XO_INL
 bool XO_CC AVector3::RoughlyEqual(AVector3 const& left, AVector3 const& right) {
@@ -1735,8 +1923,13 @@ XO_INL float AVector4::Sum() const { return x + y + z + w; }
 
 XO_INL float AVector4::MagnitudeSquared() const { return x * x + y * y + z * z + w * w; }
 XO_INL float AVector4::Magnitude() const { return Sqrt(MagnitudeSquared()); }
-XO_INL AVector4 AVector4::Normalized() const { return AVector4(*this).Normalize(); }
-XO_INL AVector4& AVector4::Normalize() { return (*this) /= AVector4(Magnitude()); };
+XO_INL AVector4 AVector4::Normalized(Precision precision) const { return AVector4(*this).Normalize(precision); }
+XO_INL AVector4& AVector4::Normalize(Precision precision) {
+    if (precision == Precision::Exact) {
+        return (*this) /= AVector4(Magnitude());
+    }
+    return (*this) *= AVector4(InverseSqrt(MagnitudeSquared(), precision));
+}
 
 /*static*/ XO_INL 
 bool XO_CC AVector4::RoughlyEqual(AVector4 const& left, AVector4 const& right) {
@@ -1955,6 +2148,63 @@ bool XO_CC AMatrix4x4::InvertSafe(AMatrix4x4 const& AMatrixIn, AMatrix4x4& AMatr
     return true;
 }
 
+/*static*/ XO_INL
+AMatrix4x4 XO_CC AMatrix4x4::InvertAffine(AMatrix4x4 const& matrixIn) {
+    // The columns of the 3x3 inverse are c0 = a1 x a2, c1 = a2 x a0 and c2 = a0 x a1 over
+    // the determinant a0 . c0.
+    AVector3 a0(matrixIn.v[0], matrixIn.v[1], matrixIn.v[2]);
+    AVector3 a1(matrixIn.v[4], matrixIn.v[5], matrixIn.v[6]);
+    AVector3 a2(matrixIn.v[8], matrixIn.v[9], matrixIn.v[10]);
+    AVector3 c0 = AVector3::CrossProduct(a1, a2);
+    AVector3 c1 = AVector3::CrossProduct(a2, a0);
+    AVector3 c2 = AVector3::CrossProduct(a0, a1);
+    float invDet = 1.f / AVector3::DotProduct(a0, c0);
+    AVector3 b0 = AVector3(c0.x, c1.x, c2.x) * invDet;
+    AVector3 b1 = AVector3(c0.y, c1.y, c2.y) * invDet;
+    AVector3 b2 = AVector3(c0.z, c1.z, c2.z) * invDet;
+    AVector3 d = -(b0 * matrixIn.v[12] + b1 * matrixIn.v[13] + b2 * matrixIn.v[14]);
+    return AMatrix4x4(
+        AVector4(b0.x, b0.y, b0.z, 0.f),
+        AVector4(b1.x, b1.y, b1.z, 0.f),
+        AVector4(b2.x, b2.y, b2.z, 0.f),
+        AVector4(d.x,  d.y,  d.z,  1.f));
+}
+
+/*static*/ XO_INL
+AMatrix4x4 XO_CC AMatrix4x4::InvertOrthonormal(AMatrix4x4 const& matrixIn) {
+    float const* m = matrixIn.v;
+    AVector3 b0(m[0], m[4], m[8]);
+    AVector3 b1(m[1], m[5], m[9]);
+    AVector3 b2(m[2], m[6], m[10]);
+    AVector3 d = -(b0 * m[12] + b1 * m[13] + b2 * m[14]);
+    return AMatrix4x4(
+        AVector4(b0.x, b0.y, b0.z, 0.f),
+        AVector4(b1.x, b1.y, b1.z, 0.f),
+        AVector4(b2.x, b2.y, b2.z, 0.f),
+        AVector4(d.x,  d.y,  d.z,  1.f));
+}
+
+/*static*/ XO_INL
+bool XO_CC AMatrix4x4::IsAffine(AMatrix4x4 const& matrixIn) {
+    return CloseEnough(matrixIn.v[3], 0.f) && CloseEnough(matrixIn.v[7], 0.f)
+        && CloseEnough(matrixIn.v[11], 0.f) && CloseEnough(matrixIn.v[15], 1.f);
+}
+
+/*static*/ XO_INL
+bool XO_CC AMatrix4x4::IsOrthonormal(AMatrix4x4 const& matrixIn) {
+    AVector3 a0(matrixIn.v[0], matrixIn.v[1], matrixIn.v[2]);
+    AVector3 a1(matrixIn.v[4], matrixIn.v[5], matrixIn.v[6]);
+    AVector3 a2(matrixIn.v[8], matrixIn.v[9], matrixIn.v[10]);
+    float const tolerance = 1e-5f;
+    return IsAffine(matrixIn)
+        && Abs(a0.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(a1.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(a2.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(AVector3::DotProduct(a0, a1)) <= tolerance
+        && Abs(AVector3::DotProduct(a1, a2)) <= tolerance
+        && Abs(AVector3::DotProduct(a2, a0)) <= tolerance;
+}
+
 /*static*/ XO_INL 
 AMatrix4x4 XO_CC AMatrix4x4::Translation(AVector3 const& pos) {
     return AMatrix4x4(
@@ -2065,6 +2315,7 @@ AMatrix4x4 XO_CC AMatrix4x4::Perspective(float width,
                                        float aspect, 
                                        float nearPlane, 
                                        float farPlane) {
+    XO_UNUSED(aspect);   // width / height already give it
     float n2 = Pow<2>(nearPlane);
     float r = farPlane / (nearPlane - farPlane);
     float w = n2 / width;
@@ -2149,6 +2400,26 @@ AQuaternion AQuaternion::operator -() const {
     return AQuaternion(-i, -j, -k, -r);
 }
 
+XO_INL
+AQuaternion XO_CC AQuaternion::operator * (AQuaternion const& other) const {
+    return AQuaternion(r * other.i + i * other.r + j * other.k - k * other.j,
+                       r * other.j - i * other.k + j * other.r + k * other.i,
+                       r * other.k + i * other.j - j * other.i + k * other.r,
+                       r * other.r - i * other.i - j * other.j - k * other.k);
+}
+
+XO_INL
+AQuaternion& XO_CC AQuaternion::operator *= (AQuaternion const& other) {
+    return *this = *this * other;
+}
+
+XO_INL
+AVector3 XO_CC AQuaternion::Rotate(AVector3 const& v) const {
+    AVector3 q(i, j, k);
+    AVector3 t = AVector3::CrossProduct(q, v) * 2.f;
+    return v + t * r + AVector3::CrossProduct(q, t);
+}
+
 XO_INL
 float AQuaternion::Magnitude() const {
     return vec4.Magnitude();
@@ -2160,13 +2431,13 @@ float AQuaternion::MagnitudeSquared() const {
 };
 
 XO_INL
-AQuaternion AQuaternion::Normalized() const {
-    return AQuaternion(vec4.Normalized());
+AQuaternion AQuaternion::Normalized(Precision precision) const {
+    return AQuaternion(vec4.Normalized(precision));
 };
 
 XO_INL
-AQuaternion& AQuaternion::Normalize() {
-    vec4.Normalize(); return *this;
+AQuaternion& AQuaternion::Normalize(Precision precision) {
+    vec4.Normalize(precision); return *this;
 };
 
 XO_INL
@@ -1,7 +1,2676 @@
 #pragma once
 #include <inttypes.h>
 #include "xo-math-macros.h"
+#include "xo-math-utilities.h"
+#include "xo-math-detect-simd.h"
+#ifndef XO_CONFIG_LEFT_HANDED
+#define XO_CONFIG_LEFT_HANDED 1
+#endif
+#ifndef XO_CONFIG_RIGHT_HANDED
+#define XO_CONFIG_RIGHT_HANDED 0
+#endif
+#ifndef XO_CONFIG_Y_UP
+#define XO_CONFIG_Y_UP 1
+#endif
+#ifndef XO_CONFIG_Z_UP
+#define XO_CONFIG_Z_UP 0
+#endif
 // $inline_begin
+#if XO_SSE_CURRENT >= XO_AVX
+#   include <immintrin.h>
+#else
+#   include <smmintrin.h>
+#endif
+
+#if !defined(XO_CONFIG_DEFAULT_NEAR_PLANE)
+#   define XO_CONFIG_DEFAULT_NEAR_PLANE 0.1f
+#endif
+#if !defined(XO_CONFIG_DEFAULT_FAR_PLANE)
+#   define XO_CONFIG_DEFAULT_FAR_PLANE 1000.f
+#endif
+#if !defined(XO_CONFIG_DEFAULT_PRECISION)
+#   define XO_CONFIG_DEFAULT_PRECISION xo::Precision::Exact
+#endif
+
+#define XO_SSE_ALN                  XO_ALN_16
+#define XO_SSE_NEW_DEL(typeName)    XO_NEW_DEL_16(typeName)
+
 namespace xo {
+//////////////////////////////////////////////////////////////////////////////////////////
+struct Vector3 {
+    float x, y, z;
+    constexpr Vector3(float x, float y, float z) 
+        : x(x)
+        , y(y)
+        , z(z)
+    { }
+
+    constexpr explicit Vector3(float all)
+        : x(all)
+        , y(all)
+        , z(all) 
+    { }
+
+    Vector3() = default;
+    ~Vector3() = default;
+    Vector3(Vector3 const& other) = default;
+    Vector3(Vector3&& ref) = default;
+    Vector3& operator = (Vector3 const& other) = default;
+    Vector3& operator = (Vector3&& ref) = default;
+
+    Vector3 XO_CC operator + (Vector3 const& other) const;
+    Vector3 XO_CC operator - (Vector3 const& other) const;
+    Vector3 XO_CC operator * (Vector3 const& other) const;
+    Vector3 XO_CC operator / (Vector3 const& other) const;
+    Vector3& XO_CC operator += (Vector3 const& other);
+    Vector3& XO_CC operator -= (Vector3 const& other);
+    Vector3& XO_CC operator *= (Vector3 const& other);
+    Vector3& XO_CC operator /= (Vector3 const& other);
+
+    Vector3 XO_CC operator + (float value) const { return *this + Vector3(value); }
+    Vector3 XO_CC operator - (float value) const { return *this - Vector3(value); }
+    Vector3 XO_CC operator * (float value) const { return *this * Vector3(value); }
+    Vector3 XO_CC operator / (float value) const { return *this / Vector3(value); }
+    Vector3& XO_CC operator += (float value) { return *this += Vector3(value); }
+    Vector3& XO_CC operator -= (float value) { return *this -= Vector3(value); }
+    Vector3& XO_CC operator *= (float value) { return *this *= Vector3(value); }
+    Vector3& XO_CC operator /= (float value) { return *this /= Vector3(value); }
+
+    Vector3 operator -() const;
+
+    float Sum() const;
+
+    float Magnitude() const;
+    float MagnitudeSquared() const;
+
+    Vector3& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+    Vector3 Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+
+    static bool XO_CC RoughlyEqual(Vector3 const& left, Vector3 const& right);
+    static bool XO_CC ExactlyEqual(Vector3 const& left, Vector3 const& right);
+    static bool XO_CC RoughlyEqual(Vector3 const& left, float magnitude);
+    static bool XO_CC ExactlyEqual(Vector3 const& left, float magnitude);
+
+    static float XO_CC DotProduct(Vector3 const& left, Vector3 const& right);
+    static Vector3 XO_CC CrossProduct(Vector3 const& left, Vector3 const& right);
+    static Vector3 XO_CC Lerp(Vector3 const& left, Vector3 const& right, float t);
+    static float XO_CC DistanceSquared(Vector3 const& left, Vector3 const& right);
+    static float XO_CC Distance(Vector3 const& left, Vector3 const& right);
+
+    static const Vector3 Zero;
+    static const Vector3 One;
+    static const Vector3 Up;
+    static const Vector3 Down;
+    static const Vector3 Left;
+    static const Vector3 Right;
+    static const Vector3 Forward;
+    static const Vector3 Backward;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+struct Vector4 {
+    union {
+        struct { float x, y, z, w; };
+        float v[4];
+    };
+    constexpr Vector4(float x, float y, float z, float w)
+        : x(x)
+        , y(y)
+        , z(z)
+        , w(w)
+    { }
+
+    constexpr explicit Vector4(float all)
+        : x(all)
+        , y(all)
+        , z(all)
+        , w(all)
+    { }
+
+    constexpr explicit Vector4(Vector3 v3, float w = 0.f)
+        : x(v3.x)
+        , y(v3.y)
+        , z(v3.z)
+        , w(w)
+    { }
+
+    Vector4() = default;
+    ~Vector4() = default;
+    Vector4(Vector4 const& other) = default;
+    Vector4(Vector4&& ref) = default;
+    Vector4& operator = (Vector4 const& other) = default;
+    Vector4& operator = (Vector4&& ref) = default;
+
+    Vector4 XO_CC operator + (Vector4 const& other) const;
+    Vector4 XO_CC operator - (Vector4 const& other) const;
+    Vector4 XO_CC operator * (Vector4 const& other) const;
+    Vector4 XO_CC operator / (Vector4 const& other) const;
+    Vector4& XO_CC operator += (Vector4 const& other);
+    Vector4& XO_CC operator -= (Vector4 const& other);
+    Vector4& XO_CC operator *= (Vector4 const& other);
+    Vector4& XO_CC operator /= (Vector4 const& other);
+
+    Vector4 XO_CC operator + (float value) const { return *this + Vector4(value); }
+    Vector4 XO_CC operator - (float value) const { return *this - Vector4(value); }
+    Vector4 XO_CC operator * (float value) const { return *this * Vector4(value); }
+    Vector4 XO_CC operator / (float value) const { return *this / Vector4(value); }
+    Vector4& XO_CC operator += (float value) { return *this += Vector4(value); }
+    Vector4& XO_CC operator -= (float value) { return *this -= Vector4(value); }
+    Vector4& XO_CC operator *= (float value) { return *this *= Vector4(value); }
+    Vector4& XO_CC operator /= (float value) { return *this /= Vector4(value); }
+
+    Vector4 operator -() const;
+
+    float operator[] (int index) const;
+    float& operator[] (int index);
+
+    float Sum() const;
+
+    float Magnitude() const;
+    float MagnitudeSquared() const;
+    Vector4 Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+    Vector4& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+
+    static bool XO_CC RoughlyEqual(Vector4 const& left, Vector4 const& right);
+    static bool XO_CC ExactlyEqual(Vector4 const& left, Vector4 const& right);
+    static bool XO_CC RoughlyEqual(Vector4 const& left, float magnitude);
+    static bool XO_CC ExactlyEqual(Vector4 const& left, float magnitude);
+
+    static float XO_CC DotProduct(Vector4 const& left, Vector4 const& right);
+    static Vector4 XO_CC Lerp(Vector4 const& left, Vector4 const& right, float t);
+
+    static const Vector4 Zero;
+    static const Vector4 One;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+struct Matrix4x4 {
+    union {
+        Vector4 rows[4];
+        float v[16];
+    };
+    constexpr Matrix4x4(Vector4 const rows[4])
+        : rows {
+            rows[0],
+            rows[1],
+            rows[2],
+            rows[3] }
+    { }
+
+    constexpr Matrix4x4(Vector4 const& row0, 
+                        Vector4 const& row1,
+                        Vector4 const& row2,
+                        Vector4 const& row3)
+        : rows{
+            row0,
+            row1,
+            row2,
+            row3 }
+    { }
+
+    constexpr explicit Matrix4x4(float all)
+        : rows{
+            Vector4(all),
+            Vector4(all),
+            Vector4(all),
+            Vector4(all) }
+    { }
+
+    Matrix4x4() = default;
+    ~Matrix4x4() = default;
+    Matrix4x4(Matrix4x4 const& other) = default;
+    Matrix4x4(Matrix4x4&& ref) = default;
+    Matrix4x4& operator = (Matrix4x4 const& other) = default;
+    Matrix4x4& operator = (Matrix4x4&& ref) = default;
+
+    Vector3 XO_CC Transform(Vector3 const& v3) const;
+    Vector4 XO_CC Transform(Vector4 const& v4) const;
+    Vector3 XO_CC InverseTransform(Vector3 const& v3) const;
+    Vector4 XO_CC InverseTransform(Vector4 const& v4) const;
+
+    // Transforms 'count' vectors from in to out (which may be the same array). Points and
+    // directions are row vectors times the matrix, like InverseTransform and
+    // Matrix3x4::TransformPoint: points get the translation from rows[3], directions don't.
+    // Homogeneous is InverseTransform(Vector4), so a point with w = 1 comes out as from
+    // TransformPoints, and nothing divides by w. Strides are in bytes, for
+    // vectors that live inside larger structs. Runs 8 or 16 at a time with AVX2 or AVX512,
+    // see xo-math-batch.h.
+    void XO_CC TransformPoints(Vector3 const* in,
+                               Vector3* out,
+                               size_t count,
+                               size_t inStride = sizeof(Vector3),
+                               size_t outStride = sizeof(Vector3)) const;
+    void XO_CC TransformDirections(Vector3 const* in,
+                                   Vector3* out,
+                                   size_t count,
+                                   size_t inStride = sizeof(Vector3),
+                                   size_t outStride = sizeof(Vector3)) const;
+    void XO_CC TransformHomogeneous(Vector4 const* in,
+                                    Vector4* out,
+                                    size_t count,
+                                    size_t inStride = sizeof(Vector4),
+                                    size_t outStride = sizeof(Vector4)) const;
+    Matrix4x4 XO_CC operator * (Matrix4x4 const& other) const;
+    Matrix4x4& XO_CC operator *= (Matrix4x4 const& other);
+
+    Vector4 operator[] (int index) const;
+    Vector4& operator[] (int index);
+    
+    Vector3 Up() const;
+    Vector3 Down() const;
+    Vector3 Left() const;
+    Vector3 Right() const;
+    Vector3 Forward() const;
+    Vector3 Backward() const;
+
+    // out[i] = left[i] * right[i], out may be left or right. Runs on the batch kernels, see
+    // xo-math-batch.h.
+    static void XO_CC Multiply(Matrix4x4 const* left,
+                               Matrix4x4 const* right,
+                               Matrix4x4* out,
+                               size_t count);
+    static Matrix4x4 XO_CC Transpose(Matrix4x4 const& matrixIn);
+    static Matrix4x4 XO_CC Invert(Matrix4x4 const& matrixIn);
+    static bool XO_CC InvertSafe(Matrix4x4 const& matrixIn, Matrix4x4& matrixOut);
+    // Cheaper inverses for matrices whose last column is (0, 0, 0, 1), like the ones built
+    // by Translation, Scale, the Rotation functions, LookAt and products of them.
+    // InvertAffine inverts the upper 3x3 and moves the translation row back through it.
+    // InvertOrthonormal is for rotation and translation only (no scale or shear): the
+    // 3x3 inverse is its transpose. Neither checks its input, IsAffine and IsOrthonormal
+    // can do that in an assert. IsOrthonormal allows 1e-5 of error in the dot products.
+    static Matrix4x4 XO_CC InvertAffine(Matrix4x4 const& matrixIn);
+    static Matrix4x4 XO_CC InvertOrthonormal(Matrix4x4 const& matrixIn);
+    static bool XO_CC IsAffine(Matrix4x4 const& matrixIn);
+    static bool XO_CC IsOrthonormal(Matrix4x4 const& matrixIn);
+    static Matrix4x4 XO_CC Translation(Vector3 const& pos);
+    static Matrix4x4 XO_CC Scale(Vector3 const& scale);
+    static Matrix4x4 XO_CC RotationYaw(float yaw);
+    static Matrix4x4 XO_CC RotationPitch(float pitch);
+    static Matrix4x4 XO_CC RotationRoll(float roll);
+    static Matrix4x4 XO_CC RotationYawPitchRoll(float yaw, float pitch, float roll);
+    static Matrix4x4 XO_CC RotationAxisAngle(Vector3 const& axis, float angle);
+    static Matrix4x4 XO_CC PerspectiveFOV(float fov, 
+                                          float aspect, 
+                                          float nearPlane = XO_CONFIG_DEFAULT_NEAR_PLANE, 
+                                          float farPlane = XO_CONFIG_DEFAULT_FAR_PLANE);
+    static Matrix4x4 XO_CC Perspective(float width, 
+                                       float height, 
+                                       float aspect, 
+                                       float nearPlane = XO_CONFIG_DEFAULT_NEAR_PLANE, 
+                                       float farPlane = XO_CONFIG_DEFAULT_FAR_PLANE);
+    static Matrix4x4 XO_CC Orthographic(float width,
+                                        float height,
+                                        float nearPlane,
+                                        float farPlane);
+    static Matrix4x4 XO_CC LookAt(Vector3 const& from, 
+                                  Vector3 const& to, 
+                                  Vector3 const& up = Vector3::Up);
+
+    static bool XO_CC RoughlyEqual(Matrix4x4 const& left, Matrix4x4 const& right);
+    static bool XO_CC ExactlyEqual(Matrix4x4 const& left, Matrix4x4 const& right);
+
+    static const Matrix4x4 One;
+    static const Matrix4x4 Zero;
+    static const Matrix4x4 Identity;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+struct Quaternion {
+    union {
+        struct { float i, j, k, r; };
+        Vector4 vec4;
+    };
+
+    constexpr Quaternion(float i, float j, float k, float r)
+        : i(i)
+        , j(j)
+        , k(k)
+        , r(r)
+    { }
+
+    constexpr explicit Quaternion(float all)
+        : i(all)
+        , j(all)
+        , k(all)
+        , r(all)
+    { }
+
+    constexpr explicit Quaternion(Vector4 const& v4)
+        : vec4(v4)
+    { }
+
+    Quaternion() = default;
+    ~Quaternion() = default;
+    Quaternion(Quaternion const& other) = default;
+    Quaternion(Quaternion&& ref) = default;
+    Quaternion& operator = (Quaternion const& other) = default;
+    Quaternion& operator = (Quaternion&& ref) = default;
+
+    Quaternion operator + (Quaternion other) const;
+    Quaternion operator * (float scalar) const;
+    Quaternion operator -() const;
+    // The Hamilton product: rotating by a * b is rotating by b, then by a.
+    Quaternion XO_CC operator * (Quaternion const& other) const;
+    Quaternion& XO_CC operator *= (Quaternion const& other);
+
+    // v rotated by this, which should be normalized. The same as ToMatrix().Transform(v),
+    // without the matrix: v + 2r(q x v) + q x 2(q x v) for the vector part q.
+    Vector3 XO_CC Rotate(Vector3 const& v) const;
+
+    float Magnitude() const;
+    float MagnitudeSquared() const;
+    Quaternion Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+    Quaternion& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+
+    Matrix4x4 ToMatrix() const;
+
+    static Quaternion XO_CC Invert(Quaternion const& quat);
+    static Quaternion XO_CC RotationAxisAngle(Vector3 const& axis, float angle);
+    static Quaternion XO_CC RotationEuler(Vector3 const& angles);
+    static float XO_CC DotProduct(Quaternion const& left, Quaternion const& right);
+    static Quaternion XO_CC Lerp(Quaternion const& start, Quaternion const& end, float t);
+    static Quaternion XO_CC Slerp(Quaternion const& start, 
+                                  Quaternion const& end, 
+                                  float t);
+
+    static bool XO_CC RoughlyEqual(Quaternion const& left, Quaternion const& right);
+    static bool XO_CC ExactlyEqual(Quaternion const& left, Quaternion const& right);
+
+    static const Quaternion Zero;
+    static const Quaternion Identity;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// vector 3, aligned for cpu specific optimizations (where applicable) 
+struct XO_SSE_ALN AVector3 {
+    XO_SSE_NEW_DEL(AVector3);
+    float x, y, z;
+    constexpr AVector3(float x, float y, float z)
+        : x(x)
+        , y(y)
+        , z(z)
+    { }
+
+    constexpr explicit AVector3(float all)
+        : x(all)
+        , y(all)
+        , z(all)
+    { }
+
+    AVector3() = default;
+    ~AVector3() = default;
+    AVector3(AVector3 const& other) = default;
+    AVector3(AVector3&& ref) = default;
+    AVector3& operator = (AVector3 const& other) = default;
+    AVector3& operator = (AVector3&& ref) = default;
+
+    AVector3 XO_CC operator + (AVector3 const& other) const;
+    AVector3 XO_CC operator - (AVector3 const& other) const;
+    AVector3 XO_CC operator * (AVector3 const& other) const;
+    AVector3 XO_CC operator / (AVector3 const& other) const;
+    AVector3& XO_CC operator += (AVector3 const& other);
+    AVector3& XO_CC operator -= (AVector3 const& other);
+    AVector3& XO_CC operator *= (AVector3 const& other);
+    AVector3& XO_CC operator /= (AVector3 const& other);
+
+    AVector3 XO_CC operator + (float value) const { return *this + AVector3(value); }
+    AVector3 XO_CC operator - (float value) const { return *this - AVector3(value); }
+    AVector3 XO_CC operator * (float value) const { return *this * AVector3(value); }
+    AVector3 XO_CC operator / (float value) const { return *this / AVector3(value); }
+    AVector3& XO_CC operator += (float value) { return *this += AVector3(value); }
+    AVector3& XO_CC operator -= (float value) { return *this -= AVector3(value); }
+    AVector3& XO_CC operator *= (float value) { return *this *= AVector3(value); }
+    AVector3& XO_CC operator /= (float value) { return *this /= AVector3(value); }
+
+    AVector3 operator -() const;
+
+    float Sum() const;
+
+    float Magnitude() const;
+    float MagnitudeSquared() const;
+
+    AVector3& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+    AVector3 Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+
+    static bool XO_CC RoughlyEqual(AVector3 const& left, AVector3 const& right);
+    static bool XO_CC ExactlyEqual(AVector3 const& left, AVector3 const& right);
+    static bool XO_CC RoughlyEqual(AVector3 const& left, float magnitude);
+    static bool XO_CC ExactlyEqual(AVector3 const& left, float magnitude);
+
+    static float XO_CC DotProduct(AVector3 const& left, AVector3 const& right);
+    static AVector3 XO_CC CrossProduct(AVector3 const& left, AVector3 const& right);
+    static AVector3 XO_CC Lerp(AVector3 const& left, AVector3 const& right, float t);
+    static float XO_CC DistanceSquared(AVector3 const& left, AVector3 const& right);
+    static float XO_CC Distance(AVector3 const& left, AVector3 const& right);
+
+    static const AVector3 Zero;
+    static const AVector3 One;
+    static const AVector3 Up;
+    static const AVector3 Down;
+    static const AVector3 Left;
+    static const AVector3 Right;
+    static const AVector3 Forward;
+    static const AVector3 Backward;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// vector 4, aligned for cpu specific optimizations (where applicable)
+struct XO_SSE_ALN AVector4 {
+    XO_SSE_NEW_DEL(AVector4);
+    union {
+        struct { float x, y, z, w; };
+        float v[4];
+    };
+    constexpr AVector4(float x, float y, float z, float w)
+        : x(x)
+        , y(y)
+        , z(z)
+        , w(w)
+    { }
+
+    constexpr explicit AVector4(float all)
+        : x(all)
+        , y(all)
+        , z(all)
+        , w(all)
+    { }
+
+    constexpr explicit AVector4(AVector3 v3, float w = 0.f)
+        : x(v3.x)
+        , y(v3.y)
+        , z(v3.z)
+        , w(w)
+    { }
+
+    AVector4() = default;
+    ~AVector4() = default;
+    AVector4(AVector4 const& other) = default;
+    AVector4(AVector4&& ref) = default;
+    AVector4& operator = (AVector4 const& other) = default;
+    AVector4& operator = (AVector4&& ref) = default;
+
+    AVector4 XO_CC operator + (AVector4 const& other) const;
+    AVector4 XO_CC operator - (AVector4 const& other) const;
+    AVector4 XO_CC operator * (AVector4 const& other) const;
+    AVector4 XO_CC operator / (AVector4 const& other) const;
+    AVector4& XO_CC operator += (AVector4 const& other);
+    AVector4& XO_CC operator -= (AVector4 const& other);
+    AVector4& XO_CC operator *= (AVector4 const& other);
+    AVector4& XO_CC operator /= (AVector4 const& other);
+
+    AVector4 XO_CC operator + (float value) const { return *this + AVector4(value); }
+    AVector4 XO_CC operator - (float value) const { return *this - AVector4(value); }
+    AVector4 XO_CC operator * (float value) const { return *this * AVector4(value); }
+    AVector4 XO_CC operator / (float value) const { return *this / AVector4(value); }
+    AVector4& XO_CC operator += (float value) { return *this += AVector4(value); }
+    AVector4& XO_CC operator -= (float value) { return *this -= AVector4(value); }
+    AVector4& XO_CC operator *= (float value) { return *this *= AVector4(value); }
+    AVector4& XO_CC operator /= (float value) { return *this /= AVector4(value); }
+
+    AVector4 operator -() const;
+
+    float operator[] (int index) const;
+    float& operator[] (int index);
+
+    float Sum() const;
+
+    float Magnitude() const;
+    float MagnitudeSquared() const;
+    AVector4 Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+    AVector4& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+
+    static bool XO_CC RoughlyEqual(AVector4 const& left, AVector4 const& right);
+    static bool XO_CC ExactlyEqual(AVector4 const& left, AVector4 const& right);
+    static bool XO_CC RoughlyEqual(AVector4 const& left, float magnitude);
+    static bool XO_CC ExactlyEqual(AVector4 const& left, float magnitude);
+
+    static float XO_CC DotProduct(AVector4 const& left, AVector4 const& right);
+    static AVector4 XO_CC Lerp(AVector4 const& left, AVector4 const& right, float t);
+
+    static const AVector4 Zero;
+    static const AVector4 One;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// matrix4x4, aligned for cpu specific optimizations (where applicable)
+struct XO_SSE_ALN AMatrix4x4 {
+    XO_SSE_NEW_DEL(AMatrix4x4);
+    union {
+        AVector4 rows[4];
+        float v[16];
+    };
+    constexpr AMatrix4x4(AVector4 const rows[4])
+        : rows{
+        rows[0],
+        rows[1],
+        rows[2],
+        rows[3] }
+    { }
+
+    constexpr AMatrix4x4(AVector4 const& row0,
+        AVector4 const& row1,
+        AVector4 const& row2,
+        AVector4 const& row3)
+        : rows{
+        row0,
+        row1,
+        row2,
+        row3 }
+    { }
+
+    constexpr explicit AMatrix4x4(float all)
+        : rows{
+        AVector4(all),
+        AVector4(all),
+        AVector4(all),
+        AVector4(all) }
+    { }
+
+    AMatrix4x4() = default;
+    ~AMatrix4x4() = default;
+    AMatrix4x4(AMatrix4x4 const& other) = default;
+    AMatrix4x4(AMatrix4x4&& ref) = default;
+    AMatrix4x4& operator = (AMatrix4x4 const& other) = default;
+    AMatrix4x4& operator = (AMatrix4x4&& ref) = default;
+
+    AVector3 XO_CC Transform(AVector3 const& v3) const;
+    AVector4 XO_CC Transform(AVector4 const& v4) const;
+    AVector3 XO_CC InverseTransform(AVector3 const& v3) const;
+    AVector4 XO_CC InverseTransform(AVector4 const& v4) const;
+
+    // Transforms 'count' vectors from in to out (which may be the same array). Points and
+    // directions are row vectors times the matrix, like InverseTransform and
+    // Matrix3x4::TransformPoint: points get the translation from rows[3], directions don't.
+    // Homogeneous is InverseTransform(AVector4), so a point with w = 1 comes out as from
+    // TransformPoints, and nothing divides by w. Strides are in bytes, for
+    // vectors that live inside larger structs. Runs 8 or 16 at a time with AVX2 or AVX512,
+    // see xo-math-batch.h.
+    void XO_CC TransformPoints(AVector3 const* in,
+                               AVector3* out,
+                               size_t count,
+                               size_t inStride = sizeof(AVector3),
+                               size_t outStride = sizeof(AVector3)) const;
+    void XO_CC TransformDirections(AVector3 const* in,
+                                   AVector3* out,
+                                   size_t count,
+                                   size_t inStride = sizeof(AVector3),
+                                   size_t outStride = sizeof(AVector3)) const;
+    void XO_CC TransformHomogeneous(AVector4 const* in,
+                                    AVector4* out,
+                                    size_t count,
+                                    size_t inStride = sizeof(AVector4),
+                                    size_t outStride = sizeof(AVector4)) const;
+
+    AMatrix4x4 XO_CC operator * (AMatrix4x4 const& other) const;
+    AMatrix4x4& XO_CC operator *= (AMatrix4x4 const& other);
+
+    AVector4 operator[] (int index) const;
+    AVector4& operator[] (int index);
+
+    AVector3 Up() const;
+    AVector3 Down() const;
+    AVector3 Left() const;
+    AVector3 Right() const;
+    AVector3 Forward() const;
+    AVector3 Backward() const;
+
+    // out[i] = left[i] * right[i], out may be left or right. Runs on the batch kernels, see
+    // xo-math-batch.h.
+    static void XO_CC Multiply(AMatrix4x4 const* left,
+                               AMatrix4x4 const* right,
+                               AMatrix4x4* out,
+                               size_t count);
+    static AMatrix4x4 XO_CC Transpose(AMatrix4x4 const& matrixIn);
+    static AMatrix4x4 XO_CC Invert(AMatrix4x4 const& matrixIn);
+    static bool XO_CC InvertSafe(AMatrix4x4 const& matrixIn, AMatrix4x4& matrixOut);
+    // Cheaper inverses for matrices whose last column is (0, 0, 0, 1), like the ones built
+    // by Translation, Scale, the Rotation functions, LookAt and products of them.
+    // InvertAffine inverts the upper 3x3 and moves the translation row back through it.
+    // InvertOrthonormal is for rotation and translation only (no scale or shear): the
+    // 3x3 inverse is its transpose. Neither checks its input, IsAffine and IsOrthonormal
+    // can do that in an assert. IsOrthonormal allows 1e-5 of error in the dot products.
+    static AMatrix4x4 XO_CC InvertAffine(AMatrix4x4 const& matrixIn);
+    static AMatrix4x4 XO_CC InvertOrthonormal(AMatrix4x4 const& matrixIn);
+    static bool XO_CC IsAffine(AMatrix4x4 const& matrixIn);
+    static bool XO_CC IsOrthonormal(AMatrix4x4 const& matrixIn);
+    static AMatrix4x4 XO_CC Translation(AVector3 const& pos);
+    static AMatrix4x4 XO_CC Scale(AVector3 const& scale);
+    static AMatrix4x4 XO_CC RotationYaw(float yaw);
+    static AMatrix4x4 XO_CC RotationPitch(float pitch);
+    static AMatrix4x4 XO_CC RotationRoll(float roll);
+    static AMatrix4x4 XO_CC RotationYawPitchRoll(float yaw, float pitch, float roll);
+    static AMatrix4x4 XO_CC RotationAxisAngle(AVector3 const& axis, float angle);
+    static AMatrix4x4 XO_CC PerspectiveFOV(float fov,
+                                           float aspect,
+                                           float nearPlane = XO_CONFIG_DEFAULT_NEAR_PLANE,
+                                           float farPlane = XO_CONFIG_DEFAULT_FAR_PLANE);
+    static AMatrix4x4 XO_CC Perspective(float width,
+                                        float height,
+                                        float aspect,
+                                        float nearPlane = XO_CONFIG_DEFAULT_NEAR_PLANE,
+                                        float farPlane = XO_CONFIG_DEFAULT_FAR_PLANE);
+    static AMatrix4x4 XO_CC Orthographic(float width,
+                                         float height,
+                                         float nearPlane,
+                                         float farPlane);
+    static AMatrix4x4 XO_CC LookAt(AVector3 const& from,
+                                   AVector3 const& to,
+                                   AVector3 const& up = AVector3::Up);
+
+    static bool XO_CC RoughlyEqual(AMatrix4x4 const& left, AMatrix4x4 const& right);
+    static bool XO_CC ExactlyEqual(AMatrix4x4 const& left, AMatrix4x4 const& right);
+
+    static const AMatrix4x4 One;
+    static const AMatrix4x4 Zero;
+    static const AMatrix4x4 Identity;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// quaternion, aligned for cpu specific optimizations (where applicable)
+struct XO_SSE_ALN AQuaternion {
+    XO_SSE_NEW_DEL(AQuaternion);
+    union {
+        struct { float i, j, k, r; };
+        AVector4 vec4;
+    };
+
+    constexpr AQuaternion(float i, float j, float k, float r)
+        : i(i)
+        , j(j)
+        , k(k)
+        , r(r)
+    { }
+
+    constexpr explicit AQuaternion(float all)
+        : i(all)
+        , j(all)
+        , k(all)
+        , r(all)
+    { }
+
+    constexpr explicit AQuaternion(AVector4 const& v4)
+        : vec4(v4)
+    { }
+
+    AQuaternion() = default;
+    ~AQuaternion() = default;
+    AQuaternion(AQuaternion const& other) = default;
+    AQuaternion(AQuaternion&& ref) = default;
+    AQuaternion& operator = (AQuaternion const& other) = default;
+    AQuaternion& operator = (AQuaternion&& ref) = default;
+
+    AQuaternion operator + (AQuaternion other) const;
+    AQuaternion operator * (float scalar) const;
+    AQuaternion operator -() const;
+    // The Hamilton product: rotating by a * b is rotating by b, then by a.
+    AQuaternion XO_CC operator * (AQuaternion const& other) const;
+    AQuaternion& XO_CC operator *= (AQuaternion const& other);
+
+    // v rotated by this, which should be normalized. The same as ToMatrix().Transform(v),
+    // without the matrix: v + 2r(q x v) + q x 2(q x v) for the vector part q.
+    AVector3 XO_CC Rotate(AVector3 const& v) const;
+
+    float Magnitude() const;
+    float MagnitudeSquared() const;
+    AQuaternion Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+    AQuaternion& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+
+    AMatrix4x4 ToMatrix() const;
+
+    static AQuaternion XO_CC Invert(AQuaternion const& quat);
+    static AQuaternion XO_CC RotationAxisAngle(AVector3 const& axis, float angle);
+    static AQuaternion XO_CC RotationEuler(AVector3 const& angles);
+    static float XO_CC DotProduct(AQuaternion const& left, AQuaternion const& right);
+    static AQuaternion XO_CC Lerp(AQuaternion const& start, AQuaternion const& end, float t);
+    static AQuaternion XO_CC Slerp(AQuaternion const& start, 
+                                  AQuaternion const& end, 
+                                  float t);
+
+    static bool XO_CC RoughlyEqual(AQuaternion const& left, AQuaternion const& right);
+    static bool XO_CC ExactlyEqual(AQuaternion const& left, AQuaternion const& right);
+
+    static const AQuaternion Zero;
+    static const AQuaternion Identity;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////// SSE helpers
+// Unaligned types go through loadu/storeu (or lane-wise for the 12 byte Vector3). The
+// aligned types can use the full 16 bytes directly, the w lane of an AVector3 is padding.
+namespace sse {
+XO_INL __m128 XO_CC Load(Vector3 const& v)       { return _mm_set_ps(0.f, v.z, v.y, v.x); }
+XO_INL __m128 XO_CC Load(Vector4 const& v)       { return _mm_loadu_ps(v.v); }
+XO_INL __m128 XO_CC Load(Quaternion const& q)    { return _mm_loadu_ps(q.vec4.v); }
+XO_INL __m128 XO_CC Load(AVector3 const& v)      { return _mm_load_ps(&v.x); }
+XO_INL __m128 XO_CC Load(AVector4 const& v)      { return _mm_load_ps(v.v); }
+XO_INL __m128 XO_CC Load(AQuaternion const& q)   { return _mm_load_ps(q.vec4.v); }
+
+XO_INL void XO_CC Store(Vector3& v, __m128 m) {
+    _mm_storel_pi(reinterpret_cast<__m64*>(&v.x), m);
+    _mm_store_ss(&v.z, _mm_movehl_ps(m, m));
+}
+XO_INL void XO_CC Store(Vector4& v, __m128 m)       { _mm_storeu_ps(v.v, m); }
+XO_INL void XO_CC Store(Quaternion& q, __m128 m)    { _mm_storeu_ps(q.vec4.v, m); }
+XO_INL void XO_CC Store(AVector3& v, __m128 m)      { _mm_store_ps(&v.x, m); }
+XO_INL void XO_CC Store(AVector4& v, __m128 m)      { _mm_store_ps(v.v, m); }
+XO_INL void XO_CC Store(AQuaternion& q, __m128 m)   { _mm_store_ps(q.vec4.v, m); }
+
+template<typename T>
+XO_INL T XO_CC Make(__m128 m) {
+    T result;
+    Store(result, m);
+    return result;
+}
+
+template<int lane>
+XO_INL __m128 XO_CC Splat(__m128 m) {
+    return _mm_shuffle_ps(m, m, _MM_SHUFFLE(lane, lane, lane, lane));
+}
+
+XO_INL __m128 XO_CC Abs(__m128 m) {
+    return _mm_andnot_ps(_mm_set1_ps(-0.f), m);
+}
+
+// Lane-wise CloseEnough, see xo-math-utilities.h
+XO_INL int XO_CC CloseEnoughMask(__m128 left, __m128 right) {
+    __m128 scale = _mm_max_ps(_mm_set1_ps(1.f), _mm_max_ps(Abs(left), Abs(right)));
+    __m128 epsilon = _mm_mul_ps(_mm_set1_ps(MachineEpsilon), scale);
+    return _mm_movemask_ps(_mm_cmple_ps(Abs(_mm_sub_ps(left, right)), epsilon));
+}
+
+XO_INL int XO_CC ExactlyEqualMask(__m128 left, __m128 right) {
+    return _mm_movemask_ps(_mm_cmpeq_ps(left, right));
+}
+
+// a * b + c, fused when the target has FMA3
+XO_INL __m128 XO_CC MultiplyAdd(__m128 a, __m128 b, __m128 c) {
+#if XO_HAS_FMA
+    return _mm_fmadd_ps(a, b, c);
+#else
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+// 1/sqrt(m) on every lane for Precision::Fast and Fastest, see xo-math-utilities.h.
+// The Newton-Raphson step is r * (1.5 - (0.5 * m * r) * r), never forming r * r, which
+// overflows for the smallest m.
+XO_INL __m128 XO_CC InverseSqrt(__m128 m, Precision precision) {
+#if XO_SSE_CURRENT >= XO_AVX512 && defined(__AVX512VL__)
+    __m128 const scale = _mm_set1_ps(1.f);
+    __m128 r = _mm_rsqrt14_ps(m);
+#else
+    // Denormals scaled into range, see xo::rsqrt.
+    __m128 const tiny = _mm_cmplt_ps(m, _mm_set1_ps(rsqrt::Tiny));
+    m = _mm_blendv_ps(m, _mm_mul_ps(m, _mm_set1_ps(rsqrt::ScaleUp)), tiny);
+    __m128 const scale = _mm_blendv_ps(_mm_set1_ps(1.f), _mm_set1_ps(rsqrt::ScaleBack), tiny);
+    __m128 r = _mm_rsqrt_ps(m);
+#endif
+    if (precision == Precision::Fastest) {
+        return _mm_mul_ps(r, scale);
+    }
+    __m128 halfMR = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), m), r);
+    return _mm_mul_ps(_mm_mul_ps(r, scale), _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(halfMR, r)));
+}
+
+#if XO_SSE_CURRENT >= XO_AVX
+XO_INL __m256 XO_CC MultiplyAdd(__m256 a, __m256 b, __m256 c) {
+#   if XO_HAS_FMA
+    return _mm256_fmadd_ps(a, b, c);
+#   else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#   endif
+}
+#endif
+
+// left x right on the xyz lanes, w comes out as 0 for finite input.
+XO_INL __m128 XO_CC CrossProduct(__m128 left, __m128 right) {
+    __m128 lyzx = _mm_shuffle_ps(left, left, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 ryzx = _mm_shuffle_ps(right, right, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 zxy = _mm_sub_ps(_mm_mul_ps(left, ryzx), _mm_mul_ps(lyzx, right));
+    return _mm_shuffle_ps(zxy, zxy, _MM_SHUFFLE(3, 0, 2, 1));
+}
+
+// The inverse of an affine matrix, given the columns of the inverse of its upper 3x3 and
+// its translation row t. The translation of the result is -t times the 3x3 inverse.
+template<typename M>
+XO_INL M XO_CC AffineInverse(__m128 c0, __m128 c1, __m128 c2, __m128 t) {
+    __m128 c3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    __m128 d = _mm_mul_ps(Splat<0>(t), c0);
+    d = MultiplyAdd(Splat<1>(t), c1, d);
+    d = MultiplyAdd(Splat<2>(t), c2, d);
+    M result;
+    Store(result.rows[0], c0);
+    Store(result.rows[1], c1);
+    Store(result.rows[2], c2);
+    Store(result.rows[3], _mm_sub_ps(_mm_setr_ps(0.f, 0.f, 0.f, 1.f), d));
+    return result;
+}
+
+// The adjugate of the row major 4x4 matrix m, returns the determinant in every lane.
+// The inverse is the adjugate divided by the determinant.
+// This is the cofactor expansion from Intel's "Streaming SIMD Extensions - Inverse of 4x4
+// Matrix" (AP-928): the matrix is transposed into registers (with rows 1 and 3 rotated by
+// two lanes), then each pair product of two rows is shuffled against the other rows to
+// build all 16 cofactors four at a time.
+XO_INL __m128 XO_CC Adjugate(float const* m, __m128 adjugate[4]) {
+    __m128 in0 = _mm_loadu_ps(m);
+    __m128 in1 = _mm_loadu_ps(m + 4);
+    __m128 in2 = _mm_loadu_ps(m + 8);
+    __m128 in3 = _mm_loadu_ps(m + 12);
+    __m128 tmp = _mm_movelh_ps(in0, in1);
+    __m128 row1 = _mm_movelh_ps(in2, in3);
+    __m128 row0 = _mm_shuffle_ps(tmp, row1, 0x88);
+    row1 = _mm_shuffle_ps(row1, tmp, 0xDD);
+    tmp = _mm_movehl_ps(in1, in0);
+    __m128 row3 = _mm_movehl_ps(in3, in2);
+    __m128 row2 = _mm_shuffle_ps(tmp, row3, 0x88);
+    row3 = _mm_shuffle_ps(row3, tmp, 0xDD);
+
+    __m128 minor0, minor1, minor2, minor3;
+    tmp = _mm_mul_ps(row2, row3);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    minor0 = _mm_mul_ps(row1, tmp);
+    minor1 = _mm_mul_ps(row0, tmp);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor0 = _mm_sub_ps(_mm_mul_ps(row1, tmp), minor0);
+    minor1 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor1);
+    minor1 = _mm_shuffle_ps(minor1, minor1, 0x4E);
+
+    tmp = _mm_mul_ps(row1, row2);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    minor0 = MultiplyAdd(row3, tmp, minor0);
+    minor3 = _mm_mul_ps(row0, tmp);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row3, tmp));
+    minor3 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor3);
+    minor3 = _mm_shuffle_ps(minor3, minor3, 0x4E);
+
+    tmp = _mm_mul_ps(_mm_shuffle_ps(row1, row1, 0x4E), row3);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    row2 = _mm_shuffle_ps(row2, row2, 0x4E);
+    minor0 = MultiplyAdd(row2, tmp, minor0);
+    minor2 = _mm_mul_ps(row0, tmp);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row2, tmp));
+    minor2 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor2);
+    minor2 = _mm_shuffle_ps(minor2, minor2, 0x4E);
+
+    tmp = _mm_mul_ps(row0, row1);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    minor2 = MultiplyAdd(row3, tmp, minor2);
+    minor3 = _mm_sub_ps(_mm_mul_ps(row2, tmp), minor3);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor2 = _mm_sub_ps(_mm_mul_ps(row3, tmp), minor2);
+    minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row2, tmp));
+
+    tmp = _mm_mul_ps(row0, row3);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row2, tmp));
+    minor2 = MultiplyAdd(row1, tmp, minor2);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor1 = MultiplyAdd(row2, tmp, minor1);
+    minor2 = _mm_sub_ps(minor2, _mm_mul_ps(row1, tmp));
+
+    tmp = _mm_mul_ps(row0, row2);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    minor1 = MultiplyAdd(row3, tmp, minor1);
+    minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row1, tmp));
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row3, tmp));
+    minor3 = MultiplyAdd(row1, tmp, minor3);
+
+    adjugate[0] = minor0;
+    adjugate[1] = minor1;
+    adjugate[2] = minor2;
+    adjugate[3] = minor3;
+    __m128 det = _mm_mul_ps(row0, minor0);
+    det = _mm_add_ps(_mm_shuffle_ps(det, det, 0x4E), det);
+    return _mm_add_ps(_mm_shuffle_ps(det, det, 0xB1), det);
+}
+
+// out = left * right for row major 4x4 float matrices. out may alias left or right.
+// Each row of the result is the rows of right weighted by the broadcast elements of the
+// same row of left. With AVX two rows of left share one 256 bit register, and each row of
+// right is broadcast into both halves.
+XO_INL void XO_CC MultiplyMatrix(float const* left, float const* right, float* out) {
+#if XO_SSE_CURRENT >= XO_AVX
+    __m256 r0 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(right));
+    __m256 r1 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(right + 4));
+    __m256 r2 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(right + 8));
+    __m256 r3 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(right + 12));
+    __m256 l01 = _mm256_loadu_ps(left);
+    __m256 l23 = _mm256_loadu_ps(left + 8);
+
+    __m256 a01 = MultiplyAdd(_mm256_permute_ps(l01, 0x55), r1,
+                             _mm256_mul_ps(_mm256_permute_ps(l01, 0x00), r0));
+    __m256 b01 = MultiplyAdd(_mm256_permute_ps(l01, 0xFF), r3,
+                             _mm256_mul_ps(_mm256_permute_ps(l01, 0xAA), r2));
+    __m256 a23 = MultiplyAdd(_mm256_permute_ps(l23, 0x55), r1,
+                             _mm256_mul_ps(_mm256_permute_ps(l23, 0x00), r0));
+    __m256 b23 = MultiplyAdd(_mm256_permute_ps(l23, 0xFF), r3,
+                             _mm256_mul_ps(_mm256_permute_ps(l23, 0xAA), r2));
+
+    _mm256_storeu_ps(out, _mm256_add_ps(a01, b01));
+    _mm256_storeu_ps(out + 8, _mm256_add_ps(a23, b23));
+#else
+    __m128 r0 = _mm_loadu_ps(right);
+    __m128 r1 = _mm_loadu_ps(right + 4);
+    __m128 r2 = _mm_loadu_ps(right + 8);
+    __m128 r3 = _mm_loadu_ps(right + 12);
+    for (int i = 0; i < 16; i += 4) {
+        __m128 row = _mm_loadu_ps(left + i);
+        __m128 a = MultiplyAdd(Splat<1>(row), r1, _mm_mul_ps(Splat<0>(row), r0));
+        __m128 b = MultiplyAdd(Splat<3>(row), r3, _mm_mul_ps(Splat<2>(row), r2));
+        _mm_storeu_ps(out + i, _mm_add_ps(a, b));
+    }
+#endif
+}
+} // ::xo::sse
+
+////////////////////////////////////////////////////////////////////////////////////////// Vector 3
+#if defined(XO_MATH_IMPL)
+/*static*/ const Vector3 Vector3::Zero(0.f);
+/*static*/ const Vector3 Vector3::One(1.f);
+/*static*/ const Vector3 Vector3::Left(-1.f, 0.f, 0.f);
+/*static*/ const Vector3 Vector3::Right(1.f, 0.f, 0.f);
+
+#   if !defined(XO_CONFIG_Y_UP) || !defined(XO_CONFIG_Z_UP)
+    static_assert(false, 
+        "define both XO_CONFIG_Y_UP and XO_CONFIG_Z_UP. One should have a value of 1, and\
+ the other should have a value of 0");
+#   endif
+
+#   if !defined(XO_CONFIG_LEFT_HANDED) || !defined(XO_CONFIG_RIGHT_HANDED)
+    static_assert(false, 
+        "define both XO_CONFIG_LEFT_HANDED and XO_CONFIG_RIGHT_HANDED. One should have a \
+value of 1, and the other should have a value of 0");
+#   endif
+
+#   if XO_CONFIG_Y_UP
+    static_assert(XO_CONFIG_Z_UP == 0, 
+        "XO_CONFIG_Z_UP should be 0 if XO_CONFIG_Y_UP is 1");
+/*static*/ const Vector3 Vector3::Up(0.f, 1.f, 0.f);
+/*static*/ const Vector3 Vector3::Down(0.f, -1.f, 0.f);
+#       if XO_CONFIG_LEFT_HANDED
+        static_assert(XO_CONFIG_RIGHT_HANDED == 0, 
+            "XO_CONFIG_RIGHT_HANDED should be 0 if XO_CONFIG_LEFT_HANDED is 1");
+/*static*/ const Vector3 Vector3::Forward(0.f, 0.f, 1.f);
+/*static*/ const Vector3 Vector3::Backward(0.f, 0.f, -1.f);
+#       elif XO_CONFIG_RIGHT_HANDED
+        static_assert(XO_CONFIG_LEFT_HANDED == 0, 
+            "XO_CONFIG_LEFT_HANDED should be 0 if XO_CONFIG_RIGHT_HANDED is 1");
+/*static*/ const Vector3 Vector3::Forward(0.f, 0.f, -1.f);
+/*static*/ const Vector3 Vector3::Backward(0.f, 0.f, 1.f);
+#       else
+        static_assert(false, 
+            "XO_CONFIG_LEFT_HANDED or XO_CONFIG_RIGHT_HANDED should have a non zero \
+value...");
+#       endif
+#   elif XO_CONFIG_Z_UP
+// no static assert here about XO_CONFIG_Y_UP, because it's been checked.
+/*static*/ const Vector3 Vector3::Up(0.f, 0.f, 1.f);
+/*static*/ const Vector3 Vector3::Down(0.f, 0.f, -1.f);
+#       if XO_CONFIG_LEFT_HANDED
+        static_assert(XO_CONFIG_RIGHT_HANDED == 0, 
+            "XO_CONFIG_RIGHT_HANDED should be 0 if XO_CONFIG_LEFT_HANDED is 1");
+/*static*/ const Vector3 Vector3::Forward(0.f, -1.f, 0.f);
+/*static*/ const Vector3 Vector3::Backward(0.f, 1.f, 0.f);
+#       elif XO_CONFIG_RIGHT_HANDED
+        static_assert(XO_CONFIG_LEFT_HANDED == 0, 
+            "XO_CONFIG_LEFT_HANDED should be 0 if XO_CONFIG_RIGHT_HANDED is 1");
+/*static*/ const Vector3 Vector3::Forward(0.f, 1.f, 0.f);
+/*static*/ const Vector3 Vector3::Backward(0.f, -1.f, 0.f);
+#       else
+        static_assert(false,
+            "XO_CONFIG_LEFT_HANDED or XO_CONFIG_RIGHT_HANDED should have a non zero \
+value...");
+#       endif
+#   else
+    static_assert(false,
+        "XO_CONFIG_Y_UP or XO_CONFIG_Z_UP should have a non zero value...");
+#   endif
+#endif
+
+XO_INL
+Vector3 XO_CC Vector3::operator + (Vector3 const& other) const {
+    return sse::Make<Vector3>(_mm_add_ps(sse::Load(*this), sse::Load(other)));
+}
+
+XO_INL
+Vector3 XO_CC Vector3::operator - (Vector3 const& other) const {
+    return sse::Make<Vector3>(_mm_sub_ps(sse::Load(*this), sse::Load(other)));
+}
+
+XO_INL
+Vector3 XO_CC Vector3::operator * (Vector3 const& other) const {
+    return sse::Make<Vector3>(_mm_mul_ps(sse::Load(*this), sse::Load(other)));
+}
+
+XO_INL
+Vector3 XO_CC Vector3::operator / (Vector3 const& other) const {
+    return sse::Make<Vector3>(_mm_div_ps(sse::Load(*this), sse::Load(other)));
+}
+
+XO_INL
+Vector3& XO_CC Vector3::operator += (Vector3 const& other) {
+    sse::Store(*this, _mm_add_ps(sse::Load(*this), sse::Load(other)));
+    return *this;
+}
+
+XO_INL
+Vector3& XO_CC Vector3::operator -= (Vector3 const& other) {
+    sse::Store(*this, _mm_sub_ps(sse::Load(*this), sse::Load(other)));
+    return *this;
+}
+
+XO_INL
+Vector3& XO_CC Vector3::operator *= (Vector3 const& other) {
+    sse::Store(*this, _mm_mul_ps(sse::Load(*this), sse::Load(other)));
+    return *this;
+}
+
+XO_INL
+Vector3& XO_CC Vector3::operator /= (Vector3 const& other) {
+    sse::Store(*this, _mm_div_ps(sse::Load(*this), sse::Load(other)));
+    return *this;
+}
+
+XO_INL Vector3 Vector3::operator -() const {
+    return sse::Make<Vector3>(_mm_xor_ps(sse::Load(*this), _mm_set1_ps(-0.f)));
+}
+
+XO_INL float Vector3::Sum() const {
+    return _mm_cvtss_f32(_mm_dp_ps(sse::Load(*this), _mm_set1_ps(1.f), 0x71));
+}
+
+XO_INL float Vector3::MagnitudeSquared() const {
+    __m128 m = sse::Load(*this);
+    return _mm_cvtss_f32(_mm_dp_ps(m, m, 0x71));
+}
+
+XO_INL float Vector3::Magnitude() const {
+    __m128 m = sse::Load(*this);
+    return _mm_cvtss_f32(_mm_sqrt_ss(_mm_dp_ps(m, m, 0x71)));
+}
+
+XO_INL Vector3& Vector3::Normalize(Precision precision) {
+    __m128 m = sse::Load(*this);
+    __m128 magnitudeSquared = _mm_dp_ps(m, m, 0x7F);
+    if (precision == Precision::Exact) {
+        sse::Store(*this, _mm_div_ps(m, _mm_sqrt_ps(magnitudeSquared)));
+    }
+    else {
+        sse::Store(*this, _mm_mul_ps(m, sse::InverseSqrt(magnitudeSquared, precision)));
+    }
+    return *this;
+}
+
+XO_INL Vector3 Vector3::Normalized(Precision precision) const { return Vector3(*this).Normalize(precision); }
+
+/*static*/ XO_INL
+bool XO_CC Vector3::RoughlyEqual(Vector3 const& left, Vector3 const& right) {
+    return (sse::CloseEnoughMask(sse::Load(left), sse::Load(right)) & 0x7) == 0x7;
+}
+
+/*static*/ XO_INL
+bool XO_CC Vector3::ExactlyEqual(Vector3 const& left, Vector3 const& right) {
+    return (sse::ExactlyEqualMask(sse::Load(left), sse::Load(right)) & 0x7) == 0x7;
+}
+
+/*static*/ XO_INL
+bool XO_CC Vector3::RoughlyEqual(Vector3 const& left, float magnitude) {
+    return CloseEnough(left.MagnitudeSquared(), Pow<2>(magnitude));
+}
+
+/*static*/ XO_INL
+bool XO_CC Vector3::ExactlyEqual(Vector3 const& left, float magnitude) {
+    return left.MagnitudeSquared() == Pow<2>(magnitude);
+}
+
+/*static*/ XO_INL
+float XO_CC Vector3::DotProduct(Vector3 const& left, Vector3 const& right) {
+    return _mm_cvtss_f32(_mm_dp_ps(sse::Load(left), sse::Load(right), 0x71));
+}
+
+/*static*/ XO_INL
+Vector3 XO_CC Vector3::CrossProduct(Vector3 const& left, Vector3 const& right) {
+    // (l * r.yzx - l.yzx * r).yzx
+    __m128 l = sse::Load(left);
+    __m128 r = sse::Load(right);
+    __m128 lyzx = _mm_shuffle_ps(l, l, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 ryzx = _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 zxy = _mm_sub_ps(_mm_mul_ps(l, ryzx), _mm_mul_ps(lyzx, r));
+    return sse::Make<Vector3>(_mm_shuffle_ps(zxy, zxy, _MM_SHUFFLE(3, 0, 2, 1)));
+}
+
+/*static*/ XO_INL
+Vector3 XO_CC Vector3::Lerp(Vector3 const& left, Vector3 const& right, float t) {
+    __m128 l = sse::Load(left);
+    __m128 r = sse::Load(right);
+    return sse::Make<Vector3>(_mm_add_ps(l, _mm_mul_ps(_mm_set1_ps(t), _mm_sub_ps(r, l))));
+}
+
+/*static*/ XO_INL
+float XO_CC Vector3::DistanceSquared(Vector3 const& left, Vector3 const& right) {
+    return (right - left).MagnitudeSquared();
+}
+
+/*static*/ XO_INL
+float XO_CC Vector3::Distance(Vector3 const& left, Vector3 const& right) {
+    return (right - left).Magnitude();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////// Vector 4
+
+XO_INL
+Vector4 XO_CC Vector4::operator + (Vector4 const& other) const {
+    return sse::Make<Vector4>(_mm_add_ps(sse::Load(*this), sse::Load(other)));
+}
+
+XO_INL
+Vector4 XO_CC Vector4::operator - (Vector4 const& other) const {
+    return sse::Make<Vector4>(_mm_sub_ps(sse::Load(*this), sse::Load(other)));
+}
+
+XO_INL
+Vector4 XO_CC Vector4::operator * (Vector4 const& other) const {
+    return sse::Make<Vector4>(_mm_mul_ps(sse::Load(*this), sse::Load(other)));
+}
+
+XO_INL
+Vector4 XO_CC Vector4::operator / (Vector4 const& other) const {
+    return sse::Make<Vector4>(_mm_div_ps(sse::Load(*this), sse::Load(other)));
+}
+
+XO_INL
+Vector4& XO_CC Vector4::operator += (Vector4 const& other) {
+    sse::Store(*this, _mm_add_ps(sse::Load(*this), sse::Load(other)));
+    return *this;
+}
+
+XO_INL
+Vector4& XO_CC Vector4::operator -= (Vector4 const& other) {
+    sse::Store(*this, _mm_sub_ps(sse::Load(*this), sse::Load(other)));
+    return *this;
+}
+
+XO_INL
+Vector4& XO_CC Vector4::operator *= (Vector4 const& other) {
+    sse::Store(*this, _mm_mul_ps(sse::Load(*this), sse::Load(other)));
+    return *this;
+}
+
+XO_INL
+Vector4& XO_CC Vector4::operator /= (Vector4 const& other) {
+    sse::Store(*this, _mm_div_ps(sse::Load(*this), sse::Load(other)));
+    return *this;
+}
+
+XO_INL Vector4 Vector4::operator -() const {
+    return sse::Make<Vector4>(_mm_xor_ps(sse::Load(*this), _mm_set1_ps(-0.f)));
+}
+
+XO_INL float Vector4::operator[] (int index) const { return v[index]; }
+XO_INL float& Vector4::operator[] (int index) { return v[index]; }
+
+XO_INL float Vector4::Sum() const {
+    return _mm_cvtss_f32(_mm_dp_ps(sse::Load(*this), _mm_set1_ps(1.f), 0xF1));
+}
+
+XO_INL float Vector4::MagnitudeSquared() const {
+    __m128 m = sse::Load(*this);
+    return _mm_cvtss_f32(_mm_dp_ps(m, m, 0xF1));
+}
+
+XO_INL float Vector4::Magnitude() const {
+    __m128 m = sse::Load(*this);
+    return _mm_cvtss_f32(_mm_sqrt_ss(_mm_dp_ps(m, m, 0xF1)));
+}
+
+XO_INL Vector4 Vector4::Normalized(Precision precision) const { return Vector4(*this).Normalize(precision); }
+
+XO_INL Vector4& Vector4::Normalize(Precision precision) {
+    __m128 m = sse::Load(*this);
+    __m128 magnitudeSquared = _mm_dp_ps(m, m, 0xFF);
+    if (precision == Precision::Exact) {
+        sse::Store(*this, _mm_div_ps(m, _mm_sqrt_ps(magnitudeSquared)));
+    }
+    else {
+        sse::Store(*this, _mm_mul_ps(m, sse::InverseSqrt(magnitudeSquared, precision)));
+    }
+    return *this;
+}
+
+/*static*/ XO_INL
+bool XO_CC Vector4::RoughlyEqual(Vector4 const& left, Vector4 const& right) {
+    return sse::CloseEnoughMask(sse::Load(left), sse::Load(right)) == 0xF;
+}
+
+/*static*/ XO_INL
+bool XO_CC Vector4::ExactlyEqual(Vector4 const& left, Vector4 const& right) {
+    return sse::ExactlyEqualMask(sse::Load(left), sse::Load(right)) == 0xF;
+}
+
+/*static*/ XO_INL
+bool XO_CC Vector4::RoughlyEqual(Vector4 const& left, float magnitude) {
+    return CloseEnough(left.MagnitudeSquared(), Pow<2>(magnitude));
+}
+
+/*static*/ XO_INL
+bool XO_CC Vector4::ExactlyEqual(Vector4 const& left, float magnitude) {
+    return left.MagnitudeSquared() == Pow<2>(magnitude);
+}
+
+/*static*/ XO_INL
+float XO_CC Vector4::DotProduct(Vector4 const& left, Vector4 const& right) {
+    return _mm_cvtss_f32(_mm_dp_ps(sse::Load(left), sse::Load(right), 0xF1));
+}
+
+/*static*/ XO_INL
+Vector4 XO_CC Vector4::Lerp(Vector4 const& left, Vector4 const& right, float t) {
+    __m128 l = sse::Load(left);
+    __m128 r = sse::Load(right);
+    return sse::Make<Vector4>(_mm_add_ps(l, _mm_mul_ps(_mm_set1_ps(t), _mm_sub_ps(r, l))));
+}
+
+#if defined(XO_MATH_IMPL)
+/*static*/ const Vector4 Vector4::Zero(0.f);
+/*static*/ const Vector4 Vector4::One(1.f);
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////// Matrix4x4
+
+#if defined(XO_MATH_IMPL)
+/*static*/ const Matrix4x4 Matrix4x4::One(1.f);
+/*static*/ const Matrix4x4 Matrix4x4::Zero(0.f);
+/*static*/ const Matrix4x4 Matrix4x4::Identity(
+    Vector4(1.f, 0.f, 0.f, 0.f),
+    Vector4(0.f, 1.f, 0.f, 0.f),
+    Vector4(0.f, 0.f, 1.f, 0.f),
+    Vector4(0.f, 0.f, 0.f, 1.f));
+#endif
+
+XO_INL
+Vector3 XO_CC Matrix4x4::Transform(Vector3 const& v3) const {
+    // w is implicitly 0, so the dot products only read xyz.
+    __m128 v = sse::Load(v3);
+    __m128 x = _mm_dp_ps(sse::Load(rows[0]), v, 0x71);
+    __m128 y = _mm_dp_ps(sse::Load(rows[1]), v, 0x72);
+    __m128 z = _mm_dp_ps(sse::Load(rows[2]), v, 0x74);
+    return sse::Make<Vector3>(_mm_or_ps(_mm_or_ps(x, y), z));
+}
+
+XO_INL
+Vector4 XO_CC Matrix4x4::Transform(Vector4 const& v4) const {
+    __m128 v = sse::Load(v4);
+    __m128 x = _mm_dp_ps(sse::Load(rows[0]), v, 0xF1);
+    __m128 y = _mm_dp_ps(sse::Load(rows[1]), v, 0xF2);
+    __m128 z = _mm_dp_ps(sse::Load(rows[2]), v, 0xF4);
+    __m128 w = _mm_dp_ps(sse::Load(rows[3]), v, 0xF8);
+    return sse::Make<Vector4>(_mm_or_ps(_mm_or_ps(x, y), _mm_or_ps(z, w)));
+}
+
+XO_INL
+Vector3 XO_CC Matrix4x4::InverseTransform(Vector3 const& v3) const {
+    __m128 v = sse::Load(v3);
+    __m128 r = _mm_mul_ps(sse::Splat<0>(v), sse::Load(rows[0]));
+    r = sse::MultiplyAdd(sse::Splat<1>(v), sse::Load(rows[1]), r);
+    r = sse::MultiplyAdd(sse::Splat<2>(v), sse::Load(rows[2]), r);
+    return sse::Make<Vector3>(r);
+}
+
+XO_INL
+Vector4 XO_CC Matrix4x4::InverseTransform(Vector4 const& v4) const {
+    __m128 v = sse::Load(v4);
+    __m128 r = _mm_mul_ps(sse::Splat<0>(v), sse::Load(rows[0]));
+    r = sse::MultiplyAdd(sse::Splat<1>(v), sse::Load(rows[1]), r);
+    r = sse::MultiplyAdd(sse::Splat<2>(v), sse::Load(rows[2]), r);
+    r = sse::MultiplyAdd(sse::Splat<3>(v), sse::Load(rows[3]), r);
+    return sse::Make<Vector4>(r);
+}
+
+XO_INL
+Matrix4x4 XO_CC Matrix4x4::operator * (Matrix4x4 const& other) const {
+    return Matrix4x4(*this) *= other;
+}
+
+XO_INL
+Matrix4x4& XO_CC Matrix4x4::operator *= (Matrix4x4 const& other) {
+    sse::MultiplyMatrix(v, other.v, v);
+    return *this;
+}
+
+XO_INL Vector4 Matrix4x4::operator[] (int index) const { return rows[index]; }
+XO_INL Vector4& Matrix4x4::operator[] (int index) { return rows[index]; }
+
+XO_INL
+Vector3 Matrix4x4::Up() const {
+#if defined(XO_CONFIG_Y_UP) && XO_CONFIG_Y_UP
+    return Vector3(rows[1][0], rows[1][1], rows[1][2]);
+#elif defined(XO_CONFIG_Z_UP) && XO_CONFIG_Z_UP
+    return Vector3(rows[2][0], rows[2][1], rows[2][2]);
+#else
+    static_assert(false, "Define XO_CONFIG_Y_UP and XO_CONFIG_Z_UP. One should have a \
+value of 1, the other should have a value of 0.");
+#endif
+}
+
+XO_INL
+Vector3 Matrix4x4::Down() const {
+    return -Up();
+}
+
+XO_INL
+Vector3 Matrix4x4::Left() const {
+    return -Right();
+}
+XO_INL
+Vector3 Matrix4x4::Right() const {
+    return Vector3(rows[0][0], rows[0][1], rows[0][2]);
+}
+
+XO_INL
+Vector3 Matrix4x4::Forward() const {
+#if defined(XO_CONFIG_Y_UP) && XO_CONFIG_Y_UP
+#   if defined(XO_CONFIG_LEFT_HANDED) && XO_CONFIG_LEFT_HANDED
+    return Vector3(rows[2][0], rows[2][1], rows[2][2]);
+#   elif defined(XO_CONFIG_RIGHT_HANDED) && XO_CONFIG_RIGHT_HANDED
+    return Vector3(-rows[2][0], -rows[2][1], -rows[2][2]);
+#   else
+    static_assert(false, "Define XO_CONFIG_LEFT_HANDED and XO_CONFIG_RIGHT_HANDED. One \
+should have a value of 1, the other should have a value of 0.");
+#   endif
+#elif defined(XO_CONFIG_Z_UP) && XO_CONFIG_Z_UP
+#   if defined(XO_CONFIG_LEFT_HANDED) && XO_CONFIG_LEFT_HANDED
+    return Vector3(-rows[1][0], -rows[1][1], -rows[1][2]);
+#   elif defined(XO_CONFIG_RIGHT_HANDED) && XO_CONFIG_RIGHT_HANDED
+    return Vector3(rows[1][0], rows[1][1], rows[1][2]);
+#   else
+    static_assert(false, "Define XO_CONFIG_LEFT_HANDED and XO_CONFIG_RIGHT_HANDED. One \
+should have a value of 1, the other should have a value of 0.");
+#   endif
+#else
+    static_assert(false, "Define XO_CONFIG_Y_UP and XO_CONFIG_Z_UP. One should have a \
+value of 1, the other should have a value of 0.");
+#endif
+}
+
+XO_INL
+Vector3 Matrix4x4::Backward() const {
+    return -Forward();
+}
+
+/*static*/ XO_INL
+Matrix4x4 XO_CC Matrix4x4::Transpose(Matrix4x4 const& matrixIn) {
+    __m128 r0 = sse::Load(matrixIn.rows[0]);
+    __m128 r1 = sse::Load(matrixIn.rows[1]);
+    __m128 r2 = sse::Load(matrixIn.rows[2]);
+    __m128 r3 = sse::Load(matrixIn.rows[3]);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    Matrix4x4 transposed;
+    sse::Store(transposed.rows[0], r0);
+    sse::Store(transposed.rows[1], r1);
+    sse::Store(transposed.rows[2], r2);
+    sse::Store(transposed.rows[3], r3);
+    return transposed;
+}
+
+/*static*/ XO_INL 
+Matrix4x4 XO_CC Matrix4x4::Invert(Matrix4x4 const& matrixIn) {
+    __m128 adjugate[4];
+    __m128 invDet = _mm_div_ps(_mm_set1_ps(1.f), sse::Adjugate(matrixIn.v, adjugate));
+    Matrix4x4 inverted;
+    for (int i = 0; i < 4; ++i) {
+        sse::Store(inverted.rows[i], _mm_mul_ps(adjugate[i], invDet));
+    }
+    return inverted;
+}
+
+/*static*/ XO_INL
+bool XO_CC Matrix4x4::InvertSafe(Matrix4x4 const& matrixIn, Matrix4x4& matrixOut) {
+    __m128 adjugate[4];
+    __m128 det = sse::Adjugate(matrixIn.v, adjugate);
+    if (CloseEnough(_mm_cvtss_f32(det), 0.f))
+        return false;
+    __m128 invDet = _mm_div_ps(_mm_set1_ps(1.f), det);
+    for (int i = 0; i < 4; ++i) {
+        sse::Store(matrixOut.rows[i], _mm_mul_ps(adjugate[i], invDet));
+    }
+    return true;
+}
+
+/*static*/ XO_INL
+Matrix4x4 XO_CC Matrix4x4::InvertAffine(Matrix4x4 const& matrixIn) {
+    // The columns of the 3x3 inverse are c0 = a1 x a2, c1 = a2 x a0 and c2 = a0 x a1 over
+    // the determinant a0 . c0.
+    __m128 a0 = sse::Load(matrixIn.rows[0]);
+    __m128 a1 = sse::Load(matrixIn.rows[1]);
+    __m128 a2 = sse::Load(matrixIn.rows[2]);
+    __m128 c0 = sse::CrossProduct(a1, a2);
+    __m128 c1 = sse::CrossProduct(a2, a0);
+    __m128 c2 = sse::CrossProduct(a0, a1);
+    __m128 invDet = _mm_div_ps(_mm_set1_ps(1.f), _mm_dp_ps(a0, c0, 0x7F));
+    return sse::AffineInverse<Matrix4x4>(_mm_mul_ps(c0, invDet), _mm_mul_ps(c1, invDet),
+                                   _mm_mul_ps(c2, invDet), sse::Load(matrixIn.rows[3]));
+}
+
+/*static*/ XO_INL
+Matrix4x4 XO_CC Matrix4x4::InvertOrthonormal(Matrix4x4 const& matrixIn) {
+    // The columns of the 3x3 inverse are the rows.
+    return sse::AffineInverse<Matrix4x4>(sse::Load(matrixIn.rows[0]), sse::Load(matrixIn.rows[1]),
+                                   sse::Load(matrixIn.rows[2]), sse::Load(matrixIn.rows[3]));
+}
+
+/*static*/ XO_INL
+bool XO_CC Matrix4x4::IsAffine(Matrix4x4 const& matrixIn) {
+    return CloseEnough(matrixIn.v[3], 0.f) && CloseEnough(matrixIn.v[7], 0.f)
+        && CloseEnough(matrixIn.v[11], 0.f) && CloseEnough(matrixIn.v[15], 1.f);
+}
+
+/*static*/ XO_INL
+bool XO_CC Matrix4x4::IsOrthonormal(Matrix4x4 const& matrixIn) {
+    Vector3 a0(matrixIn.v[0], matrixIn.v[1], matrixIn.v[2]);
+    Vector3 a1(matrixIn.v[4], matrixIn.v[5], matrixIn.v[6]);
+    Vector3 a2(matrixIn.v[8], matrixIn.v[9], matrixIn.v[10]);
+    float const tolerance = 1e-5f;
+    return IsAffine(matrixIn)
+        && Abs(a0.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(a1.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(a2.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(Vector3::DotProduct(a0, a1)) <= tolerance
+        && Abs(Vector3::DotProduct(a1, a2)) <= tolerance
+        && Abs(Vector3::DotProduct(a2, a0)) <= tolerance;
+}
+
+/*static*/ XO_INL 
+Matrix4x4 XO_CC Matrix4x4::Translation(Vector3 const& pos) {
+    return Matrix4x4(
+        Vector4(1.f,   0.f,   0.f,   0.f),
+        Vector4(0.f,   1.f,   0.f,   0.f),
+        Vector4(0.f,   0.f,   1.f,   0.f),
+        Vector4(pos.x, pos.y, pos.z, 1.f));
+}
+
+/*static*/ XO_INL 
+Matrix4x4 XO_CC Matrix4x4::Scale(Vector3 const& scale) {
+    return Matrix4x4(
+        Vector4(scale.x, 0.f,     0.f,     0.f),
+        Vector4(0.f,     scale.y, 0.f,     0.f),
+        Vector4(0.f,     0.f,     scale.z, 0.f),
+        Vector4(0.f,     0.f,     0.f,     1.f));
+}
+
+/*static*/ XO_INL 
+Matrix4x4 XO_CC Matrix4x4::RotationYaw(float yaw) {
+    float s, c;
+    SinCos(yaw, s, c);
+    return Matrix4x4(
+        Vector4(c,   0.f, -s,  0.f),
+        Vector4(0.f, 1.f, 0.f, 0.f),
+        Vector4(s,   0.f, c,   0.f),
+        Vector4(0.f, 0.f, 0.f, 1.f));
+}
+
+/*static*/ XO_INL
+Matrix4x4 XO_CC Matrix4x4::RotationPitch(float pitch) {
+    float s, c;
+    SinCos(pitch, s, c);
+    return Matrix4x4(
+        Vector4(1.f, 0.f, 0.f, 0.f),
+        Vector4(0.f, c,   -s,  0.f),
+        Vector4(0.f, s,   c,   0.f),
+        Vector4(0.f, 0.f, 0.f, 1.f));
+}
+
+/*static*/ XO_INL 
+Matrix4x4 XO_CC Matrix4x4::RotationRoll(float roll) {
+    float s, c;
+    SinCos(roll, s, c);
+    return Matrix4x4(
+        Vector4(c,   -s,  0.f, 0.f),
+        Vector4(s,   c,   0.f, 0.f),
+        Vector4(0.f, 0.f, 1.f, 0.f),
+        Vector4(0.f, 0.f, 0.f, 1.f));
+}
+
+/*static*/ XO_INL 
+Matrix4x4 XO_CC Matrix4x4::RotationYawPitchRoll(float yaw, float pitch, float roll) {
+    return RotationYaw(yaw) * RotationPitch(pitch) * RotationRoll(roll);
+}
+
+/*static*/ XO_INL
+Matrix4x4 XO_CC Matrix4x4::RotationAxisAngle(Vector3 const& axis, float angle) {
+    float s, c;
+    SinCos(angle, s, c);
+    float t = 1.f - c;
+    Vector3 a = axis.Normalized();
+    Matrix4x4 rotation(Matrix4x4::Identity);
+
+    rotation[0][0] = c + a.x*a.x*t;
+    rotation[1][1] = c + a.y*a.y*t;
+    rotation[2][2] = c + a.z*a.z*t;
+
+    float tmp1 = a.x*a.y*t;
+    float tmp2 = a.z*s;
+    rotation[1][0] = tmp1 + tmp2;
+    rotation[0][1] = tmp1 - tmp2;
+    
+    tmp1 = a.x*a.z*t;
+    tmp2 = a.y*s;
+    rotation[2][0] = tmp1 - tmp2;
+    rotation[0][2] = tmp1 + tmp2;    tmp1 = a.y*a.z*t;
+
+    tmp2 = a.x*s;
+    rotation[2][1] = tmp1 + tmp2;
+    rotation[1][2] = tmp1 - tmp2;
+
+    return rotation;
+}
+
+/*static*/ XO_INL 
+Matrix4x4 XO_CC Matrix4x4::PerspectiveFOV(float fov, 
+                                          float aspect, 
+                                          float nearPlane, 
+                                          float farPlane) {
+    float s, c;
+    SinCos(fov*0.5f, s, c);
+    float h = c / s;                             // height
+    float w = h / aspect;                        // width
+    float r = farPlane / (nearPlane - farPlane); // range
+    float rn = r * nearPlane;                    // range*near
+    return Matrix4x4(
+        Vector4(w,   0.f, 0.f, 0.f),
+        Vector4(0.f, h,   0.f, 0.f),
+        Vector4(0.f, 0.f, r,  -1.f),
+        Vector4(0.f, 0.f, rn,  0.f));
+}
+
+/*static*/ XO_INL 
+Matrix4x4 XO_CC Matrix4x4::Perspective(float width,
+                                       float height, 
+                                       float aspect, 
+                                       float nearPlane, 
+                                       float farPlane) {
+    XO_UNUSED(aspect);   // width / height already give it
+    float n2 = Pow<2>(nearPlane);
+    float r = farPlane / (nearPlane - farPlane);
+    float w = n2 / width;
+    float h = n2 / height;
+    float rn = r * nearPlane;
+    return Matrix4x4(
+        Vector4(w,   0.f, 0.f, 0.f),
+        Vector4(0.f, h,   0.f, 0.f),
+        Vector4(0.f, 0.f, r,  -1.f),
+        Vector4(0.f, 0.f, rn,  0.f));
+}
+
+/*static*/ XO_INL
+Matrix4x4 XO_CC Matrix4x4::Orthographic(float width,
+                                        float height,
+                                        float nearPlane,
+                                        float farPlane) {
+    float r = 1.f / (nearPlane - farPlane);
+    float w = 2.f / width;
+    float h = 2.f / height;
+    float rn = r * nearPlane;
+    return Matrix4x4(
+        Vector4(w, 0.f, 0.f, 0.f),
+        Vector4(0.f, h, 0.f, 0.f),
+        Vector4(0.f, 0.f, r, 0.f),
+        Vector4(0.f, 0.f, rn, 0.f));
+}
+
+/*static*/ XO_INL
+Matrix4x4 XO_CC Matrix4x4::LookAt(Vector3 const& from,
+                                  Vector3 const& to, 
+                                  Vector3 const& up) {
+    Vector3 dir = from - to;
+    Vector3 r2 = dir.Normalized();
+    Vector3 r0 = Vector3::CrossProduct(up, r2).Normalized();
+    Vector3 r1 = Vector3::CrossProduct(r2, r0);
+
+    float d0 = -Vector3::DotProduct(r0, from);
+    float d1 = -Vector3::DotProduct(r1, from);
+    float d2 = -Vector3::DotProduct(r2, from);
+    return Matrix4x4(
+        Vector4(r0.x, r1.x, r2.x, 0.f),
+        Vector4(r0.y, r1.y, r2.y, 0.f),
+        Vector4(r0.z, r1.z, r2.z, 0.f),
+        Vector4(d0,   d1,   d2,   1.f));
+}
+
+/*static*/ XO_INL 
+bool XO_CC Matrix4x4::RoughlyEqual(Matrix4x4 const& left, Matrix4x4 const& right) {
+    return Vector4::RoughlyEqual(left[0], right[0])
+        && Vector4::RoughlyEqual(left[1], right[1])
+        && Vector4::RoughlyEqual(left[2], right[2])
+        && Vector4::RoughlyEqual(left[3], right[3]);
+}
+
+/*static*/ XO_INL 
+bool XO_CC Matrix4x4::ExactlyEqual(Matrix4x4 const& left, Matrix4x4 const& right) {
+    return Vector4::ExactlyEqual(left[0], right[0])
+        && Vector4::ExactlyEqual(left[1], right[1])
+        && Vector4::ExactlyEqual(left[2], right[2])
+        && Vector4::ExactlyEqual(left[3], right[3]);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////// Quaternion
+#if defined(XO_MATH_IMPL)
+/*static*/ const Quaternion Quaternion::Zero(0.f);
+/*static*/ const Quaternion Quaternion::Identity(0.f, 0.f, 0.f, 1.f);
+#endif
+
+XO_INL
+Quaternion Quaternion::operator + (Quaternion other) const {
+    return sse::Make<Quaternion>(_mm_add_ps(sse::Load(*this), sse::Load(other)));
+}
+
+XO_INL
+Quaternion Quaternion::operator *(float s) const {
+    return sse::Make<Quaternion>(_mm_mul_ps(sse::Load(*this), _mm_set1_ps(s)));
+}
+
+XO_INL
+Quaternion Quaternion::operator -() const {
+    return sse::Make<Quaternion>(_mm_xor_ps(sse::Load(*this), _mm_set1_ps(-0.f)));
+}
+
+XO_INL
+Quaternion XO_CC Quaternion::operator * (Quaternion const& other) const {
+    // Each lane of this times a shuffled, sign flipped copy of other, see the reference
+    // backend for the scalar form.
+    __m128 a = sse::Load(*this);
+    __m128 b = sse::Load(other);
+    __m128 rkji = _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3));
+    __m128 krij = _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2));
+    __m128 jirk = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 result = _mm_mul_ps(sse::Splat<3>(a), b);
+    result = sse::MultiplyAdd(sse::Splat<0>(a), _mm_xor_ps(rkji, _mm_setr_ps(0.f, -0.f, 0.f, -0.f)), result);
+    result = sse::MultiplyAdd(sse::Splat<1>(a), _mm_xor_ps(krij, _mm_setr_ps(0.f, 0.f, -0.f, -0.f)), result);
+    result = sse::MultiplyAdd(sse::Splat<2>(a), _mm_xor_ps(jirk, _mm_setr_ps(-0.f, 0.f, 0.f, -0.f)), result);
+    return sse::Make<Quaternion>(result);
+}
+
+XO_INL
+Quaternion& XO_CC Quaternion::operator *= (Quaternion const& other) {
+    return *this = *this * other;
+}
+
+XO_INL
+Vector3 XO_CC Quaternion::Rotate(Vector3 const& v) const {
+    // The cross products see r in the w lane, against the 0 w of v and t, so w stays 0.
+    __m128 q = sse::Load(*this);
+    __m128 m = sse::Load(v);
+    __m128 t = sse::CrossProduct(q, m);
+    t = _mm_add_ps(t, t);
+    __m128 result = sse::MultiplyAdd(sse::Splat<3>(q), t, m);
+    return sse::Make<Vector3>(_mm_add_ps(result, sse::CrossProduct(q, t)));
+}
+
+XO_INL
+float Quaternion::Magnitude() const {
+    return vec4.Magnitude();
+}
+
+XO_INL
+float Quaternion::MagnitudeSquared() const {
+    return vec4.MagnitudeSquared();
+};
+
+XO_INL
+Quaternion Quaternion::Normalized(Precision precision) const {
+    return Quaternion(vec4.Normalized(precision));
+};
+
+XO_INL
+Quaternion& Quaternion::Normalize(Precision precision) {
+    vec4.Normalize(precision); return *this;
+};
+
+XO_INL
+Matrix4x4 Quaternion::ToMatrix() const {
+    // See: https://www.flipcode.com/documents/matrfaq.html#Q54
+    float ii = i * i;
+    float ij = i * j;
+    float ik = i * k;
+    float ir = i * r;
+    float jj = j * j;
+    float jk = j * k;
+    float jr = j * r;
+    float kk = k * k;
+    float kr = k * r;
+    return Matrix4x4(
+        Vector4(1.f - 2.f * (jj + kk), 2.f * (ij - kr), 2.f * (ik + jr), 0.f),
+        Vector4(2.f * (ij + kr), 1.f - 2.f * (ii + kk), 2.f * (jk - ir), 0.f),
+        Vector4(2.f * (ik - jr), 2.f * (jk + ir), 1.f - 2.f * (ii + jj), 0.f),
+        Vector4(0.f, 0.f, 0.f, 1.f));
+}
+
+/*static*/ XO_INL
+Quaternion XO_CC Quaternion::Invert(Quaternion const& quat) {
+    return sse::Make<Quaternion>(_mm_xor_ps(sse::Load(quat), _mm_set_ps(0.f, -0.f, -0.f, -0.f)));
+}
+
+/*static*/ XO_INL
+Quaternion XO_CC Quaternion::RotationAxisAngle(Vector3 const& axis, float angle) {
+    float s, c;
+    SinCos(angle*0.5f, s, c);
+    return Quaternion(axis.x*s, axis.y*s, axis.z*s, c);
+}
+
+/*static*/ XO_INL
+Quaternion XO_CC Quaternion::RotationEuler(Vector3 const& angles) {
+    float sr, cp, sp, cy, sy, cr;
+    SinCos(angles.x * 0.5f, sy, cy);
+    SinCos(angles.y * 0.5f, sp, cp);
+    SinCos(angles.z * 0.5f, sr, cr);
+    return Quaternion(cy * cr * cp + sy * sr * sp,
+                      cy * sr * cp - sy * cr * sp,
+                      cy * cr * sp + sy * sr * cp,
+                      sy * cr * cp - cy * sr * sp);
+}
+
+/*static*/ XO_INL
+float XO_CC Quaternion::DotProduct(Quaternion const& left, Quaternion const& right) {
+    return Vector4::DotProduct(left.vec4, right.vec4);
+}
+
+/*static*/ XO_INL
+Quaternion XO_CC Quaternion::Lerp(Quaternion const& start,
+                                  Quaternion const& end,
+                                  float t) {
+    return Quaternion(Vector4::Lerp(start.vec4, end.vec4, t));
+}
+
+/*static*/ XO_INL
+Quaternion XO_CC Quaternion::Slerp(Quaternion const& start, 
+                                   Quaternion const& end, 
+                                   float t) {
+    Quaternion s = start.Normalized();
+    Quaternion e = end.Normalized();
+    float d = Quaternion::DotProduct(s, e);
+    if (d < 0.f) {
+        e = -e;
+        d = -d;
+    }
+
+    if (CloseEnough(d, 1.f)) {
+        return Lerp(s, e, t).Normalize();
+    }
+
+    float th0 = ACos(d);
+    float th = th0 * t;
+
+    float st, ct, sth0;
+    SinCos(th, st, ct);
+    sth0 = Sin(th0);
+    float s0 = ct - d * st / sth0;
+    float s1 = st / sth0;
+    return (s * s0) + (e * s1);
+}
+
+/*static*/ XO_INL
+bool XO_CC Quaternion::RoughlyEqual(Quaternion const& left, Quaternion const& right) {
+    return sse::CloseEnoughMask(sse::Load(left), sse::Load(right)) == 0xF;
+}
+
+/*static*/ XO_INL
+bool XO_CC Quaternion::ExactlyEqual(Quaternion const& left, Quaternion const& right) {
+    return sse::ExactlyEqualMask(sse::Load(left), sse::Load(right)) == 0xF;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////// AVector 3
+#if defined(XO_MATH_IMPL)
+/*static*/ const AVector3 AVector3::Zero(0.f);
+/*static*/ const AVector3 AVector3::One(1.f);
+/*static*/ const AVector3 AVector3::Left(-1.f, 0.f, 0.f);
+/*static*/ const AVector3 AVector3::Right(1.f, 0.f, 0.f);
+
+#   if !defined(XO_CONFIG_Y_UP) || !defined(XO_CONFIG_Z_UP)
+    static_assert(false, 
+        "define both XO_CONFIG_Y_UP and XO_CONFIG_Z_UP. One should have a value of 1, and\
+ the other should have a value of 0");
+#   endif
+
+#   if !defined(XO_CONFIG_LEFT_HANDED) || !defined(XO_CONFIG_RIGHT_HANDED)
+    static_assert(false, 
+        "define both XO_CONFIG_LEFT_HANDED and XO_CONFIG_RIGHT_HANDED. One should have a \
+value of 1, and the other should have a value of 0");
+#   endif
+
+#   if XO_CONFIG_Y_UP
+    static_assert(XO_CONFIG_Z_UP == 0, 
+        "XO_CONFIG_Z_UP should be 0 if XO_CONFIG_Y_UP is 1");
+/*static*/ const AVector3 AVector3::Up(0.f, 1.f, 0.f);
+/*static*/ const AVector3 AVector3::Down(0.f, -1.f, 0.f);
+#       if XO_CONFIG_LEFT_HANDED
+        static_assert(XO_CONFIG_RIGHT_HANDED == 0, 
+            "XO_CONFIG_RIGHT_HANDED should be 0 if XO_CONFIG_LEFT_HANDED is 1");
+/*static*/ const AVector3 AVector3::Forward(0.f, 0.f, 1.f);
+/*static*/ const AVector3 AVector3::Backward(0.f, 0.f, -1.f);
+#       elif XO_CONFIG_RIGHT_HANDED
+        static_assert(XO_CONFIG_LEFT_HANDED == 0, 
+            "XO_CONFIG_LEFT_HANDED should be 0 if XO_CONFIG_RIGHT_HANDED is 1");
+/*static*/ const AVector3 AVector3::Forward(0.f, 0.f, -1.f);
+/*static*/ const AVector3 AVector3::Backward(0.f, 0.f, 1.f);
+#       else
+        static_assert(false, 
+            "XO_CONFIG_LEFT_HANDED or XO_CONFIG_RIGHT_HANDED should have a non zero \
+value...");
+#       endif
+#   elif XO_CONFIG_Z_UP
+// no static assert here about XO_CONFIG_Y_UP, because it's been checked.
+/*static*/ const AVector3 AVector3::Up(0.f, 0.f, 1.f);
+/*static*/ const AVector3 AVector3::Down(0.f, 0.f, -1.f);
+#       if XO_CONFIG_LEFT_HANDED
+        static_assert(XO_CONFIG_RIGHT_HANDED == 0, 
+            "XO_CONFIG_RIGHT_HANDED should be 0 if XO_CONFIG_LEFT_HANDED is 1");
+/*static*/ const AVector3 AVector3::Forward(0.f, -1.f, 0.f);
+/*static*/ const AVector3 AVector3::Backward(0.f, 1.f, 0.f);
+#       elif XO_CONFIG_RIGHT_HANDED
+        static_assert(XO_CONFIG_LEFT_HANDED == 0, 
+            "XO_CONFIG_LEFT_HANDED should be 0 if XO_CONFIG_RIGHT_HANDED is 1");
+/*static*/ const AVector3 AVector3::Forward(0.f, 1.f, 0.f);
+/*static*/ const AVector3 AVector3::Backward(0.f, -1.f, 0.f);
+#       else
+        static_assert(false,
+            "XO_CONFIG_LEFT_HANDED or XO_CONFIG_RIGHT_HANDED should have a non zero \
+value...");
+#       endif
+#   else
+    static_assert(false,
+        "XO_CONFIG_Y_UP or XO_CONFIG_Z_UP should have a non zero value...");
+#   endif
+#endif
+
+XO_INL
+AVector3 XO_CC AVector3::operator + (AVector3 const& other) const {
+    return sse::Make<AVector3>(_mm_add_ps(sse::Load(*this), sse::Load(other)));
+}
+
+XO_INL
+AVector3 XO_CC AVector3::operator - (AVector3 const& other) const {
+    return sse::Make<AVector3>(_mm_sub_ps(sse::Load(*this), sse::Load(other)));
+}
+
+XO_INL
+AVector3 XO_CC AVector3::operator * (AVector3 const& other) const {
+    return sse::Make<AVector3>(_mm_mul_ps(sse::Load(*this), sse::Load(other)));
+}
+
+XO_INL
+AVector3 XO_CC AVector3::operator / (AVector3 const& other) const {
+    return sse::Make<AVector3>(_mm_div_ps(sse::Load(*this), sse::Load(other)));
+}
+
+XO_INL
+AVector3& XO_CC AVector3::operator += (AVector3 const& other) {
+    sse::Store(*this, _mm_add_ps(sse::Load(*this), sse::Load(other)));
+    return *this;
+}
+
+XO_INL
+AVector3& XO_CC AVector3::operator -= (AVector3 const& other) {
+    sse::Store(*this, _mm_sub_ps(sse::Load(*this), sse::Load(other)));
+    return *this;
+}
+
+XO_INL
+AVector3& XO_CC AVector3::operator *= (AVector3 const& other) {
+    sse::Store(*this, _mm_mul_ps(sse::Load(*this), sse::Load(other)));
+    return *this;
+}
+
+XO_INL
+AVector3& XO_CC AVector3::operator /= (AVector3 const& other) {
+    sse::Store(*this, _mm_div_ps(sse::Load(*this), sse::Load(other)));
+    return *this;
+}
+
+XO_INL AVector3 AVector3::operator -() const {
+    return sse::Make<AVector3>(_mm_xor_ps(sse::Load(*this), _mm_set1_ps(-0.f)));
+}
+
+XO_INL float AVector3::Sum() const {
+    return _mm_cvtss_f32(_mm_dp_ps(sse::Load(*this), _mm_set1_ps(1.f), 0x71));
+}
+
+XO_INL float AVector3::MagnitudeSquared() const {
+    __m128 m = sse::Load(*this);
+    return _mm_cvtss_f32(_mm_dp_ps(m, m, 0x71));
+}
+
+XO_INL float AVector3::Magnitude() const {
+    __m128 m = sse::Load(*this);
+    return _mm_cvtss_f32(_mm_sqrt_ss(_mm_dp_ps(m, m, 0x71)));
+}
+
+XO_INL AVector3& AVector3::Normalize(Precision precision) {
+    __m128 m = sse::Load(*this);
+    __m128 magnitudeSquared = _mm_dp_ps(m, m, 0x7F);
+    if (precision == Precision::Exact) {
+        sse::Store(*this, _mm_div_ps(m, _mm_sqrt_ps(magnitudeSquared)));
+    }
+    else {
+        sse::Store(*this, _mm_mul_ps(m, sse::InverseSqrt(magnitudeSquared, precision)));
+    }
+    return *this;
+}
+
+XO_INL AVector3 AVector3::Normalized(Precision precision) const { return AVector3(*this).Normalize(precision); }
+
+/*static*/ XO_INL
+bool XO_CC AVector3::RoughlyEqual(AVector3 const& left, AVector3 const& right) {
+    return (sse::CloseEnoughMask(sse::Load(left), sse::Load(right)) & 0x7) == 0x7;
+}
+
+/*static*/ XO_INL
+bool XO_CC AVector3::ExactlyEqual(AVector3 const& left, AVector3 const& right) {
+    return (sse::ExactlyEqualMask(sse::Load(left), sse::Load(right)) & 0x7) == 0x7;
+}
+
+/*static*/ XO_INL
+bool XO_CC AVector3::RoughlyEqual(AVector3 const& left, float magnitude) {
+    return CloseEnough(left.MagnitudeSquared(), Pow<2>(magnitude));
+}
+
+/*static*/ XO_INL
+bool XO_CC AVector3::ExactlyEqual(AVector3 const& left, float magnitude) {
+    return left.MagnitudeSquared() == Pow<2>(magnitude);
+}
+
+/*static*/ XO_INL
+float XO_CC AVector3::DotProduct(AVector3 const& left, AVector3 const& right) {
+    return _mm_cvtss_f32(_mm_dp_ps(sse::Load(left), sse::Load(right), 0x71));
+}
+
+/*static*/ XO_INL
+AVector3 XO_CC AVector3::CrossProduct(AVector3 const& left, AVector3 const& right) {
+    // (l * r.yzx - l.yzx * r).yzx
+    __m128 l = sse::Load(left);
+    __m128 r = sse::Load(right);
+    __m128 lyzx = _mm_shuffle_ps(l, l, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 ryzx = _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 zxy = _mm_sub_ps(_mm_mul_ps(l, ryzx), _mm_mul_ps(lyzx, r));
+    return sse::Make<AVector3>(_mm_shuffle_ps(zxy, zxy, _MM_SHUFFLE(3, 0, 2, 1)));
+}
+
+/*static*/ XO_INL
+AVector3 XO_CC AVector3::Lerp(AVector3 const& left, AVector3 const& right, float t) {
+    __m128 l = sse::Load(left);
+    __m128 r = sse::Load(right);
+    return sse::Make<AVector3>(_mm_add_ps(l, _mm_mul_ps(_mm_set1_ps(t), _mm_sub_ps(r, l))));
+}
+
+/*static*/ XO_INL
+float XO_CC AVector3::DistanceSquared(AVector3 const& left, AVector3 const& right) {
+    return (right - left).MagnitudeSquared();
+}
+
+/*static*/ XO_INL
+float XO_CC AVector3::Distance(AVector3 const& left, AVector3 const& right) {
+    return (right - left).Magnitude();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////// AVector 4
+
+XO_INL
+AVector4 XO_CC AVector4::operator + (AVector4 const& other) const {
+    return sse::Make<AVector4>(_mm_add_ps(sse::Load(*this), sse::Load(other)));
+}
+
+XO_INL
+AVector4 XO_CC AVector4::operator - (AVector4 const& other) const {
+    return sse::Make<AVector4>(_mm_sub_ps(sse::Load(*this), sse::Load(other)));
+}
+
+XO_INL
+AVector4 XO_CC AVector4::operator * (AVector4 const& other) const {
+    return sse::Make<AVector4>(_mm_mul_ps(sse::Load(*this), sse::Load(other)));
+}
+
+XO_INL
+AVector4 XO_CC AVector4::operator / (AVector4 const& other) const {
+    return sse::Make<AVector4>(_mm_div_ps(sse::Load(*this), sse::Load(other)));
+}
+
+XO_INL
+AVector4& XO_CC AVector4::operator += (AVector4 const& other) {
+    sse::Store(*this, _mm_add_ps(sse::Load(*this), sse::Load(other)));
+    return *this;
+}
+
+XO_INL
+AVector4& XO_CC AVector4::operator -= (AVector4 const& other) {
+    sse::Store(*this, _mm_sub_ps(sse::Load(*this), sse::Load(other)));
+    return *this;
+}
+
+XO_INL
+AVector4& XO_CC AVector4::operator *= (AVector4 const& other) {
+    sse::Store(*this, _mm_mul_ps(sse::Load(*this), sse::Load(other)));
+    return *this;
+}
+
+XO_INL
+AVector4& XO_CC AVector4::operator /= (AVector4 const& other) {
+    sse::Store(*this, _mm_div_ps(sse::Load(*this), sse::Load(other)));
+    return *this;
+}
+
+XO_INL AVector4 AVector4::operator -() const {
+    return sse::Make<AVector4>(_mm_xor_ps(sse::Load(*this), _mm_set1_ps(-0.f)));
+}
+
+XO_INL float AVector4::operator[] (int index) const { return v[index]; }
+XO_INL float& AVector4::operator[] (int index) { return v[index]; }
+
+XO_INL float AVector4::Sum() const {
+    return _mm_cvtss_f32(_mm_dp_ps(sse::Load(*this), _mm_set1_ps(1.f), 0xF1));
+}
+
+XO_INL float AVector4::MagnitudeSquared() const {
+    __m128 m = sse::Load(*this);
+    return _mm_cvtss_f32(_mm_dp_ps(m, m, 0xF1));
+}
+
+XO_INL float AVector4::Magnitude() const {
+    __m128 m = sse::Load(*this);
+    return _mm_cvtss_f32(_mm_sqrt_ss(_mm_dp_ps(m, m, 0xF1)));
+}
+
+XO_INL AVector4 AVector4::Normalized(Precision precision) const { return AVector4(*this).Normalize(precision); }
+
+XO_INL AVector4& AVector4::Normalize(Precision precision) {
+    __m128 m = sse::Load(*this);
+    __m128 magnitudeSquared = _mm_dp_ps(m, m, 0xFF);
+    if (precision == Precision::Exact) {
+        sse::Store(*this, _mm_div_ps(m, _mm_sqrt_ps(magnitudeSquared)));
+    }
+    else {
+        sse::Store(*this, _mm_mul_ps(m, sse::InverseSqrt(magnitudeSquared, precision)));
+    }
+    return *this;
+}
+
+/*static*/ XO_INL
+bool XO_CC AVector4::RoughlyEqual(AVector4 const& left, AVector4 const& right) {
+    return sse::CloseEnoughMask(sse::Load(left), sse::Load(right)) == 0xF;
+}
+
+/*static*/ XO_INL
+bool XO_CC AVector4::ExactlyEqual(AVector4 const& left, AVector4 const& right) {
+    return sse::ExactlyEqualMask(sse::Load(left), sse::Load(right)) == 0xF;
+}
+
+/*static*/ XO_INL
+bool XO_CC AVector4::RoughlyEqual(AVector4 const& left, float magnitude) {
+    return CloseEnough(left.MagnitudeSquared(), Pow<2>(magnitude));
+}
+
+/*static*/ XO_INL
+bool XO_CC AVector4::ExactlyEqual(AVector4 const& left, float magnitude) {
+    return left.MagnitudeSquared() == Pow<2>(magnitude);
+}
+
+/*static*/ XO_INL
+float XO_CC AVector4::DotProduct(AVector4 const& left, AVector4 const& right) {
+    return _mm_cvtss_f32(_mm_dp_ps(sse::Load(left), sse::Load(right), 0xF1));
+}
+
+/*static*/ XO_INL
+AVector4 XO_CC AVector4::Lerp(AVector4 const& left, AVector4 const& right, float t) {
+    __m128 l = sse::Load(left);
+    __m128 r = sse::Load(right);
+    return sse::Make<AVector4>(_mm_add_ps(l, _mm_mul_ps(_mm_set1_ps(t), _mm_sub_ps(r, l))));
+}
+
+#if defined(XO_MATH_IMPL)
+/*static*/ const AVector4 AVector4::Zero(0.f);
+/*static*/ const AVector4 AVector4::One(1.f);
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////// AMatrix4x4
+
+#if defined(XO_MATH_IMPL)
+/*static*/ const AMatrix4x4 AMatrix4x4::One(1.f);
+/*static*/ const AMatrix4x4 AMatrix4x4::Zero(0.f);
+/*static*/ const AMatrix4x4 AMatrix4x4::Identity(
+    AVector4(1.f, 0.f, 0.f, 0.f),
+    AVector4(0.f, 1.f, 0.f, 0.f),
+    AVector4(0.f, 0.f, 1.f, 0.f),
+    AVector4(0.f, 0.f, 0.f, 1.f));
+#endif
+
+XO_INL
+AVector3 XO_CC AMatrix4x4::Transform(AVector3 const& v3) const {
+    // w is implicitly 0, so the dot products only read xyz.
+    __m128 v = sse::Load(v3);
+    __m128 x = _mm_dp_ps(sse::Load(rows[0]), v, 0x71);
+    __m128 y = _mm_dp_ps(sse::Load(rows[1]), v, 0x72);
+    __m128 z = _mm_dp_ps(sse::Load(rows[2]), v, 0x74);
+    return sse::Make<AVector3>(_mm_or_ps(_mm_or_ps(x, y), z));
+}
+
+XO_INL
+AVector4 XO_CC AMatrix4x4::Transform(AVector4 const& v4) const {
+    __m128 v = sse::Load(v4);
+    __m128 x = _mm_dp_ps(sse::Load(rows[0]), v, 0xF1);
+    __m128 y = _mm_dp_ps(sse::Load(rows[1]), v, 0xF2);
+    __m128 z = _mm_dp_ps(sse::Load(rows[2]), v, 0xF4);
+    __m128 w = _mm_dp_ps(sse::Load(rows[3]), v, 0xF8);
+    return sse::Make<AVector4>(_mm_or_ps(_mm_or_ps(x, y), _mm_or_ps(z, w)));
+}
+
+XO_INL
+AVector3 XO_CC AMatrix4x4::InverseTransform(AVector3 const& v3) const {
+    __m128 v = sse::Load(v3);
+    __m128 r = _mm_mul_ps(sse::Splat<0>(v), sse::Load(rows[0]));
+    r = sse::MultiplyAdd(sse::Splat<1>(v), sse::Load(rows[1]), r);
+    r = sse::MultiplyAdd(sse::Splat<2>(v), sse::Load(rows[2]), r);
+    return sse::Make<AVector3>(r);
+}
+
+XO_INL
+AVector4 XO_CC AMatrix4x4::InverseTransform(AVector4 const& v4) const {
+    __m128 v = sse::Load(v4);
+    __m128 r = _mm_mul_ps(sse::Splat<0>(v), sse::Load(rows[0]));
+    r = sse::MultiplyAdd(sse::Splat<1>(v), sse::Load(rows[1]), r);
+    r = sse::MultiplyAdd(sse::Splat<2>(v), sse::Load(rows[2]), r);
+    r = sse::MultiplyAdd(sse::Splat<3>(v), sse::Load(rows[3]), r);
+    return sse::Make<AVector4>(r);
+}
+
+XO_INL
+AMatrix4x4 XO_CC AMatrix4x4::operator * (AMatrix4x4 const& other) const {
+    return AMatrix4x4(*this) *= other;
+}
+
+XO_INL
+AMatrix4x4& XO_CC AMatrix4x4::operator *= (AMatrix4x4 const& other) {
+    sse::MultiplyMatrix(v, other.v, v);
+    return *this;
+}
+
+XO_INL AVector4 AMatrix4x4::operator[] (int index) const { return rows[index]; }
+XO_INL AVector4& AMatrix4x4::operator[] (int index) { return rows[index]; }
+
+XO_INL
+AVector3 AMatrix4x4::Up() const {
+#if defined(XO_CONFIG_Y_UP) && XO_CONFIG_Y_UP
+    return AVector3(rows[1][0], rows[1][1], rows[1][2]);
+#elif defined(XO_CONFIG_Z_UP) && XO_CONFIG_Z_UP
+    return AVector3(rows[2][0], rows[2][1], rows[2][2]);
+#else
+    static_assert(false, "Define XO_CONFIG_Y_UP and XO_CONFIG_Z_UP. One should have a \
+value of 1, the other should have a value of 0.");
+#endif
+}
+
+XO_INL
+AVector3 AMatrix4x4::Down() const {
+    return -Up();
+}
+
+XO_INL
+AVector3 AMatrix4x4::Left() const {
+    return -Right();
+}
+XO_INL
+AVector3 AMatrix4x4::Right() const {
+    return AVector3(rows[0][0], rows[0][1], rows[0][2]);
+}
+
+XO_INL
+AVector3 AMatrix4x4::Forward() const {
+#if defined(XO_CONFIG_Y_UP) && XO_CONFIG_Y_UP
+#   if defined(XO_CONFIG_LEFT_HANDED) && XO_CONFIG_LEFT_HANDED
+    return AVector3(rows[2][0], rows[2][1], rows[2][2]);
+#   elif defined(XO_CONFIG_RIGHT_HANDED) && XO_CONFIG_RIGHT_HANDED
+    return AVector3(-rows[2][0], -rows[2][1], -rows[2][2]);
+#   else
+    static_assert(false, "Define XO_CONFIG_LEFT_HANDED and XO_CONFIG_RIGHT_HANDED. One \
+should have a value of 1, the other should have a value of 0.");
+#   endif
+#elif defined(XO_CONFIG_Z_UP) && XO_CONFIG_Z_UP
+#   if defined(XO_CONFIG_LEFT_HANDED) && XO_CONFIG_LEFT_HANDED
+    return AVector3(-rows[1][0], -rows[1][1], -rows[1][2]);
+#   elif defined(XO_CONFIG_RIGHT_HANDED) && XO_CONFIG_RIGHT_HANDED
+    return AVector3(rows[1][0], rows[1][1], rows[1][2]);
+#   else
+    static_assert(false, "Define XO_CONFIG_LEFT_HANDED and XO_CONFIG_RIGHT_HANDED. One \
+should have a value of 1, the other should have a value of 0.");
+#   endif
+#else
+    static_assert(false, "Define XO_CONFIG_Y_UP and XO_CONFIG_Z_UP. One should have a \
+value of 1, the other should have a value of 0.");
+#endif
+}
+
+XO_INL
+AVector3 AMatrix4x4::Backward() const {
+    return -Forward();
+}
+
+/*static*/ XO_INL
+AMatrix4x4 XO_CC AMatrix4x4::Transpose(AMatrix4x4 const& matrixIn) {
+    __m128 r0 = sse::Load(matrixIn.rows[0]);
+    __m128 r1 = sse::Load(matrixIn.rows[1]);
+    __m128 r2 = sse::Load(matrixIn.rows[2]);
+    __m128 r3 = sse::Load(matrixIn.rows[3]);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    AMatrix4x4 transposed;
+    sse::Store(transposed.rows[0], r0);
+    sse::Store(transposed.rows[1], r1);
+    sse::Store(transposed.rows[2], r2);
+    sse::Store(transposed.rows[3], r3);
+    return transposed;
+}
+
+/*static*/ XO_INL 
+AMatrix4x4 XO_CC AMatrix4x4::Invert(AMatrix4x4 const& matrixIn) {
+    __m128 adjugate[4];
+    __m128 invDet = _mm_div_ps(_mm_set1_ps(1.f), sse::Adjugate(matrixIn.v, adjugate));
+    AMatrix4x4 inverted;
+    for (int i = 0; i < 4; ++i) {
+        sse::Store(inverted.rows[i], _mm_mul_ps(adjugate[i], invDet));
+    }
+    return inverted;
+}
+
+/*static*/ XO_INL
+bool XO_CC AMatrix4x4::InvertSafe(AMatrix4x4 const& matrixIn, AMatrix4x4& matrixOut) {
+    __m128 adjugate[4];
+    __m128 det = sse::Adjugate(matrixIn.v, adjugate);
+    if (CloseEnough(_mm_cvtss_f32(det), 0.f))
+        return false;
+    __m128 invDet = _mm_div_ps(_mm_set1_ps(1.f), det);
+    for (int i = 0; i < 4; ++i) {
+        sse::Store(matrixOut.rows[i], _mm_mul_ps(adjugate[i], invDet));
+    }
+    return true;
+}
+
+/*static*/ XO_INL
+AMatrix4x4 XO_CC AMatrix4x4::InvertAffine(AMatrix4x4 const& matrixIn) {
+    // The columns of the 3x3 inverse are c0 = a1 x a2, c1 = a2 x a0 and c2 = a0 x a1 over
+    // the determinant a0 . c0.
+    __m128 a0 = sse::Load(matrixIn.rows[0]);
+    __m128 a1 = sse::Load(matrixIn.rows[1]);
+    __m128 a2 = sse::Load(matrixIn.rows[2]);
+    __m128 c0 = sse::CrossProduct(a1, a2);
+    __m128 c1 = sse::CrossProduct(a2, a0);
+    __m128 c2 = sse::CrossProduct(a0, a1);
+    __m128 invDet = _mm_div_ps(_mm_set1_ps(1.f), _mm_dp_ps(a0, c0, 0x7F));
+    return sse::AffineInverse<AMatrix4x4>(_mm_mul_ps(c0, invDet), _mm_mul_ps(c1, invDet),
+                                   _mm_mul_ps(c2, invDet), sse::Load(matrixIn.rows[3]));
+}
+
+/*static*/ XO_INL
+AMatrix4x4 XO_CC AMatrix4x4::InvertOrthonormal(AMatrix4x4 const& matrixIn) {
+    // The columns of the 3x3 inverse are the rows.
+    return sse::AffineInverse<AMatrix4x4>(sse::Load(matrixIn.rows[0]), sse::Load(matrixIn.rows[1]),
+                                   sse::Load(matrixIn.rows[2]), sse::Load(matrixIn.rows[3]));
+}
+
+/*static*/ XO_INL
+bool XO_CC AMatrix4x4::IsAffine(AMatrix4x4 const& matrixIn) {
+    return CloseEnough(matrixIn.v[3], 0.f) && CloseEnough(matrixIn.v[7], 0.f)
+        && CloseEnough(matrixIn.v[11], 0.f) && CloseEnough(matrixIn.v[15], 1.f);
+}
+
+/*static*/ XO_INL
+bool XO_CC AMatrix4x4::IsOrthonormal(AMatrix4x4 const& matrixIn) {
+    AVector3 a0(matrixIn.v[0], matrixIn.v[1], matrixIn.v[2]);
+    AVector3 a1(matrixIn.v[4], matrixIn.v[5], matrixIn.v[6]);
+    AVector3 a2(matrixIn.v[8], matrixIn.v[9], matrixIn.v[10]);
+    float const tolerance = 1e-5f;
+    return IsAffine(matrixIn)
+        && Abs(a0.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(a1.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(a2.MagnitudeSquared() - 1.f) <= tolerance
+        && Abs(AVector3::DotProduct(a0, a1)) <= tolerance
+        && Abs(AVector3::DotProduct(a1, a2)) <= tolerance
+        && Abs(AVector3::DotProduct(a2, a0)) <= tolerance;
+}
+
+/*static*/ XO_INL 
+AMatrix4x4 XO_CC AMatrix4x4::Translation(AVector3 const& pos) {
+    return AMatrix4x4(
+        AVector4(1.f,   0.f,   0.f,   0.f),
+        AVector4(0.f,   1.f,   0.f,   0.f),
+        AVector4(0.f,   0.f,   1.f,   0.f),
+        AVector4(pos.x, pos.y, pos.z, 1.f));
+}
+
+/*static*/ XO_INL 
+AMatrix4x4 XO_CC AMatrix4x4::Scale(AVector3 const& scale) {
+    return AMatrix4x4(
+        AVector4(scale.x, 0.f,     0.f,     0.f),
+        AVector4(0.f,     scale.y, 0.f,     0.f),
+        AVector4(0.f,     0.f,     scale.z, 0.f),
+        AVector4(0.f,     0.f,     0.f,     1.f));
+}
+
+/*static*/ XO_INL 
+AMatrix4x4 XO_CC AMatrix4x4::RotationYaw(float yaw) {
+    float s, c;
+    SinCos(yaw, s, c);
+    return AMatrix4x4(
+        AVector4(c,   0.f, -s,  0.f),
+        AVector4(0.f, 1.f, 0.f, 0.f),
+        AVector4(s,   0.f, c,   0.f),
+        AVector4(0.f, 0.f, 0.f, 1.f));
+}
+
+/*static*/ XO_INL
+AMatrix4x4 XO_CC AMatrix4x4::RotationPitch(float pitch) {
+    float s, c;
+    SinCos(pitch, s, c);
+    return AMatrix4x4(
+        AVector4(1.f, 0.f, 0.f, 0.f),
+        AVector4(0.f, c,   -s,  0.f),
+        AVector4(0.f, s,   c,   0.f),
+        AVector4(0.f, 0.f, 0.f, 1.f));
+}
+
+/*static*/ XO_INL 
+AMatrix4x4 XO_CC AMatrix4x4::RotationRoll(float roll) {
+    float s, c;
+    SinCos(roll, s, c);
+    return AMatrix4x4(
+        AVector4(c,   -s,  0.f, 0.f),
+        AVector4(s,   c,   0.f, 0.f),
+        AVector4(0.f, 0.f, 1.f, 0.f),
+        AVector4(0.f, 0.f, 0.f, 1.f));
+}
+
+/*static*/ XO_INL 
+AMatrix4x4 XO_CC AMatrix4x4::RotationYawPitchRoll(float yaw, float pitch, float roll) {
+    return RotationYaw(yaw) * RotationPitch(pitch) * RotationRoll(roll);
+}
+
+/*static*/ XO_INL
+AMatrix4x4 XO_CC AMatrix4x4::RotationAxisAngle(AVector3 const& axis, float angle) {
+    float s, c;
+    SinCos(angle, s, c);
+    float t = 1.f - c;
+    AVector3 a = axis.Normalized();
+    AMatrix4x4 rotation(AMatrix4x4::Identity);
+
+    rotation[0][0] = c + a.x*a.x*t;
+    rotation[1][1] = c + a.y*a.y*t;
+    rotation[2][2] = c + a.z*a.z*t;
+
+    float tmp1 = a.x*a.y*t;
+    float tmp2 = a.z*s;
+    rotation[1][0] = tmp1 + tmp2;
+    rotation[0][1] = tmp1 - tmp2;
+    
+    tmp1 = a.x*a.z*t;
+    tmp2 = a.y*s;
+    rotation[2][0] = tmp1 - tmp2;
+    rotation[0][2] = tmp1 + tmp2;    tmp1 = a.y*a.z*t;
+
+    tmp2 = a.x*s;
+    rotation[2][1] = tmp1 + tmp2;
+    rotation[1][2] = tmp1 - tmp2;
+
+    return rotation;
+}
+
+/*static*/ XO_INL 
+AMatrix4x4 XO_CC AMatrix4x4::PerspectiveFOV(float fov, 
+                                          float aspect, 
+                                          float nearPlane, 
+                                          float farPlane) {
+    float s, c;
+    SinCos(fov*0.5f, s, c);
+    float h = c / s;                             // height
+    float w = h / aspect;                        // width
+    float r = farPlane / (nearPlane - farPlane); // range
+    float rn = r * nearPlane;                    // range*near
+    return AMatrix4x4(
+        AVector4(w,   0.f, 0.f, 0.f),
+        AVector4(0.f, h,   0.f, 0.f),
+        AVector4(0.f, 0.f, r,  -1.f),
+        AVector4(0.f, 0.f, rn,  0.f));
+}
+
+/*static*/ XO_INL 
+AMatrix4x4 XO_CC AMatrix4x4::Perspective(float width,
+                                       float height, 
+                                       float aspect, 
+                                       float nearPlane, 
+                                       float farPlane) {
+    XO_UNUSED(aspect);   // width / height already give it
+    float n2 = Pow<2>(nearPlane);
+    float r = farPlane / (nearPlane - farPlane);
+    float w = n2 / width;
+    float h = n2 / height;
+    float rn = r * nearPlane;
+    return AMatrix4x4(
+        AVector4(w,   0.f, 0.f, 0.f),
+        AVector4(0.f, h,   0.f, 0.f),
+        AVector4(0.f, 0.f, r,  -1.f),
+        AVector4(0.f, 0.f, rn,  0.f));
+}
+
+/*static*/ XO_INL
+AMatrix4x4 XO_CC AMatrix4x4::Orthographic(float width,
+                                        float height,
+                                        float nearPlane,
+                                        float farPlane) {
+    float r = 1.f / (nearPlane - farPlane);
+    float w = 2.f / width;
+    float h = 2.f / height;
+    float rn = r * nearPlane;
+    return AMatrix4x4(
+        AVector4(w, 0.f, 0.f, 0.f),
+        AVector4(0.f, h, 0.f, 0.f),
+        AVector4(0.f, 0.f, r, 0.f),
+        AVector4(0.f, 0.f, rn, 0.f));
+}
+
+/*static*/ XO_INL
+AMatrix4x4 XO_CC AMatrix4x4::LookAt(AVector3 const& from,
+                                  AVector3 const& to, 
+                                  AVector3 const& up) {
+    AVector3 dir = from - to;
+    AVector3 r2 = dir.Normalized();
+    AVector3 r0 = AVector3::CrossProduct(up, r2).Normalized();
+    AVector3 r1 = AVector3::CrossProduct(r2, r0);
+
+    float d0 = -AVector3::DotProduct(r0, from);
+    float d1 = -AVector3::DotProduct(r1, from);
+    float d2 = -AVector3::DotProduct(r2, from);
+    return AMatrix4x4(
+        AVector4(r0.x, r1.x, r2.x, 0.f),
+        AVector4(r0.y, r1.y, r2.y, 0.f),
+        AVector4(r0.z, r1.z, r2.z, 0.f),
+        AVector4(d0,   d1,   d2,   1.f));
+}
+
+/*static*/ XO_INL 
+bool XO_CC AMatrix4x4::RoughlyEqual(AMatrix4x4 const& left, AMatrix4x4 const& right) {
+    return AVector4::RoughlyEqual(left[0], right[0])
+        && AVector4::RoughlyEqual(left[1], right[1])
+        && AVector4::RoughlyEqual(left[2], right[2])
+        && AVector4::RoughlyEqual(left[3], right[3]);
+}
+
+/*static*/ XO_INL 
+bool XO_CC AMatrix4x4::ExactlyEqual(AMatrix4x4 const& left, AMatrix4x4 const& right) {
+    return AVector4::ExactlyEqual(left[0], right[0])
+        && AVector4::ExactlyEqual(left[1], right[1])
+        && AVector4::ExactlyEqual(left[2], right[2])
+        && AVector4::ExactlyEqual(left[3], right[3]);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////// AQuaternion
+#if defined(XO_MATH_IMPL)
+/*static*/ const AQuaternion AQuaternion::Zero(0.f);
+/*static*/ const AQuaternion AQuaternion::Identity(0.f, 0.f, 0.f, 1.f);
+#endif
+
+XO_INL
+AQuaternion AQuaternion::operator + (AQuaternion other) const {
+    return sse::Make<AQuaternion>(_mm_add_ps(sse::Load(*this), sse::Load(other)));
+}
+
+XO_INL
+AQuaternion AQuaternion::operator *(float s) const {
+    return sse::Make<AQuaternion>(_mm_mul_ps(sse::Load(*this), _mm_set1_ps(s)));
+}
+
+XO_INL
+AQuaternion AQuaternion::operator -() const {
+    return sse::Make<AQuaternion>(_mm_xor_ps(sse::Load(*this), _mm_set1_ps(-0.f)));
+}
+
+XO_INL
+AQuaternion XO_CC AQuaternion::operator * (AQuaternion const& other) const {
+    // Each lane of this times a shuffled, sign flipped copy of other, see the reference
+    // backend for the scalar form.
+    __m128 a = sse::Load(*this);
+    __m128 b = sse::Load(other);
+    __m128 rkji = _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3));
+    __m128 krij = _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2));
+    __m128 jirk = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 result = _mm_mul_ps(sse::Splat<3>(a), b);
+    result = sse::MultiplyAdd(sse::Splat<0>(a), _mm_xor_ps(rkji, _mm_setr_ps(0.f, -0.f, 0.f, -0.f)), result);
+    result = sse::MultiplyAdd(sse::Splat<1>(a), _mm_xor_ps(krij, _mm_setr_ps(0.f, 0.f, -0.f, -0.f)), result);
+    result = sse::MultiplyAdd(sse::Splat<2>(a), _mm_xor_ps(jirk, _mm_setr_ps(-0.f, 0.f, 0.f, -0.f)), result);
+    return sse::Make<AQuaternion>(result);
+}
+
+XO_INL
+AQuaternion& XO_CC AQuaternion::operator *= (AQuaternion const& other) {
+    return *this = *this * other;
+}
+
+XO_INL
+AVector3 XO_CC AQuaternion::Rotate(AVector3 const& v) const {
+    // The cross products see r in the w lane, against the 0 w of v and t, so w stays 0.
+    __m128 q = sse::Load(*this);
+    __m128 m = sse::Load(v);
+    __m128 t = sse::CrossProduct(q, m);
+    t = _mm_add_ps(t, t);
+    __m128 result = sse::MultiplyAdd(sse::Splat<3>(q), t, m);
+    return sse::Make<AVector3>(_mm_add_ps(result, sse::CrossProduct(q, t)));
+}
+
+XO_INL
+float AQuaternion::Magnitude() const {
+    return vec4.Magnitude();
+}
+
+XO_INL
+float AQuaternion::MagnitudeSquared() const {
+    return vec4.MagnitudeSquared();
+};
+
+XO_INL
+AQuaternion AQuaternion::Normalized(Precision precision) const {
+    return AQuaternion(vec4.Normalized(precision));
+};
+
+XO_INL
+AQuaternion& AQuaternion::Normalize(Precision precision) {
+    vec4.Normalize(precision); return *this;
+};
+
+XO_INL
+AMatrix4x4 AQuaternion::ToMatrix() const {
+    // See: https://www.flipcode.com/documents/matrfaq.html#Q54
+    float ii = i * i;
+    float ij = i * j;
+    float ik = i * k;
+    float ir = i * r;
+    float jj = j * j;
+    float jk = j * k;
+    float jr = j * r;
+    float kk = k * k;
+    float kr = k * r;
+    return AMatrix4x4(
+        AVector4(1.f - 2.f * (jj + kk), 2.f * (ij - kr), 2.f * (ik + jr), 0.f),
+        AVector4(2.f * (ij + kr), 1.f - 2.f * (ii + kk), 2.f * (jk - ir), 0.f),
+        AVector4(2.f * (ik - jr), 2.f * (jk + ir), 1.f - 2.f * (ii + jj), 0.f),
+        AVector4(0.f, 0.f, 0.f, 1.f));
+}
+
+/*static*/ XO_INL
+AQuaternion XO_CC AQuaternion::Invert(AQuaternion const& quat) {
+    return sse::Make<AQuaternion>(_mm_xor_ps(sse::Load(quat), _mm_set_ps(0.f, -0.f, -0.f, -0.f)));
+}
+
+/*static*/ XO_INL
+AQuaternion XO_CC AQuaternion::RotationAxisAngle(AVector3 const& axis, float angle) {
+    float s, c;
+    SinCos(angle*0.5f, s, c);
+    return AQuaternion(axis.x*s, axis.y*s, axis.z*s, c);
+}
+
+/*static*/ XO_INL
+AQuaternion XO_CC AQuaternion::RotationEuler(AVector3 const& angles) {
+    float sr, cp, sp, cy, sy, cr;
+    SinCos(angles.x * 0.5f, sy, cy);
+    SinCos(angles.y * 0.5f, sp, cp);
+    SinCos(angles.z * 0.5f, sr, cr);
+    return AQuaternion(cy * cr * cp + sy * sr * sp,
+                      cy * sr * cp - sy * cr * sp,
+                      cy * cr * sp + sy * sr * cp,
+                      sy * cr * cp - cy * sr * sp);
+}
+
+/*static*/ XO_INL
+float XO_CC AQuaternion::DotProduct(AQuaternion const& left, AQuaternion const& right) {
+    return AVector4::DotProduct(left.vec4, right.vec4);
+}
+
+/*static*/ XO_INL
+AQuaternion XO_CC AQuaternion::Lerp(AQuaternion const& start,
+                                  AQuaternion const& end,
+                                  float t) {
+    return AQuaternion(AVector4::Lerp(start.vec4, end.vec4, t));
+}
+
+/*static*/ XO_INL
+AQuaternion XO_CC AQuaternion::Slerp(AQuaternion const& start, 
+                                   AQuaternion const& end, 
+                                   float t) {
+    AQuaternion s = start.Normalized();
+    AQuaternion e = end.Normalized();
+    float d = AQuaternion::DotProduct(s, e);
+    if (d < 0.f) {
+        e = -e;
+        d = -d;
+    }
+
+    if (CloseEnough(d, 1.f)) {
+        return Lerp(s, e, t).Normalize();
+    }
+
+    float th0 = ACos(d);
+    float th = th0 * t;
+
+    float st, ct, sth0;
+    SinCos(th, st, ct);
+    sth0 = Sin(th0);
+    float s0 = ct - d * st / sth0;
+    float s1 = st / sth0;
+    return (s * s0) + (e * s1);
+}
+
+/*static*/ XO_INL
+bool XO_CC AQuaternion::RoughlyEqual(AQuaternion const& left, AQuaternion const& right) {
+    return sse::CloseEnoughMask(sse::Load(left), sse::Load(right)) == 0xF;
+}
+
+/*static*/ XO_INL
+bool XO_CC AQuaternion::ExactlyEqual(AQuaternion const& left, AQuaternion const& right) {
+    return sse::ExactlyEqualMask(sse::Load(left), sse::Load(right)) == 0xF;
+}
 
 } // ::xo
\ No newline at end of file
@@ -3,7 +3,13 @@
 #include <cstdlib>
 #include "xo-math-macros.h"
 #include "xo-math-constants.h"
+#include "xo-math-detect-simd.h"
 // $inline_begin
+#include <cmath>
+#include <cstring>
+#if XO_HAS_SSE
+#   include <xmmintrin.h>
+#endif
 namespace xo
 {
 template<typename T> constexpr XO_INL T Abs(T num)          { return num >= 0 ? num : -num; }
@@ -24,6 +30,8 @@ constexpr XO_INL float Lerp(float start, float end, float t) {
 
 constexpr XO_INL float RelativeEpsilon(float a)          { return MachineEpsilon * Max(1.f, Abs(a)); }
 constexpr XO_INL float RelativeEpsilon(float a, float b) { return MachineEpsilon * Max(1.f, Abs(a), Abs(b)); }
+constexpr XO_INL double RelativeEpsilon(double a)           { return MachineEpsilonDouble * Max(1.0, Abs(a)); }
+constexpr XO_INL double RelativeEpsilon(double a, double b) { return MachineEpsilonDouble * Max(1.0, Abs(a), Abs(b)); }
 
 // See: http://realtimecollisiondetection.net/blog/?p=89
 // Example accuracy:
@@ -32,13 +40,69 @@ constexpr XO_INL float RelativeEpsilon(float a, float b) { return MachineEpsilon
 constexpr XO_INL bool CloseEnough(float left, float right) {
     return Abs(left - right) <= RelativeEpsilon(left, right);
 }
+constexpr XO_INL bool CloseEnough(double left, double right) {
+    return Abs(left - right) <= RelativeEpsilon(left, right);
+}
 
 float Sqrt(float val);
+
+// How Normalize, Normalized and InverseSqrt get 1/sqrt(x).
+// Exact: sqrt and divide, both correctly rounded.
+// Fast: the hardware estimate refined by one Newton-Raphson step, within a few ulp.
+// Fastest: the hardware estimate alone, relative error below 1.5 * 2^-12 (2^-14 where
+// AVX512 rsqrt14 is used).
+// Without SSE the estimate is the integer shift trick plus one Newton-Raphson step (about
+// 2e-3 relative error), and Fast takes a second step (about 5e-6).
+// The default for the member functions is XO_CONFIG_DEFAULT_PRECISION.
+enum class Precision : uint8_t { Exact, Fast, Fastest };
+
+// rsqrtss and rsqrtps read a denormal as 0 and give infinity, and the shift trick is no
+// better there, so Fast and Fastest scale values under FLT_MIN up by 2^64 before the
+// estimate and the result by 2^32 after it. Both are exact, so short vectors normalize as
+// well as with Exact. AVX512 rsqrt14 takes denormals as they are.
+namespace rsqrt {
+constexpr float Tiny = std::numeric_limits<float>::min();
+constexpr float ScaleUp = 18446744073709551616.f;  // 2^64
+constexpr float ScaleBack = 4294967296.f;          // 2^32
+} // ::xo::rsqrt
+
+XO_INL float InverseSqrt(float val, Precision precision) {
+    if (precision == Precision::Exact) {
+        return 1.f / std::sqrt(val);
+    }
+    float scale = 1.f;
+    if (val < rsqrt::Tiny) {
+        val *= rsqrt::ScaleUp;
+        scale = rsqrt::ScaleBack;
+    }
+#if XO_HAS_SSE
+    float estimate = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(val)));
+#else
+    uint32_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    bits = 0x5F375A86u - (bits >> 1);
+    float estimate;
+    std::memcpy(&estimate, &bits, sizeof(estimate));
+    estimate = estimate * (1.5f - (0.5f * val * estimate) * estimate);
+#endif
+    if (precision == Precision::Fastest) {
+        return estimate * scale;
+    }
+    return estimate * (1.5f - (0.5f * val * estimate) * estimate) * scale;
+}
+
 float Pow(float val, int power);
 template<int power> XO_INL float Pow(float val) { return Pow(val, power); }
 template<> float XO_INL Pow<2>(float val) { return val*val; }
 template<> float XO_INL Pow<3>(float val) { return val * val * val; }
 
+// Sin, Cos and SinCos don't call into libm. One Cody-Waite reduction by pi/2 is shared by
+// a minimax polynomial for each of sin and cos on [-pi/4, pi/4].
+// Error against the correctly rounded result: at most 2 ulp for |val| <= pi. Up to
+// |val| <= 1e5 the absolute error stays below 1.2e-7, but right next to the zeros of sin
+// and cos (tiny results) that can be tens of ulp. Larger inputs go through std::sin and
+// std::cos. The FloatN versions in xo-math-wide.h run the same code on 4, 8 or 16 lanes,
+// without the fallback. bench/bench-trig.cpp measures both against libm.
 float Sin(float val);
 float Cos(float val);
 float ASin(float val);
@@ -46,6 +110,143 @@ float ACos(float val);
 void SinCos(float val, float& sinOut, float& cosOut);
 void ASinACos(float val, float& asinOut, float& acosOut);
 
+namespace trig {
+constexpr float TwoOverPi = 0.636619772f;
+// pi/2 in four parts, the first three short enough that k times them is exact for
+// |k| < 2^16.
+constexpr float PiOver2A = 1.5703125f;
+constexpr float PiOver2B = 4.84466552734375e-4f;
+constexpr float PiOver2C = -6.4074993133544922e-7f;
+constexpr float PiOver2D = 9.9209362947050295e-10f;
+// Past this the reduction loses bits.
+constexpr float MaxReducible = 1e5f;
+// 1.5 * 2^23: adding and then subtracting it rounds |x| < 2^22 to the nearest integer.
+constexpr float RoundMagic = 12582912.f;
+
+// F is float or an xo::FloatN, the body only needs +, -, * and F(float).
+template<typename F>
+XO_INL void SinCos(F const& val, F& sinOut, F& cosOut) {
+    F const magic(RoundMagic);
+    F const k = (val * F(TwoOverPi) + magic) - magic;
+    F const r = (((val - k * F(PiOver2A)) - k * F(PiOver2B)) - k * F(PiOver2C)) - k * F(PiOver2D);
+    F const r2 = r * r;
+    F const s = r + r * r2 * (F(-1.6666654611e-1f) + r2 * (F(8.3321608736e-3f) + r2 * F(-1.9515295891e-4f)));
+    F const c = (F(1.f) - r2 * F(0.5f))
+              + r2 * r2 * (F(4.166664568298827e-2f) + r2 * (F(-1.388731625493765e-3f) + r2 * F(2.443315711809948e-5f)));
+
+    // Quadrant k: odd k swaps sin and cos, odd k/2 flips both signs. Selecting with a
+    // multiply by 0 or 1 keeps it branch free and exact.
+    F const half = ((k * F(0.5f) - F(0.25f)) + magic) - magic;     // floor(k / 2)
+    F const odd = k - half * F(2.f);
+    F const flip = half - (((half * F(0.5f) - F(0.25f)) + magic) - magic) * F(2.f);
+    F const even = F(1.f) - odd;
+    F const sign = F(1.f) - flip * F(2.f);
+    sinOut = sign * (s * even + c * odd);
+    cosOut = sign * (c * even - s * odd);
+}
+} // ::xo::trig
+
+// Slerp weights without acos or sin, from D. Eberly, "A Fast and Accurate Algorithm for
+// Computing SLERP". For unit quaternions at an angle a with cosine = cos(a) in [0, 1],
+// Weight(cosine, t) is sin(t a) / sin(a) as a series in t and cosine - 1. The series is cut
+// at Terms, with the last term scaled by Mu to make up for the rest: the error stays below
+// 8e-7 for t in [0, 1].
+namespace slerp {
+constexpr int Terms = 12;
+constexpr float Mu = 1.895f;
+// Term i multiplies by (U[i] t^2 - V[i]) (cosine - 1), U = 1 / (n (2n + 1)) and
+// V = n / (2n + 1) for n = i + 1.
+constexpr float U[Terms] = {
+    1.f / 3, 1.f / 10, 1.f / 21, 1.f / 36, 1.f / 55, 1.f / 78,
+    1.f / 105, 1.f / 136, 1.f / 171, 1.f / 210, 1.f / 253, Mu / 300 };
+constexpr float V[Terms] = {
+    1.f / 3, 2.f / 5, 3.f / 7, 4.f / 9, 5.f / 11, 6.f / 13,
+    7.f / 15, 8.f / 17, 9.f / 19, 10.f / 21, 11.f / 23, Mu * 12 / 25 };
+
+// F is float or an xo::FloatN, like trig::SinCos.
+template<typename F>
+XO_INL F Weight(F const& cosine, F const& t) {
+    F const xm1 = cosine - F(1.f);
+    F const tt = t * t;
+    F r(1.f);
+    for (int i = Terms - 1; i >= 0; --i) {
+        r = F(1.f) + (F(U[i]) * tt - F(V[i])) * xm1 * r;
+    }
+    return t * r;
+}
+} // ::xo::slerp
+
+// Denormals, the floats below FLT_MIN, go through a microcode assist on most x86 cores:
+// a hundred cycles or more per op where it's otherwise 4. Anything that decays toward zero,
+// like damped velocities or a Lerp chasing its target, ends up there. Flushing them makes
+// denormal results 0 (FTZ) and reads denormal inputs as 0 (DAZ), at full speed.
+// The setting is in MXCSR (FPCR on ARM64), which is per thread. ScopedFlushDenormals sets
+// it for a scope and puts back what was there, SetFlushDenormals(true) at the start of each
+// worker thread sets it for good. Whether a new thread inherits it from its creator
+// depends on the OS, so set it in every thread rather than counting on that.
+// Without SSE or ARM64 (x87 code included) they do nothing and report false.
+//
+//     void Worker() {
+//         xo::SetFlushDenormals(true);
+//         ...
+//     }
+//
+//     {
+//         xo::ScopedFlushDenormals flush;
+//         world.Step(dt);
+//     }
+namespace denormals {
+#if XO_HAS_SSE
+constexpr uint32_t Mask = 0x8040u;      // FTZ, bit 15, and DAZ, bit 6
+XO_INL uint32_t GetControl() { return _mm_getcsr(); }
+XO_INL void SetControl(uint32_t control) { _mm_setcsr(control); }
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+constexpr uint32_t Mask = 1u << 24;     // FZ, which flushes inputs and results
+XO_INL uint32_t GetControl() {
+    uint64_t fpcr;
+    __asm__ volatile("mrs %0, fpcr" : "=r"(fpcr));
+    return static_cast<uint32_t>(fpcr);
+}
+XO_INL void SetControl(uint32_t control) {
+    uint64_t const fpcr = control;
+    __asm__ volatile("msr fpcr, %0" : : "r"(fpcr));
+}
+#else
+constexpr uint32_t Mask = 0u;
+XO_INL uint32_t GetControl() { return 0u; }
+XO_INL void SetControl(uint32_t) { }
+#endif
+} // ::xo::denormals
+
+// True when denormals are flushed on this thread.
+XO_INL bool GetFlushDenormals() {
+    return denormals::Mask != 0u && (denormals::GetControl() & denormals::Mask) == denormals::Mask;
+}
+
+// Flushes denormals on this thread, or stops. Returns whether they were flushed before.
+XO_INL bool SetFlushDenormals(bool flush) {
+    bool const was = GetFlushDenormals();
+    uint32_t const control = denormals::GetControl();
+    denormals::SetControl(flush ? control | denormals::Mask : control & ~denormals::Mask);
+    return was;
+}
+
+class ScopedFlushDenormals {
+public:
+    ScopedFlushDenormals() : saved(denormals::GetControl()) {
+        denormals::SetControl(saved | denormals::Mask);
+    }
+    // Only the flush bits go back, a rounding mode set in the scope stays.
+    ~ScopedFlushDenormals() {
+        denormals::SetControl((denormals::GetControl() & ~denormals::Mask) | (saved & denormals::Mask));
+    }
+    ScopedFlushDenormals(ScopedFlushDenormals const&) = delete;
+    ScopedFlushDenormals& operator = (ScopedFlushDenormals const&) = delete;
+
+private:
+    uint32_t saved;
+};
+
 #if defined(XO_MATH_IMPL)
 float WrapMinMax(float val, float minVal, float maxVal) {
     if (CloseEnough(val, minVal) || CloseEnough(val, maxVal)) {
@@ -61,14 +262,29 @@ float WrapMinMax(float val, float minVal, float maxVal) {
 
 float Sqrt(float val) { return std::sqrt(val); }
 float Pow(float val, int power) { return std::pow(val, power); }
-float Sin(float val) { return std::sin(val); }
-float Cos(float val) { return std::cos(val); }
+float Sin(float val) {
+    float s, c;
+    SinCos(val, s, c);
+    return s;
+}
+
+float Cos(float val) {
+    float s, c;
+    SinCos(val, s, c);
+    return c;
+}
+
 float ASin(float val) { return std::asin(val); }
 float ACos(float val) { return std::acos(val); }
 
 void SinCos(float val, float& sinOut, float& cosOut) {
-    sinOut = Sin(val);
-    cosOut = Cos(val);
+    if (Abs(val) <= trig::MaxReducible) {
+        trig::SinCos(val, sinOut, cosOut);
+    }
+    else {
+        sinOut = std::sin(val);
+        cosOut = std::cos(val);
+    }
 }
 
 void ASinACos(float val, float& asinOut, float& acosOut) {
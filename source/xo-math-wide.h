@@ -0,0 +1,707 @@
+#pragma once
+#include <inttypes.h>
+#include "xo-math-macros.h"
+#include "xo-math-utilities.h"
+#include "xo-math-detect-simd.h"
+// $inline_begin
+#if XO_SSE_CURRENT >= XO_AVX || XO_HAS_FMA
+#   include <immintrin.h>
+#elif XO_HAS_SSE
+#   include <xmmintrin.h>
+#endif
+
+namespace xo {
+// Structure of arrays types. Where a Vector3 is one vector, a Vector3xN<N> is N vectors
+// with each component held in a FloatN<N>: N floats worked on as one value. Every function
+// does the same thing as its Vector3 counterpart to all N lanes at once, so dot products,
+// cross products and normalization don't waste lanes or need horizontal sums.
+// Move data in and out with Gather/Scatter, or keep it in this form between frames.
+//
+// FloatN<4> is an __m128 with SSE, FloatN<8> an __m256 with AVX and FloatN<16> an __m512
+// with AVX512. Any other N (or a build without them) is a plain array the compiler can
+// vectorize. Pick the N that matches the widest register the build targets.
+
+// One Newton-Raphson step on an estimate r of 1/sqrt(a). r * r would overflow for the
+// smallest a, so the product goes (0.5 * a * r) * r.
+template<typename F>
+XO_INL F RefineInverseSqrt(F const& a, F const& r) {
+    return r * (F(1.5f) - (F(0.5f) * a * r) * r);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+template<int N>
+struct FloatN {
+    float v[N];
+
+    FloatN() = default;
+    explicit FloatN(float all) { for (int i = 0; i < N; ++i) v[i] = all; }
+
+    static FloatN XO_CC Load(float const* in) { FloatN r; for (int i = 0; i < N; ++i) r.v[i] = in[i]; return r; }
+    void XO_CC Store(float* out) const { for (int i = 0; i < N; ++i) out[i] = v[i]; }
+
+    FloatN XO_CC operator + (FloatN const& o) const { FloatN r; for (int i = 0; i < N; ++i) r.v[i] = v[i] + o.v[i]; return r; }
+    FloatN XO_CC operator - (FloatN const& o) const { FloatN r; for (int i = 0; i < N; ++i) r.v[i] = v[i] - o.v[i]; return r; }
+    FloatN XO_CC operator * (FloatN const& o) const { FloatN r; for (int i = 0; i < N; ++i) r.v[i] = v[i] * o.v[i]; return r; }
+    FloatN XO_CC operator / (FloatN const& o) const { FloatN r; for (int i = 0; i < N; ++i) r.v[i] = v[i] / o.v[i]; return r; }
+    FloatN operator -() const { FloatN r; for (int i = 0; i < N; ++i) r.v[i] = -v[i]; return r; }
+
+    static FloatN XO_CC Sqrt(FloatN const& a) { FloatN r; for (int i = 0; i < N; ++i) r.v[i] = xo::Sqrt(a.v[i]); return r; }
+    static FloatN XO_CC InverseSqrt(FloatN const& a, Precision precision) {
+        FloatN r; for (int i = 0; i < N; ++i) r.v[i] = xo::InverseSqrt(a.v[i], precision); return r;
+    }
+    static FloatN XO_CC Abs(FloatN const& a) { FloatN r; for (int i = 0; i < N; ++i) r.v[i] = xo::Abs(a.v[i]); return r; }
+    static FloatN XO_CC Max(FloatN const& a, FloatN const& b) { FloatN r; for (int i = 0; i < N; ++i) r.v[i] = xo::Max(a.v[i], b.v[i]); return r; }
+    // a * b + c
+    static FloatN XO_CC MultiplyAdd(FloatN const& a, FloatN const& b, FloatN const& c) { return a * b + c; }
+
+    static bool XO_CC AllLessEqual(FloatN const& a, FloatN const& b) {
+        for (int i = 0; i < N; ++i) if (!(a.v[i] <= b.v[i])) return false;
+        return true;
+    }
+    static bool XO_CC AllEqual(FloatN const& a, FloatN const& b) {
+        for (int i = 0; i < N; ++i) if (!(a.v[i] == b.v[i])) return false;
+        return true;
+    }
+};
+
+#if XO_HAS_SSE
+template<>
+struct FloatN<4> {
+    __m128 m;
+
+    FloatN() = default;
+    explicit FloatN(float all) : m(_mm_set1_ps(all)) { }
+    explicit FloatN(__m128 m) : m(m) { }
+
+    static FloatN XO_CC Load(float const* in) { return FloatN(_mm_loadu_ps(in)); }
+    void XO_CC Store(float* out) const { _mm_storeu_ps(out, m); }
+
+    FloatN XO_CC operator + (FloatN const& o) const { return FloatN(_mm_add_ps(m, o.m)); }
+    FloatN XO_CC operator - (FloatN const& o) const { return FloatN(_mm_sub_ps(m, o.m)); }
+    FloatN XO_CC operator * (FloatN const& o) const { return FloatN(_mm_mul_ps(m, o.m)); }
+    FloatN XO_CC operator / (FloatN const& o) const { return FloatN(_mm_div_ps(m, o.m)); }
+    FloatN operator -() const { return FloatN(_mm_xor_ps(m, _mm_set1_ps(-0.f))); }
+
+    static FloatN XO_CC Sqrt(FloatN const& a) { return FloatN(_mm_sqrt_ps(a.m)); }
+    static FloatN XO_CC InverseSqrt(FloatN const& a, Precision precision) {
+        if (precision == Precision::Exact) return FloatN(1.f) / Sqrt(a);
+        // Denormals scaled into range, see xo::rsqrt. No blendv before SSE4.1.
+        __m128 const tiny = _mm_cmplt_ps(a.m, _mm_set1_ps(rsqrt::Tiny));
+        FloatN const up(_mm_or_ps(_mm_andnot_ps(tiny, a.m), _mm_and_ps(tiny, _mm_mul_ps(a.m, _mm_set1_ps(rsqrt::ScaleUp)))));
+        FloatN const scale(_mm_or_ps(_mm_andnot_ps(tiny, _mm_set1_ps(1.f)), _mm_and_ps(tiny, _mm_set1_ps(rsqrt::ScaleBack))));
+        FloatN r(_mm_rsqrt_ps(up.m));
+        return (precision == Precision::Fastest ? r : RefineInverseSqrt(up, r)) * scale;
+    }
+    static FloatN XO_CC Abs(FloatN const& a) { return FloatN(_mm_andnot_ps(_mm_set1_ps(-0.f), a.m)); }
+    static FloatN XO_CC Max(FloatN const& a, FloatN const& b) { return FloatN(_mm_max_ps(a.m, b.m)); }
+    static FloatN XO_CC MultiplyAdd(FloatN const& a, FloatN const& b, FloatN const& c) {
+#   if XO_HAS_FMA
+        return FloatN(_mm_fmadd_ps(a.m, b.m, c.m));
+#   else
+        return a * b + c;
+#   endif
+    }
+
+    static bool XO_CC AllLessEqual(FloatN const& a, FloatN const& b) { return _mm_movemask_ps(_mm_cmple_ps(a.m, b.m)) == 0xF; }
+    static bool XO_CC AllEqual(FloatN const& a, FloatN const& b) { return _mm_movemask_ps(_mm_cmpeq_ps(a.m, b.m)) == 0xF; }
+};
+#endif
+
+#if XO_SSE_CURRENT >= XO_AVX || XO_HAS_FMA
+template<>
+struct FloatN<8> {
+    __m256 m;
+
+    FloatN() = default;
+    explicit FloatN(float all) : m(_mm256_set1_ps(all)) { }
+    explicit FloatN(__m256 m) : m(m) { }
+
+    static FloatN XO_CC Load(float const* in) { return FloatN(_mm256_loadu_ps(in)); }
+    void XO_CC Store(float* out) const { _mm256_storeu_ps(out, m); }
+
+    FloatN XO_CC operator + (FloatN const& o) const { return FloatN(_mm256_add_ps(m, o.m)); }
+    FloatN XO_CC operator - (FloatN const& o) const { return FloatN(_mm256_sub_ps(m, o.m)); }
+    FloatN XO_CC operator * (FloatN const& o) const { return FloatN(_mm256_mul_ps(m, o.m)); }
+    FloatN XO_CC operator / (FloatN const& o) const { return FloatN(_mm256_div_ps(m, o.m)); }
+    FloatN operator -() const { return FloatN(_mm256_xor_ps(m, _mm256_set1_ps(-0.f))); }
+
+    static FloatN XO_CC Sqrt(FloatN const& a) { return FloatN(_mm256_sqrt_ps(a.m)); }
+    static FloatN XO_CC InverseSqrt(FloatN const& a, Precision precision) {
+        if (precision == Precision::Exact) return FloatN(1.f) / Sqrt(a);
+        // Denormals scaled into range, see xo::rsqrt.
+        __m256 const tiny = _mm256_cmp_ps(a.m, _mm256_set1_ps(rsqrt::Tiny), _CMP_LT_OQ);
+        FloatN const up(_mm256_blendv_ps(a.m, _mm256_mul_ps(a.m, _mm256_set1_ps(rsqrt::ScaleUp)), tiny));
+        FloatN const scale(_mm256_blendv_ps(_mm256_set1_ps(1.f), _mm256_set1_ps(rsqrt::ScaleBack), tiny));
+        FloatN r(_mm256_rsqrt_ps(up.m));
+        return (precision == Precision::Fastest ? r : RefineInverseSqrt(up, r)) * scale;
+    }
+    static FloatN XO_CC Abs(FloatN const& a) { return FloatN(_mm256_andnot_ps(_mm256_set1_ps(-0.f), a.m)); }
+    static FloatN XO_CC Max(FloatN const& a, FloatN const& b) { return FloatN(_mm256_max_ps(a.m, b.m)); }
+    static FloatN XO_CC MultiplyAdd(FloatN const& a, FloatN const& b, FloatN const& c) {
+#   if XO_HAS_FMA
+        return FloatN(_mm256_fmadd_ps(a.m, b.m, c.m));
+#   else
+        return a * b + c;
+#   endif
+    }
+
+    static bool XO_CC AllLessEqual(FloatN const& a, FloatN const& b) {
+        return _mm256_movemask_ps(_mm256_cmp_ps(a.m, b.m, _CMP_LE_OQ)) == 0xFF;
+    }
+    static bool XO_CC AllEqual(FloatN const& a, FloatN const& b) {
+        return _mm256_movemask_ps(_mm256_cmp_ps(a.m, b.m, _CMP_EQ_OQ)) == 0xFF;
+    }
+};
+#endif
+
+#if XO_SSE_CURRENT >= XO_AVX512
+template<>
+struct FloatN<16> {
+    __m512 m;
+
+    FloatN() = default;
+    explicit FloatN(float all) : m(_mm512_set1_ps(all)) { }
+    explicit FloatN(__m512 m) : m(m) { }
+
+    static FloatN XO_CC Load(float const* in) { return FloatN(_mm512_loadu_ps(in)); }
+    void XO_CC Store(float* out) const { _mm512_storeu_ps(out, m); }
+
+    FloatN XO_CC operator + (FloatN const& o) const { return FloatN(_mm512_add_ps(m, o.m)); }
+    FloatN XO_CC operator - (FloatN const& o) const { return FloatN(_mm512_sub_ps(m, o.m)); }
+    FloatN XO_CC operator * (FloatN const& o) const { return FloatN(_mm512_mul_ps(m, o.m)); }
+    FloatN XO_CC operator / (FloatN const& o) const { return FloatN(_mm512_div_ps(m, o.m)); }
+    FloatN operator -() const { return FloatN(_mm512_sub_ps(_mm512_setzero_ps(), m)); }
+
+    // The maskz forms with every lane set are the same instructions. The plain intrinsics
+    // pass _mm512_undefined_ps() through, which gcc flags with -Wmaybe-uninitialized.
+    static FloatN XO_CC Sqrt(FloatN const& a) { return FloatN(_mm512_maskz_sqrt_ps(0xFFFF, a.m)); }
+    // rsqrt14 is good to 2^-14, so Fastest here is a little better than on 4 or 8 lanes
+    static FloatN XO_CC InverseSqrt(FloatN const& a, Precision precision) {
+        if (precision == Precision::Exact) return FloatN(1.f) / Sqrt(a);
+        FloatN r(_mm512_maskz_rsqrt14_ps(0xFFFF, a.m));
+        return precision == Precision::Fastest ? r : RefineInverseSqrt(a, r);
+    }
+    static FloatN XO_CC Abs(FloatN const& a) { return FloatN(_mm512_abs_ps(a.m)); }
+    static FloatN XO_CC Max(FloatN const& a, FloatN const& b) { return FloatN(_mm512_max_ps(a.m, b.m)); }
+    static FloatN XO_CC MultiplyAdd(FloatN const& a, FloatN const& b, FloatN const& c) {
+        return FloatN(_mm512_fmadd_ps(a.m, b.m, c.m));
+    }
+
+    static bool XO_CC AllLessEqual(FloatN const& a, FloatN const& b) {
+        return _mm512_cmp_ps_mask(a.m, b.m, _CMP_LE_OQ) == 0xFFFF;
+    }
+    static bool XO_CC AllEqual(FloatN const& a, FloatN const& b) {
+        return _mm512_cmp_ps_mask(a.m, b.m, _CMP_EQ_OQ) == 0xFFFF;
+    }
+};
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////////
+template<int N>
+struct Vector3xN {
+    typedef FloatN<N> Lanes;
+    static constexpr int Width = N;
+
+    Lanes x, y, z;
+
+    Vector3xN(Lanes const& x, Lanes const& y, Lanes const& z)
+        : x(x)
+        , y(y)
+        , z(z)
+    { }
+
+    explicit Vector3xN(float all)
+        : x(all)
+        , y(all)
+        , z(all)
+    { }
+
+    // The same vector in every lane.
+    explicit Vector3xN(Vector3 const& v)
+        : x(v.x)
+        , y(v.y)
+        , z(v.z)
+    { }
+
+    Vector3xN() = default;
+
+    // Reads N vectors. The count versions read min(count, N) and zero the remaining lanes,
+    // or write only the first min(count, N) lanes.
+    static Vector3xN XO_CC Gather(Vector3 const* in);
+    static Vector3xN XO_CC Gather(Vector3 const* in, size_t count);
+    void XO_CC Scatter(Vector3* out) const;
+    void XO_CC Scatter(Vector3* out, size_t count) const;
+
+    Vector3 XO_CC Get(int lane) const;
+
+    Vector3xN XO_CC operator + (Vector3xN const& other) const;
+    Vector3xN XO_CC operator - (Vector3xN const& other) const;
+    Vector3xN XO_CC operator * (Vector3xN const& other) const;
+    Vector3xN XO_CC operator / (Vector3xN const& other) const;
+    Vector3xN& XO_CC operator += (Vector3xN const& other) { return *this = *this + other; }
+    Vector3xN& XO_CC operator -= (Vector3xN const& other) { return *this = *this - other; }
+    Vector3xN& XO_CC operator *= (Vector3xN const& other) { return *this = *this * other; }
+    Vector3xN& XO_CC operator /= (Vector3xN const& other) { return *this = *this / other; }
+
+    Vector3xN XO_CC operator * (Lanes const& value) const { return Vector3xN(x * value, y * value, z * value); }
+    Vector3xN XO_CC operator / (Lanes const& value) const { return Vector3xN(x / value, y / value, z / value); }
+
+    Vector3xN XO_CC operator + (float value) const { return *this + Vector3xN(value); }
+    Vector3xN XO_CC operator - (float value) const { return *this - Vector3xN(value); }
+    Vector3xN XO_CC operator * (float value) const { return *this * Vector3xN(value); }
+    Vector3xN XO_CC operator / (float value) const { return *this / Vector3xN(value); }
+    Vector3xN& XO_CC operator += (float value) { return *this += Vector3xN(value); }
+    Vector3xN& XO_CC operator -= (float value) { return *this -= Vector3xN(value); }
+    Vector3xN& XO_CC operator *= (float value) { return *this *= Vector3xN(value); }
+    Vector3xN& XO_CC operator /= (float value) { return *this /= Vector3xN(value); }
+
+    Vector3xN operator -() const { return Vector3xN(-x, -y, -z); }
+
+    Lanes Sum() const;
+
+    Lanes Magnitude() const;
+    Lanes MagnitudeSquared() const;
+
+    Vector3xN& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+    Vector3xN Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+
+    // true when every lane is equal
+    static bool XO_CC RoughlyEqual(Vector3xN const& left, Vector3xN const& right);
+    static bool XO_CC ExactlyEqual(Vector3xN const& left, Vector3xN const& right);
+    static bool XO_CC RoughlyEqual(Vector3xN const& left, float magnitude);
+    static bool XO_CC ExactlyEqual(Vector3xN const& left, float magnitude);
+
+    static Lanes XO_CC DotProduct(Vector3xN const& left, Vector3xN const& right);
+    static Vector3xN XO_CC CrossProduct(Vector3xN const& left, Vector3xN const& right);
+    static Vector3xN XO_CC Lerp(Vector3xN const& left, Vector3xN const& right, float t);
+    static Vector3xN XO_CC Lerp(Vector3xN const& left, Vector3xN const& right, Lanes const& t);
+    static Lanes XO_CC DistanceSquared(Vector3xN const& left, Vector3xN const& right);
+    static Lanes XO_CC Distance(Vector3xN const& left, Vector3xN const& right);
+
+    static const Vector3xN Zero;
+    static const Vector3xN One;
+    static const Vector3xN Up;
+    static const Vector3xN Down;
+    static const Vector3xN Left;
+    static const Vector3xN Right;
+    static const Vector3xN Forward;
+    static const Vector3xN Backward;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+template<int N>
+struct Vector4xN {
+    typedef FloatN<N> Lanes;
+    static constexpr int Width = N;
+
+    Lanes x, y, z, w;
+
+    Vector4xN(Lanes const& x, Lanes const& y, Lanes const& z, Lanes const& w)
+        : x(x)
+        , y(y)
+        , z(z)
+        , w(w)
+    { }
+
+    explicit Vector4xN(float all)
+        : x(all)
+        , y(all)
+        , z(all)
+        , w(all)
+    { }
+
+    // The same vector in every lane.
+    explicit Vector4xN(Vector4 const& v)
+        : x(v.x)
+        , y(v.y)
+        , z(v.z)
+        , w(v.w)
+    { }
+
+    explicit Vector4xN(Vector3xN<N> const& v3, float w = 0.f)
+        : x(v3.x)
+        , y(v3.y)
+        , z(v3.z)
+        , w(w)
+    { }
+
+    Vector4xN() = default;
+
+    // See Vector3xN::Gather
+    static Vector4xN XO_CC Gather(Vector4 const* in);
+    static Vector4xN XO_CC Gather(Vector4 const* in, size_t count);
+    void XO_CC Scatter(Vector4* out) const;
+    void XO_CC Scatter(Vector4* out, size_t count) const;
+
+    Vector4 XO_CC Get(int lane) const;
+
+    Vector4xN XO_CC operator + (Vector4xN const& other) const;
+    Vector4xN XO_CC operator - (Vector4xN const& other) const;
+    Vector4xN XO_CC operator * (Vector4xN const& other) const;
+    Vector4xN XO_CC operator / (Vector4xN const& other) const;
+    Vector4xN& XO_CC operator += (Vector4xN const& other) { return *this = *this + other; }
+    Vector4xN& XO_CC operator -= (Vector4xN const& other) { return *this = *this - other; }
+    Vector4xN& XO_CC operator *= (Vector4xN const& other) { return *this = *this * other; }
+    Vector4xN& XO_CC operator /= (Vector4xN const& other) { return *this = *this / other; }
+
+    Vector4xN XO_CC operator * (Lanes const& value) const { return Vector4xN(x * value, y * value, z * value, w * value); }
+    Vector4xN XO_CC operator / (Lanes const& value) const { return Vector4xN(x / value, y / value, z / value, w / value); }
+
+    Vector4xN XO_CC operator + (float value) const { return *this + Vector4xN(value); }
+    Vector4xN XO_CC operator - (float value) const { return *this - Vector4xN(value); }
+    Vector4xN XO_CC operator * (float value) const { return *this * Vector4xN(value); }
+    Vector4xN XO_CC operator / (float value) const { return *this / Vector4xN(value); }
+    Vector4xN& XO_CC operator += (float value) { return *this += Vector4xN(value); }
+    Vector4xN& XO_CC operator -= (float value) { return *this -= Vector4xN(value); }
+    Vector4xN& XO_CC operator *= (float value) { return *this *= Vector4xN(value); }
+    Vector4xN& XO_CC operator /= (float value) { return *this /= Vector4xN(value); }
+
+    Vector4xN operator -() const { return Vector4xN(-x, -y, -z, -w); }
+
+    Lanes Sum() const;
+
+    Lanes Magnitude() const;
+    Lanes MagnitudeSquared() const;
+    Vector4xN Normalized(Precision precision = XO_CONFIG_DEFAULT_PRECISION) const;
+    Vector4xN& Normalize(Precision precision = XO_CONFIG_DEFAULT_PRECISION);
+
+    // true when every lane is equal
+    static bool XO_CC RoughlyEqual(Vector4xN const& left, Vector4xN const& right);
+    static bool XO_CC ExactlyEqual(Vector4xN const& left, Vector4xN const& right);
+    static bool XO_CC RoughlyEqual(Vector4xN const& left, float magnitude);
+    static bool XO_CC ExactlyEqual(Vector4xN const& left, float magnitude);
+
+    static Lanes XO_CC DotProduct(Vector4xN const& left, Vector4xN const& right);
+    static Vector4xN XO_CC Lerp(Vector4xN const& left, Vector4xN const& right, float t);
+    static Vector4xN XO_CC Lerp(Vector4xN const& left, Vector4xN const& right, Lanes const& t);
+
+    static const Vector4xN Zero;
+    static const Vector4xN One;
+};
+
+typedef Vector3xN<4> Vector3x4;
+typedef Vector3xN<8> Vector3x8;
+typedef Vector4xN<4> Vector4x4;
+typedef Vector4xN<8> Vector4x8;
+
+////////////////////////////////////////////////////////////////////////////////////////// FloatN trig
+// The polynomial from xo-math-utilities.h on every lane. No libm fallback here, so keep
+// |val| <= trig::MaxReducible.
+template<int N>
+XO_INL void XO_CC SinCos(FloatN<N> const& val, FloatN<N>& sinOut, FloatN<N>& cosOut) {
+    trig::SinCos(val, sinOut, cosOut);
+}
+
+template<int N>
+XO_INL FloatN<N> XO_CC Sin(FloatN<N> const& val) {
+    FloatN<N> s, c;
+    trig::SinCos(val, s, c);
+    return s;
+}
+
+template<int N>
+XO_INL FloatN<N> XO_CC Cos(FloatN<N> const& val) {
+    FloatN<N> s, c;
+    trig::SinCos(val, s, c);
+    return c;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////// FloatN helpers
+namespace wide {
+// Lane-wise CloseEnough, see xo-math-utilities.h
+template<int N>
+XO_INL bool XO_CC CloseEnough(FloatN<N> const& left, FloatN<N> const& right) {
+    typedef FloatN<N> F;
+    F scale = F::Max(F(1.f), F::Max(F::Abs(left), F::Abs(right)));
+    return F::AllLessEqual(F::Abs(left - right), F(MachineEpsilon) * scale);
+}
+} // ::xo::wide
+
+////////////////////////////////////////////////////////////////////////////////////////// Vector 3 xN
+
+template<int N> /*static*/ XO_INL
+Vector3xN<N> XO_CC Vector3xN<N>::Gather(Vector3 const* in) {
+    // A transpose through the stack: cheap next to the math it feeds, and the compiler
+    // turns it into shuffles where it can.
+    XO_ALN_16 float c[3][N];
+    for (int i = 0; i < N; ++i) {
+        c[0][i] = in[i].x;
+        c[1][i] = in[i].y;
+        c[2][i] = in[i].z;
+    }
+    return Vector3xN(Lanes::Load(c[0]), Lanes::Load(c[1]), Lanes::Load(c[2]));
+}
+
+template<int N> /*static*/ XO_INL
+Vector3xN<N> XO_CC Vector3xN<N>::Gather(Vector3 const* in, size_t count) {
+    XO_ALN_16 float c[3][N];
+    for (int i = 0; i < N; ++i) {
+        bool const live = size_t(i) < count;
+        c[0][i] = live ? in[i].x : 0.f;
+        c[1][i] = live ? in[i].y : 0.f;
+        c[2][i] = live ? in[i].z : 0.f;
+    }
+    return Vector3xN(Lanes::Load(c[0]), Lanes::Load(c[1]), Lanes::Load(c[2]));
+}
+
+template<int N> XO_INL
+void XO_CC Vector3xN<N>::Scatter(Vector3* out) const {
+    Scatter(out, N);
+}
+
+template<int N> XO_INL
+void XO_CC Vector3xN<N>::Scatter(Vector3* out, size_t count) const {
+    XO_ALN_16 float c[3][N];
+    x.Store(c[0]);
+    y.Store(c[1]);
+    z.Store(c[2]);
+    size_t const n = count < size_t(N) ? count : size_t(N);
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = Vector3(c[0][i], c[1][i], c[2][i]);
+    }
+}
+
+template<int N> XO_INL
+Vector3 XO_CC Vector3xN<N>::Get(int lane) const {
+    XO_ALN_16 float c[N];
+    x.Store(c); float const xx = c[lane];
+    y.Store(c); float const yy = c[lane];
+    z.Store(c); float const zz = c[lane];
+    return Vector3(xx, yy, zz);
+}
+
+template<int N> XO_INL
+Vector3xN<N> XO_CC Vector3xN<N>::operator + (Vector3xN const& other) const {
+    return Vector3xN(x + other.x, y + other.y, z + other.z);
+}
+
+template<int N> XO_INL
+Vector3xN<N> XO_CC Vector3xN<N>::operator - (Vector3xN const& other) const {
+    return Vector3xN(x - other.x, y - other.y, z - other.z);
+}
+
+template<int N> XO_INL
+Vector3xN<N> XO_CC Vector3xN<N>::operator * (Vector3xN const& other) const {
+    return Vector3xN(x * other.x, y * other.y, z * other.z);
+}
+
+template<int N> XO_INL
+Vector3xN<N> XO_CC Vector3xN<N>::operator / (Vector3xN const& other) const {
+    return Vector3xN(x / other.x, y / other.y, z / other.z);
+}
+
+template<int N> XO_INL FloatN<N> Vector3xN<N>::Sum() const { return x + y + z; }
+
+template<int N> XO_INL FloatN<N> Vector3xN<N>::MagnitudeSquared() const { return DotProduct(*this, *this); }
+template<int N> XO_INL FloatN<N> Vector3xN<N>::Magnitude() const { return Lanes::Sqrt(MagnitudeSquared()); }
+
+template<int N> XO_INL Vector3xN<N>& Vector3xN<N>::Normalize(Precision precision) {
+    if (precision == Precision::Exact) {
+        return *this = *this / Magnitude();
+    }
+    return *this = *this * Lanes::InverseSqrt(MagnitudeSquared(), precision);
+}
+template<int N> XO_INL Vector3xN<N> Vector3xN<N>::Normalized(Precision precision) const { return Vector3xN(*this).Normalize(precision); }
+
+template<int N> /*static*/ XO_INL
+bool XO_CC Vector3xN<N>::RoughlyEqual(Vector3xN const& left, Vector3xN const& right) {
+    return wide::CloseEnough(left.x, right.x)
+        && wide::CloseEnough(left.y, right.y)
+        && wide::CloseEnough(left.z, right.z);
+}
+
+template<int N> /*static*/ XO_INL
+bool XO_CC Vector3xN<N>::ExactlyEqual(Vector3xN const& left, Vector3xN const& right) {
+    return Lanes::AllEqual(left.x, right.x)
+        && Lanes::AllEqual(left.y, right.y)
+        && Lanes::AllEqual(left.z, right.z);
+}
+
+template<int N> /*static*/ XO_INL
+bool XO_CC Vector3xN<N>::RoughlyEqual(Vector3xN const& left, float magnitude) {
+    return wide::CloseEnough(left.MagnitudeSquared(), Lanes(Pow<2>(magnitude)));
+}
+
+template<int N> /*static*/ XO_INL
+bool XO_CC Vector3xN<N>::ExactlyEqual(Vector3xN const& left, float magnitude) {
+    return Lanes::AllEqual(left.MagnitudeSquared(), Lanes(Pow<2>(magnitude)));
+}
+
+template<int N> /*static*/ XO_INL
+FloatN<N> XO_CC Vector3xN<N>::DotProduct(Vector3xN const& left, Vector3xN const& right) {
+    return Lanes::MultiplyAdd(left.z, right.z, Lanes::MultiplyAdd(left.y, right.y, left.x * right.x));
+}
+
+template<int N> /*static*/ XO_INL
+Vector3xN<N> XO_CC Vector3xN<N>::CrossProduct(Vector3xN const& left, Vector3xN const& right) {
+    return Vector3xN(
+        left.y * right.z - left.z * right.y,
+        left.z * right.x - left.x * right.z,
+        left.x * right.y - left.y * right.x);
+}
+
+template<int N> /*static*/ XO_INL
+Vector3xN<N> XO_CC Vector3xN<N>::Lerp(Vector3xN const& left, Vector3xN const& right, float t) {
+    return Lerp(left, right, Lanes(t));
+}
+
+template<int N> /*static*/ XO_INL
+Vector3xN<N> XO_CC Vector3xN<N>::Lerp(Vector3xN const& left, Vector3xN const& right, Lanes const& t) {
+    return Vector3xN(
+        Lanes::MultiplyAdd(t, right.x - left.x, left.x),
+        Lanes::MultiplyAdd(t, right.y - left.y, left.y),
+        Lanes::MultiplyAdd(t, right.z - left.z, left.z));
+}
+
+template<int N> /*static*/ XO_INL
+FloatN<N> XO_CC Vector3xN<N>::DistanceSquared(Vector3xN const& left, Vector3xN const& right) {
+    return (right - left).MagnitudeSquared();
+}
+
+template<int N> /*static*/ XO_INL
+FloatN<N> XO_CC Vector3xN<N>::Distance(Vector3xN const& left, Vector3xN const& right) {
+    return (right - left).Magnitude();
+}
+
+template<int N> /*static*/ const Vector3xN<N> Vector3xN<N>::Zero(Vector3::Zero);
+template<int N> /*static*/ const Vector3xN<N> Vector3xN<N>::One(Vector3::One);
+template<int N> /*static*/ const Vector3xN<N> Vector3xN<N>::Up(Vector3::Up);
+template<int N> /*static*/ const Vector3xN<N> Vector3xN<N>::Down(Vector3::Down);
+template<int N> /*static*/ const Vector3xN<N> Vector3xN<N>::Left(Vector3::Left);
+template<int N> /*static*/ const Vector3xN<N> Vector3xN<N>::Right(Vector3::Right);
+template<int N> /*static*/ const Vector3xN<N> Vector3xN<N>::Forward(Vector3::Forward);
+template<int N> /*static*/ const Vector3xN<N> Vector3xN<N>::Backward(Vector3::Backward);
+
+////////////////////////////////////////////////////////////////////////////////////////// Vector 4 xN
+
+template<int N> /*static*/ XO_INL
+Vector4xN<N> XO_CC Vector4xN<N>::Gather(Vector4 const* in) {
+    XO_ALN_16 float c[4][N];
+    for (int i = 0; i < N; ++i) {
+        for (int j = 0; j < 4; ++j) c[j][i] = in[i].v[j];
+    }
+    return Vector4xN(Lanes::Load(c[0]), Lanes::Load(c[1]), Lanes::Load(c[2]), Lanes::Load(c[3]));
+}
+
+template<int N> /*static*/ XO_INL
+Vector4xN<N> XO_CC Vector4xN<N>::Gather(Vector4 const* in, size_t count) {
+    XO_ALN_16 float c[4][N];
+    for (int i = 0; i < N; ++i) {
+        bool const live = size_t(i) < count;
+        for (int j = 0; j < 4; ++j) c[j][i] = live ? in[i].v[j] : 0.f;
+    }
+    return Vector4xN(Lanes::Load(c[0]), Lanes::Load(c[1]), Lanes::Load(c[2]), Lanes::Load(c[3]));
+}
+
+template<int N> XO_INL
+void XO_CC Vector4xN<N>::Scatter(Vector4* out) const {
+    Scatter(out, N);
+}
+
+template<int N> XO_INL
+void XO_CC Vector4xN<N>::Scatter(Vector4* out, size_t count) const {
+    XO_ALN_16 float c[4][N];
+    x.Store(c[0]);
+    y.Store(c[1]);
+    z.Store(c[2]);
+    w.Store(c[3]);
+    size_t const n = count < size_t(N) ? count : size_t(N);
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = Vector4(c[0][i], c[1][i], c[2][i], c[3][i]);
+    }
+}
+
+template<int N> XO_INL
+Vector4 XO_CC Vector4xN<N>::Get(int lane) const {
+    XO_ALN_16 float c[N];
+    x.Store(c); float const xx = c[lane];
+    y.Store(c); float const yy = c[lane];
+    z.Store(c); float const zz = c[lane];
+    w.Store(c); float const ww = c[lane];
+    return Vector4(xx, yy, zz, ww);
+}
+
+template<int N> XO_INL
+Vector4xN<N> XO_CC Vector4xN<N>::operator + (Vector4xN const& other) const {
+    return Vector4xN(x + other.x, y + other.y, z + other.z, w + other.w);
+}
+
+template<int N> XO_INL
+Vector4xN<N> XO_CC Vector4xN<N>::operator - (Vector4xN const& other) const {
+    return Vector4xN(x - other.x, y - other.y, z - other.z, w - other.w);
+}
+
+template<int N> XO_INL
+Vector4xN<N> XO_CC Vector4xN<N>::operator * (Vector4xN const& other) const {
+    return Vector4xN(x * other.x, y * other.y, z * other.z, w * other.w);
+}
+
+template<int N> XO_INL
+Vector4xN<N> XO_CC Vector4xN<N>::operator / (Vector4xN const& other) const {
+    return Vector4xN(x / other.x, y / other.y, z / other.z, w / other.w);
+}
+
+template<int N> XO_INL FloatN<N> Vector4xN<N>::Sum() const { return (x + y) + (z + w); }
+
+template<int N> XO_INL FloatN<N> Vector4xN<N>::MagnitudeSquared() const { return DotProduct(*this, *this); }
+template<int N> XO_INL FloatN<N> Vector4xN<N>::Magnitude() const { return Lanes::Sqrt(MagnitudeSquared()); }
+
+template<int N> XO_INL Vector4xN<N>& Vector4xN<N>::Normalize(Precision precision) {
+    if (precision == Precision::Exact) {
+        return *this = *this / Magnitude();
+    }
+    return *this = *this * Lanes::InverseSqrt(MagnitudeSquared(), precision);
+}
+template<int N> XO_INL Vector4xN<N> Vector4xN<N>::Normalized(Precision precision) const { return Vector4xN(*this).Normalize(precision); }
+
+template<int N> /*static*/ XO_INL
+bool XO_CC Vector4xN<N>::RoughlyEqual(Vector4xN const& left, Vector4xN const& right) {
+    return wide::CloseEnough(left.x, right.x)
+        && wide::CloseEnough(left.y, right.y)
+        && wide::CloseEnough(left.z, right.z)
+        && wide::CloseEnough(left.w, right.w);
+}
+
+template<int N> /*static*/ XO_INL
+bool XO_CC Vector4xN<N>::ExactlyEqual(Vector4xN const& left, Vector4xN const& right) {
+    return Lanes::AllEqual(left.x, right.x)
+        && Lanes::AllEqual(left.y, right.y)
+        && Lanes::AllEqual(left.z, right.z)
+        && Lanes::AllEqual(left.w, right.w);
+}
+
+template<int N> /*static*/ XO_INL
+bool XO_CC Vector4xN<N>::RoughlyEqual(Vector4xN const& left, float magnitude) {
+    return wide::CloseEnough(left.MagnitudeSquared(), Lanes(Pow<2>(magnitude)));
+}
+
+template<int N> /*static*/ XO_INL
+bool XO_CC Vector4xN<N>::ExactlyEqual(Vector4xN const& left, float magnitude) {
+    return Lanes::AllEqual(left.MagnitudeSquared(), Lanes(Pow<2>(magnitude)));
+}
+
+template<int N> /*static*/ XO_INL
+FloatN<N> XO_CC Vector4xN<N>::DotProduct(Vector4xN const& left, Vector4xN const& right) {
+    return Lanes::MultiplyAdd(left.w, right.w,
+           Lanes::MultiplyAdd(left.z, right.z,
+           Lanes::MultiplyAdd(left.y, right.y, left.x * right.x)));
+}
+
+template<int N> /*static*/ XO_INL
+Vector4xN<N> XO_CC Vector4xN<N>::Lerp(Vector4xN const& left, Vector4xN const& right, float t) {
+    return Lerp(left, right, Lanes(t));
+}
+
+template<int N> /*static*/ XO_INL
+Vector4xN<N> XO_CC Vector4xN<N>::Lerp(Vector4xN const& left, Vector4xN const& right, Lanes const& t) {
+    return Vector4xN(
+        Lanes::MultiplyAdd(t, right.x - left.x, left.x),
+        Lanes::MultiplyAdd(t, right.y - left.y, left.y),
+        Lanes::MultiplyAdd(t, right.z - left.z, left.z),
+        Lanes::MultiplyAdd(t, right.w - left.w, left.w));
+}
+
+template<int N> /*static*/ const Vector4xN<N> Vector4xN<N>::Zero(Vector4::Zero);
+template<int N> /*static*/ const Vector4xN<N> Vector4xN<N>::One(Vector4::One);
+
+} // ::xo
@@ -63,14 +63,18 @@
 #include <limits>
 #include "xo-math-constants.h"
 #include "xo-math-macros.h"
-#include "xo-math-utilities.h"
 #include "xo-math-detect-simd.h"
+#include "xo-math-utilities.h"
 
 // As an end user you can configure these values
 #define XO_CONFIG_LEFT_HANDED 1
 #define XO_CONFIG_Y_UP 1
 #define XO_CONFIG_DEFAULT_NEAR_PLANE 0.1f
 #define XO_CONFIG_DEFAULT_FAR_PLANE 1000.f
+// 1: batch functions pick AVX2/AVX512 kernels at runtime. 0: only what the build targets.
+#define XO_CONFIG_RUNTIME_DISPATCH 1
+// Normalize and Normalized use this when no xo::Precision is passed, see xo-math-utilities.h
+#define XO_CONFIG_DEFAULT_PRECISION xo::Precision::Exact
 
 // These configs can set themselves up based on the other configs above...
 #define XO_CONFIG_RIGHT_HANDED (XO_CONFIG_LEFT_HANDED == 0 ? 1 : 0)
@@ -82,4 +86,16 @@
 #include "xo-math-reference.h"
 #endif
 
+#include "xo-math-matrix3x4.h"
+#include "xo-math-generic.h"
+#include "xo-math-double.h"
+#include "xo-math-half.h"
+#include "xo-math-packed.h"
+#include "xo-math-memory.h"
+#include "xo-math-wide.h"
+#include "xo-math-avx2.h"
+#include "xo-math-avx512.h"
+#include "xo-math-batch.h"
+#include "xo-math-lazy.h"
+
 #include "third-party-licenses.h"
\ No newline at end of file